@@ -49,7 +49,9 @@ EZ_STATICLINK_LIBRARY(Core)
   EZ_STATICLINK_REFERENCE(Core_ResourceManager_Implementation_Resource);
   EZ_STATICLINK_REFERENCE(Core_ResourceManager_Implementation_ResourceHandle);
   EZ_STATICLINK_REFERENCE(Core_ResourceManager_Implementation_ResourceLoading);
+  EZ_STATICLINK_REFERENCE(Core_ResourceManager_Implementation_ResourceLoadingQueue);
   EZ_STATICLINK_REFERENCE(Core_ResourceManager_Implementation_ResourceManager);
+  EZ_STATICLINK_REFERENCE(Core_ResourceManager_Implementation_ResourceMemoryBudgets);
   EZ_STATICLINK_REFERENCE(Core_ResourceManager_Implementation_ResourceTypeLoader);
   EZ_STATICLINK_REFERENCE(Core_ResourceManager_Implementation_WorkerTasks);
   EZ_STATICLINK_REFERENCE(Core_Scripting_Duktape_DuktapeContext);
@@ -73,6 +75,7 @@ EZ_STATICLINK_LIBRARY(Core)
   EZ_STATICLINK_REFERENCE(Core_World_Implementation_SettingsComponent);
   EZ_STATICLINK_REFERENCE(Core_World_Implementation_SpatialData);
   EZ_STATICLINK_REFERENCE(Core_World_Implementation_SpatialSystem);
+  EZ_STATICLINK_REFERENCE(Core_World_Implementation_SpatialSystem_LooseOctree);
   EZ_STATICLINK_REFERENCE(Core_World_Implementation_SpatialSystem_RegularGrid);
   EZ_STATICLINK_REFERENCE(Core_World_Implementation_World);
   EZ_STATICLINK_REFERENCE(Core_World_Implementation_WorldData);
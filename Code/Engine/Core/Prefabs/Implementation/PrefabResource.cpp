@@ -18,6 +18,11 @@ ezPrefabResource::ezPrefabResource()
 }
 
 void ezPrefabResource::InstantiatePrefab(ezWorld& world, const ezTransform& rootTransform, ezPrefabInstantiationOptions options, const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues)
+{
+  InstantiatePrefabs(world, ezMakeArrayPtr(&rootTransform, 1), options, pExposedParamValues);
+}
+
+void ezPrefabResource::InstantiatePrefabs(ezWorld& world, ezArrayPtr<const ezTransform> rootTransforms, ezPrefabInstantiationOptions options, const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues)
 {
   if (GetLoadingState() != ezResourceState::Loaded)
     return;
@@ -37,17 +42,30 @@ void ezPrefabResource::InstantiatePrefab(ezWorld& world, const ezTransform& root
       options.m_pCreatedChildObjectsOut = &createdChildObjects;
     }
 
-    m_WorldReader.InstantiatePrefab(world, rootTransform, options);
+    const ezUInt32 uiFirstRootObject = options.m_pCreatedRootObjectsOut->GetCount();
+    const ezUInt32 uiFirstChildObject = options.m_pCreatedChildObjectsOut->GetCount();
+
+    m_WorldReader.InstantiatePrefabs(world, rootTransforms, options);
 
-    ApplyExposedParameterValues(pExposedParamValues, *options.m_pCreatedChildObjectsOut, *options.m_pCreatedRootObjectsOut);
+    // every instance has the same number of objects
+    const ezUInt32 uiNumRootObjects = m_WorldReader.GetRootObjectCount();
+    const ezUInt32 uiNumChildObjects = m_WorldReader.GetChildObjectCount();
+
+    for (ezUInt32 i = 0; i < rootTransforms.GetCount(); ++i)
+    {
+      ezArrayPtr<ezGameObject* const> instanceRootObjects = options.m_pCreatedRootObjectsOut->GetArrayPtr().GetSubArray(uiFirstRootObject + i * uiNumRootObjects, uiNumRootObjects);
+      ezArrayPtr<ezGameObject* const> instanceChildObjects = options.m_pCreatedChildObjectsOut->GetArrayPtr().GetSubArray(uiFirstChildObject + i * uiNumChildObjects, uiNumChildObjects);
+
+      ApplyExposedParameterValues(pExposedParamValues, instanceChildObjects, instanceRootObjects);
+    }
   }
   else
   {
-    m_WorldReader.InstantiatePrefab(world, rootTransform, options);
+    m_WorldReader.InstantiatePrefabs(world, rootTransforms, options);
   }
 }
 
-void ezPrefabResource::ApplyExposedParameterValues(const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, const ezDynamicArray<ezGameObject*>& createdChildObjects, const ezDynamicArray<ezGameObject*>& createdRootObjects) const
+void ezPrefabResource::ApplyExposedParameterValues(const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, ezArrayPtr<ezGameObject* const> createdChildObjects, ezArrayPtr<ezGameObject* const> createdRootObjects) const
 {
   const ezUInt32 uiNumParamDescs = m_PrefabParamDescs.GetCount();
 
@@ -37,7 +37,13 @@ public:
   /// \brief Creates an instance of this prefab in the given world.
   void InstantiatePrefab(ezWorld& world, const ezTransform& rootTransform, ezPrefabInstantiationOptions options, const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues = nullptr);
 
-  void ApplyExposedParameterValues(const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, const ezDynamicArray<ezGameObject*>& createdChildObjects, const ezDynamicArray<ezGameObject*>& createdRootObjects) const;
+  /// \brief Creates one instance of this prefab for every transform in \a rootTransforms.
+  ///
+  /// This is much cheaper than calling InstantiatePrefab() for every instance, see ezWorldReader::InstantiatePrefabs().
+  /// The created objects of all instances are appended to the output arrays in \a options, one instance after the other.
+  void InstantiatePrefabs(ezWorld& world, ezArrayPtr<const ezTransform> rootTransforms, ezPrefabInstantiationOptions options, const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues = nullptr);
+
+  void ApplyExposedParameterValues(const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, ezArrayPtr<ezGameObject* const> createdChildObjects, ezArrayPtr<ezGameObject* const> createdRootObjects) const;
 
 private:
   virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override;
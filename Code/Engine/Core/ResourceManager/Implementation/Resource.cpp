@@ -140,6 +140,19 @@ void ezResource::CallUnloadData(Unload WhatToUnload)
   m_LoadingState = ld.m_State;
   m_uiQualityLevelsDiscardable = ld.m_uiQualityLevelsDiscardable;
   m_uiQualityLevelsLoadable = ld.m_uiQualityLevelsLoadable;
+
+  // Update Memory Usage, the memory budgets rely on it
+  {
+    ezResource::MemoryUsage MemUsage;
+    MemUsage.m_uiMemoryCPU = 0xFFFFFFFF;
+    MemUsage.m_uiMemoryGPU = 0xFFFFFFFF;
+    UpdateMemoryUsage(MemUsage);
+
+    EZ_ASSERT_DEV(MemUsage.m_uiMemoryCPU != 0xFFFFFFFF, "Resource '{0}' did not properly update its CPU memory usage", GetResourceID());
+    EZ_ASSERT_DEV(MemUsage.m_uiMemoryGPU != 0xFFFFFFFF, "Resource '{0}' did not properly update its GPU memory usage", GetResourceID());
+
+    m_MemoryUsage = MemUsage;
+  }
 }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -236,6 +249,12 @@ void ezResource::SetPriority(ezResourcePriority priority)
 
   m_Priority = priority;
 
+  // move it to its new position in the loading queue right away, instead of waiting for the next periodic update
+  if (ezResourceManager::IsQueuedForLoading(this))
+  {
+    ezResourceManager::UpdateLoadingPriority(this);
+  }
+
   ezResourceEvent e;
   e.m_pResource = this;
   e.m_Type = ezResourceEvent::Type::ResourcePriorityChanged;
@@ -29,6 +29,13 @@ void ezResourceManager::InternalPreloadResource(ezResource* pResource, bool bHig
     return;
   }
 
+  // while the memory budget is exhausted, loaded resources don't get any more quality levels
+  if (pResource->GetLoadingState() == ezResourceState::Loaded && !s_State->m_MemoryBudgets.IsEmpty() &&
+      GetResourceTypeInfo(pResource->GetDynamicRTTI()).m_bMemoryBudgetExhausted)
+  {
+    return;
+  }
+
   EZ_ASSERT_DEV(!s_State->s_bExportMode, "Resources should not be loaded in export mode");
 
   // if we are already loading this resource, early out
@@ -51,12 +58,9 @@ void ezResourceManager::InternalPreloadResource(ezResource* pResource, bool bHig
   {
     AddToLoadingQueue(pResource, bHighestPriority);
 
-    if (bHighestPriority && ezTaskSystem::GetCurrentThreadWorkerType() == ezWorkerThreadType::FileAccess)
-    {
-      ezResourceManager::s_State->s_bAllowLaunchDataLoadTask = true;
-    }
-
-    RunWorkerTask(pResource);
+    // if a file access thread waits for this resource, it may block one of the data load tasks,
+    // so another one needs to be started, even if that exceeds the limit
+    RunWorkerTask(bHighestPriority && ezTaskSystem::GetCurrentThreadWorkerType() == ezWorkerThreadType::FileAccess);
   }
 }
 
@@ -82,6 +86,8 @@ void ezResourceManager::SetupWorkerTasks()
     {
       static const ezUInt32 InitialUpdateContentTasks = 16;
 
+      EZ_LOCK(s_State->s_WorkerTasksUpdateContentMutex);
+
       for (ezUInt32 i = 0; i < InitialUpdateContentTasks; ++i)
       {
         s.Format("Resource Content Updater {0}", i);
@@ -93,7 +99,7 @@ void ezResourceManager::SetupWorkerTasks()
   }
 }
 
-void ezResourceManager::RunWorkerTask(ezResource* pResource)
+void ezResourceManager::RunWorkerTask(bool bLaunchAdditionalTask)
 {
   if (s_State->s_bShutdown)
     return;
@@ -102,52 +108,40 @@ void ezResourceManager::RunWorkerTask(ezResource* pResource)
 
   SetupWorkerTasks();
 
-  if (s_State->s_bAllowLaunchDataLoadTask && !s_State->s_LoadingQueue.IsEmpty())
+  // every file access thread loads one resource at a time
+  const ezUInt32 uiMaxRunningTasks = ezMath::Max(ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::FileAccess), 1u) + (bLaunchAdditionalTask ? 1 : 0);
+
+  // each task picks up one resource, so there is no need for more tasks than queued resources
+  ezUInt32 uiNumTasksToStart = 0;
+  if (s_State->s_uiNumRunningDataLoadTasks < uiMaxRunningTasks)
   {
-    s_State->s_bAllowLaunchDataLoadTask = false;
+    uiNumTasksToStart = ezMath::Min(uiMaxRunningTasks - s_State->s_uiNumRunningDataLoadTasks, s_State->s_LoadingQueue.GetCount());
+  }
 
-    for (ezUInt32 i = 0; i < s_State->s_WorkerTasksDataLoad.GetCount(); ++i)
+  for (ezUInt32 i = 0; i < s_State->s_WorkerTasksDataLoad.GetCount() && uiNumTasksToStart > 0; ++i)
+  {
+    if (s_State->s_WorkerTasksDataLoad[i].m_pTask->IsTaskFinished())
     {
-      if (s_State->s_WorkerTasksDataLoad[i].m_pTask->IsTaskFinished())
-      {
-        s_State->s_WorkerTasksDataLoad[i].m_GroupId =
-          ezTaskSystem::StartSingleTask(s_State->s_WorkerTasksDataLoad[i].m_pTask, ezTaskPriority::FileAccess);
-        return;
-      }
-    }
+      s_State->s_WorkerTasksDataLoad[i].m_GroupId =
+        ezTaskSystem::StartSingleTask(s_State->s_WorkerTasksDataLoad[i].m_pTask, ezTaskPriority::FileAccess);
 
-    // could not find any unused task -> need to create a new one
-    {
-      ezStringBuilder s;
-      s.Format("Resource Data Loader {0}", s_State->s_WorkerTasksDataLoad.GetCount());
-      auto& data = s_State->s_WorkerTasksDataLoad.ExpandAndGetRef();
-      data.m_pTask = EZ_DEFAULT_NEW(ezResourceManagerWorkerDataLoad);
-      data.m_pTask->ConfigureTask(s, ezTaskNesting::Maybe);
-      data.m_GroupId = ezTaskSystem::StartSingleTask(data.m_pTask, ezTaskPriority::FileAccess);
+      ++s_State->s_uiNumRunningDataLoadTasks;
+      --uiNumTasksToStart;
     }
   }
-}
-
-void ezResourceManager::ReverseBubbleSortStep(ezDeque<LoadingInfo>& data)
-{
-  // Yep, it's really bubble sort!
-  // This will move the entry with the smallest value to the front and move all other values closer to their correct position,
-  // which is exactly what we need for the priority queue.
-  // We do this once a frame, which gives us nice iterative sorting, with relatively deterministic performance characteristics.
-
-  EZ_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "Calling code must acquire s_ResourceMutex");
-
-  const ezUInt32 uiCount = data.GetCount();
 
-  for (ezUInt32 i = uiCount; i > 1; --i)
+  // could not find enough unused tasks -> need to create new ones
+  while (uiNumTasksToStart > 0)
   {
-    const ezUInt32 idx2 = i - 1;
-    const ezUInt32 idx1 = i - 2;
-
-    if (data[idx1].m_fPriority > data[idx1].m_fPriority)
-    {
-      ezMath::Swap(data[idx1], data[idx2]);
-    }
+    ezStringBuilder s;
+    s.Format("Resource Data Loader {0}", s_State->s_WorkerTasksDataLoad.GetCount());
+    auto& data = s_State->s_WorkerTasksDataLoad.ExpandAndGetRef();
+    data.m_pTask = EZ_DEFAULT_NEW(ezResourceManagerWorkerDataLoad);
+    data.m_pTask->ConfigureTask(s, ezTaskNesting::Maybe);
+    data.m_GroupId = ezTaskSystem::StartSingleTask(data.m_pTask, ezTaskPriority::FileAccess);
+
+    ++s_State->s_uiNumRunningDataLoadTasks;
+    --uiNumTasksToStart;
   }
 }
 
@@ -160,6 +154,9 @@ void ezResourceManager::UpdateLoadingDeadlines()
 
   EZ_PROFILE_SCOPE("UpdateLoadingDeadlines");
 
+  // Re-evaluating all priorities every time would be too expensive for long queues, so only a few are updated per call, round robin.
+  // Re-prioritized entries move to their new position in the heap right away, so a few entries might get visited twice or skipped in one
+  // round, which doesn't matter.
   const ezUInt32 uiCount = s_State->s_LoadingQueue.GetCount();
   s_State->s_uiLastResourcePriorityUpdateIdx = ezMath::Min(s_State->s_uiLastResourcePriorityUpdateIdx, uiCount);
 
@@ -171,25 +168,24 @@ void ezResourceManager::UpdateLoadingDeadlines()
     uiUpdateCount = ezMath::Min(50u, uiCount - s_State->s_uiLastResourcePriorityUpdateIdx);
   }
 
-  if (uiUpdateCount > 0)
-  {
-    {
-      EZ_PROFILE_SCOPE("EvalLoadingDeadlines");
+  const ezTime tNow = ezTime::Now();
 
-      const ezTime tNow = ezTime::Now();
+  for (ezUInt32 i = 0; i < uiUpdateCount; ++i)
+  {
+    ezResource* pResource = s_State->s_LoadingQueue.GetResource(s_State->s_uiLastResourcePriorityUpdateIdx);
+    s_State->s_LoadingQueue.UpdatePriority(pResource, pResource->GetLoadingPriority(tNow));
+    ++s_State->s_uiLastResourcePriorityUpdateIdx;
+  }
+}
 
-      for (ezUInt32 i = 0; i < uiUpdateCount; ++i)
-      {
-        auto& element = s_State->s_LoadingQueue[s_State->s_uiLastResourcePriorityUpdateIdx];
-        element.m_fPriority = element.m_pResource->GetLoadingPriority(tNow);
-        ++s_State->s_uiLastResourcePriorityUpdateIdx;
-      }
-    }
+void ezResourceManager::UpdateLoadingPriority(ezResource* pResource)
+{
+  EZ_LOCK(s_ResourceMutex);
 
-    {
-      EZ_PROFILE_SCOPE("SortLoadingDeadlines");
-      ReverseBubbleSortStep(s_State->s_LoadingQueue);
-    }
+  // the flag is also set while the resource is being loaded, at which point it isn't in the queue anymore
+  if (s_State->s_LoadingQueue.Contains(pResource))
+  {
+    s_State->s_LoadingQueue.UpdatePriority(pResource, pResource->GetLoadingPriority(s_State->s_LastFrameUpdate));
   }
 }
 
@@ -221,10 +217,7 @@ ezResult ezResourceManager::RemoveFromLoadingQueue(ezResource* pResource)
   if (!IsQueuedForLoading(pResource))
     return EZ_SUCCESS;
 
-  LoadingInfo li;
-  li.m_pResource = pResource;
-
-  if (s_State->s_LoadingQueue.RemoveAndSwap(li))
+  if (s_State->s_LoadingQueue.Remove(pResource))
   {
     pResource->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
     return EZ_SUCCESS;
@@ -240,19 +233,15 @@ void ezResourceManager::AddToLoadingQueue(ezResource* pResource, bool bHighestPr
 
   pResource->m_Flags.Add(ezResourceFlags::IsQueuedForLoading);
 
-  LoadingInfo li;
-  li.m_pResource = pResource;
-
   if (bHighestPriority)
   {
+    // someone is waiting for this resource, so it goes before everything else that is critical
     pResource->SetPriority(ezResourcePriority::Critical);
-    li.m_fPriority = 0.0f;
-    s_State->s_LoadingQueue.PushFront(li);
+    s_State->s_LoadingQueue.Insert(pResource, 0.0f, true);
   }
   else
   {
-    li.m_fPriority = pResource->GetLoadingPriority(s_State->s_LastFrameUpdate);
-    s_State->s_LoadingQueue.PushBack(li);
+    s_State->s_LoadingQueue.Insert(pResource, pResource->GetLoadingPriority(s_State->s_LastFrameUpdate));
   }
 }
 
@@ -285,10 +274,7 @@ bool ezResourceManager::ReloadResource(ezResource* pResource, bool bForce)
   {
     bAllowPreloading = false;
 
-    LoadingInfo li;
-    li.m_pResource = pResource;
-
-    if (s_State->s_LoadingQueue.IndexOf(li) == ezInvalidIndex)
+    if (!s_State->s_LoadingQueue.Contains(pResource))
     {
       // the resource is marked as 'loading' but it is not in the queue anymore
       // that means some task is already working on loading it
@@ -414,6 +400,7 @@ void ezResourceManager::EnsureResourceLoadingState(ezResource* pResourceToLoad,
 
     {
       EZ_LOCK(s_ResourceMutex);
+      EZ_LOCK(s_State->s_WorkerTasksUpdateContentMutex);
 
       for (ezUInt32 i = 0; i < s_State->s_WorkerTasksUpdateContent.GetCount(); ++i)
       {
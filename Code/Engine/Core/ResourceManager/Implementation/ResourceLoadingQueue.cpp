@@ -0,0 +1,175 @@
+#include <CorePCH.h>
+
+#include <Core/ResourceManager/Implementation/ResourceLoadingQueue.h>
+#include <Core/ResourceManager/Resource.h>
+
+// regular entries count up from the middle of the range, entries that go before equal priorities count down from there
+static constexpr ezUInt64 s_uiFirstOrder = 1ull << 63;
+
+ezResourceLoadingQueue::ezResourceLoadingQueue()
+  : m_uiNextOrder(s_uiFirstOrder)
+  , m_uiNextFrontOrder(s_uiFirstOrder - 1)
+{
+}
+
+ezResourceLoadingQueue::~ezResourceLoadingQueue()
+{
+  Clear();
+}
+
+bool ezResourceLoadingQueue::Contains(const ezResource* pResource) const
+{
+  const ezUInt32 uiIndex = pResource->m_uiLoadingQueueIndex;
+  return uiIndex < m_Entries.GetCount() && m_Entries[uiIndex].m_pResource == pResource;
+}
+
+void ezResourceLoadingQueue::Insert(ezResource* pResource, float fPriority, bool bBeforeEqualPriorities)
+{
+  EZ_ASSERT_DEBUG(!Contains(pResource), "Resource is already in the loading queue");
+
+  Entry entry;
+  entry.m_fPriority = fPriority;
+  entry.m_uiOrder = bBeforeEqualPriorities ? m_uiNextFrontOrder-- : m_uiNextOrder++;
+  entry.m_pResource = pResource;
+
+  const ezUInt32 uiIndex = m_Entries.GetCount();
+  m_Entries.PushBack(entry);
+  pResource->m_uiLoadingQueueIndex = uiIndex;
+
+  SiftUp(uiIndex);
+}
+
+ezResource* ezResourceLoadingQueue::PopFront()
+{
+  EZ_ASSERT_DEBUG(!m_Entries.IsEmpty(), "The loading queue is empty");
+
+  ezResource* pResource = m_Entries[0].m_pResource;
+  RemoveAt(0);
+
+  return pResource;
+}
+
+bool ezResourceLoadingQueue::Remove(ezResource* pResource)
+{
+  if (!Contains(pResource))
+    return false;
+
+  RemoveAt(pResource->m_uiLoadingQueueIndex);
+  return true;
+}
+
+void ezResourceLoadingQueue::UpdatePriority(ezResource* pResource, float fPriority)
+{
+  EZ_ASSERT_DEBUG(Contains(pResource), "Resource is not in the loading queue");
+
+  const ezUInt32 uiIndex = pResource->m_uiLoadingQueueIndex;
+  Entry& entry = m_Entries[uiIndex];
+
+  if (entry.m_fPriority == fPriority)
+    return;
+
+  const bool bMoveUp = fPriority < entry.m_fPriority;
+  entry.m_fPriority = fPriority;
+
+  if (bMoveUp)
+    SiftUp(uiIndex);
+  else
+    SiftDown(uiIndex);
+}
+
+void ezResourceLoadingQueue::Clear()
+{
+  for (const Entry& entry : m_Entries)
+  {
+    entry.m_pResource->m_uiLoadingQueueIndex = ezInvalidIndex;
+  }
+
+  m_Entries.Clear();
+}
+
+bool ezResourceLoadingQueue::IsBefore(const Entry& lhs, const Entry& rhs)
+{
+  if (lhs.m_fPriority != rhs.m_fPriority)
+    return lhs.m_fPriority < rhs.m_fPriority;
+
+  return lhs.m_uiOrder < rhs.m_uiOrder;
+}
+
+EZ_ALWAYS_INLINE void ezResourceLoadingQueue::SetEntry(ezUInt32 uiIndex, const Entry& entry)
+{
+  m_Entries[uiIndex] = entry;
+  entry.m_pResource->m_uiLoadingQueueIndex = uiIndex;
+}
+
+void ezResourceLoadingQueue::RemoveAt(ezUInt32 uiIndex)
+{
+  m_Entries[uiIndex].m_pResource->m_uiLoadingQueueIndex = ezInvalidIndex;
+
+  const ezUInt32 uiLastIndex = m_Entries.GetCount() - 1;
+
+  if (uiIndex != uiLastIndex)
+  {
+    // the last entry fills the gap and then moves to wherever it belongs
+    const Entry lastEntry = m_Entries[uiLastIndex];
+    const bool bMoveUp = IsBefore(lastEntry, m_Entries[uiIndex]);
+
+    SetEntry(uiIndex, lastEntry);
+    m_Entries.PopBack();
+
+    if (bMoveUp)
+      SiftUp(uiIndex);
+    else
+      SiftDown(uiIndex);
+  }
+  else
+  {
+    m_Entries.PopBack();
+  }
+}
+
+void ezResourceLoadingQueue::SiftUp(ezUInt32 uiIndex)
+{
+  const Entry entry = m_Entries[uiIndex];
+
+  while (uiIndex > 0)
+  {
+    const ezUInt32 uiParent = (uiIndex - 1) / 2;
+
+    if (!IsBefore(entry, m_Entries[uiParent]))
+      break;
+
+    SetEntry(uiIndex, m_Entries[uiParent]);
+    uiIndex = uiParent;
+  }
+
+  SetEntry(uiIndex, entry);
+}
+
+void ezResourceLoadingQueue::SiftDown(ezUInt32 uiIndex)
+{
+  const Entry entry = m_Entries[uiIndex];
+  const ezUInt32 uiCount = m_Entries.GetCount();
+
+  while (true)
+  {
+    ezUInt32 uiChild = uiIndex * 2 + 1;
+
+    if (uiChild >= uiCount)
+      break;
+
+    if (uiChild + 1 < uiCount && IsBefore(m_Entries[uiChild + 1], m_Entries[uiChild]))
+    {
+      ++uiChild;
+    }
+
+    if (!IsBefore(m_Entries[uiChild], entry))
+      break;
+
+    SetEntry(uiIndex, m_Entries[uiChild]);
+    uiIndex = uiChild;
+  }
+
+  SetEntry(uiIndex, entry);
+}
+
+EZ_STATICLINK_FILE(Core, Core_ResourceManager_Implementation_ResourceLoadingQueue);
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Core/CoreInternal.h>
+EZ_CORE_INTERNAL_HEADER
+
+#include <Foundation/Containers/DynamicArray.h>
+
+class ezResource;
+
+/// \brief The queue of resources that wait for a data loader task, ordered by their loading priority.
+///
+/// This is a binary min-heap, the resource with the lowest priority value is at the front. Every queued resource knows its position
+/// in the heap, so finding, removing and re-prioritizing a resource only takes O(log n).
+/// Resources with the same priority are loaded in the order in which they were queued, except for those that are inserted with
+/// bBeforeEqualPriorities, which are loaded before all resources with the same priority that are already queued.
+///
+/// Not thread-safe, all functions must be called while holding ezResourceManager's resource mutex.
+class ezResourceLoadingQueue
+{
+public:
+  ezResourceLoadingQueue();
+  ~ezResourceLoadingQueue();
+
+  bool IsEmpty() const { return m_Entries.IsEmpty(); }
+  ezUInt32 GetCount() const { return m_Entries.GetCount(); }
+
+  /// \brief Returns the resource at the given position in the heap. Only useful to iterate over all queued resources, in no particular order.
+  ezResource* GetResource(ezUInt32 uiIndex) const { return m_Entries[uiIndex].m_pResource; }
+
+  /// \brief Returns the resource that should be loaded next.
+  ezResource* PeekFront() const { return m_Entries[0].m_pResource; }
+
+  bool Contains(const ezResource* pResource) const;
+
+  void Insert(ezResource* pResource, float fPriority, bool bBeforeEqualPriorities = false);
+
+  /// \brief Removes the resource that should be loaded next and returns it.
+  ezResource* PopFront();
+
+  /// \brief Removes the given resource from the queue. Returns false, if it wasn't queued.
+  bool Remove(ezResource* pResource);
+
+  /// \brief Changes the priority of a queued resource and moves it to its new position.
+  void UpdatePriority(ezResource* pResource, float fPriority);
+
+  void Clear();
+
+private:
+  struct Entry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    float m_fPriority;
+    ezUInt64 m_uiOrder; ///< Keeps resources with the same priority in insertion order.
+    ezResource* m_pResource;
+  };
+
+  static bool IsBefore(const Entry& lhs, const Entry& rhs);
+
+  void SetEntry(ezUInt32 uiIndex, const Entry& entry);
+  void RemoveAt(ezUInt32 uiIndex);
+  void SiftUp(ezUInt32 uiIndex);
+  void SiftDown(ezUInt32 uiIndex);
+
+  ezDynamicArray<Entry> m_Entries;
+  ezUInt64 m_uiNextOrder;
+  ezUInt64 m_uiNextFrontOrder;
+};
@@ -8,7 +8,6 @@
 #include <Foundation/Profiling/Profiling.h>
 
 /// \todo Do not unload resources while they are acquired
-/// \todo Resource Type Memory Thresholds
 /// \todo Preload does not load all quality levels
 
 /// Infos to Display:
@@ -446,6 +445,7 @@ void ezResourceManager::PerFrameUpdate()
 {
   EZ_PROFILE_SCOPE("ezResourceManagerUpdate");
 
+  s_State->m_PreviousFrameUpdate = s_State->s_LastFrameUpdate;
   s_State->s_LastFrameUpdate = ezTime::Now();
 
   if (s_State->s_bBroadcastExistsEvent)
@@ -502,6 +502,8 @@ void ezResourceManager::PerFrameUpdate()
   {
     FreeUnusedResources(s_State->m_AutoFreeUnusedTimeout, s_State->m_AutoFreeUnusedThreshold);
   }
+
+  EnforceMemoryBudgets();
 }
 
 const ezEvent<const ezResourceEvent&, ezMutex>& ezResourceManager::GetResourceEvents()
@@ -541,7 +543,7 @@ void ezResourceManager::OnCoreStartup()
   s_State = EZ_DEFAULT_NEW(ezResourceManagerState);
 
   EZ_LOCK(s_ResourceMutex);
-  s_State->s_bAllowLaunchDataLoadTask = true;
+  s_State->s_uiNumRunningDataLoadTasks = 0;
   s_State->s_bShutdown = false;
 
   ezPlugin::s_PluginEvents.AddEventHandler(PluginEventHandler);
@@ -558,8 +560,7 @@ void ezResourceManager::EngineAboutToShutdown()
       return;
     }
 
-    s_State->s_bAllowLaunchDataLoadTask = false; // prevent a new one from starting
-    s_State->s_bShutdown = true;
+    s_State->s_bShutdown = true; // prevent a new one from starting
   }
 
   for (ezUInt32 i = 0; i < s_State->s_WorkerTasksDataLoad.GetCount(); ++i)
@@ -575,9 +576,12 @@ void ezResourceManager::EngineAboutToShutdown()
   {
     EZ_LOCK(s_ResourceMutex);
 
-    for (auto entry : s_State->s_LoadingQueue)
+    // canceled tasks that never ran did not get to decrement this
+    s_State->s_uiNumRunningDataLoadTasks = 0;
+
+    for (ezUInt32 i = 0; i < s_State->s_LoadingQueue.GetCount(); ++i)
     {
-      entry.m_pResource->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
+      s_State->s_LoadingQueue.GetResource(i)->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
     }
 
     s_State->s_LoadingQueue.Clear();
@@ -618,6 +622,8 @@ bool ezResourceManager::IsAnyLoadingInProgress()
     }
   }
 
+  EZ_LOCK(s_State->s_WorkerTasksUpdateContentMutex);
+
   for (ezUInt32 i = 0; i < s_State->s_WorkerTasksUpdateContent.GetCount(); ++i)
   {
     if (!s_State->s_WorkerTasksUpdateContent[i].m_pTask->IsTaskFinished())
@@ -3,6 +3,7 @@
 #include <Core/CoreInternal.h>
 EZ_CORE_INTERNAL_HEADER
 
+#include <Core/ResourceManager/Implementation/ResourceLoadingQueue.h>
 #include <Core/ResourceManager/ResourceManager.h>
 
 class ezResourceManagerState
@@ -51,13 +52,16 @@ private:
   ezUInt32 s_uiForceNoFallbackAcquisition = 0;
 
   // resources in this queue are waiting for a task to load them
-  ezDeque<ezResourceManager::LoadingInfo> s_LoadingQueue;
+  ezResourceLoadingQueue s_LoadingQueue;
 
   ezHashTable<const ezRTTI*, ezResourceManager::LoadedResources> s_LoadedResources;
 
-  bool s_bAllowLaunchDataLoadTask = true;
+  // data load tasks that were started and did not pick up their resource yet or are still loading it, at most one per file access thread
+  ezUInt32 s_uiNumRunningDataLoadTasks = 0;
   bool s_bShutdown = false;
 
+  // data load tasks hand their resources over to the update content tasks without locking the resource mutex
+  ezMutex s_WorkerTasksUpdateContentMutex;
   ezHybridArray<TaskDataUpdateContent, 24> s_WorkerTasksUpdateContent;
   ezHybridArray<TaskDataDataLoad, 8> s_WorkerTasksDataLoad;
 
@@ -101,5 +105,10 @@ private:
   ezTime m_AutoFreeUnusedTimeout = ezTime::Zero();
   ezTime m_AutoFreeUnusedThreshold = ezTime::Zero();
 
+  // Memory budgets
+  ezHybridArray<ezResourceManager::MemoryBudget, 4> m_MemoryBudgets;
+  ezDynamicArray<ezResource*> m_EvictionCandidates;
+  ezTime m_PreviousFrameUpdate;
+
   ezMap<const ezRTTI*, ezResourceManager::ResourceTypeInfo> m_TypeInfo;
 };
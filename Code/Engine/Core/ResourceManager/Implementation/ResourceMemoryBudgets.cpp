@@ -0,0 +1,289 @@
+#include <CorePCH.h>
+
+#include <Core/ResourceManager/Implementation/ResourceManagerState.h>
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Utilities/Stats.h>
+
+// Quality levels are only streamed in again once a category uses less than this fraction of its budget.
+// Otherwise a category right at its limit would discard and reload the same quality levels every frame.
+static constexpr double s_fStreamingHeadroom = 0.9;
+
+static bool IsMemoryBudgetExceeded(const ezResourceManager::MemoryBudgetStats& stats, double fFraction)
+{
+  return (stats.m_uiBudgetCPU > 0 && stats.m_uiMemoryCPU > stats.m_uiBudgetCPU * fFraction) ||
+         (stats.m_uiBudgetGPU > 0 && stats.m_uiMemoryGPU > stats.m_uiBudgetGPU * fFraction);
+}
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+static void SetMemoryBudgetStat(const ezRTTI* pResourceType, const char* szName, ezUInt64 uiMemory, ezUInt64 uiBudget)
+{
+  ezStringBuilder sStatName;
+  sStatName.Format("Resource Budgets/{0}/{1}", pResourceType->GetTypeName(), szName);
+
+  ezStringBuilder sStatValue;
+  if (uiBudget > 0)
+    sStatValue.Format("{0} / {1} (Mb)", ezArgF(uiMemory / (1024.0 * 1024.0), 2), ezArgF(uiBudget / (1024.0 * 1024.0), 2));
+  else
+    sStatValue.Format("{0} (Mb)", ezArgF(uiMemory / (1024.0 * 1024.0), 2));
+
+  ezStats::SetStat(sStatName, sStatValue.GetData());
+}
+#endif
+
+void ezResourceManager::SetResourceTypeMemoryBudget(const ezRTTI* pResourceType, ezUInt64 uiBudgetCPU, ezUInt64 uiBudgetGPU)
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  auto& budgets = s_State->m_MemoryBudgets;
+
+  ezUInt32 uiBudgetIndex = ezInvalidIndex;
+  for (ezUInt32 i = 0; i < budgets.GetCount(); ++i)
+  {
+    if (budgets[i].m_pResourceType == pResourceType)
+    {
+      uiBudgetIndex = i;
+      break;
+    }
+  }
+
+  if (uiBudgetCPU == 0 && uiBudgetGPU == 0)
+  {
+    if (uiBudgetIndex == ezInvalidIndex)
+      return;
+
+    budgets.RemoveAtAndCopy(uiBudgetIndex);
+
+    // recomputed by the next EnforceMemoryBudgets(), if other budgets remain
+    for (auto it = s_State->m_TypeInfo.GetIterator(); it.IsValid(); ++it)
+    {
+      it.Value().m_bMemoryBudgetExhausted = false;
+    }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    ezStringBuilder sStatName;
+    for (const char* szName : {"CPU", "GPU", "Discarded Quality Levels", "Deallocated Resources", "Frames Over Budget"})
+    {
+      sStatName.Format("Resource Budgets/{0}/{1}", pResourceType->GetTypeName(), szName);
+      ezStats::RemoveStat(sStatName);
+    }
+#endif
+
+    return;
+  }
+
+  if (uiBudgetIndex == ezInvalidIndex)
+  {
+    uiBudgetIndex = budgets.GetCount();
+    budgets.ExpandAndGetRef().m_pResourceType = pResourceType;
+  }
+
+  budgets[uiBudgetIndex].m_Stats.m_uiBudgetCPU = uiBudgetCPU;
+  budgets[uiBudgetIndex].m_Stats.m_uiBudgetGPU = uiBudgetGPU;
+}
+
+ezResult ezResourceManager::GetMemoryBudgetStats(const ezRTTI* pResourceType, MemoryBudgetStats& out_Stats)
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  for (const MemoryBudget& budget : s_State->m_MemoryBudgets)
+  {
+    if (budget.m_pResourceType == pResourceType)
+    {
+      out_Stats = budget.m_Stats;
+      return EZ_SUCCESS;
+    }
+  }
+
+  return EZ_FAILURE;
+}
+
+void ezResourceManager::EnforceMemoryBudgets()
+{
+  if (s_State->m_MemoryBudgets.IsEmpty())
+    return;
+
+  EZ_LOCK(s_ResourceMutex);
+  EZ_PROFILE_SCOPE("EnforceMemoryBudgets");
+
+  auto& budgets = s_State->m_MemoryBudgets;
+
+  for (MemoryBudget& budget : budgets)
+  {
+    budget.m_Stats.m_uiMemoryCPU = 0;
+    budget.m_Stats.m_uiMemoryGPU = 0;
+  }
+
+  for (auto itType = s_State->s_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
+  {
+    ezUInt64 uiMemoryCPU = 0;
+    ezUInt64 uiMemoryGPU = 0;
+
+    for (auto it = itType.Value().m_Resources.GetIterator(); it.IsValid(); ++it)
+    {
+      const ezResource::MemoryUsage& memoryUsage = it.Value()->GetMemoryUsage();
+      uiMemoryCPU += memoryUsage.m_uiMemoryCPU;
+      uiMemoryGPU += memoryUsage.m_uiMemoryGPU;
+    }
+
+    for (MemoryBudget& budget : budgets)
+    {
+      if (itType.Key()->IsDerivedFrom(budget.m_pResourceType))
+      {
+        budget.m_Stats.m_uiMemoryCPU += uiMemoryCPU;
+        budget.m_Stats.m_uiMemoryGPU += uiMemoryGPU;
+      }
+    }
+  }
+
+  // a resource counts towards several budgets, when it is evicted for one of them, all of them have to be updated
+  auto ReduceMemoryUsage = [&](const ezRTTI* pResourceType, const ezResource::MemoryUsage& before, const ezResource::MemoryUsage& after) {
+    const ezUInt64 uiFreedCPU = before.m_uiMemoryCPU - ezMath::Min(before.m_uiMemoryCPU, after.m_uiMemoryCPU);
+    const ezUInt64 uiFreedGPU = before.m_uiMemoryGPU - ezMath::Min(before.m_uiMemoryGPU, after.m_uiMemoryGPU);
+
+    for (MemoryBudget& budget : budgets)
+    {
+      if (pResourceType->IsDerivedFrom(budget.m_pResourceType))
+      {
+        budget.m_Stats.m_uiMemoryCPU -= ezMath::Min(budget.m_Stats.m_uiMemoryCPU, uiFreedCPU);
+        budget.m_Stats.m_uiMemoryGPU -= ezMath::Min(budget.m_Stats.m_uiMemoryGPU, uiFreedGPU);
+      }
+    }
+  };
+
+  ezDynamicArray<ezResource*>& candidates = s_State->m_EvictionCandidates;
+
+  for (MemoryBudget& budget : budgets)
+  {
+    if (!IsMemoryBudgetExceeded(budget.m_Stats, 1.0))
+    {
+      budget.m_Stats.m_uiNumFramesOverBudget = 0;
+      continue;
+    }
+
+    // Resources that are acquired during the previous frame may still be in use by the render thread.
+    // Resources that are being loaded or are locked right now are off limits as well.
+    candidates.Clear();
+    for (auto itType = s_State->s_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
+    {
+      if (!itType.Key()->IsDerivedFrom(budget.m_pResourceType))
+        continue;
+
+      const bool bIncrementalUnload = GetResourceTypeInfo(itType.Key()).m_bIncrementalUnload;
+
+      for (auto it = itType.Value().m_Resources.GetIterator(); it.IsValid(); ++it)
+      {
+        ezResource* pResource = it.Value();
+
+        if (IsQueuedForLoading(pResource) || pResource->m_iLockCount > 0 || pResource->GetLastAcquireTime() >= s_State->m_PreviousFrameUpdate)
+          continue;
+
+        if (pResource->GetMemoryUsage().m_uiMemoryCPU == 0 && pResource->GetMemoryUsage().m_uiMemoryGPU == 0)
+          continue;
+
+        const bool bCanDeallocate = pResource->GetReferenceCount() == 0 && bIncrementalUnload;
+        if (bCanDeallocate || pResource->GetNumQualityLevelsDiscardable() > 0)
+        {
+          candidates.PushBack(pResource);
+        }
+      }
+    }
+
+    // lowest priority first, then least recently used
+    candidates.Sort([](const ezResource* a, const ezResource* b) {
+      if (a->GetPriority() != b->GetPriority())
+        return a->GetPriority() > b->GetPriority();
+
+      return a->GetLastAcquireTime() < b->GetLastAcquireTime();
+    });
+
+    // nobody uses unreferenced resources anymore, so those go before reducing the quality of anything that is still in use
+    for (ezUInt32 i = 0; i < candidates.GetCount() && IsMemoryBudgetExceeded(budget.m_Stats, 1.0); ++i)
+    {
+      ezResource* pResource = candidates[i];
+
+      if (pResource->GetReferenceCount() != 0 || !GetResourceTypeInfo(pResource->GetDynamicRTTI()).m_bIncrementalUnload)
+        continue;
+
+      const ezRTTI* pResourceType = pResource->GetDynamicRTTI();
+      const ezResource::MemoryUsage before = pResource->GetMemoryUsage();
+      const ezTempHashedString sResourceID(pResource->GetResourceID());
+
+      if (DeallocateResource(pResource).Succeeded())
+      {
+        s_State->s_LoadedResources[pResourceType].m_Resources.Remove(sResourceID);
+        candidates[i] = nullptr;
+
+        ReduceMemoryUsage(pResourceType, before, ezResource::MemoryUsage());
+        ++budget.m_Stats.m_uiNumDeallocatedResources;
+      }
+    }
+
+    for (ezUInt32 i = 0; i < candidates.GetCount() && IsMemoryBudgetExceeded(budget.m_Stats, 1.0); ++i)
+    {
+      ezResource* pResource = candidates[i];
+
+      while (pResource != nullptr && pResource->GetNumQualityLevelsDiscardable() > 0 && IsMemoryBudgetExceeded(budget.m_Stats, 1.0))
+      {
+        const ezResource::MemoryUsage before = pResource->GetMemoryUsage();
+
+        pResource->CallUnloadData(ezResource::Unload::OneQualityLevel);
+
+        ReduceMemoryUsage(pResource->GetDynamicRTTI(), before, pResource->GetMemoryUsage());
+        ++budget.m_Stats.m_uiNumDiscardedQualityLevels;
+      }
+    }
+
+    candidates.Clear();
+
+    if (IsMemoryBudgetExceeded(budget.m_Stats, 1.0))
+      ++budget.m_Stats.m_uiNumFramesOverBudget;
+    else
+      budget.m_Stats.m_uiNumFramesOverBudget = 0;
+  }
+
+  for (auto itType = s_State->s_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
+  {
+    bool bExhausted = false;
+
+    for (const MemoryBudget& budget : budgets)
+    {
+      if (itType.Key()->IsDerivedFrom(budget.m_pResourceType) && IsMemoryBudgetExceeded(budget.m_Stats, s_fStreamingHeadroom))
+      {
+        bExhausted = true;
+        break;
+      }
+    }
+
+    GetResourceTypeInfo(itType.Key()).m_bMemoryBudgetExhausted = bExhausted;
+  }
+
+  UpdateMemoryBudgetStats();
+}
+
+void ezResourceManager::UpdateMemoryBudgetStats()
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  ezStringBuilder sStatName;
+
+  for (const MemoryBudget& budget : s_State->m_MemoryBudgets)
+  {
+    const MemoryBudgetStats& stats = budget.m_Stats;
+    const char* szTypeName = budget.m_pResourceType->GetTypeName();
+
+    SetMemoryBudgetStat(budget.m_pResourceType, "CPU", stats.m_uiMemoryCPU, stats.m_uiBudgetCPU);
+    SetMemoryBudgetStat(budget.m_pResourceType, "GPU", stats.m_uiMemoryGPU, stats.m_uiBudgetGPU);
+
+    sStatName.Format("Resource Budgets/{0}/Discarded Quality Levels", szTypeName);
+    ezStats::SetStat(sStatName, stats.m_uiNumDiscardedQualityLevels);
+
+    sStatName.Format("Resource Budgets/{0}/Deallocated Resources", szTypeName);
+    ezStats::SetStat(sStatName, stats.m_uiNumDeallocatedResources);
+
+    sStatName.Format("Resource Budgets/{0}/Frames Over Budget", szTypeName);
+    ezStats::SetStat(sStatName, stats.m_uiNumFramesOverBudget);
+  }
+#endif
+}
+
+EZ_STATICLINK_FILE(Core, Core_ResourceManager_Implementation_ResourceMemoryBudgets);
@@ -8,10 +8,51 @@
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Profiling/Profiling.h>
 
+namespace
+{
+  /// Reads the header part first and continues with the content part, so the file content doesn't need to be copied behind the header.
+  class ezHeaderAndContentStreamReader final : public ezStreamReader
+  {
+  public:
+    virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override
+    {
+      ezUInt64 uiBytesRead = m_Header.ReadBytes(pReadBuffer, uiBytesToRead);
+
+      if (uiBytesRead < uiBytesToRead)
+      {
+        void* pContentBuffer = pReadBuffer != nullptr ? ezMemoryUtils::AddByteOffset(pReadBuffer, static_cast<ptrdiff_t>(uiBytesRead)) : nullptr;
+        uiBytesRead += m_Content.ReadBytes(pContentBuffer, uiBytesToRead - uiBytesRead);
+      }
+
+      return uiBytesRead;
+    }
+
+    virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override
+    {
+      ezUInt64 uiBytesSkipped = m_Header.SkipBytes(uiBytesToSkip);
+
+      if (uiBytesSkipped < uiBytesToSkip)
+      {
+        uiBytesSkipped += m_Content.SkipBytes(uiBytesToSkip - uiBytesSkipped);
+      }
+
+      return uiBytesSkipped;
+    }
+
+    ezRawMemoryStreamReader m_Header;
+    ezRawMemoryStreamReader m_Content;
+  };
+} // namespace
+
 struct FileResourceLoadData
 {
   ezBlob m_Storage;
   ezRawMemoryStreamReader m_Reader;
+
+  // Files that are mapped into memory (e.g. uncompressed files in archives) are read without a copy, the file stays open until the
+  // data stream is closed.
+  ezFileReader m_MappedFile;
+  ezHeaderAndContentStreamReader m_MappedReader;
 };
 
 ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pResource)
@@ -20,9 +61,14 @@ ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pR
 
   ezResourceLoadData res;
 
-  ezFileReader File;
+  FileResourceLoadData* pData = EZ_DEFAULT_NEW(FileResourceLoadData);
+
+  ezFileReader& File = pData->m_MappedFile;
   if (File.Open(pResource->GetResourceID().GetData()).Failed())
+  {
+    EZ_DEFAULT_DELETE(pData);
     return res;
+  }
 
   res.m_sResourceDescription = File.GetFilePathRelative().GetData();
 
@@ -35,11 +81,11 @@ ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pR
 
 #endif
 
-  FileResourceLoadData* pData = EZ_DEFAULT_NEW(FileResourceLoadData);
-
   const ezUInt64 uiFileSize = File.GetFileSize();
+  const ezArrayPtr<const ezUInt8> mappedData = File.GetMappedData();
 
-  const ezUInt64 uiBlobCapacity = uiFileSize + File.GetFilePathAbsolute().GetElementCount() + 8; // +8 for the string overhead
+  const ezUInt64 uiPathCapacity = File.GetFilePathAbsolute().GetElementCount() + 8; // +8 for the string overhead
+  const ezUInt64 uiBlobCapacity = mappedData.IsEmpty() ? uiFileSize + uiPathCapacity : uiPathCapacity;
   pData->m_Storage.SetCountUninitialized(uiBlobCapacity);
 
   ezUInt8* pBlobPtr = pData->m_Storage.GetBlobPtr<ezUInt8>().GetPtr();
@@ -51,10 +97,21 @@ ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pR
 
   const ezUInt64 uiOffset = w.GetNumWrittenBytes();
 
-  File.ReadBytes(pBlobPtr + uiOffset, uiFileSize);
+  if (!mappedData.IsEmpty())
+  {
+    pData->m_MappedReader.m_Header.Reset(pBlobPtr, uiOffset);
+    pData->m_MappedReader.m_Content.Reset(mappedData.GetPtr(), mappedData.GetCount());
+    res.m_pDataStream = &pData->m_MappedReader;
+  }
+  else
+  {
+    File.ReadBytes(pBlobPtr + uiOffset, uiFileSize);
+    File.Close();
+
+    pData->m_Reader.Reset(pBlobPtr, uiOffset + uiFileSize);
+    res.m_pDataStream = &pData->m_Reader;
+  }
 
-  pData->m_Reader.Reset(pBlobPtr, w.GetNumWrittenBytes() + uiFileSize);
-  res.m_pDataStream = &pData->m_Reader;
   res.m_pCustomLoaderData = pData;
 
   return res;
@@ -21,15 +21,13 @@ void ezResourceManagerWorkerDataLoad::Execute()
 
     if (ezResourceManager::s_State->s_LoadingQueue.IsEmpty())
     {
-      ezResourceManager::s_State->s_bAllowLaunchDataLoadTask = true;
+      --ezResourceManager::s_State->s_uiNumRunningDataLoadTasks;
       return;
     }
 
     ezResourceManager::UpdateLoadingDeadlines();
 
-    auto it = ezResourceManager::s_State->s_LoadingQueue.PeekFront();
-    pResourceToLoad = it.m_pResource;
-    ezResourceManager::s_State->s_LoadingQueue.PopFront();
+    pResourceToLoad = ezResourceManager::s_State->s_LoadingQueue.PopFront();
 
     if (pResourceToLoad->m_Flags.IsSet(ezResourceFlags::HasCustomDataLoader))
     {
@@ -56,54 +54,61 @@ void ezResourceManagerWorkerDataLoad::Execute()
   ezSharedPtr<ezResourceManagerWorkerUpdateContent> pUpdateContentTask;
   ezTaskGroupID* pUpdateContentGroup = nullptr;
 
-  EZ_LOCK(ezResourceManager::s_ResourceMutex);
-
-  // try to find an update content task that has finished and can be reused
-  for (ezUInt32 i = 0; i < ezResourceManager::s_State->s_WorkerTasksUpdateContent.GetCount(); ++i)
+  // the resource is only accessed by this task until it is handed over, so other data load tasks can work on their resources in the meantime
   {
-    auto& td = ezResourceManager::s_State->s_WorkerTasksUpdateContent[i];
+    EZ_LOCK(ezResourceManager::s_State->s_WorkerTasksUpdateContentMutex);
+
+    // try to find an update content task that has finished and can be reused
+    for (ezUInt32 i = 0; i < ezResourceManager::s_State->s_WorkerTasksUpdateContent.GetCount(); ++i)
+    {
+      auto& td = ezResourceManager::s_State->s_WorkerTasksUpdateContent[i];
+
+      if (ezTaskSystem::IsTaskGroupFinished(td.m_GroupId))
+      {
+        pUpdateContentTask = td.m_pTask;
+        pUpdateContentGroup = &td.m_GroupId;
+        break;
+      }
+    }
 
-    if (ezTaskSystem::IsTaskGroupFinished(td.m_GroupId))
+    // if no such task could be found, we must allocate a new one
+    if (pUpdateContentTask == nullptr)
     {
+      ezStringBuilder s;
+      s.Format("Resource Content Updater {0}", ezResourceManager::s_State->s_WorkerTasksUpdateContent.GetCount());
+
+      auto& td = ezResourceManager::s_State->s_WorkerTasksUpdateContent.ExpandAndGetRef();
+      td.m_pTask = EZ_DEFAULT_NEW(ezResourceManagerWorkerUpdateContent);
+      td.m_pTask->ConfigureTask(s, ezTaskNesting::Maybe);
+
       pUpdateContentTask = td.m_pTask;
       pUpdateContentGroup = &td.m_GroupId;
-      break;
     }
-  }
 
-  // if no such task could be found, we must allocate a new one
-  if (pUpdateContentTask == nullptr)
-  {
-    ezStringBuilder s;
-    s.Format("Resource Content Updater {0}", ezResourceManager::s_State->s_WorkerTasksUpdateContent.GetCount());
+    // always updated together with pUpdateContentTask
+    EZ_MSVC_ANALYSIS_ASSUME(pUpdateContentGroup != nullptr);
 
-    auto& td = ezResourceManager::s_State->s_WorkerTasksUpdateContent.ExpandAndGetRef();
-    td.m_pTask = EZ_DEFAULT_NEW(ezResourceManagerWorkerUpdateContent);
-    td.m_pTask->ConfigureTask(s, ezTaskNesting::Maybe);
+    // set up the data load task and launch it
+    {
+      pUpdateContentTask->m_LoaderData = LoaderData;
+      pUpdateContentTask->m_pLoader = pLoader;
+      pUpdateContentTask->m_pCustomLoader = std::move(pCustomLoader);
+      pUpdateContentTask->m_pResourceToLoad = pResourceToLoad;
 
-    pUpdateContentTask = td.m_pTask;
-    pUpdateContentGroup = &td.m_GroupId;
-  }
+      // schedule the task to run, either on the main thread or on some other thread
+      *pUpdateContentGroup = ezTaskSystem::StartSingleTask(
+        pUpdateContentTask, bResourceIsLoadedOnMainThread ? ezTaskPriority::SomeFrameMainThread : ezTaskPriority::LateNextFrame);
 
-  // always updated together with pUpdateContentTask
-  EZ_MSVC_ANALYSIS_ASSUME(pUpdateContentGroup != nullptr);
+      pCustomLoader.Clear();
+    }
+  }
 
-  // set up the data load task and launch it
   {
-    pUpdateContentTask->m_LoaderData = LoaderData;
-    pUpdateContentTask->m_pLoader = pLoader;
-    pUpdateContentTask->m_pCustomLoader = std::move(pCustomLoader);
-    pUpdateContentTask->m_pResourceToLoad = pResourceToLoad;
-
-    // schedule the task to run, either on the main thread or on some other thread
-    *pUpdateContentGroup = ezTaskSystem::StartSingleTask(
-      pUpdateContentTask, bResourceIsLoadedOnMainThread ? ezTaskPriority::SomeFrameMainThread : ezTaskPriority::LateNextFrame);
-
-    // restart the next loading task (this one is about to finish)
-    ezResourceManager::s_State->s_bAllowLaunchDataLoadTask = true;
-    ezResourceManager::RunWorkerTask(nullptr);
+    EZ_LOCK(ezResourceManager::s_ResourceMutex);
 
-    pCustomLoader.Clear();
+    // start the next loading task (this one is about to finish)
+    --ezResourceManager::s_State->s_uiNumRunningDataLoadTasks;
+    ezResourceManager::RunWorkerTask();
   }
 }
 
@@ -135,6 +135,7 @@ private:
   friend class ezResourceManager;
   friend class ezResourceManagerWorkerDataLoad;
   friend class ezResourceManagerWorkerUpdateContent;
+  friend class ezResourceLoadingQueue;
 
   /// \brief Called by ezResourceManager shortly after resource creation.
   void SetUniqueID(const char* szUniqueID, bool bIsReloadable);
@@ -228,6 +229,7 @@ private:
   ezTime m_LastAcquire;
   ezResourcePriority m_Priority = ezResourcePriority::Medium;
   ezTimestamp m_LoadedFileModificationTime;
+  ezUInt32 m_uiLoadingQueueIndex = ezInvalidIndex; ///< Position in ezResourceLoadingQueue, only accessed under the resource manager mutex.
 
 private:
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -222,6 +222,55 @@ public:
 private:
   static ezResult DeallocateResource(ezResource* pResource);
 
+  ///@}
+  /// \name Memory budgets
+  ///@{
+
+public:
+  struct MemoryBudgetStats
+  {
+    ezUInt64 m_uiBudgetCPU = 0; ///< Zero means unlimited.
+    ezUInt64 m_uiBudgetGPU = 0; ///< Zero means unlimited.
+    ezUInt64 m_uiMemoryCPU = 0; ///< Memory used by all resources of the category, as of the last PerFrameUpdate().
+    ezUInt64 m_uiMemoryGPU = 0; ///< Memory used by all resources of the category, as of the last PerFrameUpdate().
+    ezUInt64 m_uiNumDiscardedQualityLevels = 0;
+    ezUInt64 m_uiNumDeallocatedResources = 0;
+    ezUInt32 m_uiNumFramesOverBudget = 0; ///< How many frames the budget stayed exceeded because nothing else could be evicted.
+  };
+
+  /// \brief Limits how much CPU and GPU memory all resources of the given type, including derived types, may use.
+  ///
+  /// The budget is enforced once per frame in PerFrameUpdate(). When it is exceeded, resources that are not referenced anymore are
+  /// deallocated first, afterwards referenced resources discard quality levels. Resources with a lower priority and those that were
+  /// not acquired for a longer time go first. Resources that were acquired during the last two frames are never evicted.
+  /// While a category is close to its budget, its resources don't stream in additional quality levels.
+  ///
+  /// A resource counts towards every budget of its type and its base types, so a budget for ezResource limits all resources.
+  /// Pass zero for a limit that should not be enforced and zero for both limits to remove the budget.
+  template <typename ResourceType>
+  static void SetResourceTypeMemoryBudget(ezUInt64 uiBudgetCPU, ezUInt64 uiBudgetGPU)
+  {
+    SetResourceTypeMemoryBudget(ezGetStaticRTTI<ResourceType>(), uiBudgetCPU, uiBudgetGPU);
+  }
+
+  /// \sa SetResourceTypeMemoryBudget()
+  static void SetResourceTypeMemoryBudget(const ezRTTI* pResourceType, ezUInt64 uiBudgetCPU, ezUInt64 uiBudgetGPU);
+
+  /// \brief Returns the current memory usage and eviction statistics for the budget of the given type. Fails if there is no budget.
+  ///
+  /// The same values are published through ezStats under 'Resource Budgets/<type>' in development builds.
+  static ezResult GetMemoryBudgetStats(const ezRTTI* pResourceType, MemoryBudgetStats& out_Stats);
+
+private:
+  struct MemoryBudget
+  {
+    const ezRTTI* m_pResourceType = nullptr;
+    MemoryBudgetStats m_Stats;
+  };
+
+  static void EnforceMemoryBudgets();
+  static void UpdateMemoryBudgetStats();
+
   ///@}
   /// \name Miscellaneous
   ///@{
@@ -437,14 +486,6 @@ private:
     ezHashTable<ezTempHashedString, ezResource*> m_Resources;
   };
 
-  struct LoadingInfo
-  {
-    float m_fPriority = 0;
-    ezResource* m_pResource = nullptr;
-
-    EZ_ALWAYS_INLINE bool operator==(const LoadingInfo& rhs) const { return m_pResource == rhs.m_pResource; }
-    EZ_ALWAYS_INLINE bool operator<(const LoadingInfo& rhs) const { return m_fPriority < rhs.m_fPriority; }
-  };
   static void EnsureResourceLoadingState(ezResource* pResource, const ezResourceState RequestedState);
   static void PreloadResource(ezResource* pResource);
   static void InternalPreloadResource(ezResource* pResource, bool bHighestPriority);
@@ -452,9 +493,9 @@ private:
   template <typename ResourceType>
   static ResourceType* GetResource(const char* szResourceID, bool bIsReloadable);
   static ezResource* GetResource(const ezRTTI* pRtti, const char* szResourceID, bool bIsReloadable);
-  static void RunWorkerTask(ezResource* pResource);
+  static void RunWorkerTask(bool bLaunchAdditionalTask = false);
   static void UpdateLoadingDeadlines();
-  static void ReverseBubbleSortStep(ezDeque<LoadingInfo>& data);
+  static void UpdateLoadingPriority(ezResource* pResource);
   static bool ReloadResource(ezResource* pResource, bool bForce);
 
   static void SetupWorkerTasks();
@@ -470,6 +511,7 @@ private:
   {
     bool m_bIncrementalUnload = true;
     bool m_bAllowNestedAcquireCached = false;
+    bool m_bMemoryBudgetExhausted = false; ///< Blocks streaming in more quality levels.
 
     ezHybridArray<const ezRTTI*, 8> m_NestedTypes;
   };
@@ -545,6 +545,9 @@ private:
     void UpdateGlobalBounds();
     void UpdateGlobalBoundsAndSpatialData(ezSpatialSystem& spatialSytem);
 
+    // Updates the global bounds and returns true if the spatial data needs to be updated. Does not touch the spatial system.
+    bool UpdateGlobalBoundsAndCheckSpatialData(bool& out_bWasAlwaysVisible);
+
     void UpdateVelocity(const ezSimdFloat& fInvDeltaSeconds);
 
     void UpdateSpatialData(ezSpatialSystem& spatialSystem, bool bWasAlwaysVisible, bool bIsAlwaysVisible);
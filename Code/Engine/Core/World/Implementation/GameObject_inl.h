@@ -560,6 +560,17 @@ EZ_FORCE_INLINE void ezGameObject::TransformationData::UpdateGlobalBounds()
 }
 
 EZ_FORCE_INLINE void ezGameObject::TransformationData::UpdateGlobalBoundsAndSpatialData(ezSpatialSystem& spatialSytem)
+{
+  bool bWasAlwaysVisible = false;
+  if (UpdateGlobalBoundsAndCheckSpatialData(bWasAlwaysVisible))
+  {
+    bool bIsAlwaysVisible = m_globalBounds.m_BoxHalfExtents.w() != ezSimdFloat::Zero();
+
+    UpdateSpatialData(spatialSytem, bWasAlwaysVisible, bIsAlwaysVisible);
+  }
+}
+
+EZ_FORCE_INLINE bool ezGameObject::TransformationData::UpdateGlobalBoundsAndCheckSpatialData(bool& out_bWasAlwaysVisible)
 {
   ezSimdBBoxSphere oldGlobalBounds = m_globalBounds;
 
@@ -570,11 +581,11 @@ EZ_FORCE_INLINE void ezGameObject::TransformationData::UpdateGlobalBoundsAndSpat
   if ((m_globalBounds.m_CenterAndRadius != oldGlobalBounds.m_CenterAndRadius || m_globalBounds.m_BoxHalfExtents != oldGlobalBounds.m_BoxHalfExtents)
         .AnySet<4>())
   {
-    bool bWasAlwaysVisible = oldGlobalBounds.m_BoxHalfExtents.w() != ezSimdFloat::Zero();
-    bool bIsAlwaysVisible = m_globalBounds.m_BoxHalfExtents.w() != ezSimdFloat::Zero();
-
-    UpdateSpatialData(spatialSytem, bWasAlwaysVisible, bIsAlwaysVisible);
+    out_bWasAlwaysVisible = oldGlobalBounds.m_BoxHalfExtents.w() != ezSimdFloat::Zero();
+    return true;
   }
+
+  return false;
 }
 
 EZ_ALWAYS_INLINE void ezGameObject::TransformationData::UpdateVelocity(const ezSimdFloat& fInvDeltaSeconds)
@@ -217,6 +217,63 @@ void ezSpatialSystem::FindVisibleObjects(
 #endif
 }
 
+void ezSpatialSystem::FindVisibleObjects(ezArrayPtr<const ezFrustum> frustums, ezUInt32 uiCategoryBitmask,
+  ezArrayPtr<ezDynamicArray<const ezGameObject*>> out_Objects, QueryStats* pStats /*= nullptr*/) const
+{
+  EZ_ASSERT_DEV(frustums.GetCount() == out_Objects.GetCount(), "Need one output array per frustum");
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  ezStopwatch timer;
+
+  if (pStats != nullptr)
+  {
+    pStats->m_uiTotalNumObjects = m_DataTable.GetCount();
+    pStats->m_uiNumObjectsTested += m_DataAlwaysVisible.GetCount() * frustums.GetCount();
+    pStats->m_uiNumObjectsPassed += m_DataAlwaysVisible.GetCount() * frustums.GetCount();
+  }
+#endif
+
+  FindVisibleObjectsBatchInternal(frustums, uiCategoryBitmask, out_Objects, pStats);
+
+  for (auto pData : m_DataAlwaysVisible)
+  {
+    if ((pData->m_uiCategoryBitmask & uiCategoryBitmask) != 0)
+    {
+      for (auto& objects : out_Objects)
+      {
+        objects.PushBack(pData->m_pObject);
+      }
+    }
+  }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (pStats != nullptr)
+  {
+    pStats->m_TimeTaken = timer.GetRunningTotal();
+  }
+#endif
+}
+
+void ezSpatialSystem::FindVisibleObjectsBatchInternal(ezArrayPtr<const ezFrustum> frustums, ezUInt32 uiCategoryBitmask,
+  ezArrayPtr<ezDynamicArray<const ezGameObject*>> out_Objects, QueryStats* pStats) const
+{
+  for (ezUInt32 i = 0; i < frustums.GetCount(); ++i)
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    QueryStats frustumStats;
+    FindVisibleObjectsInternal(frustums[i], uiCategoryBitmask, out_Objects[i], pStats != nullptr ? &frustumStats : nullptr);
+
+    if (pStats != nullptr)
+    {
+      pStats->m_uiNumObjectsTested += frustumStats.m_uiNumObjectsTested;
+      pStats->m_uiNumObjectsPassed += frustumStats.m_uiNumObjectsPassed;
+    }
+#else
+    FindVisibleObjectsInternal(frustums[i], uiCategoryBitmask, out_Objects[i], nullptr);
+#endif
+  }
+}
+
 
 
 EZ_STATICLINK_FILE(Core, Core_World_Implementation_SpatialSystem);
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <Foundation/Math/Frustum.h>
+#include <Foundation/SimdMath/SimdBSphere.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/SimdMath/SimdMat4f.h>
+
+// Frustum culling helpers that are shared by the spatial system implementations
+namespace ezInternal
+{
+  /// \brief The six frustum planes transposed into SoA layout, so that one sphere can be tested against four planes at once.
+  struct FrustumPlaneData
+  {
+    ezSimdVec4f m_x0x1x2x3;
+    ezSimdVec4f m_y0y1y2y3;
+    ezSimdVec4f m_z0z1z2z3;
+    ezSimdVec4f m_w0w1w2w3;
+
+    ezSimdVec4f m_x4x5x4x5;
+    ezSimdVec4f m_y4y5y4y5;
+    ezSimdVec4f m_z4z5z4z5;
+    ezSimdVec4f m_w4w5w4w5;
+
+    void SetFrustum(const ezFrustum& frustum)
+    {
+      // Compiler is too stupid to properly unroll a constant loop so we do it by hand
+      ezSimdVec4f plane0 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(0).m_vNormal.x)));
+      ezSimdVec4f plane1 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(1).m_vNormal.x)));
+      ezSimdVec4f plane2 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(2).m_vNormal.x)));
+      ezSimdVec4f plane3 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(3).m_vNormal.x)));
+      ezSimdVec4f plane4 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(4).m_vNormal.x)));
+      ezSimdVec4f plane5 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(5).m_vNormal.x)));
+
+      ezSimdMat4f helperMat;
+      helperMat.SetRows(plane0, plane1, plane2, plane3);
+
+      m_x0x1x2x3 = helperMat.m_col0;
+      m_y0y1y2y3 = helperMat.m_col1;
+      m_z0z1z2z3 = helperMat.m_col2;
+      m_w0w1w2w3 = helperMat.m_col3;
+
+      helperMat.SetRows(plane4, plane5, plane4, plane5);
+
+      m_x4x5x4x5 = helperMat.m_col0;
+      m_y4y5y4y5 = helperMat.m_col1;
+      m_z4z5z4z5 = helperMat.m_col2;
+      m_w4w5w4w5 = helperMat.m_col3;
+    }
+  };
+
+  /// \brief Returns true if the sphere is not completely outside of any of the frustum planes.
+  EZ_FORCE_INLINE bool SphereFrustumIntersect(const ezSimdBSphere& sphere, const FrustumPlaneData& planeData)
+  {
+    ezSimdVec4f pos_xxxx(sphere.m_CenterAndRadius.x());
+    ezSimdVec4f pos_yyyy(sphere.m_CenterAndRadius.y());
+    ezSimdVec4f pos_zzzz(sphere.m_CenterAndRadius.z());
+    ezSimdVec4f pos_rrrr(sphere.m_CenterAndRadius.w());
+
+    ezSimdVec4f dot_0123;
+    dot_0123 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
+    dot_0123 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y0y1y2y3, dot_0123);
+    dot_0123 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z0z1z2z3, dot_0123);
+
+    ezSimdVec4f dot_4545;
+    dot_4545 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
+    dot_4545 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y4y5y4y5, dot_4545);
+    dot_4545 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z4z5z4z5, dot_4545);
+
+    ezSimdVec4b cmp_0123 = dot_0123 > pos_rrrr;
+    ezSimdVec4b cmp_4545 = dot_4545 > pos_rrrr;
+    return (cmp_0123 || cmp_4545).NoneSet<4>();
+  }
+
+  /// \brief Returns true if the sphere is completely on the inner side of all frustum planes.
+  EZ_FORCE_INLINE bool SphereInsideFrustum(const ezSimdBSphere& sphere, const FrustumPlaneData& planeData)
+  {
+    ezSimdVec4f pos_xxxx(sphere.m_CenterAndRadius.x());
+    ezSimdVec4f pos_yyyy(sphere.m_CenterAndRadius.y());
+    ezSimdVec4f pos_zzzz(sphere.m_CenterAndRadius.z());
+    ezSimdVec4f neg_rrrr = -ezSimdVec4f(sphere.m_CenterAndRadius.w());
+
+    ezSimdVec4f dot_0123;
+    dot_0123 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
+    dot_0123 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y0y1y2y3, dot_0123);
+    dot_0123 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z0z1z2z3, dot_0123);
+
+    ezSimdVec4f dot_4545;
+    dot_4545 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
+    dot_4545 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y4y5y4y5, dot_4545);
+    dot_4545 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z4z5z4z5, dot_4545);
+
+    ezSimdVec4b cmp_0123 = dot_0123 < neg_rrrr;
+    ezSimdVec4b cmp_4545 = dot_4545 < neg_rrrr;
+    return (cmp_0123 && cmp_4545).AllSet<4>();
+  }
+
+  /// \brief Tests two spheres at once. Bit 0 of the result is set if sphere A intersects the frustum, bit 1 for sphere B.
+  EZ_FORCE_INLINE ezUInt32 SphereFrustumIntersect(const ezSimdBSphere& sphereA, const ezSimdBSphere& sphereB, const FrustumPlaneData& planeData)
+  {
+    ezSimdVec4f posA_xxxx(sphereA.m_CenterAndRadius.x());
+    ezSimdVec4f posA_yyyy(sphereA.m_CenterAndRadius.y());
+    ezSimdVec4f posA_zzzz(sphereA.m_CenterAndRadius.z());
+    ezSimdVec4f posA_rrrr(sphereA.m_CenterAndRadius.w());
+
+    ezSimdVec4f dotA_0123;
+    dotA_0123 = ezSimdVec4f::MulAdd(posA_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
+    dotA_0123 = ezSimdVec4f::MulAdd(posA_yyyy, planeData.m_y0y1y2y3, dotA_0123);
+    dotA_0123 = ezSimdVec4f::MulAdd(posA_zzzz, planeData.m_z0z1z2z3, dotA_0123);
+
+    ezSimdVec4f posB_xxxx(sphereB.m_CenterAndRadius.x());
+    ezSimdVec4f posB_yyyy(sphereB.m_CenterAndRadius.y());
+    ezSimdVec4f posB_zzzz(sphereB.m_CenterAndRadius.z());
+    ezSimdVec4f posB_rrrr(sphereB.m_CenterAndRadius.w());
+
+    ezSimdVec4f dotB_0123;
+    dotB_0123 = ezSimdVec4f::MulAdd(posB_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
+    dotB_0123 = ezSimdVec4f::MulAdd(posB_yyyy, planeData.m_y0y1y2y3, dotB_0123);
+    dotB_0123 = ezSimdVec4f::MulAdd(posB_zzzz, planeData.m_z0z1z2z3, dotB_0123);
+
+    ezSimdVec4f posAB_xxxx = posA_xxxx.GetCombined<ezSwizzle::XXXX>(posB_xxxx);
+    ezSimdVec4f posAB_yyyy = posA_yyyy.GetCombined<ezSwizzle::XXXX>(posB_yyyy);
+    ezSimdVec4f posAB_zzzz = posA_zzzz.GetCombined<ezSwizzle::XXXX>(posB_zzzz);
+    ezSimdVec4f posAB_rrrr = posA_rrrr.GetCombined<ezSwizzle::XXXX>(posB_rrrr);
+
+    ezSimdVec4f dot_A45B45;
+    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
+    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_yyyy, planeData.m_y4y5y4y5, dot_A45B45);
+    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_zzzz, planeData.m_z4z5z4z5, dot_A45B45);
+
+    ezSimdVec4b cmp_A0123 = dotA_0123 > posA_rrrr;
+    ezSimdVec4b cmp_B0123 = dotB_0123 > posB_rrrr;
+    ezSimdVec4b cmp_A45B45 = dot_A45B45 > posAB_rrrr;
+
+    ezSimdVec4b cmp_A45 = cmp_A45B45.Get<ezSwizzle::XYXY>();
+    ezSimdVec4b cmp_B45 = cmp_A45B45.Get<ezSwizzle::ZWZW>();
+
+    ezUInt32 result = (cmp_A0123 || cmp_A45).NoneSet<4>() ? 1 : 0;
+    result |= (cmp_B0123 || cmp_B45).NoneSet<4>() ? 2 : 0;
+
+    return result;
+  }
+} // namespace ezInternal
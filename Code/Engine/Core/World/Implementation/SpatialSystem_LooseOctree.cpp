@@ -0,0 +1,551 @@
+#include <CorePCH.h>
+
+#include <Core/World/Implementation/SpatialSystemCulling.h>
+#include <Core/World/SpatialSystem_LooseOctree.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+
+struct ezSpatialSystem_LooseOctree::SpatialUserData
+{
+  Node* m_pNode = nullptr;
+  ezUInt32 m_uiDataIndex = 0;
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+struct ezSpatialSystem_LooseOctree::Node
+{
+  Node(Node* pParent, ezUInt32 uiChildIndex, const ezSimdVec4f& centerAndHalfExtent, ezAllocatorBase* pAllocator, ezAllocatorBase* pAlignedAllocator)
+    : m_pParent(pParent)
+    , m_uiDepth(pParent != nullptr ? pParent->m_uiDepth + 1 : 0)
+    , m_uiChildIndex(uiChildIndex)
+    , m_CenterAndHalfExtent(centerAndHalfExtent)
+    , m_BoundingSpheres(pAlignedAllocator)
+    , m_DataPointers(pAllocator)
+    , m_CategoryBitmasks(pAllocator)
+  {
+    const ezSimdFloat fLooseHalfExtent = centerAndHalfExtent.w() * ezSimdFloat(2.0f);
+
+    m_LooseBox.SetCenterAndHalfExtents(centerAndHalfExtent, ezSimdVec4f(fLooseHalfExtent));
+    m_LooseSphere = ezSimdBSphere(centerAndHalfExtent, fLooseHalfExtent * ezSimdFloat(1.7320508f));
+  }
+
+  EZ_ALWAYS_INLINE bool IsRoot() const { return m_pParent == nullptr; }
+
+  EZ_ALWAYS_INLINE ezSimdFloat GetHalfExtent() const { return m_CenterAndHalfExtent.w(); }
+
+  ezSimdBBox m_LooseBox;
+  ezSimdBSphere m_LooseSphere;
+  ezSimdVec4f m_CenterAndHalfExtent; // w = half extent of the area covered by this node, the loose bounds are twice as large
+
+  Node* m_pParent = nullptr;
+  Node* m_pChildren[8] = {};
+  ezUInt32 m_uiDepth = 0;
+  ezUInt32 m_uiChildIndex = 0;
+
+  ezUInt32 m_uiNumObjectsInSubtree = 0;
+  ezUInt32 m_uiCategoryBitmask = 0; ///< Combined bitmask of all objects in this node and its children. Only reset when the node is deleted.
+
+  ezDynamicArray<ezSimdBSphere> m_BoundingSpheres;
+  ezDynamicArray<ezSpatialData*> m_DataPointers;
+  ezDynamicArray<ezUInt32> m_CategoryBitmasks;
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+  /// Tests all objects of a node that intersects the frustum, two at a time.
+  template <typename Node>
+  EZ_FORCE_INLINE void CullObjects(const Node& node, ezUInt32 uiCategoryBitmask, const ezInternal::FrustumPlaneData& planeData,
+    ezDynamicArray<const ezGameObject*>& out_Objects, ezUInt32& inout_uiNumObjectsPassed)
+  {
+    const ezSimdBSphere* pBoundingSpheres = node.m_BoundingSpheres.GetData();
+    const ezUInt32* pCategoryBitmasks = node.m_CategoryBitmasks.GetData();
+    const ezUInt32 numSpheres = node.m_BoundingSpheres.GetCount();
+
+    ezUInt32 currentIndex = 0;
+
+    while (currentIndex < numSpheres)
+    {
+      if (numSpheres - currentIndex >= 32)
+      {
+        ezUInt32 mask = 0;
+
+        for (ezUInt32 i = 0; i < 32; i += 2)
+        {
+          mask |= ezInternal::SphereFrustumIntersect(pBoundingSpheres[currentIndex + i + 0], pBoundingSpheres[currentIndex + i + 1], planeData) << i;
+        }
+
+        while (mask > 0)
+        {
+          ezUInt32 i = ezMath::FirstBitLow(mask) + currentIndex;
+          mask &= mask - 1;
+
+          if ((pCategoryBitmasks[i] & uiCategoryBitmask) != 0)
+          {
+            out_Objects.PushBack(node.m_DataPointers[i]->m_pObject);
+            ++inout_uiNumObjectsPassed;
+          }
+        }
+
+        currentIndex += 32;
+      }
+      else
+      {
+        ezUInt32 i = currentIndex;
+        ++currentIndex;
+
+        if ((pCategoryBitmasks[i] & uiCategoryBitmask) == 0 || !ezInternal::SphereFrustumIntersect(pBoundingSpheres[i], planeData))
+          continue;
+
+        out_Objects.PushBack(node.m_DataPointers[i]->m_pObject);
+        ++inout_uiNumObjectsPassed;
+      }
+    }
+  }
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezSpatialSystem_LooseOctree, 1, ezRTTINoAllocator)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+ezSpatialSystem_LooseOctree::ezSpatialSystem_LooseOctree(float fRootHalfExtent /*= 65536.0f*/, float fMinNodeHalfExtent /*= 16.0f*/)
+  : m_AlignedAllocator("Spatial System Aligned", ezFoundation::GetAlignedAllocator())
+  , m_fRootHalfExtent(fRootHalfExtent)
+{
+  EZ_CHECK_AT_COMPILETIME(sizeof(ezSpatialSystem_LooseOctree::SpatialUserData) <= sizeof(ezSpatialData::m_uiUserData));
+  EZ_ASSERT_DEV(fRootHalfExtent > 0.0f && fMinNodeHalfExtent > 0.0f, "Invalid octree extents");
+
+  for (float fHalfExtent = fRootHalfExtent * 0.5f; fHalfExtent >= fMinNodeHalfExtent; fHalfExtent *= 0.5f)
+  {
+    ++m_uiMaxDepth;
+  }
+
+  m_pRoot = EZ_NEW(&m_AlignedAllocator, Node, nullptr, 0, ezSimdVec4f(0.0f, 0.0f, 0.0f, fRootHalfExtent), &m_Allocator, &m_AlignedAllocator);
+}
+
+ezSpatialSystem_LooseOctree::~ezSpatialSystem_LooseOctree()
+{
+  DeleteNode(m_pRoot);
+}
+
+ezResult ezSpatialSystem_LooseOctree::GetNodeBoxForSpatialData(const ezSpatialDataHandle& hData, ezBoundingBox& out_BoundingBox) const
+{
+  ezSpatialData* pData;
+  if (!m_DataTable.TryGetValue(hData.GetInternalID(), pData))
+    return EZ_FAILURE;
+
+  auto pUserData = reinterpret_cast<SpatialUserData*>(&pData->m_uiUserData[0]);
+  if (pUserData->m_pNode != nullptr)
+  {
+    out_BoundingBox = ezSimdConversion::ToBBox(pUserData->m_pNode->m_LooseBox);
+    return EZ_SUCCESS;
+  }
+
+  return EZ_FAILURE;
+}
+
+void ezSpatialSystem_LooseOctree::GetAllNodeBoxes(ezHybridArray<ezBoundingBox, 16>& out_BoundingBoxes, ezSpatialData::Category filterCategory) const
+{
+  const ezUInt32 uiCategoryBitmask = filterCategory == ezInvalidSpatialDataCategory ? 0xFFFFFFFF : filterCategory.GetBitmask();
+
+  ezSimdBBox infiniteBox;
+  infiniteBox.SetCenterAndHalfExtents(ezSimdVec4f::ZeroVector(), ezSimdVec4f(ezMath::MaxValue<float>()));
+
+  ForEachNode(infiniteBox, uiCategoryBitmask, [&](const Node& node, ezUInt32 uiFilteredCategoryBitmask) {
+    out_BoundingBoxes.ExpandAndGetRef() = ezSimdConversion::ToBBox(node.m_LooseBox);
+    return true;
+  });
+}
+
+void ezSpatialSystem_LooseOctree::FindObjectsInSphereInternal(
+  const ezBoundingSphere& sphere, ezUInt32 uiCategoryBitmask, QueryCallback callback, QueryStats* pStats) const
+{
+  ezSimdBSphere simdSphere(ezSimdConversion::ToVec3(sphere.m_vCenter), sphere.m_fRadius);
+  ezSimdBBox simdBox;
+  simdBox.SetCenterAndHalfExtents(simdSphere.m_CenterAndRadius, simdSphere.m_CenterAndRadius.Get<ezSwizzle::WWWW>());
+
+  ForEachNode(simdBox, uiCategoryBitmask, [&](const Node& node, ezUInt32 uiFilteredCategoryBitmask) {
+    const ezUInt32 numSpheres = node.m_BoundingSpheres.GetCount();
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    if (pStats != nullptr)
+    {
+      pStats->m_uiNumObjectsTested += numSpheres;
+    }
+#endif
+
+    for (ezUInt32 i = 0; i < numSpheres; ++i)
+    {
+      if ((node.m_CategoryBitmasks[i] & uiFilteredCategoryBitmask) == 0 || !simdSphere.Overlaps(node.m_BoundingSpheres[i]))
+        continue;
+
+      if (callback(node.m_DataPointers[i]->m_pObject) == ezVisitorExecution::Stop)
+        return false;
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+      if (pStats != nullptr)
+      {
+        pStats->m_uiNumObjectsPassed++;
+      }
+#endif
+    }
+
+    return true;
+  });
+}
+
+void ezSpatialSystem_LooseOctree::FindObjectsInBoxInternal(
+  const ezBoundingBox& box, ezUInt32 uiCategoryBitmask, QueryCallback callback, QueryStats* pStats) const
+{
+  ezSimdBBox simdBox(ezSimdConversion::ToVec3(box.m_vMin), ezSimdConversion::ToVec3(box.m_vMax));
+
+  ForEachNode(simdBox, uiCategoryBitmask, [&](const Node& node, ezUInt32 uiFilteredCategoryBitmask) {
+    const ezUInt32 numSpheres = node.m_BoundingSpheres.GetCount();
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    if (pStats != nullptr)
+    {
+      pStats->m_uiNumObjectsTested += numSpheres;
+    }
+#endif
+
+    for (ezUInt32 i = 0; i < numSpheres; ++i)
+    {
+      if ((node.m_CategoryBitmasks[i] & uiFilteredCategoryBitmask) == 0 || !simdBox.Overlaps(node.m_BoundingSpheres[i]))
+        continue;
+
+      const ezSpatialData* pData = node.m_DataPointers[i];
+      if (!simdBox.Overlaps(pData->m_Bounds.GetBox()))
+        continue;
+
+      if (callback(pData->m_pObject) == ezVisitorExecution::Stop)
+        return false;
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+      if (pStats != nullptr)
+      {
+        pStats->m_uiNumObjectsPassed++;
+      }
+#endif
+    }
+
+    return true;
+  });
+}
+
+void ezSpatialSystem_LooseOctree::FindVisibleObjectsInternal(
+  const ezFrustum& frustum, ezUInt32 uiCategoryBitmask, ezDynamicArray<const ezGameObject*>& out_Objects, QueryStats* pStats) const
+{
+  ezInternal::FrustumPlaneData planeData;
+  planeData.SetFrustum(frustum);
+
+  ezUInt32 uiNumObjectsTested = 0;
+  ezUInt32 uiNumObjectsPassed = 0;
+
+  struct StackEntry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    const Node* m_pNode;
+    bool m_bFullyInside;
+  };
+
+  ezHybridArray<StackEntry, 64> stack;
+  stack.PushBack({m_pRoot, false});
+
+  while (!stack.IsEmpty())
+  {
+    StackEntry entry = stack.PeekBack();
+    stack.PopBack();
+
+    const Node& node = *entry.m_pNode;
+    if ((node.m_uiCategoryBitmask & uiCategoryBitmask) == 0)
+      continue;
+
+    // the root node also holds the objects outside of the octree, so it can never be culled
+    bool bFullyInside = entry.m_bFullyInside;
+    if (!bFullyInside && !node.IsRoot())
+    {
+      if (!ezInternal::SphereFrustumIntersect(node.m_LooseSphere, planeData))
+        continue;
+
+      bFullyInside = ezInternal::SphereInsideFrustum(node.m_LooseSphere, planeData);
+    }
+
+    const ezUInt32 numSpheres = node.m_BoundingSpheres.GetCount();
+    uiNumObjectsTested += numSpheres;
+
+    if (bFullyInside)
+    {
+      for (ezUInt32 i = 0; i < numSpheres; ++i)
+      {
+        if ((node.m_CategoryBitmasks[i] & uiCategoryBitmask) != 0)
+        {
+          out_Objects.PushBack(node.m_DataPointers[i]->m_pObject);
+          ++uiNumObjectsPassed;
+        }
+      }
+    }
+    else
+    {
+      CullObjects(node, uiCategoryBitmask, planeData, out_Objects, uiNumObjectsPassed);
+    }
+
+    for (const Node* pChild : node.m_pChildren)
+    {
+      if (pChild != nullptr)
+      {
+        stack.PushBack({pChild, bFullyInside});
+      }
+    }
+  }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (pStats != nullptr)
+  {
+    pStats->m_uiNumObjectsTested += uiNumObjectsTested;
+    pStats->m_uiNumObjectsPassed += uiNumObjectsPassed;
+  }
+#endif
+}
+
+void ezSpatialSystem_LooseOctree::SpatialDataAdded(ezSpatialData* pData)
+{
+  AddToNode(GetOrCreateNode(pData->m_Bounds), pData);
+}
+
+void ezSpatialSystem_LooseOctree::SpatialDataRemoved(ezSpatialData* pData)
+{
+  RemoveFromNode(pData);
+}
+
+void ezSpatialSystem_LooseOctree::SpatialDataChanged(ezSpatialData* pData, const ezSimdBBoxSphere& oldBounds, ezUInt32 uiOldCategoryBitmask)
+{
+  auto pUserData = reinterpret_cast<SpatialUserData*>(&pData->m_uiUserData[0]);
+  Node* pNode = pUserData->m_pNode;
+
+  if (pNode != nullptr && pData->m_uiCategoryBitmask != 0 && IsTargetNode(pNode, pData->m_Bounds))
+  {
+    // still in the right node, only patch the cached values
+    const ezUInt32 uiDataIndex = pUserData->m_uiDataIndex;
+    pNode->m_BoundingSpheres[uiDataIndex] = pData->m_Bounds.GetSphere();
+
+    if (pData->m_uiCategoryBitmask != uiOldCategoryBitmask)
+    {
+      pNode->m_CategoryBitmasks[uiDataIndex] = pData->m_uiCategoryBitmask;
+
+      for (Node* pCurrent = pNode; pCurrent != nullptr; pCurrent = pCurrent->m_pParent)
+      {
+        pCurrent->m_uiCategoryBitmask |= pData->m_uiCategoryBitmask;
+      }
+    }
+
+    return;
+  }
+
+  RemoveFromNode(pData);
+
+  if (pData->m_uiCategoryBitmask != 0)
+  {
+    AddToNode(GetOrCreateNode(pData->m_Bounds), pData);
+  }
+}
+
+void ezSpatialSystem_LooseOctree::FixSpatialDataPointer(ezSpatialData* pOldPtr, ezSpatialData* pNewPtr)
+{
+  auto pUserData = reinterpret_cast<SpatialUserData*>(&pNewPtr->m_uiUserData[0]);
+  if (pUserData->m_pNode != nullptr)
+  {
+    pUserData->m_pNode->m_DataPointers[pUserData->m_uiDataIndex] = pNewPtr;
+  }
+}
+
+template <typename Functor>
+EZ_FORCE_INLINE void ezSpatialSystem_LooseOctree::ForEachNode(const ezSimdBBox& box, ezUInt32 uiCategoryBitmask, Functor func) const
+{
+  ezHybridArray<const Node*, 64> stack;
+  stack.PushBack(m_pRoot);
+
+  while (!stack.IsEmpty())
+  {
+    const Node* pNode = stack.PeekBack();
+    stack.PopBack();
+
+    const ezUInt32 uiFilteredCategoryBitmask = pNode->m_uiCategoryBitmask & uiCategoryBitmask;
+    if (uiFilteredCategoryBitmask == 0)
+      continue;
+
+    // the root node also holds the objects outside of the octree, so it can never be skipped
+    if (!pNode->IsRoot() && !box.Overlaps(pNode->m_LooseBox))
+      continue;
+
+    if (!pNode->m_DataPointers.IsEmpty())
+    {
+      if (!func(*pNode, uiFilteredCategoryBitmask))
+        return;
+    }
+
+    for (const Node* pChild : pNode->m_pChildren)
+    {
+      if (pChild != nullptr)
+      {
+        stack.PushBack(pChild);
+      }
+    }
+  }
+}
+
+ezSpatialSystem_LooseOctree::Node* ezSpatialSystem_LooseOctree::GetOrCreateNode(const ezSimdBBoxSphere& bounds)
+{
+  const ezUInt32 uiDepth = ComputeDepth(bounds);
+
+  const ezSimdVec4f center = bounds.m_CenterAndRadius;
+
+  Node* pNode = m_pRoot;
+  while (pNode->m_uiDepth < uiDepth)
+  {
+    const ezSimdVec4b greaterEqual = center >= pNode->m_CenterAndHalfExtent;
+
+    ezUInt32 uiChildIndex = 0;
+    uiChildIndex |= greaterEqual.x() ? 1 : 0;
+    uiChildIndex |= greaterEqual.y() ? 2 : 0;
+    uiChildIndex |= greaterEqual.z() ? 4 : 0;
+
+    Node* pChild = pNode->m_pChildren[uiChildIndex];
+    if (pChild == nullptr)
+    {
+      const ezSimdFloat fChildHalfExtent = pNode->GetHalfExtent() * ezSimdFloat(0.5f);
+      const ezSimdVec4f offset = ezSimdVec4f::Select(greaterEqual, ezSimdVec4f(fChildHalfExtent), -ezSimdVec4f(fChildHalfExtent));
+
+      ezSimdVec4f childCenter = pNode->m_CenterAndHalfExtent + offset;
+      childCenter.SetW(fChildHalfExtent);
+
+      pChild = EZ_NEW(&m_AlignedAllocator, Node, pNode, uiChildIndex, childCenter, &m_Allocator, &m_AlignedAllocator);
+      pNode->m_pChildren[uiChildIndex] = pChild;
+    }
+
+    pNode = pChild;
+  }
+
+  return pNode;
+}
+
+bool ezSpatialSystem_LooseOctree::IsTargetNode(const Node* pNode, const ezSimdBBoxSphere& bounds) const
+{
+  if (ComputeDepth(bounds) != pNode->m_uiDepth)
+    return false;
+
+  if (pNode->IsRoot())
+    return true;
+
+  // the node has to contain the center, otherwise the object could stick out of the loose bounds
+  const ezSimdVec4f distance = (bounds.m_CenterAndRadius - pNode->m_CenterAndHalfExtent).Abs();
+  return (distance <= ezSimdVec4f(pNode->GetHalfExtent())).AllSet<3>();
+}
+
+ezUInt32 ezSpatialSystem_LooseOctree::ComputeDepth(const ezSimdBBoxSphere& bounds) const
+{
+  // objects outside of the octree are stored in the root node
+  if (!(bounds.m_CenterAndRadius.Abs() <= ezSimdVec4f(m_fRootHalfExtent)).AllSet<3>())
+    return 0;
+
+  // Go down as long as the object is not larger than the node. With the center inside the node, the object's box and sphere are then
+  // always inside the loose bounds.
+  const float fMaxExtent = bounds.m_BoxHalfExtents.HorizontalMax<3>().Max(bounds.m_CenterAndRadius.w());
+
+  ezUInt32 uiDepth = 0;
+  for (float fHalfExtent = m_fRootHalfExtent * 0.5f; uiDepth < m_uiMaxDepth && fHalfExtent >= fMaxExtent; fHalfExtent *= 0.5f)
+  {
+    ++uiDepth;
+  }
+
+  return uiDepth;
+}
+
+void ezSpatialSystem_LooseOctree::AddToNode(Node* pNode, ezSpatialData* pData)
+{
+  auto pUserData = reinterpret_cast<SpatialUserData*>(&pData->m_uiUserData[0]);
+  EZ_ASSERT_DEBUG(pUserData->m_pNode == nullptr, "Data can't be in multiple nodes");
+
+  pUserData->m_pNode = pNode;
+  pUserData->m_uiDataIndex = pNode->m_DataPointers.GetCount();
+
+  pNode->m_BoundingSpheres.PushBack(pData->m_Bounds.GetSphere());
+  pNode->m_DataPointers.PushBack(pData);
+  pNode->m_CategoryBitmasks.PushBack(pData->m_uiCategoryBitmask);
+
+  for (Node* pCurrent = pNode; pCurrent != nullptr; pCurrent = pCurrent->m_pParent)
+  {
+    ++pCurrent->m_uiNumObjectsInSubtree;
+    pCurrent->m_uiCategoryBitmask |= pData->m_uiCategoryBitmask;
+  }
+}
+
+void ezSpatialSystem_LooseOctree::RemoveFromNode(ezSpatialData* pData)
+{
+  auto pUserData = reinterpret_cast<SpatialUserData*>(&pData->m_uiUserData[0]);
+  Node* pNode = pUserData->m_pNode;
+  if (pNode == nullptr)
+    return;
+
+  const ezUInt32 uiDataIndex = pUserData->m_uiDataIndex;
+  if (uiDataIndex != pNode->m_DataPointers.GetCount() - 1)
+  {
+    ezSpatialData* pLastData = pNode->m_DataPointers.PeekBack();
+    reinterpret_cast<SpatialUserData*>(&pLastData->m_uiUserData[0])->m_uiDataIndex = uiDataIndex;
+  }
+
+  pNode->m_BoundingSpheres.RemoveAtAndSwap(uiDataIndex);
+  pNode->m_DataPointers.RemoveAtAndSwap(uiDataIndex);
+  pNode->m_CategoryBitmasks.RemoveAtAndSwap(uiDataIndex);
+
+  pUserData->m_pNode = nullptr;
+  pUserData->m_uiDataIndex = ezInvalidIndex;
+
+  // prune the topmost node that became empty, all its children are empty as well
+  Node* pEmptyNode = nullptr;
+  for (Node* pCurrent = pNode; pCurrent != nullptr; pCurrent = pCurrent->m_pParent)
+  {
+    if (--pCurrent->m_uiNumObjectsInSubtree == 0)
+    {
+      pEmptyNode = pCurrent;
+    }
+  }
+
+  if (pEmptyNode == m_pRoot)
+  {
+    for (Node*& pChild : m_pRoot->m_pChildren)
+    {
+      if (pChild != nullptr)
+      {
+        DeleteNode(pChild);
+        pChild = nullptr;
+      }
+    }
+
+    m_pRoot->m_uiCategoryBitmask = 0;
+  }
+  else if (pEmptyNode != nullptr)
+  {
+    pEmptyNode->m_pParent->m_pChildren[pEmptyNode->m_uiChildIndex] = nullptr;
+    DeleteNode(pEmptyNode);
+  }
+}
+
+void ezSpatialSystem_LooseOctree::DeleteNode(Node* pNode)
+{
+  for (Node* pChild : pNode->m_pChildren)
+  {
+    if (pChild != nullptr)
+    {
+      DeleteNode(pChild);
+    }
+  }
+
+  EZ_DELETE(&m_AlignedAllocator, pNode);
+}
+
+
+EZ_STATICLINK_FILE(Core, Core_World_Implementation_SpatialSystem_LooseOctree);
@@ -1,8 +1,10 @@
 #include <CorePCH.h>
 
+#include <Core/World/Implementation/SpatialSystemCulling.h>
 #include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Foundation/Containers/HashSet.h>
 #include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 namespace
 {
@@ -39,86 +41,6 @@ namespace
 
     return ezSimdBBox(bmin, bmax);
   }
-
-  struct PlaneData
-  {
-    ezSimdVec4f m_x0x1x2x3;
-    ezSimdVec4f m_y0y1y2y3;
-    ezSimdVec4f m_z0z1z2z3;
-    ezSimdVec4f m_w0w1w2w3;
-
-    ezSimdVec4f m_x4x5x4x5;
-    ezSimdVec4f m_y4y5y4y5;
-    ezSimdVec4f m_z4z5z4z5;
-    ezSimdVec4f m_w4w5w4w5;
-  };
-
-  EZ_FORCE_INLINE bool SphereFrustumIntersect(const ezSimdBSphere& sphere, const PlaneData& planeData)
-  {
-    ezSimdVec4f pos_xxxx(sphere.m_CenterAndRadius.x());
-    ezSimdVec4f pos_yyyy(sphere.m_CenterAndRadius.y());
-    ezSimdVec4f pos_zzzz(sphere.m_CenterAndRadius.z());
-    ezSimdVec4f pos_rrrr(sphere.m_CenterAndRadius.w());
-
-    ezSimdVec4f dot_0123;
-    dot_0123 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dot_0123 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y0y1y2y3, dot_0123);
-    dot_0123 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z0z1z2z3, dot_0123);
-
-    ezSimdVec4f dot_4545;
-    dot_4545 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
-    dot_4545 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y4y5y4y5, dot_4545);
-    dot_4545 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z4z5z4z5, dot_4545);
-
-    ezSimdVec4b cmp_0123 = dot_0123 > pos_rrrr;
-    ezSimdVec4b cmp_4545 = dot_4545 > pos_rrrr;
-    return (cmp_0123 || cmp_4545).NoneSet<4>();
-  }
-
-  EZ_FORCE_INLINE ezUInt32 SphereFrustumIntersect(const ezSimdBSphere& sphereA, const ezSimdBSphere& sphereB, const PlaneData& planeData)
-  {
-    ezSimdVec4f posA_xxxx(sphereA.m_CenterAndRadius.x());
-    ezSimdVec4f posA_yyyy(sphereA.m_CenterAndRadius.y());
-    ezSimdVec4f posA_zzzz(sphereA.m_CenterAndRadius.z());
-    ezSimdVec4f posA_rrrr(sphereA.m_CenterAndRadius.w());
-
-    ezSimdVec4f dotA_0123;
-    dotA_0123 = ezSimdVec4f::MulAdd(posA_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dotA_0123 = ezSimdVec4f::MulAdd(posA_yyyy, planeData.m_y0y1y2y3, dotA_0123);
-    dotA_0123 = ezSimdVec4f::MulAdd(posA_zzzz, planeData.m_z0z1z2z3, dotA_0123);
-
-    ezSimdVec4f posB_xxxx(sphereB.m_CenterAndRadius.x());
-    ezSimdVec4f posB_yyyy(sphereB.m_CenterAndRadius.y());
-    ezSimdVec4f posB_zzzz(sphereB.m_CenterAndRadius.z());
-    ezSimdVec4f posB_rrrr(sphereB.m_CenterAndRadius.w());
-
-    ezSimdVec4f dotB_0123;
-    dotB_0123 = ezSimdVec4f::MulAdd(posB_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dotB_0123 = ezSimdVec4f::MulAdd(posB_yyyy, planeData.m_y0y1y2y3, dotB_0123);
-    dotB_0123 = ezSimdVec4f::MulAdd(posB_zzzz, planeData.m_z0z1z2z3, dotB_0123);
-
-    ezSimdVec4f posAB_xxxx = posA_xxxx.GetCombined<ezSwizzle::XXXX>(posB_xxxx);
-    ezSimdVec4f posAB_yyyy = posA_yyyy.GetCombined<ezSwizzle::XXXX>(posB_yyyy);
-    ezSimdVec4f posAB_zzzz = posA_zzzz.GetCombined<ezSwizzle::XXXX>(posB_zzzz);
-    ezSimdVec4f posAB_rrrr = posA_rrrr.GetCombined<ezSwizzle::XXXX>(posB_rrrr);
-
-    ezSimdVec4f dot_A45B45;
-    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
-    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_yyyy, planeData.m_y4y5y4y5, dot_A45B45);
-    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_zzzz, planeData.m_z4z5z4z5, dot_A45B45);
-
-    ezSimdVec4b cmp_A0123 = dotA_0123 > posA_rrrr;
-    ezSimdVec4b cmp_B0123 = dotB_0123 > posB_rrrr;
-    ezSimdVec4b cmp_A45B45 = dot_A45B45 > posAB_rrrr;
-
-    ezSimdVec4b cmp_A45 = cmp_A45B45.Get<ezSwizzle::XYXY>();
-    ezSimdVec4b cmp_B45 = cmp_A45B45.Get<ezSwizzle::ZWZW>();
-
-    ezUInt32 result = (cmp_A0123 || cmp_A45).NoneSet<4>() ? 1 : 0;
-    result |= (cmp_B0123 || cmp_B45).NoneSet<4>() ? 2 : 0;
-
-    return result;
-  }
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -291,6 +213,103 @@ struct ezSpatialSystem_RegularGrid::CellKeyHashHelper
 
 //////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+  template <typename Cell>
+  struct VisibleCell
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    const Cell* m_pCell;
+    ezUInt32 m_uiCategoryBitmask;
+    ezUInt32 m_uiFrustumBitmask;
+    ezUInt32 m_uiNumObjects;
+  };
+
+  /// Tests the objects of the given cells against all frustums in the cell's frustum bitmask. The cell's spheres are still in the cache
+  /// when they are tested against the next frustum, so the data only has to be loaded once for all frustums.
+  template <typename Cell>
+  void CullCells(ezArrayPtr<const VisibleCell<Cell>> cells, const ezInternal::FrustumPlaneData* pPlaneData,
+    ezArrayPtr<ezDynamicArray<const ezGameObject*>> out_Objects, ezUInt32& inout_uiNumObjectsTested, ezUInt32& inout_uiNumObjectsPassed)
+  {
+    for (auto& visibleCell : cells)
+    {
+      const Cell& cell = *visibleCell.m_pCell;
+
+      ezUInt32 categoryMask = visibleCell.m_uiCategoryBitmask;
+      while (categoryMask > 0)
+      {
+        ezUInt32 category = ezMath::FirstBitLow(categoryMask);
+        categoryMask &= categoryMask - 1;
+
+        auto& boundingSpheres = cell.m_BoundingSpheres[category];
+        auto& dataPointers = cell.m_DataPointers[category];
+
+        const ezUInt32 numSpheres = boundingSpheres.GetCount();
+
+        ezUInt32 frustumMask = visibleCell.m_uiFrustumBitmask;
+        while (frustumMask > 0)
+        {
+          ezUInt32 uiFrustumIndex = ezMath::FirstBitLow(frustumMask);
+          frustumMask &= frustumMask - 1;
+
+          const ezInternal::FrustumPlaneData& planeData = pPlaneData[uiFrustumIndex];
+          ezDynamicArray<const ezGameObject*>& objects = out_Objects[uiFrustumIndex];
+
+          inout_uiNumObjectsTested += numSpheres;
+
+          ezUInt32 currentIndex = 0;
+
+          while (currentIndex < numSpheres)
+          {
+            if (numSpheres - currentIndex >= 32)
+            {
+              ezUInt32 mask = 0;
+
+              for (ezUInt32 i = 0; i < 32; i += 2)
+              {
+                auto& objectSphereA = boundingSpheres[currentIndex + i + 0];
+                auto& objectSphereB = boundingSpheres[currentIndex + i + 1];
+
+                mask |= ezInternal::SphereFrustumIntersect(objectSphereA, objectSphereB, planeData) << i;
+              }
+
+              while (mask > 0)
+              {
+                ezUInt32 i = ezMath::FirstBitLow(mask);
+                mask &= mask - 1;
+
+                ezSpatialData* pData = dataPointers[currentIndex + i];
+                objects.PushBack(pData->m_pObject);
+
+                inout_uiNumObjectsPassed++;
+              }
+
+              currentIndex += 32;
+            }
+            else
+            {
+              ezUInt32 i = currentIndex;
+              ++currentIndex;
+
+              auto& objectSphere = boundingSpheres[i];
+              if (!ezInternal::SphereFrustumIntersect(objectSphere, planeData))
+                continue;
+
+              ezSpatialData* pData = dataPointers[i];
+              objects.PushBack(pData->m_pObject);
+
+              inout_uiNumObjectsPassed++;
+            }
+          }
+        }
+      }
+    }
+  }
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezSpatialSystem_RegularGrid, 1, ezRTTINoAllocator)
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 
@@ -446,125 +465,172 @@ void ezSpatialSystem_RegularGrid::FindObjectsInBoxInternal(
 void ezSpatialSystem_RegularGrid::FindVisibleObjectsInternal(
   const ezFrustum& frustum, ezUInt32 uiCategoryBitmask, ezDynamicArray<const ezGameObject*>& out_Objects, QueryStats* pStats) const
 {
-  ezVec3 cornerPoints[8];
-  frustum.ComputeCornerPoints(cornerPoints);
+  FindVisibleObjectsBatchInternal(ezMakeArrayPtr(&frustum, 1), uiCategoryBitmask, ezMakeArrayPtr(&out_Objects, 1), pStats);
+}
 
-  ezSimdVec4f simdCornerPoints[8];
-  for (ezUInt32 i = 0; i < 8; ++i)
+void ezSpatialSystem_RegularGrid::FindVisibleObjectsBatchInternal(ezArrayPtr<const ezFrustum> frustums, ezUInt32 uiCategoryBitmask,
+  ezArrayPtr<ezDynamicArray<const ezGameObject*>> out_Objects, QueryStats* pStats) const
+{
+  // the frustum bitmask of a cell limits one pass to 32 frustums
+  const ezUInt32 uiMaxFrustumsPerPass = 32;
+  if (frustums.GetCount() > uiMaxFrustumsPerPass)
   {
-    simdCornerPoints[i] = ezSimdConversion::ToVec3(cornerPoints[i]);
+    for (ezUInt32 uiStart = 0; uiStart < frustums.GetCount(); uiStart += uiMaxFrustumsPerPass)
+    {
+      const ezUInt32 uiCount = ezMath::Min(uiMaxFrustumsPerPass, frustums.GetCount() - uiStart);
+      FindVisibleObjectsBatchInternal(frustums.GetSubArray(uiStart, uiCount), uiCategoryBitmask, out_Objects.GetSubArray(uiStart, uiCount), pStats);
+    }
+
+    return;
   }
 
+  ezInternal::FrustumPlaneData planeData[uiMaxFrustumsPerPass];
   ezSimdBBox simdBox;
-  simdBox.SetFromPoints(simdCornerPoints, 8);
+  simdBox.SetInvalid();
 
-  PlaneData planeData;
+  for (ezUInt32 uiFrustumIndex = 0; uiFrustumIndex < frustums.GetCount(); ++uiFrustumIndex)
   {
-    // Compiler is too stupid to properly unroll a constant loop so we do it by hand
-    ezSimdVec4f plane0 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(0).m_vNormal.x)));
-    ezSimdVec4f plane1 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(1).m_vNormal.x)));
-    ezSimdVec4f plane2 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(2).m_vNormal.x)));
-    ezSimdVec4f plane3 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(3).m_vNormal.x)));
-    ezSimdVec4f plane4 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(4).m_vNormal.x)));
-    ezSimdVec4f plane5 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(5).m_vNormal.x)));
-
-    ezSimdMat4f helperMat;
-    helperMat.SetRows(plane0, plane1, plane2, plane3);
-
-    planeData.m_x0x1x2x3 = helperMat.m_col0;
-    planeData.m_y0y1y2y3 = helperMat.m_col1;
-    planeData.m_z0z1z2z3 = helperMat.m_col2;
-    planeData.m_w0w1w2w3 = helperMat.m_col3;
-
-    helperMat.SetRows(plane4, plane5, plane4, plane5);
-
-    planeData.m_x4x5x4x5 = helperMat.m_col0;
-    planeData.m_y4y5y4y5 = helperMat.m_col1;
-    planeData.m_z4z5z4z5 = helperMat.m_col2;
-    planeData.m_w4w5w4w5 = helperMat.m_col3;
+    const ezFrustum& frustum = frustums[uiFrustumIndex];
+
+    ezVec3 cornerPoints[8];
+    frustum.ComputeCornerPoints(cornerPoints);
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+    {
+      simdBox.ExpandToInclude(ezSimdConversion::ToVec3(cornerPoints[i]));
+    }
+
+    planeData[uiFrustumIndex].SetFrustum(frustum);
   }
 
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-  ezUInt32 uiNumObjectsTested = 0;
-  ezUInt32 uiNumObjectsPassed = 0;
-#endif
+  // Find all cells that are visible in at least one frustum. This is cheap compared to testing the objects inside the cells.
+  ezHybridArray<VisibleCell<Cell>, 256> visibleCells;
+  ezUInt32 uiNumObjectsInVisibleCells = 0;
 
   ForEachCellInBox(
     simdBox, uiCategoryBitmask, [&](const ezSimdVec4i& cellIndex, ezUInt64 cellKey, const Cell& cell, ezUInt32 uiFilteredCategoryBitmask) {
       ezSimdBSphere cellSphere = cell.m_Bounds.GetSphere();
-      if (!SphereFrustumIntersect(cellSphere, planeData))
+
+      ezUInt32 uiFrustumBitmask = 0;
+      for (ezUInt32 uiFrustumIndex = 0; uiFrustumIndex < frustums.GetCount(); ++uiFrustumIndex)
+      {
+        if (ezInternal::SphereFrustumIntersect(cellSphere, planeData[uiFrustumIndex]))
+        {
+          uiFrustumBitmask |= EZ_BIT(uiFrustumIndex);
+        }
+      }
+
+      if (uiFrustumBitmask == 0)
         return;
 
-      ezUInt32 filteredMask = uiFilteredCategoryBitmask;
-      while (filteredMask > 0)
+      ezUInt32 uiNumObjects = 0;
+      ezUInt32 categoryMask = uiFilteredCategoryBitmask;
+      while (categoryMask > 0)
       {
-        ezUInt32 category = ezMath::FirstBitLow(filteredMask);
-        filteredMask &= filteredMask - 1;
+        ezUInt32 category = ezMath::FirstBitLow(categoryMask);
+        categoryMask &= categoryMask - 1;
 
-        auto& boundingSpheres = cell.m_BoundingSpheres[category];
-        auto& dataPointers = cell.m_DataPointers[category];
+        uiNumObjects += cell.m_BoundingSpheres[category].GetCount() * ezMath::CountBits(uiFrustumBitmask);
+      }
 
-        const ezUInt32 numSpheres = boundingSpheres.GetCount();
+      visibleCells.PushBack({&cell, uiFilteredCategoryBitmask, uiFrustumBitmask, uiNumObjects});
+      uiNumObjectsInVisibleCells += uiNumObjects;
+    });
 
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-        uiNumObjectsTested += numSpheres;
-#endif
-        ezUInt32 currentIndex = 0;
+  ezUInt32 uiNumObjectsTested = 0;
+  ezUInt32 uiNumObjectsPassed = 0;
 
-        while (currentIndex < numSpheres)
+  const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+  if (uiNumObjectsInVisibleCells < m_uiParallelCullingThreshold || uiNumWorkers <= 1 || visibleCells.GetCount() <= 1)
+  {
+    CullCells<Cell>(visibleCells, planeData, out_Objects, uiNumObjectsTested, uiNumObjectsPassed);
+  }
+  else
+  {
+    // Split the cells into slices with roughly the same number of objects. Every slice writes into its own output arrays,
+    // which are appended in slice order afterwards, so the result is the same as for the single-threaded path.
+    struct Slice
+    {
+      ezUInt32 m_uiFirstCell = 0;
+      ezUInt32 m_uiNumCells = 0;
+      ezUInt32 m_uiNumObjectsTested = 0;
+      ezUInt32 m_uiNumObjectsPassed = 0;
+    };
+
+    const ezUInt32 uiMaxSlices = ezMath::Min(uiNumWorkers * 2, visibleCells.GetCount());
+    const ezUInt32 uiObjectsPerSlice = (uiNumObjectsInVisibleCells + uiMaxSlices - 1) / uiMaxSlices;
+
+    ezHybridArray<Slice, 32> slices;
+    {
+      Slice* pSlice = &slices.ExpandAndGetRef();
+      ezUInt32 uiNumObjectsInSlice = 0;
+
+      for (ezUInt32 i = 0; i < visibleCells.GetCount(); ++i)
+      {
+        if (uiNumObjectsInSlice >= uiObjectsPerSlice)
         {
-          if (numSpheres - currentIndex >= 32)
-          {
-            ezUInt32 mask = 0;
+          pSlice = &slices.ExpandAndGetRef();
+          pSlice->m_uiFirstCell = i;
+          uiNumObjectsInSlice = 0;
+        }
 
-            for (ezUInt32 i = 0; i < 32; i += 2)
-            {
-              auto& objectSphereA = boundingSpheres[currentIndex + i + 0];
-              auto& objectSphereB = boundingSpheres[currentIndex + i + 1];
+        pSlice->m_uiNumCells++;
+        uiNumObjectsInSlice += visibleCells[i].m_uiNumObjects;
+      }
+    }
 
-              mask |= SphereFrustumIntersect(objectSphereA, objectSphereB, planeData) << i;
-            }
+    const ezUInt32 uiNumFrustums = frustums.GetCount();
 
-            while (mask > 0)
-            {
-              ezUInt32 i = ezMath::FirstBitLow(mask);
-              mask &= mask - 1;
+    ezDynamicArray<ezDynamicArray<const ezGameObject*>> sliceObjects;
+    sliceObjects.SetCount(slices.GetCount() * uiNumFrustums);
 
-              ezSpatialData* pData = dataPointers[currentIndex + i];
-              out_Objects.PushBack(pData->m_pObject);
+    auto cullSlices = [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 uiSliceIndex = uiStartIndex; uiSliceIndex < uiEndIndex; ++uiSliceIndex)
+      {
+        Slice& slice = slices[uiSliceIndex];
+        auto cells = visibleCells.GetArrayPtr().GetSubArray(slice.m_uiFirstCell, slice.m_uiNumCells);
+        auto objects = sliceObjects.GetArrayPtr().GetSubArray(uiSliceIndex * uiNumFrustums, uiNumFrustums);
 
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-              uiNumObjectsPassed++;
-#endif
-            }
+        CullCells<Cell>(cells, planeData, objects, slice.m_uiNumObjectsTested, slice.m_uiNumObjectsPassed);
+      }
+    };
 
-            currentIndex += 32;
-          }
-          else
-          {
-            ezUInt32 i = currentIndex;
-            ++currentIndex;
+    ezParallelForParams params;
+    params.uiBinSize = 1;
+    params.uiMaxTasksPerThread = 2;
 
-            auto& objectSphere = boundingSpheres[i];
-            if (!SphereFrustumIntersect(objectSphere, planeData))
-              continue;
+    ezTaskSystem::ParallelForIndexed(0, slices.GetCount(), cullSlices, "Visibility Culling", params);
 
-            ezSpatialData* pData = dataPointers[i];
-            out_Objects.PushBack(pData->m_pObject);
+    for (ezUInt32 uiFrustumIndex = 0; uiFrustumIndex < uiNumFrustums; ++uiFrustumIndex)
+    {
+      auto& objects = out_Objects[uiFrustumIndex];
 
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-            uiNumObjectsPassed++;
-#endif
-          }
-        }
+      ezUInt32 uiTotalCount = objects.GetCount();
+      for (ezUInt32 uiSliceIndex = 0; uiSliceIndex < slices.GetCount(); ++uiSliceIndex)
+      {
+        uiTotalCount += sliceObjects[uiSliceIndex * uiNumFrustums + uiFrustumIndex].GetCount();
       }
-    });
+
+      objects.Reserve(uiTotalCount);
+
+      for (ezUInt32 uiSliceIndex = 0; uiSliceIndex < slices.GetCount(); ++uiSliceIndex)
+      {
+        objects.PushBackRange(sliceObjects[uiSliceIndex * uiNumFrustums + uiFrustumIndex]);
+      }
+    }
+
+    for (auto& slice : slices)
+    {
+      uiNumObjectsTested += slice.m_uiNumObjectsTested;
+      uiNumObjectsPassed += slice.m_uiNumObjectsPassed;
+    }
+  }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   if (pStats != nullptr)
   {
-    pStats->m_uiNumObjectsTested = uiNumObjectsTested;
-    pStats->m_uiNumObjectsPassed = uiNumObjectsPassed;
+    pStats->m_uiNumObjectsTested += uiNumObjectsTested;
+    pStats->m_uiNumObjectsPassed += uiNumObjectsPassed;
   }
 #endif
 }
@@ -692,33 +758,60 @@ EZ_FORCE_INLINE void ezSpatialSystem_RegularGrid::ForEachCellInBox(const ezSimdB
   const ezInt32 iDiffX = diff.x();
   const ezInt32 iDiffY = diff.y();
   const ezInt32 iDiffZ = diff.z();
-  const ezInt32 iNumIterations = iDiffX * iDiffY * iDiffZ;
+  const ezInt64 iNumIterations = (ezInt64)iDiffX * iDiffY * iDiffZ;
 
-  for (ezInt32 i = 0; i < iNumIterations; ++i)
+  // For large boxes, e.g. frustums with a far away far plane, it is cheaper to check all existing cells than to look up every cell index.
+  if (iNumIterations > (ezInt64)m_Cells.GetCount())
   {
-    ezInt32 index = i;
-    ezInt32 z = i / (iDiffX * iDiffY);
-    index -= z * iDiffX * iDiffY;
-    ezInt32 y = index / iDiffX;
-    ezInt32 x = index - (y * iDiffX);
+    const ezSimdVec4i maxIndexPlusOne = maxIndex + ezSimdVec4i(1);
 
-    x += iMinX;
-    y += iMinY;
-    z += iMinZ;
+    for (auto it = m_Cells.GetIterator(); it.IsValid(); ++it)
+    {
+      const ezUInt64 cellKey = it.Key();
+      const ezInt32 x = (ezInt32)((cellKey >> 42) & CELL_INDEX_MASK) - MAX_CELL_INDEX;
+      const ezInt32 y = (ezInt32)((cellKey >> 21) & CELL_INDEX_MASK) - MAX_CELL_INDEX;
+      const ezInt32 z = (ezInt32)(cellKey & CELL_INDEX_MASK) - MAX_CELL_INDEX;
 
-    ezUInt64 cellKey = GetCellKey(x, y, z);
+      ezSimdVec4i cellIndex(x, y, z);
+      if (!((cellIndex >= minIndex) && (cellIndex < maxIndexPlusOne)).AllSet<3>())
+        continue;
 
-    if (auto ppCell = m_Cells.GetValue(cellKey))
-    {
-      const Cell& constCell = *(*ppCell);
+      const Cell& constCell = *it.Value();
       ezUInt32 uiFilteredCategoryBitmask = constCell.m_uiCategoryBitmask & uiCategoryBitmask;
       if (uiFilteredCategoryBitmask != 0)
       {
-        ezSimdVec4i cellIndex(x, y, z);
         func(cellIndex, cellKey, constCell, uiFilteredCategoryBitmask);
       }
     }
   }
+  else
+  {
+    for (ezInt32 i = 0; i < (ezInt32)iNumIterations; ++i)
+    {
+      ezInt32 index = i;
+      ezInt32 z = i / (iDiffX * iDiffY);
+      index -= z * iDiffX * iDiffY;
+      ezInt32 y = index / iDiffX;
+      ezInt32 x = index - (y * iDiffX);
+
+      x += iMinX;
+      y += iMinY;
+      z += iMinZ;
+
+      ezUInt64 cellKey = GetCellKey(x, y, z);
+
+      if (auto ppCell = m_Cells.GetValue(cellKey))
+      {
+        const Cell& constCell = *(*ppCell);
+        ezUInt32 uiFilteredCategoryBitmask = constCell.m_uiCategoryBitmask & uiCategoryBitmask;
+        if (uiFilteredCategoryBitmask != 0)
+        {
+          ezSimdVec4i cellIndex(x, y, z);
+          func(cellIndex, cellKey, constCell, uiFilteredCategoryBitmask);
+        }
+      }
+    }
+  }
 
   ezUInt32 uiFilteredCategoryBitmask = m_pOverflowCell->m_uiCategoryBitmask & uiCategoryBitmask;
   if (uiFilteredCategoryBitmask != 0)
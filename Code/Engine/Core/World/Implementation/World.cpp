@@ -881,6 +881,12 @@ void ezWorld::ProcessQueuedMessages(ezObjectMsgQueueType::Enum queueType)
       ProcessQueuedMessage(queue[i]);
 
       // no need to deallocate these messages, they are allocated through a frame allocator
+
+      // messages that were posted while processing the queue end up in the shards, merge them so they are processed in this pass as well
+      if (i + 1 == queue.GetCount())
+      {
+        queue.MergeShards();
+      }
     }
 
     queue.Clear();
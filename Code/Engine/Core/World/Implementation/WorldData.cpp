@@ -3,6 +3,7 @@
 #include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Core/World/World.h>
 
+#include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Time/DefaultTimeStepSmoothing.h>
 
 namespace ezInternal
@@ -175,6 +176,8 @@ namespace ezInternal
 
       {
         MessageQueue& queue = m_TimedMessageQueues[i];
+        queue.MergeShards();
+
         while (!queue.IsEmpty())
         {
           MessageQueue::Entry& entry = queue.Peek();
@@ -309,12 +312,10 @@ namespace ezInternal
     struct UserData
     {
       ezSimdFloat m_fInvDt;
-      ezSpatialSystem* m_pSpatialSystem;
     };
 
     UserData userData;
     userData.m_fInvDt = fInvDeltaSeconds;
-    userData.m_pSpatialSystem = m_pSpatialSystem.Borrow();
 
     struct RootLevel
     {
@@ -336,19 +337,17 @@ namespace ezInternal
 
     struct RootLevelWithSpatialData
     {
-      EZ_ALWAYS_INLINE static ezVisitorExecution::Enum Visit(ezGameObject::TransformationData* pData, void* pUserData)
+      EZ_ALWAYS_INLINE static void Visit(ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDt, SpatialDataUpdateBuffer& updates)
       {
-        WorldData::UpdateGlobalTransformAndSpatialData(pData, static_cast<UserData*>(pUserData)->m_fInvDt, *static_cast<UserData*>(pUserData)->m_pSpatialSystem);
-        return ezVisitorExecution::Continue;
+        WorldData::UpdateGlobalTransformAndSpatialData(pData, fInvDt, updates);
       }
     };
 
     struct WithParentWithSpatialData
     {
-      EZ_ALWAYS_INLINE static ezVisitorExecution::Enum Visit(ezGameObject::TransformationData* pData, void* pUserData)
+      EZ_ALWAYS_INLINE static void Visit(ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDt, SpatialDataUpdateBuffer& updates)
       {
-        WorldData::UpdateGlobalTransformWithParentAndSpatialData(pData, static_cast<UserData*>(pUserData)->m_fInvDt, *static_cast<UserData*>(pUserData)->m_pSpatialSystem);
-        return ezVisitorExecution::Continue;
+        WorldData::UpdateGlobalTransformWithParentAndSpatialData(pData, fInvDt, updates);
       }
     };
 
@@ -357,8 +356,6 @@ namespace ezInternal
     {
       auto dataPtr = hierarchy.m_Data.GetData();
 
-      // If we have no spatial system, we perform multi-threaded update as we do not
-      // have to acquire a write lock in the process.
       if (m_pSpatialSystem == nullptr)
       {
         TraverseHierarchyLevelMultiThreaded<RootLevel>(*dataPtr[0], &userData);
@@ -370,16 +367,51 @@ namespace ezInternal
       }
       else
       {
-        TraverseHierarchyLevel<RootLevelWithSpatialData>(*dataPtr[0], &userData);
+        // The spatial system is not thread-safe, so the tasks only record which objects changed their bounds.
+        // Every object is updated on exactly one hierarchy level, thus all changes can be applied in one go at the end.
+        TraverseHierarchyLevelMultiThreadedWithSpatialData<RootLevelWithSpatialData>(*dataPtr[0], userData.m_fInvDt);
 
         for (ezUInt32 i = 1; i < hierarchy.m_Data.GetCount(); ++i)
         {
-          TraverseHierarchyLevel<WithParentWithSpatialData>(*dataPtr[i], &userData);
+          TraverseHierarchyLevelMultiThreadedWithSpatialData<WithParentWithSpatialData>(*dataPtr[i], userData.m_fInvDt);
         }
+
+        ApplySpatialDataUpdates();
       }
     }
   }
 
+  void WorldData::FlushSpatialDataUpdates(SpatialDataUpdateBuffer& updates)
+  {
+    if (updates.IsEmpty())
+      return;
+
+    EZ_LOCK(m_SpatialDataUpdatesMutex);
+    m_SpatialDataUpdates.PushBackRange(updates);
+  }
+
+  void WorldData::ApplySpatialDataUpdates()
+  {
+    if (m_SpatialDataUpdates.IsEmpty())
+      return;
+
+    EZ_PROFILE_SCOPE("Apply Spatial Data Updates");
+
+    // the order in which the tasks hand over their changes is random, sort to keep the spatial system deterministic
+    m_SpatialDataUpdates.Sort();
+
+    ezSpatialSystem& spatialSystem = *m_pSpatialSystem;
+    for (const SpatialDataUpdate& update : m_SpatialDataUpdates)
+    {
+      ezGameObject::TransformationData* pData = update.m_pData;
+      const bool bIsAlwaysVisible = pData->m_globalBounds.m_BoxHalfExtents.w() != ezSimdFloat::Zero();
+
+      pData->UpdateSpatialData(spatialSystem, update.m_bWasAlwaysVisible, bIsAlwaysVisible);
+    }
+
+    m_SpatialDataUpdates.Clear();
+  }
+
 } // namespace ezInternal
 
 
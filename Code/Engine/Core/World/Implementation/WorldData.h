@@ -5,6 +5,7 @@
 #include <Foundation/Math/Random.h>
 #include <Foundation/Memory/FrameAllocator.h>
 #include <Foundation/Threading/DelegateTask.h>
+#include <Foundation/Threading/Mutex.h>
 #include <Foundation/Time/Clock.h>
 
 #include <Core/World/GameObject.h>
@@ -136,11 +137,32 @@ namespace ezInternal
     static void UpdateGlobalTransform(ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds);
     static void UpdateGlobalTransformWithParent(ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds);
 
-    static void UpdateGlobalTransformAndSpatialData(ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds, ezSpatialSystem& spatialSystem);
-    static void UpdateGlobalTransformWithParentAndSpatialData(ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds, ezSpatialSystem& spatialSystem);
+    // spatial data updates are collected during the multi-threaded transform update and applied to the spatial system afterwards
+    struct SpatialDataUpdate
+    {
+      EZ_DECLARE_POD_TYPE();
+
+      ezGameObject::TransformationData* m_pData;
+      bool m_bWasAlwaysVisible;
+
+      bool operator<(const SpatialDataUpdate& other) const { return m_pData < other.m_pData; }
+    };
+
+    typedef ezHybridArray<SpatialDataUpdate, 128> SpatialDataUpdateBuffer;
+
+    template <typename VISITOR>
+    void TraverseHierarchyLevelMultiThreadedWithSpatialData(Hierarchy::DataBlockArray& blocks, const ezSimdFloat& fInvDeltaSeconds);
+    void FlushSpatialDataUpdates(SpatialDataUpdateBuffer& updates);
+    void ApplySpatialDataUpdates();
+
+    static void UpdateGlobalTransformAndSpatialData(ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds, SpatialDataUpdateBuffer& updates);
+    static void UpdateGlobalTransformWithParentAndSpatialData(ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds, SpatialDataUpdateBuffer& updates);
 
     void UpdateGlobalTransforms(float fInvDeltaSeconds);
 
+    ezMutex m_SpatialDataUpdatesMutex;
+    ezDynamicArray<SpatialDataUpdate, ezLocalAllocatorWrapper> m_SpatialDataUpdates;
+
     // game object lookups
     ezHashTable<ezUInt64, ezGameObjectId, ezHashHelper<ezUInt64>, ezLocalAllocatorWrapper> m_GlobalKeyToIdTable;
     ezHashTable<ezUInt64, ezHashedString, ezHashHelper<ezUInt64>, ezLocalAllocatorWrapper> m_IdToGlobalKeyTable;
@@ -228,7 +250,8 @@ namespace ezInternal
       ezTime m_Due;
     };
 
-    typedef ezMessageQueue<QueuedMsgMetaData, ezLocalAllocatorWrapper> MessageQueue;
+    // Sharded since messages are posted from many threads at the same time during the async update phase
+    typedef ezShardedMessageQueue<QueuedMsgMetaData, ezLocalAllocatorWrapper> MessageQueue;
     mutable MessageQueue m_MessageQueues[ezObjectMsgQueueType::COUNT];
     mutable MessageQueue m_TimedMessageQueues[ezObjectMsgQueueType::COUNT];
 
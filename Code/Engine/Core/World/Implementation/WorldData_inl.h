@@ -59,6 +59,38 @@ namespace ezInternal
     return ezVisitorExecution::Continue;
   }
 
+  template <typename VISITOR>
+  EZ_FORCE_INLINE void WorldData::TraverseHierarchyLevelMultiThreadedWithSpatialData(
+    Hierarchy::DataBlockArray& blocks, const ezSimdFloat& fInvDeltaSeconds)
+  {
+    ezParallelForParams parallelForParams;
+    parallelForParams.uiBinSize = 100;
+    parallelForParams.uiMaxTasksPerThread = 2;
+    parallelForParams.pTaskAllocator = m_StackAllocator.GetCurrentAllocator();
+
+    ezTaskSystem::ParallelFor(
+      blocks.GetArrayPtr(),
+      [this, &fInvDeltaSeconds](ezArrayPtr<WorldData::Hierarchy::DataBlock> blocksSlice) {
+        // every task collects its changes locally, they are only handed over to the world once the slice is done
+        SpatialDataUpdateBuffer updates;
+
+        for (WorldData::Hierarchy::DataBlock& block : blocksSlice)
+        {
+          ezGameObject::TransformationData* pCurrentData = block.m_pData;
+          ezGameObject::TransformationData* pEndData = block.m_pData + block.m_uiCount;
+
+          while (pCurrentData < pEndData)
+          {
+            VISITOR::Visit(pCurrentData, fInvDeltaSeconds, updates);
+            ++pCurrentData;
+          }
+        }
+
+        FlushSpatialDataUpdates(updates);
+      },
+      "World DataBlock Traversal Task", parallelForParams);
+  }
+
   // static
   EZ_FORCE_INLINE void WorldData::UpdateGlobalTransform(ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds)
   {
@@ -77,20 +109,34 @@ namespace ezInternal
 
   // static
   EZ_FORCE_INLINE void WorldData::UpdateGlobalTransformAndSpatialData(
-    ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds, ezSpatialSystem& spatialSystem)
+    ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds, SpatialDataUpdateBuffer& updates)
   {
     pData->UpdateGlobalTransform();
     pData->UpdateVelocity(fInvDeltaSeconds);
-    pData->UpdateGlobalBoundsAndSpatialData(spatialSystem);
+
+    bool bWasAlwaysVisible = false;
+    if (pData->UpdateGlobalBoundsAndCheckSpatialData(bWasAlwaysVisible))
+    {
+      auto& update = updates.ExpandAndGetRef();
+      update.m_pData = pData;
+      update.m_bWasAlwaysVisible = bWasAlwaysVisible;
+    }
   }
 
   // static
   EZ_FORCE_INLINE void WorldData::UpdateGlobalTransformWithParentAndSpatialData(
-    ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds, ezSpatialSystem& spatialSystem)
+    ezGameObject::TransformationData* pData, const ezSimdFloat& fInvDeltaSeconds, SpatialDataUpdateBuffer& updates)
   {
     pData->UpdateGlobalTransformWithParent();
     pData->UpdateVelocity(fInvDeltaSeconds);
-    pData->UpdateGlobalBoundsAndSpatialData(spatialSystem);
+
+    bool bWasAlwaysVisible = false;
+    if (pData->UpdateGlobalBoundsAndCheckSpatialData(bWasAlwaysVisible))
+    {
+      auto& update = updates.ExpandAndGetRef();
+      update.m_pData = pData;
+      update.m_bWasAlwaysVisible = bWasAlwaysVisible;
+    }
   }
 
   ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -61,6 +61,13 @@ public:
   void FindVisibleObjects(
     const ezFrustum& frustum, ezUInt32 uiCategoryBitmask, ezDynamicArray<const ezGameObject*>& out_Objects, QueryStats* pStats = nullptr) const;
 
+  /// \brief Culls against several frustums at once, e.g. all cascades of a shadow casting light or all faces of a reflection probe.
+  ///
+  /// \a out_Objects must contain one array per frustum. Each array receives the objects that are visible in the respective frustum.
+  /// This is faster than individual queries since the spatial data only needs to be traversed once for all frustums.
+  void FindVisibleObjects(ezArrayPtr<const ezFrustum> frustums, ezUInt32 uiCategoryBitmask,
+    ezArrayPtr<ezDynamicArray<const ezGameObject*>> out_Objects, QueryStats* pStats = nullptr) const;
+
   ///@}
 
 protected:
@@ -70,6 +77,10 @@ protected:
   virtual void FindVisibleObjectsInternal(
     const ezFrustum& frustum, ezUInt32 uiCategoryBitmask, ezDynamicArray<const ezGameObject*>& out_Objects, QueryStats* pStats) const = 0;
 
+  /// \brief The default implementation calls FindVisibleObjectsInternal for every frustum.
+  virtual void FindVisibleObjectsBatchInternal(ezArrayPtr<const ezFrustum> frustums, ezUInt32 uiCategoryBitmask,
+    ezArrayPtr<ezDynamicArray<const ezGameObject*>> out_Objects, QueryStats* pStats) const;
+
   virtual void SpatialDataAdded(ezSpatialData* pData) = 0;
   virtual void SpatialDataRemoved(ezSpatialData* pData) = 0;
   virtual void SpatialDataChanged(ezSpatialData* pData, const ezSimdBBoxSphere& oldBounds, ezUInt32 uiOldCategoryBitmask) = 0;
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <Core/World/SpatialSystem.h>
+
+/// \brief A spatial system that sorts objects into a loose octree.
+///
+/// Every node's bounds are twice as large as the area it covers, so an object is stored in the deepest node that is at least as large as the
+/// object and that contains the object's center. Large objects thus end up in nodes close to the root instead of a global overflow list and
+/// moving objects only switch nodes when they leave the area of their current node.
+/// Objects that are outside of the root node or larger than it are stored in the root node and are always tested.
+///
+/// Set an instance as ezWorldDesc::m_pSpatialSystem to use it instead of the default ezSpatialSystem_RegularGrid.
+class EZ_CORE_DLL ezSpatialSystem_LooseOctree : public ezSpatialSystem
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezSpatialSystem_LooseOctree, ezSpatialSystem);
+
+public:
+  /// \brief The octree covers a cube of size 2 * \a fRootHalfExtent around the origin.
+  /// Nodes are subdivided until their half extent would drop below \a fMinNodeHalfExtent.
+  ezSpatialSystem_LooseOctree(float fRootHalfExtent = 65536.0f, float fMinNodeHalfExtent = 16.0f);
+  ~ezSpatialSystem_LooseOctree();
+
+  /// \brief Returns the loose bounding box of the node that contains the given spatial data. Useful for debug visualizations.
+  ezResult GetNodeBoxForSpatialData(const ezSpatialDataHandle& hData, ezBoundingBox& out_BoundingBox) const;
+
+  /// \brief Returns the loose bounding boxes of all nodes that contain objects of the given category.
+  void GetAllNodeBoxes(
+    ezHybridArray<ezBoundingBox, 16>& out_BoundingBoxes, ezSpatialData::Category filterCategory = ezInvalidSpatialDataCategory) const;
+
+private:
+  // ezSpatialSystem implementation
+  virtual void FindObjectsInSphereInternal(
+    const ezBoundingSphere& sphere, ezUInt32 uiCategoryBitmask, QueryCallback callback, QueryStats* pStats = nullptr) const override;
+  virtual void FindObjectsInBoxInternal(
+    const ezBoundingBox& box, ezUInt32 uiCategoryBitmask, QueryCallback callback, QueryStats* pStats = nullptr) const override;
+
+  virtual void FindVisibleObjectsInternal(const ezFrustum& frustum, ezUInt32 uiCategoryBitmask, ezDynamicArray<const ezGameObject*>& out_Objects,
+    QueryStats* pStats = nullptr) const override;
+
+  virtual void SpatialDataAdded(ezSpatialData* pData) override;
+  virtual void SpatialDataRemoved(ezSpatialData* pData) override;
+  virtual void SpatialDataChanged(ezSpatialData* pData, const ezSimdBBoxSphere& oldBounds, ezUInt32 uiOldCategoryBitmask) override;
+  virtual void FixSpatialDataPointer(ezSpatialData* pOldPtr, ezSpatialData* pNewPtr) override;
+
+  ezProxyAllocator m_AlignedAllocator;
+  float m_fRootHalfExtent;
+  ezUInt32 m_uiMaxDepth = 0;
+
+  struct SpatialUserData;
+  struct Node;
+
+  Node* m_pRoot = nullptr;
+
+  template <typename Functor>
+  void ForEachNode(const ezSimdBBox& box, ezUInt32 uiCategoryBitmask, Functor func) const;
+
+  Node* GetOrCreateNode(const ezSimdBBoxSphere& bounds);
+  bool IsTargetNode(const Node* pNode, const ezSimdBBoxSphere& bounds) const;
+  ezUInt32 ComputeDepth(const ezSimdBBoxSphere& bounds) const;
+
+  void AddToNode(Node* pNode, ezSpatialData* pData);
+  void RemoveFromNode(ezSpatialData* pData);
+  void DeleteNode(Node* pNode);
+};
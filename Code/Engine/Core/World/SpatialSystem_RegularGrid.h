@@ -19,6 +19,11 @@ public:
   void GetAllCellBoxes(
     ezHybridArray<ezBoundingBox, 16>& out_BoundingBoxes, ezSpatialData::Category filterCategory = ezInvalidSpatialDataCategory) const;
 
+  /// \brief Visibility queries that have to test at least this many objects are split across the worker threads of the task system.
+  ///
+  /// Set it to ezInvalidIndex to always cull on the calling thread.
+  void SetParallelCullingThreshold(ezUInt32 uiNumObjects) { m_uiParallelCullingThreshold = uiNumObjects; }
+
 private:
   // ezSpatialSystem implementation
   virtual void FindObjectsInSphereInternal(
@@ -28,6 +33,8 @@ private:
 
   virtual void FindVisibleObjectsInternal(const ezFrustum& frustum, ezUInt32 uiCategoryBitmask, ezDynamicArray<const ezGameObject*>& out_Objects,
     QueryStats* pStats = nullptr) const override;
+  virtual void FindVisibleObjectsBatchInternal(ezArrayPtr<const ezFrustum> frustums, ezUInt32 uiCategoryBitmask,
+    ezArrayPtr<ezDynamicArray<const ezGameObject*>> out_Objects, QueryStats* pStats = nullptr) const override;
 
   virtual void SpatialDataAdded(ezSpatialData* pData) override;
   virtual void SpatialDataRemoved(ezSpatialData* pData) override;
@@ -38,6 +45,7 @@ private:
   ezSimdVec4i m_iCellSize;
   ezSimdVec4f m_fOverlapSize;
   ezSimdFloat m_fInvCellSize;
+  ezUInt32 m_uiParallelCullingThreshold = 8192;
 
   struct SpatialUserData;
   struct Cell;
@@ -19,8 +19,8 @@ struct ezWorldDesc
   ezHashedString m_sName;
   ezUInt64 m_uiRandomNumberGeneratorSeed = 0;
 
-  ezUniquePtr<ezSpatialSystem> m_pSpatialSystem;
-  bool m_bAutoCreateSpatialSystem = true; ///< automatically create a default spatial system if none is set
+  ezUniquePtr<ezSpatialSystem> m_pSpatialSystem; ///< e.g. an ezSpatialSystem_LooseOctree for worlds with many large or fast moving objects
+  bool m_bAutoCreateSpatialSystem = true; ///< automatically create a default spatial system (ezSpatialSystem_RegularGrid) if none is set
 
   ezSharedPtr<ezCoordinateSystemProvider> m_pCoordinateSystemProvider;
   ezUniquePtr<ezTimeStepSmoothing> m_pTimeStepSmoothing; ///< if nullptr, ezDefaultTimeStepSmoothing will be used
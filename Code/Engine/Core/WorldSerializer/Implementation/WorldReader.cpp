@@ -2,17 +2,45 @@
 
 #include <Core/WorldSerializer/WorldReader.h>
 #include <Foundation/IO/StringDeduplicationContext.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Utilities/Progress.h>
 
 ezWorldReader::FindComponentTypeCallback ezWorldReader::s_FindComponentTypeCallback;
 
+// owner index, component index, active flag and user flags, see ezWorldWriter::WriteComponentCreationData
+static constexpr ezUInt32 s_uiComponentCreationRecordSize = sizeof(ezUInt32) + sizeof(ezUInt32) + sizeof(ezUInt8) + sizeof(ezUInt8);
+
+// a super simple, but also efficient random number generator
+inline static ezUInt32 NextStableRandomSeed(ezUInt32& seed)
+{
+  seed = 214013L * seed + 2531011L;
+  return ((seed >> 16) & 0x7FFFF);
+}
+
+template <typename Func>
+static void ProcessItems(ezUInt32 uiNumItems, bool bInParallel, const char* szTaskName, Func func)
+{
+  if (!bInParallel || ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks) == 0)
+  {
+    func(0, uiNumItems);
+    return;
+  }
+
+  ezParallelForParams params;
+  params.uiBinSize = 256;
+  params.uiMaxTasksPerThread = 2;
+
+  ezTaskSystem::ParallelForIndexed(0, uiNumItems, func, szTaskName, params);
+}
+
 ezWorldReader::ezWorldReader() = default;
 ezWorldReader::~ezWorldReader() = default;
 
 ezResult ezWorldReader::ReadWorldDescription(ezStreamReader& stream)
 {
   m_pStream = &stream;
+  m_InstantiationTemplate.m_bIsValid = false;
 
   m_uiVersion = 0;
   stream >> m_uiVersion;
@@ -74,6 +102,8 @@ ezResult ezWorldReader::ReadWorldDescription(ezStreamReader& stream)
   ReadComponentDataToMemStream();
   m_pStringDedupReadContext->SetActive(false);
 
+  DecodeComponentCreationData();
+
   return EZ_SUCCESS;
 }
 
@@ -93,6 +123,138 @@ ezUniquePtr<ezWorldReader::InstantiationContextBase> ezWorldReader::InstantiateP
   return Instantiate(world, true, rootTransform, options);
 }
 
+void ezWorldReader::InstantiatePrefabs(ezWorld& world, ezArrayPtr<const ezTransform> rootTransforms, const ezPrefabInstantiationOptions& options)
+{
+  EZ_PROFILE_SCOPE("ezWorldReader::InstantiatePrefabs");
+
+  UpdateInstantiationTemplate(options);
+  InstantiationTemplate& t = m_InstantiationTemplate;
+
+  m_pWorld = &world;
+
+  EZ_LOCK(world.GetWriteMarker());
+
+  // the component managers only have to be looked up once for all instances
+  ezHybridArray<ezComponentManagerBase*, 16> managers;
+  managers.SetCountUninitialized(t.m_ComponentTypesToCreate.GetCount());
+  for (ezUInt32 i = 0; i < t.m_ComponentTypesToCreate.GetCount(); ++i)
+  {
+    const ezRTTI* pRtti = m_ComponentTypes[t.m_ComponentTypesToCreate[i]].m_pRtti;
+
+    managers[i] = world.GetOrCreateManagerForComponentType(pRtti);
+    EZ_ASSERT_DEV(managers[i] != nullptr, "Cannot create components of type '{0}', manager is not available.", pRtti->GetTypeName());
+  }
+
+  if (options.m_pCreatedRootObjectsOut != nullptr)
+  {
+    options.m_pCreatedRootObjectsOut->Reserve(options.m_pCreatedRootObjectsOut->GetCount() + rootTransforms.GetCount() * t.m_RootObjects.GetCount());
+  }
+
+  if (options.m_pCreatedChildObjectsOut != nullptr)
+  {
+    options.m_pCreatedChildObjectsOut->Reserve(options.m_pCreatedChildObjectsOut->GetCount() + rootTransforms.GetCount() * t.m_ChildObjects.GetCount());
+  }
+
+  ezMemoryStreamReader dataReader(&m_ComponentDataStream);
+
+  m_pStringDedupReadContext->SetActive(true);
+
+  ezStreamReader* pPrevReader = m_pStream;
+  m_pStream = &dataReader;
+
+  EZ_SCOPE_EXIT(m_pStream = pPrevReader; m_pStringDedupReadContext->SetActive(false););
+
+  for (const ezTransform& rootTransform : rootTransforms)
+  {
+    ClearHandles();
+
+    // every instance gets the same seeds, just like with separate calls to InstantiatePrefab()
+    ezUInt32 uiRandomSeedRootValue = options.m_uiCustomRandomSeedRootValue;
+
+    auto createObject = [&](ezGameObjectDesc& desc, const GameObjectToCreate& godesc, ezGameObjectHandle hParent) {
+      desc.m_hParent = hParent.IsInvalidated() ? m_IndexToGameObjectHandle[godesc.m_uiParentHandleIdx] : hParent;
+
+      if (options.m_RandomSeedMode == ezPrefabInstantiationOptions::RandomSeedMode::CustomRootValue)
+      {
+        desc.m_uiStableRandomSeed = NextStableRandomSeed(uiRandomSeedRootValue);
+      }
+
+      return CreateGameObject(desc, godesc.m_sGlobalKey);
+    };
+
+    for (ezUInt32 i = 0; i < t.m_RootObjects.GetCount(); ++i)
+    {
+      ezGameObjectDesc& desc = t.m_RootObjects[i];
+
+      ezTransform tFinal;
+      tFinal.SetGlobalTransform(rootTransform, t.m_RootObjectTransforms[i]);
+
+      desc.m_LocalPosition = tFinal.m_vPosition;
+      desc.m_LocalRotation = tFinal.m_qRotation;
+      desc.m_LocalScaling = tFinal.m_vScale;
+
+      ezGameObject* pObject = createObject(desc, m_RootObjectsToCreate[i], options.m_hParent);
+
+      if (options.m_pCreatedRootObjectsOut != nullptr)
+      {
+        options.m_pCreatedRootObjectsOut->PushBack(pObject);
+      }
+    }
+
+    for (ezUInt32 i = 0; i < t.m_ChildObjects.GetCount(); ++i)
+    {
+      ezGameObject* pObject = createObject(t.m_ChildObjects[i], m_ChildObjectsToCreate[i], ezGameObjectHandle());
+
+      if (options.m_pCreatedChildObjectsOut != nullptr)
+      {
+        options.m_pCreatedChildObjectsOut->PushBack(pObject);
+      }
+    }
+
+    for (ezUInt32 i = 0; i < t.m_ComponentTypesToCreate.GetCount(); ++i)
+    {
+      auto& compTypeInfo = m_ComponentTypes[t.m_ComponentTypesToCreate[i]];
+
+      for (const ComponentToCreate& componentToCreate : compTypeInfo.m_ComponentsToCreate)
+      {
+        CreateComponent(managers[i], compTypeInfo.m_ComponentIndexToHandle, componentToCreate);
+      }
+    }
+
+    // types without components have no data in the stream, so the data of the remaining types is stored in the same order
+    dataReader.SetReadPosition(0);
+
+    for (ezUInt32 uiTypeIndex : t.m_ComponentTypesToCreate)
+    {
+      const auto& indexToHandle = m_ComponentTypes[uiTypeIndex].m_ComponentIndexToHandle;
+
+      // index 0 is the invalid handle
+      for (ezUInt32 i = 1; i < indexToHandle.GetCount(); ++i)
+      {
+        ezComponent* pComponent = nullptr;
+        if (world.TryGetComponent(indexToHandle[i], pComponent))
+        {
+          pComponent->DeserializeComponent(*this);
+        }
+      }
+    }
+
+    for (ezUInt32 uiTypeIndex : t.m_ComponentTypesToCreate)
+    {
+      const auto& indexToHandle = m_ComponentTypes[uiTypeIndex].m_ComponentIndexToHandle;
+
+      for (ezUInt32 i = 1; i < indexToHandle.GetCount(); ++i)
+      {
+        ezComponent* pComponent = nullptr;
+        if (world.TryGetComponent(indexToHandle[i], pComponent))
+        {
+          pComponent->GetOwningManager()->InitializeComponent(pComponent);
+        }
+      }
+    }
+  }
+}
+
 ezGameObjectHandle ezWorldReader::ReadGameObjectHandle()
 {
   ezUInt32 idx = 0;
@@ -131,6 +293,8 @@ ezUInt32 ezWorldReader::GetComponentTypeVersion(const ezRTTI* pRtti) const
 
 void ezWorldReader::ClearAndCompact()
 {
+  m_InstantiationTemplate = InstantiationTemplate();
+
   m_IndexToGameObjectHandle.Clear();
   m_IndexToGameObjectHandle.Compact();
 
@@ -155,8 +319,17 @@ void ezWorldReader::ClearAndCompact()
 
 ezUInt64 ezWorldReader::GetHeapMemoryUsage() const
 {
+  ezUInt64 uiComponentsToCreateSize = 0;
+  for (const auto& compTypeInfo : m_ComponentTypes)
+  {
+    uiComponentsToCreateSize += compTypeInfo.m_ComponentsToCreate.GetHeapMemoryUsage();
+  }
+
+  const InstantiationTemplate& t = m_InstantiationTemplate;
+  uiComponentsToCreateSize += t.m_RootObjects.GetHeapMemoryUsage() + t.m_RootObjectTransforms.GetHeapMemoryUsage() + t.m_ChildObjects.GetHeapMemoryUsage() + t.m_ComponentTypesToCreate.GetHeapMemoryUsage();
+
   return m_IndexToGameObjectHandle.GetHeapMemoryUsage() + m_RootObjectsToCreate.GetHeapMemoryUsage() + m_ChildObjectsToCreate.GetHeapMemoryUsage() + m_ComponentTypes.GetHeapMemoryUsage() + m_ComponentTypeVersions.GetHeapMemoryUsage() + m_ComponentCreationStream.GetHeapMemoryUsage() +
-         m_ComponentDataStream.GetHeapMemoryUsage();
+         m_ComponentDataStream.GetHeapMemoryUsage() + uiComponentsToCreateSize;
 }
 
 ezUInt32 ezWorldReader::GetRootObjectCount() const
@@ -233,6 +406,8 @@ void ezWorldReader::ReadComponentTypeInfo(ezUInt32 uiComponentTypeIdx)
 
 void ezWorldReader::ReadComponentDataToMemStream()
 {
+  m_uiTotalNumComponents = 0;
+
   auto WriteToMemStream = [&](ezMemoryStreamWriter& writer, bool bReadNumComponents) {
     ezUInt8 Temp[4096];
     for (auto& compTypeInfo : m_ComponentTypes)
@@ -253,6 +428,9 @@ void ezWorldReader::ReadComponentDataToMemStream()
           *m_pStream >> compTypeInfo.m_uiNumComponents;
           uiAllComponentsSize -= sizeof(ezUInt32);
 
+          EZ_ASSERT_DEV(uiAllComponentsSize == compTypeInfo.m_uiNumComponents * s_uiComponentCreationRecordSize, "Invalid component creation data for type '{0}'", compTypeInfo.m_pRtti->GetTypeName());
+
+          compTypeInfo.m_uiCreationDataOffset = writer.GetWritePosition();
           m_uiTotalNumComponents += compTypeInfo.m_uiNumComponents;
         }
 
@@ -279,6 +457,157 @@ void ezWorldReader::ReadComponentDataToMemStream()
   }
 }
 
+void ezWorldReader::DecodeComponentCreationData()
+{
+  EZ_PROFILE_SCOPE("ezWorldReader::DecodeComponentCreationData");
+
+  for (auto& compTypeInfo : m_ComponentTypes)
+  {
+    compTypeInfo.m_ComponentsToCreate.Clear();
+
+    if (compTypeInfo.m_pRtti == nullptr)
+      continue;
+
+    compTypeInfo.m_ComponentsToCreate.SetCountUninitialized(compTypeInfo.m_uiNumComponents);
+
+    // all records have the same size, so every task can start reading at its own position
+    auto decodeRecords = [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      ezMemoryStreamReader reader(&m_ComponentCreationStream);
+      reader.SetReadPosition(compTypeInfo.m_uiCreationDataOffset + uiStartIndex * s_uiComponentCreationRecordSize);
+
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        ComponentToCreate& componentToCreate = compTypeInfo.m_ComponentsToCreate[i];
+
+        ezUInt32 uiComponentIdx = 0;
+        reader >> componentToCreate.m_uiOwnerHandleIdx;
+        reader >> uiComponentIdx;
+        reader >> componentToCreate.m_bActive;
+        reader >> componentToCreate.m_uiUserFlags;
+
+        // index 0 is reserved for the invalid handle
+        EZ_ASSERT_DEBUG(uiComponentIdx == i + 1, "Component index doesn't match");
+      }
+    };
+
+    ProcessItems(compTypeInfo.m_uiNumComponents, compTypeInfo.m_uiNumComponents >= m_uiParallelPreparationThreshold, "DecodeComponentCreationData", decodeRecords);
+  }
+
+  // everything that is needed to create the components is decoded now
+  m_ComponentCreationStream.Clear();
+  m_ComponentCreationStream.Compact();
+}
+
+ezGameObject* ezWorldReader::CreateGameObject(const ezGameObjectDesc& desc, const ezString& sGlobalKey)
+{
+  ezGameObject* pObject = nullptr;
+  m_IndexToGameObjectHandle.PushBack(m_pWorld->CreateObject(desc, pObject));
+
+  if (!sGlobalKey.IsEmpty())
+  {
+    pObject->SetGlobalKey(sGlobalKey);
+  }
+
+  return pObject;
+}
+
+void ezWorldReader::CreateComponent(ezComponentManagerBase* pManager, ezDynamicArray<ezComponentHandle>& inout_ComponentIndexToHandle, const ComponentToCreate& componentToCreate)
+{
+  const ezGameObjectHandle hOwner = m_IndexToGameObjectHandle[componentToCreate.m_uiOwnerHandleIdx];
+
+  ezGameObject* pOwnerObject = nullptr;
+  m_pWorld->TryGetObject(hOwner, pOwnerObject);
+
+  EZ_ASSERT_DEBUG(pOwnerObject != nullptr, "Owner object must be not null");
+
+  ezComponent* pComponent = nullptr;
+  auto hComponent = pManager->CreateComponentNoInit(pOwnerObject, pComponent);
+
+  pComponent->SetActiveFlag(componentToCreate.m_bActive);
+
+  for (ezUInt8 j = 0; j < 8; ++j)
+  {
+    pComponent->SetUserFlag(j, (componentToCreate.m_uiUserFlags & EZ_BIT(j)) != 0);
+  }
+
+  inout_ComponentIndexToHandle.PushBack(hComponent);
+}
+
+void ezWorldReader::ApplyInstantiationOptions(ezGameObjectDesc& desc, const ezPrefabInstantiationOptions& options)
+{
+  desc.m_bDynamic |= options.bForceDynamic;
+
+  switch (options.m_RandomSeedMode)
+  {
+    case ezPrefabInstantiationOptions::RandomSeedMode::DeterministicFromParent:
+      desc.m_uiStableRandomSeed = 0xFFFFFFFF; // ezWorld::CreateObject() will either derive a deterministic value from the parent object, or assign a random value, if no parent exists
+      break;
+
+    case ezPrefabInstantiationOptions::RandomSeedMode::CompletelyRandom:
+      desc.m_uiStableRandomSeed = 0; // ezWorld::CreateObject() will assign a random value to this object
+      break;
+
+    case ezPrefabInstantiationOptions::RandomSeedMode::FixedFromSerialization:
+      // keep deserialized value
+      break;
+
+    case ezPrefabInstantiationOptions::RandomSeedMode::CustomRootValue:
+      // depends on the order in which the objects are created, assigned right before an object is created
+      break;
+  }
+
+  if (options.m_pOverrideTeamID != nullptr)
+  {
+    desc.m_uiTeamID = *options.m_pOverrideTeamID;
+  }
+}
+
+void ezWorldReader::UpdateInstantiationTemplate(const ezPrefabInstantiationOptions& options)
+{
+  InstantiationTemplate& t = m_InstantiationTemplate;
+
+  const bool bOverrideTeamID = options.m_pOverrideTeamID != nullptr;
+  const ezUInt16 uiOverrideTeamID = bOverrideTeamID ? *options.m_pOverrideTeamID : 0;
+
+  if (t.m_bIsValid && t.m_bForceDynamic == options.bForceDynamic && t.m_bOverrideTeamID == bOverrideTeamID && t.m_uiOverrideTeamID == uiOverrideTeamID && t.m_RandomSeedMode == options.m_RandomSeedMode)
+    return;
+
+  EZ_PROFILE_SCOPE("ezWorldReader::UpdateInstantiationTemplate");
+
+  t.m_bIsValid = true;
+  t.m_bForceDynamic = options.bForceDynamic;
+  t.m_bOverrideTeamID = bOverrideTeamID;
+  t.m_uiOverrideTeamID = uiOverrideTeamID;
+  t.m_RandomSeedMode = options.m_RandomSeedMode;
+
+  t.m_RootObjects.SetCount(m_RootObjectsToCreate.GetCount());
+  t.m_RootObjectTransforms.SetCount(m_RootObjectsToCreate.GetCount());
+  for (ezUInt32 i = 0; i < m_RootObjectsToCreate.GetCount(); ++i)
+  {
+    const ezGameObjectDesc& desc = m_RootObjectsToCreate[i].m_Desc;
+
+    t.m_RootObjects[i] = desc;
+    t.m_RootObjectTransforms[i] = ezTransform(desc.m_LocalPosition, desc.m_LocalRotation, desc.m_LocalScaling);
+    ApplyInstantiationOptions(t.m_RootObjects[i], options);
+  }
+
+  t.m_ChildObjects.SetCount(m_ChildObjectsToCreate.GetCount());
+  for (ezUInt32 i = 0; i < m_ChildObjectsToCreate.GetCount(); ++i)
+  {
+    t.m_ChildObjects[i] = m_ChildObjectsToCreate[i].m_Desc;
+    ApplyInstantiationOptions(t.m_ChildObjects[i], options);
+  }
+
+  t.m_ComponentTypesToCreate.Clear();
+  for (ezUInt32 i = 0; i < m_ComponentTypes.GetCount(); ++i)
+  {
+    if (m_ComponentTypes[i].m_pRtti != nullptr && m_ComponentTypes[i].m_uiNumComponents > 0)
+    {
+      t.m_ComponentTypesToCreate.PushBack(i);
+    }
+  }
+}
+
 void ezWorldReader::ClearHandles()
 {
   m_IndexToGameObjectHandle.Clear();
@@ -301,6 +630,12 @@ ezUniquePtr<ezWorldReader::InstantiationContextBase> ezWorldReader::Instantiate(
   {
     InstantiationContext context = InstantiationContext(*this, bUseTransform, rootTransform, options);
 
+    // all objects are created in one go, so the work that doesn't touch the world can be done up front, outside of the world's write lock
+    if (GetRootObjectCount() + GetChildObjectCount() >= m_uiParallelPreparationThreshold)
+    {
+      context.PrepareGameObjects();
+    }
+
     EZ_VERIFY(context.Step() == InstantiationContextBase::StepResult::Finished, "Instantiation should be completed after this call");
     return nullptr;
   }
@@ -365,12 +700,12 @@ ezWorldReader::InstantiationContext::StepResult ezWorldReader::InstantiationCont
   {
     if (m_bUseTransform)
     {
-      if (!CreateGameObjects<true>(m_WorldReader.m_RootObjectsToCreate, m_Options.m_hParent, m_Options.m_pCreatedRootObjectsOut, endTime))
+      if (!CreateGameObjects<true>(m_WorldReader.m_RootObjectsToCreate, m_PreparedRootObjects, m_Options.m_hParent, m_Options.m_pCreatedRootObjectsOut, endTime))
         return StepResult::Continue;
     }
     else
     {
-      if (!CreateGameObjects<false>(m_WorldReader.m_RootObjectsToCreate, m_Options.m_hParent, m_Options.m_pCreatedRootObjectsOut, endTime))
+      if (!CreateGameObjects<false>(m_WorldReader.m_RootObjectsToCreate, m_PreparedRootObjects, m_Options.m_hParent, m_Options.m_pCreatedRootObjectsOut, endTime))
         return StepResult::Continue;
     }
 
@@ -380,28 +715,22 @@ ezWorldReader::InstantiationContext::StepResult ezWorldReader::InstantiationCont
 
   if (m_Phase == Phase::CreateChildObjects)
   {
-    if (!CreateGameObjects<false>(m_WorldReader.m_ChildObjectsToCreate, ezGameObjectHandle(), m_Options.m_pCreatedChildObjectsOut, endTime))
+    if (!CreateGameObjects<false>(m_WorldReader.m_ChildObjectsToCreate, m_PreparedChildObjects, ezGameObjectHandle(), m_Options.m_pCreatedChildObjectsOut, endTime))
       return StepResult::Continue;
 
-    m_CurrentReader.SetStorage(&m_WorldReader.m_ComponentCreationStream);
+    m_PreparedRootObjects.Clear();
+    m_PreparedRootObjects.Compact();
+    m_PreparedChildObjects.Clear();
+    m_PreparedChildObjects.Compact();
+
     m_Phase = Phase::CreateComponents;
     BeginNextProgressStep("CreateComponents");
   }
 
   if (m_Phase == Phase::CreateComponents)
   {
-    if (m_WorldReader.m_ComponentCreationStream.GetStorageSize() > 0)
-    {
-      m_WorldReader.m_pStringDedupReadContext->SetActive(true);
-
-      ezStreamReader* pPrevReader = m_WorldReader.m_pStream;
-      m_WorldReader.m_pStream = &m_CurrentReader;
-
-      EZ_SCOPE_EXIT(m_WorldReader.m_pStream = pPrevReader; m_WorldReader.m_pStringDedupReadContext->SetActive(false););
-
-      if (!CreateComponents(endTime))
-        return StepResult::Continue;
-    }
+    if (!CreateComponents(endTime))
+      return StepResult::Continue;
 
     m_CurrentReader.SetStorage(&m_WorldReader.m_ComponentDataStream);
     m_Phase = Phase::DeserializeComponents;
@@ -469,70 +798,87 @@ void ezWorldReader::InstantiationContext::Cancel()
   m_pOverallProgressRange = nullptr;
 }
 
-// a super simple, but also efficient random number generator
-inline static ezUInt32 NextStableRandomSeed(ezUInt32& seed)
+void ezWorldReader::InstantiationContext::PrepareGameObjects()
 {
-  seed = 214013L * seed + 2531011L;
-  return ((seed >> 16) & 0x7FFFF);
+  EZ_PROFILE_SCOPE("ezWorldReader::PrepareGameObjects");
+
+  const auto& rootObjects = m_WorldReader.m_RootObjectsToCreate;
+  const auto& childObjects = m_WorldReader.m_ChildObjectsToCreate;
+  const bool bInParallel = rootObjects.GetCount() + childObjects.GetCount() >= m_WorldReader.m_uiParallelPreparationThreshold;
+
+  m_PreparedRootObjects.SetCount(rootObjects.GetCount());
+  m_PreparedChildObjects.SetCount(childObjects.GetCount());
+
+  ProcessItems(rootObjects.GetCount(), bInParallel, "PrepareRootObjects", [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+    for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+    {
+      m_PreparedRootObjects[i] = rootObjects[i].m_Desc;
+
+      if (m_bUseTransform)
+        PrepareGameObjectDesc<true>(m_PreparedRootObjects[i]);
+      else
+        PrepareGameObjectDesc<false>(m_PreparedRootObjects[i]);
+    }
+  });
+
+  ProcessItems(childObjects.GetCount(), bInParallel, "PrepareChildObjects", [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+    for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+    {
+      m_PreparedChildObjects[i] = childObjects[i].m_Desc;
+      PrepareGameObjectDesc<false>(m_PreparedChildObjects[i]);
+    }
+  });
 }
 
 template <bool UseTransform>
-bool ezWorldReader::InstantiationContext::CreateGameObjects(const ezDynamicArray<GameObjectToCreate>& objects, ezGameObjectHandle hParent, ezDynamicArray<ezGameObject*>* out_CreatedObjects, ezTime endTime)
+void ezWorldReader::InstantiationContext::PrepareGameObjectDesc(ezGameObjectDesc& desc) const
+{
+  ezWorldReader::ApplyInstantiationOptions(desc, m_Options);
+
+  if (UseTransform)
+  {
+    ezTransform tChild(desc.m_LocalPosition, desc.m_LocalRotation, desc.m_LocalScaling);
+    ezTransform tFinal;
+    tFinal.SetGlobalTransform(m_RootTransform, tChild);
+
+    desc.m_LocalPosition = tFinal.m_vPosition;
+    desc.m_LocalRotation = tFinal.m_qRotation;
+    desc.m_LocalScaling = tFinal.m_vScale;
+  }
+}
+
+template <bool UseTransform>
+bool ezWorldReader::InstantiationContext::CreateGameObjects(const ezDynamicArray<GameObjectToCreate>& objects, ezArrayPtr<ezGameObjectDesc> preparedObjects, ezGameObjectHandle hParent, ezDynamicArray<ezGameObject*>* out_CreatedObjects, ezTime endTime)
 {
   EZ_PROFILE_SCOPE("ezWorldReader::CreateGameObjects");
 
+  ezGameObjectDesc desc;
+
   while (m_uiCurrentIndex < objects.GetCount())
   {
     auto& godesc = objects[m_uiCurrentIndex];
 
-    ezGameObjectDesc desc = godesc.m_Desc; // make a copy
-    desc.m_hParent = hParent.IsInvalidated() ? m_WorldReader.m_IndexToGameObjectHandle[godesc.m_uiParentHandleIdx] : hParent;
-    desc.m_bDynamic |= m_Options.bForceDynamic;
-
-    switch (m_Options.m_RandomSeedMode)
+    ezGameObjectDesc* pDesc = &desc;
+    if (preparedObjects.IsEmpty())
     {
-      case ezPrefabInstantiationOptions::RandomSeedMode::DeterministicFromParent:
-        desc.m_uiStableRandomSeed = 0xFFFFFFFF; // ezWorld::CreateObject() will either derive a deterministic value from the parent object, or assign a random value, if no parent exists
-        break;
-
-      case ezPrefabInstantiationOptions::RandomSeedMode::CompletelyRandom:
-        desc.m_uiStableRandomSeed = 0; // ezWorld::CreateObject() will assign a random value to this object
-        break;
-
-      case ezPrefabInstantiationOptions::RandomSeedMode::FixedFromSerialization:
-        // keep deserialized value
-        break;
-
-      case ezPrefabInstantiationOptions::RandomSeedMode::CustomRootValue:
-        // we use the given seed root value to assign a deterministic (but different) value to each game object
-        desc.m_uiStableRandomSeed = NextStableRandomSeed(m_Options.m_uiCustomRandomSeedRootValue);
-        break;
+      desc = godesc.m_Desc; // make a copy
+      PrepareGameObjectDesc<UseTransform>(desc);
     }
-
-    if (m_Options.m_pOverrideTeamID != nullptr)
-    {
-      desc.m_uiTeamID = *m_Options.m_pOverrideTeamID;
-    }
-
-    if (UseTransform)
+    else
     {
-      ezTransform tChild(desc.m_LocalPosition, desc.m_LocalRotation, desc.m_LocalScaling);
-      ezTransform tFinal;
-      tFinal.SetGlobalTransform(m_RootTransform, tChild);
-
-      desc.m_LocalPosition = tFinal.m_vPosition;
-      desc.m_LocalRotation = tFinal.m_qRotation;
-      desc.m_LocalScaling = tFinal.m_vScale;
+      pDesc = &preparedObjects[m_uiCurrentIndex];
     }
 
-    ezGameObject* pObject = nullptr;
-    m_WorldReader.m_IndexToGameObjectHandle.PushBack(m_WorldReader.m_pWorld->CreateObject(desc, pObject));
+    pDesc->m_hParent = hParent.IsInvalidated() ? m_WorldReader.m_IndexToGameObjectHandle[godesc.m_uiParentHandleIdx] : hParent;
 
-    if (!godesc.m_sGlobalKey.IsEmpty())
+    if (m_Options.m_RandomSeedMode == ezPrefabInstantiationOptions::RandomSeedMode::CustomRootValue)
     {
-      pObject->SetGlobalKey(godesc.m_sGlobalKey);
+      // we use the given seed root value to assign a deterministic (but different) value to each game object
+      pDesc->m_uiStableRandomSeed = NextStableRandomSeed(m_Options.m_uiCustomRandomSeedRootValue);
     }
 
+    ezGameObject* pObject = m_WorldReader.CreateGameObject(*pDesc, godesc.m_sGlobalKey);
+
     if (out_CreatedObjects)
     {
       out_CreatedObjects->PushBack(pObject);
@@ -557,8 +903,6 @@ bool ezWorldReader::InstantiationContext::CreateComponents(ezTime endTime)
 {
   EZ_PROFILE_SCOPE("ezWorldReader::CreateComponents");
 
-  ezStreamReader& s = *m_WorldReader.m_pStream;
-
   for (; m_uiCurrentComponentTypeIndex < m_WorldReader.m_ComponentTypes.GetCount(); ++m_uiCurrentComponentTypeIndex)
   {
     auto& compTypeInfo = m_WorldReader.m_ComponentTypes[m_uiCurrentComponentTypeIndex];
@@ -572,34 +916,7 @@ bool ezWorldReader::InstantiationContext::CreateComponents(ezTime endTime)
 
     while (m_uiCurrentIndex < compTypeInfo.m_uiNumComponents)
     {
-      const ezGameObjectHandle hOwner = m_WorldReader.ReadGameObjectHandle();
-
-      ezUInt32 uiComponentIdx = 0;
-      s >> uiComponentIdx;
-
-      bool bActive = true;
-      s >> bActive;
-
-      ezUInt8 userFlags = 0;
-      s >> userFlags;
-
-      ezGameObject* pOwnerObject = nullptr;
-      m_WorldReader.m_pWorld->TryGetObject(hOwner, pOwnerObject);
-
-      EZ_ASSERT_DEBUG(pOwnerObject != nullptr, "Owner object must be not null");
-
-      ezComponent* pComponent = nullptr;
-      auto hComponent = pManager->CreateComponentNoInit(pOwnerObject, pComponent);
-
-      pComponent->SetActiveFlag(bActive);
-
-      for (ezUInt8 j = 0; j < 8; ++j)
-      {
-        pComponent->SetUserFlag(j, (userFlags & EZ_BIT(j)) != 0);
-      }
-
-      EZ_ASSERT_DEBUG(uiComponentIdx == compTypeInfo.m_ComponentIndexToHandle.GetCount(), "Component index doesn't match");
-      compTypeInfo.m_ComponentIndexToHandle.PushBack(hComponent);
+      m_WorldReader.CreateComponent(pManager, compTypeInfo.m_ComponentIndexToHandle, compTypeInfo.m_ComponentsToCreate[m_uiCurrentIndex]);
 
       ++m_uiCurrentIndex;
       ++m_uiCurrentNumComponentsProcessed;
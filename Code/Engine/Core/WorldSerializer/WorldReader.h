@@ -112,6 +112,16 @@ public:
   /// has to be valid as long as the instantiation is in progress.
   ezUniquePtr<InstantiationContextBase> InstantiatePrefab(ezWorld& world, const ezTransform& rootTransform, const ezPrefabInstantiationOptions& options);
 
+  /// \brief Creates one instance of the world that was previously read by ReadWorldDescription() for every transform in \a rootTransforms.
+  ///
+  /// Gives the same result as calling InstantiatePrefab() once per transform, but is a lot cheaper for small prefabs that are spawned
+  /// often. The game object descriptions are prepared once and cached until different instantiation options are passed in, so every
+  /// instance only has to patch the root transforms and object handles. All instances are created under one world lock.
+  ///
+  /// The created objects of all instances are appended to the output arrays in \a options, one instance after the other.
+  /// The instantiation always completes immediately, m_MaxStepTime and m_pProgress in \a options are ignored.
+  void InstantiatePrefabs(ezWorld& world, ezArrayPtr<const ezTransform> rootTransforms, const ezPrefabInstantiationOptions& options);
+
   /// \brief Gives access to the stream of data. Use this inside component deserialization functions to read data.
   ezStreamReader& GetStream() const { return *m_pStream; }
 
@@ -147,6 +157,15 @@ public:
   ezUInt32 GetRootObjectCount() const;
   ezUInt32 GetChildObjectCount() const;
 
+  /// \brief Work that does not need to access the ezWorld is split across the worker threads of the task system, if there is at least this
+  /// much of it.
+  ///
+  /// This applies to decoding the component creation data in ReadWorldDescription() (number of components) and to preparing the game object
+  /// descriptions when a world or prefab is instantiated without a maxStepTime (number of game objects). Only inserting the objects and
+  /// components into the world happens under the world's write lock.
+  /// Set it to ezInvalidIndex to always do all work on the calling thread.
+  void SetParallelPreparationThreshold(ezUInt32 uiNumItems) { m_uiParallelPreparationThreshold = uiNumItems; }
+
 private:
   struct GameObjectToCreate
   {
@@ -155,12 +174,30 @@ private:
     ezUInt32 m_uiParentHandleIdx;
   };
 
+  struct ComponentToCreate
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiOwnerHandleIdx;
+    bool m_bActive;
+    ezUInt8 m_uiUserFlags;
+  };
+
   void ReadGameObjectDesc(GameObjectToCreate& godesc);
   void ReadComponentTypeInfo(ezUInt32 uiComponentTypeIdx);
   void ReadComponentDataToMemStream();
+  void DecodeComponentCreationData();
   void ClearHandles();
   ezUniquePtr<InstantiationContextBase> Instantiate(ezWorld& world, bool bUseTransform, const ezTransform& rootTransform, const ezPrefabInstantiationOptions& options);
 
+  /// \brief Applies everything from \a options to \a desc that does not depend on the order in which the objects are created.
+  static void ApplyInstantiationOptions(ezGameObjectDesc& desc, const ezPrefabInstantiationOptions& options);
+
+  ezGameObject* CreateGameObject(const ezGameObjectDesc& desc, const ezString& sGlobalKey);
+  void CreateComponent(ezComponentManagerBase* pManager, ezDynamicArray<ezComponentHandle>& inout_ComponentIndexToHandle, const ComponentToCreate& componentToCreate);
+
+  void UpdateInstantiationTemplate(const ezPrefabInstantiationOptions& options);
+
   ezStreamReader* m_pStream = nullptr;
   ezWorld* m_pWorld = nullptr;
 
@@ -174,14 +211,36 @@ private:
   {
     const ezRTTI* m_pRtti = nullptr;
     ezDynamicArray<ezComponentHandle> m_ComponentIndexToHandle;
+    ezDynamicArray<ComponentToCreate> m_ComponentsToCreate;
     ezUInt32 m_uiNumComponents = 0;
+    ezUInt32 m_uiCreationDataOffset = 0; ///< Where the creation data of this type starts in m_ComponentCreationStream.
   };
 
   ezDynamicArray<ComponentTypeInfo> m_ComponentTypes;
   ezHashTable<const ezRTTI*, ezUInt32> m_ComponentTypeVersions;
-  ezMemoryStreamStorage m_ComponentCreationStream;
+  ezMemoryStreamStorage m_ComponentCreationStream; ///< Only used until the creation data has been decoded into ComponentTypeInfo::m_ComponentsToCreate.
   ezMemoryStreamStorage m_ComponentDataStream;
   ezUInt64 m_uiTotalNumComponents = 0;
+  ezUInt32 m_uiParallelPreparationThreshold = 4096;
+
+  /// \brief Game object descriptions with the instantiation options already applied, used by InstantiatePrefabs().
+  struct InstantiationTemplate
+  {
+    bool m_bIsValid = false;
+
+    // the options that were applied
+    bool m_bForceDynamic = false;
+    bool m_bOverrideTeamID = false;
+    ezUInt16 m_uiOverrideTeamID = 0;
+    ezPrefabInstantiationOptions::RandomSeedMode m_RandomSeedMode = ezPrefabInstantiationOptions::RandomSeedMode::DeterministicFromParent;
+
+    ezDynamicArray<ezGameObjectDesc> m_RootObjects;
+    ezDynamicArray<ezTransform> m_RootObjectTransforms; ///< The local transforms of the root objects, before the root transform is applied.
+    ezDynamicArray<ezGameObjectDesc> m_ChildObjects;
+    ezDynamicArray<ezUInt32> m_ComponentTypesToCreate; ///< Indices into m_ComponentTypes of all types that have components.
+  };
+
+  InstantiationTemplate m_InstantiationTemplate;
 
   ezUniquePtr<ezStringDeduplicationReadContext> m_pStringDedupReadContext;
 
@@ -194,8 +253,14 @@ private:
     virtual StepResult Step() override;
     virtual void Cancel() override;
 
+    /// \brief Prepares the descriptions of all game objects on the worker threads, so that CreateGameObjects() only needs to insert them.
+    void PrepareGameObjects();
+
     template <bool UseTransform>
-    bool CreateGameObjects(const ezDynamicArray<GameObjectToCreate>& objects, ezGameObjectHandle hParent, ezDynamicArray<ezGameObject*>* out_CreatedObjects, ezTime endTime);
+    void PrepareGameObjectDesc(ezGameObjectDesc& desc) const;
+
+    template <bool UseTransform>
+    bool CreateGameObjects(const ezDynamicArray<GameObjectToCreate>& objects, ezArrayPtr<ezGameObjectDesc> preparedObjects, ezGameObjectHandle hParent, ezDynamicArray<ezGameObject*>* out_CreatedObjects, ezTime endTime);
 
     bool CreateComponents(ezTime endTime);
     bool DeserializeComponents(ezTime endTime);
@@ -238,6 +303,10 @@ private:
     ezUInt64 m_uiCurrentNumComponentsProcessed = 0;
     ezMemoryStreamReader m_CurrentReader;
 
+    // Filled by PrepareGameObjects(), otherwise every object is prepared right before it is created
+    ezDynamicArray<ezGameObjectDesc> m_PreparedRootObjects;
+    ezDynamicArray<ezGameObjectDesc> m_PreparedChildObjects;
+
     ezUniquePtr<ezProgressRange> m_pOverallProgressRange;
     ezUniquePtr<ezProgressRange> m_pSubProgressRange;
   };
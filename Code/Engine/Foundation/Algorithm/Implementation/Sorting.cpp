@@ -0,0 +1,33 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Algorithm/Sorting.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+// static
+ezUInt32 ezSorting::GetNumRadixSortTasks(ezUInt32 uiNumElements)
+{
+  // Counting and scattering is memory bound, so each task should at least process a few thousand elements to be worth the overhead.
+  const ezUInt32 uiMinElementsPerTask = 16 * 1024;
+  const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+
+  return ezMath::Clamp(uiNumElements / uiMinElementsPerTask, 1u, ezMath::Max(uiNumWorkers, 1u));
+}
+
+// static
+void ezSorting::RunRadixSortTasks(ezUInt32 uiNumTasks, RadixSortTaskFunc func, void* pContext)
+{
+  ezParallelForParams params;
+  params.uiBinSize = 1;
+  params.uiMaxTasksPerThread = 1;
+
+  ezTaskSystem::ParallelForIndexed(0, uiNumTasks,
+    [func, pContext](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 uiTaskIndex = uiStartIndex; uiTaskIndex < uiEndIndex; ++uiTaskIndex)
+      {
+        func(pContext, uiTaskIndex);
+      }
+    },
+    "RadixSort", params);
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Algorithm_Implementation_Sorting);
@@ -153,3 +153,141 @@ void ezSorting::InsertionSort(ezArrayPtr<T>& arrayPtr, ezUInt32 uiStartIndex, ez
     }
   }
 }
+
+template <typename T, typename KeyFunc>
+struct ezSorting::RadixSortContext
+{
+  T* m_pSource;
+  T* m_pDestination;
+  const KeyFunc* m_pKeyFunc;
+  ezUInt32 m_uiNumElements;
+  ezUInt32 m_uiChunkSize;
+  ezUInt32 m_uiShift;
+
+  // RADIX_NUM_BUCKETS counters or offsets per task
+  ezUInt32* m_pBuckets;
+
+  static void CountDigits(void* pContext, ezUInt32 uiTaskIndex)
+  {
+    const RadixSortContext& ctx = *static_cast<RadixSortContext*>(pContext);
+    ezUInt32* pBuckets = ctx.m_pBuckets + uiTaskIndex * RADIX_NUM_BUCKETS;
+
+    const ezUInt32 uiStart = uiTaskIndex * ctx.m_uiChunkSize;
+    const ezUInt32 uiEnd = ezMath::Min(uiStart + ctx.m_uiChunkSize, ctx.m_uiNumElements);
+
+    ezMemoryUtils::ZeroFill(pBuckets, RADIX_NUM_BUCKETS);
+
+    for (ezUInt32 i = uiStart; i < uiEnd; ++i)
+    {
+      const ezUInt64 uiKey = (*ctx.m_pKeyFunc)(ctx.m_pSource[i]);
+      ++pBuckets[(uiKey >> ctx.m_uiShift) & (RADIX_NUM_BUCKETS - 1)];
+    }
+  }
+
+  static void Scatter(void* pContext, ezUInt32 uiTaskIndex)
+  {
+    const RadixSortContext& ctx = *static_cast<RadixSortContext*>(pContext);
+    ezUInt32* pOffsets = ctx.m_pBuckets + uiTaskIndex * RADIX_NUM_BUCKETS;
+
+    const ezUInt32 uiStart = uiTaskIndex * ctx.m_uiChunkSize;
+    const ezUInt32 uiEnd = ezMath::Min(uiStart + ctx.m_uiChunkSize, ctx.m_uiNumElements);
+
+    for (ezUInt32 i = uiStart; i < uiEnd; ++i)
+    {
+      const ezUInt64 uiKey = (*ctx.m_pKeyFunc)(ctx.m_pSource[i]);
+      ctx.m_pDestination[pOffsets[(uiKey >> ctx.m_uiShift) & (RADIX_NUM_BUCKETS - 1)]++] = ctx.m_pSource[i];
+    }
+  }
+};
+
+template <typename T, typename KeyFunc>
+void ezSorting::RadixSort(ezArrayPtr<T> arrayPtr, ezArrayPtr<T> tempArray, const KeyFunc& keyFunc, bool bParallel)
+{
+  EZ_CHECK_AT_COMPILETIME_MSG(ezIsPodType<T>::value, "RadixSort only supports POD types since elements are copied between the arrays");
+
+  const ezUInt32 uiNumElements = arrayPtr.GetCount();
+  if (uiNumElements < 2)
+    return;
+
+  EZ_ASSERT_DEV(tempArray.GetCount() >= uiNumElements, "Temp array is too small, expected at least {0} elements.", uiNumElements);
+
+  // Histograms of all digits are independent of the element order, so they are computed once up front. They are used to skip passes and
+  // as the global bucket offsets of each pass.
+  ezUInt32 histograms[RADIX_NUM_PASSES][RADIX_NUM_BUCKETS] = {};
+  for (const T& element : arrayPtr)
+  {
+    ezUInt64 uiKey = keyFunc(element);
+    for (ezUInt32 uiPass = 0; uiPass < RADIX_NUM_PASSES; ++uiPass)
+    {
+      ++histograms[uiPass][uiKey & (RADIX_NUM_BUCKETS - 1)];
+      uiKey >>= RADIX_DIGIT_BITS;
+    }
+  }
+
+  const ezUInt32 uiNumTasks = bParallel ? GetNumRadixSortTasks(uiNumElements) : 1;
+
+  RadixSortContext<T, KeyFunc> ctx;
+  ctx.m_pSource = arrayPtr.GetPtr();
+  ctx.m_pDestination = tempArray.GetPtr();
+  ctx.m_pKeyFunc = &keyFunc;
+  ctx.m_uiNumElements = uiNumElements;
+  ctx.m_uiChunkSize = (uiNumElements + uiNumTasks - 1) / uiNumTasks;
+  ctx.m_uiShift = 0;
+
+  ezUInt32 serialBuckets[RADIX_NUM_BUCKETS];
+  ctx.m_pBuckets = uiNumTasks > 1 ? EZ_NEW_RAW_BUFFER(ezFoundation::GetDefaultAllocator(), ezUInt32, uiNumTasks * RADIX_NUM_BUCKETS) : serialBuckets;
+
+  for (ezUInt32 uiPass = 0; uiPass < RADIX_NUM_PASSES; ++uiPass, ctx.m_uiShift += RADIX_DIGIT_BITS)
+  {
+    const ezUInt32* pHistogram = histograms[uiPass];
+
+    // All keys have the same digit, this pass would not change the order
+    if (pHistogram[(keyFunc(arrayPtr[0]) >> ctx.m_uiShift) & (RADIX_NUM_BUCKETS - 1)] == uiNumElements)
+      continue;
+
+    if (uiNumTasks > 1)
+    {
+      RunRadixSortTasks(uiNumTasks, &RadixSortContext<T, KeyFunc>::CountDigits, &ctx);
+
+      // Turn the per task counts into per task offsets. Tasks write their part of a bucket in order so the sort stays stable.
+      ezUInt32 uiOffset = 0;
+      for (ezUInt32 uiBucket = 0; uiBucket < RADIX_NUM_BUCKETS; ++uiBucket)
+      {
+        for (ezUInt32 uiTask = 0; uiTask < uiNumTasks; ++uiTask)
+        {
+          ezUInt32& uiCount = ctx.m_pBuckets[uiTask * RADIX_NUM_BUCKETS + uiBucket];
+          const ezUInt32 uiTaskCount = uiCount;
+          uiCount = uiOffset;
+          uiOffset += uiTaskCount;
+        }
+      }
+
+      RunRadixSortTasks(uiNumTasks, &RadixSortContext<T, KeyFunc>::Scatter, &ctx);
+    }
+    else
+    {
+      ezUInt32 uiOffset = 0;
+      for (ezUInt32 uiBucket = 0; uiBucket < RADIX_NUM_BUCKETS; ++uiBucket)
+      {
+        ctx.m_pBuckets[uiBucket] = uiOffset;
+        uiOffset += pHistogram[uiBucket];
+      }
+
+      RadixSortContext<T, KeyFunc>::Scatter(&ctx, 0);
+    }
+
+    T* pNewSource = ctx.m_pDestination;
+    ctx.m_pDestination = ctx.m_pSource;
+    ctx.m_pSource = pNewSource;
+  }
+
+  if (ctx.m_pSource != arrayPtr.GetPtr())
+  {
+    ezMemoryUtils::Copy(arrayPtr.GetPtr(), ctx.m_pSource, uiNumElements);
+  }
+
+  if (uiNumTasks > 1)
+  {
+    EZ_DELETE_RAW_BUFFER(ezFoundation::GetDefaultAllocator(), ctx.m_pBuckets);
+  }
+}
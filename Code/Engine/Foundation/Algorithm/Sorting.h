@@ -27,6 +27,16 @@ public:
   template <typename T, typename Comparer>
   static void InsertionSort(ezArrayPtr<T>& arrayPtr, const Comparer& comparer = Comparer()); // [tested]
 
+
+  /// \brief Sorts the elements in the array by an unsigned 64-bit key using an LSD radix sort (stable, not in-place).
+  ///
+  /// \a keyFunc is called with an element and has to return its ezUInt64 key. \a tempArray must have at least as many elements as
+  /// \a arrayPtr and is used as scratch memory, the sorted result always ends up in \a arrayPtr. Only POD types are supported.
+  /// Digit passes in which all keys are equal are skipped, so keys that only use some of the 64 bits need fewer passes.
+  /// If \a bParallel is set, large arrays are counted and scattered with multiple tasks of the ezTaskSystem.
+  template <typename T, typename KeyFunc>
+  static void RadixSort(ezArrayPtr<T> arrayPtr, ezArrayPtr<T> tempArray, const KeyFunc& keyFunc, bool bParallel = false); // [tested]
+
 private:
   enum
   {
@@ -72,6 +82,23 @@ private:
 
   template <typename T, typename Comparer>
   static void InsertionSort(ezArrayPtr<T>& arrayPtr, ezUInt32 uiStartIndex, ezUInt32 uiEndIndex, const Comparer& comparer);
+
+
+  enum
+  {
+    RADIX_DIGIT_BITS = 8,
+    RADIX_NUM_BUCKETS = 1 << RADIX_DIGIT_BITS,
+    RADIX_NUM_PASSES = 64 / RADIX_DIGIT_BITS,
+  };
+
+  template <typename T, typename KeyFunc>
+  struct RadixSortContext;
+
+  using RadixSortTaskFunc = void (*)(void* pContext, ezUInt32 uiTaskIndex);
+
+  // The parallel parts of the radix sort are implemented in the cpp, this header can't depend on the task system.
+  EZ_FOUNDATION_DLL static ezUInt32 GetNumRadixSortTasks(ezUInt32 uiNumElements);
+  EZ_FOUNDATION_DLL static void RunRadixSortTasks(ezUInt32 uiNumTasks, RadixSortTaskFunc func, void* pContext);
 };
 
 #include <Foundation/Algorithm/Implementation/Sorting_inl.h>
@@ -63,6 +63,7 @@
 #define EZ_SUPPORTS_CASE_INSENSITIVE_PATHS EZ_OFF
 #define EZ_SUPPORTS_CRASH_DUMPS EZ_OFF
 #define EZ_SUPPORTS_LONG_PATHS EZ_OFF
+#define EZ_SUPPORTS_DIRECTORY_WATCHER EZ_OFF
 
 // Allocators
 #define EZ_USE_ALLOCATION_TRACKING EZ_OFF
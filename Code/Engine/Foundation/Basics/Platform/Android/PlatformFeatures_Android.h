@@ -45,6 +45,10 @@
 #undef EZ_SUPPORTS_PROCESSES
 #define EZ_SUPPORTS_PROCESSES EZ_OFF
 
+/// Whether ezDirectoryWatcher reports file changes.
+#undef EZ_SUPPORTS_DIRECTORY_WATCHER
+#define EZ_SUPPORTS_DIRECTORY_WATCHER EZ_OFF
+
 // SIMD support
 #undef EZ_SIMD_IMPLEMENTATION
 #define EZ_SIMD_IMPLEMENTATION EZ_SIMD_IMPLEMENTATION_FPU
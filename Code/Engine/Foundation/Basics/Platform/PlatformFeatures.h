@@ -50,3 +50,7 @@
 #ifndef EZ_SUPPORTS_LONG_PATHS
 #  error "EZ_SUPPORTS_LONG_PATHS is not defined."
 #endif
+
+#ifndef EZ_SUPPORTS_DIRECTORY_WATCHER
+#  error "EZ_SUPPORTS_DIRECTORY_WATCHER is not defined."
+#endif
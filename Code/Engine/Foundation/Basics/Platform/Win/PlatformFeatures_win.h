@@ -64,6 +64,14 @@
 #  define EZ_SUPPORTS_PROCESSES EZ_ON
 #endif
 
+/// Whether ezDirectoryWatcher reports file changes.
+#undef EZ_SUPPORTS_DIRECTORY_WATCHER
+#if EZ_ENABLED(EZ_PLATFORM_WINDOWS_UWP)
+#  define EZ_SUPPORTS_DIRECTORY_WATCHER EZ_OFF
+#else
+#  define EZ_SUPPORTS_DIRECTORY_WATCHER EZ_ON
+#endif
+
 // SIMD support
 #undef EZ_SIMD_IMPLEMENTATION
 
@@ -36,7 +36,15 @@ const ezTokenizer* ezTokenizedFileCache::Tokenize(const ezString& sFileName, ezA
 {
   EZ_LOCK(m_Mutex);
 
-  auto& data = m_Cache[sFileName];
+  bool bExisted = false;
+  auto it = m_Cache.FindOrAdd(sFileName, &bExisted);
+
+  // another thread that shares this cache may have tokenized the file in the meantime
+  // its tokens may already be in use, so they must not be replaced
+  if (bExisted)
+    return &it.Value().m_Tokens;
+
+  auto& data = it.Value();
 
   data.m_Timestamp = FileTimeStamp;
   ezTokenizer* pTokenizer = &data.m_Tokens;
@@ -34,6 +34,8 @@ public:
   ///
   //// The file content is tokenized first and all #line directives are evaluated, to update the line number and file origin for each token.
   /// Any errors are written to the given log.
+  /// If the file is already cached, e.g. because another thread sharing this cache tokenized it concurrently, the cached tokens are returned
+  /// unchanged. Call Remove() first to force the file to be re-tokenized.
   const ezTokenizer* Tokenize(const ezString& sFileName, ezArrayPtr<const ezUInt8> FileContent, const ezTimestamp& FileTimeStamp, ezLogInterface* pLog);
 
 private:
@@ -0,0 +1,22 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Communication/MessageQueue.h>
+#include <Foundation/Threading/AtomicInteger.h>
+
+namespace
+{
+  ezAtomicInteger32 s_iNextThreadShardIndex;
+  thread_local ezInt32 tl_iThreadShardIndex = -1;
+} // namespace
+
+ezUInt32 ezInternal::GetThreadShardIndex()
+{
+  if (tl_iThreadShardIndex < 0)
+  {
+    tl_iThreadShardIndex = s_iNextThreadShardIndex.PostIncrement() & 0x7FFFFFFF;
+  }
+
+  return static_cast<ezUInt32>(tl_iThreadShardIndex);
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Communication_Implementation_MessageQueue);
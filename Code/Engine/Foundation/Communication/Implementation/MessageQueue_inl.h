@@ -182,3 +182,65 @@ void ezMessageQueue<MD, A>::operator=(const ezMessageQueueBase<MD>& rhs)
 {
   ezMessageQueueBase<MD>::operator=(rhs);
 }
+
+
+template <typename MD, typename A>
+ezShardedMessageQueue<MD, A>::ezShardedMessageQueue() = default;
+
+template <typename MD, typename A>
+void ezShardedMessageQueue<MD, A>::Enqueue(ezMessage* pMessage, const MD& metaData)
+{
+  Entry entry;
+  entry.m_pMessage = pMessage;
+  entry.m_MetaData = metaData;
+
+  Shard& shard = m_Shards[ezInternal::GetThreadShardIndex() % NUM_SHARDS];
+
+  {
+    EZ_LOCK(shard.m_Mutex);
+
+    shard.m_Entries.PushBack(entry);
+  }
+}
+
+template <typename MD, typename A>
+void ezShardedMessageQueue<MD, A>::MergeShards()
+{
+  ezUInt32 uiNumEntries = this->m_Queue.GetCount();
+  for (const Shard& shard : m_Shards)
+  {
+    uiNumEntries += shard.m_Entries.GetCount();
+  }
+
+  this->m_Queue.Reserve(uiNumEntries);
+
+  for (Shard& shard : m_Shards)
+  {
+    for (const Entry& entry : shard.m_Entries)
+    {
+      this->m_Queue.PushBack(entry);
+    }
+
+    shard.m_Entries.Clear();
+  }
+}
+
+template <typename MD, typename A>
+template <typename Comparer>
+EZ_ALWAYS_INLINE void ezShardedMessageQueue<MD, A>::Sort(const Comparer& comparer)
+{
+  MergeShards();
+
+  ezMessageQueueBase<MD>::Sort(comparer);
+}
+
+template <typename MD, typename A>
+void ezShardedMessageQueue<MD, A>::Clear()
+{
+  for (Shard& shard : m_Shards)
+  {
+    shard.m_Entries.Clear();
+  }
+
+  ezMessageQueueBase<MD>::Clear();
+}
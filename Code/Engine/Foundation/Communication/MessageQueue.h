@@ -3,6 +3,7 @@
 
 #include <Foundation/Communication/Message.h>
 #include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
 
@@ -86,8 +87,10 @@ public:
   /// \brief Releases a lock that has been previously acquired. Do not use this method directly but use ezLock instead.
   void Unlock(); // [tested]
 
-private:
+protected:
   ezDeque<Entry, ezNullAllocatorWrapper> m_Queue;
+
+private:
   ezMutex m_Mutex;
 };
 
@@ -106,4 +109,55 @@ public:
   void operator=(const ezMessageQueueBase<MetaDataType>& rhs);
 };
 
+namespace ezInternal
+{
+  /// \brief Returns a small index that is assigned to the calling thread on first use. Used to spread writes of concurrent threads over
+  /// several shards.
+  EZ_FOUNDATION_DLL ezUInt32 GetThreadShardIndex();
+} // namespace ezInternal
+
+/// \brief A message queue that is optimized for many threads enqueuing at the same time.
+///
+/// Enqueue writes into one of several shards that is picked by the calling thread, so concurrent producers rarely contend on the same
+/// lock. Before the queue is processed the shards have to be merged into the queue with MergeShards, Sort does this automatically.
+/// All other methods inherited from ezMessageQueueBase only see entries that have been merged already.
+/// The order of messages that are enqueued concurrently is not deterministic, so the queue should always be sorted before delivery.
+template <typename MetaDataType, typename AllocatorWrapper = ezDefaultAllocatorWrapper>
+class ezShardedMessageQueue : public ezMessageQueue<MetaDataType, AllocatorWrapper>
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezShardedMessageQueue);
+
+public:
+  using Entry = typename ezMessageQueueBase<MetaDataType>::Entry;
+
+  ezShardedMessageQueue();
+
+  /// \brief Enqueues the given message and meta-data into the shard of the calling thread. This method is thread safe.
+  void Enqueue(ezMessage* pMessage, const MetaDataType& metaData); // [tested]
+
+  /// \brief Moves the entries of all shards to the end of the queue. Not thread safe.
+  void MergeShards(); // [tested]
+
+  /// \brief Merges the shards and sorts the queue with explicit comparer. Not thread safe.
+  template <typename Comparer>
+  void Sort(const Comparer& comparer); // [tested]
+
+  /// \brief Destructs all elements in the queue and in the shards. Does not deallocate any data.
+  void Clear();
+
+private:
+  enum
+  {
+    NUM_SHARDS = 16
+  };
+
+  struct Shard
+  {
+    ezMutex m_Mutex;
+    ezDynamicArray<Entry, AllocatorWrapper> m_Entries;
+  };
+
+  Shard m_Shards[NUM_SHARDS];
+};
+
 #include <Foundation/Communication/Implementation/MessageQueue_inl.h>
@@ -0,0 +1,910 @@
+#pragma once
+
+/// \brief Value used by containers for indices to indicate an invalid index.
+#ifndef ezInvalidIndex
+#  define ezInvalidIndex 0xFFFFFFFF
+#endif
+
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86)
+#  define EZ_FLATHASHTABLE_USE_SSE EZ_ON
+#  define EZ_FLATHASHTABLE_USE_NEON EZ_OFF
+#  include <emmintrin.h>
+#elif EZ_ENABLED(EZ_PLATFORM_ARCH_ARM) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#  define EZ_FLATHASHTABLE_USE_SSE EZ_OFF
+#  define EZ_FLATHASHTABLE_USE_NEON EZ_ON
+#  include <arm_neon.h>
+#else
+#  define EZ_FLATHASHTABLE_USE_SSE EZ_OFF
+#  define EZ_FLATHASHTABLE_USE_NEON EZ_OFF
+#endif
+
+namespace ezInternal
+{
+  /// \brief The control bytes of 16 consecutive slots of an ezFlatHashTable.
+  ///
+  /// All Match functions return a bitmask with one bit per slot, bit 0 corresponds to the first slot of the group.
+  struct FlatHashTableGroup
+  {
+    EZ_ALWAYS_INLINE explicit FlatHashTableGroup(const ezUInt8* pControlBytes)
+    {
+#if EZ_ENABLED(EZ_FLATHASHTABLE_USE_SSE)
+      m_ControlBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pControlBytes));
+#elif EZ_ENABLED(EZ_FLATHASHTABLE_USE_NEON)
+      m_ControlBytes = vld1q_u8(pControlBytes);
+#else
+      m_pControlBytes = pControlBytes;
+#endif
+    }
+
+    /// \brief Returns the slots that store the given hash fragment.
+    EZ_ALWAYS_INLINE ezUInt32 Match(ezUInt8 uiHashFragment) const
+    {
+#if EZ_ENABLED(EZ_FLATHASHTABLE_USE_SSE)
+      return static_cast<ezUInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(uiHashFragment)), m_ControlBytes)));
+#elif EZ_ENABLED(EZ_FLATHASHTABLE_USE_NEON)
+      return MoveMask(vceqq_u8(vdupq_n_u8(uiHashFragment), m_ControlBytes));
+#else
+      ezUInt32 uiMask = 0;
+      for (ezUInt32 i = 0; i < 16; ++i)
+      {
+        uiMask |= (m_pControlBytes[i] == uiHashFragment ? 1u : 0u) << i;
+      }
+      return uiMask;
+#endif
+    }
+
+    /// \brief Returns the slots that have never been used since the last rehash.
+    EZ_ALWAYS_INLINE ezUInt32 MatchEmpty() const { return Match(0x80); }
+
+    /// \brief Returns the slots that don't store an element. Only empty and deleted slots have the highest bit set.
+    EZ_ALWAYS_INLINE ezUInt32 MatchEmptyOrDeleted() const
+    {
+#if EZ_ENABLED(EZ_FLATHASHTABLE_USE_SSE)
+      return static_cast<ezUInt32>(_mm_movemask_epi8(m_ControlBytes));
+#elif EZ_ENABLED(EZ_FLATHASHTABLE_USE_NEON)
+      return MoveMask(vtstq_u8(m_ControlBytes, vdupq_n_u8(0x80)));
+#else
+      ezUInt32 uiMask = 0;
+      for (ezUInt32 i = 0; i < 16; ++i)
+      {
+        uiMask |= (m_pControlBytes[i] >> 7) << i;
+      }
+      return uiMask;
+#endif
+    }
+
+  private:
+#if EZ_ENABLED(EZ_FLATHASHTABLE_USE_SSE)
+    __m128i m_ControlBytes;
+#elif EZ_ENABLED(EZ_FLATHASHTABLE_USE_NEON)
+    // NEON has no movemask, so every byte is reduced to its bit and the bits are summed up horizontally
+    EZ_ALWAYS_INLINE static ezUInt32 MoveMask(uint8x16_t mask)
+    {
+      static const ezUInt8 s_Bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+      const uint8x16_t maskedBits = vandq_u8(mask, vld1q_u8(s_Bits));
+
+      uint8x8_t sum = vpadd_u8(vget_low_u8(maskedBits), vget_high_u8(maskedBits));
+      sum = vpadd_u8(sum, sum);
+      sum = vpadd_u8(sum, sum);
+
+      return static_cast<ezUInt32>(vget_lane_u8(sum, 0)) | (static_cast<ezUInt32>(vget_lane_u8(sum, 1)) << 8);
+    }
+
+    uint8x16_t m_ControlBytes;
+#else
+    const ezUInt8* m_pControlBytes;
+#endif
+  };
+} // namespace ezInternal
+
+// ***** Const Iterator *****
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::ConstIterator::ConstIterator(const ezFlatHashTableBase<K, V, H>& hashTable)
+  : m_hashTable(&hashTable)
+{
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::ConstIterator::SetToBegin()
+{
+  if (m_hashTable->IsEmpty())
+  {
+    m_uiCurrentIndex = m_hashTable->m_uiCapacity;
+    return;
+  }
+  while (!m_hashTable->IsValidEntry(m_uiCurrentIndex))
+  {
+    ++m_uiCurrentIndex;
+  }
+}
+
+template <typename K, typename V, typename H>
+inline void ezFlatHashTableBase<K, V, H>::ConstIterator::SetToEnd()
+{
+  m_uiCurrentCount = m_hashTable->m_uiCount;
+  m_uiCurrentIndex = m_hashTable->m_uiCapacity;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE bool ezFlatHashTableBase<K, V, H>::ConstIterator::IsValid() const
+{
+  return m_uiCurrentCount < m_hashTable->m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE bool ezFlatHashTableBase<K, V, H>::ConstIterator::operator==(const typename ezFlatHashTableBase<K, V, H>::ConstIterator& rhs) const
+{
+  return m_uiCurrentIndex == rhs.m_uiCurrentIndex && m_hashTable->m_pEntries == rhs.m_hashTable->m_pEntries;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezFlatHashTableBase<K, V, H>::ConstIterator::operator!=(const typename ezFlatHashTableBase<K, V, H>::ConstIterator& rhs) const
+{
+  return !(*this == rhs);
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE const K& ezFlatHashTableBase<K, V, H>::ConstIterator::Key() const
+{
+  return m_hashTable->m_pEntries[m_uiCurrentIndex].key;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE const V& ezFlatHashTableBase<K, V, H>::ConstIterator::Value() const
+{
+  return m_hashTable->m_pEntries[m_uiCurrentIndex].value;
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::ConstIterator::Next()
+{
+  // if we already iterated over the amount of valid elements that the hash-table stores, early out
+  if (m_uiCurrentCount >= m_hashTable->m_uiCount)
+    return;
+
+  // increase the counter of how many elements we have seen
+  ++m_uiCurrentCount;
+  // increase the index of the element to look at
+  ++m_uiCurrentIndex;
+
+  // check that we don't leave the valid range of element indices
+  while (m_uiCurrentIndex < m_hashTable->m_uiCapacity)
+  {
+    if (m_hashTable->IsValidEntry(m_uiCurrentIndex))
+      return;
+
+    ++m_uiCurrentIndex;
+  }
+
+  // if we fell through this loop, we reached the end of all elements in the container
+  // set the m_uiCurrentCount to maximum, to enable early-out in the future and to make 'IsValid' return 'false'
+  m_uiCurrentCount = m_hashTable->m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE void ezFlatHashTableBase<K, V, H>::ConstIterator::operator++()
+{
+  Next();
+}
+
+
+// ***** Iterator *****
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::Iterator::Iterator(const ezFlatHashTableBase<K, V, H>& hashTable)
+  : ConstIterator(hashTable)
+{
+}
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::Iterator::Iterator(const typename ezFlatHashTableBase<K, V, H>::Iterator& rhs)
+  : ConstIterator(*rhs.m_hashTable)
+{
+  this->m_uiCurrentIndex = rhs.m_uiCurrentIndex;
+  this->m_uiCurrentCount = rhs.m_uiCurrentCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE void ezFlatHashTableBase<K, V, H>::Iterator::operator=(const Iterator& rhs) // [tested]
+{
+  this->m_hashTable = rhs.m_hashTable;
+  this->m_uiCurrentIndex = rhs.m_uiCurrentIndex;
+  this->m_uiCurrentCount = rhs.m_uiCurrentCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE V& ezFlatHashTableBase<K, V, H>::Iterator::Value()
+{
+  return this->m_hashTable->m_pEntries[this->m_uiCurrentIndex].value;
+}
+
+
+// ***** ezFlatHashTableBase *****
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::ezFlatHashTableBase(ezAllocatorBase* pAllocator)
+{
+  m_pEntries = nullptr;
+  m_pControlBytes = nullptr;
+  m_uiCount = 0;
+  m_uiCapacity = 0;
+  m_uiGrowthLeft = 0;
+  m_pAllocator = pAllocator;
+}
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::ezFlatHashTableBase(const ezFlatHashTableBase<K, V, H>& other, ezAllocatorBase* pAllocator)
+{
+  m_pEntries = nullptr;
+  m_pControlBytes = nullptr;
+  m_uiCount = 0;
+  m_uiCapacity = 0;
+  m_uiGrowthLeft = 0;
+  m_pAllocator = pAllocator;
+
+  *this = other;
+}
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::ezFlatHashTableBase(ezFlatHashTableBase<K, V, H>&& other, ezAllocatorBase* pAllocator)
+{
+  m_pEntries = nullptr;
+  m_pControlBytes = nullptr;
+  m_uiCount = 0;
+  m_uiCapacity = 0;
+  m_uiGrowthLeft = 0;
+  m_pAllocator = pAllocator;
+
+  *this = std::move(other);
+}
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::~ezFlatHashTableBase()
+{
+  Clear();
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pEntries);
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pControlBytes);
+  m_uiCapacity = 0;
+  m_uiGrowthLeft = 0;
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::operator=(const ezFlatHashTableBase<K, V, H>& rhs)
+{
+  Clear();
+  Reserve(rhs.GetCount());
+
+  ezUInt32 uiCopied = 0;
+  for (ezUInt32 i = 0; uiCopied < rhs.GetCount(); ++i)
+  {
+    if (rhs.IsValidEntry(i))
+    {
+      Insert(rhs.m_pEntries[i].key, rhs.m_pEntries[i].value);
+      ++uiCopied;
+    }
+  }
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::operator=(ezFlatHashTableBase<K, V, H>&& rhs)
+{
+  // Clear any existing data (calls destructors if necessary)
+  Clear();
+
+  if (m_pAllocator != rhs.m_pAllocator)
+  {
+    Reserve(rhs.m_uiCount);
+
+    ezUInt32 uiCopied = 0;
+    for (ezUInt32 i = 0; uiCopied < rhs.GetCount(); ++i)
+    {
+      if (rhs.IsValidEntry(i))
+      {
+        Insert(std::move(rhs.m_pEntries[i].key), std::move(rhs.m_pEntries[i].value));
+        ++uiCopied;
+      }
+    }
+
+    rhs.Clear();
+  }
+  else
+  {
+    EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pEntries);
+    EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pControlBytes);
+
+    // Move all data over.
+    m_pEntries = rhs.m_pEntries;
+    m_pControlBytes = rhs.m_pControlBytes;
+    m_uiCount = rhs.m_uiCount;
+    m_uiCapacity = rhs.m_uiCapacity;
+    m_uiGrowthLeft = rhs.m_uiGrowthLeft;
+
+    // Temp copy forgets all its state.
+    rhs.m_pEntries = nullptr;
+    rhs.m_pControlBytes = nullptr;
+    rhs.m_uiCount = 0;
+    rhs.m_uiCapacity = 0;
+    rhs.m_uiGrowthLeft = 0;
+  }
+}
+
+template <typename K, typename V, typename H>
+bool ezFlatHashTableBase<K, V, H>::operator==(const ezFlatHashTableBase<K, V, H>& rhs) const
+{
+  if (m_uiCount != rhs.m_uiCount)
+    return false;
+
+  ezUInt32 uiCompared = 0;
+  for (ezUInt32 i = 0; uiCompared < m_uiCount; ++i)
+  {
+    if (IsValidEntry(i))
+    {
+      const V* pRhsValue = nullptr;
+      if (!rhs.TryGetValue(m_pEntries[i].key, pRhsValue))
+        return false;
+
+      if (m_pEntries[i].value != *pRhsValue)
+        return false;
+
+      ++uiCompared;
+    }
+  }
+
+  return true;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezFlatHashTableBase<K, V, H>::operator!=(const ezFlatHashTableBase<K, V, H>& rhs) const
+{
+  return !(*this == rhs);
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::Reserve(ezUInt32 uiCapacity)
+{
+  EZ_ASSERT_DEBUG(uiCapacity <= GetMaxLoad(0x80000000u), "ezFlatHashTable does not support more than 1.8 billion entries.");
+
+  ezUInt32 uiNewCapacity = GROUP_SIZE;
+  while (GetMaxLoad(uiNewCapacity) < uiCapacity && uiNewCapacity < 0x80000000u)
+  {
+    uiNewCapacity *= 2;
+  }
+
+  if (m_uiCapacity >= uiNewCapacity)
+    return;
+
+  SetCapacity(uiNewCapacity);
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::Compact()
+{
+  if (IsEmpty())
+  {
+    // completely deallocate all data, if the table is empty.
+    EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pEntries);
+    EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pControlBytes);
+    m_uiCapacity = 0;
+    m_uiGrowthLeft = 0;
+  }
+  else
+  {
+    ezUInt32 uiNewCapacity = GROUP_SIZE;
+    while (GetMaxLoad(uiNewCapacity) < m_uiCount)
+    {
+      uiNewCapacity *= 2;
+    }
+
+    // rehashing at the same capacity still gets rid of all deleted slots
+    const bool bHasDeletedSlots = m_uiCount + m_uiGrowthLeft < GetMaxLoad(m_uiCapacity);
+    if (m_uiCapacity != uiNewCapacity || bHasDeletedSlots)
+      SetCapacity(uiNewCapacity);
+  }
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::GetCount() const
+{
+  return m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezFlatHashTableBase<K, V, H>::IsEmpty() const
+{
+  return m_uiCount == 0;
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::Clear()
+{
+  for (ezUInt32 i = 0; i < m_uiCapacity; ++i)
+  {
+    if (IsValidEntry(i))
+    {
+      ezMemoryUtils::Destruct(&m_pEntries[i].key, 1);
+      ezMemoryUtils::Destruct(&m_pEntries[i].value, 1);
+    }
+  }
+
+  ezMemoryUtils::PatternFill(m_pControlBytes, CONTROL_EMPTY, m_uiCapacity);
+  m_uiCount = 0;
+  m_uiGrowthLeft = GetMaxLoad(m_uiCapacity);
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType, typename CompatibleValueType>
+bool ezFlatHashTableBase<K, V, H>::Insert(CompatibleKeyType&& key, CompatibleValueType&& value, V* out_oldValue /*= nullptr*/)
+{
+  const ezUInt32 uiHash = H::Hash(key);
+  ezUInt32 uiIndex = FindEntry(uiHash, key);
+
+  if (uiIndex != ezInvalidIndex)
+  {
+    if (out_oldValue != nullptr)
+      *out_oldValue = std::move(m_pEntries[uiIndex].value);
+
+    m_pEntries[uiIndex].value = std::forward<CompatibleValueType>(value); // Either move or copy assignment.
+    return true;
+  }
+
+  uiIndex = AddEntry(uiHash);
+
+  // Both constructions might either be a move or a copy.
+  ezMemoryUtils::CopyOrMoveConstruct(&m_pEntries[uiIndex].key, std::forward<CompatibleKeyType>(key));
+  ezMemoryUtils::CopyOrMoveConstruct(&m_pEntries[uiIndex].value, std::forward<CompatibleValueType>(value));
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+bool ezFlatHashTableBase<K, V, H>::Remove(const CompatibleKeyType& key, V* out_oldValue /*= nullptr*/)
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    if (out_oldValue != nullptr)
+      *out_oldValue = std::move(m_pEntries[uiIndex].value);
+
+    RemoveInternal(uiIndex);
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+typename ezFlatHashTableBase<K, V, H>::Iterator ezFlatHashTableBase<K, V, H>::Remove(const typename ezFlatHashTableBase<K, V, H>::Iterator& pos)
+{
+  Iterator it = pos;
+  ezUInt32 uiIndex = pos.m_uiCurrentIndex;
+  ++it;
+  --it.m_uiCurrentCount;
+  RemoveInternal(uiIndex);
+  return it;
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::RemoveInternal(ezUInt32 uiIndex)
+{
+  ezMemoryUtils::Destruct(&m_pEntries[uiIndex].key, 1);
+  ezMemoryUtils::Destruct(&m_pEntries[uiIndex].value, 1);
+
+  // Lookups only continue past groups without any empty slot. If the group still has an empty slot no lookup ever went past it,
+  // so the slot can be marked as empty again instead of leaving a tombstone behind.
+  const ezInternal::FlatHashTableGroup group(m_pControlBytes + (uiIndex & ~(GROUP_SIZE - 1)));
+  if (group.MatchEmpty() != 0)
+  {
+    m_pControlBytes[uiIndex] = CONTROL_EMPTY;
+    ++m_uiGrowthLeft;
+  }
+  else
+  {
+    m_pControlBytes[uiIndex] = CONTROL_DELETED;
+  }
+
+  --m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool ezFlatHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, V& out_value) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    out_value = m_pEntries[uiIndex].value;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool ezFlatHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, const V*& out_pValue) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    out_pValue = &m_pEntries[uiIndex].value;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool ezFlatHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, V*& out_pValue) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    out_pValue = &m_pEntries[uiIndex].value;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline typename ezFlatHashTableBase<K, V, H>::ConstIterator ezFlatHashTableBase<K, V, H>::Find(const CompatibleKeyType& key) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex == ezInvalidIndex)
+  {
+    return GetEndIterator();
+  }
+
+  ConstIterator it(*this);
+  it.m_uiCurrentIndex = uiIndex;
+  it.m_uiCurrentCount = 0; // we do not know the 'count' (which is used as an optimization), so we just use 0
+
+  return it;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline typename ezFlatHashTableBase<K, V, H>::Iterator ezFlatHashTableBase<K, V, H>::Find(const CompatibleKeyType& key)
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex == ezInvalidIndex)
+  {
+    return GetEndIterator();
+  }
+
+  Iterator it(*this);
+  it.m_uiCurrentIndex = uiIndex;
+  it.m_uiCurrentCount = 0; // we do not know the 'count' (which is used as an optimization), so we just use 0
+  return it;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline const V* ezFlatHashTableBase<K, V, H>::GetValue(const CompatibleKeyType& key) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  return (uiIndex != ezInvalidIndex) ? &m_pEntries[uiIndex].value : nullptr;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline V* ezFlatHashTableBase<K, V, H>::GetValue(const CompatibleKeyType& key)
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  return (uiIndex != ezInvalidIndex) ? &m_pEntries[uiIndex].value : nullptr;
+}
+
+template <typename K, typename V, typename H>
+inline V& ezFlatHashTableBase<K, V, H>::operator[](const K& key)
+{
+  return FindOrAdd(key, nullptr);
+}
+
+template <typename K, typename V, typename H>
+V& ezFlatHashTableBase<K, V, H>::FindOrAdd(const K& key, bool* bExisted)
+{
+  const ezUInt32 uiHash = H::Hash(key);
+  ezUInt32 uiIndex = FindEntry(uiHash, key);
+
+  if (bExisted)
+  {
+    *bExisted = uiIndex != ezInvalidIndex;
+  }
+
+  if (uiIndex == ezInvalidIndex)
+  {
+    uiIndex = AddEntry(uiHash);
+
+    // new entry
+    ezMemoryUtils::CopyConstruct(&m_pEntries[uiIndex].key, key, 1);
+    ezMemoryUtils::DefaultConstruct(&m_pEntries[uiIndex].value, 1);
+  }
+  return m_pEntries[uiIndex].value;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE bool ezFlatHashTableBase<K, V, H>::Contains(const CompatibleKeyType& key) const
+{
+  return FindEntry(key) != ezInvalidIndex;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezFlatHashTableBase<K, V, H>::Iterator ezFlatHashTableBase<K, V, H>::GetIterator()
+{
+  Iterator iterator(*this);
+  iterator.SetToBegin();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezFlatHashTableBase<K, V, H>::Iterator ezFlatHashTableBase<K, V, H>::GetEndIterator()
+{
+  Iterator iterator(*this);
+  iterator.SetToEnd();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezFlatHashTableBase<K, V, H>::ConstIterator ezFlatHashTableBase<K, V, H>::GetIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToBegin();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezFlatHashTableBase<K, V, H>::ConstIterator ezFlatHashTableBase<K, V, H>::GetEndIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToEnd();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezAllocatorBase* ezFlatHashTableBase<K, V, H>::GetAllocator() const
+{
+  return m_pAllocator;
+}
+
+template <typename K, typename V, typename H>
+ezUInt64 ezFlatHashTableBase<K, V, H>::GetHeapMemoryUsage() const
+{
+  return (ezUInt64)m_uiCapacity * (sizeof(Entry) + sizeof(ezUInt8));
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void ezFlatHashTableBase<KeyType, ValueType, Hasher>::Swap(ezFlatHashTableBase<KeyType, ValueType, Hasher>& other)
+{
+  ezMath::Swap(this->m_pEntries, other.m_pEntries);
+  ezMath::Swap(this->m_pControlBytes, other.m_pControlBytes);
+  ezMath::Swap(this->m_uiCount, other.m_uiCount);
+  ezMath::Swap(this->m_uiCapacity, other.m_uiCapacity);
+  ezMath::Swap(this->m_uiGrowthLeft, other.m_uiGrowthLeft);
+  ezMath::Swap(this->m_pAllocator, other.m_pAllocator);
+}
+
+// private methods
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::SetCapacity(ezUInt32 uiCapacity)
+{
+  EZ_ASSERT_DEV(ezMath::IsPowerOf2(uiCapacity) && uiCapacity >= GROUP_SIZE, "uiCapacity must be a power of two and at least one group.");
+  const ezUInt32 uiOldCapacity = m_uiCapacity;
+  m_uiCapacity = uiCapacity;
+
+  Entry* pOldEntries = m_pEntries;
+  ezUInt8* pOldControlBytes = m_pControlBytes;
+
+  m_pEntries = EZ_NEW_RAW_BUFFER(m_pAllocator, Entry, m_uiCapacity);
+  m_pControlBytes = EZ_NEW_RAW_BUFFER(m_pAllocator, ezUInt8, m_uiCapacity);
+  ezMemoryUtils::PatternFill(m_pControlBytes, CONTROL_EMPTY, m_uiCapacity);
+
+  m_uiCount = 0;
+  m_uiGrowthLeft = GetMaxLoad(m_uiCapacity);
+
+  for (ezUInt32 i = 0; i < uiOldCapacity; ++i)
+  {
+    if ((pOldControlBytes[i] & 0x80) == 0)
+    {
+      // all keys are unique, so the new slot can be taken directly without looking for the key first
+      const ezUInt32 uiIndex = AddEntry(H::Hash(pOldEntries[i].key));
+
+      ezMemoryUtils::RelocateConstruct(&m_pEntries[uiIndex].key, &pOldEntries[i].key, 1);
+      ezMemoryUtils::RelocateConstruct(&m_pEntries[uiIndex].value, &pOldEntries[i].value, 1);
+    }
+  }
+
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, pOldEntries);
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, pOldControlBytes);
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::Grow()
+{
+  // If a good part of the used slots are deleted ones, rehashing at the same size is enough to get rid of them.
+  // Otherwise the table is really full and needs to be enlarged. The threshold leaves enough empty slots after an in-place rehash
+  // so that tables with many removals don't need to be rehashed too often.
+  if (m_uiCapacity > 0 && static_cast<ezUInt64>(m_uiCount) * 8 <= static_cast<ezUInt64>(m_uiCapacity) * 5)
+  {
+    SetCapacity(m_uiCapacity);
+  }
+  else
+  {
+    EZ_ASSERT_DEV(m_uiCapacity < 0x80000000u, "ezFlatHashTable does not support more than 1.8 billion entries.");
+    SetCapacity(ezMath::Max<ezUInt32>(m_uiCapacity * 2, GROUP_SIZE));
+  }
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::FindEntry(const CompatibleKeyType& key) const
+{
+  return FindEntry(H::Hash(key), key);
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline ezUInt32 ezFlatHashTableBase<K, V, H>::FindEntry(ezUInt32 uiHash, const CompatibleKeyType& key) const
+{
+  if (m_uiCapacity > 0)
+  {
+    const ezUInt8 uiHashFragment = GetHashFragment(uiHash);
+    const ezUInt32 uiGroupMask = (m_uiCapacity / GROUP_SIZE) - 1;
+
+    ezUInt32 uiGroupIndex = GetFirstGroup(uiHash);
+    for (ezUInt32 uiProbe = 1; uiProbe <= uiGroupMask + 1; ++uiProbe)
+    {
+      const ezUInt32 uiFirstIndex = uiGroupIndex * GROUP_SIZE;
+      const ezInternal::FlatHashTableGroup group(m_pControlBytes + uiFirstIndex);
+
+      ezUInt32 uiMatches = group.Match(uiHashFragment);
+      while (uiMatches != 0)
+      {
+        const ezUInt32 uiIndex = uiFirstIndex + ezMath::FirstBitLow(uiMatches);
+        if (H::Equal(m_pEntries[uiIndex].key, key))
+          return uiIndex;
+
+        uiMatches &= uiMatches - 1;
+      }
+
+      // the key would have been inserted into this group if there was room
+      if (group.MatchEmpty() != 0)
+        break;
+
+      // triangular probing visits every group exactly once since the number of groups is a power of two
+      uiGroupIndex = (uiGroupIndex + uiProbe) & uiGroupMask;
+    }
+  }
+  // not found
+  return ezInvalidIndex;
+}
+
+template <typename K, typename V, typename H>
+ezUInt32 ezFlatHashTableBase<K, V, H>::FindFreeIndex(ezUInt32 uiHash) const
+{
+  const ezUInt32 uiGroupMask = (m_uiCapacity / GROUP_SIZE) - 1;
+
+  ezUInt32 uiGroupIndex = GetFirstGroup(uiHash);
+  for (ezUInt32 uiProbe = 1;; ++uiProbe)
+  {
+    const ezUInt32 uiFirstIndex = uiGroupIndex * GROUP_SIZE;
+    const ezUInt32 uiFree = ezInternal::FlatHashTableGroup(m_pControlBytes + uiFirstIndex).MatchEmptyOrDeleted();
+    if (uiFree != 0)
+      return uiFirstIndex + ezMath::FirstBitLow(uiFree);
+
+    EZ_ASSERT_DEBUG(uiProbe <= uiGroupMask, "Implementation error: the table has no free slot");
+    uiGroupIndex = (uiGroupIndex + uiProbe) & uiGroupMask;
+  }
+}
+
+template <typename K, typename V, typename H>
+ezUInt32 ezFlatHashTableBase<K, V, H>::AddEntry(ezUInt32 uiHash)
+{
+  if (m_uiGrowthLeft == 0)
+  {
+    Grow();
+  }
+
+  const ezUInt32 uiIndex = FindFreeIndex(uiHash);
+
+  // re-using a deleted slot doesn't reduce the number of empty slots
+  if (m_pControlBytes[uiIndex] == CONTROL_EMPTY)
+    --m_uiGrowthLeft;
+
+  m_pControlBytes[uiIndex] = GetHashFragment(uiHash);
+  ++m_uiCount;
+
+  return uiIndex;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::GetFirstGroup(ezUInt32 uiHash) const
+{
+  // Fibonacci hashing to spread weak hashes over all groups, the high bits of the product are mapped to the number of groups
+  const ezUInt64 uiMixedHash = static_cast<ezUInt32>(uiHash * 2654435769u);
+  return static_cast<ezUInt32>((uiMixedHash * (m_uiCapacity / GROUP_SIZE)) >> 32);
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezUInt8 ezFlatHashTableBase<K, V, H>::GetHashFragment(ezUInt32 uiHash)
+{
+  // the top 7 bits, the highest bit of the control byte marks empty and deleted slots
+  return static_cast<ezUInt8>(uiHash >> 25);
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::GetMaxLoad(ezUInt32 uiCapacity)
+{
+  return uiCapacity - uiCapacity / 8;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezFlatHashTableBase<K, V, H>::IsValidEntry(ezUInt32 uiEntryIndex) const
+{
+  return (m_pControlBytes[uiEntryIndex] & 0x80) == 0;
+}
+
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable()
+  : ezFlatHashTableBase<K, V, H>(A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(ezAllocatorBase* pAllocator)
+  : ezFlatHashTableBase<K, V, H>(pAllocator)
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(const ezFlatHashTable<K, V, H, A>& other)
+  : ezFlatHashTableBase<K, V, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(const ezFlatHashTableBase<K, V, H>& other)
+  : ezFlatHashTableBase<K, V, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(ezFlatHashTable<K, V, H, A>&& other)
+  : ezFlatHashTableBase<K, V, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(ezFlatHashTableBase<K, V, H>&& other)
+  : ezFlatHashTableBase<K, V, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezFlatHashTable<K, V, H, A>::operator=(const ezFlatHashTable<K, V, H, A>& rhs)
+{
+  ezFlatHashTableBase<K, V, H>::operator=(rhs);
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezFlatHashTable<K, V, H, A>::operator=(const ezFlatHashTableBase<K, V, H>& rhs)
+{
+  ezFlatHashTableBase<K, V, H>::operator=(rhs);
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezFlatHashTable<K, V, H, A>::operator=(ezFlatHashTable<K, V, H, A>&& rhs)
+{
+  ezFlatHashTableBase<K, V, H>::operator=(std::move(rhs));
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezFlatHashTable<K, V, H, A>::operator=(ezFlatHashTableBase<K, V, H>&& rhs)
+{
+  ezFlatHashTableBase<K, V, H>::operator=(std::move(rhs));
+}
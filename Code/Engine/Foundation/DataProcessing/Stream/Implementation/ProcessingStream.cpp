@@ -31,15 +31,18 @@ void ezProcessingStream::SetSize(ezUInt64 uiNumElements)
     return;
   }
 
+  // pad to full SIMD batches, so that kernels never need special handling for the last few elements
+  const ezUInt64 uiNumAllocatedElements = GetNumSimdBatches(uiNumElements) * SimdBatchSize;
+
   /// \todo Allow to reuse memory from a pool ?
   if (m_uiAlignment > 0)
   {
-    m_pData =
-      ezFoundation::GetAlignedAllocator()->Allocate(static_cast<size_t>(uiNumElements * GetDataTypeSize(m_Type)), static_cast<size_t>(m_uiAlignment));
+    m_pData = ezFoundation::GetAlignedAllocator()->Allocate(
+      static_cast<size_t>(uiNumAllocatedElements * GetDataTypeSize(m_Type)), static_cast<size_t>(m_uiAlignment));
   }
   else
   {
-    m_pData = ezFoundation::GetDefaultAllocator()->Allocate(static_cast<size_t>(uiNumElements * GetDataTypeSize(m_Type)), 0);
+    m_pData = ezFoundation::GetDefaultAllocator()->Allocate(static_cast<size_t>(uiNumAllocatedElements * GetDataTypeSize(m_Type)), 0);
   }
 
   EZ_ASSERT_DEV(m_pData != nullptr, "Allocating {0} elements of {1} bytes each, with {2} bytes alignment, failed", uiNumElements,
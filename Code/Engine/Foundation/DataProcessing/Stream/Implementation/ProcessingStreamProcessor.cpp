@@ -3,6 +3,7 @@
 #include <Foundation/Basics.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamGroup.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamProcessor.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
 
 // clang-format off
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezProcessingStreamProcessor, 1, ezRTTINoAllocator)
@@ -19,6 +20,15 @@ ezProcessingStreamProcessor::~ezProcessingStreamProcessor()
   m_pStreamGroup = nullptr;
 }
 
+ezSimdVec4f* ezProcessingStreamProcessor::GetSimdData(const ezProcessingStream* pStream)
+{
+  EZ_ASSERT_DEV(pStream != nullptr, "Stream pointer may not be null!");
+  EZ_ASSERT_DEV(pStream->GetElementStride() == sizeof(ezSimdVec4f), "Only Float4 and Int4 streams can be processed as SIMD data");
+  EZ_ASSERT_DEV(pStream->GetAlignment() >= EZ_ALIGNMENT_OF(ezSimdVec4f), "Stream '{0}' is not aligned for SIMD processing", pStream->GetName());
+
+  return pStream->GetWritableData<ezSimdVec4f>();
+}
+
 
 
 EZ_STATICLINK_FILE(Foundation, Foundation_DataProcessing_Stream_Implementation_ProcessingStreamProcessor);
@@ -81,6 +81,12 @@ public:
     return m_uiTypeSize;
   }
 
+  /// \brief The number of elements SIMD kernels process at once. The stream data is always allocated for a multiple of this many elements.
+  static constexpr ezUInt32 SimdBatchSize = 4;
+
+  /// \brief Returns how many SIMD batches are needed to cover the given number of elements.
+  static ezUInt64 GetNumSimdBatches(ezUInt64 uiNumElements) { return (uiNumElements + SimdBatchSize - 1) / SimdBatchSize; }
+
   static size_t GetDataTypeSize(DataType Type);
 
 protected:
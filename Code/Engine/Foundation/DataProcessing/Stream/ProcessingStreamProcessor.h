@@ -4,7 +4,9 @@
 #include <Foundation/Basics.h>
 #include <Foundation/Reflection/Reflection.h>
 
+class ezProcessingStream;
 class ezProcessingStreamGroup;
+class ezSimdVec4f;
 
 /// \brief Base class for all stream processor implementations.
 class EZ_FOUNDATION_DLL ezProcessingStreamProcessor : public ezReflectedClass
@@ -35,6 +37,12 @@ protected:
   /// \brief The actual method which processes the data, will be called with the number of elements to process.
   virtual void Process(ezUInt64 uiNumElements) = 0;
 
+  /// \brief Returns the data of a Float4 or Int4 stream for processing it with SIMD instructions.
+  ///
+  /// Stream data is padded to full batches of ezProcessingStream::SimdBatchSize elements, so SIMD kernels can always process
+  /// ezProcessingStream::GetNumSimdBatches(uiNumElements) complete batches. Elements in the padding have undefined values.
+  static ezSimdVec4f* GetSimdData(const ezProcessingStream* pStream);
+
   /// \brief Back pointer to the stream group - will be set to the owner stream group when adding the stream processor to the group.
   /// Can be used to get stream pointers in UpdateStreamBindings();
   ezProcessingStreamGroup* m_pStreamGroup;
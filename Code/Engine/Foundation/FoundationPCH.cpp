@@ -8,6 +8,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Algorithm_Implementation_HashHelperString);
   EZ_STATICLINK_REFERENCE(Foundation_Algorithm_Implementation_HashStream);
   EZ_STATICLINK_REFERENCE(Foundation_Algorithm_Implementation_HashingUtils);
+  EZ_STATICLINK_REFERENCE(Foundation_Algorithm_Implementation_Sorting);
   EZ_STATICLINK_REFERENCE(Foundation_Application_Config_Implementation_FileSystemConfig);
   EZ_STATICLINK_REFERENCE(Foundation_Application_Config_Implementation_PluginConfig);
   EZ_STATICLINK_REFERENCE(Foundation_Application_Implementation_Android_Application_android);
@@ -40,6 +41,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_IpcChannelEnet);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_Message);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_MessageLoop);
+  EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_MessageQueue);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_Mobile_MessageLoop_mobile);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_RemoteInterface);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_RemoteInterfaceEnet);
@@ -91,6 +93,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_StreamOperations);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_StreamOperationsOther);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_StringDeduplicationContext);
+  EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_AsyncWriter);
   EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_ConsoleWriter);
   EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_ETWWriter);
   EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_HTMLWriter);
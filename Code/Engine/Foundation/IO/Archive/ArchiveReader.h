@@ -33,6 +33,12 @@ public:
   /// \brief Creates a reader that will decompress the given file entry.
   ezUniquePtr<ezStreamReader> CreateEntryReader(ezUInt32 uiEntryIdx) const;
 
+  /// \brief Returns the data of an uncompressed entry directly from the memory mapped archive, without copying it.
+  ///
+  /// For compressed entries (and entries that are too large for an ezArrayPtr) an empty array is returned, use CreateEntryReader() for
+  /// those. The data stays valid as long as the archive is open.
+  ezArrayPtr<const ezUInt8> GetEntryMappedData(ezUInt32 uiEntryIdx) const; // [tested]
+
 protected:
   /// \brief Called by ExtractAllFiles() for progress reporting. Return false to abort.
   virtual bool ExtractNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, const char* szSourceFile) const;
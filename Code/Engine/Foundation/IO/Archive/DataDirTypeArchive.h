@@ -68,6 +68,7 @@ namespace ezDataDirectory
 
     virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
     virtual ezUInt64 GetFileSize() const override;
+    virtual ezArrayPtr<const ezUInt8> GetMappedData() const override;
 
   protected:
     virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
@@ -78,6 +79,9 @@ namespace ezDataDirectory
     ezUInt64 m_uiUncompressedSize = 0;
     ezUInt64 m_uiCompressedSize = 0;
     ezRawMemoryStreamReader m_MemStreamReader;
+
+    // only set for uncompressed entries
+    ezArrayPtr<const ezUInt8> m_MappedData;
   };
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
@@ -126,6 +126,17 @@ ezUniquePtr<ezStreamReader> ezArchiveReader::CreateEntryReader(ezUInt32 uiEntryI
   return ezArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart);
 }
 
+ezArrayPtr<const ezUInt8> ezArchiveReader::GetEntryMappedData(ezUInt32 uiEntryIdx) const
+{
+  const ezArchiveEntry& entry = m_ArchiveTOC.m_Entries[uiEntryIdx];
+
+  if (entry.m_CompressionMode != ezArchiveCompressionMode::Uncompressed || entry.m_uiStoredDataSize > ezMath::MaxValue<ezUInt32>())
+    return ezArrayPtr<const ezUInt8>();
+
+  const ezUInt8* pData = static_cast<const ezUInt8*>(ezMemoryUtils::AddByteOffset(m_pDataStart, static_cast<ptrdiff_t>(entry.m_uiDataStartOffset)));
+  return ezMakeArrayPtr(pData, static_cast<ezUInt32>(entry.m_uiStoredDataSize));
+}
+
 ezResult ezArchiveReader::ExtractFile(ezUInt32 uiEntryIdx, const char* szTargetFolder) const
 {
   const char* szFilePath = m_ArchiveTOC.GetEntryPathString(uiEntryIdx);
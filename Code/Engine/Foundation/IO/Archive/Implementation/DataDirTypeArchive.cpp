@@ -114,6 +114,7 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(const char*
   pReader->m_uiCompressedSize = pEntry->m_uiStoredDataSize;
 
   m_ArchiveReader.ConfigureRawMemoryStreamReader(uiEntryIndex, pReader->m_MemStreamReader);
+  pReader->m_MappedData = m_ArchiveReader.GetEntryMappedData(uiEntryIndex);
 
   if (pReader->Open(sArchivePath, this, FileShareMode).Failed())
   {
@@ -272,6 +273,11 @@ ezUInt64 ezDataDirectory::ArchiveReaderUncompressed::GetFileSize() const
   return m_uiUncompressedSize;
 }
 
+ezArrayPtr<const ezUInt8> ezDataDirectory::ArchiveReaderUncompressed::GetMappedData() const
+{
+  return m_MappedData;
+}
+
 ezResult ezDataDirectory::ArchiveReaderUncompressed::InternalOpen(ezFileShareMode::Enum FileShareMode)
 {
   EZ_ASSERT_DEBUG(FileShareMode != ezFileShareMode::Exclusive, "Archives only support shared reading of files. Exclusive access cannot be guaranteed.");
@@ -26,6 +26,9 @@ public:
 
   /// \brief Opens the given file for reading. Returns EZ_SUCCESS if the file could be opened. A cache is created to speed up small reads.
   ///
+  /// If the data directory provides the file content directly in memory (see GetMappedData()), no cache is created and all reads copy
+  /// straight from that memory.
+  ///
   /// You should typically not disable bAllowFileEvents, unless you need to prevent recursive file events,
   /// which is only the case, if you are doing file accesses from within a File Event Handler.
   ezResult Open(const char* szFile, ezUInt32 uiCacheSize = 1024 * 64, ezFileShareMode::Enum FileShareMode = ezFileShareMode::Default,
@@ -41,5 +44,6 @@ private:
   ezUInt64 m_uiBytesCached;
   ezUInt64 m_uiCacheReadPosition;
   ezDynamicArray<ezUInt8> m_Cache;
+  ezArrayPtr<const ezUInt8> m_MappedData;
   bool m_bEOF;
 };
@@ -1,11 +1,15 @@
 #pragma once
 
 #include <Foundation/Communication/Event.h>
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Containers/Map.h>
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
+#include <Foundation/Threading/AtomicInteger.h>
 #include <Foundation/Threading/Mutex.h>
 
+class ezDirectoryWatcher;
+
 /// \brief The ezFileSystem provides high-level functionality to manage files in a virtual file system.
 ///
 /// There are two sides at which the file system can be extended:
@@ -189,8 +193,25 @@ public:
 
   /// \brief Returns the (recursive) mutex that is used internally by the file system which can be used to guard bundled operations on the file
   /// system.
+  ///
+  /// The mutex is held while data directories are added or removed. Reading files, checking for their existence and resolving paths does
+  /// not lock it, these operations work on a snapshot of the data directories and never block each other.
   static ezMutex& GetMutex();
 
+  /// \brief Enables caching the results of ExistsFile() and of ResolvePath() for paths that are relative to the data directories.
+  ///
+  /// The cache is discarded whenever data directories are added or removed, and when files are created or deleted through the file system.
+  /// Changes that are made by other means (e.g. by other processes) are detected through ezDirectoryWatcher on platforms that support it
+  /// (EZ_SUPPORTS_DIRECTORY_WATCHER). On all other platforms ClearResolveCache() has to be called when files might have changed.
+  /// Disabled by default.
+  static void SetResolveCacheEnabled(bool bEnable);
+
+  /// \brief Returns whether the results of ExistsFile() and ResolvePath() are cached. See SetResolveCacheEnabled().
+  static bool IsResolveCacheEnabled();
+
+  /// \brief Discards all cached results of ExistsFile() and ResolvePath().
+  static void ClearResolveCache();
+
   ///@}
 
   static ezResult CreateDirectoryStructure(const char* szPath);
@@ -295,22 +316,98 @@ private:
     ezDataDirFactory m_Factory;
   };
 
+  /// \brief An immutable copy of the data directory list, which is replaced as a whole whenever data directories are added or removed.
+  struct DataDirSnapshot
+  {
+    ezHybridArray<DataDirectory, 16> m_DataDirectories;
+  };
+
+  /// \brief Gives access to the current DataDirSnapshot. The snapshot and its data directories are not destroyed while the scope exists.
+  class SnapshotScope;
+
+  struct ResolveCacheEntry
+  {
+    enum Flags
+    {
+      ExistsKnown = EZ_BIT(0),
+      Exists = EZ_BIT(1),
+      ResolveKnown = EZ_BIT(2),
+      Resolved = EZ_BIT(3),
+    };
+
+    ezUInt8 m_uiFlags = 0;
+    ezString m_sPath; ///< The entries are stored by the hash of the path, this tells apart paths with equal hashes.
+    ezString m_sAbsolutePath;
+    ezString m_sDataDirRelativePath;
+    ezDataDirectoryType* m_pDataDir = nullptr;
+  };
+
+  /// \brief The resolve cache is split into several independently locked parts, so that threads rarely wait for each other.
+  struct ResolveCacheShard
+  {
+    ezMutex m_Mutex;
+    ezHashTable<ezUInt64, ResolveCacheEntry> m_Entries;
+  };
+
   struct FileSystemData
   {
     ezHybridArray<Factory, 4> m_DataDirFactories;
-    ezHybridArray<DataDirectory, 16> m_DataDirectories;
+    ezHybridArray<DataDirectory, 16> m_DataDirectories; ///< Only accessed under m_FsMutex, all reads go through m_pSnapshot.
 
     ezEvent<const FileEvent&, ezMutex> m_Event;
     ezMutex m_FsMutex;
+
+    DataDirSnapshot* volatile m_pSnapshot = nullptr; ///< Only replaced under m_FsMutex, see PublishDataDirectories().
+    ezAtomicInteger32 m_iReaderPhase;
+    ezAtomicInteger32 m_iActiveReaders[2]; ///< Number of SnapshotScope's that were entered in each phase.
+
+    /// Snapshots and data directories that SnapshotScope's might still be using. Only accessed under m_FsMutex.
+    ezDynamicArray<DataDirSnapshot*> m_RetiredSnapshots;
+    ezDynamicArray<ezDataDirectoryType*> m_RemovedDataDirectories;
+
+    static constexpr ezUInt32 NumResolveCacheShards = 16;
+    ezAtomicBool m_bResolveCacheEnabled;
+    ezAtomicInteger32 m_iResolveCacheGeneration; ///< Incremented whenever the cache is cleared.
+    ResolveCacheShard m_ResolveCache[NumResolveCacheShards];
+
+    ezMutex m_WatcherMutex;
+    ezDynamicArray<ezDirectoryWatcher*> m_Watchers;
+    ezAtomicInteger64 m_iNextWatcherUpdate; ///< In microseconds.
   };
 
+  /// \brief Replaces the current DataDirSnapshot with a copy of m_DataDirectories. Must be called under m_FsMutex.
+  static void PublishDataDirectories();
+
+  /// \brief Waits until no SnapshotScope uses retired snapshots anymore and destroys them, together with the removed data directories.
+  ///
+  /// Must not be called under m_FsMutex, as threads inside a SnapshotScope might wait for it (e.g. to add a data directory in a file event
+  /// handler). If the calling thread is inside a SnapshotScope itself, it can't wait for that and the retired data is destroyed next time.
+  static void DestroyRetiredData();
+
+  /// \brief Returns whether the resolve cache is enabled. If so, out_iGeneration has to be passed to StoreResolveCacheEntry() and
+  /// out_uiFlags is set to the ResolveCacheEntry::Flags of the given path. The other outputs are filled out if the path was resolved.
+  static bool LookUpResolveCache(const char* szPath, ezInt32& out_iGeneration, ezUInt8& out_uiFlags, ezStringBuilder* out_sAbsolutePath = nullptr,
+    ezStringBuilder* out_sDataDirRelativePath = nullptr, ezDataDirectoryType** out_ppDataDir = nullptr);
+
+  /// \brief Merges the given entry into the cache, unless the cache was cleared since LookUpResolveCache() returned iGeneration.
+  static void StoreResolveCacheEntry(const char* szPath, ezInt32 iGeneration, ResolveCacheEntry&& entry);
+
+  /// \brief Discards all cached results, also when the cache is disabled. ClearResolveCache() skips that.
+  static void ClearResolveCacheShards();
+
+  /// \brief Watches all folder data directories for changes, if the resolve cache is enabled. Must be called under m_FsMutex.
+  static void UpdateDirectoryWatchers();
+
+  /// \brief Clears the resolve cache when a directory watcher reports any changes. Checks at most every few milliseconds.
+  static void PollDirectoryWatchers();
+
   /// \brief Returns a list of data directory categories that were embedded in the path.
   static const char* ExtractRootName(const char* szPath, ezString& rootName);
 
   /// \brief Returns the given path relative to its data directory. The path must be inside the given data directory.
-  static const char* GetDataDirRelativePath(const char* szPath, ezUInt32 uiDataDir);
+  static const char* GetDataDirRelativePath(const char* szPath, const ezDataDirectoryType* pDataDir);
 
-  static DataDirectory* GetDataDirForRoot(const ezString& sRoot);
+  static const DataDirectory* GetDataDirForRoot(const DataDirSnapshot& snapshot, const ezString& sRoot);
 
   static void CleanUpRootName(ezStringBuilder& sRoot);
 
@@ -3,6 +3,7 @@
 #include <Foundation/Basics.h>
 #include <Foundation/IO/FileEnums.h>
 #include <Foundation/Strings/String.h>
+#include <Foundation/Types/ArrayPtr.h>
 
 class ezDataDirectoryReaderWriterBase;
 class ezDataDirectoryReader;
@@ -163,6 +164,12 @@ public:
   }
 
   virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) = 0;
+
+  /// \brief If the entire file content is available in memory (e.g. uncompressed files in a memory mapped archive), this returns a view
+  /// to it, which allows to consume the data without copying it. Otherwise an empty array is returned.
+  ///
+  /// The view is independent of the read position and stays valid until the reader is closed.
+  virtual ezArrayPtr<const ezUInt8> GetMappedData() const { return ezArrayPtr<const ezUInt8>(); }
 };
 
 /// \brief A base class for writers that handle writing to a (virtual) file inside a data directory.
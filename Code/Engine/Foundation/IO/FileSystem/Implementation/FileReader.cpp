@@ -14,6 +14,17 @@ ezResult ezFileReader::Open(const char* szFile, ezUInt32 uiCacheSize /*= 1024 *
   if (!m_pDataDirReader)
     return EZ_FAILURE;
 
+  m_MappedData = m_pDataDirReader->GetMappedData();
+  if (!m_MappedData.IsEmpty())
+  {
+    // the whole file is already in memory, use it as the cache
+    m_uiCacheReadPosition = 0;
+    m_uiBytesCached = m_MappedData.GetCount();
+    m_bEOF = false;
+
+    return EZ_SUCCESS;
+  }
+
   m_Cache.SetCountUninitialized(uiCacheSize);
 
   m_uiCacheReadPosition = 0;
@@ -29,6 +40,7 @@ void ezFileReader::Close()
     m_pDataDirReader->Close();
 
   m_pDataDirReader = nullptr;
+  m_MappedData = ezArrayPtr<const ezUInt8>();
   m_bEOF = true;
 }
 
@@ -40,6 +52,7 @@ ezUInt64 ezFileReader::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
 
   ezUInt64 uiBufferPosition = 0; // how much was read, yet
   ezUInt8* pBuffer = (ezUInt8*)pReadBuffer;
+  const ezUInt8* pCache = m_MappedData.IsEmpty() ? m_Cache.GetData() : m_MappedData.GetPtr();
 
   while (uiBytesToRead > 0)
   {
@@ -52,7 +65,7 @@ ezUInt64 ezFileReader::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
 
     // copy data into the buffer
     // uiChunkSize can never be larger than the cache size, which is limited to 32 Bit
-    ezMemoryUtils::Copy(&pBuffer[uiBufferPosition], &m_Cache[(ezUInt32)m_uiCacheReadPosition], (ezUInt32)uiChunkSize);
+    ezMemoryUtils::Copy(&pBuffer[uiBufferPosition], &pCache[m_uiCacheReadPosition], (ezUInt32)uiChunkSize);
 
     // store how much was read and how much is still left to read
     uiBufferPosition += uiChunkSize;
@@ -65,7 +78,8 @@ ezUInt64 ezFileReader::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
     // this will even be triggered if EXACTLY the amount of available bytes was read
     if (m_uiCacheReadPosition >= m_uiBytesCached)
     {
-      m_uiBytesCached = m_pDataDirReader->Read(&m_Cache[0], m_Cache.GetCount());
+      // mapped data is the whole file, there is nothing left to read
+      m_uiBytesCached = m_MappedData.IsEmpty() ? m_pDataDirReader->Read(&m_Cache[0], m_Cache.GetCount()) : 0;
       m_uiCacheReadPosition = 0;
 
       // if nothing else could be read from the file, return the number of bytes that have been read
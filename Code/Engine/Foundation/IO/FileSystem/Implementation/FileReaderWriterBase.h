@@ -36,6 +36,12 @@ public:
   /// \brief Returns the current total size of the file.
   ezUInt64 GetFileSize() const { return m_pDataDirReader->GetFileSize(); }
 
+  /// \brief Returns a view to the entire file content, if the data directory keeps it in memory (e.g. uncompressed files in archives).
+  ///
+  /// Returns an empty array otherwise. The view is independent of the read position and stays valid until the file is closed.
+  /// \see ezDataDirectoryReader::GetMappedData()
+  ezArrayPtr<const ezUInt8> GetMappedData() const { return m_pDataDirReader->GetMappedData(); }
+
 protected:
   ezDataDirectoryReader* GetFileReader(const char* szFile, ezFileShareMode::Enum FileShareMode, bool bAllowFileEvents)
   {
@@ -1,9 +1,12 @@
 #include <FoundationPCH.h>
 
 #include <Foundation/Configuration/Startup.h>
+#include <Foundation/IO/DirectoryWatcher.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Time/Time.h>
 
 // clang-format off
 EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, FileSystem)
@@ -25,6 +28,43 @@ ezFileSystem::FileSystemData* ezFileSystem::s_Data = nullptr;
 ezString ezFileSystem::s_sSdkRootDir;
 ezMap<ezString, ezString> ezFileSystem::s_SpecialDirectories;
 
+/// \brief Number of ezFileSystem::SnapshotScope's that the current thread is inside of.
+static thread_local ezUInt32 s_uiSnapshotScopeDepth = 0;
+
+// Readers announce themselves in one of two counters, selected by the current phase. To make sure that no reader uses a retired snapshot
+// anymore, a writer switches the phase and waits until the counter of the old phase drops to zero, twice, because a reader may have read
+// the old phase value before the first switch but only incremented the counter afterwards.
+class ezFileSystem::SnapshotScope
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(SnapshotScope);
+
+public:
+  SnapshotScope()
+  {
+    ++s_uiSnapshotScopeDepth;
+
+    m_uiPhase = static_cast<ezUInt32>(s_Data->m_iReaderPhase) & 1;
+    s_Data->m_iActiveReaders[m_uiPhase].Increment();
+
+    // the increment is a full barrier, so a writer that retires this snapshot afterwards waits for this scope
+    m_pSnapshot = s_Data->m_pSnapshot;
+  }
+
+  ~SnapshotScope()
+  {
+    s_Data->m_iActiveReaders[m_uiPhase].Decrement();
+
+    --s_uiSnapshotScopeDepth;
+  }
+
+  const ezHybridArray<DataDirectory, 16>& GetDataDirectories() const { return m_pSnapshot->m_DataDirectories; }
+
+  const DataDirSnapshot& GetSnapshot() const { return *m_pSnapshot; }
+
+private:
+  ezUInt32 m_uiPhase;
+  const DataDirSnapshot* m_pSnapshot;
+};
 
 void ezFileSystem::RegisterDataDirectoryFactory(ezDataDirFactory Factory, float fPriority /*= 0*/)
 {
@@ -86,49 +126,61 @@ ezResult ezFileSystem::AddDataDirectory(const char* szDataDirectory, const char*
   ezStringBuilder sCleanRootName = szRootName;
   CleanUpRootName(sCleanRootName);
 
-  EZ_LOCK(s_Data->m_FsMutex);
+  ezResult result = EZ_FAILURE;
 
-  bool failed = false;
-  if (FindDataDirectoryWithRoot(sCleanRootName) != nullptr)
   {
-    ezLog::Error("A data directory with root name '{0}' already exists.", sCleanRootName);
-    failed = true;
-  }
+    EZ_LOCK(s_Data->m_FsMutex);
 
-  if (!failed)
-  {
-    s_Data->m_DataDirFactories.Sort([](const auto& a, const auto& b) { return a.m_fPriority < b.m_fPriority; });
+    bool failed = false;
+    if (FindDataDirectoryWithRoot(sCleanRootName) != nullptr)
+    {
+      ezLog::Error("A data directory with root name '{0}' already exists.", sCleanRootName);
+      failed = true;
+    }
 
-    // use the factory that was added last as the one with the highest priority -> allows to override already added factories
-    for (ezInt32 i = s_Data->m_DataDirFactories.GetCount() - 1; i >= 0; --i)
+    if (!failed)
     {
-      ezDataDirectoryType* pDataDir = s_Data->m_DataDirFactories[i].m_Factory(sPath, szGroup, szRootName, Usage);
+      s_Data->m_DataDirFactories.Sort([](const auto& a, const auto& b) { return a.m_fPriority < b.m_fPriority; });
 
-      if (pDataDir != nullptr)
+      // use the factory that was added last as the one with the highest priority -> allows to override already added factories
+      for (ezInt32 i = s_Data->m_DataDirFactories.GetCount() - 1; i >= 0; --i)
       {
-        DataDirectory dd;
-        dd.m_Usage = Usage;
-        dd.m_pDataDirectory = pDataDir;
-        dd.m_sRootName = sCleanRootName;
-        dd.m_sGroup = szGroup;
-
-        s_Data->m_DataDirectories.PushBack(dd);
+        ezDataDirectoryType* pDataDir = s_Data->m_DataDirFactories[i].m_Factory(sPath, szGroup, szRootName, Usage);
 
+        if (pDataDir != nullptr)
         {
-          // Broadcast that a data directory was added
-          FileEvent fe;
-          fe.m_EventType = FileEventType::AddDataDirectorySucceeded;
-          fe.m_szFileOrDirectory = sPath;
-          fe.m_szOther = sCleanRootName;
-          fe.m_pDataDir = pDataDir;
-          s_Data->m_Event.Broadcast(fe);
+          DataDirectory dd;
+          dd.m_Usage = Usage;
+          dd.m_pDataDirectory = pDataDir;
+          dd.m_sRootName = sCleanRootName;
+          dd.m_sGroup = szGroup;
+
+          s_Data->m_DataDirectories.PushBack(dd);
+          PublishDataDirectories();
+
+          {
+            // Broadcast that a data directory was added
+            FileEvent fe;
+            fe.m_EventType = FileEventType::AddDataDirectorySucceeded;
+            fe.m_szFileOrDirectory = sPath;
+            fe.m_szOther = sCleanRootName;
+            fe.m_pDataDir = pDataDir;
+            s_Data->m_Event.Broadcast(fe);
+          }
+
+          result = EZ_SUCCESS;
+          break;
         }
-
-        return EZ_SUCCESS;
       }
     }
   }
 
+  if (result.Succeeded())
+  {
+    DestroyRetiredData();
+    return EZ_SUCCESS;
+  }
+
   {
     // Broadcast that adding a data directory failed
     FileEvent fe;
@@ -148,32 +200,38 @@ bool ezFileSystem::RemoveDataDirectory(const char* szRootName)
   ezStringBuilder sCleanRootName = szRootName;
   CleanUpRootName(sCleanRootName);
 
-  EZ_LOCK(s_Data->m_FsMutex);
+  bool bRemoved = false;
 
-  for (ezUInt32 i = 0; i < s_Data->m_DataDirectories.GetCount();)
   {
-    if (s_Data->m_DataDirectories[i].m_sRootName == sCleanRootName)
+    EZ_LOCK(s_Data->m_FsMutex);
+
+    for (ezUInt32 i = 0; i < s_Data->m_DataDirectories.GetCount(); ++i)
     {
+      if (s_Data->m_DataDirectories[i].m_sRootName == sCleanRootName)
       {
-        // Broadcast that a data directory is about to be removed
-        FileEvent fe;
-        fe.m_EventType = FileEventType::RemoveDataDirectory;
-        fe.m_szFileOrDirectory = s_Data->m_DataDirectories[i].m_pDataDirectory->GetDataDirectoryPath();
-        fe.m_szOther = s_Data->m_DataDirectories[i].m_sRootName;
-        fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
-        s_Data->m_Event.Broadcast(fe);
-      }
+        {
+          // Broadcast that a data directory is about to be removed
+          FileEvent fe;
+          fe.m_EventType = FileEventType::RemoveDataDirectory;
+          fe.m_szFileOrDirectory = s_Data->m_DataDirectories[i].m_pDataDirectory->GetDataDirectoryPath();
+          fe.m_szOther = s_Data->m_DataDirectories[i].m_sRootName;
+          fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
+          s_Data->m_Event.Broadcast(fe);
+        }
 
-      s_Data->m_DataDirectories[i].m_pDataDirectory->RemoveDataDirectory();
-      s_Data->m_DataDirectories.RemoveAtAndCopy(i);
+        // other threads might still be reading from it, it is destroyed once they are done
+        s_Data->m_RemovedDataDirectories.PushBack(s_Data->m_DataDirectories[i].m_pDataDirectory);
+        s_Data->m_DataDirectories.RemoveAtAndCopy(i);
+        PublishDataDirectories();
 
-      return true;
+        bRemoved = true;
+        break;
+      }
     }
-    else
-      ++i;
   }
 
-  return false;
+  DestroyRetiredData();
+  return bRemoved;
 }
 
 ezUInt32 ezFileSystem::RemoveDataDirectoryGroup(const char* szGroup)
@@ -181,33 +239,41 @@ ezUInt32 ezFileSystem::RemoveDataDirectoryGroup(const char* szGroup)
   if (s_Data == nullptr)
     return 0;
 
-  EZ_LOCK(s_Data->m_FsMutex);
-
   ezUInt32 uiRemoved = 0;
 
-  for (ezUInt32 i = 0; i < s_Data->m_DataDirectories.GetCount();)
   {
-    if (s_Data->m_DataDirectories[i].m_sGroup == szGroup)
+    EZ_LOCK(s_Data->m_FsMutex);
+
+    for (ezUInt32 i = 0; i < s_Data->m_DataDirectories.GetCount();)
     {
+      if (s_Data->m_DataDirectories[i].m_sGroup == szGroup)
       {
-        // Broadcast that a data directory is about to be removed
-        FileEvent fe;
-        fe.m_EventType = FileEventType::RemoveDataDirectory;
-        fe.m_szFileOrDirectory = s_Data->m_DataDirectories[i].m_pDataDirectory->GetDataDirectoryPath();
-        fe.m_szOther = s_Data->m_DataDirectories[i].m_sRootName;
-        fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
-        s_Data->m_Event.Broadcast(fe);
-      }
+        {
+          // Broadcast that a data directory is about to be removed
+          FileEvent fe;
+          fe.m_EventType = FileEventType::RemoveDataDirectory;
+          fe.m_szFileOrDirectory = s_Data->m_DataDirectories[i].m_pDataDirectory->GetDataDirectoryPath();
+          fe.m_szOther = s_Data->m_DataDirectories[i].m_sRootName;
+          fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
+          s_Data->m_Event.Broadcast(fe);
+        }
 
-      ++uiRemoved;
+        ++uiRemoved;
 
-      s_Data->m_DataDirectories[i].m_pDataDirectory->RemoveDataDirectory();
-      s_Data->m_DataDirectories.RemoveAtAndCopy(i);
+        s_Data->m_RemovedDataDirectories.PushBack(s_Data->m_DataDirectories[i].m_pDataDirectory);
+        s_Data->m_DataDirectories.RemoveAtAndCopy(i);
+      }
+      else
+        ++i;
+    }
+
+    if (uiRemoved > 0)
+    {
+      PublishDataDirectories();
     }
-    else
-      ++i;
   }
 
+  DestroyRetiredData();
   return uiRemoved;
 }
 
@@ -215,24 +281,29 @@ void ezFileSystem::ClearAllDataDirectories()
 {
   EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
 
-  EZ_LOCK(s_Data->m_FsMutex);
-
-  for (ezInt32 i = s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
+    EZ_LOCK(s_Data->m_FsMutex);
+
+    for (ezInt32 i = s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
     {
-      // Broadcast that a data directory is about to be removed
-      FileEvent fe;
-      fe.m_EventType = FileEventType::RemoveDataDirectory;
-      fe.m_szFileOrDirectory = s_Data->m_DataDirectories[i].m_pDataDirectory->GetDataDirectoryPath();
-      fe.m_szOther = s_Data->m_DataDirectories[i].m_sRootName;
-      fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
-      s_Data->m_Event.Broadcast(fe);
+      {
+        // Broadcast that a data directory is about to be removed
+        FileEvent fe;
+        fe.m_EventType = FileEventType::RemoveDataDirectory;
+        fe.m_szFileOrDirectory = s_Data->m_DataDirectories[i].m_pDataDirectory->GetDataDirectoryPath();
+        fe.m_szOther = s_Data->m_DataDirectories[i].m_sRootName;
+        fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
+        s_Data->m_Event.Broadcast(fe);
+      }
+
+      s_Data->m_RemovedDataDirectories.PushBack(s_Data->m_DataDirectories[i].m_pDataDirectory);
     }
 
-    s_Data->m_DataDirectories[i].m_pDataDirectory->RemoveDataDirectory();
+    s_Data->m_DataDirectories.Clear();
+    PublishDataDirectories();
   }
 
-  s_Data->m_DataDirectories.Clear();
+  DestroyRetiredData();
 }
 
 ezDataDirectoryType* ezFileSystem::FindDataDirectoryWithRoot(const char* szRootName)
@@ -240,9 +311,9 @@ ezDataDirectoryType* ezFileSystem::FindDataDirectoryWithRoot(const char* szRootN
   if (ezStringUtils::IsNullOrEmpty(szRootName))
     return nullptr;
 
-  EZ_LOCK(s_Data->m_FsMutex);
+  SnapshotScope snapshot;
 
-  for (const auto& dd : s_Data->m_DataDirectories)
+  for (const auto& dd : snapshot.GetDataDirectories())
   {
     if (dd.m_sRootName.IsEqual_NoCase(szRootName))
     {
@@ -267,16 +338,75 @@ ezDataDirectoryType* ezFileSystem::GetDataDirectory(ezUInt32 uiDataDirIndex)
   return s_Data->m_DataDirectories[uiDataDirIndex].m_pDataDirectory;
 }
 
-const char* ezFileSystem::GetDataDirRelativePath(const char* szPath, ezUInt32 uiDataDir)
+void ezFileSystem::PublishDataDirectories()
 {
-  EZ_LOCK(s_Data->m_FsMutex);
+  DataDirSnapshot* pSnapshot = EZ_DEFAULT_NEW(DataDirSnapshot);
+  pSnapshot->m_DataDirectories = s_Data->m_DataDirectories;
+
+  DataDirSnapshot* pPrevSnapshot = s_Data->m_pSnapshot;
+
+  // full barrier, readers that see the new pointer also see the copied data directories
+  ezAtomicUtils::TestAndSet((void**)&s_Data->m_pSnapshot, pPrevSnapshot, pSnapshot);
+
+  if (pPrevSnapshot != nullptr)
+  {
+    s_Data->m_RetiredSnapshots.PushBack(pPrevSnapshot);
+  }
+
+  UpdateDirectoryWatchers();
+
+  // cached results may refer to data directories that are gone now, or miss files in new ones
+  ClearResolveCache();
+}
+
+void ezFileSystem::DestroyRetiredData()
+{
+  ezDynamicArray<DataDirSnapshot*> retiredSnapshots;
+  ezDynamicArray<ezDataDirectoryType*> removedDataDirectories;
+
+  {
+    EZ_LOCK(s_Data->m_FsMutex);
+
+    // this thread would wait for itself
+    if (s_uiSnapshotScopeDepth > 0)
+      return;
+
+    retiredSnapshots.Swap(s_Data->m_RetiredSnapshots);
+    removedDataDirectories.Swap(s_Data->m_RemovedDataDirectories);
+  }
+
+  if (retiredSnapshots.IsEmpty() && removedDataDirectories.IsEmpty())
+    return;
+
+  for (ezUInt32 i = 0; i < 2; ++i)
+  {
+    const ezUInt32 uiOldPhase = static_cast<ezUInt32>(s_Data->m_iReaderPhase.PostIncrement()) & 1;
+
+    while (s_Data->m_iActiveReaders[uiOldPhase] != 0)
+    {
+      ezThreadUtils::YieldTimeSlice();
+    }
+  }
 
+  for (DataDirSnapshot* pSnapshot : retiredSnapshots)
+  {
+    EZ_DEFAULT_DELETE(pSnapshot);
+  }
+
+  for (ezDataDirectoryType* pDataDir : removedDataDirectories)
+  {
+    pDataDir->RemoveDataDirectory();
+  }
+}
+
+const char* ezFileSystem::GetDataDirRelativePath(const char* szPath, const ezDataDirectoryType* pDataDir)
+{
   // if an absolute path is given, this will check whether the absolute path would fall into this data directory
   // if yes, the prefix path is removed and then only the relative path is given to the data directory type
   // otherwise the data directory would prepend its own path and thus create an invalid path to work with
 
   // first check the redirected directory
-  const ezString128& sRedDirPath = s_Data->m_DataDirectories[uiDataDir].m_pDataDirectory->GetRedirectedDataDirectoryPath();
+  const ezString128& sRedDirPath = pDataDir->GetRedirectedDataDirectoryPath();
 
   if (!sRedDirPath.IsEmpty() && ezStringUtils::StartsWith_NoCase(szPath, sRedDirPath))
   {
@@ -290,7 +420,7 @@ const char* ezFileSystem::GetDataDirRelativePath(const char* szPath, ezUInt32 ui
   }
 
   // then check the original mount path
-  const ezString128& sDirPath = s_Data->m_DataDirectories[uiDataDir].m_pDataDirectory->GetDataDirectoryPath();
+  const ezString128& sDirPath = pDataDir->GetDataDirectoryPath();
 
   // If the data dir is empty we return the paths as is or the code below would remove the '/' in front of an
   // absolute path.
@@ -309,14 +439,12 @@ const char* ezFileSystem::GetDataDirRelativePath(const char* szPath, ezUInt32 ui
 }
 
 
-ezFileSystem::DataDirectory* ezFileSystem::GetDataDirForRoot(const ezString& sRoot)
+const ezFileSystem::DataDirectory* ezFileSystem::GetDataDirForRoot(const DataDirSnapshot& snapshot, const ezString& sRoot)
 {
-  EZ_LOCK(s_Data->m_FsMutex);
-
-  for (ezInt32 i = (ezInt32)s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+  for (ezInt32 i = (ezInt32)snapshot.m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
-    if (s_Data->m_DataDirectories[i].m_sRootName == sRoot)
-      return &s_Data->m_DataDirectories[i];
+    if (snapshot.m_DataDirectories[i].m_sRootName == sRoot)
+      return &snapshot.m_DataDirectories[i];
   }
 
   return nullptr;
@@ -330,6 +458,7 @@ void ezFileSystem::DeleteFile(const char* szFile)
   if (ezPathUtils::IsAbsolutePath(szFile))
   {
     ezOSFile::DeleteFile(szFile).IgnoreResult();
+    ClearResolveCache();
     return;
   }
 
@@ -341,18 +470,19 @@ void ezFileSystem::DeleteFile(const char* szFile)
   if (sRootName.IsEmpty())
     return;
 
-  EZ_LOCK(s_Data->m_FsMutex);
+  SnapshotScope snapshot;
+  const auto& dataDirectories = snapshot.GetDataDirectories();
 
-  for (ezInt32 i = (ezInt32)s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+  for (ezInt32 i = (ezInt32)dataDirectories.GetCount() - 1; i >= 0; --i)
   {
     // do not delete data from directories that are mounted as read only
-    if (s_Data->m_DataDirectories[i].m_Usage != AllowWrites)
+    if (dataDirectories[i].m_Usage != AllowWrites)
       continue;
 
-    if (s_Data->m_DataDirectories[i].m_sRootName != sRootName)
+    if (dataDirectories[i].m_sRootName != sRootName)
       continue;
 
-    const char* szRelPath = GetDataDirRelativePath(szFile, i);
+    const char* szRelPath = GetDataDirRelativePath(szFile, dataDirectories[i].m_pDataDirectory);
 
     {
       // Broadcast that a file is about to be deleted
@@ -360,38 +490,64 @@ void ezFileSystem::DeleteFile(const char* szFile)
       FileEvent fe;
       fe.m_EventType = FileEventType::DeleteFile;
       fe.m_szFileOrDirectory = szRelPath;
-      fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
+      fe.m_pDataDir = dataDirectories[i].m_pDataDirectory;
       fe.m_szOther = sRootName;
       s_Data->m_Event.Broadcast(fe);
     }
 
-    s_Data->m_DataDirectories[i].m_pDataDirectory->DeleteFile(szRelPath);
+    dataDirectories[i].m_pDataDirectory->DeleteFile(szRelPath);
   }
+
+  ClearResolveCache();
 }
 
 bool ezFileSystem::ExistsFile(const char* szFile)
 {
   EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
 
+  ezInt32 iCacheGeneration = 0;
+  ezUInt8 uiCacheFlags = 0;
+  const bool bUseCache = LookUpResolveCache(szFile, iCacheGeneration, uiCacheFlags);
+
+  if (uiCacheFlags & ResolveCacheEntry::ExistsKnown)
+    return (uiCacheFlags & ResolveCacheEntry::Exists) != 0;
+
+  const char* szFullPath = szFile;
+
   ezString sRootName;
   szFile = ExtractRootName(szFile, sRootName);
 
   const bool bOneSpecificDataDir = !sRootName.IsEmpty();
 
-  EZ_LOCK(s_Data->m_FsMutex);
+  bool bExists = false;
 
-  for (ezInt32 i = (ezInt32)s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
-    if (!sRootName.IsEmpty() && s_Data->m_DataDirectories[i].m_sRootName != sRootName)
-      continue;
+    SnapshotScope snapshot;
+    const auto& dataDirectories = snapshot.GetDataDirectories();
+
+    for (ezInt32 i = (ezInt32)dataDirectories.GetCount() - 1; i >= 0; --i)
+    {
+      if (!sRootName.IsEmpty() && dataDirectories[i].m_sRootName != sRootName)
+        continue;
 
-    const char* szRelPath = GetDataDirRelativePath(szFile, i);
+      const char* szRelPath = GetDataDirRelativePath(szFile, dataDirectories[i].m_pDataDirectory);
 
-    if (s_Data->m_DataDirectories[i].m_pDataDirectory->ExistsFile(szRelPath, bOneSpecificDataDir))
-      return true;
+      if (dataDirectories[i].m_pDataDirectory->ExistsFile(szRelPath, bOneSpecificDataDir))
+      {
+        bExists = true;
+        break;
+      }
+    }
   }
 
-  return false;
+  if (bUseCache)
+  {
+    ResolveCacheEntry entry;
+    entry.m_uiFlags = ResolveCacheEntry::ExistsKnown | (bExists ? ResolveCacheEntry::Exists : 0);
+    StoreResolveCacheEntry(szFullPath, iCacheGeneration, std::move(entry));
+  }
+
+  return bExists;
 }
 
 
@@ -399,21 +555,22 @@ ezResult ezFileSystem::GetFileStats(const char* szFileOrFolder, ezFileStats& out
 {
   EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
 
-  EZ_LOCK(s_Data->m_FsMutex);
-
   ezString sRootName;
   szFileOrFolder = ExtractRootName(szFileOrFolder, sRootName);
 
   const bool bOneSpecificDataDir = !sRootName.IsEmpty();
 
-  for (ezInt32 i = (ezInt32)s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+  SnapshotScope snapshot;
+  const auto& dataDirectories = snapshot.GetDataDirectories();
+
+  for (ezInt32 i = (ezInt32)dataDirectories.GetCount() - 1; i >= 0; --i)
   {
-    if (!sRootName.IsEmpty() && s_Data->m_DataDirectories[i].m_sRootName != sRootName)
+    if (!sRootName.IsEmpty() && dataDirectories[i].m_sRootName != sRootName)
       continue;
 
-    const char* szRelPath = GetDataDirRelativePath(szFileOrFolder, i);
+    const char* szRelPath = GetDataDirRelativePath(szFileOrFolder, dataDirectories[i].m_pDataDirectory);
 
-    if (s_Data->m_DataDirectories[i].m_pDataDirectory->GetFileStats(szRelPath, bOneSpecificDataDir, out_Stats).Succeeded())
+    if (dataDirectories[i].m_pDataDirectory->GetFileStats(szRelPath, bOneSpecificDataDir, out_Stats).Succeeded())
       return EZ_SUCCESS;
   }
 
@@ -454,8 +611,6 @@ ezDataDirectoryReader* ezFileSystem::GetFileReader(const char* szFile, ezFileSha
   if (ezStringUtils::IsNullOrEmpty(szFile))
     return nullptr;
 
-  EZ_LOCK(s_Data->m_FsMutex);
-
   ezString sRootName;
   szFile = ExtractRootName(szFile, sRootName);
 
@@ -465,14 +620,17 @@ ezDataDirectoryReader* ezFileSystem::GetFileReader(const char* szFile, ezFileSha
 
   const bool bOneSpecificDataDir = !sRootName.IsEmpty();
 
+  SnapshotScope snapshot;
+  const auto& dataDirectories = snapshot.GetDataDirectories();
+
   // the last added data directory has the highest priority
-  for (ezInt32 i = (ezInt32)s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+  for (ezInt32 i = (ezInt32)dataDirectories.GetCount() - 1; i >= 0; --i)
   {
     // if a root is used, ignore all directories that do not have the same root name
-    if (bOneSpecificDataDir && s_Data->m_DataDirectories[i].m_sRootName != sRootName)
+    if (bOneSpecificDataDir && dataDirectories[i].m_sRootName != sRootName)
       continue;
 
-    const char* szRelPath = GetDataDirRelativePath(sPath, i);
+    const char* szRelPath = GetDataDirRelativePath(sPath, dataDirectories[i].m_pDataDirectory);
 
     if (bAllowFileEvents)
     {
@@ -482,12 +640,12 @@ ezDataDirectoryReader* ezFileSystem::GetFileReader(const char* szFile, ezFileSha
       fe.m_EventType = FileEventType::OpenFileAttempt;
       fe.m_szFileOrDirectory = szRelPath;
       fe.m_szOther = sRootName;
-      fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
+      fe.m_pDataDir = dataDirectories[i].m_pDataDirectory;
       s_Data->m_Event.Broadcast(fe);
     }
 
     // Let the data directory try to open the file.
-    ezDataDirectoryReader* pReader = s_Data->m_DataDirectories[i].m_pDataDirectory->OpenFileToRead(szRelPath, FileShareMode, bOneSpecificDataDir);
+    ezDataDirectoryReader* pReader = dataDirectories[i].m_pDataDirectory->OpenFileToRead(szRelPath, FileShareMode, bOneSpecificDataDir);
 
     if (bAllowFileEvents && pReader != nullptr)
     {
@@ -496,7 +654,7 @@ ezDataDirectoryReader* ezFileSystem::GetFileReader(const char* szFile, ezFileSha
       fe.m_EventType = FileEventType::OpenFileSucceeded;
       fe.m_szFileOrDirectory = szRelPath;
       fe.m_szOther = sRootName;
-      fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
+      fe.m_pDataDir = dataDirectories[i].m_pDataDirectory;
       s_Data->m_Event.Broadcast(fe);
 
       return pReader;
@@ -522,8 +680,6 @@ ezDataDirectoryWriter* ezFileSystem::GetFileWriter(const char* szFile, ezFileSha
   if (ezStringUtils::IsNullOrEmpty(szFile))
     return nullptr;
 
-  EZ_LOCK(s_Data->m_FsMutex);
-
   ezString sRootName;
 
   if (!ezPathUtils::IsAbsolutePath(szFile))
@@ -539,17 +695,20 @@ ezDataDirectoryWriter* ezFileSystem::GetFileWriter(const char* szFile, ezFileSha
   ezStringBuilder sPath = szFile;
   sPath.MakeCleanPath();
 
+  SnapshotScope snapshot;
+  const auto& dataDirectories = snapshot.GetDataDirectories();
+
   // the last added data directory has the highest priority
-  for (ezInt32 i = (ezInt32)s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
+  for (ezInt32 i = (ezInt32)dataDirectories.GetCount() - 1; i >= 0; --i)
   {
-    if (s_Data->m_DataDirectories[i].m_Usage != AllowWrites)
+    if (dataDirectories[i].m_Usage != AllowWrites)
       continue;
 
     // ignore all directories that have not the category that is currently requested
-    if (s_Data->m_DataDirectories[i].m_sRootName != sRootName)
+    if (dataDirectories[i].m_sRootName != sRootName)
       continue;
 
-    const char* szRelPath = GetDataDirRelativePath(sPath, i);
+    const char* szRelPath = GetDataDirRelativePath(sPath, dataDirectories[i].m_pDataDirectory);
 
     if (bAllowFileEvents)
     {
@@ -559,11 +718,26 @@ ezDataDirectoryWriter* ezFileSystem::GetFileWriter(const char* szFile, ezFileSha
       fe.m_EventType = FileEventType::CreateFileAttempt;
       fe.m_szFileOrDirectory = szRelPath;
       fe.m_szOther = sRootName;
-      fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
+      fe.m_pDataDir = dataDirectories[i].m_pDataDirectory;
       s_Data->m_Event.Broadcast(fe);
     }
 
-    ezDataDirectoryWriter* pWriter = s_Data->m_DataDirectories[i].m_pDataDirectory->OpenFileToWrite(szRelPath, FileShareMode);
+    // Overwriting a file doesn't change which files exist or where paths resolve to. A new file can change the results of any cached
+    // path though, e.g. through redirections or different spellings of the path, so then the whole cache is discarded.
+    bool bExistedBefore = false;
+    if (IsResolveCacheEnabled())
+    {
+      ezStringBuilder sAbsPath = dataDirectories[i].m_pDataDirectory->GetRedirectedDataDirectoryPath();
+      sAbsPath.AppendPath(szRelPath);
+      bExistedBefore = ezOSFile::ExistsFile(sAbsPath);
+    }
+
+    ezDataDirectoryWriter* pWriter = dataDirectories[i].m_pDataDirectory->OpenFileToWrite(szRelPath, FileShareMode);
+
+    if (pWriter != nullptr && !bExistedBefore)
+    {
+      ClearResolveCache();
+    }
 
     if (bAllowFileEvents && pWriter != nullptr)
     {
@@ -572,7 +746,7 @@ ezDataDirectoryWriter* ezFileSystem::GetFileWriter(const char* szFile, ezFileSha
       fe.m_EventType = FileEventType::CreateFileSucceeded;
       fe.m_szFileOrDirectory = szRelPath;
       fe.m_szOther = sRootName;
-      fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
+      fe.m_pDataDir = dataDirectories[i].m_pDataDirectory;
       s_Data->m_Event.Broadcast(fe);
 
       return pWriter;
@@ -595,8 +769,6 @@ ezResult ezFileSystem::ResolvePath(const char* szPath, ezStringBuilder* out_sAbs
 {
   EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
 
-  EZ_LOCK(s_Data->m_FsMutex);
-
   ezStringBuilder absPath, relPath;
 
   if (ezStringUtils::StartsWith(szPath, ":"))
@@ -605,7 +777,8 @@ ezResult ezFileSystem::ResolvePath(const char* szPath, ezStringBuilder* out_sAbs
     ezString sRootName;
     ExtractRootName(szPath, sRootName);
 
-    DataDirectory* pDataDir = GetDataDirForRoot(sRootName);
+    SnapshotScope snapshot;
+    const DataDirectory* pDataDir = GetDataDirForRoot(snapshot.GetSnapshot(), sRootName);
 
     if (pDataDir == nullptr)
       return EZ_FAILURE;
@@ -623,9 +796,12 @@ ezResult ezFileSystem::ResolvePath(const char* szPath, ezStringBuilder* out_sAbs
     absPath = szPath;
     absPath.MakeCleanPath();
 
-    for (ezUInt32 dd = s_Data->m_DataDirectories.GetCount(); dd > 0; --dd)
+    SnapshotScope snapshot;
+    const auto& dataDirectories = snapshot.GetDataDirectories();
+
+    for (ezUInt32 dd = dataDirectories.GetCount(); dd > 0; --dd)
     {
-      auto& dir = s_Data->m_DataDirectories[dd - 1];
+      auto& dir = dataDirectories[dd - 1];
 
       if (ezPathUtils::IsSubPath(dir.m_pDataDirectory->GetRedirectedDataDirectoryPath(), absPath))
       {
@@ -649,11 +825,28 @@ ezResult ezFileSystem::ResolvePath(const char* szPath, ezStringBuilder* out_sAbs
   }
   else
   {
+    // relative paths have to be searched for in all data directories, the cache saves opening the file
+    ezInt32 iCacheGeneration = 0;
+    ezUInt8 uiCacheFlags = 0;
+    const bool bUseCache = LookUpResolveCache(szPath, iCacheGeneration, uiCacheFlags, out_sAbsolutePath, out_sDataDirRelativePath, out_ppDataDir);
+
+    if (uiCacheFlags & ResolveCacheEntry::ResolveKnown)
+      return (uiCacheFlags & ResolveCacheEntry::Resolved) ? EZ_SUCCESS : EZ_FAILURE;
+
     // try to get a reader -> if we get one, the file does indeed exist
     ezDataDirectoryReader* pReader = ezFileSystem::GetFileReader(szPath, ezFileShareMode::SharedReads, true);
 
     if (!pReader)
+    {
+      if (bUseCache)
+      {
+        ResolveCacheEntry entry;
+        entry.m_uiFlags = ResolveCacheEntry::ResolveKnown;
+        StoreResolveCacheEntry(szPath, iCacheGeneration, std::move(entry));
+      }
+
       return EZ_FAILURE;
+    }
 
     if (out_ppDataDir != nullptr)
       *out_ppDataDir = pReader->GetDataDirectory();
@@ -663,6 +856,16 @@ ezResult ezFileSystem::ResolvePath(const char* szPath, ezStringBuilder* out_sAbs
     absPath = pReader->GetDataDirectory()->GetRedirectedDataDirectoryPath(); /// \todo We might also need the none-redirected path as an output
     absPath.AppendPath(relPath);
 
+    if (bUseCache)
+    {
+      ResolveCacheEntry entry;
+      entry.m_uiFlags = ResolveCacheEntry::ResolveKnown | ResolveCacheEntry::Resolved | ResolveCacheEntry::ExistsKnown | ResolveCacheEntry::Exists;
+      entry.m_sAbsolutePath = absPath;
+      entry.m_sDataDirRelativePath = relPath;
+      entry.m_pDataDir = pReader->GetDataDirectory();
+      StoreResolveCacheEntry(szPath, iCacheGeneration, std::move(entry));
+    }
+
     pReader->Close();
   }
 
@@ -675,6 +878,7 @@ ezResult ezFileSystem::ResolvePath(const char* szPath, ezStringBuilder* out_sAbs
   return EZ_SUCCESS;
 }
 
+
 ezResult ezFileSystem::FindFolderWithSubPath(ezStringBuilder& result, const char* szStartDirectory, const char* szSubPath, const char* szRedirectionFileName /*= nullptr*/)
 {
   ezStringBuilder sStartDirAbs = szStartDirectory;
@@ -755,9 +959,9 @@ ezResult ezFileSystem::FindFolderWithSubPath(ezStringBuilder& result, const char
 
 bool ezFileSystem::ResolveAssetRedirection(const char* szPathOrAssetGuid, ezStringBuilder& out_sRedirection)
 {
-  EZ_LOCK(s_Data->m_FsMutex);
+  SnapshotScope snapshot;
 
-  for (auto& dd : s_Data->m_DataDirectories)
+  for (auto& dd : snapshot.GetDataDirectories())
   {
     if (dd.m_pDataDirectory->ResolveAssetRedirection(szPathOrAssetGuid, out_sRedirection))
       return true;
@@ -777,11 +981,194 @@ void ezFileSystem::ReloadAllExternalDataDirectoryConfigs()
   {
     dd.m_pDataDirectory->ReloadExternalConfigs();
   }
+
+  // redirections may resolve to different files now
+  ClearResolveCache();
+}
+
+void ezFileSystem::SetResolveCacheEnabled(bool bEnable)
+{
+  EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
+
+  EZ_LOCK(s_Data->m_FsMutex);
+
+  s_Data->m_bResolveCacheEnabled = bEnable;
+
+  UpdateDirectoryWatchers();
+
+  // results that were stored while the cache was being disabled must not survive until it is enabled again
+  ClearResolveCacheShards();
+}
+
+bool ezFileSystem::IsResolveCacheEnabled()
+{
+  EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
+
+  return s_Data->m_bResolveCacheEnabled;
+}
+
+void ezFileSystem::ClearResolveCache()
+{
+  EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
+
+  // nothing is looked up or stored, SetResolveCacheEnabled() clears the cache when it is enabled again
+  if (!s_Data->m_bResolveCacheEnabled)
+    return;
+
+  ClearResolveCacheShards();
+}
+
+void ezFileSystem::ClearResolveCacheShards()
+{
+  // results that are currently being determined are not stored anymore
+  s_Data->m_iResolveCacheGeneration.Increment();
+
+  for (ResolveCacheShard& shard : s_Data->m_ResolveCache)
+  {
+    EZ_LOCK(shard.m_Mutex);
+    shard.m_Entries.Clear();
+  }
+}
+
+bool ezFileSystem::LookUpResolveCache(const char* szPath, ezInt32& out_iGeneration, ezUInt8& out_uiFlags, ezStringBuilder* out_sAbsolutePath,
+  ezStringBuilder* out_sDataDirRelativePath, ezDataDirectoryType** out_ppDataDir)
+{
+  out_uiFlags = 0;
+
+  if (!s_Data->m_bResolveCacheEnabled)
+    return false;
+
+  PollDirectoryWatchers();
+
+  // read before the data directories are accessed, so that results are discarded when the data directories change in the meantime
+  out_iGeneration = s_Data->m_iResolveCacheGeneration;
+
+  const ezUInt64 uiHash = ezHashingUtils::StringHash(szPath);
+  ResolveCacheShard& shard = s_Data->m_ResolveCache[(uiHash >> 32) % FileSystemData::NumResolveCacheShards];
+
+  EZ_LOCK(shard.m_Mutex);
+
+  const ResolveCacheEntry* pEntry = nullptr;
+  if (!shard.m_Entries.TryGetValue(uiHash, pEntry) || pEntry->m_sPath != szPath)
+    return true;
+
+  out_uiFlags = pEntry->m_uiFlags;
+
+  if (pEntry->m_uiFlags & ResolveCacheEntry::Resolved)
+  {
+    if (out_sAbsolutePath)
+      *out_sAbsolutePath = pEntry->m_sAbsolutePath;
+
+    if (out_sDataDirRelativePath)
+      *out_sDataDirRelativePath = pEntry->m_sDataDirRelativePath;
+
+    if (out_ppDataDir)
+      *out_ppDataDir = pEntry->m_pDataDir;
+  }
+
+  return true;
+}
+
+void ezFileSystem::StoreResolveCacheEntry(const char* szPath, ezInt32 iGeneration, ResolveCacheEntry&& entry)
+{
+  const ezUInt64 uiHash = ezHashingUtils::StringHash(szPath);
+  ResolveCacheShard& shard = s_Data->m_ResolveCache[(uiHash >> 32) % FileSystemData::NumResolveCacheShards];
+
+  EZ_LOCK(shard.m_Mutex);
+
+  // ClearResolveCache() increments the generation before it clears the shards, so this can't add outdated results after it
+  if (s_Data->m_iResolveCacheGeneration != iGeneration)
+    return;
+
+  ResolveCacheEntry* pEntry = nullptr;
+  if (shard.m_Entries.TryGetValue(uiHash, pEntry) && pEntry->m_sPath == szPath)
+  {
+    // keep what is known already, e.g. whether the file exists when it is resolved now
+    if (entry.m_uiFlags & ResolveCacheEntry::ResolveKnown)
+    {
+      pEntry->m_sAbsolutePath = std::move(entry.m_sAbsolutePath);
+      pEntry->m_sDataDirRelativePath = std::move(entry.m_sDataDirRelativePath);
+      pEntry->m_pDataDir = entry.m_pDataDir;
+    }
+
+    pEntry->m_uiFlags |= entry.m_uiFlags;
+    return;
+  }
+
+  entry.m_sPath = szPath;
+  shard.m_Entries.Insert(uiHash, std::move(entry));
+}
+
+void ezFileSystem::UpdateDirectoryWatchers()
+{
+#if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+  EZ_LOCK(s_Data->m_WatcherMutex);
+
+  for (ezDirectoryWatcher* pWatcher : s_Data->m_Watchers)
+  {
+    EZ_DEFAULT_DELETE(pWatcher);
+  }
+
+  s_Data->m_Watchers.Clear();
+
+  if (!s_Data->m_bResolveCacheEnabled)
+    return;
+
+  for (const DataDirectory& dd : s_Data->m_DataDirectories)
+  {
+    // archives and other data directory types are not watched, only folders on disk
+    const ezString128& sPath = dd.m_pDataDirectory->GetRedirectedDataDirectoryPath();
+    if (sPath.IsEmpty() || !ezOSFile::ExistsDirectory(sPath))
+      continue;
+
+    const ezBitflags<ezDirectoryWatcher::Watch> whatToWatch =
+      ezDirectoryWatcher::Watch::Writes | ezDirectoryWatcher::Watch::Creates | ezDirectoryWatcher::Watch::Renames | ezDirectoryWatcher::Watch::Subdirectories;
+
+    ezDirectoryWatcher* pWatcher = EZ_DEFAULT_NEW(ezDirectoryWatcher);
+    if (pWatcher->OpenDirectory(sPath.GetData(), whatToWatch).Failed())
+    {
+      EZ_DEFAULT_DELETE(pWatcher);
+      continue;
+    }
+
+    s_Data->m_Watchers.PushBack(pWatcher);
+  }
+#endif
+}
+
+void ezFileSystem::PollDirectoryWatchers()
+{
+#if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+  const ezInt64 iNow = static_cast<ezInt64>(ezTime::Now().GetMicroseconds());
+
+  if (iNow < s_Data->m_iNextWatcherUpdate)
+    return;
+
+  // don't wait for another thread that is checking the watchers already
+  if (!s_Data->m_WatcherMutex.TryLock())
+    return;
+
+  s_Data->m_iNextWatcherUpdate = iNow + 50000;
+
+  bool bAnyChanges = false;
+  for (ezDirectoryWatcher* pWatcher : s_Data->m_Watchers)
+  {
+    pWatcher->EnumerateChanges([&bAnyChanges](const char* szFilename, ezDirectoryWatcherAction action) { bAnyChanges = true; });
+  }
+
+  s_Data->m_WatcherMutex.Unlock();
+
+  if (bAnyChanges)
+  {
+    ClearResolveCache();
+  }
+#endif
 }
 
 void ezFileSystem::Startup()
 {
   s_Data = EZ_DEFAULT_NEW(FileSystemData);
+  s_Data->m_pSnapshot = EZ_DEFAULT_NEW(DataDirSnapshot);
 }
 
 void ezFileSystem::Shutdown()
@@ -790,10 +1177,16 @@ void ezFileSystem::Shutdown()
     EZ_LOCK(s_Data->m_FsMutex);
 
     s_Data->m_DataDirFactories.Clear();
-
-    ClearAllDataDirectories();
   }
 
+  ClearAllDataDirectories();
+  SetResolveCacheEnabled(false);
+
+  EZ_ASSERT_DEV(s_Data->m_RetiredSnapshots.IsEmpty() && s_Data->m_RemovedDataDirectories.IsEmpty(), "The file system is shut down while it is still in use.");
+
+  DataDirSnapshot* pSnapshot = s_Data->m_pSnapshot;
+  EZ_DEFAULT_DELETE(pSnapshot);
+
   EZ_DEFAULT_DELETE(s_Data);
 }
 
@@ -5,6 +5,8 @@
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
 
 enum class ezDependencyFileVersion : ezUInt8
 {
@@ -18,6 +20,9 @@ enum class ezDependencyFileVersion : ezUInt8
 
 ezMap<ezString, ezDependencyFile::FileCheckCache> ezDependencyFile::s_FileTimestamps;
 
+// dependency files may be checked from multiple threads, e.g. when shader permutations are compiled in parallel
+static ezMutex s_FileTimestampsMutex;
+
 ezDependencyFile::ezDependencyFile()
 {
   Clear();
@@ -146,6 +151,8 @@ ezResult ezDependencyFile::RetrieveFileTimeStamp(const char* szFile, ezTimestamp
 {
 #if EZ_ENABLED(EZ_SUPPORTS_FILE_STATS)
 
+  EZ_LOCK(s_FileTimestampsMutex);
+
   bool bExisted = false;
   auto it = s_FileTimestamps.FindOrAdd(szFile, &bExisted);
 
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/ThreadSignal.h>
+
+class ezAsyncLogWriterThread;
+
+namespace ezLogWriter
+{
+  /// \brief A log writer that hands all log messages over to a background thread, which passes them on to other log writers.
+  ///
+  /// Writing a log message only copies it into a fixed size ring buffer, without taking any lock, so threads that log a lot are not
+  /// stalled by slow log writers. The background thread takes all queued messages at once and passes them to the registered log writers.
+  ///
+  /// Create an instance of this class, register the actual log writers at it with AddLogWriter() and register its LogMessageHandler at
+  /// ezGlobalLog, passing the pointer to the instance as the pPassThrough argument:
+  ///
+  /// \code{.cpp}
+  ///   ezLogWriter::Async asyncWriter;
+  ///   asyncWriter.AddLogWriter(ezLogWriter::Console::LogMessageHandler);
+  ///   asyncWriter.Startup();
+  ///   ezGlobalLog::AddLogWriter(ezMakeDelegate(&ezLogWriter::Async::LogMessageHandler, &asyncWriter));
+  /// \endcode
+  ///
+  /// When the ring buffer is full, logging threads wait until the background thread has made room, so no message is ever lost and memory
+  /// usage stays bounded. Error messages and ezLog::Flush() wake up the background thread immediately.
+  /// Before Startup() and after Shutdown() all messages are passed on to the log writers directly.
+  /// Shutdown() may be called while other threads are still logging.
+  class EZ_FOUNDATION_DLL Async
+  {
+    EZ_DISALLOW_COPY_AND_ASSIGN(Async);
+
+  public:
+    Async();
+    ~Async();
+
+    /// \brief Starts the background thread. At most uiMaxQueuedMessages messages are buffered, the value is rounded up to a power of two.
+    void Startup(ezUInt32 uiMaxQueuedMessages = 4096);
+
+    /// \brief Writes all queued messages and stops the background thread.
+    void Shutdown();
+
+    /// \brief Registers a log writer that all messages are passed to on the background thread.
+    ezEventSubscriptionID AddLogWriter(ezLoggingEvent::Handler handler);
+
+    /// \brief Unregisters a previously registered log writer.
+    void RemoveLogWriter(ezLoggingEvent::Handler handler);
+
+    /// \brief Unregisters a previously registered log writer.
+    void RemoveLogWriter(ezEventSubscriptionID subscriptionID);
+
+    /// \brief Register this at ezLog to queue all log messages for the background thread.
+    void LogMessageHandler(const ezLoggingEventData& eventData);
+
+    /// \brief Passes all messages that were queued before this call to the log writers on the calling thread and makes them flush their
+    /// output.
+    void Flush();
+
+    /// \brief Flushes all started instances. Call this from crash handlers, to get the last messages out before the application dies.
+    ///
+    /// Never blocks: instances whose log writers are busy on another thread, or on the crashing thread itself, are skipped.
+    static void FlushAll();
+
+  private:
+    friend class ::ezAsyncLogWriterThread;
+
+    struct Entry;
+
+    void Enqueue(const ezLoggingEventData& eventData);
+    void FlushLocked(ezInt64 iWriteUntilPos);
+
+    /// \brief Passes all queued messages to the log writers. Waits for messages before uiWriteUntilPos that are still being queued.
+    void WriteQueuedMessages(ezInt64 iWriteUntilPos = 0);
+
+    ezArrayPtr<Entry> m_Entries;
+    ezAtomicInteger64 m_iEnqueuePos;
+    ezInt64 m_iDequeuePos = 0; ///< Only accessed under m_WriteMutex.
+
+    /// Messages are only queued while this is set. Shutdown() clears it and then waits until m_iNumEnqueuing drops to zero,
+    /// before it frees the queue.
+    ezAtomicBool m_bRunning;
+    ezAtomicInteger32 m_iNumEnqueuing;
+
+    /// Held while messages are passed to the log writers, which therefore do not need to be thread-safe.
+    ezMutex m_WriteMutex;
+    ezEvent<const ezLoggingEventData&, ezNoMutex> m_LogWriters;
+
+    ezThreadSignal m_WakeUp;
+    ezAsyncLogWriterThread* m_pThread = nullptr;
+    Async* m_pNextRunning = nullptr; ///< Started instances are linked for FlushAll().
+  };
+} // namespace ezLogWriter
@@ -0,0 +1,342 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Logging/AsyncWriter.h>
+#include <Foundation/Math/Math.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+/// \brief Set while a thread passes queued messages to the log writers.
+static thread_local const ezLogWriter::Async* s_pWritingLogWriter = nullptr;
+
+/// \brief All started instances, for FlushAll().
+static ezMutex s_RunningWritersMutex;
+static ezLogWriter::Async* s_pFirstRunningWriter = nullptr;
+
+struct ezLogWriter::Async::Entry
+{
+  /// Messages that do not fit into the entry are copied into a separate allocation.
+  static constexpr ezUInt32 InlineStorageSize = 256;
+
+  /// Equals the queue position that this entry can be written to next, or that position + 1 once a message has been written to it.
+  ezAtomicInteger64 m_iSequence;
+
+  ezLogMsgType::Enum m_EventType = ezLogMsgType::None;
+  ezUInt8 m_uiIndentation = 0;
+  ezUInt32 m_uiTagOffset = 0; ///< The text is stored first, followed by the tag.
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  double m_fSeconds = 0;
+#endif
+  char* m_pHeapStorage = nullptr;
+  char m_InlineStorage[InlineStorageSize];
+};
+
+class ezAsyncLogWriterThread : public ezThread
+{
+public:
+  ezAsyncLogWriterThread(ezLogWriter::Async* pWriter)
+    : ezThread("ezAsyncLogWriter")
+    , m_pWriter(pWriter)
+  {
+  }
+
+  volatile bool m_bKeepRunning = true;
+
+private:
+  virtual ezUInt32 Run() override
+  {
+    while (m_bKeepRunning)
+    {
+      // messages are collected until the queue fills up or someone needs them written right away
+      m_pWriter->m_WakeUp.WaitForSignal(ezTime::Milliseconds(50));
+
+      EZ_LOCK(m_pWriter->m_WriteMutex);
+      m_pWriter->WriteQueuedMessages();
+    }
+
+    return 0;
+  }
+
+  ezLogWriter::Async* m_pWriter;
+};
+
+ezLogWriter::Async::Async() = default;
+
+ezLogWriter::Async::~Async()
+{
+  Shutdown();
+}
+
+void ezLogWriter::Async::Startup(ezUInt32 uiMaxQueuedMessages)
+{
+  if (m_pThread != nullptr)
+    return;
+
+  EZ_ASSERT_DEV(uiMaxQueuedMessages >= 16, "The async log writer needs to be able to queue at least 16 messages.");
+
+  {
+    EZ_LOCK(m_WriteMutex);
+
+    m_Entries = EZ_DEFAULT_NEW_ARRAY(Entry, ezMath::PowerOfTwo_Ceil(uiMaxQueuedMessages));
+    for (ezUInt32 i = 0; i < m_Entries.GetCount(); ++i)
+    {
+      m_Entries[i].m_iSequence = i;
+    }
+
+    m_iDequeuePos = 0;
+    m_iEnqueuePos.Set(0);
+  }
+
+  m_pThread = EZ_DEFAULT_NEW(ezAsyncLogWriterThread, this);
+  m_pThread->Start();
+
+  {
+    EZ_LOCK(s_RunningWritersMutex);
+    m_pNextRunning = s_pFirstRunningWriter;
+    s_pFirstRunningWriter = this;
+  }
+
+  m_bRunning.Set(true);
+}
+
+void ezLogWriter::Async::Shutdown()
+{
+  if (m_pThread == nullptr)
+    return;
+
+  // from now on messages are passed on directly, but threads that are already queueing a message still need the queue
+  m_bRunning.Set(false);
+  while (m_iNumEnqueuing > 0)
+  {
+    ezThreadUtils::YieldTimeSlice();
+  }
+
+  {
+    EZ_LOCK(s_RunningWritersMutex);
+    for (Async** ppWriter = &s_pFirstRunningWriter; *ppWriter != nullptr; ppWriter = &(*ppWriter)->m_pNextRunning)
+    {
+      if (*ppWriter == this)
+      {
+        *ppWriter = m_pNextRunning;
+        break;
+      }
+    }
+    m_pNextRunning = nullptr;
+  }
+
+  m_pThread->m_bKeepRunning = false;
+  m_WakeUp.RaiseSignal();
+  m_pThread->Join();
+  EZ_DEFAULT_DELETE(m_pThread);
+
+  Flush();
+
+  EZ_LOCK(m_WriteMutex);
+  EZ_DEFAULT_DELETE_ARRAY(m_Entries);
+}
+
+ezEventSubscriptionID ezLogWriter::Async::AddLogWriter(ezLoggingEvent::Handler handler)
+{
+  EZ_LOCK(m_WriteMutex);
+  return m_LogWriters.AddEventHandler(handler);
+}
+
+void ezLogWriter::Async::RemoveLogWriter(ezLoggingEvent::Handler handler)
+{
+  EZ_LOCK(m_WriteMutex);
+  m_LogWriters.RemoveEventHandler(handler);
+}
+
+void ezLogWriter::Async::RemoveLogWriter(ezEventSubscriptionID subscriptionID)
+{
+  EZ_LOCK(m_WriteMutex);
+  m_LogWriters.RemoveEventHandler(subscriptionID);
+}
+
+void ezLogWriter::Async::LogMessageHandler(const ezLoggingEventData& eventData)
+{
+  // messages that log writers log themselves are passed on directly, they might not fit into the queue otherwise
+  if (s_pWritingLogWriter != this)
+  {
+    // announce this thread before checking the flag, so that Shutdown() either sees it or this thread sees the cleared flag
+    m_iNumEnqueuing.Increment();
+
+    if (m_bRunning)
+    {
+      Enqueue(eventData);
+      m_iNumEnqueuing.Decrement();
+      return;
+    }
+
+    m_iNumEnqueuing.Decrement();
+  }
+
+  EZ_LOCK(m_WriteMutex);
+  m_LogWriters.Broadcast(eventData);
+}
+
+void ezLogWriter::Async::Flush()
+{
+  const ezInt64 iEnqueuePos = m_iEnqueuePos;
+
+  EZ_LOCK(m_WriteMutex);
+  FlushLocked(iEnqueuePos);
+}
+
+void ezLogWriter::Async::FlushAll()
+{
+  // a crash handler must not wait for locks, the thread that holds them may never continue
+  if (!s_RunningWritersMutex.TryLock())
+    return;
+
+  for (Async* pWriter = s_pFirstRunningWriter; pWriter != nullptr; pWriter = pWriter->m_pNextRunning)
+  {
+    // skip writers that are busy, either on another thread or on this one, when the crash happened inside a log writer
+    if (s_pWritingLogWriter == pWriter)
+      continue;
+
+    const ezInt64 iEnqueuePos = pWriter->m_iEnqueuePos;
+
+    if (pWriter->m_WriteMutex.TryLock())
+    {
+      pWriter->FlushLocked(iEnqueuePos);
+      pWriter->m_WriteMutex.Unlock();
+    }
+  }
+
+  s_RunningWritersMutex.Unlock();
+}
+
+void ezLogWriter::Async::FlushLocked(ezInt64 iWriteUntilPos)
+{
+  WriteQueuedMessages(iWriteUntilPos);
+
+  ezLoggingEventData le;
+  le.m_EventType = ezLogMsgType::Flush;
+  m_LogWriters.Broadcast(le);
+}
+
+void ezLogWriter::Async::Enqueue(const ezLoggingEventData& eventData)
+{
+  const ezUInt32 uiCapacity = m_Entries.GetCount();
+
+  ezInt64 iPos = m_iEnqueuePos;
+  Entry* pEntry = nullptr;
+
+  while (true)
+  {
+    pEntry = &m_Entries[static_cast<ezUInt32>(iPos) & (uiCapacity - 1)];
+    const ezInt64 iSequence = pEntry->m_iSequence;
+
+    if (iSequence == iPos)
+    {
+      if (m_iEnqueuePos.TestAndSet(iPos, iPos + 1))
+        break;
+
+      iPos = m_iEnqueuePos;
+    }
+    else if (iSequence < iPos)
+    {
+      // the queue is full, write the messages on this thread if the background thread is not busy with that already
+      if (m_WriteMutex.TryLock())
+      {
+        WriteQueuedMessages();
+        m_WriteMutex.Unlock();
+      }
+      else
+      {
+        m_WakeUp.RaiseSignal();
+        ezThreadUtils::YieldTimeSlice();
+      }
+
+      iPos = m_iEnqueuePos;
+    }
+    else
+    {
+      // another thread took this position
+      iPos = m_iEnqueuePos;
+    }
+  }
+
+  const ezUInt32 uiTextLength = ezStringUtils::GetStringElementCount(eventData.m_szText);
+  const ezUInt32 uiTagLength = ezStringUtils::GetStringElementCount(eventData.m_szTag);
+  const ezUInt32 uiStorageSize = uiTextLength + uiTagLength + 2;
+
+  char* pStorage = pEntry->m_InlineStorage;
+  if (uiStorageSize > Entry::InlineStorageSize)
+  {
+    pEntry->m_pHeapStorage = EZ_DEFAULT_NEW_RAW_BUFFER(char, uiStorageSize);
+    pStorage = pEntry->m_pHeapStorage;
+  }
+
+  ezMemoryUtils::Copy(pStorage, eventData.m_szText, uiTextLength);
+  pStorage[uiTextLength] = '\0';
+  ezMemoryUtils::Copy(pStorage + uiTextLength + 1, eventData.m_szTag, uiTagLength);
+  pStorage[uiTextLength + 1 + uiTagLength] = '\0';
+
+  pEntry->m_EventType = eventData.m_EventType;
+  pEntry->m_uiIndentation = eventData.m_uiIndentation;
+  pEntry->m_uiTagOffset = uiTextLength + 1;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  pEntry->m_fSeconds = eventData.m_fSeconds;
+#endif
+
+  pEntry->m_iSequence.Set(iPos + 1);
+
+  // wake up the background thread early enough that the queue doesn't fill up, and immediately for anything urgent
+  if (eventData.m_EventType == ezLogMsgType::ErrorMsg || eventData.m_EventType == ezLogMsgType::Flush ||
+      (static_cast<ezUInt32>(iPos) & (uiCapacity / 4 - 1)) == 0)
+  {
+    m_WakeUp.RaiseSignal();
+  }
+}
+
+void ezLogWriter::Async::WriteQueuedMessages(ezInt64 iWriteUntilPos)
+{
+  const ezUInt32 uiCapacity = m_Entries.GetCount();
+  ezUInt32 uiNumRetries = 0;
+
+  while (uiCapacity > 0)
+  {
+    const ezInt64 iPos = m_iDequeuePos;
+    Entry& entry = m_Entries[static_cast<ezUInt32>(iPos) & (uiCapacity - 1)];
+
+    if (entry.m_iSequence != iPos + 1)
+    {
+      // Either the queue is empty or another thread is still in the middle of writing this entry.
+      // Don't wait forever though, the other thread might have crashed.
+      if (iPos >= iWriteUntilPos || ++uiNumRetries > 1000)
+        break;
+
+      ezThreadUtils::YieldTimeSlice();
+      continue;
+    }
+
+    m_iDequeuePos = iPos + 1;
+
+    const char* szStorage = entry.m_pHeapStorage != nullptr ? entry.m_pHeapStorage : entry.m_InlineStorage;
+
+    ezLoggingEventData le;
+    le.m_EventType = entry.m_EventType;
+    le.m_uiIndentation = entry.m_uiIndentation;
+    le.m_szText = szStorage;
+    le.m_szTag = szStorage + entry.m_uiTagOffset;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    le.m_fSeconds = entry.m_fSeconds;
+#endif
+
+    s_pWritingLogWriter = this;
+    m_LogWriters.Broadcast(le);
+    s_pWritingLogWriter = nullptr;
+
+    if (entry.m_pHeapStorage != nullptr)
+    {
+      EZ_DEFAULT_DELETE_RAW_BUFFER(entry.m_pHeapStorage);
+    }
+
+    // the entry can be used again for the message that is one full round further
+    entry.m_iSequence.Set(iPos + uiCapacity);
+  }
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Logging_Implementation_AsyncWriter);
@@ -3,11 +3,12 @@
 #include <Foundation/Communication/DataTransfer.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Configuration/Startup.h>
-#include <Foundation/Containers/IdTable.h>
-#include <Foundation/Containers/StaticRingBuffer.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/IO/JSONWriter.h>
 #include <Foundation/Memory/CommonAllocators.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
 #include <Foundation/Threading/ThreadUtils.h>
 
 #if EZ_ENABLED(EZ_USE_PROFILING)
@@ -53,63 +54,465 @@ namespace
   enum
   {
     BUFFER_SIZE_OTHER_THREAD = 1024 * 1024,
-    BUFFER_SIZE_MAIN_THREAD = BUFFER_SIZE_OTHER_THREAD * 4 ///< Typically the main thread allocated a lot more profiling events than other threads
+    BUFFER_SIZE_MAIN_THREAD = BUFFER_SIZE_OTHER_THREAD * 4, ///< Typically the main thread allocated a lot more profiling events than other threads
+    BUFFER_SIZE_GPU = BUFFER_SIZE_OTHER_THREAD,
   };
 
   enum
   {
-    BUFFER_SIZE_FRAMES = 120 * 60,
+    BUFFER_SIZE_FRAMES = 8 * 1024, ///< A bit more than two minutes at 60 fps, must be a power of two
   };
 
-  typedef ezStaticRingBuffer<ezProfilingSystem::GPUScope, BUFFER_SIZE_OTHER_THREAD / sizeof(ezProfilingSystem::GPUScope)> GPUScopesBuffer;
-
-  static ezUInt64 s_MainThreadId = 0;
-
-  struct CpuScopesBufferBase
+  enum
   {
-    virtual ~CpuScopesBufferBase() = default;
-
-    ezUInt64 m_uiThreadId = 0;
-    bool IsMainThread() const { return m_uiThreadId == s_MainThreadId; }
+    SCOPE_NAME_CHUNK_SIZE = 256,
+    SCOPE_NAME_MAX_CHUNKS = 64,
+    SCOPE_NAME_MAX_COUNT = SCOPE_NAME_CHUNK_SIZE * SCOPE_NAME_MAX_CHUNKS, ///< Also used as the ID for all names that don't fit anymore
+    SCOPE_NAME_TABLE_SIZE = SCOPE_NAME_MAX_COUNT * 2,                      ///< Must be a power of two and larger than SCOPE_NAME_MAX_COUNT
   };
 
-  template <ezUInt32 SizeInBytes>
-  struct CpuScopesBuffer : public CpuScopesBufferBase
+  enum
   {
-    ezStaticRingBuffer<ezProfilingSystem::CPUScope, SizeInBytes / sizeof(ezProfilingSystem::CPUScope)> m_Data;
+    GPU_THREAD_ID = 0,
+    FRAMES_THREAD_ID = 1,
+    CPU_THREAD_ID_OFFSET = 2,
   };
 
-  CpuScopesBuffer<BUFFER_SIZE_MAIN_THREAD>* CastToMainThreadEventBuffer(CpuScopesBufferBase* pEventBuffer)
+  /// \brief A ring buffer that is filled by a single thread, without ever blocking that thread.
+  ///
+  /// Entries are addressed by a monotonically increasing index. Any thread may copy entries out at any time without taking a lock,
+  /// entries which the producer may have overwritten in the meantime are discarded after copying.
+  template <typename T>
+  class ProfilingRingBuffer
   {
-    EZ_ASSERT_DEV(pEventBuffer->IsMainThread(), "Implementation error");
-    return static_cast<CpuScopesBuffer<BUFFER_SIZE_MAIN_THREAD>*>(pEventBuffer);
-  }
+  public:
+    ProfilingRingBuffer() = default;
+    ProfilingRingBuffer(T* pData, ezUInt32 uiCapacity) { Initialize(pData, uiCapacity); }
+
+    void Initialize(T* pData, ezUInt32 uiCapacity)
+    {
+      EZ_ASSERT_DEV(ezMath::IsPowerOf2(uiCapacity), "Ring buffer capacity must be a power of two");
+
+      m_pData = pData;
+      m_uiMask = uiCapacity - 1;
+    }
+
+    /// \brief Must only be called by the thread that owns the buffer.
+    EZ_ALWAYS_INLINE void PushBack(const T& value)
+    {
+      m_pData[m_uiProducerIndex & m_uiMask] = value;
+      ++m_uiProducerIndex;
+
+      // publishes the entry, Set() is a full memory barrier
+      m_iWriteIndex.Set(static_cast<ezInt64>(m_uiProducerIndex));
+    }
+
+    /// \brief Returns the index after the most recently added entry.
+    ezUInt64 GetWriteIndex() const { return static_cast<ezUInt64>(m_iWriteIndex); }
+
+    /// \brief Read() ignores all entries before the given index, which allows to clear the buffer from any thread.
+    void ClearUpTo(ezUInt64 uiIndex) { m_iClearIndex.Max(static_cast<ezInt64>(uiIndex)); }
+
+    void Clear() { ClearUpTo(GetWriteIndex()); }
+
+    /// \brief Copies all entries that were added since uiFirstIndex and are still available to out_Data.
+    ///
+    /// Returns the index after the last copied entry, which can be passed to the next call to only get the new entries.
+    /// If pNumDropped is given, the number of requested entries that were already overwritten is added to it.
+    ezUInt64 Read(ezUInt64 uiFirstIndex, ezDynamicArray<T>& out_Data, ezUInt64* pNumDropped = nullptr) const
+    {
+      const ezUInt64 uiCapacity = static_cast<ezUInt64>(m_uiMask) + 1;
+      const ezUInt64 uiEndIndex = GetWriteIndex();
+
+      uiFirstIndex = ezMath::Max(uiFirstIndex, static_cast<ezUInt64>(m_iClearIndex));
+
+      ezUInt64 uiBeginIndex = uiEndIndex > uiCapacity ? ezMath::Max(uiFirstIndex, uiEndIndex - uiCapacity) : uiFirstIndex;
+      uiBeginIndex = ezMath::Min(uiBeginIndex, uiEndIndex);
+
+      const ezUInt32 uiCount = static_cast<ezUInt32>(uiEndIndex - uiBeginIndex);
+      const ezUInt32 uiStart = static_cast<ezUInt32>(uiBeginIndex & m_uiMask);
+      const ezUInt32 uiFirstPart = ezMath::Min(uiCount, m_uiMask + 1 - uiStart);
 
-  CpuScopesBuffer<BUFFER_SIZE_OTHER_THREAD>* CastToOtherThreadEventBuffer(CpuScopesBufferBase* pEventBuffer)
+      out_Data.SetCountUninitialized(uiCount);
+      ezMemoryUtils::Copy(out_Data.GetData(), m_pData + uiStart, uiFirstPart);
+      ezMemoryUtils::Copy(out_Data.GetData() + uiFirstPart, m_pData, uiCount - uiFirstPart);
+
+      // the producer may have overwritten the oldest entries while they were copied, including the one it is writing right now
+      const ezUInt64 uiNewEndIndex = GetWriteIndex() + 1;
+      if (uiNewEndIndex > uiBeginIndex + uiCapacity)
+      {
+        const ezUInt32 uiNumOverwritten = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiNewEndIndex - uiCapacity - uiBeginIndex, uiCount));
+        out_Data.RemoveAtAndCopy(0, uiNumOverwritten);
+        uiBeginIndex += uiNumOverwritten;
+      }
+
+      if (pNumDropped != nullptr && uiBeginIndex > uiFirstIndex)
+      {
+        *pNumDropped += uiBeginIndex - uiFirstIndex;
+      }
+
+      return uiEndIndex;
+    }
+
+  private:
+    T* m_pData = nullptr;
+    ezUInt32 m_uiMask = 0;
+    ezUInt64 m_uiProducerIndex = 0;
+    ezAtomicInteger64 m_iWriteIndex;
+    ezAtomicInteger64 m_iClearIndex;
+  };
+
+  template <typename T>
+  struct ScopesBuffer
   {
-    EZ_ASSERT_DEV(!pEventBuffer->IsMainThread(), "Implementation error");
-    return static_cast<CpuScopesBuffer<BUFFER_SIZE_OTHER_THREAD>*>(pEventBuffer);
-  }
+    explicit ScopesBuffer(ezUInt32 uiSizeInBytes)
+    {
+      const ezUInt32 uiCapacity = ezMath::PowerOfTwo_Floor(uiSizeInBytes / sizeof(T));
+
+      m_Storage.SetCountUninitialized(uiCapacity);
+      m_Data.Initialize(m_Storage.GetData(), uiCapacity);
+    }
+
+    ezUInt64 m_uiThreadId = 0;
+    ezUInt64 m_uiStreamedIndex = 0; ///< Only accessed by the continuous capture thread
+    ProfilingRingBuffer<T> m_Data;
+    ezDynamicArray<T> m_Storage;
+  };
+
+  typedef ScopesBuffer<ezProfilingSystem::CPUScope> CpuScopesBuffer;
+  typedef ScopesBuffer<ezProfilingSystem::GPUScope> GpuScopesBuffer;
 
   ezCVarFloat CVarDiscardThresholdMs("g_ProfilingDiscardThresholdMs", 0.1f, ezCVarFlags::Default, "Discard profiling scopes if their duration is shorter than the specified threshold.");
 
-  ezStaticRingBuffer<ezTime, BUFFER_SIZE_FRAMES> s_FrameStartTimes;
-  ezUInt64 s_uiFrameCount = 0;
+  static ezTime s_FrameStartTimesData[BUFFER_SIZE_FRAMES];
+  static ProfilingRingBuffer<ezTime> s_FrameStartTimes(s_FrameStartTimesData, BUFFER_SIZE_FRAMES);
 
   static ezHybridArray<ezProfilingSystem::ThreadInfo, 16> s_ThreadInfos;
   static ezHybridArray<ezUInt64, 16> s_DeadThreadIDs;
   static ezMutex s_ThreadInfosMutex;
 
 #  if EZ_ENABLED(EZ_PLATFORM_64BIT)
-  EZ_CHECK_AT_COMPILETIME(sizeof(ezProfilingSystem::CPUScope) == 64);
-  EZ_CHECK_AT_COMPILETIME(sizeof(ezProfilingSystem::GPUScope) == 64);
+  EZ_CHECK_AT_COMPILETIME(sizeof(ezProfilingSystem::CPUScope) == 32);
+  EZ_CHECK_AT_COMPILETIME(sizeof(ezProfilingSystem::GPUScope) == 24);
 #  endif
 
-  static thread_local CpuScopesBufferBase* s_CpuScopes = nullptr;
-  static ezDynamicArray<CpuScopesBufferBase*> s_AllCpuScopes;
+  static thread_local CpuScopesBuffer* s_CpuScopes = nullptr;
+  static ezDynamicArray<CpuScopesBuffer*> s_AllCpuScopes;
   static ezMutex s_AllCpuScopesMutex;
 
-  static GPUScopesBuffer* s_GPUScopes;
+  static GpuScopesBuffer* s_GPUScopes;
+
+  struct ScopeName
+  {
+    ezUInt32 m_uiHash;
+    char m_szName[ezProfilingSystem::SCOPE_NAME_SIZE];
+  };
+
+  /// Lookups only read published slots and never lock. New names are added while holding s_ScopeNamesMutex
+  /// and become visible to other threads once their slot is set.
+  struct ScopeNameTable
+  {
+    volatile ezInt32 m_Slots[SCOPE_NAME_TABLE_SIZE]; ///< 0 for empty slots, otherwise the name ID + 1
+    ScopeName* m_Chunks[SCOPE_NAME_MAX_CHUNKS];
+    ezUInt32 m_uiNumNames;
+  };
+
+  static ScopeNameTable s_ScopeNames;
+  static ezMutex s_ScopeNamesMutex;
+
+  EZ_ALWAYS_INLINE const ScopeName& GetScopeNameEntry(ezUInt32 uiNameId)
+  {
+    return s_ScopeNames.m_Chunks[uiNameId / SCOPE_NAME_CHUNK_SIZE][uiNameId % SCOPE_NAME_CHUNK_SIZE];
+  }
+
+  /// Returns SCOPE_NAME_MAX_COUNT if the name is not in the table yet. In that case out_uiSlot is the free slot where it has to be inserted.
+  ezUInt32 FindScopeName(const char* szName, ezUInt32 uiHash, ezUInt32& out_uiSlot)
+  {
+    // the table is never full, so there is always an empty slot that ends the search
+    for (ezUInt32 uiSlot = uiHash & (SCOPE_NAME_TABLE_SIZE - 1);; uiSlot = (uiSlot + 1) & (SCOPE_NAME_TABLE_SIZE - 1))
+    {
+      const ezInt32 iSlotValue = ezAtomicUtils::Read(s_ScopeNames.m_Slots[uiSlot]);
+
+      if (iSlotValue == 0)
+      {
+        out_uiSlot = uiSlot;
+        return SCOPE_NAME_MAX_COUNT;
+      }
+
+      const ezUInt32 uiNameId = static_cast<ezUInt32>(iSlotValue - 1);
+      const ScopeName& name = GetScopeNameEntry(uiNameId);
+
+      if (name.m_uiHash == uiHash && ezStringUtils::IsEqual(name.m_szName, szName))
+        return uiNameId;
+    }
+  }
+
+  ezOsProcessID GetCurrentProcessID()
+  {
+#  if EZ_ENABLED(EZ_SUPPORTS_PROCESSES)
+    return ezProcess::GetCurrentProcessID();
+#  else
+    return 0;
+#  endif
+  }
+
+  void WriteThreadMetadata(ezJSONWriter& writer, ezOsProcessID uiProcessID, ezUInt64 uiThreadId, const char* szName, ezInt32 iSortIndex = 0)
+  {
+    writer.BeginObject();
+    writer.AddVariableString("name", "thread_name");
+    writer.AddVariableString("cat", "__metadata");
+    writer.AddVariableUInt32("pid", uiProcessID);
+    writer.AddVariableUInt64("tid", uiThreadId);
+    writer.AddVariableString("ph", "M");
+
+    writer.BeginObject("args");
+    writer.AddVariableString("name", szName);
+    writer.EndObject();
+
+    writer.EndObject();
+
+    if (iSortIndex != 0)
+    {
+      writer.BeginObject();
+      writer.AddVariableString("name", "thread_sort_index");
+      writer.AddVariableString("cat", "__metadata");
+      writer.AddVariableUInt32("pid", uiProcessID);
+      writer.AddVariableUInt64("tid", uiThreadId);
+      writer.AddVariableString("ph", "M");
+
+      writer.BeginObject("args");
+      writer.AddVariableInt32("sort_index", iSortIndex);
+      writer.EndObject();
+
+      writer.EndObject();
+    }
+  }
+
+  void WriteEvent(ezJSONWriter& writer, ezOsProcessID uiProcessID, ezUInt64 uiThreadId, const char* szName, ezTime time, const char* szPhase, const char* szFunctionName = nullptr)
+  {
+    writer.BeginObject();
+    writer.AddVariableString("name", szName);
+    writer.AddVariableUInt32("pid", uiProcessID);
+    writer.AddVariableUInt64("tid", uiThreadId);
+    writer.AddVariableUInt64("ts", static_cast<ezUInt64>(time.GetMicroseconds()));
+    writer.AddVariableString("ph", szPhase);
+
+    if (szFunctionName != nullptr)
+    {
+      writer.BeginObject("args");
+      writer.AddVariableString("function", szFunctionName);
+      writer.EndObject();
+    }
+
+    writer.EndObject();
+  }
+
+  /// \brief Writes the given scopes of one thread. The array is sorted in place.
+  ezResult WriteCPUScopes(ezJSONWriter& writer, ezOsProcessID uiProcessID, ezUInt64 uiThreadId, ezDynamicArray<ezProfilingSystem::CPUScope>& scopes)
+  {
+    // It seems that chrome does a stable sort by scope begin time. Now that we write complete scopes at the end of a scope
+    // we actually write nested scopes before their corresponding parent scope to the file. If both start at the same quantized time stamp
+    // chrome prints the nested scope first and then scrambles everything.
+    // So we sort by begin time and then by duration to make sure that parent scopes are written first in the json file.
+    // Sorting by duration alone results in lots of equal keys for short scopes, which degrades the quick sort badly.
+    scopes.Sort([](const ezProfilingSystem::CPUScope& a, const ezProfilingSystem::CPUScope& b) {
+      if (a.m_BeginTime != b.m_BeginTime)
+        return a.m_BeginTime < b.m_BeginTime;
+
+      return (a.m_EndTime - a.m_BeginTime) > (b.m_EndTime - b.m_BeginTime);
+    });
+
+    for (const ezProfilingSystem::CPUScope& e : scopes)
+    {
+      const char* szName = e.GetName();
+
+      WriteEvent(writer, uiProcessID, uiThreadId, szName, e.m_BeginTime, "B", e.m_szFunctionName);
+
+      if (e.m_EndTime.IsPositive())
+      {
+        WriteEvent(writer, uiProcessID, uiThreadId, szName, e.m_EndTime, "E");
+      }
+
+      if (writer.HadWriteError())
+      {
+        return EZ_FAILURE;
+      }
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  /// \brief Writes one event for each pair of consecutive frame start times. uiLastFrameNumber is the number of the last frame.
+  ezResult WriteFrames(ezJSONWriter& writer, ezOsProcessID uiProcessID, ezUInt64 uiThreadId, ezArrayPtr<const ezTime> frameStartTimes, ezUInt64 uiLastFrameNumber)
+  {
+    ezStringBuilder sFrameName;
+
+    const ezUInt32 uiNumFrames = frameStartTimes.GetCount();
+    for (ezUInt32 i = 1; i < uiNumFrames; ++i)
+    {
+      const ezUInt64 localFrameID = uiNumFrames - i - 1;
+      sFrameName.Format("Frame {}", uiLastFrameNumber - localFrameID);
+
+      WriteEvent(writer, uiProcessID, uiThreadId, sFrameName, frameStartTimes[i - 1], "B");
+      WriteEvent(writer, uiProcessID, uiThreadId, sFrameName, frameStartTimes[i], "E");
+
+      if (writer.HadWriteError())
+      {
+        return EZ_FAILURE;
+      }
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  ezResult WriteGPUScopes(ezJSONWriter& writer, ezOsProcessID uiProcessID, ezUInt64 uiThreadId, ezArrayPtr<const ezProfilingSystem::GPUScope> scopes)
+  {
+    for (const ezProfilingSystem::GPUScope& e : scopes)
+    {
+      const char* szName = e.GetName();
+
+      WriteEvent(writer, uiProcessID, uiThreadId, szName, e.m_BeginTime, "B");
+      WriteEvent(writer, uiProcessID, uiThreadId, szName, e.m_EndTime, "E");
+
+      if (writer.HadWriteError())
+      {
+        return EZ_FAILURE;
+      }
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  /// \brief Periodically collects all new profiling data and appends it to a file.
+  class ezProfilingCaptureThread : public ezThread
+  {
+  public:
+    ezProfilingCaptureThread()
+      : ezThread("ezProfilingCaptureThread")
+    {
+    }
+
+    ezFileWriter m_File;
+    volatile bool m_bKeepRunning = true;
+    ezThreadSignal m_WakeUp;
+    ezUInt64 m_uiNumDroppedScopes = 0;
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      m_uiProcessID = GetCurrentProcessID();
+
+      // only data that is added from now on is written to the file
+      {
+        EZ_LOCK(s_AllCpuScopesMutex);
+        for (CpuScopesBuffer* pEventBuffer : s_AllCpuScopes)
+        {
+          pEventBuffer->m_uiStreamedIndex = pEventBuffer->m_Data.GetWriteIndex();
+        }
+      }
+
+      m_uiStreamedFrames = s_FrameStartTimes.GetWriteIndex();
+
+      if (s_GPUScopes != nullptr)
+      {
+        s_GPUScopes->m_uiStreamedIndex = s_GPUScopes->m_Data.GetWriteIndex();
+      }
+
+      ezStandardJSONWriter writer;
+      writer.SetWhitespaceMode(ezJSONWriter::WhitespaceMode::None);
+      writer.SetOutputStream(&m_File);
+
+      writer.BeginObject();
+      writer.BeginArray("traceEvents");
+
+      WriteThreadMetadata(writer, m_uiProcessID, FRAMES_THREAD_ID, "Frames", -1);
+      WriteThreadMetadata(writer, m_uiProcessID, GPU_THREAD_ID, "GPU", -2);
+
+      while (m_bKeepRunning)
+      {
+        m_WakeUp.WaitForSignal(ezTime::Milliseconds(100));
+
+        if (WriteNewData(writer).Failed() || m_File.Flush().Failed())
+        {
+          ezLog::Error("Writing the profiling capture to '{0}' failed.", m_File.GetFilePathAbsolute().GetData());
+          return 1;
+        }
+      }
+
+      writer.EndArray();
+      writer.EndObject();
+
+      return 0;
+    }
+
+    ezResult WriteNewData(ezJSONWriter& writer)
+    {
+      // names of threads that were not written before
+      {
+        EZ_LOCK(s_ThreadInfosMutex);
+
+        for (const ezProfilingSystem::ThreadInfo& info : s_ThreadInfos)
+        {
+          if (!m_KnownThreadIds.Contains(info.m_uiThreadId))
+          {
+            m_KnownThreadIds.PushBack(info.m_uiThreadId);
+            WriteThreadMetadata(writer, m_uiProcessID, info.m_uiThreadId + CPU_THREAD_ID_OFFSET, info.m_sName);
+          }
+        }
+      }
+
+      // buffers are only deleted in ezProfilingSystem::Reset, which stops the capture first
+      {
+        EZ_LOCK(s_AllCpuScopesMutex);
+        m_EventBuffers = s_AllCpuScopes;
+      }
+
+      for (CpuScopesBuffer* pEventBuffer : m_EventBuffers)
+      {
+        pEventBuffer->m_uiStreamedIndex = pEventBuffer->m_Data.Read(pEventBuffer->m_uiStreamedIndex, m_CpuScopes, &m_uiNumDroppedScopes);
+        EZ_SUCCEED_OR_RETURN(WriteCPUScopes(writer, m_uiProcessID, pEventBuffer->m_uiThreadId + CPU_THREAD_ID_OFFSET, m_CpuScopes));
+      }
+
+      // frames
+      {
+        ezUInt64 uiNumDroppedFrames = 0;
+        m_uiStreamedFrames = s_FrameStartTimes.Read(m_uiStreamedFrames, m_FrameStartTimes, &uiNumDroppedFrames);
+
+        if (!m_FrameStartTimes.IsEmpty())
+        {
+          // the last frame of the previous batch ends where the first frame of this batch starts
+          if (uiNumDroppedFrames == 0 && m_LastFrameStartTime.IsPositive())
+          {
+            m_FrameStartTimes.Insert(m_LastFrameStartTime, 0);
+          }
+
+          m_LastFrameStartTime = m_FrameStartTimes.PeekBack();
+
+          EZ_SUCCEED_OR_RETURN(WriteFrames(writer, m_uiProcessID, FRAMES_THREAD_ID, m_FrameStartTimes, m_uiStreamedFrames));
+        }
+      }
+
+      if (s_GPUScopes != nullptr)
+      {
+        s_GPUScopes->m_uiStreamedIndex = s_GPUScopes->m_Data.Read(s_GPUScopes->m_uiStreamedIndex, m_GpuScopes, &m_uiNumDroppedScopes);
+        EZ_SUCCEED_OR_RETURN(WriteGPUScopes(writer, m_uiProcessID, GPU_THREAD_ID, m_GpuScopes));
+      }
+
+      return EZ_SUCCESS;
+    }
+
+    ezOsProcessID m_uiProcessID = 0;
+    ezHybridArray<ezUInt64, 16> m_KnownThreadIds;
+    ezHybridArray<CpuScopesBuffer*, 16> m_EventBuffers;
+    ezDynamicArray<ezProfilingSystem::CPUScope> m_CpuScopes;
+    ezDynamicArray<ezProfilingSystem::GPUScope> m_GpuScopes;
+    ezDynamicArray<ezTime> m_FrameStartTimes;
+    ezUInt64 m_uiStreamedFrames = 0;
+    ezTime m_LastFrameStartTime;
+  };
+
+  static ezProfilingCaptureThread* s_pCaptureThread = nullptr;
+  static ezMutex s_CaptureThreadMutex;
 
   static ezEventSubscriptionID s_PluginEventSubscription = 0;
   void PluginEvent(const ezPluginEvent& e)
@@ -251,33 +654,10 @@ ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& outputStream) c
   {
     writer.BeginArray("traceEvents");
 
-    // Frames thread metadata
+    // Frames and GPU thread metadata
     {
-      writer.BeginObject();
-      writer.AddVariableString("name", "thread_name");
-      writer.AddVariableString("cat", "__metadata");
-      writer.AddVariableUInt32("pid", m_uiProcessID);
-      writer.AddVariableUInt64("tid", m_uiFramesThreadID);
-      writer.AddVariableString("ph", "M");
-
-      writer.BeginObject("args");
-      writer.AddVariableString("name", "Frames");
-      writer.EndObject();
-
-      writer.EndObject();
-
-      writer.BeginObject();
-      writer.AddVariableString("name", "thread_sort_index");
-      writer.AddVariableString("cat", "__metadata");
-      writer.AddVariableUInt32("pid", m_uiProcessID);
-      writer.AddVariableUInt64("tid", m_uiFramesThreadID);
-      writer.AddVariableString("ph", "M");
-
-      writer.BeginObject("args");
-      writer.AddVariableInt32("sort_index", -1);
-      writer.EndObject();
-
-      writer.EndObject();
+      WriteThreadMetadata(writer, m_uiProcessID, m_uiFramesThreadID, "Frames", -1);
+      WriteThreadMetadata(writer, m_uiProcessID, m_uiGPUThreadID, "GPU", -2);
 
       if (writer.HadWriteError())
       {
@@ -285,55 +665,11 @@ ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& outputStream) c
       }
     }
 
-    // GPU thread metadata
-    {
-      writer.BeginObject();
-      writer.AddVariableString("name", "thread_name");
-      writer.AddVariableString("cat", "__metadata");
-      writer.AddVariableUInt32("pid", m_uiProcessID);
-      writer.AddVariableUInt64("tid", m_uiGPUThreadID);
-      writer.AddVariableString("ph", "M");
-
-      writer.BeginObject("args");
-      writer.AddVariableString("name", "GPU");
-      writer.EndObject();
-
-      writer.EndObject();
-
-      writer.BeginObject();
-      writer.AddVariableString("name", "thread_sort_index");
-      writer.AddVariableString("cat", "__metadata");
-      writer.AddVariableUInt32("pid", m_uiProcessID);
-      writer.AddVariableUInt64("tid", m_uiGPUThreadID);
-      writer.AddVariableString("ph", "M");
-
-      writer.BeginObject("args");
-      writer.AddVariableInt32("sort_index", -2);
-      writer.EndObject();
-
-      writer.EndObject();
-      if (writer.HadWriteError())
-      {
-        return EZ_FAILURE;
-      }
-    }
-
     // thread metadata
     {
       for (const ThreadInfo& info : m_ThreadInfos)
       {
-        writer.BeginObject();
-        writer.AddVariableString("name", "thread_name");
-        writer.AddVariableString("cat", "__metadata");
-        writer.AddVariableUInt32("pid", m_uiProcessID);
-        writer.AddVariableUInt64("tid", info.m_uiThreadId + 2);
-        writer.AddVariableString("ph", "M");
-
-        writer.BeginObject("args");
-        writer.AddVariableString("name", info.m_sName);
-        writer.EndObject();
-
-        writer.EndObject();
+        WriteThreadMetadata(writer, m_uiProcessID, info.m_uiThreadId + CPU_THREAD_ID_OFFSET, info.m_sName);
 
         if (writer.HadWriteError())
         {
@@ -346,113 +682,15 @@ ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& outputStream) c
     ezDynamicArray<CPUScope> sortedScopes;
     for (const auto& eventBuffer : m_AllEventBuffers)
     {
-      const ezUInt64 uiThreadId = eventBuffer.m_uiThreadId + 2;
-
-      // It seems that chrome does a stable sort by scope begin time. Now that we write complete scopes at the end of a scope
-      // we actually write nested scopes before their corresponding parent scope to the file. If both start at the same quantized time stamp
-      // chrome prints the nested scope first and then scrambles everything.
-      // So we sort by duration to make sure that parent scopes are written first in the json file.
       sortedScopes = eventBuffer.m_Data;
-      sortedScopes.Sort([](const CPUScope& a, const CPUScope& b) { return (a.m_EndTime - a.m_BeginTime) > (b.m_EndTime - b.m_BeginTime); });
-
-      for (const CPUScope& e : sortedScopes)
-      {
-        writer.BeginObject();
-        writer.AddVariableString("name", e.m_szName);
-        writer.AddVariableUInt32("pid", m_uiProcessID);
-        writer.AddVariableUInt64("tid", uiThreadId);
-        writer.AddVariableUInt64("ts", static_cast<ezUInt64>(e.m_BeginTime.GetMicroseconds()));
-        writer.AddVariableString("ph", "B");
-
-        if (e.m_szFunctionName != nullptr)
-        {
-          writer.BeginObject("args");
-          writer.AddVariableString("function", e.m_szFunctionName);
-          writer.EndObject();
-        }
-
-        writer.EndObject();
-
-        if (e.m_EndTime.IsPositive())
-        {
-          writer.BeginObject();
-          writer.AddVariableString("name", e.m_szName);
-          writer.AddVariableUInt32("pid", m_uiProcessID);
-          writer.AddVariableUInt64("tid", uiThreadId);
-          writer.AddVariableUInt64("ts", static_cast<ezUInt64>(e.m_EndTime.GetMicroseconds()));
-          writer.AddVariableString("ph", "E");
-          writer.EndObject();
-        }
-
-        if (writer.HadWriteError())
-        {
-          return EZ_FAILURE;
-        }
-      }
+      EZ_SUCCEED_OR_RETURN(WriteCPUScopes(writer, m_uiProcessID, eventBuffer.m_uiThreadId + CPU_THREAD_ID_OFFSET, sortedScopes));
     }
 
     // frame start/end
-    {
-      ezStringBuilder sFrameName;
-
-      const ezUInt32 uiNumFrames = m_FrameStartTimes.GetCount();
-      for (ezUInt32 i = 1; i < uiNumFrames; ++i)
-      {
-        const ezTime t0 = m_FrameStartTimes[i - 1];
-        const ezTime t1 = m_FrameStartTimes[i];
-
-        const ezUInt64 localFrameID = uiNumFrames - i - 1;
-        sFrameName.Format("Frame {}", m_uiFrameCount - localFrameID);
-
-        writer.BeginObject();
-        writer.AddVariableString("name", sFrameName);
-        writer.AddVariableUInt32("pid", m_uiProcessID);
-        writer.AddVariableUInt64("tid", m_uiFramesThreadID);
-        writer.AddVariableUInt64("ts", static_cast<ezUInt64>(t0.GetMicroseconds()));
-        writer.AddVariableString("ph", "B");
-        writer.EndObject();
-
-        writer.BeginObject();
-        writer.AddVariableString("name", sFrameName);
-        writer.AddVariableUInt32("pid", m_uiProcessID);
-        writer.AddVariableUInt64("tid", m_uiFramesThreadID);
-        writer.AddVariableUInt64("ts", static_cast<ezUInt64>(t1.GetMicroseconds()));
-        writer.AddVariableString("ph", "E");
-        writer.EndObject();
-        if (writer.HadWriteError())
-        {
-          return EZ_FAILURE;
-        }
-      }
-    }
+    EZ_SUCCEED_OR_RETURN(WriteFrames(writer, m_uiProcessID, m_uiFramesThreadID, m_FrameStartTimes, m_uiFrameCount));
 
     // GPU data
-    {
-      for (ezUInt32 i = 0; i < m_GPUScopes.GetCount(); ++i)
-      {
-        const auto& e = m_GPUScopes[i];
-
-        writer.BeginObject();
-        writer.AddVariableString("name", e.m_szName);
-        writer.AddVariableUInt32("pid", m_uiProcessID);
-        writer.AddVariableUInt64("tid", m_uiGPUThreadID);
-        writer.AddVariableUInt64("ts", static_cast<ezUInt64>(e.m_BeginTime.GetMicroseconds()));
-        writer.AddVariableString("ph", "B");
-        writer.EndObject();
-
-        writer.BeginObject();
-        writer.AddVariableString("name", e.m_szName);
-        writer.AddVariableUInt32("pid", m_uiProcessID);
-        writer.AddVariableUInt64("tid", m_uiGPUThreadID);
-        writer.AddVariableUInt64("ts", static_cast<ezUInt64>(e.m_EndTime.GetMicroseconds()));
-        writer.AddVariableString("ph", "E");
-        writer.EndObject();
-        if (writer.HadWriteError())
-        {
-          return EZ_FAILURE;
-        }
-      }
-    }
+    EZ_SUCCEED_OR_RETURN(WriteGPUScopes(writer, m_uiProcessID, m_uiGPUThreadID, m_GPUScopes));
 
     writer.EndArray();
   }
@@ -467,16 +705,9 @@ void ezProfilingSystem::Clear()
 {
   {
     EZ_LOCK(s_AllCpuScopesMutex);
-    for (auto pEventBuffer : s_AllCpuScopes)
+    for (CpuScopesBuffer* pEventBuffer : s_AllCpuScopes)
     {
-      if (pEventBuffer->IsMainThread())
-      {
-        CastToMainThreadEventBuffer(pEventBuffer)->m_Data.Clear();
-      }
-      else
-      {
-        CastToOtherThreadEventBuffer(pEventBuffer)->m_Data.Clear();
-      }
+      pEventBuffer->m_Data.Clear();
     }
   }
 
@@ -484,7 +715,7 @@ void ezProfilingSystem::Clear()
 
   if (s_GPUScopes != nullptr)
   {
-    s_GPUScopes->Clear();
+    s_GPUScopes->m_Data.Clear();
   }
 }
 
@@ -493,13 +724,9 @@ void ezProfilingSystem::Capture(ezProfilingSystem::ProfilingData& profilingData,
 {
   profilingData.Clear();
 
-  profilingData.m_uiFramesThreadID = 1;
-  profilingData.m_uiGPUThreadID = 0;
-#  if EZ_ENABLED(EZ_SUPPORTS_PROCESSES)
-  profilingData.m_uiProcessID = ezProcess::GetCurrentProcessID();
-#  else
-  profilingData.m_uiProcessID = 0;
-#  endif
+  profilingData.m_uiFramesThreadID = FRAMES_THREAD_ID;
+  profilingData.m_uiGPUThreadID = GPU_THREAD_ID;
+  profilingData.m_uiProcessID = GetCurrentProcessID();
 
   {
     EZ_LOCK(s_ThreadInfosMutex);
@@ -514,58 +741,43 @@ void ezProfilingSystem::Capture(ezProfilingSystem::ProfilingData& profilingData,
     }
   }
 
+  // The lock only protects the list of buffers, the threads that own the buffers keep on adding scopes while they are copied.
+  // When clearing, only the copied scopes are removed, anything that was added in the meantime is kept for the next capture.
   {
     EZ_LOCK(s_AllCpuScopesMutex);
 
     profilingData.m_AllEventBuffers.Reserve(s_AllCpuScopes.GetCount());
-    for (ezUInt32 i = 0; i < s_AllCpuScopes.GetCount(); ++i)
+    for (CpuScopesBuffer* pSourceEventBuffer : s_AllCpuScopes)
     {
-      const auto& sourceEventBuffer = s_AllCpuScopes[i];
       CPUScopesBufferFlat& targetEventBuffer = profilingData.m_AllEventBuffers.ExpandAndGetRef();
+      targetEventBuffer.m_uiThreadId = pSourceEventBuffer->m_uiThreadId;
 
-      targetEventBuffer.m_uiThreadId = sourceEventBuffer->m_uiThreadId;
+      const ezUInt64 uiEndIndex = pSourceEventBuffer->m_Data.Read(0, targetEventBuffer.m_Data);
 
-      ezUInt32 uiSourceCount = sourceEventBuffer->IsMainThread() ? CastToMainThreadEventBuffer(sourceEventBuffer)->m_Data.GetCount() : CastToOtherThreadEventBuffer(sourceEventBuffer)->m_Data.GetCount();
-      targetEventBuffer.m_Data.SetCountUninitialized(uiSourceCount);
-      for (ezUInt32 j = 0; j < uiSourceCount; ++j)
+      if (bClearAfterCapture)
       {
-        const CPUScope& sourceEvent = sourceEventBuffer->IsMainThread() ? CastToMainThreadEventBuffer(sourceEventBuffer)->m_Data[j] : CastToOtherThreadEventBuffer(sourceEventBuffer)->m_Data[j];
-
-        CPUScope& copiedEvent = targetEventBuffer.m_Data[j];
-        copiedEvent.m_szFunctionName = sourceEvent.m_szFunctionName;
-        copiedEvent.m_BeginTime = sourceEvent.m_BeginTime;
-        copiedEvent.m_EndTime = sourceEvent.m_EndTime;
-        ezStringUtils::Copy(copiedEvent.m_szName, CPUScope::NAME_SIZE, sourceEvent.m_szName);
+        pSourceEventBuffer->m_Data.ClearUpTo(uiEndIndex);
       }
     }
   }
 
-  profilingData.m_uiFrameCount = s_uiFrameCount;
+  // every frame adds exactly one start time, so the end index is also the number of frames
+  profilingData.m_uiFrameCount = s_FrameStartTimes.Read(0, profilingData.m_FrameStartTimes);
 
-  profilingData.m_FrameStartTimes.SetCountUninitialized(s_FrameStartTimes.GetCount());
-  for (ezUInt32 i = 0; i < s_FrameStartTimes.GetCount(); ++i)
+  if (bClearAfterCapture)
   {
-    profilingData.m_FrameStartTimes[i] = s_FrameStartTimes[i];
+    s_FrameStartTimes.ClearUpTo(profilingData.m_uiFrameCount);
   }
 
   if (s_GPUScopes != nullptr)
   {
-    profilingData.m_GPUScopes.SetCountUninitialized(s_GPUScopes->GetCount());
-    for (ezUInt32 i = 0; i < s_GPUScopes->GetCount(); ++i)
-    {
-      const GPUScope& sourceGpuDat = (*s_GPUScopes)[i];
+    const ezUInt64 uiEndIndex = s_GPUScopes->m_Data.Read(0, profilingData.m_GPUScopes);
 
-      GPUScope& copiedGpuData = profilingData.m_GPUScopes[i];
-      copiedGpuData.m_BeginTime = sourceGpuDat.m_BeginTime;
-      copiedGpuData.m_EndTime = sourceGpuDat.m_EndTime;
-      ezStringUtils::Copy(copiedGpuData.m_szName, GPUScope::NAME_SIZE, sourceGpuDat.m_szName);
+    if (bClearAfterCapture)
+    {
+      s_GPUScopes->m_Data.ClearUpTo(uiEndIndex);
     }
   }
-
-  if (bClearAfterCapture)
-  {
-    Clear();
-  }
 }
 
 // static
@@ -577,13 +789,6 @@ void ezProfilingSystem::SetDiscardThreshold(ezTime threshold)
 // static
 void ezProfilingSystem::StartNewFrame()
 {
-  ++s_uiFrameCount;
-
-  if (!s_FrameStartTimes.CanAppend())
-  {
-    s_FrameStartTimes.PopFront();
-  }
-
   s_FrameStartTimes.PushBack(ezTime::Now());
 }
 
@@ -594,19 +799,11 @@ void ezProfilingSystem::AddCPUScope(const char* szName, const char* szFunctionNa
   if (endTime - beginTime < ezTime::Milliseconds(CVarDiscardThresholdMs))
     return;
 
-  ::CpuScopesBufferBase* pScopes = s_CpuScopes;
+  CpuScopesBuffer* pScopes = s_CpuScopes;
 
   if (pScopes == nullptr)
   {
-    if (ezThreadUtils::IsMainThread())
-    {
-      pScopes = EZ_DEFAULT_NEW(::CpuScopesBuffer<BUFFER_SIZE_MAIN_THREAD>);
-    }
-    else
-    {
-      pScopes = EZ_DEFAULT_NEW(::CpuScopesBuffer<BUFFER_SIZE_OTHER_THREAD>);
-    }
-
+    pScopes = EZ_DEFAULT_NEW(CpuScopesBuffer, ezThreadUtils::IsMainThread() ? BUFFER_SIZE_MAIN_THREAD : BUFFER_SIZE_OTHER_THREAD);
     pScopes->m_uiThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
     s_CpuScopes = pScopes;
 
@@ -620,28 +817,114 @@ void ezProfilingSystem::AddCPUScope(const char* szName, const char* szFunctionNa
   scope.m_szFunctionName = szFunctionName;
   scope.m_BeginTime = beginTime;
   scope.m_EndTime = endTime;
-  ezStringUtils::Copy(scope.m_szName, EZ_ARRAY_SIZE(scope.m_szName), szName);
+  scope.m_uiNameId = InternScopeName(szName);
 
-  if (ezThreadUtils::IsMainThread())
+  pScopes->m_Data.PushBack(scope);
+}
+
+// static
+ezUInt32 ezProfilingSystem::InternScopeName(const char* szName)
+{
+  char szTruncatedName[SCOPE_NAME_SIZE];
+  const ezUInt32 uiNameLength = ezStringUtils::Copy(szTruncatedName, SCOPE_NAME_SIZE, szName);
+  const ezUInt32 uiHash = ezHashingUtils::xxHash32(szTruncatedName, uiNameLength);
+
+  ezUInt32 uiSlot = 0;
+  ezUInt32 uiNameId = FindScopeName(szTruncatedName, uiHash, uiSlot);
+
+  if (uiNameId != SCOPE_NAME_MAX_COUNT)
+    return uiNameId;
+
+  EZ_LOCK(s_ScopeNamesMutex);
+
+  // another thread may have added the same name in the meantime
+  uiNameId = FindScopeName(szTruncatedName, uiHash, uiSlot);
+
+  if (uiNameId != SCOPE_NAME_MAX_COUNT || s_ScopeNames.m_uiNumNames == SCOPE_NAME_MAX_COUNT)
+    return uiNameId;
+
+  uiNameId = s_ScopeNames.m_uiNumNames++;
+
+  ScopeName*& pChunk = s_ScopeNames.m_Chunks[uiNameId / SCOPE_NAME_CHUNK_SIZE];
+  if (pChunk == nullptr)
   {
-    auto pMainThreadBuffer = CastToMainThreadEventBuffer(pScopes);
-    if (!pMainThreadBuffer->m_Data.CanAppend())
-    {
-      pMainThreadBuffer->m_Data.PopFront();
-    }
+    // names are never freed, captured profiling data may be written long after the scopes were recorded
+    pChunk = EZ_NEW_RAW_BUFFER(ezStaticAllocatorWrapper::GetAllocator(), ScopeName, SCOPE_NAME_CHUNK_SIZE);
+  }
+
+  ScopeName& name = pChunk[uiNameId % SCOPE_NAME_CHUNK_SIZE];
+  name.m_uiHash = uiHash;
+  ezStringUtils::Copy(name.m_szName, SCOPE_NAME_SIZE, szTruncatedName);
+
+  // publishes the name, Set() is a full memory barrier
+  ezAtomicUtils::Set(s_ScopeNames.m_Slots[uiSlot], static_cast<ezInt32>(uiNameId + 1));
+
+  return uiNameId;
+}
+
+// static
+const char* ezProfilingSystem::GetScopeName(ezUInt32 uiNameId)
+{
+  if (uiNameId >= SCOPE_NAME_MAX_COUNT)
+    return "<Too many profiling scope names>";
+
+  return GetScopeNameEntry(uiNameId).m_szName;
+}
+
+// static
+ezResult ezProfilingSystem::StartContinuousCapture(const char* szFile)
+{
+  EZ_LOCK(s_CaptureThreadMutex);
 
-    pMainThreadBuffer->m_Data.PushBack(scope);
+  if (s_pCaptureThread != nullptr)
+  {
+    ezLog::Error("A continuous profiling capture is already running.");
+    return EZ_FAILURE;
   }
-  else
+
+  ezProfilingCaptureThread* pCaptureThread = EZ_DEFAULT_NEW(ezProfilingCaptureThread);
+
+  if (pCaptureThread->m_File.Open(szFile).Failed())
   {
-    auto pOtherThreadBuffer = CastToOtherThreadEventBuffer(pScopes);
-    if (!pOtherThreadBuffer->m_Data.CanAppend())
-    {
-      pOtherThreadBuffer->m_Data.PopFront();
-    }
+    ezLog::Error("Could not open '{0}' for the continuous profiling capture.", szFile);
+    EZ_DEFAULT_DELETE(pCaptureThread);
+    return EZ_FAILURE;
+  }
+
+  s_pCaptureThread = pCaptureThread;
+  s_pCaptureThread->Start();
 
-    pOtherThreadBuffer->m_Data.PushBack(scope);
+  return EZ_SUCCESS;
+}
+
+// static
+void ezProfilingSystem::StopContinuousCapture()
+{
+  EZ_LOCK(s_CaptureThreadMutex);
+
+  if (s_pCaptureThread == nullptr)
+    return;
+
+  s_pCaptureThread->m_bKeepRunning = false;
+  s_pCaptureThread->m_WakeUp.RaiseSignal();
+  s_pCaptureThread->Join();
+
+  if (s_pCaptureThread->m_uiNumDroppedScopes > 0)
+  {
+    ezLog::Warning("The continuous profiling capture dropped {0} scopes, because they were overwritten before they could be written to the file.", s_pCaptureThread->m_uiNumDroppedScopes);
   }
+
+  ezLog::Info("Profiling capture saved to '{0}'.", s_pCaptureThread->m_File.GetFilePathAbsolute().GetData());
+
+  s_pCaptureThread->m_File.Close();
+  EZ_DEFAULT_DELETE(s_pCaptureThread);
+}
+
+// static
+bool ezProfilingSystem::IsContinuousCaptureActive()
+{
+  EZ_LOCK(s_CaptureThreadMutex);
+  return s_pCaptureThread != nullptr;
 }
 
 // static
@@ -649,14 +932,15 @@ void ezProfilingSystem::Initialize()
 {
   SetThreadName("Main Thread");
 
-  s_MainThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
-
   s_PluginEventSubscription = ezPlugin::s_PluginEvents.AddEventHandler(&PluginEvent);
 }
 
 // static
 void ezProfilingSystem::Reset()
 {
+  // the capture thread accesses the buffers that are deleted below
+  StopContinuousCapture();
+
   EZ_LOCK(s_ThreadInfosMutex);
   EZ_LOCK(s_AllCpuScopesMutex);
   for (ezUInt32 i = 0; i < s_DeadThreadIDs.GetCount(); i++)
@@ -675,7 +959,7 @@ void ezProfilingSystem::Reset()
     }
     for (ezUInt32 k = 0; k < s_AllCpuScopes.GetCount(); k++)
     {
-      CpuScopesBufferBase* pEventBuffer = s_AllCpuScopes[k];
+      CpuScopesBuffer* pEventBuffer = s_AllCpuScopes[k];
       if (pEventBuffer->m_uiThreadId == uiThreadId)
       {
         EZ_DEFAULT_DELETE(pEventBuffer);
@@ -712,7 +996,7 @@ void ezProfilingSystem::InitializeGPUData()
 {
   if (s_GPUScopes == nullptr)
   {
-    s_GPUScopes = EZ_DEFAULT_NEW(GPUScopesBuffer);
+    s_GPUScopes = EZ_DEFAULT_NEW(GpuScopesBuffer, BUFFER_SIZE_GPU);
   }
 }
 
@@ -722,17 +1006,12 @@ void ezProfilingSystem::AddGPUScope(const char* szName, ezTime beginTime, ezTime
   if (endTime - beginTime < ezTime::Milliseconds(CVarDiscardThresholdMs))
     return;
 
-  if (!s_GPUScopes->CanAppend())
-  {
-    s_GPUScopes->PopFront();
-  }
-
   GPUScope scope;
   scope.m_BeginTime = beginTime;
   scope.m_EndTime = endTime;
-  ezStringUtils::Copy(scope.m_szName, EZ_ARRAY_SIZE(scope.m_szName), szName);
+  scope.m_uiNameId = InternScopeName(szName);
 
-  s_GPUScopes->PushBack(scope);
+  s_GPUScopes->m_Data.PushBack(scope);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -802,6 +1081,28 @@ void ezProfilingSystem::StartNewFrame() {}
 
 void ezProfilingSystem::AddCPUScope(const char* szName, const char* szFunctionName, ezTime beginTime, ezTime endTime) {}
 
+ezUInt32 ezProfilingSystem::InternScopeName(const char* szName)
+{
+  return 0;
+}
+
+const char* ezProfilingSystem::GetScopeName(ezUInt32 uiNameId)
+{
+  return "";
+}
+
+ezResult ezProfilingSystem::StartContinuousCapture(const char* szFile)
+{
+  return EZ_FAILURE;
+}
+
+void ezProfilingSystem::StopContinuousCapture() {}
+
+bool ezProfilingSystem::IsContinuousCaptureActive()
+{
+  return false;
+}
+
 void ezProfilingSystem::Initialize() {}
 
 void ezProfilingSystem::Reset() {}
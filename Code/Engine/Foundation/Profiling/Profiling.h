@@ -64,16 +64,19 @@ public:
     ezString m_sName;
   };
 
+  /// \brief Scope names are interned and truncated to this size (including the terminator), see InternScopeName().
+  static constexpr ezUInt32 SCOPE_NAME_SIZE = 64;
+
   struct CPUScope
   {
     EZ_DECLARE_POD_TYPE();
 
-    static constexpr ezUInt32 NAME_SIZE = 40;
+    const char* GetName() const { return GetScopeName(m_uiNameId); }
 
     const char* m_szFunctionName;
     ezTime m_BeginTime;
     ezTime m_EndTime;
-    char m_szName[NAME_SIZE];
+    ezUInt32 m_uiNameId;
   };
 
   struct CPUScopesBufferFlat
@@ -87,11 +90,11 @@ public:
   {
     EZ_DECLARE_POD_TYPE();
 
-    static constexpr ezUInt32 NAME_SIZE = 48;
+    const char* GetName() const { return GetScopeName(m_uiNameId); }
 
     ezTime m_BeginTime;
     ezTime m_EndTime;
-    char m_szName[NAME_SIZE];
+    ezUInt32 m_uiNameId;
   };
 
   struct EZ_FOUNDATION_DLL ProfilingData
@@ -132,6 +135,28 @@ public:
   /// \brief Adds a new scoped event for the calling thread in the profiling system
   static void AddCPUScope(const char* szName, const char* szFunctionName, ezTime beginTime, ezTime endTime);
 
+  /// \brief Returns a process-wide unique ID for the given scope name.
+  ///
+  /// The name is copied (and truncated to SCOPE_NAME_SIZE - 1 bytes) the first time it is seen, afterwards the lookup does not lock.
+  /// The number of unique names is limited, once the limit is reached, all new names map to a single 'overflow' ID.
+  static ezUInt32 InternScopeName(const char* szName);
+
+  /// \brief Returns the name for an ID returned by InternScopeName(). The string stays valid until the process exits.
+  static const char* GetScopeName(ezUInt32 uiNameId);
+
+  /// \brief Starts writing all profiling data continuously to the given file, in Chrome's trace event format.
+  ///
+  /// A background thread periodically collects the new scopes of all threads, so this can be used to profile long running sessions
+  /// without keeping all the data in memory. Scopes that are overwritten in the per-thread ring buffers before the
+  /// background thread collected them are dropped.
+  static ezResult StartContinuousCapture(const char* szFile);
+
+  /// \brief Stops the continuous capture and closes the file.
+  static void StopContinuousCapture();
+
+  /// \brief Returns whether a continuous capture is currently running.
+  static bool IsContinuousCaptureActive();
+
 private:
   EZ_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, ProfilingSystem);
   friend ezUInt32 RunThread(ezThread* pThread);
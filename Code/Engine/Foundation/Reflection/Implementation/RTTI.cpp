@@ -5,24 +5,195 @@
 
 #include <Foundation/Communication/Message.h>
 #include <Foundation/Configuration/Startup.h>
-#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Containers/DynamicArray.h>
+
+namespace
+{
+  /// \brief Replaces the pointer that readers load without locking. Writers must be serialized by the caller.
+  ///
+  /// This is a full barrier, so everything that was written to *pValue before is visible to readers that see the new pointer.
+  template <typename T>
+  void PublishPointer(T* volatile* pDest, T* pValue)
+  {
+    ezAtomicUtils::TestAndSet((void**)pDest, (void*)*pDest, (void*)pValue);
+  }
+
+  /// \brief Open addressing table of types that can be searched without locking, while other threads register or unregister types.
+  ///
+  /// Modifications must be serialized by the caller. Slots only ever change atomically from one type pointer to another, so a reader
+  /// always sees a consistent table. When the table needs to be resized, a new slot array is published and the old one is kept alive,
+  /// because readers might still be looking at it. Since the table grows geometrically, this wastes at most as much memory as the current
+  /// slot array takes.
+  class ezTypeLookupTable
+  {
+  public:
+    using HashFunc = ezUInt32 (*)(ezUInt64 uiTypeNameHash);
+
+    explicit ezTypeLookupTable(HashFunc hashFunc)
+      : m_HashFunc(hashFunc)
+    {
+    }
+
+    template <typename Predicate>
+    ezRTTI* Find(ezUInt32 uiHash, Predicate predicate) const
+    {
+      const Slots* pSlots = m_pSlots;
+      if (pSlots == nullptr)
+        return nullptr;
+
+      const ezUInt32 uiMask = pSlots->m_uiCapacity - 1;
+      for (ezUInt32 uiProbe = 0, uiIndex = uiHash & uiMask; uiProbe <= uiMask; ++uiProbe, uiIndex = (uiIndex + 1) & uiMask)
+      {
+        ezRTTI* pType = pSlots->m_pTypes[uiIndex];
+        if (pType == nullptr)
+          return nullptr;
+
+        if (pType != GetDeletedMarker() && predicate(pType))
+          return pType;
+      }
+
+      return nullptr;
+    }
+
+    /// \brief Adds the type or replaces a type with the same name.
+    void Insert(ezRTTI* pNewType)
+    {
+      Slots* pSlots = m_pSlots;
+      if (pSlots == nullptr || (m_uiNumUsedSlots + 1) * 2 > pSlots->m_uiCapacity)
+      {
+        pSlots = Rehash(m_uiCount + 1);
+      }
+
+      const ezUInt32 uiMask = pSlots->m_uiCapacity - 1;
+      ezUInt32 uiFreeIndex = ezInvalidIndex;
+      for (ezUInt32 uiIndex = m_HashFunc(pNewType->GetTypeNameHash()) & uiMask;; uiIndex = (uiIndex + 1) & uiMask)
+      {
+        ezRTTI* pType = pSlots->m_pTypes[uiIndex];
+        if (pType == nullptr)
+        {
+          if (uiFreeIndex == ezInvalidIndex)
+          {
+            uiFreeIndex = uiIndex;
+            ++m_uiNumUsedSlots;
+          }
+          break;
+        }
+
+        if (pType == GetDeletedMarker())
+        {
+          // a deleted slot can only be re-used once it is clear that the name isn't registered further along the chain
+          if (uiFreeIndex == ezInvalidIndex)
+            uiFreeIndex = uiIndex;
+        }
+        else if (ezStringUtils::IsEqual(pType->GetTypeName(), pNewType->GetTypeName()))
+        {
+          PublishPointer(&pSlots->m_pTypes[uiIndex], pNewType);
+          return;
+        }
+      }
+
+      PublishPointer(&pSlots->m_pTypes[uiFreeIndex], pNewType);
+      ++m_uiCount;
+    }
+
+    void Remove(const ezRTTI* pTypeToRemove)
+    {
+      Slots* pSlots = m_pSlots;
+      if (pSlots == nullptr)
+        return;
+
+      const ezUInt32 uiMask = pSlots->m_uiCapacity - 1;
+      for (ezUInt32 uiIndex = m_HashFunc(pTypeToRemove->GetTypeNameHash()) & uiMask;; uiIndex = (uiIndex + 1) & uiMask)
+      {
+        ezRTTI* pType = pSlots->m_pTypes[uiIndex];
+        if (pType == nullptr)
+          return;
+
+        if (pType == pTypeToRemove)
+        {
+          PublishPointer(&pSlots->m_pTypes[uiIndex], GetDeletedMarker());
+          --m_uiCount;
+          return;
+        }
+      }
+    }
+
+  private:
+    struct Slots
+    {
+      ezUInt32 m_uiCapacity;
+      ezRTTI* volatile* m_pTypes;
+    };
+
+    static ezRTTI* GetDeletedMarker()
+    {
+      static ezUInt8 s_DeletedMarker;
+      return reinterpret_cast<ezRTTI*>(&s_DeletedMarker);
+    }
+
+    Slots* Rehash(ezUInt32 uiMinCount)
+    {
+      // also gets rid of all deleted slots
+      Slots* pOldSlots = m_pSlots;
+
+      Slots* pNewSlots = new Slots();
+      pNewSlots->m_uiCapacity = ezMath::Max(ezMath::PowerOfTwo_Ceil(uiMinCount * 4), 1024u);
+      pNewSlots->m_pTypes = new ezRTTI* volatile[pNewSlots->m_uiCapacity]();
+
+      m_uiCount = 0;
+      m_uiNumUsedSlots = 0;
+
+      if (pOldSlots != nullptr)
+      {
+        const ezUInt32 uiNewMask = pNewSlots->m_uiCapacity - 1;
+        for (ezUInt32 i = 0; i < pOldSlots->m_uiCapacity; ++i)
+        {
+          ezRTTI* pType = pOldSlots->m_pTypes[i];
+          if (pType == nullptr || pType == GetDeletedMarker())
+            continue;
+
+          ezUInt32 uiIndex = m_HashFunc(pType->GetTypeNameHash()) & uiNewMask;
+          while (pNewSlots->m_pTypes[uiIndex] != nullptr)
+          {
+            uiIndex = (uiIndex + 1) & uiNewMask;
+          }
+
+          // the new slot array isn't visible to readers yet
+          pNewSlots->m_pTypes[uiIndex] = pType;
+          ++m_uiCount;
+          ++m_uiNumUsedSlots;
+        }
+
+        m_RetiredSlots.PushBack(pOldSlots);
+      }
+
+      PublishPointer(&m_pSlots, pNewSlots);
+      return pNewSlots;
+    }
+
+    HashFunc m_HashFunc;
+    Slots* volatile m_pSlots = nullptr;
+    ezUInt32 m_uiCount = 0;
+    ezUInt32 m_uiNumUsedSlots = 0; ///< Slots that are not empty, including deleted ones.
+    ezDynamicArray<Slots*, ezStaticAllocatorWrapper> m_RetiredSlots;
+  };
+} // namespace
 
 struct ezTypeHashTable
 {
-  ezMutex m_Mutex;
-  ezHashTable<const char*, ezRTTI*, ezHashHelper<const char*>, ezStaticAllocatorWrapper> m_Table;
+  ezMutex m_Mutex; ///< Only needed for modifications, look-ups don't lock.
+  ezTypeLookupTable m_TypesByHash{[](ezUInt64 uiTypeNameHash) { return static_cast<ezUInt32>(uiTypeNameHash); }};
+  ezTypeLookupTable m_TypesByHash32{[](ezUInt64 uiTypeNameHash) { return ezHashingUtils::StringHashTo32(uiTypeNameHash); }};
+
+  /// Ancestor arrays that were replaced when a type hierarchy changed. IsDerivedFrom may still read them on other threads.
+  ezDynamicArray<const ezDynamicArray<const ezRTTI*, ezStaticAllocatorWrapper>*, ezStaticAllocatorWrapper> m_RetiredAncestors;
 };
 
 ezTypeHashTable* GetTypeHashTable()
 {
   // Prevent static initialization hazard between first ezRTTI instance
-  // and the hash table and also make sure it is sufficiently sized before first use.
-  auto CreateTable = []() -> ezTypeHashTable* {
-    ezTypeHashTable* table = new ezTypeHashTable();
-    table->m_Table.Reserve(512);
-    return table;
-  };
-  static ezTypeHashTable* table = CreateTable();
+  // and the hash table.
+  static ezTypeHashTable* table = new ezTypeHashTable();
   return table;
 }
 
@@ -89,6 +260,12 @@ ezRTTI::~ezRTTI()
 {
   if (m_szTypeName)
     UnregisterType();
+
+  if (m_pAncestors != nullptr)
+  {
+    AncestorArray* pAncestors = const_cast<AncestorArray*>(static_cast<const AncestorArray*>(m_pAncestors));
+    EZ_DELETE(ezStaticAllocatorWrapper::GetAllocator(), pAncestors);
+  }
 }
 
 void ezRTTI::GatherDynamicMessageHandlers()
@@ -199,6 +376,60 @@ void ezRTTI::UpdateType(const ezRTTI* pParentType, ezUInt32 uiTypeSize, ezUInt32
   m_uiTypeSize = uiTypeSize;
   m_uiTypeVersion = uiTypeVersion;
   m_TypeFlags = flags;
+
+  if (m_pAncestors != nullptr)
+  {
+    // derived types may have cached this type's old hierarchy as well
+    for (ezRTTI* pRtti = ezRTTI::GetFirstInstance(); pRtti != nullptr; pRtti = pRtti->GetNextInstance())
+    {
+      if (pRtti->m_pAncestors != nullptr)
+      {
+        pRtti->SetupParentHierarchy();
+      }
+    }
+  }
+}
+
+void ezRTTI::SetupParentHierarchy()
+{
+  ezHybridArray<const ezRTTI*, 16> ancestors;
+  for (const ezRTTI* pRtti = this; pRtti != nullptr; pRtti = pRtti->m_pParentType)
+  {
+    ancestors.PushBack(pRtti);
+  }
+
+  auto pTable = GetTypeHashTable();
+  EZ_LOCK(pTable->m_Mutex);
+
+  const ezUInt32 uiDepth = ancestors.GetCount();
+  const AncestorArray* pOldAncestors = m_pAncestors;
+
+  if (pOldAncestors != nullptr && pOldAncestors->GetCount() == uiDepth)
+  {
+    bool bChanged = false;
+    for (ezUInt32 i = 0; i < uiDepth && !bChanged; ++i)
+    {
+      bChanged = (*pOldAncestors)[i] != ancestors[uiDepth - 1 - i];
+    }
+
+    if (!bChanged)
+      return;
+  }
+
+  // other threads may call IsDerivedFrom concurrently, so a published array is never modified but replaced as a whole
+  AncestorArray* pNewAncestors = EZ_NEW(ezStaticAllocatorWrapper::GetAllocator(), AncestorArray);
+  pNewAncestors->SetCountUninitialized(uiDepth);
+  for (ezUInt32 i = 0; i < uiDepth; ++i)
+  {
+    (*pNewAncestors)[i] = ancestors[uiDepth - 1 - i];
+  }
+
+  PublishPointer(&m_pAncestors, static_cast<const AncestorArray*>(pNewAncestors));
+
+  if (pOldAncestors != nullptr)
+  {
+    pTable->m_RetiredAncestors.PushBack(pOldAncestors);
+  }
 }
 
 void ezRTTI::RegisterType()
@@ -207,18 +438,31 @@ void ezRTTI::RegisterType()
 
   auto pTable = GetTypeHashTable();
   EZ_LOCK(pTable->m_Mutex);
-  pTable->m_Table.Insert(m_szTypeName, this);
+  pTable->m_TypesByHash.Insert(this);
+  pTable->m_TypesByHash32.Insert(this);
 }
 
 void ezRTTI::UnregisterType()
 {
   auto pTable = GetTypeHashTable();
   EZ_LOCK(pTable->m_Mutex);
-  pTable->m_Table.Remove(m_szTypeName);
+  pTable->m_TypesByHash.Remove(this);
+  pTable->m_TypesByHash32.Remove(this);
 }
 
 bool ezRTTI::IsDerivedFrom(const ezRTTI* pBaseType) const
 {
+  const AncestorArray* pAncestors = m_pAncestors;
+  const AncestorArray* pBaseAncestors = pBaseType != nullptr ? pBaseType->m_pAncestors : nullptr;
+
+  if (pAncestors != nullptr && pBaseAncestors != nullptr)
+  {
+    // a base type has to be at the same depth in our hierarchy as it is in its own
+    const ezUInt32 uiBaseDepth = pBaseAncestors->GetCount() - 1;
+    return uiBaseDepth < pAncestors->GetCount() && (*pAncestors)[uiBaseDepth] == pBaseType;
+  }
+
+  // the hierarchy is not set up yet for types that haven't been assigned to a plugin
   const ezRTTI* pThis = this;
 
   while (pThis != nullptr)
@@ -244,13 +488,14 @@ void ezRTTI::GetAllProperties(ezHybridArray<ezAbstractProperty*, 32>& out_Proper
 
 ezRTTI* ezRTTI::FindTypeByName(const char* szName)
 {
-  ezRTTI* pInstance = nullptr;
-  {
-    auto pTable = GetTypeHashTable();
-    EZ_LOCK(pTable->m_Mutex);
-    if (pTable->m_Table.TryGetValue(szName, pInstance))
-      return pInstance;
-  }
+  const ezUInt64 uiNameHash = ezHashingUtils::StringHash(szName);
+
+  ezRTTI* pInstance = GetTypeHashTable()->m_TypesByHash.Find(static_cast<ezUInt32>(uiNameHash), [&](const ezRTTI* pType) {
+    return pType->GetTypeNameHash() == uiNameHash && ezStringUtils::IsEqual(pType->GetTypeName(), szName);
+  });
+
+  if (pInstance != nullptr)
+    return pInstance;
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
   pInstance = ezRTTI::GetFirstInstance();
@@ -272,36 +517,14 @@ ezRTTI* ezRTTI::FindTypeByName(const char* szName)
 
 ezRTTI* ezRTTI::FindTypeByNameHash(ezUInt64 uiNameHash)
 {
-  // TODO: actually reuse the hash table for the lookup
-
-  ezRTTI* pInstance = ezRTTI::GetFirstInstance();
-
-  while (pInstance)
-  {
-    if (pInstance->GetTypeNameHash() == uiNameHash)
-      return pInstance;
-
-    pInstance = pInstance->GetNextInstance();
-  }
-
-  return nullptr;
+  return GetTypeHashTable()->m_TypesByHash.Find(
+    static_cast<ezUInt32>(uiNameHash), [&](const ezRTTI* pType) { return pType->GetTypeNameHash() == uiNameHash; });
 }
 
 ezRTTI* ezRTTI::FindTypeByNameHash32(ezUInt32 uiNameHash)
 {
-  // TODO: actually reuse the hash table for the lookup
-
-  ezRTTI* pInstance = ezRTTI::GetFirstInstance();
-
-  while (pInstance)
-  {
-    if (ezHashingUtils::StringHashTo32(pInstance->GetTypeNameHash()) == uiNameHash)
-      return pInstance;
-
-    pInstance = pInstance->GetNextInstance();
-  }
-
-  return nullptr;
+  return GetTypeHashTable()->m_TypesByHash32.Find(
+    uiNameHash, [&](const ezRTTI* pType) { return ezHashingUtils::StringHashTo32(pType->GetTypeNameHash()) == uiNameHash; });
 }
 
 ezAbstractProperty* ezRTTI::FindPropertyByName(const char* szName, bool bSearchBaseTypes /* = true */) const
@@ -404,6 +627,7 @@ void ezRTTI::AssignPlugin(const char* szPluginName)
       pInstance->m_szPluginName = szPluginName;
       SanityCheckType(pInstance);
 
+      pInstance->SetupParentHierarchy();
       pInstance->GatherDynamicMessageHandlers();
     }
     pInstance = pInstance->GetNextInstance();
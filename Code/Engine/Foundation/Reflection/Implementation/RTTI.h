@@ -157,6 +157,9 @@ protected:
 
   void GatherDynamicMessageHandlers();
 
+  /// \brief Caches the chain of parent types in m_Ancestors, which allows IsDerivedFrom to run in constant time.
+  void SetupParentHierarchy();
+
   const ezRTTI* m_pParentType;
   ezRTTIAllocator* m_pAllocator;
 
@@ -174,6 +177,12 @@ protected:
   ezDynamicArray<ezAbstractMessageHandler*, ezStaticAllocatorWrapper>
     m_DynamicMessageHandlers; // do not track this data, it won't be deallocated before shutdown
 
+  /// The root type comes first, this type last. Null until the type has been assigned to a plugin.
+  /// Published arrays are never modified, a changed hierarchy replaces the whole array. Old arrays are kept alive, because IsDerivedFrom
+  /// may still read them on other threads.
+  using AncestorArray = ezDynamicArray<const ezRTTI*, ezStaticAllocatorWrapper>; // do not track this data, it won't be deallocated before shutdown
+  const AncestorArray* volatile m_pAncestors = nullptr;
+
   ezArrayPtr<ezMessageSenderInfo> m_MessageSenders;
 
 private:
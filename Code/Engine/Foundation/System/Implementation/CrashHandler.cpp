@@ -1,6 +1,7 @@
 #include <FoundationPCH.h>
 
 #include <Foundation/IO/OSFile.h>
+#include <Foundation/Logging/AsyncWriter.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/System/CrashHandler.h>
 #include <Foundation/System/MiniDumpUtils.h>
@@ -108,6 +109,9 @@ void ezCrashHandler_WriteMiniDump::HandleCrash(void* pOsSpecificData)
   {
     ezLog::Error("Application crashed. Crash-dump written to '{}'.", m_sDumpFilePath);
   }
+
+  // messages that are still queued would be lost once the process terminates
+  ezLogWriter::Async::FlushAll();
 }
 
 //////////////////////////////////////////////////////////////////////////
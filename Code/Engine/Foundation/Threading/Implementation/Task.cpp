@@ -9,6 +9,7 @@ ezTask::~ezTask() = default;
 void ezTask::Reset()
 {
   m_iRemainingRuns = (int)ezMath::Max(1u, m_uiMultiplicity);
+  m_iUnclaimedRuns = 0;
   m_bCancelExecution = false;
   m_bTaskIsScheduled = false;
   m_bUsesMultiplicity = m_uiMultiplicity > 0;
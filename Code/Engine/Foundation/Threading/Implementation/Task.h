@@ -87,6 +87,10 @@ private:
   /// \brief Decremented when a task is finished, set to zero when canceled.
   ezAtomicInteger32 m_iRemainingRuns;
 
+  /// \brief How many invocations of this task sit in work-stealing queues and have not been claimed for execution yet. Set to zero when
+  /// canceled, in which case the remaining queue entries are discarded without running the task.
+  ezAtomicInteger32 m_iUnclaimedRuns;
+
   /// \brief Set to true when the task is SUPPOSED to cancel. Whether the task is able to do that, depends on its implementation.
   bool m_bCancelExecution = false;
 
@@ -36,8 +36,14 @@ void ezTaskSystem::Startup()
   s_ThreadState = EZ_DEFAULT_NEW(ezTaskSystemThreadState);
   s_State = EZ_DEFAULT_NEW(ezTaskSystemState);
 
+  // the main thread plus the maximum number of short task workers (see SetWorkerThreadCount())
+  s_ThreadState->m_LocalQueues.SetCount(1 + 1024);
+  CreateLocalQueues(0);
+
   tl_TaskWorkerInfo.m_WorkerType = ezWorkerThreadType::MainThread;
   tl_TaskWorkerInfo.m_iWorkerIndex = 0;
+  tl_TaskWorkerInfo.m_pLocalQueues = s_ThreadState->m_LocalQueues[0].Borrow();
+  tl_TaskWorkerInfo.m_uiLocalQueuesIndex = 0;
 
   // initialize with the default number of worker threads
   SetWorkerThreadCount();
@@ -47,6 +53,8 @@ void ezTaskSystem::Shutdown()
 {
   StopWorkerThreads();
 
+  tl_TaskWorkerInfo.m_pLocalQueues = nullptr;
+
   s_State.Clear();
   s_ThreadState.Clear();
 }
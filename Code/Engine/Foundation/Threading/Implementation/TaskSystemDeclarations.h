@@ -12,6 +12,7 @@ class ezTaskGroup;
 class ezTaskWorkerThread;
 class ezTaskSystemState;
 class ezTaskSystemThreadState;
+struct ezTaskWorkerQueues;
 class ezDGMLGraph;
 class ezAllocatorBase;
 
@@ -58,10 +59,10 @@ struct ezTaskPriority
     LongRunningHighPriority,  ///< Tasks that might take a while, but should be preferred over 'LongRunning' tasks. Use this priority only
                               ///< rarely, otherwise 'LongRunning' tasks might never get executed.
     LongRunning,              ///< Use this priority for tasks that might run for a while.
-    FileAccessHighPriority,   ///< For tasks that require file access (e.g. resource loading). They run on one dedicated thread, such that
-                              ///< file accesses are done sequentially and never in parallel.
-    FileAccess,               ///< For tasks that require file access (e.g. resource loading). They run on one dedicated thread, such that file accesses
-                              ///< are done sequentially and never in parallel.
+    FileAccessHighPriority,   ///< For tasks that require file access (e.g. resource loading). They run on dedicated threads, by default only
+                              ///< one, such that file accesses are done sequentially and never in parallel.
+    FileAccess,               ///< For tasks that require file access (e.g. resource loading). They run on dedicated threads, by default only
+                              ///< one, such that file accesses are done sequentially and never in parallel.
     ThisFrameMainThread,      ///< Tasks that need to be executed this frame, but in the main thread. This is mostly intended for resource
                               ///< creation.
     SomeFrameMainThread,      ///< Tasks that have no hard deadline but need to be executed in the main thread. This is mostly intended for
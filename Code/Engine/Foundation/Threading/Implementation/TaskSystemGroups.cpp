@@ -161,22 +161,50 @@ void ezTaskSystem::ScheduleGroupTasks(ezTaskGroup* pGroup, bool bHighPriority)
     pGroup->m_iNumRemainingTasks = iRemainingTasks;
 
 
+    // 'this frame' tasks that are started from the main thread or a short task worker go into that thread's work-stealing queue
+    // other threads take them from there without going through the global lock
+    ezTaskWorkStealingQueue* pLocalQueue = nullptr;
+    if (tl_TaskWorkerInfo.m_pLocalQueues != nullptr && ezTaskWorkerQueues::IsLocalQueuePriority(pGroup->m_Priority))
+    {
+      pLocalQueue = &tl_TaskWorkerInfo.m_pLocalQueues->m_Queues[pGroup->m_Priority];
+    }
+
     for (ezUInt32 task = 0; task < pGroup->m_Tasks.GetCount(); ++task)
     {
       auto& pTask = pGroup->m_Tasks[task];
+      pTask->m_bTaskIsScheduled = true;
 
       for (ezUInt32 mult = 0; mult < ezMath::Max(1u, pTask->m_uiMultiplicity); ++mult)
       {
+        if (pLocalQueue != nullptr)
+        {
+          ezTaskWorkStealingQueue::Entry entry;
+          entry.m_pTask = &pTask;
+          entry.m_pBelongsToGroup = pGroup;
+          entry.m_uiInvocation = mult;
+          entry.m_NestingMode = pTask->m_NestingMode;
+
+          // has to be counted before the entry becomes visible to other threads
+          pTask->m_iUnclaimedRuns.Increment();
+
+          if (pLocalQueue->Push(entry))
+            continue;
+
+          // the queue is full, fall back to the shared list
+          pTask->m_iUnclaimedRuns.Decrement();
+        }
+
         TaskData td;
         td.m_pBelongsToGroup = pGroup;
         td.m_pTask = pTask;
-        td.m_pTask->m_bTaskIsScheduled = true;
         td.m_uiInvocation = mult;
 
         if (bHighPriority)
           s_State->m_Tasks[pGroup->m_Priority].PushFront(td);
         else
           s_State->m_Tasks[pGroup->m_Priority].PushBack(td);
+
+        s_State->m_iNumSharedTasks[pGroup->m_Priority].Increment();
       }
     }
 
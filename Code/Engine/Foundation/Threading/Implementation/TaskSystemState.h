@@ -1,7 +1,19 @@
 #pragma once
 
+#include <Foundation/Threading/Implementation/TaskWorkStealingQueue.h>
 #include <Foundation/Threading/TaskSystem.h>
 
+/// \internal The work-stealing queues of one thread that executes short tasks.
+///
+/// There is one queue for each of the 'this frame' priorities (EarlyThisFrame to LateThisFrame), so that idle threads
+/// can still pick tasks strictly by priority.
+struct ezTaskWorkerQueues
+{
+  static bool IsLocalQueuePriority(ezUInt32 uiPriority) { return uiPriority <= ezTaskPriority::LateThisFrame; }
+
+  ezTaskWorkStealingQueue m_Queues[ezTaskPriority::LateThisFrame + 1];
+};
+
 class ezTaskSystemThreadState
 {
 private:
@@ -16,6 +28,15 @@ private:
 
   // the maximum number of worker threads that should be non-idle (and not blocked) at any time
   ezUInt32 m_uiMaxWorkersToUse[ezWorkerThreadType::ENUM_COUNT] = {};
+
+  // The work-stealing queues of all threads that execute short tasks.
+  // Index 0 belongs to the main thread, index N + 1 to short task worker N.
+  // The array is sized once at startup and queues are never deallocated while the task system is running,
+  // such that queued tasks stay reachable for other threads, even when their owner has been shut down.
+  ezDynamicArray<ezUniquePtr<ezTaskWorkerQueues>> m_LocalQueues;
+
+  // the number of allocated (non-null) entries in m_LocalQueues
+  ezAtomicInteger32 m_iNumLocalQueues;
 };
 
 class ezTaskSystemState
@@ -29,6 +50,9 @@ private:
   // The deque can grow without relocating existing data, therefore the ezTaskGroupID's can store pointers directly to the data
   ezDeque<ezTaskGroup> m_TaskGroups;
 
-  // The lists of all scheduled tasks, for each priority.
+  // The lists of all scheduled tasks, for each priority, that are not in any of the work-stealing queues.
   ezList<ezTaskSystem::TaskData> m_Tasks[ezTaskPriority::ENUM_COUNT];
+
+  // The number of tasks in m_Tasks, readable without holding the task system mutex, so that empty lists can be skipped without locking.
+  ezAtomicInteger32 m_iNumSharedTasks[ezTaskPriority::ENUM_COUNT];
 };
@@ -86,29 +86,132 @@ ezTaskSystem::TaskData ezTaskSystem::GetNextTask(ezTaskPriority::Enum FirstPrior
   EZ_ASSERT_DEV(FirstPriority >= ezTaskPriority::EarlyThisFrame && LastPriority < ezTaskPriority::ENUM_COUNT, "Priority Range is invalid: {0} to {1}",
     FirstPriority, LastPriority);
 
-  EZ_LOCK(s_TaskSystemMutex);
-
-  // go through all the task lists that this thread is willing to work on
-  for (ezUInt32 prio = FirstPriority; prio <= (ezUInt32)LastPriority; ++prio)
+  while (true)
   {
-    for (auto it = s_State->m_Tasks[prio].GetIterator(); it.IsValid(); ++it)
+    // go through all the task lists that this thread is willing to work on
+    for (ezUInt32 prio = FirstPriority; prio <= (ezUInt32)LastPriority; ++prio)
     {
-      if (!bOnlyTasksThatNeverWait || (it->m_pTask->m_NestingMode == ezTaskNesting::Never) || it->m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup)
-      {
-        TaskData td = *it;
+      TaskData td;
 
-        s_State->m_Tasks[prio].Remove(it);
+      // 'this frame' tasks are mostly found in the work-stealing queues, which do not require the global lock
+      if (ezTaskWorkerQueues::IsLocalQueuePriority(prio) && TryGetQueuedTask(prio, bOnlyTasksThatNeverWait, WaitingForGroup, td))
         return td;
+
+      if (s_State->m_iNumSharedTasks[prio] == 0)
+        continue;
+
+      EZ_LOCK(s_TaskSystemMutex);
+
+      for (auto it = s_State->m_Tasks[prio].GetIterator(); it.IsValid(); ++it)
+      {
+        if (!bOnlyTasksThatNeverWait || (it->m_pTask->m_NestingMode == ezTaskNesting::Never) || it->m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup)
+        {
+          td = *it;
+
+          s_State->m_Tasks[prio].Remove(it);
+          s_State->m_iNumSharedTasks[prio].Decrement();
+          return td;
+        }
       }
     }
+
+    if (pWorkerState == nullptr)
+      return TaskData();
+
+    EZ_VERIFY(pWorkerState->Set((int)ezTaskWorkerState::Idle) == (int)ezTaskWorkerState::Active, "Corrupt Worker State");
+
+    // tasks are added to the work-stealing queues without holding the global lock
+    // so a task may have been added after we looked at the queues, but before this thread became idle
+    // in that case the scheduling thread may have considered this thread as active and not woken anybody up
+    if (!HasScheduledTasks(FirstPriority, LastPriority))
+      return TaskData();
+
+    if (pWorkerState->CompareAndSwap((int)ezTaskWorkerState::Active, (int)ezTaskWorkerState::Idle) != (int)ezTaskWorkerState::Idle)
+    {
+      // someone else woke this thread up in the meantime, the wake up signal is raised and the thread will continue right away
+      return TaskData();
+    }
+  }
+}
+
+bool ezTaskSystem::TryGetQueuedTask(ezUInt32 uiPriority, bool bOnlyTasksThatNeverWait, const ezTaskGroupID& WaitingForGroup, TaskData& out_TaskData)
+{
+  ezTaskWorkStealingQueue::Entry entry;
+
+  // Returns true, if the entry was claimed for execution.
+  // Otherwise the task was canceled while it was queued and the entry is discarded.
+  auto ClaimEntry = [&]() -> bool {
+    out_TaskData.m_pTask = *entry.m_pTask;
+    out_TaskData.m_pBelongsToGroup = entry.m_pBelongsToGroup;
+    out_TaskData.m_uiInvocation = entry.m_uiInvocation;
+
+    ezAtomicInteger32& iUnclaimed = out_TaskData.m_pTask->m_iUnclaimedRuns;
+
+    for (ezInt32 i = iUnclaimed; i > 0; i = iUnclaimed)
+    {
+      if (iUnclaimed.TestAndSet(i, i - 1))
+        return true;
+    }
+
+    // the task was canceled, count this entry as finished, without executing it
+    out_TaskData.m_pTask->m_iRemainingRuns.Decrement();
+    TaskHasFinished(out_TaskData.m_pTask, out_TaskData.m_pBelongsToGroup);
+    out_TaskData = TaskData();
+    return false;
+  };
+
+  // prefer the most recently added tasks of this thread, their data is most likely still in the cache
+  if (ezTaskWorkerQueues* pOwnQueues = tl_TaskWorkerInfo.m_pLocalQueues)
+  {
+    while (pOwnQueues->m_Queues[uiPriority].Pop(entry, bOnlyTasksThatNeverWait, WaitingForGroup.m_pTaskGroup))
+    {
+      if (ClaimEntry())
+        return true;
+    }
   }
 
-  if (pWorkerState)
+  // otherwise steal the oldest task from another thread
+  // every thread starts looking at a different queue, to distribute the contention
+  const ezUInt32 uiNumQueues = s_ThreadState->m_iNumLocalQueues;
+  const ezUInt32 uiFirstQueue = tl_TaskWorkerInfo.m_uiLocalQueuesIndex + 1;
+
+  for (ezUInt32 i = 0; i < uiNumQueues; ++i)
   {
-    EZ_VERIFY(pWorkerState->Set((int)ezTaskWorkerState::Idle) == (int)ezTaskWorkerState::Active, "Corrupt Worker State");
+    ezTaskWorkerQueues* pVictim = s_ThreadState->m_LocalQueues[(uiFirstQueue + i) % uiNumQueues].Borrow();
+
+    if (pVictim == tl_TaskWorkerInfo.m_pLocalQueues)
+      continue;
+
+    while (pVictim->m_Queues[uiPriority].Steal(entry, bOnlyTasksThatNeverWait, WaitingForGroup.m_pTaskGroup))
+    {
+      if (ClaimEntry())
+        return true;
+    }
   }
 
-  return TaskData();
+  return false;
+}
+
+bool ezTaskSystem::HasScheduledTasks(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority)
+{
+  const ezUInt32 uiNumQueues = s_ThreadState->m_iNumLocalQueues;
+
+  for (ezUInt32 prio = FirstPriority; prio <= (ezUInt32)LastPriority; ++prio)
+  {
+    if (s_State->m_iNumSharedTasks[prio] > 0)
+      return true;
+
+    if (!ezTaskWorkerQueues::IsLocalQueuePriority(prio))
+      continue;
+
+    for (ezUInt32 i = 0; i < uiNumQueues; ++i)
+    {
+      if (!s_ThreadState->m_LocalQueues[i]->m_Queues[prio].IsEmpty())
+        return true;
+    }
+  }
+
+  return false;
 }
 
 bool ezTaskSystem::ExecuteTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
@@ -176,13 +279,16 @@ ezResult ezTaskSystem::CancelTask(const ezSharedPtr<ezTask>& pTask, ezOnTaskRunn
         {
           if (it->m_pTask == pTask)
           {
+            ezTaskGroup* pBelongsToGroup = it->m_pBelongsToGroup;
+
             s_State->m_Tasks[i].Remove(it);
+            s_State->m_iNumSharedTasks[i].Decrement();
 
             // we set the task to finished, even though it was not executed
             pTask->m_iRemainingRuns = 0;
 
             // tell the system that one task of that group is 'finished', to ensure its dependencies will get scheduled
-            TaskHasFinished(it->m_pTask, it->m_pBelongsToGroup);
+            TaskHasFinished(pTask, pBelongsToGroup);
             return EZ_SUCCESS;
           }
 
@@ -190,6 +296,13 @@ ezResult ezTaskSystem::CancelTask(const ezSharedPtr<ezTask>& pTask, ezOnTaskRunn
         }
       }
     }
+
+    // tasks cannot be removed from the work-stealing queues
+    // but as long as no thread has claimed them for execution yet, they will be discarded once they are taken out of a queue
+    if (pTask->m_iUnclaimedRuns.Set(0) > 0)
+    {
+      return EZ_SUCCESS;
+    }
   }
 
   // if we made it here, the task was already running
@@ -217,6 +330,12 @@ bool ezTaskSystem::HelpExecutingTasks(const ezTaskGroupID& WaitingForGroup)
 
 void ezTaskSystem::ReprioritizeFrameTasks()
 {
+  auto MoveSharedTaskCount = [](ezUInt32 uiFromPriority, ezUInt32 uiToPriority) {
+    // add to the target before clearing the source, so that idle checks never see zero tasks in between
+    s_State->m_iNumSharedTasks[uiToPriority].Add(s_State->m_iNumSharedTasks[uiFromPriority]);
+    s_State->m_iNumSharedTasks[uiFromPriority] = 0;
+  };
+
   // There should usually be no 'this frame tasks' left at this time
   // however, while we waited to enter the lock, such tasks might have appeared
   // In this case we move them into the highest-priority 'this frame' queue, to ensure they will be executed asap
@@ -233,6 +352,7 @@ void ezTaskSystem::ReprioritizeFrameTasks()
     }
 
     // remove the tasks from their current queue
+    MoveSharedTaskCount(i, ezTaskPriority::EarlyThisFrame);
     s_State->m_Tasks[i].Clear();
   }
 
@@ -249,6 +369,7 @@ void ezTaskSystem::ReprioritizeFrameTasks()
     }
 
     // remove the tasks from their current queue
+    MoveSharedTaskCount(i, i - 3);
     s_State->m_Tasks[i].Clear();
   }
 
@@ -266,6 +387,7 @@ void ezTaskSystem::ReprioritizeFrameTasks()
     }
 
     // remove the tasks from their current queue
+    MoveSharedTaskCount(i, i - 1);
     s_State->m_Tasks[i].Clear();
   }
 }
@@ -16,7 +16,7 @@ ezUInt32 ezTaskSystem::GetNumAllocatedWorkerThreads(ezWorkerThreadType::Enum typ
   return s_ThreadState->m_iAllocatedWorkers[type];
 }
 
-void ezTaskSystem::SetWorkerThreadCount(ezInt32 iShortTasks, ezInt32 iLongTasks)
+void ezTaskSystem::SetWorkerThreadCount(ezInt32 iShortTasks, ezInt32 iLongTasks, ezInt32 iFileAccessTasks)
 {
   ezSystemInformation info = ezSystemInformation::Get();
 
@@ -33,15 +33,17 @@ void ezTaskSystem::SetWorkerThreadCount(ezInt32 iShortTasks, ezInt32 iLongTasks)
   if (iLongTasks <= 0)
     iLongTasks = ezMath::Clamp<ezInt32>(iCpuCores - 2, 2, 8);
 
-  // plus there is always one additional 'file access' thread
+  // plus one 'file access' thread, unless requested otherwise
   // and the main thread, of course
 
   ezUInt32 uiShortTasks = static_cast<ezUInt32>(ezMath::Max<ezInt32>(iShortTasks, 1));
   ezUInt32 uiLongTasks = static_cast<ezUInt32>(ezMath::Max<ezInt32>(iLongTasks, 1));
+  ezUInt32 uiFileAccessTasks = static_cast<ezUInt32>(ezMath::Clamp<ezInt32>(iFileAccessTasks, 1, 64));
 
   // if nothing has changed, do nothing
   if (s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::ShortTasks] == uiShortTasks &&
-      s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::LongTasks] == uiLongTasks)
+      s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::LongTasks] == uiLongTasks &&
+      s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::FileAccess] == uiFileAccessTasks)
     return;
 
   StopWorkerThreads();
@@ -53,7 +55,7 @@ void ezTaskSystem::SetWorkerThreadCount(ezInt32 iShortTasks, ezInt32 iLongTasks)
 
   s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::ShortTasks] = uiShortTasks;
   s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::LongTasks] = uiLongTasks;
-  s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::FileAccess] = 1;
+  s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::FileAccess] = uiFileAccessTasks;
 
   AllocateThreads(ezWorkerThreadType::ShortTasks, s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::ShortTasks]);
   AllocateThreads(ezWorkerThreadType::LongTasks, s_ThreadState->m_uiMaxWorkersToUse[ezWorkerThreadType::LongTasks]);
@@ -117,6 +119,11 @@ void ezTaskSystem::AllocateThreads(ezWorkerThreadType::Enum type, ezUInt32 uiAdd
 
     for (ezUInt32 i = 0; i < uiAddThreads; ++i)
     {
+      if (type == ezWorkerThreadType::ShortTasks)
+      {
+        CreateLocalQueues(uiNextThreadIdx + 1);
+      }
+
       s_ThreadState->m_Workers[type][uiNextThreadIdx] = EZ_DEFAULT_NEW(ezTaskWorkerThread, (ezWorkerThreadType::Enum)type, uiNextThreadIdx);
       s_ThreadState->m_Workers[type][uiNextThreadIdx]->Start();
 
@@ -180,6 +187,23 @@ void ezTaskSystem::WakeUpThreads(ezWorkerThreadType::Enum type, ezUInt32 uiNumTh
   }
 }
 
+void ezTaskSystem::CreateLocalQueues(ezUInt32 uiQueuesIndex)
+{
+  EZ_ASSERT_ALWAYS(uiQueuesIndex < s_ThreadState->m_LocalQueues.GetCount(), "Max number of work-stealing queues ({}) exceeded.",
+    s_ThreadState->m_LocalQueues.GetCount());
+
+  // queues of previously shut down workers are reused, they may even still contain tasks
+  if (s_ThreadState->m_LocalQueues[uiQueuesIndex] != nullptr)
+    return;
+
+  EZ_ASSERT_DEBUG(uiQueuesIndex == (ezUInt32)s_ThreadState->m_iNumLocalQueues, "Work-stealing queues must be allocated in order.");
+
+  s_ThreadState->m_LocalQueues[uiQueuesIndex] = EZ_DEFAULT_NEW(ezTaskWorkerQueues);
+
+  // let others access the new queues now
+  s_ThreadState->m_iNumLocalQueues.Set(uiQueuesIndex + 1);
+}
+
 ezWorkerThreadType::Enum ezTaskSystem::GetCurrentThreadWorkerType()
 {
   return tl_TaskWorkerInfo.m_WorkerType;
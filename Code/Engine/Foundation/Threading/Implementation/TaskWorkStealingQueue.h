@@ -0,0 +1,125 @@
+#pragma once
+
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Implementation/TaskSystemDeclarations.h>
+
+/// \internal A bounded, lock-free work-stealing deque (Chase-Lev) of scheduled task invocations.
+///
+/// Only the owning thread may call Push() and Pop(), which operate on the 'bottom' end of the deque.
+/// All other threads may call Steal() to take entries from the 'top' end.
+/// The deque never grows. If it is full, Push() fails and the caller has to put the task into the shared task lists instead.
+class ezTaskWorkStealingQueue
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezTaskWorkStealingQueue);
+
+public:
+  enum
+  {
+    Capacity = 512 // must be a power of two
+  };
+
+  struct Entry
+  {
+    // points into ezTaskGroup::m_Tasks, which is not modified while any of the group's tasks are scheduled
+    const ezSharedPtr<ezTask>* m_pTask = nullptr;
+    ezTaskGroup* m_pBelongsToGroup = nullptr;
+    ezUInt32 m_uiInvocation = 0;
+
+    // copied from the task, thieves must not dereference m_pTask before they own the entry
+    ezTaskNesting m_NestingMode = ezTaskNesting::Maybe;
+  };
+
+  ezTaskWorkStealingQueue() = default;
+
+  /// \brief Adds an entry at the bottom. Must only be called by the owning thread. Returns false, if the deque is full.
+  bool Push(const Entry& entry)
+  {
+    const ezInt64 b = m_iBottom;
+    const ezInt64 t = m_iTop;
+
+    if (b - t >= Capacity)
+      return false;
+
+    m_Entries[b & (Capacity - 1)] = entry;
+
+    // publishes the entry, Set() is a full memory barrier
+    m_iBottom.Set(b + 1);
+    return true;
+  }
+
+  /// \brief Takes the most recently pushed entry. Must only be called by the owning thread.
+  ///
+  /// If \a bOnlyTasksThatNeverWait is set, only entries whose task never waits, or that belong to \a pWaitingForGroup, are accepted.
+  bool Pop(Entry& out_Entry, bool bOnlyTasksThatNeverWait, const ezTaskGroup* pWaitingForGroup)
+  {
+    ezInt64 b = m_iBottom;
+
+    if (m_iTop >= b)
+      return false;
+
+    // only the owner modifies the bottom end, so the entry can be inspected before it is taken
+    if (!IsAccepted(m_Entries[(b - 1) & (Capacity - 1)], bOnlyTasksThatNeverWait, pWaitingForGroup))
+      return false;
+
+    b = b - 1;
+    m_iBottom.Set(b);
+
+    const ezInt64 t = m_iTop;
+
+    if (t > b)
+    {
+      // a thief took the last entry in the meantime
+      m_iBottom.Set(b + 1);
+      return false;
+    }
+
+    out_Entry = m_Entries[b & (Capacity - 1)];
+
+    if (t < b)
+      return true;
+
+    // this is the last entry, race against the thieves for it
+    const bool bWon = m_iTop.TestAndSet(t, t + 1);
+    m_iBottom.Set(b + 1);
+    return bWon;
+  }
+
+  /// \brief Takes the oldest entry. May be called by any thread.
+  ///
+  /// Returns false if the deque is empty, the oldest entry is not accepted (see Pop()) or another thread won the race for it.
+  bool Steal(Entry& out_Entry, bool bOnlyTasksThatNeverWait, const ezTaskGroup* pWaitingForGroup)
+  {
+    const ezInt64 t = m_iTop;
+    const ezInt64 b = m_iBottom;
+
+    if (t >= b)
+      return false;
+
+    const Entry entry = m_Entries[t & (Capacity - 1)];
+
+    if (!IsAccepted(entry, bOnlyTasksThatNeverWait, pWaitingForGroup))
+      return false;
+
+    if (!m_iTop.TestAndSet(t, t + 1))
+      return false;
+
+    out_Entry = entry;
+    return true;
+  }
+
+  /// \brief Returns whether there are currently any entries in the deque. Only a snapshot, the state may change at any time.
+  bool IsEmpty() const { return m_iTop >= m_iBottom; }
+
+private:
+  EZ_ALWAYS_INLINE static bool IsAccepted(const Entry& entry, bool bOnlyTasksThatNeverWait, const ezTaskGroup* pWaitingForGroup)
+  {
+    return !bOnlyTasksThatNeverWait || (entry.m_NestingMode == ezTaskNesting::Never) || entry.m_pBelongsToGroup == pWaitingForGroup;
+  }
+
+  // top and bottom are modified by different threads, keep them on separate cache lines
+  ezAtomicInteger64 m_iTop;
+  ezUInt8 m_Padding[64 - sizeof(ezAtomicInteger64)];
+  ezAtomicInteger64 m_iBottom;
+
+  Entry m_Entries[Capacity];
+};
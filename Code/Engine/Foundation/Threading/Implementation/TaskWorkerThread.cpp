@@ -49,6 +49,12 @@ ezUInt32 ezTaskWorkerThread::Run()
   tl_TaskWorkerInfo.m_iWorkerIndex = m_uiWorkerThreadNumber;
   tl_TaskWorkerInfo.m_pWorkerState = &m_WorkerState;
 
+  if (m_WorkerType == ezWorkerThreadType::ShortTasks)
+  {
+    tl_TaskWorkerInfo.m_uiLocalQueuesIndex = m_uiWorkerThreadNumber + 1;
+    tl_TaskWorkerInfo.m_pLocalQueues = ezTaskSystem::s_ThreadState->m_LocalQueues[tl_TaskWorkerInfo.m_uiLocalQueuesIndex].Borrow();
+  }
+
   const bool bIsReserve = m_uiWorkerThreadNumber >= ezTaskSystem::s_ThreadState->m_uiMaxWorkersToUse[m_WorkerType];
 
   ezTaskPriority::Enum FirstPriority;
@@ -85,6 +85,8 @@ struct ezTaskWorkerInfo
   bool m_bAllowNestedTasks = true;
   const char* m_szTaskName = nullptr;
   ezAtomicInteger32* m_pWorkerState = nullptr;
+  ezTaskWorkerQueues* m_pLocalQueues = nullptr; ///< Only set on the main thread and on short task workers.
+  ezUInt32 m_uiLocalQueuesIndex = 0;             ///< Index into ezTaskSystemThreadState::m_LocalQueues, used as the start for stealing.
 };
 
 extern thread_local ezTaskWorkerInfo tl_TaskWorkerInfo;
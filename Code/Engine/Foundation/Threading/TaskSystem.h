@@ -86,6 +86,12 @@ private:
   static TaskData GetNextTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
     const ezTaskGroupID& WaitingForGroup, ezAtomicInteger32* pWorkerState);
 
+  /// \brief Takes a task of priority \a uiPriority out of the calling thread's own work-stealing queue or steals one from another thread.
+  static bool TryGetQueuedTask(ezUInt32 uiPriority, bool bOnlyTasksThatNeverWait, const ezTaskGroupID& WaitingForGroup, TaskData& out_TaskData);
+
+  /// \brief Returns whether any task of priority between \a FirstPriority and \a LastPriority (inclusive) is currently scheduled.
+  static bool HasScheduledTasks(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority);
+
   /// \brief Executes some task of priority between \a FirstPriority and \a LastPriority (inclusive). Returns true, if any such task was available.
   static bool ExecuteTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
     const ezTaskGroupID& WaitingForGroup, ezAtomicInteger32* pWorkerState);
@@ -185,7 +191,9 @@ public:
   /// \brief Sets the number of threads to use for the different task categories.
   ///
   /// \a uiShortTasks and \a uiLongTasks must be at least 1 and should not exceed the number of available CPU cores.
-  /// There will always be exactly one additional thread for file access tasks (ezTaskPriority::FileAccess).
+  /// Additionally there are \a iFileAccessTasks threads for file access tasks (ezTaskPriority::FileAccess). By default this is exactly
+  /// one thread, so that file accesses happen sequentially. Storage that handles concurrent reads well (SSDs, network drives) can benefit
+  /// from more, e.g. the ezResourceManager loads as many resources in parallel as there are file access threads.
   ///
   /// If \a uiShortTasks or \a uiLongTasks is smaller than 1, a default number of threads will be used for that type of work.
   /// This number of threads depends on the number of available CPU cores.
@@ -193,7 +201,7 @@ public:
   /// this default configuration.
   /// Unless you have a good idea how to set up the number of worker threads to make good use of the available cores,
   /// it is a good idea to just use the default settings.
-  static void SetWorkerThreadCount(ezInt32 iShortTasks = -1, ezInt32 iLongTasks = -1); // [tested]
+  static void SetWorkerThreadCount(ezInt32 iShortTasks = -1, ezInt32 iLongTasks = -1, ezInt32 iFileAccessTasks = -1); // [tested]
 
   /// \brief Returns the maximum number of threads that should work on the given type of task at the same time.
   static ezUInt32 GetWorkerThreadCount(ezWorkerThreadType::Enum type);
@@ -223,6 +231,9 @@ private:
   /// \brief Wakes up or allocates up to \a uiNumThreads, unless enough threads are currently active and not blocked
   static void WakeUpThreads(ezWorkerThreadType::Enum type, ezUInt32 uiNumThreads);
 
+  /// \brief Allocates the work-stealing queues at the given index of ezTaskSystemThreadState::m_LocalQueues, unless they exist already.
+  static void CreateLocalQueues(ezUInt32 uiQueuesIndex);
+
   /// \brief Shuts down all worker threads. Does NOT finish the remaining tasks that were not started yet. Does not clear them either, though.
   static void StopWorkerThreads();
 
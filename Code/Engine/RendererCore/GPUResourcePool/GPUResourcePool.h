@@ -4,6 +4,7 @@
 #include <Foundation/Containers/Set.h>
 #include <Foundation/Threading/Mutex.h>
 #include <RendererCore/RendererCoreDLL.h>
+#include <RendererFoundation/Descriptors/Descriptors.h>
 #include <RendererFoundation/Resources/ResourceFormats.h>
 
 /// \brief This class serves as a pool for GPU related resources (e.g. buffers and textures required for rendering).
@@ -16,6 +17,10 @@ public:
 
   /// \brief Returns a render target handle for the given texture description
   /// Note that you should return the handle to the pool and never destroy it directly with the device.
+  ///
+  /// Render targets are shared between all descriptions that only differ in their usage flags (shader resource view, UAV, etc.).
+  /// The returned texture supports at least the requested usages, new textures are created with all usages that have been requested
+  /// for such a description so far. That way render targets that are used at different times can alias the same texture.
   ezGALTextureHandle GetRenderTarget(const ezGALTextureCreationDescription& TextureDesc);
 
   /// \brief Convenience functions which creates a texture description fit for a 2d render target without a mip chains.
@@ -34,6 +39,11 @@ public:
   void ReturnBuffer(ezGALBufferHandle hBuffer);
 
 
+  /// \brief Returns a hash of the given description that ignores the usage flags.
+  /// Render targets with the same aliasing hash are served from the same textures.
+  static ezUInt32 CalculateAliasingHash(const ezGALTextureCreationDescription& TextureDesc);
+
+
   /// \brief Tries to free resources which are currently in the pool.
   /// Triggered automatically due to allocation number / size thresholds but can be triggered manually (e.g. after editor window resize)
   void RunGC();
@@ -51,8 +61,9 @@ protected:
   ezUInt32 m_uiNumAllocationsThresholdForGC;
   ezUInt32 m_uiNumAllocationsSinceLastGC;
 
-  ezMap<ezUInt32, ezDynamicArray<ezGALTextureHandle>> m_AvailableTextures;
+  ezMap<ezUInt32, ezDynamicArray<ezGALTextureHandle>> m_AvailableTextures; ///< Key is the aliasing hash
   ezSet<ezGALTextureHandle> m_TexturesInUse;
+  ezMap<ezUInt32, ezGALTextureCreationDescription> m_AliasedTextureDescs; ///< All usage flags requested so far per aliasing hash, RunGC() removes hashes without live textures
 
   ezMap<ezUInt32, ezDynamicArray<ezGALBufferHandle>> m_AvailableBuffers;
   ezSet<ezGALBufferHandle> m_BuffersInUse;
@@ -12,6 +12,24 @@
 
 ezGPUResourcePool* ezGPUResourcePool::s_pDefaultInstance = nullptr;
 
+namespace
+{
+  bool SupportsUsages(const ezGALTextureCreationDescription& desc, const ezGALTextureCreationDescription& requestedDesc)
+  {
+    return (desc.m_bAllowShaderResourceView || !requestedDesc.m_bAllowShaderResourceView) && (desc.m_bAllowUAV || !requestedDesc.m_bAllowUAV) &&
+           (desc.m_bCreateRenderTarget || !requestedDesc.m_bCreateRenderTarget) &&
+           (desc.m_bAllowDynamicMipGeneration || !requestedDesc.m_bAllowDynamicMipGeneration);
+  }
+
+  void AddUsages(ezGALTextureCreationDescription& desc, const ezGALTextureCreationDescription& requestedDesc)
+  {
+    desc.m_bAllowShaderResourceView |= requestedDesc.m_bAllowShaderResourceView;
+    desc.m_bAllowUAV |= requestedDesc.m_bAllowUAV;
+    desc.m_bCreateRenderTarget |= requestedDesc.m_bCreateRenderTarget;
+    desc.m_bAllowDynamicMipGeneration |= requestedDesc.m_bAllowDynamicMipGeneration;
+  }
+} // namespace
+
 
 ezGPUResourcePool::ezGPUResourcePool()
   : m_uiMemoryThresholdForGC(256 * 1024 * 1024)
@@ -44,19 +62,24 @@ ezGALTextureHandle ezGPUResourcePool::GetRenderTarget(const ezGALTextureCreation
     return ezGALTextureHandle();
   }
 
-  const ezUInt32 uiTextureDescHash = TextureDesc.CalculateHash();
+  const ezUInt32 uiAliasingHash = CalculateAliasingHash(TextureDesc);
 
   // Check if there is a fitting texture available
-  auto it = m_AvailableTextures.Find(uiTextureDescHash);
+  auto it = m_AvailableTextures.Find(uiAliasingHash);
   if (it.IsValid())
   {
     ezDynamicArray<ezGALTextureHandle>& textures = it.Value();
-    if (!textures.IsEmpty())
+    for (ezUInt32 i = 0; i < textures.GetCount(); ++i)
     {
-      ezGALTextureHandle hTexture = textures[0];
-      textures.RemoveAtAndSwap(0);
+      ezGALTextureHandle hTexture = textures[i];
+
+      const ezGALTexture* pTexture = m_pDevice->GetTexture(hTexture);
+      EZ_ASSERT_DEV(pTexture != nullptr, "Invalid texture in resource pool");
+
+      if (!SupportsUsages(pTexture->GetDescription(), TextureDesc))
+        continue;
 
-      EZ_ASSERT_DEV(m_pDevice->GetTexture(hTexture) != nullptr, "Invalid texture in resource pool");
+      textures.RemoveAtAndSwap(i);
 
       m_TexturesInUse.Insert(hTexture);
 
@@ -65,10 +88,26 @@ ezGALTextureHandle ezGPUResourcePool::GetRenderTarget(const ezGALTextureCreation
   }
 
   // Since we found no matching texture we need to create a new one, but we check if we should run a GC
-  // first since we need to allocate memory now
+  // first since we need to allocate memory now. This has to happen before looking up the aliased description, the GC prunes them.
   CheckAndPotentiallyRunGC();
 
-  ezGALTextureHandle hNewTexture = m_pDevice->CreateTexture(TextureDesc);
+  // Create the texture with all usages that have been requested for this description so far, so it can be handed out for any of them later
+  bool bExisted = false;
+  ezGALTextureCreationDescription& aliasedDesc = m_AliasedTextureDescs.FindOrAdd(uiAliasingHash, &bExisted).Value();
+  if (!bExisted)
+  {
+    aliasedDesc = TextureDesc;
+  }
+  AddUsages(aliasedDesc, TextureDesc);
+
+  ezGALTextureHandle hNewTexture = m_pDevice->CreateTexture(aliasedDesc);
+
+  if (hNewTexture.IsInvalidated() && aliasedDesc.CalculateHash() != TextureDesc.CalculateHash())
+  {
+    // The combined usages are not supported for this format, don't share textures between the different usages then
+    aliasedDesc = TextureDesc;
+    hNewTexture = m_pDevice->CreateTexture(aliasedDesc);
+  }
 
   if (hNewTexture.IsInvalidated())
   {
@@ -81,7 +120,7 @@ ezGALTextureHandle ezGPUResourcePool::GetRenderTarget(const ezGALTextureCreation
   m_TexturesInUse.Insert(hNewTexture);
 
   m_uiNumAllocationsSinceLastGC++;
-  m_uiCurrentlyAllocatedMemory += m_pDevice->GetMemoryConsumptionForTexture(TextureDesc);
+  m_uiCurrentlyAllocatedMemory += m_pDevice->GetMemoryConsumptionForTexture(aliasedDesc);
 
   UpdateMemoryStats();
 
@@ -123,18 +162,29 @@ void ezGPUResourcePool::ReturnRenderTarget(ezGALTextureHandle hRenderTarget)
 
   if (const ezGALTexture* pTexture = m_pDevice->GetTexture(hRenderTarget))
   {
-    const ezUInt32 uiTextureDescHash = pTexture->GetDescription().CalculateHash();
+    const ezUInt32 uiAliasingHash = CalculateAliasingHash(pTexture->GetDescription());
 
-    auto it = m_AvailableTextures.Find(uiTextureDescHash);
+    auto it = m_AvailableTextures.Find(uiAliasingHash);
     if (!it.IsValid())
     {
-      it = m_AvailableTextures.Insert(uiTextureDescHash, ezDynamicArray<ezGALTextureHandle>());
+      it = m_AvailableTextures.Insert(uiAliasingHash, ezDynamicArray<ezGALTextureHandle>());
     }
 
     it.Value().PushBack(hRenderTarget);
   }
 }
 
+ezUInt32 ezGPUResourcePool::CalculateAliasingHash(const ezGALTextureCreationDescription& TextureDesc)
+{
+  ezGALTextureCreationDescription desc = TextureDesc;
+  desc.m_bAllowShaderResourceView = false;
+  desc.m_bAllowUAV = false;
+  desc.m_bCreateRenderTarget = false;
+  desc.m_bAllowDynamicMipGeneration = false;
+
+  return desc.CalculateHash();
+}
+
 ezGALBufferHandle ezGPUResourcePool::GetBuffer(const ezGALBufferCreationDescription& BufferDesc)
 {
   EZ_LOCK(m_Lock);
@@ -236,6 +286,30 @@ void ezGPUResourcePool::RunGC()
     m_AvailableTextures.Clear();
   }
 
+  // Forget the usages of descriptions that no texture is alive for anymore, otherwise the map would grow with every resolution change
+  {
+    ezSet<ezUInt32> aliasingHashesInUse;
+    for (auto hTexture : m_TexturesInUse)
+    {
+      if (const ezGALTexture* pTexture = m_pDevice->GetTexture(hTexture))
+      {
+        aliasingHashesInUse.Insert(CalculateAliasingHash(pTexture->GetDescription()));
+      }
+    }
+
+    for (auto it = m_AliasedTextureDescs.GetIterator(); it.IsValid();)
+    {
+      if (aliasingHashesInUse.Contains(it.Key()))
+      {
+        ++it;
+      }
+      else
+      {
+        it = m_AliasedTextureDescs.Remove(it);
+      }
+    }
+  }
+
   // Destroy all available buffers
   {
     for (auto it = m_AvailableBuffers.GetIterator(); it.IsValid(); ++it)
@@ -887,6 +887,12 @@ void ezMaterialResource::UpdateConstantBuffer(ezShaderPermutationResource* pShad
   if (pLayout == nullptr)
     return;
 
+  // The material can be applied by several render contexts at the same time
+  EZ_LOCK(m_UpdateCacheMutex);
+
+  if (!AreConstantsModified())
+    return;
+
   auto pCachedValues = GetOrUpdateCachedValues();
 
   m_iLastConstantsUpdated = m_iLastConstantsModified;
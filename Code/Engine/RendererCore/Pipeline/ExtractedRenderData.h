@@ -32,6 +32,17 @@ public:
   void AddRenderData(const ezRenderData* pRenderData, ezRenderData::Category category);
   void AddFrameData(const ezRenderData* pFrameData);
 
+  /// \brief Clears \a shard and copies the camera and view settings into it, so render data can be extracted into the shard on another
+  /// thread.
+  void PrepareShard(ezExtractedRenderData& shard) const;
+
+  /// \brief Appends the render data and frame data of a shard that was set up with PrepareShard.
+  ///
+  /// Shards are merged in the order of this call, so merging them in a fixed order gives the same result as extracting serially.
+  void MergeShard(const ezExtractedRenderData& shard);
+
+  /// \brief Sorts the render data of each category and groups it into batches. Categories are processed as separate tasks if
+  /// multi-threaded rendering is enabled.
   void SortAndBatch();
 
   void Clear();
@@ -52,8 +63,13 @@ private:
   {
     ezDynamicArray<ezRenderDataBatch> m_Batches;
     ezDynamicArray<ezRenderDataBatch::SortableRenderData> m_SortableRenderData;
+
+    // Scratch memory for the radix sort, kept around to avoid allocations every frame
+    ezDynamicArray<ezRenderDataBatch::SortableRenderData> m_SortTempData;
   };
 
+  static void SortAndBatch(DataPerCategory& dataPerCategory);
+
   ezCamera m_Camera;
   ezCamera m_LodCamera; // Temporary until we have a real LOD system
   ezViewData m_ViewData;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/RenderData.h>
 
 class EZ_RENDERERCORE_DLL ezExtractor : public ezReflectedClass
@@ -42,8 +44,8 @@ protected:
   ezHybridArray<ezHashedString, 4> m_DependsOn;
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-  mutable ezUInt32 m_uiNumCachedRenderData;
-  mutable ezUInt32 m_uiNumUncachedRenderData;
+  mutable ezAtomicInteger32 m_NumCachedRenderData;
+  mutable ezAtomicInteger32 m_NumUncachedRenderData;
 #endif
 };
 
@@ -57,6 +59,12 @@ public:
 
   virtual void Extract(
     const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& extractedRenderData) override;
+
+private:
+  void ExtractObjects(const ezView& view, ezArrayPtr<const ezGameObject* const> objects, ezExtractedRenderData& extractedRenderData) const;
+
+  // Large object lists are split into chunks that are extracted as tasks, each chunk into its own shard
+  ezDynamicArray<ezExtractedRenderData> m_ChunkShards;
 };
 
 class EZ_RENDERERCORE_DLL ezSelectedObjectsExtractor : public ezExtractor
@@ -1,7 +1,10 @@
 #include <RendererCorePCH.h>
 
+#include <Foundation/Algorithm/Sorting.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
 
 ezExtractedRenderData::ezExtractedRenderData() {}
 
@@ -19,54 +22,125 @@ void ezExtractedRenderData::AddFrameData(const ezRenderData* pFrameData)
   m_FrameData.PushBack(pFrameData);
 }
 
+void ezExtractedRenderData::PrepareShard(ezExtractedRenderData& shard) const
+{
+  shard.Clear();
+
+  shard.m_Camera = m_Camera;
+  shard.m_LodCamera = m_LodCamera;
+  shard.m_ViewData = m_ViewData;
+  shard.m_WorldTime = m_WorldTime;
+  shard.m_WorldDebugContext = m_WorldDebugContext;
+  shard.m_ViewDebugContext = m_ViewDebugContext;
+}
+
+void ezExtractedRenderData::MergeShard(const ezExtractedRenderData& shard)
+{
+  m_DataPerCategory.EnsureCount(shard.m_DataPerCategory.GetCount());
+
+  for (ezUInt32 uiCategory = 0; uiCategory < shard.m_DataPerCategory.GetCount(); ++uiCategory)
+  {
+    m_DataPerCategory[uiCategory].m_SortableRenderData.PushBackRange(shard.m_DataPerCategory[uiCategory].m_SortableRenderData);
+  }
+
+  m_FrameData.PushBackRange(shard.m_FrameData);
+}
+
 void ezExtractedRenderData::SortAndBatch()
 {
   EZ_PROFILE_SCOPE("SortAndBatch");
 
-  struct RenderDataComparer
+  // Tiny categories are not worth a task of their own
+  const ezUInt32 uiMinRenderDataForTasks = 256;
+
+  ezUInt32 uiNumRenderData = 0;
+  for (auto& dataPerCategory : m_DataPerCategory)
   {
-    EZ_FORCE_INLINE bool Less(const ezRenderDataBatch::SortableRenderData& a, const ezRenderDataBatch::SortableRenderData& b) const
+    uiNumRenderData += dataPerCategory.m_SortableRenderData.GetCount();
+  }
+
+  if (!ezRenderWorld::GetUseMultithreadedRendering() || uiNumRenderData < uiMinRenderDataForTasks)
+  {
+    for (auto& dataPerCategory : m_DataPerCategory)
     {
-      if (a.m_uiSortingKey == b.m_uiSortingKey)
+      SortAndBatch(dataPerCategory);
+    }
+
+    return;
+  }
+
+  ezParallelForParams params;
+  params.uiBinSize = 1;
+  params.nestingMode = ezTaskNesting::Maybe; // the radix sort of big categories uses tasks itself
+
+  ezTaskSystem::ParallelForIndexed(0, m_DataPerCategory.GetCount(),
+    [this](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
       {
-        return a.m_pRenderData->m_uiBatchId < b.m_pRenderData->m_uiBatchId;
+        SortAndBatch(m_DataPerCategory[i]);
       }
+    },
+    "SortAndBatchCategory", params);
+}
 
-      return a.m_uiSortingKey < b.m_uiSortingKey;
+// static
+void ezExtractedRenderData::SortAndBatch(DataPerCategory& dataPerCategory)
+{
+  struct BatchIdComparer
+  {
+    EZ_FORCE_INLINE bool Less(const ezRenderDataBatch::SortableRenderData& a, const ezRenderDataBatch::SortableRenderData& b) const
+    {
+      return a.m_pRenderData->m_uiBatchId < b.m_pRenderData->m_uiBatchId;
     }
   };
 
-  for (auto& dataPerCategory : m_DataPerCategory)
-  {
-    if (dataPerCategory.m_SortableRenderData.IsEmpty())
-      continue;
-
-    auto& data = dataPerCategory.m_SortableRenderData;
+  if (dataPerCategory.m_SortableRenderData.IsEmpty())
+    return;
 
-    // Sort
-    data.Sort(RenderDataComparer());
+  auto& data = dataPerCategory.m_SortableRenderData;
 
-    // Find batches
-    ezUInt32 uiCurrentBatchId = data[0].m_pRenderData->m_uiBatchId;
-    ezUInt32 uiCurrentBatchStartIndex = 0;
-    const ezRTTI* pCurrentBatchType = data[0].m_pRenderData->GetDynamicRTTI();
+  // Sort by sorting key. The radix sort doesn't need to dereference the render data, which a comparison based sort would do for every
+  // compare with equal keys.
+  dataPerCategory.m_SortTempData.SetCountUninitialized(data.GetCount());
+  ezSorting::RadixSort(data.GetArrayPtr(), dataPerCategory.m_SortTempData.GetArrayPtr(),
+    [](const ezRenderDataBatch::SortableRenderData& a) { return a.m_uiSortingKey; }, ezRenderWorld::GetUseMultithreadedRendering());
 
-    for (ezUInt32 i = 1; i < data.GetCount(); ++i)
+  // Render data with equal sorting keys is ordered by batch id
+  ezUInt32 uiRunStartIndex = 0;
+  for (ezUInt32 i = 1; i <= data.GetCount(); ++i)
+  {
+    if (i == data.GetCount() || data[i].m_uiSortingKey != data[uiRunStartIndex].m_uiSortingKey)
     {
-      auto pRenderData = data[i].m_pRenderData;
-
-      if (pRenderData->m_uiBatchId != uiCurrentBatchId || pRenderData->GetDynamicRTTI() != pCurrentBatchType)
+      if (i - uiRunStartIndex > 1)
       {
-        dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], i - uiCurrentBatchStartIndex);
-
-        uiCurrentBatchId = pRenderData->m_uiBatchId;
-        uiCurrentBatchStartIndex = i;
-        pCurrentBatchType = pRenderData->GetDynamicRTTI();
+        ezArrayPtr<ezRenderDataBatch::SortableRenderData> run = data.GetArrayPtr().GetSubArray(uiRunStartIndex, i - uiRunStartIndex);
+        ezSorting::QuickSort(run, BatchIdComparer());
       }
+
+      uiRunStartIndex = i;
     }
+  }
+
+  // Find batches
+  ezUInt32 uiCurrentBatchId = data[0].m_pRenderData->m_uiBatchId;
+  ezUInt32 uiCurrentBatchStartIndex = 0;
+  const ezRTTI* pCurrentBatchType = data[0].m_pRenderData->GetDynamicRTTI();
+
+  for (ezUInt32 i = 1; i < data.GetCount(); ++i)
+  {
+    auto pRenderData = data[i].m_pRenderData;
+
+    if (pRenderData->m_uiBatchId != uiCurrentBatchId || pRenderData->GetDynamicRTTI() != pCurrentBatchType)
+    {
+      dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], i - uiCurrentBatchStartIndex);
 
-    dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], data.GetCount() - uiCurrentBatchStartIndex);
+      uiCurrentBatchId = pRenderData->m_uiBatchId;
+      uiCurrentBatchStartIndex = i;
+      pCurrentBatchType = pRenderData->GetDynamicRTTI();
+    }
   }
+
+  dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], data.GetCount() - uiCurrentBatchStartIndex);
 }
 
 void ezExtractedRenderData::Clear()
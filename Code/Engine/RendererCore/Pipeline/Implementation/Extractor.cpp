@@ -1,8 +1,10 @@
 #include <RendererCorePCH.h>
 
+#include <Core/World/SpatialSystem_LooseOctree.h>
 #include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Core/World/World.h>
 #include <Foundation/Configuration/CVar.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/Extractor.h>
@@ -31,17 +33,21 @@ namespace
     if (CVarVisSpatialData && CVarVisObjectName.GetValue().IsEmpty() && !CVarVisObjectSelection)
     {
       const ezSpatialSystem& spatialSystem = *view.GetWorld()->GetSpatialSystem();
+      ezSpatialData::Category filterCategory = ezSpatialData::FindCategory(CVarVisSpatialCategory.GetValue());
+
+      ezHybridArray<ezBoundingBox, 16> boxes;
       if (auto pSpatialSystemGrid = ezDynamicCast<const ezSpatialSystem_RegularGrid*>(&spatialSystem))
       {
-        ezSpatialData::Category filterCategory = ezSpatialData::FindCategory(CVarVisSpatialCategory.GetValue());
-
-        ezHybridArray<ezBoundingBox, 16> boxes;
         pSpatialSystemGrid->GetAllCellBoxes(boxes, filterCategory);
+      }
+      else if (auto pSpatialSystemOctree = ezDynamicCast<const ezSpatialSystem_LooseOctree*>(&spatialSystem))
+      {
+        pSpatialSystemOctree->GetAllNodeBoxes(boxes, filterCategory);
+      }
 
-        for (auto& box : boxes)
-        {
-          ezDebugRenderer::DrawLineBox(view.GetHandle(), box, ezColor::Cyan);
-        }
+      for (auto& box : boxes)
+      {
+        ezDebugRenderer::DrawLineBox(view.GetHandle(), box, ezColor::Cyan);
       }
     }
   }
@@ -73,13 +79,20 @@ namespace
     if (CVarVisSpatialData && CVarVisSpatialCategory.GetValue().IsEmpty())
     {
       const ezSpatialSystem& spatialSystem = *view.GetWorld()->GetSpatialSystem();
+      ezBoundingBox box;
+      ezResult res = EZ_FAILURE;
       if (auto pSpatialSystemGrid = ezDynamicCast<const ezSpatialSystem_RegularGrid*>(&spatialSystem))
       {
-        ezBoundingBox box;
-        if (pSpatialSystemGrid->GetCellBoxForSpatialData(pObject->GetSpatialData(), box).Succeeded())
-        {
-          ezDebugRenderer::DrawLineBox(view.GetHandle(), box, ezColor::Cyan);
-        }
+        res = pSpatialSystemGrid->GetCellBoxForSpatialData(pObject->GetSpatialData(), box);
+      }
+      else if (auto pSpatialSystemOctree = ezDynamicCast<const ezSpatialSystem_LooseOctree*>(&spatialSystem))
+      {
+        res = pSpatialSystemOctree->GetNodeBoxForSpatialData(pObject->GetSpatialData(), box);
+      }
+
+      if (res.Succeeded())
+      {
+        ezDebugRenderer::DrawLineBox(view.GetHandle(), box, ezColor::Cyan);
       }
     }
   }
@@ -106,8 +119,8 @@ ezExtractor::ezExtractor(const char* szName)
   m_sName.Assign(szName);
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-  m_uiNumCachedRenderData = 0;
-  m_uiNumUncachedRenderData = 0;
+  m_NumCachedRenderData = 0;
+  m_NumUncachedRenderData = 0;
 #endif
 }
 
@@ -161,7 +174,7 @@ void ezExtractor::ExtractRenderData(const ezView& view, const ezGameObject* pObj
     }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    m_uiNumUncachedRenderData += msg.m_ExtractedRenderData.GetCount();
+    m_NumUncachedRenderData.Add(msg.m_ExtractedRenderData.GetCount());
 #endif
   };
 
@@ -197,7 +210,7 @@ void ezExtractor::ExtractRenderData(const ezView& view, const ezGameObject* pObj
           extractedRenderData.AddRenderData(cacheEntry.m_pRenderData, msg.m_OverrideCategory != ezInvalidRenderDataCategory ? msg.m_OverrideCategory : ezRenderData::Category(cacheEntry.m_uiCategory));
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-          ++m_uiNumCachedRenderData;
+          m_NumCachedRenderData.Increment();
 #endif
         }
         ++uiCacheIndex;
@@ -281,36 +294,75 @@ ezVisibleObjectsExtractor::ezVisibleObjectsExtractor(const char* szName)
 void ezVisibleObjectsExtractor::Extract(
   const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& extractedRenderData)
 {
-  ezMsgExtractRenderData msg;
-  msg.m_pView = &view;
-
   EZ_LOCK(view.GetWorld()->GetReadMarker());
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   VisualizeSpatialData(view);
 
-  m_uiNumCachedRenderData = 0;
-  m_uiNumUncachedRenderData = 0;
+  m_NumCachedRenderData = 0;
+  m_NumUncachedRenderData = 0;
 #endif
 
-  for (auto pObject : visibleObjects)
+  // Sending the extraction message to a few hundred objects is cheap enough to not be worth a task
+  const ezUInt32 uiMinObjectsPerChunk = 512;
+  const ezUInt32 uiNumObjects = visibleObjects.GetCount();
+
+  ezUInt32 uiNumChunks = 1;
+  if (ezRenderWorld::GetUseMultithreadedRendering())
   {
-    ExtractRenderData(view, pObject, msg, extractedRenderData);
+    const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+    uiNumChunks = ezMath::Clamp(uiNumObjects / uiMinObjectsPerChunk, 1u, ezMath::Max(uiNumWorkers, 1u));
+  }
+
+  if (uiNumChunks == 1)
+  {
+    ExtractObjects(view, visibleObjects, extractedRenderData);
+  }
+  else
+  {
+    // Each chunk is extracted into its own shard, the shards are merged in chunk order afterwards so the result is the same as extracting
+    // all objects serially.
+    m_ChunkShards.SetCount(uiNumChunks);
+    const ezUInt32 uiChunkSize = (uiNumObjects + uiNumChunks - 1) / uiNumChunks;
+
+    ezParallelForParams params;
+    params.uiBinSize = 1;
+    params.uiMaxTasksPerThread = 1;
+
+    ezTaskSystem::ParallelForIndexed(0, uiNumChunks,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        for (ezUInt32 uiChunk = uiStartIndex; uiChunk < uiEndIndex; ++uiChunk)
+        {
+          const ezUInt32 uiFirstObject = uiChunk * uiChunkSize;
+          const ezUInt32 uiChunkObjects = ezMath::Min(uiChunkSize, uiNumObjects - uiFirstObject);
+
+          extractedRenderData.PrepareShard(m_ChunkShards[uiChunk]);
+          ExtractObjects(view, visibleObjects.GetArrayPtr().GetSubArray(uiFirstObject, uiChunkObjects), m_ChunkShards[uiChunk]);
+        }
+      },
+      "ExtractVisibleObjects", params);
+
+    for (const auto& shard : m_ChunkShards)
+    {
+      extractedRenderData.MergeShard(shard);
+    }
+  }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    if (CVarVisBounds || CVarVisLocalBBox || CVarVisSpatialData)
+  // The debug renderer is thread safe, but calling it from the chunk tasks would make them contend on its lock and draw the objects
+  // in a different order every frame, so the objects are visualized on this thread once all chunks are done.
+  if ((CVarVisBounds || CVarVisLocalBBox || CVarVisSpatialData) && !CVarVisObjectSelection)
+  {
+    for (auto pObject : visibleObjects)
     {
-      if ((CVarVisObjectName.GetValue().IsEmpty() ||
-            ezStringUtils::FindSubString_NoCase(pObject->GetName(), CVarVisObjectName.GetValue()) != nullptr) &&
-          !CVarVisObjectSelection)
+      if (CVarVisObjectName.GetValue().IsEmpty() ||
+          ezStringUtils::FindSubString_NoCase(pObject->GetName(), CVarVisObjectName.GetValue()) != nullptr)
       {
         VisualizeObject(view, pObject);
       }
     }
-#endif
   }
 
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   const bool bIsMainView = (view.GetCameraUsageHint() == ezCameraUsageHint::MainView || view.GetCameraUsageHint() == ezCameraUsageHint::EditorView);
 
   if (CVarExtractionStats && bIsMainView)
@@ -321,15 +373,27 @@ void ezVisibleObjectsExtractor::Extract(
 
     ezDebugRenderer::Draw2DText(hView, "Extraction Stats", ezVec2I32(10, 200), ezColor::LimeGreen);
 
-    sb.Format("Num Cached Render Data: {0}", m_uiNumCachedRenderData);
+    sb.Format("Num Cached Render Data: {0}", (ezInt32)m_NumCachedRenderData);
     ezDebugRenderer::Draw2DText(hView, sb, ezVec2I32(10, 220), ezColor::LimeGreen);
 
-    sb.Format("Num Uncached Render Data: {0}", m_uiNumUncachedRenderData);
+    sb.Format("Num Uncached Render Data: {0}", (ezInt32)m_NumUncachedRenderData);
     ezDebugRenderer::Draw2DText(hView, sb, ezVec2I32(10, 240), ezColor::LimeGreen);
   }
 #endif
 }
 
+void ezVisibleObjectsExtractor::ExtractObjects(
+  const ezView& view, ezArrayPtr<const ezGameObject* const> objects, ezExtractedRenderData& extractedRenderData) const
+{
+  ezMsgExtractRenderData msg;
+  msg.m_pView = &view;
+
+  for (auto pObject : objects)
+  {
+    ExtractRenderData(view, pObject, msg, extractedRenderData);
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezSelectedObjectsExtractor, 1, ezRTTINoAllocator)
@@ -3,6 +3,7 @@
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/InstanceDataProvider.h>
 #include <RendererCore/RenderContext/RenderContext.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
 #include <RendererFoundation/Profiling/Profiling.h>
 
 #include <RendererCore/../../../Data/Base/Shaders/Common/ObjectConstants.h>
@@ -98,6 +99,30 @@ ezInstanceDataProvider::ezInstanceDataProvider() {}
 
 ezInstanceDataProvider::~ezInstanceDataProvider() {}
 
+ezInstanceData* ezInstanceDataProvider::GetData(const ezRenderViewContext& renderViewContext)
+{
+  if (!renderViewContext.m_pRenderContext->IsRecording())
+  {
+    return ezFrameDataProvider<ezInstanceData>::GetData(renderViewContext);
+  }
+
+  EZ_LOCK(m_RecordingDataMutex);
+
+  RecordingData& recordingData = m_RecordingData[renderViewContext.m_pRenderContext];
+  if (recordingData.m_pData == nullptr)
+  {
+    recordingData.m_pData = EZ_DEFAULT_NEW(ezInstanceData);
+  }
+
+  if (recordingData.m_uiLastUpdateFrame != ezRenderWorld::GetFrameCounter())
+  {
+    recordingData.m_pData->Reset();
+    recordingData.m_uiLastUpdateFrame = ezRenderWorld::GetFrameCounter();
+  }
+
+  return recordingData.m_pData.Borrow();
+}
+
 void* ezInstanceDataProvider::UpdateData(const ezRenderViewContext& renderViewContext, const ezExtractedRenderData& extractedData)
 {
   m_Data.Reset();
@@ -80,6 +80,16 @@ EZ_FORCE_INLINE ezRenderDataBatch::Iterator<T> ezRenderDataBatch::GetIterator(ez
   return Iterator<T>(m_Data.GetPtr() + uiStartIndex, m_Data.GetPtr() + uiEndIndex, m_Filter);
 }
 
+EZ_FORCE_INLINE ezRenderDataBatch ezRenderDataBatch::GetSubBatch(ezUInt32 uiStartIndex, ezUInt32 uiCount) const
+{
+  EZ_ASSERT_DEBUG(uiStartIndex <= m_Data.GetCount(), "Invalid start index");
+
+  ezRenderDataBatch subBatch;
+  subBatch.m_Filter = m_Filter;
+  subBatch.m_Data = m_Data.GetSubArray(uiStartIndex, ezMath::Min(uiCount, m_Data.GetCount() - uiStartIndex));
+  return subBatch;
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 EZ_ALWAYS_INLINE ezUInt32 ezRenderDataBatchList::GetBatchCount() const
@@ -1,6 +1,7 @@
 #include <RendererCorePCH.h>
 
 #include <Core/World/World.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Clock.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/GPUResourcePool/GPUResourcePool.h>
@@ -13,6 +14,10 @@
 #include <RendererCore/RenderWorld/RenderWorld.h>
 #include <RendererFoundation/Profiling/Profiling.h>
 
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+#  include <Foundation/Utilities/Stats.h>
+#endif
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
 ezCVarBool ezRenderPipeline::s_DebugCulling("r_DebugCulling", false, ezCVarFlags::Default, "Enables debug visualization of visibility culling");
 
@@ -34,6 +39,13 @@ ezRenderPipeline::ezRenderPipeline()
 
 ezRenderPipeline::~ezRenderPipeline()
 {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (!m_sTransientMemoryStatName.IsEmpty())
+  {
+    ezStats::RemoveStat(m_sTransientMemoryStatName);
+  }
+#endif
+
   m_Data[0].Clear();
   m_Data[1].Clear();
 
@@ -590,9 +602,82 @@ bool ezRenderPipeline::CreateRenderTargetUsage(const ezView& view)
   m_TextureUsageIdxSortedByFirstUsage.Sort(FirstUsageComparer(m_TextureUsage));
   m_TextureUsageIdxSortedByLastUsage.Sort(LastUsageComparer(m_TextureUsage));
 
+  ComputeTransientTargetMemory(view);
+
   return true;
 }
 
+void ezRenderPipeline::ComputeTransientTargetMemory(const ezView& view)
+{
+  ezGALDevice* pDevice = ezGALDevice::GetDefaultDevice();
+
+  m_Statistics.m_uiNumTransientTargets = m_TextureUsageIdxSortedByFirstUsage.GetCount();
+  m_Statistics.m_uiTransientTargetMemory = 0;
+  m_Statistics.m_uiAliasedTransientTargetMemory = 0;
+
+  // Replay the lifetimes the same way Render() acquires and returns the pool textures. A target whose lifetime starts after
+  // another compatible target has been returned gets that texture, so only the targets that are alive at the same time need memory.
+  ezHashTable<ezUInt32, ezUInt32> numReturnedTextures;
+
+  ezUInt32 uiCurrentFirstUsageIdx = 0;
+  ezUInt32 uiCurrentLastUsageIdx = 0;
+  for (ezUInt32 i = 0; i < m_Passes.GetCount(); ++i)
+  {
+    for (; uiCurrentFirstUsageIdx < m_TextureUsageIdxSortedByFirstUsage.GetCount(); ++uiCurrentFirstUsageIdx)
+    {
+      const TextureUsageData& usageData = m_TextureUsage[m_TextureUsageIdxSortedByFirstUsage[uiCurrentFirstUsageIdx]];
+      if (usageData.m_uiFirstUsageIdx != i)
+        break;
+
+      const ezGALTextureCreationDescription& desc = usageData.m_UsedBy[0]->m_Desc;
+      const ezUInt64 uiMemory = pDevice->GetMemoryConsumptionForTexture(desc);
+      m_Statistics.m_uiTransientTargetMemory += uiMemory;
+
+      ezUInt32& uiNumReturned = numReturnedTextures[ezGPUResourcePool::CalculateAliasingHash(desc)];
+      if (uiNumReturned > 0)
+      {
+        --uiNumReturned;
+      }
+      else
+      {
+        m_Statistics.m_uiAliasedTransientTargetMemory += uiMemory;
+      }
+    }
+
+    for (; uiCurrentLastUsageIdx < m_TextureUsageIdxSortedByLastUsage.GetCount(); ++uiCurrentLastUsageIdx)
+    {
+      const TextureUsageData& usageData = m_TextureUsage[m_TextureUsageIdxSortedByLastUsage[uiCurrentLastUsageIdx]];
+      if (usageData.m_uiLastUsageIdx != i)
+        break;
+
+      numReturnedTextures[ezGPUResourcePool::CalculateAliasingHash(usageData.m_UsedBy[0]->m_Desc)]++;
+    }
+  }
+
+  const float fToMB = 1.0f / (1024.0f * 1024.0f);
+  ezLog::Debug("{0} intermediate render targets: {1} MB, {2} MB with aliasing ({3} MB saved)", m_Statistics.m_uiNumTransientTargets,
+    ezArgF(m_Statistics.m_uiTransientTargetMemory * fToMB, 2), ezArgF(m_Statistics.m_uiAliasedTransientTargetMemory * fToMB, 2),
+    ezArgF((m_Statistics.m_uiTransientTargetMemory - m_Statistics.m_uiAliasedTransientTargetMemory) * fToMB, 2));
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  // Several views can share the same pipeline asset, so the stat is keyed by the view and the pipeline instance.
+  ezStringBuilder sStatName, sOut;
+  sStatName.Format("Render Pipeline/{0} ({1})/Transient Memory Saved", view.GetName(), ezArgU(reinterpret_cast<ezUInt64>(this), 16, true, 16));
+  if (m_sTransientMemoryStatName != sStatName)
+  {
+    if (!m_sTransientMemoryStatName.IsEmpty())
+    {
+      ezStats::RemoveStat(m_sTransientMemoryStatName);
+    }
+
+    m_sTransientMemoryStatName = sStatName;
+  }
+
+  sOut.Format("{0} (Mb)", ezArgF((m_Statistics.m_uiTransientTargetMemory - m_Statistics.m_uiAliasedTransientTargetMemory) * fToMB, 4));
+  ezStats::SetStat(m_sTransientMemoryStatName, sOut.GetData());
+#endif
+}
+
 bool ezRenderPipeline::InitRenderPipelinePasses()
 {
   ezLogBlock b("Init Render Pipeline Passes");
@@ -834,6 +919,8 @@ bool ezRenderPipeline::ArePassThroughInputsDone(const ezRenderPipelinePass* pPas
 
 ezFrameDataProviderBase* ezRenderPipeline::GetFrameDataProvider(const ezRTTI* pRtti) const
 {
+  EZ_LOCK(m_DataProvidersMutex);
+
   ezUInt32 uiIndex = 0;
   if (m_TypeToDataProviderIndex.TryGetValue(pRtti, uiIndex))
   {
@@ -865,8 +952,14 @@ void ezRenderPipeline::ExtractData(const ezView& view)
   m_uiLastExtractionFrame = ezRenderWorld::GetFrameCounter();
 
   // Determine visible objects
+  ezTime startTime = ezTime::Now();
   FindVisibleObjects(view);
 
+  ezTime endTime = ezTime::Now();
+  m_Statistics.m_VisibilityCullingTime = endTime - startTime;
+  m_Statistics.m_uiNumVisibleObjects = m_visibleObjects.GetCount();
+  startTime = endTime;
+
   // Extract and sort data
   auto& data = m_Data[ezRenderWorld::GetDataIndexForExtraction()];
 
@@ -882,16 +975,57 @@ void ezRenderPipeline::ExtractData(const ezView& view)
   data.SetViewDebugContext(view.GetHandle());
 
   // Extract object render data
-  for (auto& pExtractor : m_Extractors)
+  if (ezRenderWorld::GetUseMultithreadedRendering() && m_Extractors.GetCount() > 1)
   {
-    if (pExtractor->m_bActive)
+    // Every extractor writes into its own shard so they can run as tasks. The shards are merged in extractor order afterwards which gives
+    // the same result as extracting serially.
+    m_ExtractorShards.SetCount(m_Extractors.GetCount());
+
+    ezParallelForParams params;
+    params.uiBinSize = 1;
+    params.nestingMode = ezTaskNesting::Maybe; // extractors may use tasks themselves
+
+    ezTaskSystem::ParallelForIndexed(0, m_Extractors.GetCount(),
+      [this, &view, &data](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          auto& pExtractor = m_Extractors[i];
+          if (pExtractor->m_bActive)
+          {
+            EZ_PROFILE_SCOPE(pExtractor->m_sName.GetData());
+
+            data.PrepareShard(m_ExtractorShards[i]);
+            pExtractor->Extract(view, m_visibleObjects, m_ExtractorShards[i]);
+          }
+        }
+      },
+      "Extractors", params);
+
+    for (ezUInt32 i = 0; i < m_Extractors.GetCount(); ++i)
     {
-      EZ_PROFILE_SCOPE(pExtractor->m_sName.GetData());
+      if (m_Extractors[i]->m_bActive)
+      {
+        data.MergeShard(m_ExtractorShards[i]);
+      }
+    }
+  }
+  else
+  {
+    for (auto& pExtractor : m_Extractors)
+    {
+      if (pExtractor->m_bActive)
+      {
+        EZ_PROFILE_SCOPE(pExtractor->m_sName.GetData());
 
-      pExtractor->Extract(view, m_visibleObjects, data);
+        pExtractor->Extract(view, m_visibleObjects, data);
+      }
     }
   }
 
+  endTime = ezTime::Now();
+  m_Statistics.m_ExtractionTime = endTime - startTime;
+  startTime = endTime;
+
   data.SortAndBatch();
 
   for (auto& pExtractor : m_Extractors)
@@ -904,6 +1038,8 @@ void ezRenderPipeline::ExtractData(const ezView& view)
     }
   }
 
+  m_Statistics.m_SortingTime = ezTime::Now() - startTime;
+
   m_CurrentExtractThread = (ezThreadID)0;
 }
 
@@ -980,6 +1116,7 @@ void ezRenderPipeline::Render(ezRenderContext* pRenderContext)
   EZ_ASSERT_DEV(m_uiLastRenderFrame != ezRenderWorld::GetFrameCounter(), "Render must not be called multiple times per frame.");
   m_uiLastRenderFrame = ezRenderWorld::GetFrameCounter();
 
+  const ezTime startTime = ezTime::Now();
 
   auto& data = m_Data[ezRenderWorld::GetDataIndexForRendering()];
   const ezCamera* pCamera = &data.GetCamera();
@@ -1127,6 +1264,8 @@ void ezRenderPipeline::Render(ezRenderContext* pRenderContext)
 
   data.Clear();
 
+  m_Statistics.m_RenderingTime = ezTime::Now() - startTime;
+
   m_CurrentRenderThread = (ezThreadID)0;
 }
 
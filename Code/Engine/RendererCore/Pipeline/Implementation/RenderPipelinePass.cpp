@@ -1,12 +1,187 @@
 #include <RendererCorePCH.h>
 
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Pipeline/RenderPipeline.h>
 #include <RendererCore/Pipeline/RenderPipelinePass.h>
 #include <RendererCore/Pipeline/Renderer.h>
 #include <RendererCore/RenderContext/RenderContext.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
 
 #include <RendererFoundation/Profiling/Profiling.h>
 
+ezCVarBool CVarParallelRecording("r_ParallelRecording", false, ezCVarFlags::Default, "Records large render data categories on multiple threads");
+
+namespace
+{
+  // Recording on another thread only pays off if there is enough render data to record
+  constexpr ezUInt32 s_uiMinRenderDataPerRecordingJob = 256;
+
+  struct RenderBatchItem
+  {
+    ezRenderDataBatch m_Batch;
+    const ezRenderer* m_pRenderer;
+  };
+
+  struct RecordingJob
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiFirstItem;
+    ezUInt32 m_uiItemCount;
+    bool m_bRecordInParallel; ///< Otherwise the items are rendered directly on the render thread
+    ezRenderContext* m_pRecordingContext;
+  };
+
+  bool RenderBatchesInParallel(const ezRenderViewContext& renderViewContext, const ezRenderPipelinePass* pPass, ezRenderData::Category category, const ezRenderDataBatchList& batchList)
+  {
+    ezRenderContext* pRenderContext = renderViewContext.m_pRenderContext;
+
+    if (!CVarParallelRecording || !ezRenderWorld::GetUseMultithreadedRendering() || pRenderContext->IsRecording() ||
+        !ezGALDevice::GetDefaultDevice()->GetCapabilities().m_bMultithreadedResourceCreation)
+    {
+      return false;
+    }
+
+    ezDynamicArray<RenderBatchItem> batches(ezFrameAllocator::GetCurrentAllocator());
+    ezUInt32 uiParallelRenderDataCount = 0;
+
+    const ezUInt32 uiBatchCount = batchList.GetBatchCount();
+    for (ezUInt32 i = 0; i < uiBatchCount; ++i)
+    {
+      const ezRenderDataBatch& batch = batchList.GetBatch(i);
+
+      if (const ezRenderData* pRenderData = batch.GetFirstData<ezRenderData>())
+      {
+        if (const ezRenderer* pRenderer = ezRenderData::GetCategoryRenderer(category, pRenderData->GetDynamicRTTI()))
+        {
+          batches.PushBack({batch, pRenderer});
+
+          if (pRenderer->CanRecordInParallel())
+          {
+            uiParallelRenderDataCount += batch.GetCount();
+          }
+        }
+      }
+    }
+
+    const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+    const ezUInt32 uiNumJobs = ezMath::Min(uiParallelRenderDataCount / s_uiMinRenderDataPerRecordingJob, uiNumWorkers);
+    if (uiNumJobs < 2)
+    {
+      return false;
+    }
+
+    // Distribute the batches evenly across the jobs, large batches are split into several jobs.
+    // Batches of renderers that can't record in parallel are rendered on the render thread in between the recorded jobs,
+    // so the draw calls are submitted in the same order as when rendering serially.
+    const ezUInt32 uiRenderDataPerJob = (uiParallelRenderDataCount + uiNumJobs - 1) / uiNumJobs;
+
+    ezDynamicArray<RenderBatchItem> items(ezFrameAllocator::GetCurrentAllocator());
+    ezDynamicArray<RecordingJob> jobs(ezFrameAllocator::GetCurrentAllocator());
+    ezUInt32 uiCurrentJobRenderDataCount = 0;
+    ezUInt32 uiNumRecordingJobs = 0;
+    bool bCanContinueJob = false;
+
+    for (const RenderBatchItem& batch : batches)
+    {
+      if (!batch.m_pRenderer->CanRecordInParallel())
+      {
+        jobs.PushBack({items.GetCount(), 1, false, nullptr});
+        items.PushBack(batch);
+        bCanContinueJob = false;
+        continue;
+      }
+
+      const ezUInt32 uiCount = batch.m_Batch.GetCount();
+      ezUInt32 uiStartIndex = 0;
+      while (uiStartIndex < uiCount)
+      {
+        if (!bCanContinueJob || uiCurrentJobRenderDataCount >= uiRenderDataPerJob)
+        {
+          jobs.PushBack({items.GetCount(), 0, true, nullptr});
+          uiCurrentJobRenderDataCount = 0;
+          ++uiNumRecordingJobs;
+          bCanContinueJob = true;
+        }
+
+        const ezUInt32 uiSubBatchCount = ezMath::Min(uiCount - uiStartIndex, uiRenderDataPerJob - uiCurrentJobRenderDataCount);
+        items.PushBack({batch.m_Batch.GetSubBatch(uiStartIndex, uiSubBatchCount), batch.m_pRenderer});
+        jobs.PeekBack().m_uiItemCount++;
+
+        uiCurrentJobRenderDataCount += uiSubBatchCount;
+        uiStartIndex += uiSubBatchCount;
+      }
+    }
+
+    // Many small jobs are created when parallel and serial batches alternate, recording doesn't pay off in this case
+    if (uiNumRecordingJobs > uiNumJobs * 2)
+    {
+      return false;
+    }
+
+    ezUInt32 uiRecordingContextIndex = 0;
+    for (RecordingJob& job : jobs)
+    {
+      if (job.m_bRecordInParallel)
+      {
+        job.m_pRecordingContext = pRenderContext->GetRecordingContext(uiRecordingContextIndex++);
+        job.m_pRecordingContext->BeginRecording(*pRenderContext);
+      }
+    }
+
+    {
+      EZ_PROFILE_SCOPE("Record Render Data");
+
+      ezParallelForParams params;
+      params.uiBinSize = 1;
+      params.uiMaxTasksPerThread = 1;
+
+      ezTaskSystem::ParallelForIndexed(0, jobs.GetCount(),
+        [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+          for (ezUInt32 uiJob = uiStartIndex; uiJob < uiEndIndex; ++uiJob)
+          {
+            const RecordingJob& job = jobs[uiJob];
+            if (!job.m_bRecordInParallel)
+              continue;
+
+            ezRenderViewContext recordingViewContext = renderViewContext;
+            recordingViewContext.m_pRenderContext = job.m_pRecordingContext;
+
+            for (ezUInt32 i = job.m_uiFirstItem; i < job.m_uiFirstItem + job.m_uiItemCount; ++i)
+            {
+              items[i].m_pRenderer->RenderBatch(recordingViewContext, pPass, items[i].m_Batch);
+            }
+          }
+        },
+        "RecordRenderData", params);
+    }
+
+    for (const RecordingJob& job : jobs)
+    {
+      if (job.m_bRecordInParallel)
+      {
+        job.m_pRecordingContext->EndRecording();
+      }
+    }
+
+    for (const RecordingJob& job : jobs)
+    {
+      if (job.m_bRecordInParallel)
+      {
+        pRenderContext->ExecuteRecordedCommands(*job.m_pRecordingContext);
+      }
+      else
+      {
+        const RenderBatchItem& item = items[job.m_uiFirstItem];
+        item.m_pRenderer->RenderBatch(renderViewContext, pPass, item.m_Batch);
+      }
+    }
+
+    return true;
+  }
+} // namespace
+
 // clang-format off
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezRenderPipelinePass, 1, ezRTTINoAllocator)
 {
@@ -59,6 +234,11 @@ void ezRenderPipelinePass::RenderDataWithCategory(const ezRenderViewContext& ren
   EZ_PROFILE_AND_MARKER(renderViewContext.m_pRenderContext->GetCommandEncoder(), ezRenderData::GetCategoryName(category));
 
   auto batchList = m_pPipeline->GetRenderDataBatchesWithCategory(category, filter);
+  if (RenderBatchesInParallel(renderViewContext, this, category, batchList))
+  {
+    return;
+  }
+
   const ezUInt32 uiBatchCount = batchList.GetBatchCount();
   for (ezUInt32 i = 0; i < uiBatchCount; ++i)
   {
@@ -69,6 +69,11 @@ EZ_ALWAYS_INLINE ezEnum<ezViewRenderMode> ezView::GetViewRenderMode() const
   return m_Data.m_ViewRenderMode;
 }
 
+EZ_ALWAYS_INLINE const ezRenderPipeline* ezView::GetRenderPipeline() const
+{
+  return m_pRenderPipeline.Borrow();
+}
+
 EZ_ALWAYS_INLINE const ezRectFloat& ezView::GetViewport() const
 {
   return m_Data.m_ViewPortRect;
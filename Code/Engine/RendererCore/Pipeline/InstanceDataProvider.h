@@ -1,5 +1,7 @@
 #pragma once
 
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Types/UniquePtr.h>
 #include <RendererCore/Declarations.h>
 #include <RendererCore/Pipeline/FrameDataProvider.h>
 #include <RendererCore/Shader/ConstantBufferStorage.h>
@@ -45,8 +47,22 @@ public:
   ezInstanceDataProvider();
   ~ezInstanceDataProvider();
 
+  /// \brief Returns the instance data for the render context of the given view context.
+  ///
+  /// Render contexts that record on other threads get their own instance data, since it is modified while rendering.
+  ezInstanceData* GetData(const ezRenderViewContext& renderViewContext);
+
 private:
   virtual void* UpdateData(const ezRenderViewContext& renderViewContext, const ezExtractedRenderData& extractedData) override;
 
   ezInstanceData m_Data;
+
+  struct RecordingData
+  {
+    ezUniquePtr<ezInstanceData> m_pData;
+    ezUInt64 m_uiLastUpdateFrame = 0;
+  };
+
+  ezMutex m_RecordingDataMutex;
+  ezHashTable<const ezRenderContext*, RecordingData> m_RecordingData;
 };
@@ -52,6 +52,9 @@ public:
   template <typename T>
   Iterator<T> GetIterator(ezUInt32 uiStartIndex = 0, ezUInt32 uiCount = ezInvalidIndex) const;
 
+  /// \brief Returns a batch that only contains the given range of this batch.
+  ezRenderDataBatch GetSubBatch(ezUInt32 uiStartIndex, ezUInt32 uiCount = ezInvalidIndex) const;
+
 private:
   friend class ezExtractedRenderData;
   friend class ezRenderDataBatchList;
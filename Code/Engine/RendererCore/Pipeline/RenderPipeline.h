@@ -4,6 +4,7 @@
 #include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/Mutex.h>
 #include <Foundation/Types/UniquePtr.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 
@@ -55,6 +56,23 @@ public:
   ezRenderDataBatchList GetRenderDataBatchesWithCategory(
     ezRenderData::Category category, ezRenderDataBatch::Filter filter = ezRenderDataBatch::Filter()) const;
 
+  /// \brief CPU time spent in the individual stages of the last extraction and the last rendering of this pipeline.
+  struct Statistics
+  {
+    ezTime m_VisibilityCullingTime;
+    ezTime m_ExtractionTime; ///< Time spent in the extractors, excluding culling and sorting
+    ezTime m_SortingTime;    ///< Time spent sorting and batching the render data, including PostSortAndBatch
+    ezTime m_RenderingTime;  ///< Time spent executing the passes, i.e. recording the commands for the GAL device
+    ezUInt32 m_uiNumVisibleObjects = 0;
+
+    // Intermediate render targets of the pipeline, updated whenever the pipeline is rebuilt
+    ezUInt32 m_uiNumTransientTargets = 0;
+    ezUInt64 m_uiTransientTargetMemory = 0;        ///< Memory the intermediate targets would need if each of them had its own texture
+    ezUInt64 m_uiAliasedTransientTargetMemory = 0; ///< Memory needed when targets with non-overlapping lifetimes share pool textures
+  };
+
+  const Statistics& GetStatistics() const { return m_Statistics; }
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   static ezCVarBool s_DebugCulling;
 #endif
@@ -71,6 +89,7 @@ private:
   bool SortPasses();
   bool InitRenderTargetDescriptions(const ezView& view);
   bool CreateRenderTargetUsage(const ezView& view);
+  void ComputeTransientTargetMemory(const ezView& view);
   bool InitRenderPipelinePasses();
   void SortExtractors();
   void UpdateViewData(const ezView& view, ezUInt32 uiDataIndex);
@@ -96,8 +115,14 @@ private: // Member data
   ezExtractedRenderData m_Data[2];
   ezDynamicArray<const ezGameObject*> m_visibleObjects;
 
+  // One shard per extractor, used when the extractors of a view run as tasks
+  ezDynamicArray<ezExtractedRenderData> m_ExtractorShards;
+
+  Statistics m_Statistics;
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   ezTime m_AverageCullingTime;
+  ezString m_sTransientMemoryStatName;
 #endif
 
   ezHashedString m_sName;
@@ -135,6 +160,7 @@ private: // Member data
   ezDynamicArray<ezUniquePtr<ezExtractor>> m_SortedExtractors;
 
   // Data Providers
+  mutable ezMutex m_DataProvidersMutex; ///< Renderers can request data providers while recording on worker threads
   mutable ezDynamicArray<ezUniquePtr<ezFrameDataProviderBase>> m_DataProviders;
   mutable ezHashTable<const ezRTTI*, ezUInt32> m_TypeToDataProviderIndex;
 
@@ -14,4 +14,10 @@ public:
   virtual void GetSupportedRenderDataCategories(ezHybridArray<ezRenderData::Category, 8>& categories) const = 0;
 
   virtual void RenderBatch(const ezRenderViewContext& renderViewContext, const ezRenderPipelinePass* pPass, const ezRenderDataBatch& batch) const = 0;
+
+  /// \brief Returns whether RenderBatch may be called on several threads at the same time, each with its own recording render context.
+  ///
+  /// The render context in the view context is then a recording context, see ezRenderContext::BeginRecording().
+  /// Batches might also be split into several smaller batches.
+  virtual bool CanRecordInParallel() const { return false; }
 };
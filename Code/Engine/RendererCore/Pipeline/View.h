@@ -42,6 +42,9 @@ public:
   void SetRenderPipelineResource(ezRenderPipelineResourceHandle hPipeline);
   ezRenderPipelineResourceHandle GetRenderPipelineResource() const;
 
+  /// \brief Returns the render pipeline instance that was created from the render pipeline resource, nullptr if it has not been created yet.
+  const ezRenderPipeline* GetRenderPipeline() const;
+
   void SetCamera(ezCamera* pCamera);
   ezCamera* GetCamera();
   const ezCamera* GetCamera() const;
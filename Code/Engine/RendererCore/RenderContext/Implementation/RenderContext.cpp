@@ -1,5 +1,6 @@
 #include <RendererCorePCH.h>
 
+#include <Foundation/Configuration/CVar.h>
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <RendererCore/Material/MaterialResource.h>
@@ -12,12 +13,16 @@
 #include <RendererCore/Textures/Texture3DResource.h>
 #include <RendererCore/Textures/TextureCubeResource.h>
 #include <RendererFoundation/CommandEncoder/CommandEncoder.h>
+#include <RendererFoundation/CommandEncoder/CommandList.h>
 #include <RendererFoundation/Resources/RenderTargetView.h>
 #include <RendererFoundation/Resources/Texture.h>
 
+ezCVarBool CVarBatchStateChanges("r_BatchStateChanges", false, ezCVarFlags::Default, "Accumulates state changes until the next draw call and only passes the actual differences to the graphics API");
+
 ezRenderContext* ezRenderContext::s_DefaultInstance = nullptr;
 ezHybridArray<ezRenderContext*, 4> ezRenderContext::s_Instances;
 
+ezMutex ezRenderContext::s_GALVertexDeclarationsMutex;
 ezMap<ezRenderContext::ShaderVertexDecl, ezGALVertexDeclarationHandle> ezRenderContext::s_GALVertexDeclarations;
 
 ezMutex ezRenderContext::s_ConstantBufferStorageMutex;
@@ -64,6 +69,10 @@ ezRenderContext::Statistics::Statistics()
 void ezRenderContext::Statistics::Reset()
 {
   m_uiFailedDrawcalls = 0;
+  m_uiExecutedCommandLists = 0;
+  m_uiStateChanges = 0;
+  m_uiRedundantStateChanges = 0;
+  m_uiAvoidedStateChanges = 0;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -108,6 +117,17 @@ ezRenderContext::ezRenderContext()
 
 ezRenderContext::~ezRenderContext()
 {
+  for (ezRenderContext* pRecordingContext : m_RecordingContexts)
+  {
+    pRecordingContext->m_pParentContext = nullptr;
+    DestroyInstance(pRecordingContext);
+  }
+
+  if (m_pParentContext != nullptr)
+  {
+    m_pParentContext->m_RecordingContexts.RemoveAndCopy(this);
+  }
+
   DeleteConstantBufferStorage(m_hGlobalConstantBufferStorage);
 
   if (s_DefaultInstance == this)
@@ -119,7 +139,7 @@ ezRenderContext::~ezRenderContext()
 ezRenderContext::Statistics ezRenderContext::GetAndResetStatistics()
 {
   ezRenderContext::Statistics ret = m_Statistics;
-  ret.Reset();
+  m_Statistics.Reset();
 
   return ret;
 }
@@ -153,6 +173,7 @@ ezGALRenderCommandEncoder* ezRenderContext::BeginRendering(ezGALPass* pGALPass,
   gc.NumMsaaSamples = msaaSampleCount;
 
   auto pGALCommandEncoder = pGALPass->BeginRendering(renderingSetup, szName);
+  pGALCommandEncoder->SetStateBatchingEnabled(CVarBatchStateChanges);
 
   pGALCommandEncoder->SetViewport(viewport);
 
@@ -165,6 +186,8 @@ ezGALRenderCommandEncoder* ezRenderContext::BeginRendering(ezGALPass* pGALPass,
 
 void ezRenderContext::EndRendering()
 {
+  CollectCommandEncoderStatistics();
+
   m_pGALPass->EndRendering(GetRenderCommandEncoder());
 
   m_pGALPass = nullptr;
@@ -179,6 +202,7 @@ void ezRenderContext::EndRendering()
 ezGALComputeCommandEncoder* ezRenderContext::BeginCompute(ezGALPass* pGALPass, const char* szName /*= ""*/)
 {
   auto pGALCommandEncoder = pGALPass->BeginCompute(szName);
+  pGALCommandEncoder->SetStateBatchingEnabled(CVarBatchStateChanges);
 
   m_pGALPass = pGALPass;
   m_pGALCommandEncoder = pGALCommandEncoder;
@@ -189,6 +213,8 @@ ezGALComputeCommandEncoder* ezRenderContext::BeginCompute(ezGALPass* pGALPass, c
 
 void ezRenderContext::EndCompute()
 {
+  CollectCommandEncoderStatistics();
+
   m_pGALPass->EndCompute(GetComputeCommandEncoder());
 
   m_pGALPass = nullptr;
@@ -198,6 +224,117 @@ void ezRenderContext::EndCompute()
   //ResetContextState();
 }
 
+ezRenderContext* ezRenderContext::GetRecordingContext(ezUInt32 uiIndex)
+{
+  EZ_ASSERT_DEV(m_pParentContext == nullptr, "A recording context can't have recording contexts itself");
+
+  while (m_RecordingContexts.GetCount() <= uiIndex)
+  {
+    ezRenderContext* pRecordingContext = CreateInstance();
+    pRecordingContext->m_pParentContext = this;
+    pRecordingContext->m_pCommandList = EZ_DEFAULT_NEW(ezGALCommandList, *ezGALDevice::GetDefaultDevice());
+
+    m_RecordingContexts.PushBack(pRecordingContext);
+  }
+
+  return m_RecordingContexts[uiIndex];
+}
+
+ezGALRenderCommandEncoder* ezRenderContext::BeginRecording(ezRenderContext& parentContext)
+{
+  EZ_ASSERT_DEV(m_pParentContext == &parentContext, "This is not a recording context of the given parent context");
+  EZ_ASSERT_DEV(ezThreadUtils::IsMainThread(), "Recording needs to be started on the render thread");
+
+  // Constants that are still pending on the parent context are needed by the recorded commands as well
+  parentContext.UploadConstants();
+
+  m_PermutationVariables = parentContext.m_PermutationVariables;
+  m_hNewMaterial = parentContext.m_hNewMaterial;
+  m_hMaterial = parentContext.m_hMaterial;
+  m_hActiveShader = parentContext.m_hActiveShader;
+  m_ShaderBindFlags = parentContext.m_ShaderBindFlags;
+  m_hActiveGALShader.Invalidate();
+  m_hActiveShaderPermutation.Invalidate();
+
+  m_hVertexBuffer = parentContext.m_hVertexBuffer;
+  m_hIndexBuffer = parentContext.m_hIndexBuffer;
+  m_pVertexDeclarationInfo = parentContext.m_pVertexDeclarationInfo;
+  m_Topology = parentContext.m_Topology;
+  m_uiMeshBufferPrimitiveCount = parentContext.m_uiMeshBufferPrimitiveCount;
+  m_DefaultTextureFilter = parentContext.m_DefaultTextureFilter;
+  m_bAllowAsyncShaderLoading = parentContext.m_bAllowAsyncShaderLoading;
+
+  m_BoundTextures2D = parentContext.m_BoundTextures2D;
+  m_BoundTextures3D = parentContext.m_BoundTextures3D;
+  m_BoundTexturesCube = parentContext.m_BoundTexturesCube;
+  m_BoundUAVs = parentContext.m_BoundUAVs;
+  m_BoundSamplers = parentContext.m_BoundSamplers;
+  m_BoundBuffer = parentContext.m_BoundBuffer;
+  m_BoundConstantBuffers = parentContext.m_BoundConstantBuffers;
+
+  WriteGlobalConstants() = parentContext.ReadGlobalConstants();
+
+  // The command list starts with an empty state, so everything has to be applied again
+  m_StateFlags = parentContext.m_StateFlags;
+  m_StateFlags.Add(ezRenderContextFlags::AllStatesInvalid);
+
+  m_pGALPass = nullptr;
+  m_pGALCommandEncoder = m_pCommandList->BeginRecording();
+  m_pGALCommandEncoder->SetStateBatchingEnabled(CVarBatchStateChanges);
+  m_bCompute = false;
+
+  return GetRenderCommandEncoder();
+}
+
+void ezRenderContext::EndRecording()
+{
+  CollectCommandEncoderStatistics();
+
+  m_pCommandList->EndRecording();
+
+  m_pGALCommandEncoder = nullptr;
+}
+
+bool ezRenderContext::IsRecording() const
+{
+  return m_pCommandList != nullptr && m_pCommandList->IsRecording();
+}
+
+void ezRenderContext::ExecuteRecordedCommands(ezRenderContext& recordingContext)
+{
+  EZ_ASSERT_DEV(recordingContext.m_pParentContext == this, "The given context is not a recording context of this context");
+
+  auto pCommandEncoder = GetRenderCommandEncoder();
+
+  // Upload the deferred material constants of all recording contexts before the first command list is executed,
+  // since materials that are updated by one recording context might be used by all others as well.
+  for (ezRenderContext* pRecordingContext : m_RecordingContexts)
+  {
+    for (auto hConstantBufferStorage : pRecordingContext->m_DeferredConstantBufferUploads)
+    {
+      ezConstantBufferStorageBase* pConstantBufferStorage = nullptr;
+      if (TryGetConstantBufferStorage(hConstantBufferStorage, pConstantBufferStorage))
+      {
+        pConstantBufferStorage->UploadData(pCommandEncoder);
+      }
+    }
+
+    pRecordingContext->m_DeferredConstantBufferUploads.Clear();
+  }
+
+  pCommandEncoder->ExecuteCommandList(*recordingContext.m_pCommandList);
+
+  m_Statistics.m_uiExecutedCommandLists++;
+  m_Statistics.m_uiFailedDrawcalls += recordingContext.m_Statistics.m_uiFailedDrawcalls;
+  m_Statistics.m_uiStateChanges += recordingContext.m_Statistics.m_uiStateChanges;
+  m_Statistics.m_uiRedundantStateChanges += recordingContext.m_Statistics.m_uiRedundantStateChanges;
+  m_Statistics.m_uiAvoidedStateChanges += recordingContext.m_Statistics.m_uiAvoidedStateChanges;
+  recordingContext.m_Statistics.Reset();
+
+  // The executed commands have changed the state of the command encoder
+  m_StateFlags.Add(ezRenderContextFlags::AllStatesInvalid);
+}
+
 void ezRenderContext::SetShaderPermutationVariable(const char* szName, const ezTempHashedString& sTempValue)
 {
   ezTempHashedString sHashedName(szName);
@@ -831,10 +968,12 @@ void ezRenderContext::OnEngineShutdown()
 {
   ezShaderStageBinary::OnEngineShutdown();
 
-  for (auto rc : s_Instances)
-    EZ_DEFAULT_DELETE(rc);
-
-  s_Instances.Clear();
+  // Destroying a context also destroys its recording contexts, which removes them from the instances array
+  while (!s_Instances.IsEmpty())
+  {
+    ezRenderContext* pRenderContext = s_Instances.PeekBack();
+    EZ_DEFAULT_DELETE(pRenderContext);
+  }
 
   // Cleanup sampler states
   for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(s_hDefaultSamplerStates); ++i)
@@ -886,6 +1025,8 @@ ezResult ezRenderContext::BuildVertexDeclaration(ezGALShaderHandle hShader, cons
   svd.m_hShader = hShader;
   svd.m_uiVertexDeclarationHash = decl.m_uiHash;
 
+  EZ_LOCK(s_GALVertexDeclarationsMutex);
+
   bool bExisted = false;
   auto it = s_GALVertexDeclarations.FindOrAdd(svd, &bExisted);
 
@@ -945,9 +1086,22 @@ void ezRenderContext::UploadConstants()
 {
   BindConstantBuffer("ezGlobalConstants", m_hGlobalConstantBufferStorage);
 
+  const ezTempHashedString sMaterialConstants("ezMaterialConstants");
+
   for (auto it = m_BoundConstantBuffers.GetIterator(); it.IsValid(); ++it)
   {
     ezConstantBufferStorageHandle hConstantBufferStorage = it.Value().m_hConstantBufferStorage;
+
+    // Material constants are shared between contexts, recording contexts leave the upload to their parent context
+    if (m_pParentContext != nullptr && it.Key() == sMaterialConstants.GetHash() && !hConstantBufferStorage.IsInvalidated())
+    {
+      if (m_DeferredConstantBufferUploads.IsEmpty() || m_DeferredConstantBufferUploads.PeekBack() != hConstantBufferStorage)
+      {
+        m_DeferredConstantBufferUploads.PushBack(hConstantBufferStorage);
+      }
+      continue;
+    }
+
     ezConstantBufferStorageBase* pConstantBufferStorage = nullptr;
     if (TryGetConstantBufferStorage(hConstantBufferStorage, pConstantBufferStorage))
     {
@@ -956,6 +1110,15 @@ void ezRenderContext::UploadConstants()
   }
 }
 
+void ezRenderContext::CollectCommandEncoderStatistics()
+{
+  m_Statistics.m_uiStateChanges += m_pGALCommandEncoder->GetStateChangeCount();
+  m_Statistics.m_uiRedundantStateChanges += m_pGALCommandEncoder->GetRedundantStateChangeCount();
+  m_Statistics.m_uiAvoidedStateChanges += m_pGALCommandEncoder->GetAvoidedStateChangeCount();
+
+  m_pGALCommandEncoder->ClearStatisticsCounters();
+}
+
 void ezRenderContext::SetShaderPermutationVariableInternal(const ezHashedString& sName, const ezHashedString& sValue)
 {
   ezHashedString* pOldValue = nullptr;
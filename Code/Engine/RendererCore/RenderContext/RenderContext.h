@@ -4,6 +4,7 @@
 #include <Foundation/Containers/Map.h>
 #include <Foundation/Math/Rect.h>
 #include <Foundation/Strings/String.h>
+#include <Foundation/Types/UniquePtr.h>
 #include <RendererCore/Declarations.h>
 #include <RendererCore/Pipeline/ViewData.h>
 #include <RendererCore/RenderContext/Implementation/RenderContextStructs.h>
@@ -22,6 +23,7 @@
 #include <RendererCore/../../../Data/Base/Shaders/Common/GlobalConstants.h>
 
 struct ezRenderWorldRenderEvent;
+class ezGALCommandList;
 
 //////////////////////////////////////////////////////////////////////////
 // ezRenderContext
@@ -49,6 +51,12 @@ public:
     void Reset();
 
     ezUInt32 m_uiFailedDrawcalls;
+    ezUInt32 m_uiExecutedCommandLists; ///< Command lists of recording contexts, see ExecuteRecordedCommands()
+
+    // State changes of the GAL command encoder, see ezGALCommandEncoder::SetStateBatchingEnabled()
+    ezUInt32 m_uiStateChanges;
+    ezUInt32 m_uiRedundantStateChanges;
+    ezUInt32 m_uiAvoidedStateChanges;
   };
 
   Statistics GetAndResetStatistics();
@@ -120,6 +128,25 @@ public:
     return ComputeScope(*viewContext.m_pRenderContext, pGALPass, viewContext.m_pRenderContext->BeginCompute(pGALPass));
   }
 
+  /// \brief Returns a render context that records into its own command list, see BeginRecording().
+  ///
+  /// The recording contexts are created on demand and are owned by this context.
+  /// Different recording contexts can be used by different threads at the same time.
+  ezRenderContext* GetRecordingContext(ezUInt32 uiIndex);
+
+  /// \brief Starts recording draw calls into the command list of this context. Needs to be called on the render thread.
+  ///
+  /// The bindings, permutation variables and global constants of \a parentContext are copied, so this context starts out in the same state.
+  /// Between BeginRecording() and EndRecording() this context can be used on any thread. The recorded commands are executed
+  /// with ExecuteRecordedCommands() on the parent context afterwards.
+  ezGALRenderCommandEncoder* BeginRecording(ezRenderContext& parentContext);
+  void EndRecording();
+
+  bool IsRecording() const;
+
+  /// \brief Executes the commands that have been recorded by \a recordingContext on the current render command encoder.
+  void ExecuteRecordedCommands(ezRenderContext& recordingContext);
+
   EZ_ALWAYS_INLINE ezGALCommandEncoder* GetCommandEncoder()
   {
     EZ_ASSERT_DEBUG(m_pGALCommandEncoder != nullptr, "BeginRendering/Compute has not been called");
@@ -340,6 +367,7 @@ private:
 
   static ezResult BuildVertexDeclaration(ezGALShaderHandle hShader, const ezVertexDeclarationInfo& decl, ezGALVertexDeclarationHandle& out_Declaration);
 
+  static ezMutex s_GALVertexDeclarationsMutex;
   static ezMap<ShaderVertexDecl, ezGALVertexDeclarationHandle> s_GALVertexDeclarations;
 
   static ezMutex s_ConstantBufferStorageMutex;
@@ -358,8 +386,17 @@ private: // Per Renderer States
   ezGALCommandEncoder* m_pGALCommandEncoder = nullptr;
   bool m_bCompute = false;
 
+  // Recording
+  ezRenderContext* m_pParentContext = nullptr;
+  ezDynamicArray<ezRenderContext*> m_RecordingContexts;
+  ezUniquePtr<ezGALCommandList> m_pCommandList;
+
+  // Material constants are shared between all contexts, recording contexts leave their upload to the parent context
+  ezDynamicArray<ezConstantBufferStorageHandle> m_DeferredConstantBufferUploads;
+
   // Member Functions
   void UploadConstants();
+  void CollectCommandEncoderStatistics();
 
   void SetShaderPermutationVariableInternal(const ezHashedString& sName, const ezHashedString& sValue);
   void BindShaderInternal(const ezShaderResourceHandle& hShader, ezBitflags<ezShaderBindFlags> flags);
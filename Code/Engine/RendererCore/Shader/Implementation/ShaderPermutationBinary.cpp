@@ -11,6 +11,7 @@ struct ezShaderPermutationBinaryVersion
     Version3 = 3,
     Version4 = 4,
     Version5 = 5,
+    Version6 = 6, // Compile hash
 
     // Increase this version number to trigger shader recompilation
 
@@ -23,6 +24,8 @@ ezShaderPermutationBinary::ezShaderPermutationBinary()
 {
   for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
     m_uiShaderStageHashes[stage] = 0;
+
+  m_uiCompileHash = 0;
 }
 
 ezResult ezShaderPermutationBinary::Write(ezStreamWriter& Stream)
@@ -52,6 +55,8 @@ ezResult ezShaderPermutationBinary::Write(ezStreamWriter& Stream)
     Stream << var.m_sValue.GetString();
   }
 
+  Stream << m_uiCompileHash;
+
   return EZ_SUCCESS;
 }
 
@@ -95,6 +100,11 @@ ezResult ezShaderPermutationBinary::Read(ezStreamReader& Stream, bool& out_bOldV
     }
   }
 
+  if (uiVersion >= ezShaderPermutationBinaryVersion::Version6)
+  {
+    Stream >> m_uiCompileHash;
+  }
+
   return EZ_SUCCESS;
 }
 
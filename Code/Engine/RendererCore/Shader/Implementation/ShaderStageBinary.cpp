@@ -154,6 +154,7 @@ ezShaderResourceBinding::~ezShaderResourceBinding() {}
 //////////////////////////////////////////////////////////////////////////
 
 ezMap<ezUInt32, ezShaderStageBinary> ezShaderStageBinary::s_ShaderStageBinaries[ezGALShaderStage::ENUM_COUNT];
+ezMutex ezShaderStageBinary::s_ShaderStageBinariesMutex;
 
 ezShaderStageBinary::ezShaderStageBinary() = default;
 
@@ -332,6 +333,10 @@ ezResult ezShaderStageBinary::WriteStageBinary(ezLogInterface* pLog) const
   sShaderStageFile.AppendPath(ezShaderManager::GetActivePlatform().GetData());
   sShaderStageFile.AppendFormat("/{0}_{1}.ezShaderStage", ezGALShaderStage::Names[m_Stage], ezArgU(m_uiSourceHash, 8, true, 16, true));
 
+  // permutations that end up with the same stage source may be compiled in parallel
+  // holding the lock while writing ensures that LoadStageBinary() never sees a partially written file
+  EZ_LOCK(s_ShaderStageBinariesMutex);
+
   ezFileWriter StageFileOut;
   if (StageFileOut.Open(sShaderStageFile.GetData()).Failed())
   {
@@ -351,6 +356,8 @@ ezResult ezShaderStageBinary::WriteStageBinary(ezLogInterface* pLog) const
 // static
 ezShaderStageBinary* ezShaderStageBinary::LoadStageBinary(ezGALShaderStage::Enum Stage, ezUInt32 uiHash)
 {
+  EZ_LOCK(s_ShaderStageBinariesMutex);
+
   auto itStage = s_ShaderStageBinaries[Stage].Find(uiHash);
 
   if (!itStage.IsValid())
@@ -395,6 +402,8 @@ ezShaderStageBinary* ezShaderStageBinary::LoadStageBinary(ezGALShaderStage::Enum
 // static
 void ezShaderStageBinary::OnEngineShutdown()
 {
+  EZ_LOCK(s_ShaderStageBinariesMutex);
+
   for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
   {
     s_ShaderStageBinaries[stage].Clear();
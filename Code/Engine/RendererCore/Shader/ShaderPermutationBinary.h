@@ -33,4 +33,9 @@ public:
   ezShaderStateResourceDescriptor m_StateDescriptor;
 
   ezHybridArray<ezPermutationVar, 16> m_PermutationVars;
+
+  /// \brief Hash over everything that went into compiling this permutation, apart from the included files (see ezShaderCompiler).
+  ///
+  /// Together with m_DependencyFile this allows the shader compiler to skip permutations that are already up to date.
+  ezUInt64 m_uiCompileHash;
 };
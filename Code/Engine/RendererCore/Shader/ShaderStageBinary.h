@@ -4,6 +4,7 @@
 #include <Foundation/Containers/Map.h>
 #include <Foundation/IO/Stream.h>
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/Mutex.h>
 #include <Foundation/Types/Enum.h>
 #include <RendererCore/RendererCoreDLL.h>
 #include <RendererFoundation/Descriptors/Descriptors.h>
@@ -156,4 +157,5 @@ private:
   static void OnEngineShutdown();
 
   static ezMap<ezUInt32, ezShaderStageBinary> s_ShaderStageBinaries[ezGALShaderStage::ENUM_COUNT];
+  static ezMutex s_ShaderStageBinariesMutex; ///< Stage binaries are loaded and written by concurrent shader compile and resource loading jobs
 };
@@ -92,9 +92,40 @@ namespace
   static const char* s_szStageDefines[ezGALShaderStage::ENUM_COUNT] = {"VERTEX_SHADER", "HULL_SHADER", "DOMAIN_SHADER", "GEOMETRY_SHADER", "PIXEL_SHADER", "COMPUTE_SHADER"};
 } // namespace
 
+ezShaderCompiler::ezShaderCompiler(ezTokenizedFileCache* pSharedFileCache)
+{
+  m_pFileCache = pSharedFileCache != nullptr ? pSharedFileCache : &m_FileCache;
+}
+
+ezResult ezShaderCompiler::FileLocator(const char* szCurAbsoluteFile, const char* szIncludeFile, ezPreprocessor::IncludeType IncType, ezStringBuilder& out_sAbsoluteFilePath)
+{
+  ezStringBuilder& s = out_sAbsoluteFilePath;
+
+  if (IncType == ezPreprocessor::RelativeInclude)
+  {
+    s = szCurAbsoluteFile;
+    s.PathParentDirectory();
+    s.AppendPath(szIncludeFile);
+    s.MakeCleanPath();
+  }
+  else
+  {
+    s = szIncludeFile;
+    s.MakeCleanPath();
+  }
+
+  // includes are recorded here and not in FileOpen(), because files that are already in the (shared) file cache are never opened again
+  if (IncType != ezPreprocessor::MainFile)
+  {
+    m_IncludeFiles.Insert(s);
+  }
+
+  return EZ_SUCCESS;
+}
+
 ezResult ezShaderCompiler::FileOpen(const char* szAbsoluteFile, ezDynamicArray<ezUInt8>& FileContent, ezTimestamp& out_FileModification)
 {
-  if (ezStringUtils::IsEqual(szAbsoluteFile, "ShaderRenderState"))
+  if (m_StateSourceFile == szAbsoluteFile)
   {
     const ezString& sData = m_ShaderData.m_StateSource;
     const ezUInt32 uiCount = sData.GetElementCount();
@@ -129,8 +160,6 @@ ezResult ezShaderCompiler::FileOpen(const char* szAbsoluteFile, ezDynamicArray<e
     }
   }
 
-  m_IncludeFiles.Insert(szAbsoluteFile);
-
   ezFileReader r;
   if (r.Open(szAbsoluteFile).Failed())
   {
@@ -168,6 +197,8 @@ ezResult ezShaderCompiler::CompileShaderPermutationForPlatforms(const char* szFi
     sFileContent.ReadAll(File);
   }
 
+  m_uiShaderFileHash = ezHashingUtils::xxHash64(sFileContent.GetData(), sFileContent.GetElementCount());
+
   ezShaderHelper::ezTextSectionizer Sections;
   ezShaderHelper::GetShaderSections(sFileContent.GetData(), Sections);
 
@@ -239,6 +270,10 @@ ezResult ezShaderCompiler::CompileShaderPermutationForPlatforms(const char* szFi
   ezStringBuilder tmp = szFile;
   tmp.MakeCleanPath();
 
+  // the virtual files must have unique names, as the file cache may be shared with compilers for other shaders
+  m_StateSourceFile = tmp;
+  m_StateSourceFile.ChangeFileExtension("renderstate");
+
   m_StageSourceFile[ezGALShaderStage::VertexShader] = tmp;
   m_StageSourceFile[ezGALShaderStage::VertexShader].ChangeFileExtension("vs");
 
@@ -318,15 +353,43 @@ ezResult ezShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
     GenerateDefines(Platforms[p].GetData(), m_ShaderData.m_Permutations, defines);
     GenerateDefines(Platforms[p].GetData(), m_ShaderData.m_FixedPermVars, defines);
 
+    ezStringBuilder sPermutationFile = ezShaderManager::GetCacheDirectory();
+    sPermutationFile.AppendPath(Platforms[p].GetData());
+    sPermutationFile.AppendPath(szFile);
+    sPermutationFile.ChangeFileExtension("");
+    if (sPermutationFile.EndsWith("."))
+      sPermutationFile.Shrink(0, 1);
+
+    const ezUInt32 uiPermutationHash = ezShaderHelper::CalculateHash(m_ShaderData.m_Permutations);
+    sPermutationFile.AppendFormat("_{0}.ezPermutation", ezArgU(uiPermutationHash, 8, true, 16, true));
+
+    // everything that determines the preprocessed source, except for the included files, which are tracked through the dependency file
+    ezUInt64 uiCompileHash = m_uiShaderFileHash;
+    for (const ezString& define : defines)
+    {
+      uiCompileHash = ezHashingUtils::xxHash64String(define, uiCompileHash);
+    }
+    uiCompileHash = ezHashingUtils::xxHash64String(pCompiler->GetDynamicRTTI()->GetTypeName(), uiCompileHash);
+    const ezUInt8 uiFlags = spd.m_Flags.GetValue();
+    uiCompileHash = ezHashingUtils::xxHash64(&uiFlags, sizeof(uiFlags), uiCompileHash);
+
+    if (IsPermutationUpToDate(sPermutationFile, uiCompileHash))
+    {
+      ezLog::Dev(pLog, "Permutation is up to date: '{0}'", sPermutationFile);
+      continue;
+    }
+
     ezShaderPermutationBinary shaderPermutationBinary;
+    shaderPermutationBinary.m_uiCompileHash = uiCompileHash;
 
     // Generate Shader State Source
     {
       EZ_LOG_BLOCK(pLog, "Preprocessing Shader State Source");
 
       ezPreprocessor pp;
-      pp.SetCustomFileCache(&m_FileCache);
+      pp.SetCustomFileCache(m_pFileCache);
       pp.SetLogInterface(ezLog::GetThreadLocalLogSystem());
+      pp.SetFileLocatorFunction(ezPreprocessor::FileLocatorCB(&ezShaderCompiler::FileLocator, this));
       pp.SetFileOpenFunction(ezPreprocessor::FileOpenCB(&ezShaderCompiler::FileOpen, this));
       pp.SetPassThroughPragma(false);
       pp.SetPassThroughLine(false);
@@ -347,7 +410,7 @@ ezResult ezShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
       });
 
       ezStringBuilder sOutput;
-      if (pp.Process("ShaderRenderState", sOutput, false).Failed() || bFoundUndefinedVars)
+      if (pp.Process(m_StateSourceFile, sOutput, false).Failed() || bFoundUndefinedVars)
       {
         ezLog::Error(pLog, "Preprocessing the Shader State block failed");
         return EZ_FAILURE;
@@ -373,8 +436,9 @@ ezResult ezShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
       bool bFoundUndefinedVars = false;
 
       ezPreprocessor pp;
-      pp.SetCustomFileCache(&m_FileCache);
+      pp.SetCustomFileCache(m_pFileCache);
       pp.SetLogInterface(ezLog::GetThreadLocalLogSystem());
+      pp.SetFileLocatorFunction(ezPreprocessor::FileLocatorCB(&ezShaderCompiler::FileLocator, this));
       pp.SetFileOpenFunction(ezPreprocessor::FileOpenCB(&ezShaderCompiler::FileOpen, this));
       pp.SetPassThroughPragma(true);
       pp.SetPassThroughUnknownCmdsCB(ezMakeDelegate(&ezShaderCompiler::PassThroughUnknownCommandCB, this));
@@ -452,16 +516,6 @@ ezResult ezShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
       }
     }
 
-    ezStringBuilder sTemp = ezShaderManager::GetCacheDirectory();
-    sTemp.AppendPath(Platforms[p].GetData());
-    sTemp.AppendPath(szFile);
-    sTemp.ChangeFileExtension("");
-    if (sTemp.EndsWith("."))
-      sTemp.Shrink(0, 1);
-
-    const ezUInt32 uiPermutationHash = ezShaderHelper::CalculateHash(m_ShaderData.m_Permutations);
-    sTemp.AppendFormat("_{0}.ezPermutation", ezArgU(uiPermutationHash, 8, true, 16, true));
-
     shaderPermutationBinary.m_DependencyFile.Clear();
     shaderPermutationBinary.m_DependencyFile.AddFileDependency(szFile);
 
@@ -473,12 +527,12 @@ ezResult ezShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
     shaderPermutationBinary.m_PermutationVars = m_ShaderData.m_Permutations;
 
     ezDeferredFileWriter PermutationFileOut;
-    PermutationFileOut.SetOutput(sTemp.GetData());
+    PermutationFileOut.SetOutput(sPermutationFile.GetData());
     EZ_SUCCEED_OR_RETURN(shaderPermutationBinary.Write(PermutationFileOut));
 
     if (PermutationFileOut.Close().Failed())
     {
-      ezLog::Error(pLog, "Could not open file for writing: '{0}'", sTemp);
+      ezLog::Error(pLog, "Could not open file for writing: '{0}'", sPermutationFile);
       return EZ_FAILURE;
     }
   }
@@ -486,6 +540,34 @@ ezResult ezShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
   return EZ_SUCCESS;
 }
 
+bool ezShaderCompiler::IsPermutationUpToDate(const char* szPermutationFile, ezUInt64 uiCompileHash)
+{
+  ezFileReader PermutationFileIn;
+  if (PermutationFileIn.Open(szPermutationFile).Failed())
+    return false;
+
+  ezShaderPermutationBinary permutationBinary;
+  bool bOldVersion = false;
+  if (permutationBinary.Read(PermutationFileIn, bOldVersion).Failed() || bOldVersion)
+    return false;
+
+  if (permutationBinary.m_uiCompileHash != uiCompileHash || permutationBinary.m_DependencyFile.HasAnyFileChanged())
+    return false;
+
+  // the stage binaries may have been deleted from the cache independently
+  for (ezUInt32 stage = ezGALShaderStage::VertexShader; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    const ezUInt32 uiStageHash = permutationBinary.m_uiShaderStageHashes[stage];
+    if (uiStageHash == 0)
+      continue;
+
+    ezShaderStageBinary* pBinary = ezShaderStageBinary::LoadStageBinary((ezGALShaderStage::Enum)stage, uiStageHash);
+    if (pBinary == nullptr || pBinary->GetByteCode().IsEmpty())
+      return false;
+  }
+
+  return true;
+}
 
 void ezShaderCompiler::WriteFailedShaderSource(ezShaderProgramCompiler::ezShaderProgramData& spd, ezLogInterface* pLog)
 {
@@ -106,6 +106,7 @@ namespace
   }
 
   static ezHashTable<ezUInt64, ezString> s_PermutationPaths;
+  static ezMutex s_PermutationPathsMutex;
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -332,21 +333,29 @@ ezShaderPermutationResourceHandle ezShaderManager::PreloadSinglePermutationInter
 {
   const ezUInt64 uiPermutationKey = (ezUInt64)ezHashingUtils::StringHashTo32(uiResourceIdHash) << 32 | uiPermutationHash;
 
-  ezString* pPermutationPath = &s_PermutationPaths[uiPermutationKey];
-  if (pPermutationPath->IsEmpty())
+  // Permutations are also requested by render contexts that record on worker threads
+  ezStringBuilder sPermutationPath;
   {
-    ezStringBuilder sShaderFile = GetCacheDirectory();
-    sShaderFile.AppendPath(GetActivePlatform().GetData());
-    sShaderFile.AppendPath(szResourceId);
-    sShaderFile.ChangeFileExtension("");
-    if (sShaderFile.EndsWith("."))
-      sShaderFile.Shrink(0, 1);
-    sShaderFile.AppendFormat("_{0}.ezPermutation", ezArgU(uiPermutationHash, 8, true, 16, true));
-
-    *pPermutationPath = sShaderFile;
+    EZ_LOCK(s_PermutationPathsMutex);
+
+    ezString* pPermutationPath = &s_PermutationPaths[uiPermutationKey];
+    if (pPermutationPath->IsEmpty())
+    {
+      ezStringBuilder sShaderFile = GetCacheDirectory();
+      sShaderFile.AppendPath(GetActivePlatform().GetData());
+      sShaderFile.AppendPath(szResourceId);
+      sShaderFile.ChangeFileExtension("");
+      if (sShaderFile.EndsWith("."))
+        sShaderFile.Shrink(0, 1);
+      sShaderFile.AppendFormat("_{0}.ezPermutation", ezArgU(uiPermutationHash, 8, true, 16, true));
+
+      *pPermutationPath = sShaderFile;
+    }
+
+    sPermutationPath = *pPermutationPath;
   }
 
-  ezShaderPermutationResourceHandle hShaderPermutation = ezResourceManager::LoadResource<ezShaderPermutationResource>(pPermutationPath->GetData());
+  ezShaderPermutationResourceHandle hShaderPermutation = ezResourceManager::LoadResource<ezShaderPermutationResource>(sPermutationPath);
 
   {
     ezResourceLock<ezShaderPermutationResource> pShaderPermutation(hShaderPermutation, ezResourceAcquireMode::PointerOnly);
@@ -64,12 +64,24 @@ public:
 class EZ_RENDERERCORE_DLL ezShaderCompiler
 {
 public:
+  /// \brief If \a pSharedFileCache is given, included files are tokenized only once for all compilers that share the cache.
+  ///
+  /// The cache is thread-safe, so several compilers may use it to compile permutations in parallel. It must outlive the compiler.
+  /// Without a shared cache each compiler uses its own.
+  ezShaderCompiler(ezTokenizedFileCache* pSharedFileCache = nullptr);
+
+  /// \brief Compiles one permutation of the given shader for all requested platforms.
+  ///
+  /// Platforms for which the cached .ezPermutation file was written from the same shader source, permutation defines and compiler,
+  /// and whose included files have not changed since, are skipped without preprocessing or compiling anything.
   ezResult CompileShaderPermutationForPlatforms(
     const char* szFile, const ezArrayPtr<const ezPermutationVar>& permutationVars, ezLogInterface* pLog, const char* szPlatform = "ALL");
 
 private:
   ezResult RunShaderCompiler(const char* szFile, const char* szPlatform, ezShaderProgramCompiler* pCompiler, ezLogInterface* pLog);
 
+  bool IsPermutationUpToDate(const char* szPermutationFile, ezUInt64 uiCompileHash);
+
   void WriteFailedShaderSource(ezShaderProgramCompiler::ezShaderProgramData& spd, ezLogInterface* pLog);
 
   bool PassThroughUnknownCommandCB(const char* szCmd) { return ezStringUtils::IsEqual(szCmd, "version"); }
@@ -83,12 +95,16 @@ private:
     ezString m_ShaderStageSource[ezGALShaderStage::ENUM_COUNT];
   };
 
+  ezResult FileLocator(const char* szCurAbsoluteFile, const char* szIncludeFile, ezPreprocessor::IncludeType IncType, ezStringBuilder& out_sAbsoluteFilePath);
   ezResult FileOpen(const char* szAbsoluteFile, ezDynamicArray<ezUInt8>& FileContent, ezTimestamp& out_FileModification);
 
+  ezStringBuilder m_StateSourceFile;
   ezStringBuilder m_StageSourceFile[ezGALShaderStage::ENUM_COUNT];
 
   ezTokenizedFileCache m_FileCache;
+  ezTokenizedFileCache* m_pFileCache;
   ezShaderData m_ShaderData;
+  ezUInt64 m_uiShaderFileHash = 0;
 
   ezSet<ezString> m_IncludeFiles;
 };
@@ -74,12 +74,32 @@ public:
   void PopMarker();
   void InsertEventMarker(const char* Marker);
 
+  /// \brief Enables or disables the batching of state changes.
+  ///
+  /// While enabled, shaders, constant buffers, sampler states, geometry and render states are not passed to the platform
+  /// immediately. The binds are accumulated until the next draw or dispatch and only the ones that differ from the state that
+  /// is already bound on the platform are applied then. Binds that are overwritten before they are used, or that switch back
+  /// to the bound state, never reach the platform. Resource views and unordered access views are always bound immediately
+  /// since they are needed to resolve resource hazards.
+  void SetStateBatchingEnabled(bool bEnable);
+  bool IsStateBatchingEnabled() const { return m_bStateBatching; }
+
+  /// \brief Returns the number of state changes that have been passed to the platform.
+  ezUInt32 GetStateChangeCount() const { return m_uiStateChanges; }
+
+  /// \brief Returns the number of state changes that were skipped because the state was already set.
+  ezUInt32 GetRedundantStateChangeCount() const { return m_uiRedundantStateChanges; }
+
+  /// \brief Returns the number of binds that were avoided by state batching, because they were overwritten or reverted before the next draw or dispatch.
+  ezUInt32 GetAvoidedStateChangeCount() const { return m_uiAvoidedStateChanges; }
+
   virtual void ClearStatisticsCounters();
 
   EZ_ALWAYS_INLINE ezGALDevice& GetDevice() { return m_Device; }
 
 protected:
   friend class ezGALDevice;
+  friend class ezGALCommandList;
 
   ezGALCommandEncoder(ezGALDevice& device, ezGALCommandEncoderState& state, ezGALCommandEncoderCommonPlatformInterface& commonImpl);
   virtual ~ezGALCommandEncoder();
@@ -89,11 +109,55 @@ protected:
 
   void AssertRenderingThread()
   {
-    EZ_ASSERT_DEV(ezThreadUtils::IsMainThread(), "This function can only be executed on the main thread.");
+    EZ_ASSERT_DEV(m_bRecordsCommandList || ezThreadUtils::IsMainThread(), "This function can only be executed on the main thread.");
   }
 
   void CountStateChange() { m_uiStateChanges++; }
   void CountRedundantStateChange() { m_uiRedundantStateChanges++; }
+  void CountAvoidedStateChange() { m_uiAvoidedStateChanges++; }
+
+  /// \brief Records a state change while state batching is enabled.
+  ///
+  /// Returns true if the new value needs to be stored as pending value, which is the case when it differs from the bound state.
+  bool DeferStateChange(ezUInt32& uiPendingMask, ezUInt32 uiPendingBit, bool bEqualsPending, bool bEqualsBound)
+  {
+    const bool bIsPending = (uiPendingMask & uiPendingBit) != 0;
+    if (bIsPending ? bEqualsPending : bEqualsBound)
+    {
+      CountRedundantStateChange();
+      return false;
+    }
+
+    // The previously pending value is replaced before it has been used
+    if (bIsPending)
+    {
+      CountAvoidedStateChange();
+    }
+
+    if (bEqualsBound)
+    {
+      uiPendingMask &= ~uiPendingBit;
+      return false;
+    }
+
+    uiPendingMask |= uiPendingBit;
+    return true;
+  }
+
+  /// \brief Passes all pending state changes to the platform, needs to be called before every draw or dispatch.
+  EZ_ALWAYS_INLINE void FlushPendingStateChanges()
+  {
+    if (m_bStateBatching)
+    {
+      ApplyPendingState();
+    }
+  }
+
+  virtual void ApplyPendingState();
+
+  bool m_bStateBatching = false;
+
+  ezGALCommandEncoderCommonPlatformInterface& m_CommonImpl;
 
 private:
   friend class ezMemoryUtils;
@@ -104,8 +168,14 @@ private:
   // Statistic variables
   ezUInt32 m_uiStateChanges = 0;
   ezUInt32 m_uiRedundantStateChanges = 0;
+  ezUInt32 m_uiAvoidedStateChanges = 0;
+
+  void ApplyShader(ezGALShaderHandle hShader);
+  void ApplyConstantBuffer(ezUInt32 uiSlot, ezGALBufferHandle hBuffer);
+  void ApplySamplerState(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, ezGALSamplerStateHandle hSamplerState);
 
   ezGALCommandEncoderState& m_State;
 
-  ezGALCommandEncoderCommonPlatformInterface& m_CommonImpl;
+  // Encoders of command lists may be used on any thread
+  bool m_bRecordsCommandList = false;
 };
@@ -20,6 +20,30 @@ struct EZ_RENDERERFOUNDATION_DLL ezGALCommandEncoderState
   ezHybridArray<const ezGALResourceBase*, 16> m_pResourcesForUnorderedAccessViews;
 
   ezGALSamplerStateHandle m_hSamplerStates[ezGALShaderStage::ENUM_COUNT][EZ_GAL_MAX_SAMPLER_COUNT];
+
+  // Binds that have been requested while state batching is enabled, but have not been passed to the platform yet.
+  // The masks have one bit per slot, the pending values are only valid if the corresponding bit is set.
+  // See ezGALCommandEncoder::SetStateBatchingEnabled()
+
+  enum PendingFlags : ezUInt32
+  {
+    PendingShader = EZ_BIT(0),
+    PendingIndexBuffer = EZ_BIT(1),
+    PendingVertexDeclaration = EZ_BIT(2),
+    PendingTopology = EZ_BIT(3),
+    PendingBlendState = EZ_BIT(4),
+    PendingDepthStencilState = EZ_BIT(5),
+    PendingRasterizerState = EZ_BIT(6),
+  };
+
+  ezUInt32 m_uiPendingFlags = 0;
+  ezGALShaderHandle m_hPendingShader;
+
+  ezUInt32 m_uiPendingConstantBuffers = 0;
+  ezGALBufferHandle m_hPendingConstantBuffers[EZ_GAL_MAX_CONSTANT_BUFFER_COUNT];
+
+  ezUInt32 m_uiPendingSamplerStates[ezGALShaderStage::ENUM_COUNT] = {};
+  ezGALSamplerStateHandle m_hPendingSamplerStates[ezGALShaderStage::ENUM_COUNT][EZ_GAL_MAX_SAMPLER_COUNT];
 };
 
 struct EZ_RENDERERFOUNDATION_DLL ezGALCommandEncoderRenderState : public ezGALCommandEncoderState
@@ -45,4 +69,22 @@ struct EZ_RENDERERFOUNDATION_DLL ezGALCommandEncoderRenderState : public ezGALCo
   ezRectFloat m_ViewPortRect = ezRectFloat(ezMath::MaxValue<float>(), ezMath::MaxValue<float>(), 0.0f, 0.0f);
   float m_fViewPortMinDepth = ezMath::MaxValue<float>();
   float m_fViewPortMaxDepth = -ezMath::MaxValue<float>();
+
+  // Pending binds, see ezGALCommandEncoderState
+
+  ezUInt32 m_uiPendingVertexBuffers = 0;
+  ezGALBufferHandle m_hPendingVertexBuffers[EZ_GAL_MAX_VERTEX_BUFFER_COUNT];
+  ezGALBufferHandle m_hPendingIndexBuffer;
+
+  ezGALVertexDeclarationHandle m_hPendingVertexDeclaration;
+  ezGALPrimitiveTopology::Enum m_PendingTopology = ezGALPrimitiveTopology::ENUM_COUNT;
+
+  ezGALBlendStateHandle m_hPendingBlendState;
+  ezColor m_PendingBlendFactor = ezColor(0, 0, 0, 0);
+  ezUInt32 m_uiPendingSampleMask = 0;
+
+  ezGALDepthStencilStateHandle m_hPendingDepthStencilState;
+  ezUInt8 m_uiPendingStencilRefValue = 0;
+
+  ezGALRasterizerStateHandle m_hPendingRasterizerState;
 };
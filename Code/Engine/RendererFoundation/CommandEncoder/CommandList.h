@@ -0,0 +1,130 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Types/UniquePtr.h>
+#include <RendererFoundation/CommandEncoder/RenderCommandEncoder.h>
+
+/// \brief Records the commands of a render command encoder so that they can be executed later.
+///
+/// A command list provides its own render command encoder, which can be used on any thread between BeginRecording() and EndRecording().
+/// The recorded commands are executed on the render thread with ezGALRenderCommandEncoder::ExecuteCommandList(). Several command lists
+/// can thus be recorded in parallel and are then executed in the desired order.
+///
+/// The commands are replayed through the platform interfaces of the executing encoder, which works with every backend.
+/// Commands that need an immediate result (fences, query results and texture readback) can't be recorded.
+/// All resources that are used by recorded commands must stay alive until the command list has been executed.
+class EZ_RENDERERFOUNDATION_DLL ezGALCommandList : public ezGALCommandEncoderCommonPlatformInterface, public ezGALCommandEncoderRenderPlatformInterface
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezGALCommandList);
+
+public:
+  ezGALCommandList(ezGALDevice& device);
+  ~ezGALCommandList();
+
+  /// \brief Clears all previously recorded commands and returns the encoder to record new ones.
+  ///
+  /// The state of the returned encoder is invalidated, so every state that the recorded commands rely on has to be set again.
+  ezGALRenderCommandEncoder* BeginRecording();
+  void EndRecording();
+
+  /// \brief Removes all recorded commands.
+  void Clear();
+
+  bool IsRecording() const { return m_bRecording; }
+  bool IsEmpty() const { return m_uiCommandCount == 0; }
+  ezUInt32 GetCommandCount() const { return m_uiCommandCount; }
+  ezUInt32 GetDrawCallCount() const { return m_uiDrawCallCount; }
+
+  /// \brief Executes all recorded commands in order through the given platform interfaces.
+  void Replay(ezGALCommandEncoderCommonPlatformInterface& commonImpl, ezGALCommandEncoderRenderPlatformInterface& renderImpl) const;
+
+private:
+  /// \brief Appends a command of type T followed by the given amount of inline data, e.g. the source data of a buffer update.
+  template <typename T>
+  T& AddCommand(ezUInt32 uiInlineDataSize = 0);
+
+  // ezGALCommandEncoderCommonPlatformInterface
+
+  virtual void SetShaderPlatform(const ezGALShader* pShader) override;
+
+  virtual void SetConstantBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer) override;
+  virtual void SetSamplerStatePlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALSamplerState* pSamplerState) override;
+  virtual void SetResourceViewPlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALResourceView* pResourceView) override;
+  virtual void SetUnorderedAccessViewPlatform(ezUInt32 uiSlot, const ezGALUnorderedAccessView* pUnorderedAccessView) override;
+
+  virtual void InsertFencePlatform(const ezGALFence* pFence) override;
+  virtual bool IsFenceReachedPlatform(const ezGALFence* pFence) override;
+  virtual void WaitForFencePlatform(const ezGALFence* pFence) override;
+
+  virtual void BeginQueryPlatform(const ezGALQuery* pQuery) override;
+  virtual void EndQueryPlatform(const ezGALQuery* pQuery) override;
+  virtual ezResult GetQueryResultPlatform(const ezGALQuery* pQuery, ezUInt64& uiQueryResult) override;
+
+  virtual void InsertTimestampPlatform(ezGALTimestampHandle hTimestamp) override;
+
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4 clearValues) override;
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4U32 clearValues) override;
+
+  virtual void CopyBufferPlatform(const ezGALBuffer* pDestination, const ezGALBuffer* pSource) override;
+  virtual void CopyBufferRegionPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, const ezGALBuffer* pSource, ezUInt32 uiSourceOffset, ezUInt32 uiByteCount) override;
+
+  virtual void UpdateBufferPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, ezArrayPtr<const ezUInt8> pSourceData, ezGALUpdateMode::Enum updateMode) override;
+
+  virtual void CopyTexturePlatform(const ezGALTexture* pDestination, const ezGALTexture* pSource) override;
+  virtual void CopyTextureRegionPlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource, const ezVec3U32& DestinationPoint, const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource, const ezBoundingBoxu32& Box) override;
+
+  virtual void UpdateTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource, const ezBoundingBoxu32& DestinationBox, const ezGALSystemMemoryDescription& pSourceData) override;
+
+  virtual void ResolveTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource, const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource) override;
+
+  virtual void ReadbackTexturePlatform(const ezGALTexture* pTexture) override;
+
+  virtual void CopyTextureReadbackResultPlatform(const ezGALTexture* pTexture, ezArrayPtr<ezGALTextureSubresource> SourceSubResource, ezArrayPtr<ezGALSystemMemoryDescription> TargetData) override;
+
+  virtual void GenerateMipMapsPlatform(const ezGALResourceView* pResourceView) override;
+
+  virtual void FlushPlatform() override;
+
+  virtual void PushMarkerPlatform(const char* Marker) override;
+  virtual void PopMarkerPlatform() override;
+  virtual void InsertEventMarkerPlatform(const char* Marker) override;
+
+  // ezGALCommandEncoderRenderPlatformInterface
+
+  virtual void ClearPlatform(const ezColor& ClearColor, ezUInt32 uiRenderTargetClearMask, bool bClearDepth, bool bClearStencil, float fDepthClear, ezUInt8 uiStencilClear) override;
+
+  virtual void DrawPlatform(ezUInt32 uiVertexCount, ezUInt32 uiStartVertex) override;
+  virtual void DrawIndexedPlatform(ezUInt32 uiIndexCount, ezUInt32 uiStartIndex) override;
+  virtual void DrawIndexedInstancedPlatform(ezUInt32 uiIndexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartIndex) override;
+  virtual void DrawIndexedInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+  virtual void DrawInstancedPlatform(ezUInt32 uiVertexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartVertex) override;
+  virtual void DrawInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+  virtual void DrawAutoPlatform() override;
+
+  virtual void BeginStreamOutPlatform() override;
+  virtual void EndStreamOutPlatform() override;
+
+  virtual void SetIndexBufferPlatform(const ezGALBuffer* pIndexBuffer) override;
+  virtual void SetVertexBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pVertexBuffer) override;
+  virtual void SetVertexDeclarationPlatform(const ezGALVertexDeclaration* pVertexDeclaration) override;
+  virtual void SetPrimitiveTopologyPlatform(ezGALPrimitiveTopology::Enum Topology) override;
+
+  virtual void SetBlendStatePlatform(const ezGALBlendState* pBlendState, const ezColor& BlendFactor, ezUInt32 uiSampleMask) override;
+  virtual void SetDepthStencilStatePlatform(const ezGALDepthStencilState* pDepthStencilState, ezUInt8 uiStencilRefValue) override;
+  virtual void SetRasterizerStatePlatform(const ezGALRasterizerState* pRasterizerState) override;
+
+  virtual void SetViewportPlatform(const ezRectFloat& rect, float fMinDepth, float fMaxDepth) override;
+  virtual void SetScissorRectPlatform(const ezRectU32& rect) override;
+
+  virtual void SetStreamOutBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer, ezUInt32 uiOffset) override;
+
+  ezGALDevice& m_Device;
+
+  ezGALCommandEncoderRenderState m_State;
+  ezUniquePtr<ezGALRenderCommandEncoder> m_pEncoder;
+
+  ezDynamicArray<ezUInt8, ezAlignedAllocatorWrapper> m_Commands;
+  ezUInt32 m_uiCommandCount = 0;
+  ezUInt32 m_uiDrawCallCount = 0;
+  bool m_bRecording = false;
+};
@@ -14,19 +14,22 @@ void ezGALCommandEncoder::SetShader(ezGALShaderHandle hShader)
   AssertRenderingThread();
   /// \todo Assert for shader capabilities (supported shader stages etc.)
 
+  if (m_bStateBatching)
+  {
+    if (DeferStateChange(m_State.m_uiPendingFlags, ezGALCommandEncoderState::PendingShader, m_State.m_hPendingShader == hShader, m_State.m_hShader == hShader))
+    {
+      m_State.m_hPendingShader = hShader;
+    }
+    return;
+  }
+
   if (m_State.m_hShader == hShader)
   {
     CountRedundantStateChange();
     return;
   }
 
-  const ezGALShader* pShader = m_Device.GetShader(hShader);
-  EZ_ASSERT_DEV(pShader != nullptr, "The given shader handle isn't valid, this may be a use after destroy!");
-
-  m_CommonImpl.SetShaderPlatform(pShader);
-
-  m_State.m_hShader = hShader;
-  CountStateChange();
+  ApplyShader(hShader);
 }
 
 void ezGALCommandEncoder::SetConstantBuffer(ezUInt32 uiSlot, ezGALBufferHandle hBuffer)
@@ -34,20 +37,22 @@ void ezGALCommandEncoder::SetConstantBuffer(ezUInt32 uiSlot, ezGALBufferHandle h
   AssertRenderingThread();
   EZ_ASSERT_RELEASE(uiSlot < EZ_GAL_MAX_CONSTANT_BUFFER_COUNT, "Constant buffer slot index too big!");
 
+  if (m_bStateBatching)
+  {
+    if (DeferStateChange(m_State.m_uiPendingConstantBuffers, (1u << uiSlot), m_State.m_hPendingConstantBuffers[uiSlot] == hBuffer, m_State.m_hConstantBuffers[uiSlot] == hBuffer))
+    {
+      m_State.m_hPendingConstantBuffers[uiSlot] = hBuffer;
+    }
+    return;
+  }
+
   if (m_State.m_hConstantBuffers[uiSlot] == hBuffer)
   {
     CountRedundantStateChange();
     return;
   }
 
-  const ezGALBuffer* pBuffer = m_Device.GetBuffer(hBuffer);
-  EZ_ASSERT_DEV(pBuffer == nullptr || pBuffer->GetDescription().m_BufferType == ezGALBufferType::ConstantBuffer, "Wrong buffer type");
-
-  m_CommonImpl.SetConstantBufferPlatform(uiSlot, pBuffer);
-
-  m_State.m_hConstantBuffers[uiSlot] = hBuffer;
-
-  CountStateChange();
+  ApplyConstantBuffer(uiSlot, hBuffer);
 }
 
 void ezGALCommandEncoder::SetSamplerState(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, ezGALSamplerStateHandle hSamplerState)
@@ -55,19 +60,22 @@ void ezGALCommandEncoder::SetSamplerState(ezGALShaderStage::Enum Stage, ezUInt32
   AssertRenderingThread();
   EZ_ASSERT_RELEASE(uiSlot < EZ_GAL_MAX_SAMPLER_COUNT, "Sampler state slot index too big!");
 
+  if (m_bStateBatching)
+  {
+    if (DeferStateChange(m_State.m_uiPendingSamplerStates[Stage], (1u << uiSlot), m_State.m_hPendingSamplerStates[Stage][uiSlot] == hSamplerState, m_State.m_hSamplerStates[Stage][uiSlot] == hSamplerState))
+    {
+      m_State.m_hPendingSamplerStates[Stage][uiSlot] = hSamplerState;
+    }
+    return;
+  }
+
   if (m_State.m_hSamplerStates[Stage][uiSlot] == hSamplerState)
   {
     CountRedundantStateChange();
     return;
   }
 
-  const ezGALSamplerState* pSamplerState = m_Device.GetSamplerState(hSamplerState);
-
-  m_CommonImpl.SetSamplerStatePlatform(Stage, uiSlot, pSamplerState);
-
-  m_State.m_hSamplerStates[Stage][uiSlot] = hSamplerState;
-
-  CountStateChange();
+  ApplySamplerState(Stage, uiSlot, hSamplerState);
 }
 
 void ezGALCommandEncoder::SetResourceView(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, ezGALResourceViewHandle hResourceView)
@@ -487,17 +495,31 @@ void ezGALCommandEncoder::InsertEventMarker(const char* Marker)
   m_CommonImpl.InsertEventMarkerPlatform(Marker);
 }
 
+void ezGALCommandEncoder::SetStateBatchingEnabled(bool bEnable)
+{
+  AssertRenderingThread();
+
+  if (m_bStateBatching == bEnable)
+    return;
+
+  // Everything that has been requested so far needs to be bound before the binds are passed on immediately again
+  ApplyPendingState();
+
+  m_bStateBatching = bEnable;
+}
+
 void ezGALCommandEncoder::ClearStatisticsCounters()
 {
   // Reset counters for various statistics
   m_uiStateChanges = 0;
   m_uiRedundantStateChanges = 0;
+  m_uiAvoidedStateChanges = 0;
 }
 
 ezGALCommandEncoder::ezGALCommandEncoder(ezGALDevice& device, ezGALCommandEncoderState& state, ezGALCommandEncoderCommonPlatformInterface& commonImpl)
-  : m_Device(device)
+  : m_CommonImpl(commonImpl)
+  , m_Device(device)
   , m_State(state)
-  , m_CommonImpl(commonImpl)
 {
 }
 
@@ -507,3 +529,67 @@ void ezGALCommandEncoder::InvalidateState()
 {
   m_State.InvalidateState();
 }
+
+void ezGALCommandEncoder::ApplyPendingState()
+{
+  if (m_State.m_uiPendingFlags & ezGALCommandEncoderState::PendingShader)
+  {
+    m_State.m_uiPendingFlags &= ~ezGALCommandEncoderState::PendingShader;
+
+    ApplyShader(m_State.m_hPendingShader);
+  }
+
+  while (m_State.m_uiPendingConstantBuffers != 0)
+  {
+    const ezUInt32 uiSlot = ezMath::FirstBitLow(m_State.m_uiPendingConstantBuffers);
+    m_State.m_uiPendingConstantBuffers &= ~(1u << uiSlot);
+
+    ApplyConstantBuffer(uiSlot, m_State.m_hPendingConstantBuffers[uiSlot]);
+  }
+
+  for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    ezUInt32& uiPendingSamplerStates = m_State.m_uiPendingSamplerStates[stage];
+    while (uiPendingSamplerStates != 0)
+    {
+      const ezUInt32 uiSlot = ezMath::FirstBitLow(uiPendingSamplerStates);
+      uiPendingSamplerStates &= ~(1u << uiSlot);
+
+      ApplySamplerState((ezGALShaderStage::Enum)stage, uiSlot, m_State.m_hPendingSamplerStates[stage][uiSlot]);
+    }
+  }
+}
+
+void ezGALCommandEncoder::ApplyShader(ezGALShaderHandle hShader)
+{
+  const ezGALShader* pShader = m_Device.GetShader(hShader);
+  EZ_ASSERT_DEV(pShader != nullptr, "The given shader handle isn't valid, this may be a use after destroy!");
+
+  m_CommonImpl.SetShaderPlatform(pShader);
+
+  m_State.m_hShader = hShader;
+  CountStateChange();
+}
+
+void ezGALCommandEncoder::ApplyConstantBuffer(ezUInt32 uiSlot, ezGALBufferHandle hBuffer)
+{
+  const ezGALBuffer* pBuffer = m_Device.GetBuffer(hBuffer);
+  EZ_ASSERT_DEV(pBuffer == nullptr || pBuffer->GetDescription().m_BufferType == ezGALBufferType::ConstantBuffer, "Wrong buffer type");
+
+  m_CommonImpl.SetConstantBufferPlatform(uiSlot, pBuffer);
+
+  m_State.m_hConstantBuffers[uiSlot] = hBuffer;
+
+  CountStateChange();
+}
+
+void ezGALCommandEncoder::ApplySamplerState(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, ezGALSamplerStateHandle hSamplerState)
+{
+  const ezGALSamplerState* pSamplerState = m_Device.GetSamplerState(hSamplerState);
+
+  m_CommonImpl.SetSamplerStatePlatform(Stage, uiSlot, pSamplerState);
+
+  m_State.m_hSamplerStates[Stage][uiSlot] = hSamplerState;
+
+  CountStateChange();
+}
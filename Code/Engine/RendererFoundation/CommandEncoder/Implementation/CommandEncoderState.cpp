@@ -27,6 +27,14 @@ void ezGALCommandEncoderState::InvalidateState()
       m_hSamplerStates[i][j].Invalidate();
     }
   }
+
+  m_uiPendingFlags = 0;
+  m_uiPendingConstantBuffers = 0;
+
+  for (ezUInt32 i = 0; i < ezGALShaderStage::ENUM_COUNT; ++i)
+  {
+    m_uiPendingSamplerStates[i] = 0;
+  }
 }
 
 void ezGALCommandEncoderRenderState::InvalidateState()
@@ -55,4 +63,6 @@ void ezGALCommandEncoderRenderState::InvalidateState()
   m_ViewPortRect = ezRectFloat(ezMath::MaxValue<float>(), ezMath::MaxValue<float>(), 0.0f, 0.0f);
   m_fViewPortMinDepth = ezMath::MaxValue<float>();
   m_fViewPortMaxDepth = -ezMath::MaxValue<float>();
+
+  m_uiPendingVertexBuffers = 0;
 }
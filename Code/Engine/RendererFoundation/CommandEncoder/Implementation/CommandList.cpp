@@ -0,0 +1,974 @@
+#include <RendererFoundationPCH.h>
+
+#include <RendererFoundation/CommandEncoder/CommandList.h>
+#include <RendererFoundation/Device/Device.h>
+
+namespace
+{
+  enum class CommandType : ezUInt16
+  {
+    SetShader,
+    SetConstantBuffer,
+    SetSamplerState,
+    SetResourceView,
+    SetUnorderedAccessView,
+    InsertFence,
+    BeginQuery,
+    EndQuery,
+    InsertTimestamp,
+    ClearUnorderedAccessViewFloat,
+    ClearUnorderedAccessViewUInt,
+    CopyBuffer,
+    CopyBufferRegion,
+    UpdateBuffer,
+    CopyTexture,
+    CopyTextureRegion,
+    UpdateTexture,
+    ResolveTexture,
+    ReadbackTexture,
+    GenerateMipMaps,
+    Flush,
+    PushMarker,
+    PopMarker,
+    InsertEventMarker,
+    Clear,
+    Draw,
+    DrawIndexed,
+    DrawIndexedInstanced,
+    DrawIndexedInstancedIndirect,
+    DrawInstanced,
+    DrawInstancedIndirect,
+    DrawAuto,
+    BeginStreamOut,
+    EndStreamOut,
+    SetIndexBuffer,
+    SetVertexBuffer,
+    SetVertexDeclaration,
+    SetPrimitiveTopology,
+    SetBlendState,
+    SetDepthStencilState,
+    SetRasterizerState,
+    SetViewport,
+    SetScissorRect,
+  };
+
+  // All commands start with this header. Commands are stored back to back, m_uiSize is the offset to the next command.
+  struct Command
+  {
+    CommandType m_Type;
+    ezUInt32 m_uiSize;
+  };
+
+  template <CommandType Type>
+  struct CommandT : public Command
+  {
+    static constexpr CommandType s_Type = Type;
+  };
+
+  template <CommandType Type>
+  struct ObjectCommand : public CommandT<Type>
+  {
+    const void* m_pObject;
+  };
+
+  template <CommandType Type>
+  struct MarkerCommand : public CommandT<Type>
+  {
+    // The marker string is stored as inline data
+    const char* GetMarker() const { return reinterpret_cast<const char*>(this + 1); }
+  };
+
+  struct SetShaderCommand : public CommandT<CommandType::SetShader>
+  {
+    const ezGALShader* m_pShader;
+  };
+
+  struct SetConstantBufferCommand : public CommandT<CommandType::SetConstantBuffer>
+  {
+    ezUInt32 m_uiSlot;
+    const ezGALBuffer* m_pBuffer;
+  };
+
+  struct SetSamplerStateCommand : public CommandT<CommandType::SetSamplerState>
+  {
+    ezGALShaderStage::Enum m_Stage;
+    ezUInt32 m_uiSlot;
+    const ezGALSamplerState* m_pSamplerState;
+  };
+
+  struct SetResourceViewCommand : public CommandT<CommandType::SetResourceView>
+  {
+    ezGALShaderStage::Enum m_Stage;
+    ezUInt32 m_uiSlot;
+    const ezGALResourceView* m_pResourceView;
+  };
+
+  struct SetUnorderedAccessViewCommand : public CommandT<CommandType::SetUnorderedAccessView>
+  {
+    ezUInt32 m_uiSlot;
+    const ezGALUnorderedAccessView* m_pUnorderedAccessView;
+  };
+
+  struct InsertTimestampCommand : public CommandT<CommandType::InsertTimestamp>
+  {
+    ezGALTimestampHandle m_hTimestamp;
+  };
+
+  struct ClearUnorderedAccessViewFloatCommand : public CommandT<CommandType::ClearUnorderedAccessViewFloat>
+  {
+    const ezGALUnorderedAccessView* m_pUnorderedAccessView;
+    ezVec4 m_ClearValues;
+  };
+
+  struct ClearUnorderedAccessViewUIntCommand : public CommandT<CommandType::ClearUnorderedAccessViewUInt>
+  {
+    const ezGALUnorderedAccessView* m_pUnorderedAccessView;
+    ezVec4U32 m_ClearValues;
+  };
+
+  struct CopyBufferCommand : public CommandT<CommandType::CopyBuffer>
+  {
+    const ezGALBuffer* m_pDestination;
+    const ezGALBuffer* m_pSource;
+  };
+
+  struct CopyBufferRegionCommand : public CommandT<CommandType::CopyBufferRegion>
+  {
+    const ezGALBuffer* m_pDestination;
+    const ezGALBuffer* m_pSource;
+    ezUInt32 m_uiDestOffset;
+    ezUInt32 m_uiSourceOffset;
+    ezUInt32 m_uiByteCount;
+  };
+
+  struct UpdateBufferCommand : public CommandT<CommandType::UpdateBuffer>
+  {
+    const ezGALBuffer* m_pDestination;
+    ezUInt32 m_uiDestOffset;
+    ezUInt32 m_uiDataSize;
+    ezGALUpdateMode::Enum m_UpdateMode;
+
+    // The source data is stored as inline data
+    ezArrayPtr<const ezUInt8> GetData() const { return ezMakeArrayPtr(reinterpret_cast<const ezUInt8*>(this + 1), m_uiDataSize); }
+  };
+
+  struct CopyTextureCommand : public CommandT<CommandType::CopyTexture>
+  {
+    const ezGALTexture* m_pDestination;
+    const ezGALTexture* m_pSource;
+  };
+
+  struct CopyTextureRegionCommand : public CommandT<CommandType::CopyTextureRegion>
+  {
+    const ezGALTexture* m_pDestination;
+    const ezGALTexture* m_pSource;
+    ezGALTextureSubresource m_DestinationSubResource;
+    ezGALTextureSubresource m_SourceSubResource;
+    ezVec3U32 m_DestinationPoint;
+    ezBoundingBoxu32 m_Box;
+  };
+
+  struct UpdateTextureCommand : public CommandT<CommandType::UpdateTexture>
+  {
+    const ezGALTexture* m_pDestination;
+    ezGALTextureSubresource m_DestinationSubResource;
+    ezBoundingBoxu32 m_DestinationBox;
+    ezUInt32 m_uiRowPitch;
+    ezUInt32 m_uiSlicePitch;
+
+    // The source data is stored as inline data
+    void* GetData() const { return const_cast<UpdateTextureCommand*>(this + 1); }
+  };
+
+  struct ResolveTextureCommand : public CommandT<CommandType::ResolveTexture>
+  {
+    const ezGALTexture* m_pDestination;
+    const ezGALTexture* m_pSource;
+    ezGALTextureSubresource m_DestinationSubResource;
+    ezGALTextureSubresource m_SourceSubResource;
+  };
+
+  struct ClearCommand : public CommandT<CommandType::Clear>
+  {
+    ezColor m_ClearColor;
+    ezUInt32 m_uiRenderTargetClearMask;
+    float m_fDepthClear;
+    ezUInt8 m_uiStencilClear;
+    bool m_bClearDepth;
+    bool m_bClearStencil;
+  };
+
+  struct DrawCommand : public CommandT<CommandType::Draw>
+  {
+    ezUInt32 m_uiVertexCount;
+    ezUInt32 m_uiStartVertex;
+  };
+
+  struct DrawIndexedCommand : public CommandT<CommandType::DrawIndexed>
+  {
+    ezUInt32 m_uiIndexCount;
+    ezUInt32 m_uiStartIndex;
+  };
+
+  struct DrawIndexedInstancedCommand : public CommandT<CommandType::DrawIndexedInstanced>
+  {
+    ezUInt32 m_uiIndexCountPerInstance;
+    ezUInt32 m_uiInstanceCount;
+    ezUInt32 m_uiStartIndex;
+  };
+
+  struct DrawInstancedCommand : public CommandT<CommandType::DrawInstanced>
+  {
+    ezUInt32 m_uiVertexCountPerInstance;
+    ezUInt32 m_uiInstanceCount;
+    ezUInt32 m_uiStartVertex;
+  };
+
+  template <CommandType Type>
+  struct DrawIndirectCommand : public CommandT<Type>
+  {
+    const ezGALBuffer* m_pIndirectArgumentBuffer;
+    ezUInt32 m_uiArgumentOffsetInBytes;
+  };
+
+  struct SetVertexBufferCommand : public CommandT<CommandType::SetVertexBuffer>
+  {
+    ezUInt32 m_uiSlot;
+    const ezGALBuffer* m_pVertexBuffer;
+  };
+
+  struct SetPrimitiveTopologyCommand : public CommandT<CommandType::SetPrimitiveTopology>
+  {
+    ezGALPrimitiveTopology::Enum m_Topology;
+  };
+
+  struct SetBlendStateCommand : public CommandT<CommandType::SetBlendState>
+  {
+    const ezGALBlendState* m_pBlendState;
+    ezColor m_BlendFactor;
+    ezUInt32 m_uiSampleMask;
+  };
+
+  struct SetDepthStencilStateCommand : public CommandT<CommandType::SetDepthStencilState>
+  {
+    const ezGALDepthStencilState* m_pDepthStencilState;
+    ezUInt8 m_uiStencilRefValue;
+  };
+
+  struct SetViewportCommand : public CommandT<CommandType::SetViewport>
+  {
+    ezRectFloat m_Rect;
+    float m_fMinDepth;
+    float m_fMaxDepth;
+  };
+
+  struct SetScissorRectCommand : public CommandT<CommandType::SetScissorRect>
+  {
+    ezRectU32 m_Rect;
+  };
+
+  using InsertFenceCommand = ObjectCommand<CommandType::InsertFence>;
+  using BeginQueryCommand = ObjectCommand<CommandType::BeginQuery>;
+  using EndQueryCommand = ObjectCommand<CommandType::EndQuery>;
+  using ReadbackTextureCommand = ObjectCommand<CommandType::ReadbackTexture>;
+  using GenerateMipMapsCommand = ObjectCommand<CommandType::GenerateMipMaps>;
+  using SetIndexBufferCommand = ObjectCommand<CommandType::SetIndexBuffer>;
+  using SetVertexDeclarationCommand = ObjectCommand<CommandType::SetVertexDeclaration>;
+  using SetRasterizerStateCommand = ObjectCommand<CommandType::SetRasterizerState>;
+  using DrawIndexedInstancedIndirectCommand = DrawIndirectCommand<CommandType::DrawIndexedInstancedIndirect>;
+  using DrawInstancedIndirectCommand = DrawIndirectCommand<CommandType::DrawInstancedIndirect>;
+  using PushMarkerCommand = MarkerCommand<CommandType::PushMarker>;
+  using InsertEventMarkerCommand = MarkerCommand<CommandType::InsertEventMarker>;
+  using FlushCommand = CommandT<CommandType::Flush>;
+  using PopMarkerCommand = CommandT<CommandType::PopMarker>;
+  using DrawAutoCommand = CommandT<CommandType::DrawAuto>;
+  using BeginStreamOutCommand = CommandT<CommandType::BeginStreamOut>;
+  using EndStreamOutCommand = CommandT<CommandType::EndStreamOut>;
+
+  // Keeps the commands and their inline data aligned
+  constexpr ezUInt32 s_uiCommandAlignment = 16;
+
+  template <typename T>
+  EZ_ALWAYS_INLINE const T& Cast(const Command& command)
+  {
+    EZ_ASSERT_DEBUG(command.m_Type == T::s_Type, "Invalid command type");
+    return static_cast<const T&>(command);
+  }
+
+  template <typename T, CommandType Type>
+  EZ_ALWAYS_INLINE const T* CastObject(const Command& command)
+  {
+    return static_cast<const T*>(Cast<ObjectCommand<Type>>(command).m_pObject);
+  }
+} // namespace
+
+ezGALCommandList::ezGALCommandList(ezGALDevice& device)
+  : m_Device(device)
+{
+  m_pEncoder = EZ_DEFAULT_NEW(ezGALRenderCommandEncoder, device, m_State, *this, *this);
+  m_pEncoder->m_bRecordsCommandList = true;
+}
+
+ezGALCommandList::~ezGALCommandList()
+{
+  EZ_ASSERT_DEV(!m_bRecording, "EndRecording has not been called");
+}
+
+ezGALRenderCommandEncoder* ezGALCommandList::BeginRecording()
+{
+  EZ_ASSERT_DEV(!m_bRecording, "Nested recording is not allowed");
+
+  Clear();
+
+  m_pEncoder->InvalidateState();
+  m_bRecording = true;
+
+  return m_pEncoder.Borrow();
+}
+
+void ezGALCommandList::EndRecording()
+{
+  EZ_ASSERT_DEV(m_bRecording, "BeginRecording has not been called");
+
+  m_bRecording = false;
+}
+
+void ezGALCommandList::Clear()
+{
+  m_Commands.Clear();
+  m_uiCommandCount = 0;
+  m_uiDrawCallCount = 0;
+}
+
+template <typename T>
+T& ezGALCommandList::AddCommand(ezUInt32 uiInlineDataSize /*= 0*/)
+{
+  EZ_ASSERT_DEBUG(m_bRecording, "BeginRecording has not been called");
+
+  const ezUInt32 uiOffset = m_Commands.GetCount();
+  const ezUInt32 uiSize = ezMemoryUtils::AlignSize<ezUInt32>(sizeof(T) + uiInlineDataSize, s_uiCommandAlignment);
+  m_Commands.SetCountUninitialized(uiOffset + uiSize);
+
+  T* pCommand = new (m_Commands.GetData() + uiOffset) T();
+  pCommand->m_Type = T::s_Type;
+  pCommand->m_uiSize = uiSize;
+
+  ++m_uiCommandCount;
+  return *pCommand;
+}
+
+void ezGALCommandList::Replay(ezGALCommandEncoderCommonPlatformInterface& commonImpl, ezGALCommandEncoderRenderPlatformInterface& renderImpl) const
+{
+  EZ_ASSERT_DEV(!m_bRecording, "A command list can't be executed while it is recorded");
+
+  const ezUInt8* pCurrent = m_Commands.GetData();
+  const ezUInt8* pEnd = pCurrent + m_Commands.GetCount();
+
+  while (pCurrent < pEnd)
+  {
+    const Command& command = *reinterpret_cast<const Command*>(pCurrent);
+    pCurrent += command.m_uiSize;
+
+    switch (command.m_Type)
+    {
+      case CommandType::SetShader:
+        commonImpl.SetShaderPlatform(Cast<SetShaderCommand>(command).m_pShader);
+        break;
+
+      case CommandType::SetConstantBuffer:
+      {
+        auto& cmd = Cast<SetConstantBufferCommand>(command);
+        commonImpl.SetConstantBufferPlatform(cmd.m_uiSlot, cmd.m_pBuffer);
+      }
+      break;
+
+      case CommandType::SetSamplerState:
+      {
+        auto& cmd = Cast<SetSamplerStateCommand>(command);
+        commonImpl.SetSamplerStatePlatform(cmd.m_Stage, cmd.m_uiSlot, cmd.m_pSamplerState);
+      }
+      break;
+
+      case CommandType::SetResourceView:
+      {
+        auto& cmd = Cast<SetResourceViewCommand>(command);
+        commonImpl.SetResourceViewPlatform(cmd.m_Stage, cmd.m_uiSlot, cmd.m_pResourceView);
+      }
+      break;
+
+      case CommandType::SetUnorderedAccessView:
+      {
+        auto& cmd = Cast<SetUnorderedAccessViewCommand>(command);
+        commonImpl.SetUnorderedAccessViewPlatform(cmd.m_uiSlot, cmd.m_pUnorderedAccessView);
+      }
+      break;
+
+      case CommandType::InsertFence:
+        commonImpl.InsertFencePlatform(CastObject<ezGALFence, CommandType::InsertFence>(command));
+        break;
+
+      case CommandType::BeginQuery:
+        commonImpl.BeginQueryPlatform(CastObject<ezGALQuery, CommandType::BeginQuery>(command));
+        break;
+
+      case CommandType::EndQuery:
+        commonImpl.EndQueryPlatform(CastObject<ezGALQuery, CommandType::EndQuery>(command));
+        break;
+
+      case CommandType::InsertTimestamp:
+        commonImpl.InsertTimestampPlatform(Cast<InsertTimestampCommand>(command).m_hTimestamp);
+        break;
+
+      case CommandType::ClearUnorderedAccessViewFloat:
+      {
+        auto& cmd = Cast<ClearUnorderedAccessViewFloatCommand>(command);
+        commonImpl.ClearUnorderedAccessViewPlatform(cmd.m_pUnorderedAccessView, cmd.m_ClearValues);
+      }
+      break;
+
+      case CommandType::ClearUnorderedAccessViewUInt:
+      {
+        auto& cmd = Cast<ClearUnorderedAccessViewUIntCommand>(command);
+        commonImpl.ClearUnorderedAccessViewPlatform(cmd.m_pUnorderedAccessView, cmd.m_ClearValues);
+      }
+      break;
+
+      case CommandType::CopyBuffer:
+      {
+        auto& cmd = Cast<CopyBufferCommand>(command);
+        commonImpl.CopyBufferPlatform(cmd.m_pDestination, cmd.m_pSource);
+      }
+      break;
+
+      case CommandType::CopyBufferRegion:
+      {
+        auto& cmd = Cast<CopyBufferRegionCommand>(command);
+        commonImpl.CopyBufferRegionPlatform(cmd.m_pDestination, cmd.m_uiDestOffset, cmd.m_pSource, cmd.m_uiSourceOffset, cmd.m_uiByteCount);
+      }
+      break;
+
+      case CommandType::UpdateBuffer:
+      {
+        auto& cmd = Cast<UpdateBufferCommand>(command);
+        commonImpl.UpdateBufferPlatform(cmd.m_pDestination, cmd.m_uiDestOffset, cmd.GetData(), cmd.m_UpdateMode);
+      }
+      break;
+
+      case CommandType::CopyTexture:
+      {
+        auto& cmd = Cast<CopyTextureCommand>(command);
+        commonImpl.CopyTexturePlatform(cmd.m_pDestination, cmd.m_pSource);
+      }
+      break;
+
+      case CommandType::CopyTextureRegion:
+      {
+        auto& cmd = Cast<CopyTextureRegionCommand>(command);
+        commonImpl.CopyTextureRegionPlatform(cmd.m_pDestination, cmd.m_DestinationSubResource, cmd.m_DestinationPoint, cmd.m_pSource, cmd.m_SourceSubResource, cmd.m_Box);
+      }
+      break;
+
+      case CommandType::UpdateTexture:
+      {
+        auto& cmd = Cast<UpdateTextureCommand>(command);
+
+        ezGALSystemMemoryDescription sourceData;
+        sourceData.m_pData = cmd.GetData();
+        sourceData.m_uiRowPitch = cmd.m_uiRowPitch;
+        sourceData.m_uiSlicePitch = cmd.m_uiSlicePitch;
+
+        commonImpl.UpdateTexturePlatform(cmd.m_pDestination, cmd.m_DestinationSubResource, cmd.m_DestinationBox, sourceData);
+      }
+      break;
+
+      case CommandType::ResolveTexture:
+      {
+        auto& cmd = Cast<ResolveTextureCommand>(command);
+        commonImpl.ResolveTexturePlatform(cmd.m_pDestination, cmd.m_DestinationSubResource, cmd.m_pSource, cmd.m_SourceSubResource);
+      }
+      break;
+
+      case CommandType::ReadbackTexture:
+        commonImpl.ReadbackTexturePlatform(CastObject<ezGALTexture, CommandType::ReadbackTexture>(command));
+        break;
+
+      case CommandType::GenerateMipMaps:
+        commonImpl.GenerateMipMapsPlatform(CastObject<ezGALResourceView, CommandType::GenerateMipMaps>(command));
+        break;
+
+      case CommandType::Flush:
+        commonImpl.FlushPlatform();
+        break;
+
+      case CommandType::PushMarker:
+        commonImpl.PushMarkerPlatform(Cast<PushMarkerCommand>(command).GetMarker());
+        break;
+
+      case CommandType::PopMarker:
+        commonImpl.PopMarkerPlatform();
+        break;
+
+      case CommandType::InsertEventMarker:
+        commonImpl.InsertEventMarkerPlatform(Cast<InsertEventMarkerCommand>(command).GetMarker());
+        break;
+
+      case CommandType::Clear:
+      {
+        auto& cmd = Cast<ClearCommand>(command);
+        renderImpl.ClearPlatform(cmd.m_ClearColor, cmd.m_uiRenderTargetClearMask, cmd.m_bClearDepth, cmd.m_bClearStencil, cmd.m_fDepthClear, cmd.m_uiStencilClear);
+      }
+      break;
+
+      case CommandType::Draw:
+      {
+        auto& cmd = Cast<DrawCommand>(command);
+        renderImpl.DrawPlatform(cmd.m_uiVertexCount, cmd.m_uiStartVertex);
+      }
+      break;
+
+      case CommandType::DrawIndexed:
+      {
+        auto& cmd = Cast<DrawIndexedCommand>(command);
+        renderImpl.DrawIndexedPlatform(cmd.m_uiIndexCount, cmd.m_uiStartIndex);
+      }
+      break;
+
+      case CommandType::DrawIndexedInstanced:
+      {
+        auto& cmd = Cast<DrawIndexedInstancedCommand>(command);
+        renderImpl.DrawIndexedInstancedPlatform(cmd.m_uiIndexCountPerInstance, cmd.m_uiInstanceCount, cmd.m_uiStartIndex);
+      }
+      break;
+
+      case CommandType::DrawIndexedInstancedIndirect:
+      {
+        auto& cmd = Cast<DrawIndexedInstancedIndirectCommand>(command);
+        renderImpl.DrawIndexedInstancedIndirectPlatform(cmd.m_pIndirectArgumentBuffer, cmd.m_uiArgumentOffsetInBytes);
+      }
+      break;
+
+      case CommandType::DrawInstanced:
+      {
+        auto& cmd = Cast<DrawInstancedCommand>(command);
+        renderImpl.DrawInstancedPlatform(cmd.m_uiVertexCountPerInstance, cmd.m_uiInstanceCount, cmd.m_uiStartVertex);
+      }
+      break;
+
+      case CommandType::DrawInstancedIndirect:
+      {
+        auto& cmd = Cast<DrawInstancedIndirectCommand>(command);
+        renderImpl.DrawInstancedIndirectPlatform(cmd.m_pIndirectArgumentBuffer, cmd.m_uiArgumentOffsetInBytes);
+      }
+      break;
+
+      case CommandType::DrawAuto:
+        renderImpl.DrawAutoPlatform();
+        break;
+
+      case CommandType::BeginStreamOut:
+        renderImpl.BeginStreamOutPlatform();
+        break;
+
+      case CommandType::EndStreamOut:
+        renderImpl.EndStreamOutPlatform();
+        break;
+
+      case CommandType::SetIndexBuffer:
+        renderImpl.SetIndexBufferPlatform(CastObject<ezGALBuffer, CommandType::SetIndexBuffer>(command));
+        break;
+
+      case CommandType::SetVertexBuffer:
+      {
+        auto& cmd = Cast<SetVertexBufferCommand>(command);
+        renderImpl.SetVertexBufferPlatform(cmd.m_uiSlot, cmd.m_pVertexBuffer);
+      }
+      break;
+
+      case CommandType::SetVertexDeclaration:
+        renderImpl.SetVertexDeclarationPlatform(CastObject<ezGALVertexDeclaration, CommandType::SetVertexDeclaration>(command));
+        break;
+
+      case CommandType::SetPrimitiveTopology:
+        renderImpl.SetPrimitiveTopologyPlatform(Cast<SetPrimitiveTopologyCommand>(command).m_Topology);
+        break;
+
+      case CommandType::SetBlendState:
+      {
+        auto& cmd = Cast<SetBlendStateCommand>(command);
+        renderImpl.SetBlendStatePlatform(cmd.m_pBlendState, cmd.m_BlendFactor, cmd.m_uiSampleMask);
+      }
+      break;
+
+      case CommandType::SetDepthStencilState:
+      {
+        auto& cmd = Cast<SetDepthStencilStateCommand>(command);
+        renderImpl.SetDepthStencilStatePlatform(cmd.m_pDepthStencilState, cmd.m_uiStencilRefValue);
+      }
+      break;
+
+      case CommandType::SetRasterizerState:
+        renderImpl.SetRasterizerStatePlatform(CastObject<ezGALRasterizerState, CommandType::SetRasterizerState>(command));
+        break;
+
+      case CommandType::SetViewport:
+      {
+        auto& cmd = Cast<SetViewportCommand>(command);
+        renderImpl.SetViewportPlatform(cmd.m_Rect, cmd.m_fMinDepth, cmd.m_fMaxDepth);
+      }
+      break;
+
+      case CommandType::SetScissorRect:
+        renderImpl.SetScissorRectPlatform(Cast<SetScissorRectCommand>(command).m_Rect);
+        break;
+
+        EZ_DEFAULT_CASE_NOT_IMPLEMENTED;
+    }
+  }
+}
+
+// ezGALCommandEncoderCommonPlatformInterface
+
+void ezGALCommandList::SetShaderPlatform(const ezGALShader* pShader)
+{
+  AddCommand<SetShaderCommand>().m_pShader = pShader;
+}
+
+void ezGALCommandList::SetConstantBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer)
+{
+  auto& cmd = AddCommand<SetConstantBufferCommand>();
+  cmd.m_uiSlot = uiSlot;
+  cmd.m_pBuffer = pBuffer;
+}
+
+void ezGALCommandList::SetSamplerStatePlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALSamplerState* pSamplerState)
+{
+  auto& cmd = AddCommand<SetSamplerStateCommand>();
+  cmd.m_Stage = Stage;
+  cmd.m_uiSlot = uiSlot;
+  cmd.m_pSamplerState = pSamplerState;
+}
+
+void ezGALCommandList::SetResourceViewPlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALResourceView* pResourceView)
+{
+  auto& cmd = AddCommand<SetResourceViewCommand>();
+  cmd.m_Stage = Stage;
+  cmd.m_uiSlot = uiSlot;
+  cmd.m_pResourceView = pResourceView;
+}
+
+void ezGALCommandList::SetUnorderedAccessViewPlatform(ezUInt32 uiSlot, const ezGALUnorderedAccessView* pUnorderedAccessView)
+{
+  auto& cmd = AddCommand<SetUnorderedAccessViewCommand>();
+  cmd.m_uiSlot = uiSlot;
+  cmd.m_pUnorderedAccessView = pUnorderedAccessView;
+}
+
+void ezGALCommandList::InsertFencePlatform(const ezGALFence* pFence)
+{
+  AddCommand<InsertFenceCommand>().m_pObject = pFence;
+}
+
+bool ezGALCommandList::IsFenceReachedPlatform(const ezGALFence* pFence)
+{
+  EZ_REPORT_FAILURE("Fences can't be queried while recording a command list");
+  return false;
+}
+
+void ezGALCommandList::WaitForFencePlatform(const ezGALFence* pFence)
+{
+  EZ_REPORT_FAILURE("Waiting for a fence is not possible while recording a command list");
+}
+
+void ezGALCommandList::BeginQueryPlatform(const ezGALQuery* pQuery)
+{
+  AddCommand<BeginQueryCommand>().m_pObject = pQuery;
+}
+
+void ezGALCommandList::EndQueryPlatform(const ezGALQuery* pQuery)
+{
+  AddCommand<EndQueryCommand>().m_pObject = pQuery;
+}
+
+ezResult ezGALCommandList::GetQueryResultPlatform(const ezGALQuery* pQuery, ezUInt64& uiQueryResult)
+{
+  EZ_REPORT_FAILURE("Query results can't be retrieved while recording a command list");
+  return EZ_FAILURE;
+}
+
+void ezGALCommandList::InsertTimestampPlatform(ezGALTimestampHandle hTimestamp)
+{
+  AddCommand<InsertTimestampCommand>().m_hTimestamp = hTimestamp;
+}
+
+void ezGALCommandList::ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4 clearValues)
+{
+  auto& cmd = AddCommand<ClearUnorderedAccessViewFloatCommand>();
+  cmd.m_pUnorderedAccessView = pUnorderedAccessView;
+  cmd.m_ClearValues = clearValues;
+}
+
+void ezGALCommandList::ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4U32 clearValues)
+{
+  auto& cmd = AddCommand<ClearUnorderedAccessViewUIntCommand>();
+  cmd.m_pUnorderedAccessView = pUnorderedAccessView;
+  cmd.m_ClearValues = clearValues;
+}
+
+void ezGALCommandList::CopyBufferPlatform(const ezGALBuffer* pDestination, const ezGALBuffer* pSource)
+{
+  auto& cmd = AddCommand<CopyBufferCommand>();
+  cmd.m_pDestination = pDestination;
+  cmd.m_pSource = pSource;
+}
+
+void ezGALCommandList::CopyBufferRegionPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, const ezGALBuffer* pSource, ezUInt32 uiSourceOffset, ezUInt32 uiByteCount)
+{
+  auto& cmd = AddCommand<CopyBufferRegionCommand>();
+  cmd.m_pDestination = pDestination;
+  cmd.m_pSource = pSource;
+  cmd.m_uiDestOffset = uiDestOffset;
+  cmd.m_uiSourceOffset = uiSourceOffset;
+  cmd.m_uiByteCount = uiByteCount;
+}
+
+void ezGALCommandList::UpdateBufferPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, ezArrayPtr<const ezUInt8> pSourceData, ezGALUpdateMode::Enum updateMode)
+{
+  // The source data only needs to be valid during the call, so it is copied into the command list
+  auto& cmd = AddCommand<UpdateBufferCommand>(pSourceData.GetCount());
+  cmd.m_pDestination = pDestination;
+  cmd.m_uiDestOffset = uiDestOffset;
+  cmd.m_uiDataSize = pSourceData.GetCount();
+  cmd.m_UpdateMode = updateMode;
+
+  ezMemoryUtils::Copy(reinterpret_cast<ezUInt8*>(&cmd + 1), pSourceData.GetPtr(), pSourceData.GetCount());
+}
+
+void ezGALCommandList::CopyTexturePlatform(const ezGALTexture* pDestination, const ezGALTexture* pSource)
+{
+  auto& cmd = AddCommand<CopyTextureCommand>();
+  cmd.m_pDestination = pDestination;
+  cmd.m_pSource = pSource;
+}
+
+void ezGALCommandList::CopyTextureRegionPlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource, const ezVec3U32& DestinationPoint, const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource, const ezBoundingBoxu32& Box)
+{
+  auto& cmd = AddCommand<CopyTextureRegionCommand>();
+  cmd.m_pDestination = pDestination;
+  cmd.m_pSource = pSource;
+  cmd.m_DestinationSubResource = DestinationSubResource;
+  cmd.m_SourceSubResource = SourceSubResource;
+  cmd.m_DestinationPoint = DestinationPoint;
+  cmd.m_Box = Box;
+}
+
+void ezGALCommandList::UpdateTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource, const ezBoundingBoxu32& DestinationBox, const ezGALSystemMemoryDescription& pSourceData)
+{
+  const ezUInt32 uiHeight = DestinationBox.m_vMax.y - DestinationBox.m_vMin.y;
+  const ezUInt32 uiDepth = DestinationBox.m_vMax.z - DestinationBox.m_vMin.z;
+  const ezUInt32 uiDataSize = uiDepth > 1 ? pSourceData.m_uiSlicePitch * uiDepth : pSourceData.m_uiRowPitch * uiHeight;
+
+  auto& cmd = AddCommand<UpdateTextureCommand>(uiDataSize);
+  cmd.m_pDestination = pDestination;
+  cmd.m_DestinationSubResource = DestinationSubResource;
+  cmd.m_DestinationBox = DestinationBox;
+  cmd.m_uiRowPitch = pSourceData.m_uiRowPitch;
+  cmd.m_uiSlicePitch = pSourceData.m_uiSlicePitch;
+
+  ezMemoryUtils::Copy(static_cast<ezUInt8*>(cmd.GetData()), static_cast<const ezUInt8*>(pSourceData.m_pData), uiDataSize);
+}
+
+void ezGALCommandList::ResolveTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource, const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource)
+{
+  auto& cmd = AddCommand<ResolveTextureCommand>();
+  cmd.m_pDestination = pDestination;
+  cmd.m_pSource = pSource;
+  cmd.m_DestinationSubResource = DestinationSubResource;
+  cmd.m_SourceSubResource = SourceSubResource;
+}
+
+void ezGALCommandList::ReadbackTexturePlatform(const ezGALTexture* pTexture)
+{
+  AddCommand<ReadbackTextureCommand>().m_pObject = pTexture;
+}
+
+void ezGALCommandList::CopyTextureReadbackResultPlatform(const ezGALTexture* pTexture, ezArrayPtr<ezGALTextureSubresource> SourceSubResource, ezArrayPtr<ezGALSystemMemoryDescription> TargetData)
+{
+  EZ_REPORT_FAILURE("Readback results can't be retrieved while recording a command list");
+}
+
+void ezGALCommandList::GenerateMipMapsPlatform(const ezGALResourceView* pResourceView)
+{
+  AddCommand<GenerateMipMapsCommand>().m_pObject = pResourceView;
+}
+
+void ezGALCommandList::FlushPlatform()
+{
+  AddCommand<FlushCommand>();
+}
+
+void ezGALCommandList::PushMarkerPlatform(const char* Marker)
+{
+  const ezUInt32 uiLength = ezStringUtils::GetStringElementCount(Marker) + 1;
+
+  auto& cmd = AddCommand<PushMarkerCommand>(uiLength);
+  ezMemoryUtils::Copy(reinterpret_cast<char*>(&cmd + 1), Marker, uiLength);
+}
+
+void ezGALCommandList::PopMarkerPlatform()
+{
+  AddCommand<PopMarkerCommand>();
+}
+
+void ezGALCommandList::InsertEventMarkerPlatform(const char* Marker)
+{
+  const ezUInt32 uiLength = ezStringUtils::GetStringElementCount(Marker) + 1;
+
+  auto& cmd = AddCommand<InsertEventMarkerCommand>(uiLength);
+  ezMemoryUtils::Copy(reinterpret_cast<char*>(&cmd + 1), Marker, uiLength);
+}
+
+// ezGALCommandEncoderRenderPlatformInterface
+
+void ezGALCommandList::ClearPlatform(const ezColor& ClearColor, ezUInt32 uiRenderTargetClearMask, bool bClearDepth, bool bClearStencil, float fDepthClear, ezUInt8 uiStencilClear)
+{
+  auto& cmd = AddCommand<ClearCommand>();
+  cmd.m_ClearColor = ClearColor;
+  cmd.m_uiRenderTargetClearMask = uiRenderTargetClearMask;
+  cmd.m_fDepthClear = fDepthClear;
+  cmd.m_uiStencilClear = uiStencilClear;
+  cmd.m_bClearDepth = bClearDepth;
+  cmd.m_bClearStencil = bClearStencil;
+}
+
+void ezGALCommandList::DrawPlatform(ezUInt32 uiVertexCount, ezUInt32 uiStartVertex)
+{
+  auto& cmd = AddCommand<DrawCommand>();
+  cmd.m_uiVertexCount = uiVertexCount;
+  cmd.m_uiStartVertex = uiStartVertex;
+
+  ++m_uiDrawCallCount;
+}
+
+void ezGALCommandList::DrawIndexedPlatform(ezUInt32 uiIndexCount, ezUInt32 uiStartIndex)
+{
+  auto& cmd = AddCommand<DrawIndexedCommand>();
+  cmd.m_uiIndexCount = uiIndexCount;
+  cmd.m_uiStartIndex = uiStartIndex;
+
+  ++m_uiDrawCallCount;
+}
+
+void ezGALCommandList::DrawIndexedInstancedPlatform(ezUInt32 uiIndexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartIndex)
+{
+  auto& cmd = AddCommand<DrawIndexedInstancedCommand>();
+  cmd.m_uiIndexCountPerInstance = uiIndexCountPerInstance;
+  cmd.m_uiInstanceCount = uiInstanceCount;
+  cmd.m_uiStartIndex = uiStartIndex;
+
+  ++m_uiDrawCallCount;
+}
+
+void ezGALCommandList::DrawIndexedInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  auto& cmd = AddCommand<DrawIndexedInstancedIndirectCommand>();
+  cmd.m_pIndirectArgumentBuffer = pIndirectArgumentBuffer;
+  cmd.m_uiArgumentOffsetInBytes = uiArgumentOffsetInBytes;
+
+  ++m_uiDrawCallCount;
+}
+
+void ezGALCommandList::DrawInstancedPlatform(ezUInt32 uiVertexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartVertex)
+{
+  auto& cmd = AddCommand<DrawInstancedCommand>();
+  cmd.m_uiVertexCountPerInstance = uiVertexCountPerInstance;
+  cmd.m_uiInstanceCount = uiInstanceCount;
+  cmd.m_uiStartVertex = uiStartVertex;
+
+  ++m_uiDrawCallCount;
+}
+
+void ezGALCommandList::DrawInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  auto& cmd = AddCommand<DrawInstancedIndirectCommand>();
+  cmd.m_pIndirectArgumentBuffer = pIndirectArgumentBuffer;
+  cmd.m_uiArgumentOffsetInBytes = uiArgumentOffsetInBytes;
+
+  ++m_uiDrawCallCount;
+}
+
+void ezGALCommandList::DrawAutoPlatform()
+{
+  AddCommand<DrawAutoCommand>();
+
+  ++m_uiDrawCallCount;
+}
+
+void ezGALCommandList::BeginStreamOutPlatform()
+{
+  AddCommand<BeginStreamOutCommand>();
+}
+
+void ezGALCommandList::EndStreamOutPlatform()
+{
+  AddCommand<EndStreamOutCommand>();
+}
+
+void ezGALCommandList::SetIndexBufferPlatform(const ezGALBuffer* pIndexBuffer)
+{
+  AddCommand<SetIndexBufferCommand>().m_pObject = pIndexBuffer;
+}
+
+void ezGALCommandList::SetVertexBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pVertexBuffer)
+{
+  auto& cmd = AddCommand<SetVertexBufferCommand>();
+  cmd.m_uiSlot = uiSlot;
+  cmd.m_pVertexBuffer = pVertexBuffer;
+}
+
+void ezGALCommandList::SetVertexDeclarationPlatform(const ezGALVertexDeclaration* pVertexDeclaration)
+{
+  AddCommand<SetVertexDeclarationCommand>().m_pObject = pVertexDeclaration;
+}
+
+void ezGALCommandList::SetPrimitiveTopologyPlatform(ezGALPrimitiveTopology::Enum Topology)
+{
+  AddCommand<SetPrimitiveTopologyCommand>().m_Topology = Topology;
+}
+
+void ezGALCommandList::SetBlendStatePlatform(const ezGALBlendState* pBlendState, const ezColor& BlendFactor, ezUInt32 uiSampleMask)
+{
+  auto& cmd = AddCommand<SetBlendStateCommand>();
+  cmd.m_pBlendState = pBlendState;
+  cmd.m_BlendFactor = BlendFactor;
+  cmd.m_uiSampleMask = uiSampleMask;
+}
+
+void ezGALCommandList::SetDepthStencilStatePlatform(const ezGALDepthStencilState* pDepthStencilState, ezUInt8 uiStencilRefValue)
+{
+  auto& cmd = AddCommand<SetDepthStencilStateCommand>();
+  cmd.m_pDepthStencilState = pDepthStencilState;
+  cmd.m_uiStencilRefValue = uiStencilRefValue;
+}
+
+void ezGALCommandList::SetRasterizerStatePlatform(const ezGALRasterizerState* pRasterizerState)
+{
+  AddCommand<SetRasterizerStateCommand>().m_pObject = pRasterizerState;
+}
+
+void ezGALCommandList::SetViewportPlatform(const ezRectFloat& rect, float fMinDepth, float fMaxDepth)
+{
+  auto& cmd = AddCommand<SetViewportCommand>();
+  cmd.m_Rect = rect;
+  cmd.m_fMinDepth = fMinDepth;
+  cmd.m_fMaxDepth = fMaxDepth;
+}
+
+void ezGALCommandList::SetScissorRectPlatform(const ezRectU32& rect)
+{
+  AddCommand<SetScissorRectCommand>().m_Rect = rect;
+}
+
+void ezGALCommandList::SetStreamOutBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer, ezUInt32 uiOffset)
+{
+  EZ_ASSERT_NOT_IMPLEMENTED;
+}
@@ -18,6 +18,8 @@ void ezGALComputeCommandEncoder::Dispatch(ezUInt32 uiThreadGroupCountX, ezUInt32
 
   EZ_ASSERT_DEBUG(uiThreadGroupCountX > 0 && uiThreadGroupCountY > 0 && uiThreadGroupCountZ > 0, "Thread group counts of zero are not meaningful. Did you mean 1?");
 
+  FlushPendingStateChanges();
+
   /// \todo Assert for compute
 
   m_ComputeImpl.DispatchPlatform(uiThreadGroupCountX, uiThreadGroupCountY, uiThreadGroupCountZ);
@@ -35,6 +37,8 @@ void ezGALComputeCommandEncoder::DispatchIndirect(ezGALBufferHandle hIndirectArg
   const ezGALBuffer* pBuffer = GetDevice().GetBuffer(hIndirectArgumentBuffer);
   EZ_ASSERT_DEV(pBuffer != nullptr, "Invalid buffer handle for indirect arguments!");
 
+  FlushPendingStateChanges();
+
   /// \todo Assert that the buffer can be used for indirect arguments (flag in desc)
   m_ComputeImpl.DispatchIndirectPlatform(pBuffer, uiArgumentOffsetInBytes);
 
@@ -1,5 +1,6 @@
 #include <RendererFoundationPCH.h>
 
+#include <RendererFoundation/CommandEncoder/CommandList.h>
 #include <RendererFoundation/CommandEncoder/RenderCommandEncoder.h>
 #include <RendererFoundation/Device/Device.h>
 #include <RendererFoundation/Resources/Buffer.h>
@@ -28,6 +29,7 @@ void ezGALRenderCommandEncoder::Clear(const ezColor& ClearColor, ezUInt32 uiRend
 void ezGALRenderCommandEncoder::Draw(ezUInt32 uiVertexCount, ezUInt32 uiStartVertex)
 {
   AssertRenderingThread();
+  FlushPendingStateChanges();
 
   /// \todo If platform indicates that non-indexed rendering is not possible bind a helper index buffer which contains continuous indices
   /// (0, 1, 2, ..)
@@ -40,6 +42,7 @@ void ezGALRenderCommandEncoder::Draw(ezUInt32 uiVertexCount, ezUInt32 uiStartVer
 void ezGALRenderCommandEncoder::DrawIndexed(ezUInt32 uiIndexCount, ezUInt32 uiStartIndex)
 {
   AssertRenderingThread();
+  FlushPendingStateChanges();
 
   m_RenderImpl.DrawIndexedPlatform(uiIndexCount, uiStartIndex);
 
@@ -49,6 +52,7 @@ void ezGALRenderCommandEncoder::DrawIndexed(ezUInt32 uiIndexCount, ezUInt32 uiSt
 void ezGALRenderCommandEncoder::DrawIndexedInstanced(ezUInt32 uiIndexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartIndex)
 {
   AssertRenderingThread();
+  FlushPendingStateChanges();
   /// \todo Assert for instancing
 
   m_RenderImpl.DrawIndexedInstancedPlatform(uiIndexCountPerInstance, uiInstanceCount, uiStartIndex);
@@ -59,6 +63,7 @@ void ezGALRenderCommandEncoder::DrawIndexedInstanced(ezUInt32 uiIndexCountPerIns
 void ezGALRenderCommandEncoder::DrawIndexedInstancedIndirect(ezGALBufferHandle hIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
 {
   AssertRenderingThread();
+  FlushPendingStateChanges();
   /// \todo Assert for instancing
   /// \todo Assert for indirect draw
   /// \todo Assert offset < buffer size
@@ -75,6 +80,7 @@ void ezGALRenderCommandEncoder::DrawIndexedInstancedIndirect(ezGALBufferHandle h
 void ezGALRenderCommandEncoder::DrawInstanced(ezUInt32 uiVertexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartVertex)
 {
   AssertRenderingThread();
+  FlushPendingStateChanges();
   /// \todo Assert for instancing
 
   /// \todo If platform indicates that non-indexed rendering is not possible bind a helper index buffer which contains continuous indices
@@ -88,6 +94,7 @@ void ezGALRenderCommandEncoder::DrawInstanced(ezUInt32 uiVertexCountPerInstance,
 void ezGALRenderCommandEncoder::DrawInstancedIndirect(ezGALBufferHandle hIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
 {
   AssertRenderingThread();
+  FlushPendingStateChanges();
   /// \todo Assert for instancing
   /// \todo Assert for indirect draw
   /// \todo Assert offset < buffer size
@@ -104,6 +111,7 @@ void ezGALRenderCommandEncoder::DrawInstancedIndirect(ezGALBufferHandle hIndirec
 void ezGALRenderCommandEncoder::DrawAuto()
 {
   AssertRenderingThread();
+  FlushPendingStateChanges();
   /// \todo Assert for draw auto support
 
   m_RenderImpl.DrawAutoPlatform();
@@ -128,135 +136,161 @@ void ezGALRenderCommandEncoder::EndStreamOut()
 
 void ezGALRenderCommandEncoder::SetIndexBuffer(ezGALBufferHandle hIndexBuffer)
 {
+  if (m_bStateBatching)
+  {
+    if (DeferStateChange(m_RenderState.m_uiPendingFlags, ezGALCommandEncoderState::PendingIndexBuffer, m_RenderState.m_hPendingIndexBuffer == hIndexBuffer, m_RenderState.m_hIndexBuffer == hIndexBuffer))
+    {
+      m_RenderState.m_hPendingIndexBuffer = hIndexBuffer;
+    }
+    return;
+  }
+
   if (m_RenderState.m_hIndexBuffer == hIndexBuffer)
   {
     CountRedundantStateChange();
     return;
   }
 
-  const ezGALBuffer* pBuffer = GetDevice().GetBuffer(hIndexBuffer);
-  /// \todo Assert on index buffer type (if non nullptr)
-  // Note that GL4 can bind arbitrary buffer to arbitrary binding points (index/vertex/transform-feedback/indirect-draw/...)
-
-  m_RenderImpl.SetIndexBufferPlatform(pBuffer);
-
-  m_RenderState.m_hIndexBuffer = hIndexBuffer;
-  CountStateChange();
+  ApplyIndexBuffer(hIndexBuffer);
 }
 
 void ezGALRenderCommandEncoder::SetVertexBuffer(ezUInt32 uiSlot, ezGALBufferHandle hVertexBuffer)
 {
+  if (m_bStateBatching)
+  {
+    if (DeferStateChange(m_RenderState.m_uiPendingVertexBuffers, (1u << uiSlot), m_RenderState.m_hPendingVertexBuffers[uiSlot] == hVertexBuffer, m_RenderState.m_hVertexBuffers[uiSlot] == hVertexBuffer))
+    {
+      m_RenderState.m_hPendingVertexBuffers[uiSlot] = hVertexBuffer;
+    }
+    return;
+  }
+
   if (m_RenderState.m_hVertexBuffers[uiSlot] == hVertexBuffer)
   {
     CountRedundantStateChange();
     return;
   }
 
-  const ezGALBuffer* pBuffer = GetDevice().GetBuffer(hVertexBuffer);
-  // Assert on vertex buffer type (if non-zero)
-  // Note that GL4 can bind arbitrary buffer to arbitrary binding points (index/vertex/transform-feedback/indirect-draw/...)
-
-  m_RenderImpl.SetVertexBufferPlatform(uiSlot, pBuffer);
-
-  m_RenderState.m_hVertexBuffers[uiSlot] = hVertexBuffer;
-  CountStateChange();
+  ApplyVertexBuffer(uiSlot, hVertexBuffer);
 }
 
 void ezGALRenderCommandEncoder::SetPrimitiveTopology(ezGALPrimitiveTopology::Enum Topology)
 {
   AssertRenderingThread();
 
+  if (m_bStateBatching)
+  {
+    if (DeferStateChange(m_RenderState.m_uiPendingFlags, ezGALCommandEncoderState::PendingTopology, m_RenderState.m_PendingTopology == Topology, m_RenderState.m_Topology == Topology))
+    {
+      m_RenderState.m_PendingTopology = Topology;
+    }
+    return;
+  }
+
   if (m_RenderState.m_Topology == Topology)
   {
     CountRedundantStateChange();
     return;
   }
 
-  m_RenderImpl.SetPrimitiveTopologyPlatform(Topology);
-
-  m_RenderState.m_Topology = Topology;
-
-  CountStateChange();
+  ApplyPrimitiveTopology(Topology);
 }
 
 void ezGALRenderCommandEncoder::SetVertexDeclaration(ezGALVertexDeclarationHandle hVertexDeclaration)
 {
   AssertRenderingThread();
 
+  if (m_bStateBatching)
+  {
+    if (DeferStateChange(m_RenderState.m_uiPendingFlags, ezGALCommandEncoderState::PendingVertexDeclaration, m_RenderState.m_hPendingVertexDeclaration == hVertexDeclaration, m_RenderState.m_hVertexDeclaration == hVertexDeclaration))
+    {
+      m_RenderState.m_hPendingVertexDeclaration = hVertexDeclaration;
+    }
+    return;
+  }
+
   if (m_RenderState.m_hVertexDeclaration == hVertexDeclaration)
   {
     CountRedundantStateChange();
     return;
   }
 
-  const ezGALVertexDeclaration* pVertexDeclaration = GetDevice().GetVertexDeclaration(hVertexDeclaration);
-  // Assert on vertex buffer type (if non-zero)
-
-  m_RenderImpl.SetVertexDeclarationPlatform(pVertexDeclaration);
-
-  m_RenderState.m_hVertexDeclaration = hVertexDeclaration;
-
-  CountStateChange();
+  ApplyVertexDeclaration(hVertexDeclaration);
 }
 
 void ezGALRenderCommandEncoder::SetBlendState(ezGALBlendStateHandle hBlendState, const ezColor& BlendFactor, ezUInt32 uiSampleMask)
 {
   AssertRenderingThread();
 
+  if (m_bStateBatching)
+  {
+    const bool bEqualsPending = m_RenderState.m_hPendingBlendState == hBlendState && m_RenderState.m_PendingBlendFactor.IsEqualRGBA(BlendFactor, 0.001f) && m_RenderState.m_uiPendingSampleMask == uiSampleMask;
+    const bool bEqualsBound = m_RenderState.m_hBlendState == hBlendState && m_RenderState.m_BlendFactor.IsEqualRGBA(BlendFactor, 0.001f) && m_RenderState.m_uiSampleMask == uiSampleMask;
+
+    if (DeferStateChange(m_RenderState.m_uiPendingFlags, ezGALCommandEncoderState::PendingBlendState, bEqualsPending, bEqualsBound))
+    {
+      m_RenderState.m_hPendingBlendState = hBlendState;
+      m_RenderState.m_PendingBlendFactor = BlendFactor;
+      m_RenderState.m_uiPendingSampleMask = uiSampleMask;
+    }
+    return;
+  }
+
   if (m_RenderState.m_hBlendState == hBlendState && m_RenderState.m_BlendFactor.IsEqualRGBA(BlendFactor, 0.001f) && m_RenderState.m_uiSampleMask == uiSampleMask)
   {
     CountRedundantStateChange();
     return;
   }
 
-  const ezGALBlendState* pBlendState = GetDevice().GetBlendState(hBlendState);
-
-  m_RenderImpl.SetBlendStatePlatform(pBlendState, BlendFactor, uiSampleMask);
-
-  m_RenderState.m_hBlendState = hBlendState;
-  m_RenderState.m_BlendFactor = BlendFactor;
-  m_RenderState.m_uiSampleMask = uiSampleMask;
-
-  CountStateChange();
+  ApplyBlendState(hBlendState, BlendFactor, uiSampleMask);
 }
 
 void ezGALRenderCommandEncoder::SetDepthStencilState(ezGALDepthStencilStateHandle hDepthStencilState, ezUInt8 uiStencilRefValue /*= 0xFFu*/)
 {
   AssertRenderingThread();
 
+  if (m_bStateBatching)
+  {
+    const bool bEqualsPending = m_RenderState.m_hPendingDepthStencilState == hDepthStencilState && m_RenderState.m_uiPendingStencilRefValue == uiStencilRefValue;
+    const bool bEqualsBound = m_RenderState.m_hDepthStencilState == hDepthStencilState && m_RenderState.m_uiStencilRefValue == uiStencilRefValue;
+
+    if (DeferStateChange(m_RenderState.m_uiPendingFlags, ezGALCommandEncoderState::PendingDepthStencilState, bEqualsPending, bEqualsBound))
+    {
+      m_RenderState.m_hPendingDepthStencilState = hDepthStencilState;
+      m_RenderState.m_uiPendingStencilRefValue = uiStencilRefValue;
+    }
+    return;
+  }
+
   if (m_RenderState.m_hDepthStencilState == hDepthStencilState && m_RenderState.m_uiStencilRefValue == uiStencilRefValue)
   {
     CountRedundantStateChange();
     return;
   }
 
-  const ezGALDepthStencilState* pDepthStencilState = GetDevice().GetDepthStencilState(hDepthStencilState);
-
-  m_RenderImpl.SetDepthStencilStatePlatform(pDepthStencilState, uiStencilRefValue);
-
-  m_RenderState.m_hDepthStencilState = hDepthStencilState;
-  m_RenderState.m_uiStencilRefValue = uiStencilRefValue;
-
-  CountStateChange();
+  ApplyDepthStencilState(hDepthStencilState, uiStencilRefValue);
 }
 
 void ezGALRenderCommandEncoder::SetRasterizerState(ezGALRasterizerStateHandle hRasterizerState)
 {
   AssertRenderingThread();
 
+  if (m_bStateBatching)
+  {
+    if (DeferStateChange(m_RenderState.m_uiPendingFlags, ezGALCommandEncoderState::PendingRasterizerState, m_RenderState.m_hPendingRasterizerState == hRasterizerState, m_RenderState.m_hRasterizerState == hRasterizerState))
+    {
+      m_RenderState.m_hPendingRasterizerState = hRasterizerState;
+    }
+    return;
+  }
+
   if (m_RenderState.m_hRasterizerState == hRasterizerState)
   {
     CountRedundantStateChange();
     return;
   }
 
-  const ezGALRasterizerState* pRasterizerState = GetDevice().GetRasterizerState(hRasterizerState);
-
-  m_RenderImpl.SetRasterizerStatePlatform(pRasterizerState);
-
-  m_RenderState.m_hRasterizerState = hRasterizerState;
-
-  CountStateChange();
+  ApplyRasterizerState(hRasterizerState);
 }
 
 void ezGALRenderCommandEncoder::SetViewport(const ezRectFloat& rect, float fMinDepth, float fMaxDepth)
@@ -302,9 +336,141 @@ void ezGALRenderCommandEncoder::SetStreamOutBuffer(ezUInt32 uiSlot, ezGALBufferH
   CountStateChange();
 }
 
+void ezGALRenderCommandEncoder::ExecuteCommandList(const ezGALCommandList& commandList)
+{
+  AssertRenderingThread();
+  EZ_ASSERT_DEV(!commandList.IsRecording(), "The command list is still recording");
+
+  // The executed commands don't see binds that are still pending, so they are simply dropped by the state invalidation below
+
+  commandList.Replay(m_CommonImpl, m_RenderImpl);
+
+  m_uiDrawCalls += commandList.GetDrawCallCount();
+
+  InvalidateState();
+}
+
 void ezGALRenderCommandEncoder::ClearStatisticsCounters()
 {
   ezGALCommandEncoder::ClearStatisticsCounters();
 
   m_uiDrawCalls = 0;
 }
+
+void ezGALRenderCommandEncoder::ApplyPendingState()
+{
+  ezGALCommandEncoder::ApplyPendingState();
+
+  while (m_RenderState.m_uiPendingVertexBuffers != 0)
+  {
+    const ezUInt32 uiSlot = ezMath::FirstBitLow(m_RenderState.m_uiPendingVertexBuffers);
+    m_RenderState.m_uiPendingVertexBuffers &= ~(1u << uiSlot);
+
+    ApplyVertexBuffer(uiSlot, m_RenderState.m_hPendingVertexBuffers[uiSlot]);
+  }
+
+  const ezUInt32 uiPendingFlags = m_RenderState.m_uiPendingFlags;
+  if (uiPendingFlags == 0)
+    return;
+
+  m_RenderState.m_uiPendingFlags = 0;
+
+  if (uiPendingFlags & ezGALCommandEncoderState::PendingIndexBuffer)
+    ApplyIndexBuffer(m_RenderState.m_hPendingIndexBuffer);
+
+  if (uiPendingFlags & ezGALCommandEncoderState::PendingVertexDeclaration)
+    ApplyVertexDeclaration(m_RenderState.m_hPendingVertexDeclaration);
+
+  if (uiPendingFlags & ezGALCommandEncoderState::PendingTopology)
+    ApplyPrimitiveTopology(m_RenderState.m_PendingTopology);
+
+  if (uiPendingFlags & ezGALCommandEncoderState::PendingBlendState)
+    ApplyBlendState(m_RenderState.m_hPendingBlendState, m_RenderState.m_PendingBlendFactor, m_RenderState.m_uiPendingSampleMask);
+
+  if (uiPendingFlags & ezGALCommandEncoderState::PendingDepthStencilState)
+    ApplyDepthStencilState(m_RenderState.m_hPendingDepthStencilState, m_RenderState.m_uiPendingStencilRefValue);
+
+  if (uiPendingFlags & ezGALCommandEncoderState::PendingRasterizerState)
+    ApplyRasterizerState(m_RenderState.m_hPendingRasterizerState);
+}
+
+void ezGALRenderCommandEncoder::ApplyIndexBuffer(ezGALBufferHandle hIndexBuffer)
+{
+  const ezGALBuffer* pBuffer = GetDevice().GetBuffer(hIndexBuffer);
+  /// \todo Assert on index buffer type (if non nullptr)
+  // Note that GL4 can bind arbitrary buffer to arbitrary binding points (index/vertex/transform-feedback/indirect-draw/...)
+
+  m_RenderImpl.SetIndexBufferPlatform(pBuffer);
+
+  m_RenderState.m_hIndexBuffer = hIndexBuffer;
+  CountStateChange();
+}
+
+void ezGALRenderCommandEncoder::ApplyVertexBuffer(ezUInt32 uiSlot, ezGALBufferHandle hVertexBuffer)
+{
+  const ezGALBuffer* pBuffer = GetDevice().GetBuffer(hVertexBuffer);
+  // Assert on vertex buffer type (if non-zero)
+  // Note that GL4 can bind arbitrary buffer to arbitrary binding points (index/vertex/transform-feedback/indirect-draw/...)
+
+  m_RenderImpl.SetVertexBufferPlatform(uiSlot, pBuffer);
+
+  m_RenderState.m_hVertexBuffers[uiSlot] = hVertexBuffer;
+  CountStateChange();
+}
+
+void ezGALRenderCommandEncoder::ApplyPrimitiveTopology(ezGALPrimitiveTopology::Enum Topology)
+{
+  m_RenderImpl.SetPrimitiveTopologyPlatform(Topology);
+
+  m_RenderState.m_Topology = Topology;
+
+  CountStateChange();
+}
+
+void ezGALRenderCommandEncoder::ApplyVertexDeclaration(ezGALVertexDeclarationHandle hVertexDeclaration)
+{
+  const ezGALVertexDeclaration* pVertexDeclaration = GetDevice().GetVertexDeclaration(hVertexDeclaration);
+  // Assert on vertex buffer type (if non-zero)
+
+  m_RenderImpl.SetVertexDeclarationPlatform(pVertexDeclaration);
+
+  m_RenderState.m_hVertexDeclaration = hVertexDeclaration;
+
+  CountStateChange();
+}
+
+void ezGALRenderCommandEncoder::ApplyBlendState(ezGALBlendStateHandle hBlendState, const ezColor& BlendFactor, ezUInt32 uiSampleMask)
+{
+  const ezGALBlendState* pBlendState = GetDevice().GetBlendState(hBlendState);
+
+  m_RenderImpl.SetBlendStatePlatform(pBlendState, BlendFactor, uiSampleMask);
+
+  m_RenderState.m_hBlendState = hBlendState;
+  m_RenderState.m_BlendFactor = BlendFactor;
+  m_RenderState.m_uiSampleMask = uiSampleMask;
+
+  CountStateChange();
+}
+
+void ezGALRenderCommandEncoder::ApplyDepthStencilState(ezGALDepthStencilStateHandle hDepthStencilState, ezUInt8 uiStencilRefValue)
+{
+  const ezGALDepthStencilState* pDepthStencilState = GetDevice().GetDepthStencilState(hDepthStencilState);
+
+  m_RenderImpl.SetDepthStencilStatePlatform(pDepthStencilState, uiStencilRefValue);
+
+  m_RenderState.m_hDepthStencilState = hDepthStencilState;
+  m_RenderState.m_uiStencilRefValue = uiStencilRefValue;
+
+  CountStateChange();
+}
+
+void ezGALRenderCommandEncoder::ApplyRasterizerState(ezGALRasterizerStateHandle hRasterizerState)
+{
+  const ezGALRasterizerState* pRasterizerState = GetDevice().GetRasterizerState(hRasterizerState);
+
+  m_RenderImpl.SetRasterizerStatePlatform(pRasterizerState);
+
+  m_RenderState.m_hRasterizerState = hRasterizerState;
+
+  CountStateChange();
+}
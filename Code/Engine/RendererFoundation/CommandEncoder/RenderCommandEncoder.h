@@ -4,6 +4,8 @@
 #include <Foundation/Math/Rect.h>
 #include <RendererFoundation/CommandEncoder/CommandEncoder.h>
 
+class ezGALCommandList;
+
 class EZ_RENDERERFOUNDATION_DLL ezGALRenderCommandEncoder : public ezGALCommandEncoder
 {
 public:
@@ -35,7 +37,10 @@ public:
   void SetVertexBuffer(ezUInt32 uiSlot, ezGALBufferHandle hVertexBuffer);
   void SetVertexDeclaration(ezGALVertexDeclarationHandle hVertexDeclaration);
 
-  ezGALPrimitiveTopology::Enum GetPrimitiveTopology() const { return m_RenderState.m_Topology; }
+  ezGALPrimitiveTopology::Enum GetPrimitiveTopology() const
+  {
+    return (m_RenderState.m_uiPendingFlags & ezGALCommandEncoderState::PendingTopology) ? m_RenderState.m_PendingTopology : m_RenderState.m_Topology;
+  }
   void SetPrimitiveTopology(ezGALPrimitiveTopology::Enum Topology);
 
   void SetBlendState(ezGALBlendStateHandle hBlendState, const ezColor& BlendFactor = ezColor::White, ezUInt32 uiSampleMask = 0xFFFFFFFFu);
@@ -47,11 +52,27 @@ public:
 
   void SetStreamOutBuffer(ezUInt32 uiSlot, ezGALBufferHandle hBuffer, ezUInt32 uiOffset);
 
+  /// \brief Executes the commands of a previously recorded command list.
+  ///
+  /// The command list can't be recording. Afterwards the state of this encoder is invalidated since the executed commands changed it.
+  void ExecuteCommandList(const ezGALCommandList& commandList);
+
   virtual void ClearStatisticsCounters() override;
 
+protected:
+  virtual void ApplyPendingState() override;
+
 private:
   void CountDrawCall() { m_uiDrawCalls++; }
 
+  void ApplyIndexBuffer(ezGALBufferHandle hIndexBuffer);
+  void ApplyVertexBuffer(ezUInt32 uiSlot, ezGALBufferHandle hVertexBuffer);
+  void ApplyVertexDeclaration(ezGALVertexDeclarationHandle hVertexDeclaration);
+  void ApplyPrimitiveTopology(ezGALPrimitiveTopology::Enum Topology);
+  void ApplyBlendState(ezGALBlendStateHandle hBlendState, const ezColor& BlendFactor, ezUInt32 uiSampleMask);
+  void ApplyDepthStencilState(ezGALDepthStencilStateHandle hDepthStencilState, ezUInt8 uiStencilRefValue);
+  void ApplyRasterizerState(ezGALRasterizerStateHandle hRasterizerState);
+
   // Statistic variables
   ezUInt32 m_uiDrawCalls = 0;
 
@@ -0,0 +1,276 @@
+#include <RendererNullPCH.h>
+
+#include <RendererNull/CommandEncoder/CommandEncoderImplNull.h>
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/Resources/ResourcesNull.h>
+
+ezGALCommandEncoderImplNull::ezGALCommandEncoderImplNull(ezGALDeviceNull& deviceNull)
+  : m_GALDeviceNull(deviceNull)
+{
+}
+
+ezGALCommandEncoderImplNull::~ezGALCommandEncoderImplNull() = default;
+
+// State setting functions
+
+void ezGALCommandEncoderImplNull::SetShaderPlatform(const ezGALShader* pShader)
+{
+  m_GALDeviceNull.m_Statistics.m_uiShaderChanges++;
+}
+
+void ezGALCommandEncoderImplNull::SetConstantBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer)
+{
+  m_GALDeviceNull.m_Statistics.m_uiConstantBufferChanges++;
+}
+
+void ezGALCommandEncoderImplNull::SetSamplerStatePlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALSamplerState* pSamplerState)
+{
+  m_GALDeviceNull.m_Statistics.m_uiResourceBindings++;
+}
+
+void ezGALCommandEncoderImplNull::SetResourceViewPlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALResourceView* pResourceView)
+{
+  m_GALDeviceNull.m_Statistics.m_uiResourceBindings++;
+}
+
+void ezGALCommandEncoderImplNull::SetUnorderedAccessViewPlatform(ezUInt32 uiSlot, const ezGALUnorderedAccessView* pUnorderedAccessView)
+{
+  m_GALDeviceNull.m_Statistics.m_uiResourceBindings++;
+}
+
+// Fence & Query functions
+
+void ezGALCommandEncoderImplNull::InsertFencePlatform(const ezGALFence* pFence) {}
+
+bool ezGALCommandEncoderImplNull::IsFenceReachedPlatform(const ezGALFence* pFence)
+{
+  // Nothing is ever executed, so every fence is reached immediately.
+  return true;
+}
+
+void ezGALCommandEncoderImplNull::WaitForFencePlatform(const ezGALFence* pFence) {}
+
+void ezGALCommandEncoderImplNull::BeginQueryPlatform(const ezGALQuery* pQuery) {}
+
+void ezGALCommandEncoderImplNull::EndQueryPlatform(const ezGALQuery* pQuery) {}
+
+ezResult ezGALCommandEncoderImplNull::GetQueryResultPlatform(const ezGALQuery* pQuery, ezUInt64& uiQueryResult)
+{
+  uiQueryResult = 0;
+  return EZ_SUCCESS;
+}
+
+// Timestamp functions
+
+void ezGALCommandEncoderImplNull::InsertTimestampPlatform(ezGALTimestampHandle hTimestamp) {}
+
+// Resource update functions
+
+void ezGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4 clearValues)
+{
+  m_GALDeviceNull.m_Statistics.m_uiClears++;
+}
+
+void ezGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4U32 clearValues)
+{
+  m_GALDeviceNull.m_Statistics.m_uiClears++;
+}
+
+void ezGALCommandEncoderImplNull::CopyBufferPlatform(const ezGALBuffer* pDestination, const ezGALBuffer* pSource)
+{
+  m_GALDeviceNull.m_Statistics.m_uiResourceUpdates++;
+}
+
+void ezGALCommandEncoderImplNull::CopyBufferRegionPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, const ezGALBuffer* pSource, ezUInt32 uiSourceOffset, ezUInt32 uiByteCount)
+{
+  m_GALDeviceNull.m_Statistics.m_uiResourceUpdates++;
+}
+
+void ezGALCommandEncoderImplNull::UpdateBufferPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, ezArrayPtr<const ezUInt8> pSourceData, ezGALUpdateMode::Enum updateMode)
+{
+  m_GALDeviceNull.m_Statistics.m_uiResourceUpdates++;
+  m_GALDeviceNull.m_Statistics.m_uiUploadedBytes += pSourceData.GetCount();
+}
+
+void ezGALCommandEncoderImplNull::CopyTexturePlatform(const ezGALTexture* pDestination, const ezGALTexture* pSource)
+{
+  m_GALDeviceNull.m_Statistics.m_uiResourceUpdates++;
+}
+
+void ezGALCommandEncoderImplNull::CopyTextureRegionPlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource, const ezVec3U32& DestinationPoint, const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource, const ezBoundingBoxu32& Box)
+{
+  m_GALDeviceNull.m_Statistics.m_uiResourceUpdates++;
+}
+
+void ezGALCommandEncoderImplNull::UpdateTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource,
+  const ezBoundingBoxu32& DestinationBox, const ezGALSystemMemoryDescription& pSourceData)
+{
+  m_GALDeviceNull.m_Statistics.m_uiResourceUpdates++;
+}
+
+void ezGALCommandEncoderImplNull::ResolveTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource,
+  const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource)
+{
+  m_GALDeviceNull.m_Statistics.m_uiResourceUpdates++;
+}
+
+void ezGALCommandEncoderImplNull::ReadbackTexturePlatform(const ezGALTexture* pTexture) {}
+
+void ezGALCommandEncoderImplNull::CopyTextureReadbackResultPlatform(const ezGALTexture* pTexture, ezArrayPtr<ezGALTextureSubresource> SourceSubResource, ezArrayPtr<ezGALSystemMemoryDescription> TargetData)
+{
+  EZ_ASSERT_DEV(SourceSubResource.GetCount() == TargetData.GetCount(), "Source and target arrays must be of the same size.");
+
+  // The texture has no content, hand out black images so that the caller does not read uninitialized memory.
+  const ezUInt32 uiSubResources = SourceSubResource.GetCount();
+  for (ezUInt32 i = 0; i < uiSubResources; i++)
+  {
+    const ezGALSystemMemoryDescription& memDesc = TargetData[i];
+    const ezUInt32 uiHeight = ezMath::Max(1u, pTexture->GetDescription().m_uiHeight >> SourceSubResource[i].m_uiMipLevel);
+
+    if (memDesc.m_pData != nullptr)
+    {
+      ezMemoryUtils::ZeroFill(static_cast<ezUInt8*>(memDesc.m_pData), memDesc.m_uiRowPitch * uiHeight);
+    }
+  }
+}
+
+void ezGALCommandEncoderImplNull::GenerateMipMapsPlatform(const ezGALResourceView* pResourceView)
+{
+  m_GALDeviceNull.m_Statistics.m_uiResourceUpdates++;
+}
+
+// Misc
+
+void ezGALCommandEncoderImplNull::FlushPlatform() {}
+
+// Debug helper functions
+
+void ezGALCommandEncoderImplNull::PushMarkerPlatform(const char* szMarker) {}
+
+void ezGALCommandEncoderImplNull::PopMarkerPlatform() {}
+
+void ezGALCommandEncoderImplNull::InsertEventMarkerPlatform(const char* szMarker) {}
+
+//////////////////////////////////////////////////////////////////////////
+
+void ezGALCommandEncoderImplNull::BeginRendering(const ezGALRenderingSetup& renderingSetup)
+{
+  m_GALDeviceNull.m_Statistics.m_uiRenderingScopes++;
+
+  if (renderingSetup.m_uiRenderTargetClearMask != 0 || renderingSetup.m_bClearDepth || renderingSetup.m_bClearStencil)
+  {
+    m_GALDeviceNull.m_Statistics.m_uiClears++;
+  }
+}
+
+// Draw functions
+
+void ezGALCommandEncoderImplNull::ClearPlatform(const ezColor& ClearColor, ezUInt32 uiRenderTargetClearMask, bool bClearDepth, bool bClearStencil, float fDepthClear, ezUInt8 uiStencilClear)
+{
+  m_GALDeviceNull.m_Statistics.m_uiClears++;
+}
+
+void ezGALCommandEncoderImplNull::DrawPlatform(ezUInt32 uiVertexCount, ezUInt32 uiStartVertex)
+{
+  m_GALDeviceNull.m_Statistics.m_uiDrawCalls++;
+}
+
+void ezGALCommandEncoderImplNull::DrawIndexedPlatform(ezUInt32 uiIndexCount, ezUInt32 uiStartIndex)
+{
+  m_GALDeviceNull.m_Statistics.m_uiDrawCalls++;
+}
+
+void ezGALCommandEncoderImplNull::DrawIndexedInstancedPlatform(ezUInt32 uiIndexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartIndex)
+{
+  m_GALDeviceNull.m_Statistics.m_uiDrawCalls++;
+}
+
+void ezGALCommandEncoderImplNull::DrawIndexedInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  m_GALDeviceNull.m_Statistics.m_uiDrawCalls++;
+}
+
+void ezGALCommandEncoderImplNull::DrawInstancedPlatform(ezUInt32 uiVertexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartVertex)
+{
+  m_GALDeviceNull.m_Statistics.m_uiDrawCalls++;
+}
+
+void ezGALCommandEncoderImplNull::DrawInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  m_GALDeviceNull.m_Statistics.m_uiDrawCalls++;
+}
+
+void ezGALCommandEncoderImplNull::DrawAutoPlatform()
+{
+  m_GALDeviceNull.m_Statistics.m_uiDrawCalls++;
+}
+
+void ezGALCommandEncoderImplNull::BeginStreamOutPlatform() {}
+
+void ezGALCommandEncoderImplNull::EndStreamOutPlatform() {}
+
+// State functions
+
+void ezGALCommandEncoderImplNull::SetIndexBufferPlatform(const ezGALBuffer* pIndexBuffer)
+{
+  m_GALDeviceNull.m_Statistics.m_uiGeometryChanges++;
+}
+
+void ezGALCommandEncoderImplNull::SetVertexBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pVertexBuffer)
+{
+  m_GALDeviceNull.m_Statistics.m_uiGeometryChanges++;
+}
+
+void ezGALCommandEncoderImplNull::SetVertexDeclarationPlatform(const ezGALVertexDeclaration* pVertexDeclaration)
+{
+  m_GALDeviceNull.m_Statistics.m_uiGeometryChanges++;
+}
+
+void ezGALCommandEncoderImplNull::SetPrimitiveTopologyPlatform(ezGALPrimitiveTopology::Enum Topology)
+{
+  m_GALDeviceNull.m_Statistics.m_uiGeometryChanges++;
+}
+
+void ezGALCommandEncoderImplNull::SetBlendStatePlatform(const ezGALBlendState* pBlendState, const ezColor& BlendFactor, ezUInt32 uiSampleMask)
+{
+  m_GALDeviceNull.m_Statistics.m_uiRenderStateChanges++;
+}
+
+void ezGALCommandEncoderImplNull::SetDepthStencilStatePlatform(const ezGALDepthStencilState* pDepthStencilState, ezUInt8 uiStencilRefValue)
+{
+  m_GALDeviceNull.m_Statistics.m_uiRenderStateChanges++;
+}
+
+void ezGALCommandEncoderImplNull::SetRasterizerStatePlatform(const ezGALRasterizerState* pRasterizerState)
+{
+  m_GALDeviceNull.m_Statistics.m_uiRenderStateChanges++;
+}
+
+void ezGALCommandEncoderImplNull::SetViewportPlatform(const ezRectFloat& rect, float fMinDepth, float fMaxDepth)
+{
+  m_GALDeviceNull.m_Statistics.m_uiRenderStateChanges++;
+}
+
+void ezGALCommandEncoderImplNull::SetScissorRectPlatform(const ezRectU32& rect)
+{
+  m_GALDeviceNull.m_Statistics.m_uiRenderStateChanges++;
+}
+
+void ezGALCommandEncoderImplNull::SetStreamOutBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer, ezUInt32 uiOffset)
+{
+  m_GALDeviceNull.m_Statistics.m_uiGeometryChanges++;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+void ezGALCommandEncoderImplNull::DispatchPlatform(ezUInt32 uiThreadGroupCountX, ezUInt32 uiThreadGroupCountY, ezUInt32 uiThreadGroupCountZ)
+{
+  m_GALDeviceNull.m_Statistics.m_uiDispatchCalls++;
+}
+
+void ezGALCommandEncoderImplNull::DispatchIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  m_GALDeviceNull.m_Statistics.m_uiDispatchCalls++;
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_CommandEncoder_Implementation_CommandEncoderImplNull);
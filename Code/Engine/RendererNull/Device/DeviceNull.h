@@ -0,0 +1,134 @@
+#pragma once
+
+#include <Foundation/Types/UniquePtr.h>
+#include <RendererFoundation/Device/Device.h>
+#include <RendererNull/RendererNullDLL.h>
+
+class ezGALPassNull;
+
+/// \brief A graphics device that does not talk to any GPU.
+///
+/// All objects are created as usual and get valid handles, but no GPU memory is allocated and commands are only counted.
+/// This allows to run the complete render pipeline on machines without a graphics card, e.g. to measure the CPU cost of
+/// extraction, sorting and command submission in isolation.
+class EZ_RENDERERNULL_DLL ezGALDeviceNull : public ezGALDevice
+{
+private:
+  friend ezInternal::NewInstance<ezGALDevice> CreateNullDevice(ezAllocatorBase* pAllocator, const ezGALDeviceCreationDescription& Description);
+  ezGALDeviceNull(const ezGALDeviceCreationDescription& Description);
+
+public:
+  virtual ~ezGALDeviceNull();
+
+  /// \brief Number of commands that reached the device since the last call to ResetStatistics().
+  struct Statistics
+  {
+    ezUInt32 m_uiRenderingScopes = 0;       ///< BeginRendering calls
+    ezUInt32 m_uiClears = 0;                ///< Render target and unordered access view clears
+    ezUInt32 m_uiDrawCalls = 0;             ///< All kinds of draws, including instanced and indirect ones
+    ezUInt32 m_uiDispatchCalls = 0;         ///< Direct and indirect dispatches
+    ezUInt32 m_uiShaderChanges = 0;         ///< SetShader calls
+    ezUInt32 m_uiConstantBufferChanges = 0; ///< SetConstantBuffer calls
+    ezUInt32 m_uiResourceBindings = 0;      ///< Resource view, unordered access view and sampler state bindings
+    ezUInt32 m_uiGeometryChanges = 0;       ///< Index buffer, vertex buffer, vertex declaration and topology changes
+    ezUInt32 m_uiRenderStateChanges = 0;    ///< Blend, depth stencil and rasterizer state, viewport and scissor rect changes
+    ezUInt32 m_uiResourceUpdates = 0;       ///< Buffer and texture updates, copies, resolves and mip map generation
+    ezUInt64 m_uiUploadedBytes = 0;         ///< Bytes passed to buffer updates
+  };
+
+  const Statistics& GetStatistics() const { return m_Statistics; }
+  void ResetStatistics() { m_Statistics = Statistics(); }
+
+  // These functions need to be implemented by a render API abstraction
+protected:
+  // Init & shutdown functions
+
+  virtual ezResult InitPlatform() override;
+  virtual ezResult ShutdownPlatform() override;
+
+  // Pipeline & Pass functions
+
+  virtual void BeginPipelinePlatform(const char* szName) override;
+  virtual void EndPipelinePlatform() override;
+
+  virtual ezGALPass* BeginPassPlatform(const char* szName) override;
+  virtual void EndPassPlatform(ezGALPass* pPass) override;
+
+
+  // State creation functions
+
+  virtual ezGALBlendState* CreateBlendStatePlatform(const ezGALBlendStateCreationDescription& Description) override;
+  virtual void DestroyBlendStatePlatform(ezGALBlendState* pBlendState) override;
+
+  virtual ezGALDepthStencilState* CreateDepthStencilStatePlatform(const ezGALDepthStencilStateCreationDescription& Description) override;
+  virtual void DestroyDepthStencilStatePlatform(ezGALDepthStencilState* pDepthStencilState) override;
+
+  virtual ezGALRasterizerState* CreateRasterizerStatePlatform(const ezGALRasterizerStateCreationDescription& Description) override;
+  virtual void DestroyRasterizerStatePlatform(ezGALRasterizerState* pRasterizerState) override;
+
+  virtual ezGALSamplerState* CreateSamplerStatePlatform(const ezGALSamplerStateCreationDescription& Description) override;
+  virtual void DestroySamplerStatePlatform(ezGALSamplerState* pSamplerState) override;
+
+
+  // Resource creation functions
+
+  virtual ezGALShader* CreateShaderPlatform(const ezGALShaderCreationDescription& Description) override;
+  virtual void DestroyShaderPlatform(ezGALShader* pShader) override;
+
+  virtual ezGALBuffer* CreateBufferPlatform(const ezGALBufferCreationDescription& Description, ezArrayPtr<const ezUInt8> pInitialData) override;
+  virtual void DestroyBufferPlatform(ezGALBuffer* pBuffer) override;
+
+  virtual ezGALTexture* CreateTexturePlatform(const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData) override;
+  virtual void DestroyTexturePlatform(ezGALTexture* pTexture) override;
+
+  virtual ezGALResourceView* CreateResourceViewPlatform(ezGALResourceBase* pResource, const ezGALResourceViewCreationDescription& Description) override;
+  virtual void DestroyResourceViewPlatform(ezGALResourceView* pResourceView) override;
+
+  virtual ezGALRenderTargetView* CreateRenderTargetViewPlatform(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description) override;
+  virtual void DestroyRenderTargetViewPlatform(ezGALRenderTargetView* pRenderTargetView) override;
+
+  ezGALUnorderedAccessView* CreateUnorderedAccessViewPlatform(ezGALResourceBase* pResource, const ezGALUnorderedAccessViewCreationDescription& Description) override;
+  virtual void DestroyUnorderedAccessViewPlatform(ezGALUnorderedAccessView* pUnorderedAccessView) override;
+
+  // Other rendering creation functions
+
+  virtual ezGALSwapChain* CreateSwapChainPlatform(const ezGALSwapChainCreationDescription& Description) override;
+  virtual void DestroySwapChainPlatform(ezGALSwapChain* pSwapChain) override;
+
+  virtual ezGALFence* CreateFencePlatform() override;
+  virtual void DestroyFencePlatform(ezGALFence* pFence) override;
+
+  virtual ezGALQuery* CreateQueryPlatform(const ezGALQueryCreationDescription& Description) override;
+  virtual void DestroyQueryPlatform(ezGALQuery* pQuery) override;
+
+  virtual ezGALVertexDeclaration* CreateVertexDeclarationPlatform(const ezGALVertexDeclarationCreationDescription& Description) override;
+  virtual void DestroyVertexDeclarationPlatform(ezGALVertexDeclaration* pVertexDeclaration) override;
+
+  // Timestamp functions
+
+  virtual ezGALTimestampHandle GetTimestampPlatform() override;
+  virtual ezResult GetTimestampResultPlatform(ezGALTimestampHandle hTimestamp, ezTime& result) override;
+
+  // Swap chain functions
+
+  virtual void PresentPlatform(ezGALSwapChain* pSwapChain, bool bVSync) override;
+
+  // Misc functions
+
+  virtual void BeginFramePlatform() override;
+  virtual void EndFramePlatform() override;
+
+  virtual void SetPrimarySwapChainPlatform(ezGALSwapChain* pSwapChain) override;
+
+  virtual void FillCapabilitiesPlatform() override;
+
+private:
+  friend class ezGALCommandEncoderImplNull;
+
+  ezUniquePtr<ezGALPassNull> m_pDefaultPass;
+
+  Statistics m_Statistics;
+
+  ezUInt64 m_uiFrameCounter = 0;
+  ezUInt32 m_uiNextTimestamp = 0;
+};
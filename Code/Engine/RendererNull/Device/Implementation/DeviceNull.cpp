@@ -0,0 +1,447 @@
+#include <RendererNullPCH.h>
+
+#include <Foundation/Configuration/Startup.h>
+#include <RendererFoundation/CommandEncoder/RenderCommandEncoder.h>
+#include <RendererFoundation/Device/DeviceFactory.h>
+#include <RendererNull/CommandEncoder/CommandEncoderImplNull.h>
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/Device/PassNull.h>
+#include <RendererNull/Device/SwapChainNull.h>
+#include <RendererNull/Resources/ResourcesNull.h>
+#include <RendererNull/Shader/ShaderNull.h>
+#include <RendererNull/State/StateNull.h>
+
+ezInternal::NewInstance<ezGALDevice> CreateNullDevice(ezAllocatorBase* pAllocator, const ezGALDeviceCreationDescription& Description)
+{
+  return EZ_NEW(pAllocator, ezGALDeviceNull, Description);
+}
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(RendererNull, DeviceFactory)
+
+ON_CORESYSTEMS_STARTUP
+{
+  // Uses the DX11 shader model so that the existing shader caches can be used, the byte code is never executed anyway.
+  ezGALDeviceFactory::RegisterCreatorFunc("Null", &CreateNullDevice, "DX11_SM50", "ezShaderCompilerHLSL");
+}
+
+ON_CORESYSTEMS_SHUTDOWN
+{
+  ezGALDeviceFactory::UnregisterCreatorFunc("Null");
+}
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+ezGALDeviceNull::ezGALDeviceNull(const ezGALDeviceCreationDescription& Description)
+  : ezGALDevice(Description)
+{
+}
+
+ezGALDeviceNull::~ezGALDeviceNull() = default;
+
+// Init & shutdown functions
+
+ezResult ezGALDeviceNull::InitPlatform()
+{
+  EZ_LOG_BLOCK("ezGALDeviceNull::InitPlatform");
+
+  // Create default pass
+  m_pDefaultPass = EZ_NEW(&m_Allocator, ezGALPassNull, *this);
+
+  ezLog::Success("Initialized null device, nothing will be rendered.");
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALDeviceNull::ShutdownPlatform()
+{
+  m_pDefaultPass = nullptr;
+
+  return EZ_SUCCESS;
+}
+
+// Pipeline & Pass functions
+
+void ezGALDeviceNull::BeginPipelinePlatform(const char* szName)
+{
+  m_pDefaultPass->m_pRenderCommandEncoder->PushMarker(szName);
+}
+
+void ezGALDeviceNull::EndPipelinePlatform()
+{
+  m_pDefaultPass->m_pRenderCommandEncoder->PopMarker();
+}
+
+ezGALPass* ezGALDeviceNull::BeginPassPlatform(const char* szName)
+{
+  m_pDefaultPass->BeginPass(szName);
+
+  return m_pDefaultPass.Borrow();
+}
+
+void ezGALDeviceNull::EndPassPlatform(ezGALPass* pPass)
+{
+  EZ_ASSERT_DEV(m_pDefaultPass.Borrow() == pPass, "Invalid pass");
+
+  m_pDefaultPass->EndPass();
+}
+
+// State creation functions
+
+ezGALBlendState* ezGALDeviceNull::CreateBlendStatePlatform(const ezGALBlendStateCreationDescription& Description)
+{
+  ezGALBlendStateNull* pState = EZ_NEW(&m_Allocator, ezGALBlendStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    return pState;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyBlendStatePlatform(ezGALBlendState* pBlendState)
+{
+  ezGALBlendStateNull* pState = static_cast<ezGALBlendStateNull*>(pBlendState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pState);
+}
+
+ezGALDepthStencilState* ezGALDeviceNull::CreateDepthStencilStatePlatform(const ezGALDepthStencilStateCreationDescription& Description)
+{
+  ezGALDepthStencilStateNull* pState = EZ_NEW(&m_Allocator, ezGALDepthStencilStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    return pState;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyDepthStencilStatePlatform(ezGALDepthStencilState* pDepthStencilState)
+{
+  ezGALDepthStencilStateNull* pState = static_cast<ezGALDepthStencilStateNull*>(pDepthStencilState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pState);
+}
+
+ezGALRasterizerState* ezGALDeviceNull::CreateRasterizerStatePlatform(const ezGALRasterizerStateCreationDescription& Description)
+{
+  ezGALRasterizerStateNull* pState = EZ_NEW(&m_Allocator, ezGALRasterizerStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    return pState;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyRasterizerStatePlatform(ezGALRasterizerState* pRasterizerState)
+{
+  ezGALRasterizerStateNull* pState = static_cast<ezGALRasterizerStateNull*>(pRasterizerState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pState);
+}
+
+ezGALSamplerState* ezGALDeviceNull::CreateSamplerStatePlatform(const ezGALSamplerStateCreationDescription& Description)
+{
+  ezGALSamplerStateNull* pState = EZ_NEW(&m_Allocator, ezGALSamplerStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    return pState;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroySamplerStatePlatform(ezGALSamplerState* pSamplerState)
+{
+  ezGALSamplerStateNull* pState = static_cast<ezGALSamplerStateNull*>(pSamplerState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pState);
+}
+
+// Resource creation functions
+
+ezGALShader* ezGALDeviceNull::CreateShaderPlatform(const ezGALShaderCreationDescription& Description)
+{
+  ezGALShaderNull* pShader = EZ_NEW(&m_Allocator, ezGALShaderNull, Description);
+
+  if (!pShader->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pShader);
+    return nullptr;
+  }
+
+  return pShader;
+}
+
+void ezGALDeviceNull::DestroyShaderPlatform(ezGALShader* pShader)
+{
+  ezGALShaderNull* pNullShader = static_cast<ezGALShaderNull*>(pShader);
+  pNullShader->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullShader);
+}
+
+ezGALBuffer* ezGALDeviceNull::CreateBufferPlatform(const ezGALBufferCreationDescription& Description, ezArrayPtr<const ezUInt8> pInitialData)
+{
+  ezGALBufferNull* pBuffer = EZ_NEW(&m_Allocator, ezGALBufferNull, Description);
+
+  if (!pBuffer->InitPlatform(this, pInitialData).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pBuffer);
+    return nullptr;
+  }
+
+  return pBuffer;
+}
+
+void ezGALDeviceNull::DestroyBufferPlatform(ezGALBuffer* pBuffer)
+{
+  ezGALBufferNull* pNullBuffer = static_cast<ezGALBufferNull*>(pBuffer);
+  pNullBuffer->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullBuffer);
+}
+
+ezGALTexture* ezGALDeviceNull::CreateTexturePlatform(const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData)
+{
+  ezGALTextureNull* pTexture = EZ_NEW(&m_Allocator, ezGALTextureNull, Description);
+
+  if (!pTexture->InitPlatform(this, pInitialData).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pTexture);
+    return nullptr;
+  }
+
+  return pTexture;
+}
+
+void ezGALDeviceNull::DestroyTexturePlatform(ezGALTexture* pTexture)
+{
+  ezGALTextureNull* pNullTexture = static_cast<ezGALTextureNull*>(pTexture);
+  pNullTexture->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullTexture);
+}
+
+ezGALResourceView* ezGALDeviceNull::CreateResourceViewPlatform(ezGALResourceBase* pResource, const ezGALResourceViewCreationDescription& Description)
+{
+  ezGALResourceViewNull* pResourceView = EZ_NEW(&m_Allocator, ezGALResourceViewNull, pResource, Description);
+
+  if (!pResourceView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pResourceView);
+    return nullptr;
+  }
+
+  return pResourceView;
+}
+
+void ezGALDeviceNull::DestroyResourceViewPlatform(ezGALResourceView* pResourceView)
+{
+  ezGALResourceViewNull* pNullResourceView = static_cast<ezGALResourceViewNull*>(pResourceView);
+  pNullResourceView->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullResourceView);
+}
+
+ezGALRenderTargetView* ezGALDeviceNull::CreateRenderTargetViewPlatform(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description)
+{
+  ezGALRenderTargetViewNull* pRTView = EZ_NEW(&m_Allocator, ezGALRenderTargetViewNull, pTexture, Description);
+
+  if (!pRTView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pRTView);
+    return nullptr;
+  }
+
+  return pRTView;
+}
+
+void ezGALDeviceNull::DestroyRenderTargetViewPlatform(ezGALRenderTargetView* pRenderTargetView)
+{
+  ezGALRenderTargetViewNull* pNullRenderTargetView = static_cast<ezGALRenderTargetViewNull*>(pRenderTargetView);
+  pNullRenderTargetView->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullRenderTargetView);
+}
+
+ezGALUnorderedAccessView* ezGALDeviceNull::CreateUnorderedAccessViewPlatform(ezGALResourceBase* pResource, const ezGALUnorderedAccessViewCreationDescription& Description)
+{
+  ezGALUnorderedAccessViewNull* pUnorderedAccessView = EZ_NEW(&m_Allocator, ezGALUnorderedAccessViewNull, pResource, Description);
+
+  if (!pUnorderedAccessView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pUnorderedAccessView);
+    return nullptr;
+  }
+
+  return pUnorderedAccessView;
+}
+
+void ezGALDeviceNull::DestroyUnorderedAccessViewPlatform(ezGALUnorderedAccessView* pUnorderedAccessView)
+{
+  ezGALUnorderedAccessViewNull* pNullUnorderedAccessView = static_cast<ezGALUnorderedAccessViewNull*>(pUnorderedAccessView);
+  pNullUnorderedAccessView->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullUnorderedAccessView);
+}
+
+// Other rendering creation functions
+
+ezGALSwapChain* ezGALDeviceNull::CreateSwapChainPlatform(const ezGALSwapChainCreationDescription& Description)
+{
+  ezGALSwapChainNull* pSwapChain = EZ_NEW(&m_Allocator, ezGALSwapChainNull, Description);
+
+  if (!pSwapChain->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pSwapChain);
+    return nullptr;
+  }
+
+  return pSwapChain;
+}
+
+void ezGALDeviceNull::DestroySwapChainPlatform(ezGALSwapChain* pSwapChain)
+{
+  ezGALSwapChainNull* pNullSwapChain = static_cast<ezGALSwapChainNull*>(pSwapChain);
+  pNullSwapChain->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullSwapChain);
+}
+
+ezGALFence* ezGALDeviceNull::CreateFencePlatform()
+{
+  ezGALFenceNull* pFence = EZ_NEW(&m_Allocator, ezGALFenceNull);
+
+  if (!pFence->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pFence);
+    return nullptr;
+  }
+
+  return pFence;
+}
+
+void ezGALDeviceNull::DestroyFencePlatform(ezGALFence* pFence)
+{
+  ezGALFenceNull* pNullFence = static_cast<ezGALFenceNull*>(pFence);
+  pNullFence->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullFence);
+}
+
+ezGALQuery* ezGALDeviceNull::CreateQueryPlatform(const ezGALQueryCreationDescription& Description)
+{
+  ezGALQueryNull* pQuery = EZ_NEW(&m_Allocator, ezGALQueryNull, Description);
+
+  if (!pQuery->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pQuery);
+    return nullptr;
+  }
+
+  return pQuery;
+}
+
+void ezGALDeviceNull::DestroyQueryPlatform(ezGALQuery* pQuery)
+{
+  ezGALQueryNull* pNullQuery = static_cast<ezGALQueryNull*>(pQuery);
+  pNullQuery->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullQuery);
+}
+
+ezGALVertexDeclaration* ezGALDeviceNull::CreateVertexDeclarationPlatform(const ezGALVertexDeclarationCreationDescription& Description)
+{
+  ezGALVertexDeclarationNull* pVertexDeclaration = EZ_NEW(&m_Allocator, ezGALVertexDeclarationNull, Description);
+
+  if (pVertexDeclaration->InitPlatform(this).Succeeded())
+  {
+    return pVertexDeclaration;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pVertexDeclaration);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyVertexDeclarationPlatform(ezGALVertexDeclaration* pVertexDeclaration)
+{
+  ezGALVertexDeclarationNull* pNullVertexDeclaration = static_cast<ezGALVertexDeclarationNull*>(pVertexDeclaration);
+  pNullVertexDeclaration->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullVertexDeclaration);
+}
+
+// Timestamp functions
+
+ezGALTimestampHandle ezGALDeviceNull::GetTimestampPlatform()
+{
+  return {m_uiNextTimestamp++, m_uiFrameCounter};
+}
+
+ezResult ezGALDeviceNull::GetTimestampResultPlatform(ezGALTimestampHandle hTimestamp, ezTime& result)
+{
+  // There is no GPU work that could be measured.
+  result.SetZero();
+  return EZ_SUCCESS;
+}
+
+// Swap chain functions
+
+void ezGALDeviceNull::PresentPlatform(ezGALSwapChain* pSwapChain, bool bVSync) {}
+
+// Misc functions
+
+void ezGALDeviceNull::BeginFramePlatform() {}
+
+void ezGALDeviceNull::EndFramePlatform()
+{
+  ++m_uiFrameCounter;
+}
+
+void ezGALDeviceNull::SetPrimarySwapChainPlatform(ezGALSwapChain* pSwapChain) {}
+
+void ezGALDeviceNull::FillCapabilitiesPlatform()
+{
+  m_Capabilities.m_sAdapterName = "Null Device";
+  m_Capabilities.m_bHardwareAccelerated = false;
+
+  m_Capabilities.m_bMultithreadedResourceCreation = true;
+  m_Capabilities.m_bNoOverwriteBufferUpdate = true;
+
+  // Report the same feature set as a DX11.1 device, so that the renderer takes the same code paths as on real hardware.
+  for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    m_Capabilities.m_bShaderStageSupported[stage] = true;
+  }
+
+  m_Capabilities.m_bInstancing = true;
+  m_Capabilities.m_b32BitIndices = true;
+  m_Capabilities.m_bIndirectDraw = true;
+  m_Capabilities.m_bStreamOut = true;
+  m_Capabilities.m_bConservativeRasterization = true;
+  m_Capabilities.m_uiMaxConstantBuffers = 14;
+  m_Capabilities.m_bTextureArrays = true;
+  m_Capabilities.m_bCubemapArrays = true;
+  m_Capabilities.m_bB5G6R5Textures = true;
+  m_Capabilities.m_uiMaxTextureDimension = 16384;
+  m_Capabilities.m_uiMaxCubemapDimension = 16384;
+  m_Capabilities.m_uiMax3DTextureDimension = 2048;
+  m_Capabilities.m_uiMaxAnisotropy = 16;
+  m_Capabilities.m_uiMaxRendertargets = 8;
+  m_Capabilities.m_uiUAVCount = 64;
+  m_Capabilities.m_bAlphaToCoverage = true;
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Device_Implementation_DeviceNull);
@@ -0,0 +1,54 @@
+#include <RendererNullPCH.h>
+
+#include <RendererFoundation/CommandEncoder/CommandEncoderState.h>
+#include <RendererFoundation/CommandEncoder/ComputeCommandEncoder.h>
+#include <RendererFoundation/CommandEncoder/RenderCommandEncoder.h>
+#include <RendererNull/CommandEncoder/CommandEncoderImplNull.h>
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/Device/PassNull.h>
+
+ezGALPassNull::ezGALPassNull(ezGALDevice& device)
+  : ezGALPass(device)
+{
+  m_pCommandEncoderState = EZ_DEFAULT_NEW(ezGALCommandEncoderRenderState);
+  m_pCommandEncoderImpl = EZ_DEFAULT_NEW(ezGALCommandEncoderImplNull, static_cast<ezGALDeviceNull&>(device));
+
+  m_pRenderCommandEncoder = EZ_DEFAULT_NEW(ezGALRenderCommandEncoder, device, *m_pCommandEncoderState, *m_pCommandEncoderImpl, *m_pCommandEncoderImpl);
+  m_pComputeCommandEncoder = EZ_DEFAULT_NEW(ezGALComputeCommandEncoder, device, *m_pCommandEncoderState, *m_pCommandEncoderImpl, *m_pCommandEncoderImpl);
+}
+
+ezGALPassNull::~ezGALPassNull() = default;
+
+ezGALRenderCommandEncoder* ezGALPassNull::BeginRenderingPlatform(const ezGALRenderingSetup& renderingSetup, const char* szName)
+{
+  m_pCommandEncoderImpl->BeginRendering(renderingSetup);
+
+  return m_pRenderCommandEncoder.Borrow();
+}
+
+void ezGALPassNull::EndRenderingPlatform(ezGALRenderCommandEncoder* pCommandEncoder)
+{
+  EZ_ASSERT_DEV(m_pRenderCommandEncoder.Borrow() == pCommandEncoder, "Invalid command encoder");
+}
+
+ezGALComputeCommandEncoder* ezGALPassNull::BeginComputePlatform(const char* szName)
+{
+  return m_pComputeCommandEncoder.Borrow();
+}
+
+void ezGALPassNull::EndComputePlatform(ezGALComputeCommandEncoder* pCommandEncoder)
+{
+  EZ_ASSERT_DEV(m_pComputeCommandEncoder.Borrow() == pCommandEncoder, "Invalid command encoder");
+}
+
+void ezGALPassNull::BeginPass(const char* szName)
+{
+  m_pCommandEncoderImpl->PushMarkerPlatform(szName);
+}
+
+void ezGALPassNull::EndPass()
+{
+  m_pCommandEncoderImpl->PopMarkerPlatform();
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Device_Implementation_PassNull);
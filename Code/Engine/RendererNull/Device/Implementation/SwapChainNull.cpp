@@ -0,0 +1,36 @@
+#include <RendererNullPCH.h>
+
+#include <Core/System/Window.h>
+#include <RendererFoundation/Device/Device.h>
+#include <RendererNull/Device/SwapChainNull.h>
+
+ezGALSwapChainNull::ezGALSwapChainNull(const ezGALSwapChainCreationDescription& Description)
+  : ezGALSwapChain(Description)
+{
+}
+
+ezGALSwapChainNull::~ezGALSwapChainNull() = default;
+
+ezResult ezGALSwapChainNull::InitPlatform(ezGALDevice* pDevice)
+{
+  ezGALTextureCreationDescription TexDesc;
+  TexDesc.m_uiWidth = m_Description.m_pWindow->GetClientAreaSize().width;
+  TexDesc.m_uiHeight = m_Description.m_pWindow->GetClientAreaSize().height;
+  TexDesc.m_SampleCount = m_Description.m_SampleCount;
+  TexDesc.m_Format = m_Description.m_BackBufferFormat;
+  TexDesc.m_bAllowShaderResourceView = false;
+  TexDesc.m_bCreateRenderTarget = true;
+  TexDesc.m_ResourceAccess.m_bImmutable = true;
+  TexDesc.m_ResourceAccess.m_bReadBack = m_Description.m_bAllowScreenshots;
+
+  m_hBackBufferTexture = pDevice->CreateTexture(TexDesc);
+  if (m_hBackBufferTexture.IsInvalidated())
+  {
+    ezLog::Error("Couldn't create backbuffer texture object!");
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Device_Implementation_SwapChainNull);
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <RendererFoundation/Descriptors/Descriptors.h>
+#include <RendererFoundation/Device/SwapChain.h>
+#include <RendererNull/RendererNullDLL.h>
+
+/// \brief Swap chain of the null device. Its back buffer is a regular texture of the window size, nothing is ever shown on screen.
+class ezGALSwapChainNull : public ezGALSwapChain
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALSwapChainNull(const ezGALSwapChainCreationDescription& Description);
+
+  virtual ~ezGALSwapChainNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+};
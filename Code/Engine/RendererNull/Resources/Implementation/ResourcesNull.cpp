@@ -0,0 +1,145 @@
+#include <RendererNullPCH.h>
+
+#include <RendererNull/Resources/ResourcesNull.h>
+
+ezGALBufferNull::ezGALBufferNull(const ezGALBufferCreationDescription& Description)
+  : ezGALBuffer(Description)
+{
+}
+
+ezGALBufferNull::~ezGALBufferNull() = default;
+
+ezResult ezGALBufferNull::InitPlatform(ezGALDevice* pDevice, ezArrayPtr<const ezUInt8> pInitialData)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALBufferNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+void ezGALBufferNull::SetDebugNamePlatform(const char* szName) const {}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALTextureNull::ezGALTextureNull(const ezGALTextureCreationDescription& Description)
+  : ezGALTexture(Description)
+{
+}
+
+ezGALTextureNull::~ezGALTextureNull() = default;
+
+ezResult ezGALTextureNull::InitPlatform(ezGALDevice* pDevice, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALTextureNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALTextureNull::ReplaceExisitingNativeObject(void* pExisitingNativeObject)
+{
+  // There are no native objects that could be wrapped.
+  return EZ_FAILURE;
+}
+
+void ezGALTextureNull::SetDebugNamePlatform(const char* szName) const {}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALResourceViewNull::ezGALResourceViewNull(ezGALResourceBase* pResource, const ezGALResourceViewCreationDescription& Description)
+  : ezGALResourceView(pResource, Description)
+{
+}
+
+ezGALResourceViewNull::~ezGALResourceViewNull() = default;
+
+ezResult ezGALResourceViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALResourceViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALRenderTargetViewNull::ezGALRenderTargetViewNull(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description)
+  : ezGALRenderTargetView(pTexture, Description)
+{
+}
+
+ezGALRenderTargetViewNull::~ezGALRenderTargetViewNull() = default;
+
+ezResult ezGALRenderTargetViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALRenderTargetViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALUnorderedAccessViewNull::ezGALUnorderedAccessViewNull(ezGALResourceBase* pResource, const ezGALUnorderedAccessViewCreationDescription& Description)
+  : ezGALUnorderedAccessView(pResource, Description)
+{
+}
+
+ezGALUnorderedAccessViewNull::~ezGALUnorderedAccessViewNull() = default;
+
+ezResult ezGALUnorderedAccessViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALUnorderedAccessViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALFenceNull::ezGALFenceNull() = default;
+
+ezGALFenceNull::~ezGALFenceNull() = default;
+
+ezResult ezGALFenceNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALFenceNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALQueryNull::ezGALQueryNull(const ezGALQueryCreationDescription& Description)
+  : ezGALQuery(Description)
+{
+}
+
+ezGALQueryNull::~ezGALQueryNull() = default;
+
+ezResult ezGALQueryNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALQueryNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+void ezGALQueryNull::SetDebugNamePlatform(const char* szName) const {}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Resources_Implementation_ResourcesNull);
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <RendererFoundation/Resources/Buffer.h>
+#include <RendererFoundation/Resources/Fence.h>
+#include <RendererFoundation/Resources/Query.h>
+#include <RendererFoundation/Resources/RenderTargetView.h>
+#include <RendererFoundation/Resources/ResourceView.h>
+#include <RendererFoundation/Resources/Texture.h>
+#include <RendererFoundation/Resources/UnorderedAccesView.h>
+#include <RendererNull/RendererNullDLL.h>
+
+// The resources of the null device only hold their description, no memory is ever allocated for their content.
+
+class EZ_RENDERERNULL_DLL ezGALBufferNull : public ezGALBuffer
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALBufferNull(const ezGALBufferCreationDescription& Description);
+
+  virtual ~ezGALBufferNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice, ezArrayPtr<const ezUInt8> pInitialData) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+
+  virtual void SetDebugNamePlatform(const char* szName) const override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALTextureNull : public ezGALTexture
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALTextureNull(const ezGALTextureCreationDescription& Description);
+
+  virtual ~ezGALTextureNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult ReplaceExisitingNativeObject(void* pExisitingNativeObject) override;
+
+  virtual void SetDebugNamePlatform(const char* szName) const override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALResourceViewNull : public ezGALResourceView
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALResourceViewNull(ezGALResourceBase* pResource, const ezGALResourceViewCreationDescription& Description);
+
+  virtual ~ezGALResourceViewNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALRenderTargetViewNull : public ezGALRenderTargetView
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALRenderTargetViewNull(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description);
+
+  virtual ~ezGALRenderTargetViewNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALUnorderedAccessViewNull : public ezGALUnorderedAccessView
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALUnorderedAccessViewNull(ezGALResourceBase* pResource, const ezGALUnorderedAccessViewCreationDescription& Description);
+
+  virtual ~ezGALUnorderedAccessViewNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALFenceNull : public ezGALFence
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALFenceNull();
+
+  virtual ~ezGALFenceNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALQueryNull : public ezGALQuery
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALQueryNull(const ezGALQueryCreationDescription& Description);
+
+  virtual ~ezGALQueryNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+
+  virtual void SetDebugNamePlatform(const char* szName) const override;
+};
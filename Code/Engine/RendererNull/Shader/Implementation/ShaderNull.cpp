@@ -0,0 +1,44 @@
+#include <RendererNullPCH.h>
+
+#include <RendererNull/Shader/ShaderNull.h>
+
+ezGALShaderNull::ezGALShaderNull(const ezGALShaderCreationDescription& Description)
+  : ezGALShader(Description)
+{
+}
+
+ezGALShaderNull::~ezGALShaderNull() = default;
+
+void ezGALShaderNull::SetDebugName(const char* szName) const {}
+
+ezResult ezGALShaderNull::InitPlatform(ezGALDevice* pDevice)
+{
+  // The byte code is kept in the description, there is nothing to compile or upload.
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALShaderNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALVertexDeclarationNull::ezGALVertexDeclarationNull(const ezGALVertexDeclarationCreationDescription& Description)
+  : ezGALVertexDeclaration(Description)
+{
+}
+
+ezGALVertexDeclarationNull::~ezGALVertexDeclarationNull() = default;
+
+ezResult ezGALVertexDeclarationNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALVertexDeclarationNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Shader_Implementation_ShaderNull);
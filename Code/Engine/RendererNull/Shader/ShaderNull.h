@@ -0,0 +1,38 @@
+#pragma once
+
+#include <RendererFoundation/Shader/Shader.h>
+#include <RendererFoundation/Shader/VertexDeclaration.h>
+#include <RendererNull/RendererNullDLL.h>
+
+class EZ_RENDERERNULL_DLL ezGALShaderNull : public ezGALShader
+{
+public:
+  virtual void SetDebugName(const char* szName) const override;
+
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALShaderNull(const ezGALShaderCreationDescription& Description);
+
+  virtual ~ezGALShaderNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALVertexDeclarationNull : public ezGALVertexDeclaration
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALVertexDeclarationNull(const ezGALVertexDeclarationCreationDescription& Description);
+
+  virtual ~ezGALVertexDeclarationNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
@@ -0,0 +1,76 @@
+#include <RendererNullPCH.h>
+
+#include <RendererNull/State/StateNull.h>
+
+ezGALBlendStateNull::ezGALBlendStateNull(const ezGALBlendStateCreationDescription& Description)
+  : ezGALBlendState(Description)
+{
+}
+
+ezGALBlendStateNull::~ezGALBlendStateNull() = default;
+
+ezResult ezGALBlendStateNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALBlendStateNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+
+ezGALDepthStencilStateNull::ezGALDepthStencilStateNull(const ezGALDepthStencilStateCreationDescription& Description)
+  : ezGALDepthStencilState(Description)
+{
+}
+
+ezGALDepthStencilStateNull::~ezGALDepthStencilStateNull() = default;
+
+ezResult ezGALDepthStencilStateNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALDepthStencilStateNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+
+ezGALRasterizerStateNull::ezGALRasterizerStateNull(const ezGALRasterizerStateCreationDescription& Description)
+  : ezGALRasterizerState(Description)
+{
+}
+
+ezGALRasterizerStateNull::~ezGALRasterizerStateNull() = default;
+
+ezResult ezGALRasterizerStateNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALRasterizerStateNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+
+ezGALSamplerStateNull::ezGALSamplerStateNull(const ezGALSamplerStateCreationDescription& Description)
+  : ezGALSamplerState(Description)
+{
+}
+
+ezGALSamplerStateNull::~ezGALSamplerStateNull() = default;
+
+ezResult ezGALSamplerStateNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALSamplerStateNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_State_Implementation_StateNull);
@@ -22,10 +22,7 @@ EZ_END_DYNAMIC_REFLECTED_TYPE;
 
 ezPlugin g_Plugin(false);
 
-CComPtr<IDxcUtils> s_pDxcUtils;
-CComPtr<IDxcCompiler3> s_pDxcCompiler;
-
-static ezResult CompileVulkanShader(const char* szFile, const char* szSource, bool bDebug, const char* szProfile, const char* szEntryPoint, ezDynamicArray<ezUInt8>& out_ByteCode);
+static ezResult CompileVulkanShader(IDxcUtils* pDxcUtils, IDxcCompiler3* pDxcCompiler, const char* szFile, const char* szSource, bool bDebug, const char* szProfile, const char* szEntryPoint, ezDynamicArray<ezUInt8>& out_ByteCode);
 
 static const char* GetProfileName(const char* szPlatform, ezGALShaderStage::Enum Stage)
 {
@@ -54,13 +51,40 @@ static const char* GetProfileName(const char* szPlatform, ezGALShaderStage::Enum
   return "";
 }
 
+ezShaderCompilerDXC::ezShaderCompilerDXC() = default;
+
+ezShaderCompilerDXC::~ezShaderCompilerDXC()
+{
+  if (m_pDxcCompiler != nullptr)
+  {
+    m_pDxcCompiler->Release();
+    m_pDxcCompiler = nullptr;
+  }
+
+  if (m_pDxcUtils != nullptr)
+  {
+    m_pDxcUtils->Release();
+    m_pDxcUtils = nullptr;
+  }
+}
+
 ezResult ezShaderCompilerDXC::Initialize()
 {
-  if (s_pDxcUtils != nullptr)
+  if (m_pDxcCompiler != nullptr)
     return EZ_SUCCESS;
 
-  DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&s_pDxcUtils));
-  DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&s_pDxcCompiler));
+  // DxcCreateInstance itself is thread-safe, only the created objects must not be shared between threads
+  if (m_pDxcUtils == nullptr && FAILED(DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&m_pDxcUtils))))
+  {
+    ezLog::Error("Failed to create the DXC utils instance.");
+    return EZ_FAILURE;
+  }
+
+  if (FAILED(DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&m_pDxcCompiler))))
+  {
+    ezLog::Error("Failed to create the DXC compiler instance.");
+    return EZ_FAILURE;
+  }
 
   return EZ_SUCCESS;
 }
@@ -82,7 +106,7 @@ ezResult ezShaderCompilerDXC::Compile(ezShaderProgramData& inout_Data, ezLogInte
 
     if (uiLength > 0 && ezStringUtils::FindSubString(szShaderSource, "main") != nullptr)
     {
-      if (CompileVulkanShader(inout_Data.m_szSourceFile, szShaderSource, inout_Data.m_Flags.IsSet(ezShaderCompilerFlags::Debug), GetProfileName(inout_Data.m_szPlatform, (ezGALShaderStage::Enum)stage), "main", inout_Data.m_StageBinary[stage].GetByteCode()).Succeeded())
+      if (CompileVulkanShader(m_pDxcUtils, m_pDxcCompiler, inout_Data.m_szSourceFile, szShaderSource, inout_Data.m_Flags.IsSet(ezShaderCompilerFlags::Debug), GetProfileName(inout_Data.m_szPlatform, (ezGALShaderStage::Enum)stage), "main", inout_Data.m_StageBinary[stage].GetByteCode()).Succeeded())
       {
         EZ_SUCCEED_OR_RETURN(ReflectShaderStage(inout_Data, (ezGALShaderStage::Enum)stage));
       }
@@ -96,7 +120,7 @@ ezResult ezShaderCompilerDXC::Compile(ezShaderProgramData& inout_Data, ezLogInte
   return EZ_SUCCESS;
 }
 
-ezResult CompileVulkanShader(const char* szFile, const char* szSource, bool bDebug, const char* szProfile, const char* szEntryPoint, ezDynamicArray<ezUInt8>& out_ByteCode)
+ezResult CompileVulkanShader(IDxcUtils* pDxcUtils, IDxcCompiler3* pDxcCompiler, const char* szFile, const char* szSource, bool bDebug, const char* szProfile, const char* szEntryPoint, ezDynamicArray<ezUInt8>& out_ByteCode)
 {
   out_ByteCode.Clear();
 
@@ -129,7 +153,7 @@ ezResult CompileVulkanShader(const char* szFile, const char* szSource, bool bDeb
   }
 
   CComPtr<IDxcBlobEncoding> pSource = nullptr;
-  s_pDxcUtils->CreateBlob(szCompileSource, (UINT32)strlen(szCompileSource), DXC_CP_UTF8, &pSource);
+  pDxcUtils->CreateBlob(szCompileSource, (UINT32)strlen(szCompileSource), DXC_CP_UTF8, &pSource);
 
   DxcBuffer Source;
   Source.Ptr = pSource->GetBufferPointer();
@@ -144,7 +168,7 @@ ezResult CompileVulkanShader(const char* szFile, const char* szSource, bool bDeb
   }
 
   CComPtr<IDxcResult> pResults;
-  s_pDxcCompiler->Compile(&Source, pszArgs.GetData(), pszArgs.GetCount(), nullptr, IID_PPV_ARGS(&pResults));
+  pDxcCompiler->Compile(&Source, pszArgs.GetData(), pszArgs.GetCount(), nullptr, IID_PPV_ARGS(&pResults));
 
   CComPtr<IDxcBlobUtf8> pErrors = nullptr;
   pResults->GetOutput(DXC_OUT_ERRORS, IID_PPV_ARGS(&pErrors), nullptr);
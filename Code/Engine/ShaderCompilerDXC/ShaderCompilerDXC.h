@@ -4,12 +4,17 @@
 #include <ShaderCompilerDXC/ShaderCompilerDXCDLL.h>
 
 struct SpvReflectDescriptorBinding;
+struct IDxcUtils;
+struct IDxcCompiler3;
 
 class EZ_SHADERCOMPILERDXC_DLL ezShaderCompilerDXC : public ezShaderProgramCompiler
 {
   EZ_ADD_DYNAMIC_REFLECTION(ezShaderCompilerDXC, ezShaderProgramCompiler);
 
 public:
+  ezShaderCompilerDXC();
+  ~ezShaderCompilerDXC();
+
   virtual void GetSupportedPlatforms(ezHybridArray<ezString, 4>& Platforms) override { Platforms.PushBack("VULKAN"); }
 
   virtual ezResult Compile(ezShaderProgramData& inout_Data, ezLogInterface* pLog) override;
@@ -22,4 +27,9 @@ private:
   ezResult FillUAVResourceBinding(ezShaderStageBinary& shaderBinary, ezShaderResourceBinding& binding, const SpvReflectDescriptorBinding& info);
 
   ezResult Initialize();
+
+  // Each compiler instance owns its DXC objects, an IDxcCompiler3 must not be used by multiple threads at the same time.
+  // The shader compiler creates one instance per permutation, so permutations can be compiled in parallel.
+  IDxcUtils* m_pDxcUtils = nullptr;
+  IDxcCompiler3* m_pDxcCompiler = nullptr;
 };
@@ -3,6 +3,7 @@
 #include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
 #include <Foundation/Math/Color16f.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_ColorGradient.h>
 #include <ParticlePlugin/Effect/ParticleEffectInstance.h>
 
@@ -109,7 +110,7 @@ void ezParticleBehavior_ColorGradient::CreateRequiredStreams()
   }
   else if (m_GradientMode == ezParticleColorGradientMode::Speed)
   {
-    CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+    CreateStream("Velocity", ezProcessingStream::DataType::Float4, &m_pStreamVelocity, false);
   }
 }
 
@@ -211,7 +212,7 @@ void ezParticleBehavior_ColorGradient::Process(ezUInt64 uiNumElements)
   }
   else if (m_GradientMode == ezParticleColorGradientMode::Speed)
   {
-    ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+    ezProcessingStreamIterator<ezSimdVec4f> itVelocity(m_pStreamVelocity, uiNumElements, 0);
 
     // skip the first n particles
     itVelocity.Advance(m_uiFirstToUpdate);
@@ -220,7 +221,7 @@ void ezParticleBehavior_ColorGradient::Process(ezUInt64 uiNumElements)
     {
       // if (itLifeTime.Current().y > 0)
       {
-        const float fSpeed = itVelocity.Current().GetLength();
+        const float fSpeed = itVelocity.Current().GetLength<3>();
         const float posx = fSpeed / m_fMaxSpeed; // no need to clamp the range, the color lookup will already do that
 
         ezColor rgba;
@@ -77,11 +77,8 @@ void ezParticleBehavior_FadeOut::Process(ezUInt64 uiNumElements)
 
   // skip the first n particles
   {
-    for (ezUInt32 i = 0; i < m_uiFirstToUpdate; ++i)
-    {
-      itLifeTime.Advance();
-      itColor.Advance();
-    }
+    itLifeTime.Advance(m_uiFirstToUpdate);
+    itColor.Advance(m_uiFirstToUpdate);
 
     ++m_uiFirstToUpdate;
     if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
@@ -95,11 +92,8 @@ void ezParticleBehavior_FadeOut::Process(ezUInt64 uiNumElements)
       const float fLifeTimeFraction = itLifeTime.Current().x * itLifeTime.Current().y;
       itColor.Current().a = m_fStartAlpha * ezMath::Pow(fLifeTimeFraction, m_fExponent);
 
-      for (ezUInt32 i = 0; i < m_uiCurrentUpdateInterval; ++i)
-      {
-        itLifeTime.Advance();
-        itColor.Advance();
-      }
+      itLifeTime.Advance(m_uiCurrentUpdateInterval);
+      itColor.Advance(m_uiCurrentUpdateInterval);
     }
   }
   else
@@ -110,11 +104,8 @@ void ezParticleBehavior_FadeOut::Process(ezUInt64 uiNumElements)
       const float fLifeTimeFraction = itLifeTime.Current().x * itLifeTime.Current().y;
       itColor.Current().a = ezMath::Min(1.0f, m_fStartAlpha * ezMath::Pow(fLifeTimeFraction, m_fExponent));
 
-      for (ezUInt32 i = 0; i < m_uiCurrentUpdateInterval; ++i)
-      {
-        itLifeTime.Advance();
-        itColor.Advance();
-      }
+      itLifeTime.Advance(m_uiCurrentUpdateInterval);
+      itColor.Advance(m_uiCurrentUpdateInterval);
     }
   }
 
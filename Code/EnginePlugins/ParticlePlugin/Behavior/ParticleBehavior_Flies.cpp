@@ -87,7 +87,7 @@ void ezParticleBehaviorFactory_Flies::Load(ezStreamReader& stream)
 void ezParticleBehavior_Flies::CreateRequiredStreams()
 {
   CreateStream("Position", ezProcessingStream::DataType::Float4, &m_pStreamPosition, false);
-  CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+  CreateStream("Velocity", ezProcessingStream::DataType::Float4, &m_pStreamVelocity, false);
 
   m_TimeToChangeDir.SetZero();
 }
@@ -108,7 +108,7 @@ void ezParticleBehavior_Flies::Process(ezUInt64 uiNumElements)
   const float fMaxDistanceToEmitterSquared = ezMath::Square(m_fMaxEmitterDistance);
 
   ezProcessingStreamIterator<ezVec4> itPosition(m_pStreamPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  ezProcessingStreamIterator<ezVec4> itVelocity(m_pStreamVelocity, uiNumElements, 0);
 
   ezQuat qRot;
 
@@ -118,7 +118,7 @@ void ezParticleBehavior_Flies::Process(ezUInt64 uiNumElements)
 
     const ezVec3 vPartToEm = vEmitterPos - itPosition.Current().GetAsVec3();
     const float fDist = vPartToEm.GetLengthSquared();
-    const ezVec3 vVelocity = itVelocity.Current();
+    const ezVec3 vVelocity = itVelocity.Current().GetAsVec3();
     ezVec3 vDir = vVelocity;
     vDir.NormalizeIfNotZero().IgnoreResult();
 
@@ -130,11 +130,11 @@ void ezParticleBehavior_Flies::Process(ezUInt64 uiNumElements)
 
       qRot.SetFromAxisAndAngle(vPivot, m_MaxSteeringAngle);
 
-      itVelocity.Current() = qRot * vVelocity;
+      itVelocity.Current() = (qRot * vVelocity).GetAsVec4(0);
     }
     else
     {
-      itVelocity.Current() = ezVec3::CreateRandomDeviation(GetRNG(), m_MaxSteeringAngle, vDir) * m_fSpeed;
+      itVelocity.Current() = (ezVec3::CreateRandomDeviation(GetRNG(), m_MaxSteeringAngle, vDir) * m_fSpeed).GetAsVec4(0);
     }
 
     itPosition.Advance();
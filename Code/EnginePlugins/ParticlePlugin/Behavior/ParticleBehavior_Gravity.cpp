@@ -3,8 +3,8 @@
 #include <Core/Interfaces/PhysicsWorldModule.h>
 #include <Core/World/World.h>
 #include <Core/World/WorldModule.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
 #include <Foundation/Time/Clock.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_Gravity.h>
 #include <ParticlePlugin/Finalizer/ParticleFinalizer_ApplyVelocity.h>
@@ -70,7 +70,7 @@ void ezParticleBehaviorFactory_Gravity::QueryFinalizerDependencies(ezSet<const e
 
 void ezParticleBehavior_Gravity::CreateRequiredStreams()
 {
-  CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+  CreateStream("Velocity", ezProcessingStream::DataType::Float4, &m_pStreamVelocity, false);
 }
 
 void ezParticleBehavior_Gravity::Process(ezUInt64 uiNumElements)
@@ -80,15 +80,18 @@ void ezParticleBehavior_Gravity::Process(ezUInt64 uiNumElements)
   const ezVec3 vGravity = m_pPhysicsModule != nullptr ? m_pPhysicsModule->GetGravity() : ezVec3(0.0f, 0.0f, -10.0f);
 
   const float tDiff = (float)m_TimeDiff.GetSeconds();
-  const ezVec3 addGravity = vGravity * m_fGravityFactor * tDiff;
+  const ezVec3 addGravity0 = vGravity * m_fGravityFactor * tDiff;
 
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  ezSimdVec4f addGravity;
+  addGravity.Load<3>(&addGravity0.x);
 
-  while (!itVelocity.HasReachedEnd())
-  {
-    itVelocity.Current() += addGravity;
+  ezSimdVec4f* pVelocity = GetSimdData(m_pStreamVelocity);
+
+  const ezUInt64 uiNumSimdElements = ezProcessingStream::GetNumSimdBatches(uiNumElements) * ezProcessingStream::SimdBatchSize;
 
-    itVelocity.Advance();
+  for (ezUInt64 i = 0; i < uiNumSimdElements; ++i)
+  {
+    pVelocity[i] += addGravity;
   }
 }
 
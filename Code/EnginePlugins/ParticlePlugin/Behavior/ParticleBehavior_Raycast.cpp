@@ -124,7 +124,7 @@ void ezParticleBehavior_Raycast::CreateRequiredStreams()
 {
   CreateStream("Position", ezProcessingStream::DataType::Float4, &m_pStreamPosition, false);
   CreateStream("LastPosition", ezProcessingStream::DataType::Float3, &m_pStreamLastPosition, false);
-  CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+  CreateStream("Velocity", ezProcessingStream::DataType::Float4, &m_pStreamVelocity, false);
 }
 
 void ezParticleBehavior_Raycast::Process(ezUInt64 uiNumElements)
@@ -135,7 +135,7 @@ void ezParticleBehavior_Raycast::Process(ezUInt64 uiNumElements)
 
   ezProcessingStreamIterator<ezVec4> itPosition(m_pStreamPosition, uiNumElements, 0);
   ezProcessingStreamIterator<const ezVec3> itLastPosition(m_pStreamLastPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  ezProcessingStreamIterator<ezVec4> itVelocity(m_pStreamVelocity, uiNumElements, 0);
 
   ezPhysicsCastResult hitResult;
 
@@ -162,7 +162,7 @@ void ezParticleBehavior_Raycast::Process(ezUInt64 uiNumElements)
             const ezVec3 vNewDir = vChange.GetReflectedVector(hitResult.m_vNormal) * m_fBounceFactor;
 
             itPosition.Current() = ezVec3(hitResult.m_vPosition + hitResult.m_vNormal * 0.05f + vNewDir).GetAsVec4(0);
-            itVelocity.Current() = vNewDir / tDiff;
+            itVelocity.Current() = (vNewDir / tDiff).GetAsVec4(0);
           }
           else if (m_Reaction == ezParticleRaycastHitReaction::Die)
           {
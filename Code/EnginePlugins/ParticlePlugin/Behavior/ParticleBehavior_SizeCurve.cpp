@@ -130,11 +130,8 @@ void ezParticleBehavior_SizeCurve::Process(ezUInt64 uiNumElements)
 
   // skip the first n particles
   {
-    for (ezUInt32 i = 0; i < m_uiFirstToUpdate; ++i)
-    {
-      itLifeTime.Advance();
-      itSize.Advance();
-    }
+    itLifeTime.Advance(m_uiFirstToUpdate);
+    itSize.Advance(m_uiFirstToUpdate);
 
     ++m_uiFirstToUpdate;
     if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
@@ -157,11 +154,8 @@ void ezParticleBehavior_SizeCurve::Process(ezUInt64 uiNumElements)
     // skip the next n items
     // this is to reduce the number of particles that need to be fully evaluated,
     // since sampling the curve is expensive
-    for (ezUInt32 i = 0; i < m_uiCurrentUpdateInterval; ++i)
-    {
-      itLifeTime.Advance();
-      itSize.Advance();
-    }
+    itLifeTime.Advance(m_uiCurrentUpdateInterval);
+    itSize.Advance(m_uiCurrentUpdateInterval);
   }
 }
 
@@ -4,8 +4,8 @@
 #include <Core/Interfaces/WindWorldModule.h>
 #include <Core/World/World.h>
 #include <Core/World/WorldModule.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
 #include <Foundation/Time/Clock.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_Velocity.h>
 #include <ParticlePlugin/Finalizer/ParticleFinalizer_ApplyVelocity.h>
@@ -102,7 +102,7 @@ void ezParticleBehaviorFactory_Velocity::QueryFinalizerDependencies(ezSet<const
 void ezParticleBehavior_Velocity::CreateRequiredStreams()
 {
   CreateStream("Position", ezProcessingStream::DataType::Float4, &m_pStreamPosition, false);
-  CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+  CreateStream("Velocity", ezProcessingStream::DataType::Float4, &m_pStreamVelocity, false);
 }
 
 void ezParticleBehavior_Velocity::Process(ezUInt64 uiNumElements)
@@ -125,18 +125,18 @@ void ezParticleBehavior_Velocity::Process(ezUInt64 uiNumElements)
   vAddPos.Load<3>(&vAddPos0.x);
 
   const float fFriction = ezMath::Clamp(m_fFriction, 0.0f, 100.0f);
-  const float fFrictionFactor = ezMath::Pow(0.5f, tDiff * fFriction);
+  const ezSimdFloat fFrictionFactor = ezMath::Pow(0.5f, tDiff * fFriction);
 
-  ezProcessingStreamIterator<ezSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  ezSimdVec4f* pPosition = GetSimdData(m_pStreamPosition);
+  ezSimdVec4f* pVelocity = GetSimdData(m_pStreamVelocity);
 
-  while (!itPosition.HasReachedEnd())
-  {
-    itPosition.Current() += vAddPos;
-    itVelocity.Current() *= fFrictionFactor;
+  // the streams are padded to full batches, so the last batch can be processed without a remainder loop
+  const ezUInt64 uiNumSimdElements = ezProcessingStream::GetNumSimdBatches(uiNumElements) * ezProcessingStream::SimdBatchSize;
 
-    itPosition.Advance();
-    itVelocity.Advance();
+  for (ezUInt64 i = 0; i < uiNumSimdElements; ++i)
+  {
+    pPosition[i] += vAddPos;
+    pVelocity[i] *= fFrictionFactor;
   }
 }
 
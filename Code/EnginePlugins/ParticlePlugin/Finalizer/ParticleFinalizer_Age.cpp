@@ -4,6 +4,7 @@
 #include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
 #include <Foundation/Math/Float16.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
 #include <ParticlePlugin/Effect/ParticleEffectInstance.h>
 #include <ParticlePlugin/Events/ParticleEvent.h>
 #include <ParticlePlugin/Finalizer/ParticleFinalizer_Age.h>
@@ -65,7 +66,7 @@ void ezParticleFinalizer_Age::CreateRequiredStreams()
   if (!m_sOnDeathEvent.IsEmpty())
   {
     CreateStream("Position", ezProcessingStream::DataType::Float4, &m_pStreamPosition, false);
-    CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+    CreateStream("Velocity", ezProcessingStream::DataType::Float4, &m_pStreamVelocity, false);
   }
 }
 
@@ -109,18 +110,39 @@ void ezParticleFinalizer_Age::Process(ezUInt64 uiNumElements)
 
   ezFloat16Vec2* pLifeTime = m_pStreamLifeTime->GetWritableData<ezFloat16Vec2>();
 
-  const float tDiff = (float)m_TimeDiff.GetSeconds();
+  const ezSimdVec4f vTimeDiff((float)m_TimeDiff.GetSeconds());
+  const ezSimdVec4f vZero = ezSimdVec4f::ZeroVector();
 
-  for (ezUInt32 i = 0; i < uiNumElements; ++i)
+  const ezUInt64 uiNumSimdElements = ezProcessingStream::GetNumSimdBatches(uiNumElements) * ezProcessingStream::SimdBatchSize;
+
+  float fRemaining[ezProcessingStream::SimdBatchSize];
+
+  for (ezUInt64 i = 0; i < uiNumSimdElements; i += ezProcessingStream::SimdBatchSize)
   {
-    pLifeTime[i].x = pLifeTime[i].x - tDiff;
+    ezSimdVec4f vRemaining(pLifeTime[i + 0].x, pLifeTime[i + 1].x, pLifeTime[i + 2].x, pLifeTime[i + 3].x);
+    vRemaining -= vTimeDiff;
+
+    const bool bAnyDied = (vRemaining <= vZero).AnySet();
 
-    if (pLifeTime[i].x <= 0)
+    vRemaining.CompMax(vZero).Store<4>(fRemaining);
+
+    for (ezUInt32 j = 0; j < ezProcessingStream::SimdBatchSize; ++j)
     {
-      pLifeTime[i].x = 0;
+      pLifeTime[i + j].x = fRemaining[j];
+    }
 
-      /// \todo Get current element index from iterator ?
-      m_pStreamGroup->RemoveElement(i);
+    if (bAnyDied)
+    {
+      // the last batch may reach into the stream padding, those elements must not be removed
+      const ezUInt64 uiBatchEnd = ezMath::Min<ezUInt64>(i + ezProcessingStream::SimdBatchSize, uiNumElements);
+
+      for (ezUInt64 j = i; j < uiBatchEnd; ++j)
+      {
+        if (fRemaining[j - i] <= 0.0f)
+        {
+          m_pStreamGroup->RemoveElement(j);
+        }
+      }
     }
   }
 }
@@ -128,12 +150,12 @@ void ezParticleFinalizer_Age::Process(ezUInt64 uiNumElements)
 void ezParticleFinalizer_Age::OnParticleDeath(const ezStreamGroupElementRemovedEvent& e)
 {
   const ezVec4* pPosition = m_pStreamPosition->GetData<ezVec4>();
-  const ezVec3* pVelocity = m_pStreamVelocity->GetData<ezVec3>();
+  const ezVec4* pVelocity = m_pStreamVelocity->GetData<ezVec4>();
 
   ezParticleEvent pe;
   pe.m_EventType = m_sOnDeathEvent;
   pe.m_vPosition = pPosition[e.m_uiElementIndex].GetAsVec3();
-  pe.m_vDirection = pVelocity[e.m_uiElementIndex];
+  pe.m_vDirection = pVelocity[e.m_uiElementIndex].GetAsVec3();
   pe.m_vNormal.SetZero();
 
   GetOwnerEffect()->AddParticleEvent(pe);
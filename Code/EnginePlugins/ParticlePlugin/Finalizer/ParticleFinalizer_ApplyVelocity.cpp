@@ -1,9 +1,9 @@
 #include <ParticlePluginPCH.h>
 
 #include <Core/World/World.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
 #include <Foundation/Math/Declarations.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
 #include <ParticlePlugin/Finalizer/ParticleFinalizer_ApplyVelocity.h>
 
 // clang-format off
@@ -37,7 +37,7 @@ ezParticleFinalizer_ApplyVelocity::~ezParticleFinalizer_ApplyVelocity() {}
 void ezParticleFinalizer_ApplyVelocity::CreateRequiredStreams()
 {
   CreateStream("Position", ezProcessingStream::DataType::Float4, &m_pStreamPosition, false);
-  CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
+  CreateStream("Velocity", ezProcessingStream::DataType::Float4, &m_pStreamVelocity, false);
 }
 
 void ezParticleFinalizer_ApplyVelocity::Process(ezUInt64 uiNumElements)
@@ -46,16 +46,16 @@ void ezParticleFinalizer_ApplyVelocity::Process(ezUInt64 uiNumElements)
 
   const float tDiff = (float)m_TimeDiff.GetSeconds();
 
-  ezProcessingStreamIterator<ezVec4> itPosition(m_pStreamPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  // the w component of the position is not part of the position, so it must stay untouched
+  const ezSimdVec4f vTimeDiff(tDiff, tDiff, tDiff, 0.0f);
 
-  while (!itPosition.HasReachedEnd())
-  {
-    ezVec3& pos = reinterpret_cast<ezVec3&>(itPosition.Current());
+  ezSimdVec4f* pPosition = GetSimdData(m_pStreamPosition);
+  const ezSimdVec4f* pVelocity = GetSimdData(m_pStreamVelocity);
 
-    pos += itVelocity.Current() * tDiff;
+  const ezUInt64 uiNumSimdElements = ezProcessingStream::GetNumSimdBatches(uiNumElements) * ezProcessingStream::SimdBatchSize;
 
-    itPosition.Advance();
-    itVelocity.Advance();
+  for (ezUInt64 i = 0; i < uiNumSimdElements; ++i)
+  {
+    pPosition[i] = ezSimdVec4f::MulAdd(pVelocity[i], vTimeDiff, pPosition[i]);
   }
 }
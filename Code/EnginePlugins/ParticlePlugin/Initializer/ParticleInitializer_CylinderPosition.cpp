@@ -149,7 +149,7 @@ void ezParticleInitializer_CylinderPosition::CreateRequiredStreams()
 
   if (m_bSetVelocity)
   {
-    CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, true);
+    CreateStream("Velocity", ezProcessingStream::DataType::Float4, &m_pStreamVelocity, true);
   }
 }
 
@@ -160,7 +160,7 @@ void ezParticleInitializer_CylinderPosition::InitializeElements(ezUInt64 uiStart
   const ezVec3 startVel = GetOwnerSystem()->GetParticleStartVelocity();
 
   ezVec4* pPosition = m_pStreamPosition->GetWritableData<ezVec4>();
-  ezVec3* pVelocity = m_bSetVelocity ? m_pStreamVelocity->GetWritableData<ezVec3>() : nullptr;
+  ezVec4* pVelocity = m_bSetVelocity ? m_pStreamVelocity->GetWritableData<ezVec4>() : nullptr;
 
   ezRandom& rng = GetRNG();
 
@@ -205,7 +205,7 @@ void ezParticleInitializer_CylinderPosition::InitializeElements(ezUInt64 uiStart
     {
       const float fSpeed = (float)rng.DoubleVariance(m_Speed.m_Value, m_Speed.m_fVariance);
 
-      pVelocity[i] = startVel + trans.m_qRotation * normalPos * fSpeed;
+      pVelocity[i] = (startVel + trans.m_qRotation * normalPos * fSpeed).GetAsVec4(0);
     }
 
     pPosition[i] = (trans * pos).GetAsVec4(0);
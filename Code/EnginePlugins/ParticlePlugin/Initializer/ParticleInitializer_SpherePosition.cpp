@@ -148,7 +148,7 @@ void ezParticleInitializer_SpherePosition::CreateRequiredStreams()
 
   if (m_bSetVelocity)
   {
-    CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, true);
+    CreateStream("Velocity", ezProcessingStream::DataType::Float4, &m_pStreamVelocity, true);
   }
 }
 
@@ -159,7 +159,7 @@ void ezParticleInitializer_SpherePosition::InitializeElements(ezUInt64 uiStartIn
   const ezVec3 startVel = GetOwnerSystem()->GetParticleStartVelocity();
 
   ezVec4* pPosition = m_pStreamPosition->GetWritableData<ezVec4>();
-  ezVec3* pVelocity = m_bSetVelocity ? m_pStreamVelocity->GetWritableData<ezVec3>() : nullptr;
+  ezVec4* pVelocity = m_bSetVelocity ? m_pStreamVelocity->GetWritableData<ezVec4>() : nullptr;
 
   ezRandom& rng = GetRNG();
 
@@ -184,7 +184,7 @@ void ezParticleInitializer_SpherePosition::InitializeElements(ezUInt64 uiStartIn
     {
       const float fSpeed = (float)rng.DoubleVariance(m_Speed.m_Value, m_Speed.m_fVariance);
 
-      pVelocity[i] = startVel + trans.m_qRotation * normalPos * fSpeed;
+      pVelocity[i] = (startVel + trans.m_qRotation * normalPos * fSpeed).GetAsVec4(0);
     }
 
     pPosition[i] = (trans * pos).GetAsVec4(0);
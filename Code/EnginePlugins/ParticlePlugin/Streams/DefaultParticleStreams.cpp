@@ -113,7 +113,7 @@ EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezParticleStream_Velocity, 1, ezRTTIDefaultAlloc
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 
 ezParticleStreamFactory_Velocity::ezParticleStreamFactory_Velocity()
-  : ezParticleStreamFactory("Velocity", ezProcessingStream::DataType::Float3, ezGetStaticRTTI<ezParticleStream_Velocity>())
+  : ezParticleStreamFactory("Velocity", ezProcessingStream::DataType::Float4, ezGetStaticRTTI<ezParticleStream_Velocity>())
 {
 }
 
@@ -124,9 +124,9 @@ void ezParticleStream_Velocity::Initialize(ezParticleSystemInstance* pOwner)
 
 void ezParticleStream_Velocity::InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
 {
-  ezProcessingStreamIterator<ezVec3> itData(m_pStream, uiNumElements, uiStartIndex);
+  ezProcessingStreamIterator<ezVec4> itData(m_pStream, uiNumElements, uiStartIndex);
 
-  const ezVec3 startVel = m_pOwner->GetParticleStartVelocity();
+  const ezVec4 startVel = m_pOwner->GetParticleStartVelocity().GetAsVec4(0);
 
   while (!itData.HasReachedEnd())
   {
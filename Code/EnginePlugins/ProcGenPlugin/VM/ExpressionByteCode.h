@@ -56,6 +56,19 @@ public:
 
       Call,
 
+      // Ternary, produced by fusing common instruction sequences in the compiler.
+      // Appended after Call so previously saved byte code keeps its op code values.
+      FirstTernary,
+
+      MulAdd_RRR, ///< r = a * b + c
+      MulAdd_CRR,
+      MulAdd_RRC,
+      MulAdd_CRC,
+
+      Clamp_CCR, ///< r = min(hi, max(lo, x))
+
+      LastTernary,
+
       Count
     };
   };
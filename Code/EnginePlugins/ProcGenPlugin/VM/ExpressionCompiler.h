@@ -1,8 +1,7 @@
 #pragma once
 
 #include <ProcGenPlugin/VM/ExpressionAST.h>
-
-class ezExpressionByteCode;
+#include <ProcGenPlugin/VM/ExpressionByteCode.h>
 
 class EZ_PROCGENPLUGIN_DLL ezExpressionCompiler
 {
@@ -14,14 +13,28 @@ public:
 
 private:
   ezResult BuildNodeInstructions(const ezExpressionAST& ast);
+  ezResult FuseInstructions();
   ezResult UpdateRegisterLifetime(const ezExpressionAST& ast);
   ezResult AssignRegisters();
   ezResult GenerateByteCode(const ezExpressionAST& ast, ezExpressionByteCode& out_byteCode);
 
+  void GetRegisterOperands(const ezExpressionAST::Node* pNode, ezHybridArray<const ezExpressionAST::Node*, 8>& out_Operands) const;
+
   ezHybridArray<const ezExpressionAST::Node*, 64> m_NodeStack;
   ezHybridArray<const ezExpressionAST::Node*, 64> m_NodeInstructions;
   ezHashTable<const ezExpressionAST::Node*, ezUInt32> m_NodeToRegisterIndex;
 
+  /// \brief A superinstruction that replaces a node and its single-use operand node, e.g. Add(Multiply(a, b), c) => MulAdd(a, b, c).
+  struct FusedInstruction
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezExpressionByteCode::OpCode::Enum m_OpCode;
+    const ezExpressionAST::Node* m_Operands[3];
+  };
+
+  ezHashTable<const ezExpressionAST::Node*, FusedInstruction> m_FusedInstructions;
+
   ezHashTable<ezHashedString, ezUInt32> m_InputToIndex;
   ezHashTable<ezHashedString, ezUInt32> m_OutputToIndex;
   ezHashTable<ezHashedString, ezUInt32> m_FunctionToIndex;
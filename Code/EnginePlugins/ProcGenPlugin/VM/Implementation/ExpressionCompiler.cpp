@@ -45,6 +45,34 @@ namespace
         return ezExpressionByteCode::OpCode::FirstUnary;
     }
   }
+
+  static bool IsConstantOperand(ezExpressionByteCode::OpCode::Enum opCode, ezUInt32 uiOperandIndex)
+  {
+    switch (opCode)
+    {
+      case ezExpressionByteCode::OpCode::MulAdd_CRR:
+        return uiOperandIndex == 0;
+      case ezExpressionByteCode::OpCode::MulAdd_RRC:
+        return uiOperandIndex == 2;
+      case ezExpressionByteCode::OpCode::MulAdd_CRC:
+        return uiOperandIndex != 1;
+      case ezExpressionByteCode::OpCode::Clamp_CCR:
+        return uiOperandIndex != 2;
+      default:
+        return false;
+    }
+  }
+
+  static ezUInt32 GetConstantValue(const ezExpressionAST::Node* pNode)
+  {
+    auto pConstant = static_cast<const ezExpressionAST::Constant*>(pNode);
+    return *reinterpret_cast<const ezUInt32*>(&pConstant->m_Value.Get<float>());
+  }
+
+  static bool IsConstant(const ezExpressionAST::Node* pNode)
+  {
+    return ezExpressionAST::NodeType::IsConstant(pNode->m_Type);
+  }
 } // namespace
 
 ezExpressionCompiler::ezExpressionCompiler() = default;
@@ -55,6 +83,9 @@ ezResult ezExpressionCompiler::Compile(ezExpressionAST& ast, ezExpressionByteCod
   if (BuildNodeInstructions(ast).Failed())
     return EZ_FAILURE;
 
+  if (FuseInstructions().Failed())
+    return EZ_FAILURE;
+
   if (UpdateRegisterLifetime(ast).Failed())
     return EZ_FAILURE;
 
@@ -127,10 +158,8 @@ ezResult ezExpressionCompiler::BuildNodeInstructions(const ezExpressionAST& ast)
   EZ_ASSERT_DEV(m_NodeInstructions.IsEmpty(), "Implementation error");
 
   m_NodeToRegisterIndex.Clear();
-  m_LiveIntervals.Clear();
-  ezUInt32 uiNextRegisterIndex = 0;
 
-  // De-duplicate nodes, build final instruction list and assign virtual register indices. Also determine their lifetime start.
+  // De-duplicate nodes and build final instruction list. Virtual register indices are assigned after instruction fusion.
   while (!m_NodeStack.IsEmpty())
   {
     auto pCurrentNode = m_NodeStack.PeekBack();
@@ -140,27 +169,166 @@ ezResult ezExpressionCompiler::BuildNodeInstructions(const ezExpressionAST& ast)
     {
       m_NodeInstructions.PushBack(pCurrentNode);
 
-      m_NodeToRegisterIndex.Insert(pCurrentNode, uiNextRegisterIndex);
-      ++uiNextRegisterIndex;
+      m_NodeToRegisterIndex.Insert(pCurrentNode, ezInvalidIndex);
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezExpressionCompiler::FuseInstructions()
+{
+  m_FusedInstructions.Clear();
+
+  // Count how often the result of each instruction is read from a register. Only results that are read exactly once can be folded
+  // into the reading instruction.
+  ezHashTable<const ezExpressionAST::Node*, ezUInt32> useCounts;
+  ezHybridArray<const ezExpressionAST::Node*, 8> operands;
 
-      ezUInt32 uiCurrentInstructionIndex = m_NodeInstructions.GetCount() - 1;
-      m_LiveIntervals.PushBack({uiCurrentInstructionIndex, uiCurrentInstructionIndex, pCurrentNode});
-      EZ_ASSERT_DEV(m_LiveIntervals.GetCount() == uiNextRegisterIndex, "Implementation error");
+  for (auto pCurrentNode : m_NodeInstructions)
+  {
+    GetRegisterOperands(pCurrentNode, operands);
+    for (auto pOperand : operands)
+    {
+      useCounts[pOperand]++;
     }
   }
 
+  auto IsSingleUse = [&](const ezExpressionAST::Node* pNode, ezExpressionAST::NodeType::Enum nodeType) {
+    ezUInt32 uiUseCount = 0;
+    return pNode->m_Type == nodeType && useCounts.TryGetValue(pNode, uiUseCount) && uiUseCount == 1;
+  };
+
+  bool bAnyFused = false;
+
+  for (auto pCurrentNode : m_NodeInstructions)
+  {
+    ezExpressionAST::NodeType::Enum nodeType = pCurrentNode->m_Type;
+    if (nodeType != ezExpressionAST::NodeType::Add && nodeType != ezExpressionAST::NodeType::Min)
+      continue;
+
+    auto pBinary = static_cast<const ezExpressionAST::BinaryOperator*>(pCurrentNode);
+    const ezExpressionAST::Node* pLeft = pBinary->m_pLeftOperand;
+    const ezExpressionAST::Node* pRight = pBinary->m_pRightOperand;
+
+    if (nodeType == ezExpressionAST::NodeType::Add)
+    {
+      // Add(Multiply(a, b), c) => MulAdd(a, b, c), both Add and Multiply are commutative
+      if (!IsSingleUse(pLeft, ezExpressionAST::NodeType::Multiply))
+      {
+        ezMath::Swap(pLeft, pRight);
+      }
+
+      if (!IsSingleUse(pLeft, ezExpressionAST::NodeType::Multiply))
+        continue;
+
+      auto pMultiply = static_cast<const ezExpressionAST::BinaryOperator*>(pLeft);
+      const ezExpressionAST::Node* pA = pMultiply->m_pLeftOperand;
+      const ezExpressionAST::Node* pB = pMultiply->m_pRightOperand;
+      if (IsConstant(pB))
+      {
+        ezMath::Swap(pA, pB);
+      }
+
+      if (IsConstant(pB))
+        continue;
+
+      static const ezExpressionByteCode::OpCode::Enum s_MulAddOpCodes[] = {ezExpressionByteCode::OpCode::MulAdd_RRR,
+        ezExpressionByteCode::OpCode::MulAdd_CRR, ezExpressionByteCode::OpCode::MulAdd_RRC, ezExpressionByteCode::OpCode::MulAdd_CRC};
+
+      ezUInt32 uiOpCodeIndex = (IsConstant(pA) ? 1 : 0) | (IsConstant(pRight) ? 2 : 0);
+      FusedInstruction fused = {s_MulAddOpCodes[uiOpCodeIndex], {pA, pB, pRight}};
+      m_FusedInstructions.Insert(pCurrentNode, fused);
+      bAnyFused = true;
+    }
+    else
+    {
+      // Min(hi, Max(lo, x)) => Clamp(lo, hi, x) for constant lo and hi.
+      // Min and Max return their second operand if either one is NaN, so only the operand order that the VM evaluates is fused.
+      if (!IsConstant(pLeft) || !IsSingleUse(pRight, ezExpressionAST::NodeType::Max))
+        continue;
+
+      auto pMax = static_cast<const ezExpressionAST::BinaryOperator*>(pRight);
+      const ezExpressionAST::Node* pLo = pMax->m_pLeftOperand;
+      const ezExpressionAST::Node* pX = pMax->m_pRightOperand;
+
+      if (!IsConstant(pLo) || IsConstant(pX))
+        continue;
+
+      FusedInstruction fused = {ezExpressionByteCode::OpCode::Clamp_CCR, {pLo, pLeft, pX}};
+      m_FusedInstructions.Insert(pCurrentNode, fused);
+      bAnyFused = true;
+    }
+  }
+
+  if (!bAnyFused)
+    return EZ_SUCCESS;
+
+  // Remove all instructions whose result is not read anymore. These are the folded Multiply/Max nodes and constants that are now
+  // embedded in the fused instructions. Instructions are in post order, so walking backwards visits all readers of a result first.
+  useCounts.Clear();
+  for (auto pCurrentNode : m_NodeInstructions)
+  {
+    GetRegisterOperands(pCurrentNode, operands);
+    for (auto pOperand : operands)
+    {
+      useCounts[pOperand]++;
+    }
+  }
+
+  for (ezUInt32 uiInstructionIndex = m_NodeInstructions.GetCount(); uiInstructionIndex-- > 0;)
+  {
+    auto pCurrentNode = m_NodeInstructions[uiInstructionIndex];
+    if (ezExpressionAST::NodeType::IsOutput(pCurrentNode->m_Type) || useCounts[pCurrentNode] > 0)
+      continue;
+
+    GetRegisterOperands(pCurrentNode, operands);
+    for (auto pOperand : operands)
+    {
+      useCounts[pOperand]--;
+    }
+
+    m_NodeToRegisterIndex.Remove(pCurrentNode);
+    m_FusedInstructions.Remove(pCurrentNode);
+    m_NodeInstructions[uiInstructionIndex] = nullptr;
+  }
+
+  ezUInt32 uiNumInstructions = 0;
+  for (auto pCurrentNode : m_NodeInstructions)
+  {
+    if (pCurrentNode != nullptr)
+    {
+      m_NodeInstructions[uiNumInstructions] = pCurrentNode;
+      ++uiNumInstructions;
+    }
+  }
+
+  m_NodeInstructions.SetCount(uiNumInstructions);
+
   return EZ_SUCCESS;
 }
 
 ezResult ezExpressionCompiler::UpdateRegisterLifetime(const ezExpressionAST& ast)
 {
   ezUInt32 uiNumInstructions = m_NodeInstructions.GetCount();
+
+  // Assign virtual register indices and determine their lifetime start
+  m_LiveIntervals.Clear();
+  for (ezUInt32 uiInstructionIndex = 0; uiInstructionIndex < uiNumInstructions; ++uiInstructionIndex)
+  {
+    auto pCurrentNode = m_NodeInstructions[uiInstructionIndex];
+
+    m_NodeToRegisterIndex[pCurrentNode] = uiInstructionIndex;
+    m_LiveIntervals.PushBack({uiInstructionIndex, uiInstructionIndex, pCurrentNode});
+  }
+
+  ezHybridArray<const ezExpressionAST::Node*, 8> operands;
   for (ezUInt32 uiInstructionIndex = 0; uiInstructionIndex < uiNumInstructions; ++uiInstructionIndex)
   {
     auto pCurrentNode = m_NodeInstructions[uiInstructionIndex];
 
-    auto children = ezExpressionAST::GetChildren(pCurrentNode);
-    for (auto pChild : children)
+    GetRegisterOperands(pCurrentNode, operands);
+    for (auto pChild : operands)
     {
       ezUInt32 uiRegisterIndex = ezInvalidIndex;
       if (m_NodeToRegisterIndex.TryGetValue(pChild, uiRegisterIndex))
@@ -245,7 +413,19 @@ ezResult ezExpressionCompiler::GenerateByteCode(const ezExpressionAST& ast, ezEx
     uiMaxRegisterIndex = ezMath::Max(uiMaxRegisterIndex, uiTargetRegister);
 
     ezExpressionAST::NodeType::Enum nodeType = pCurrentNode->m_Type;
-    if (ezExpressionAST::NodeType::IsUnary(nodeType))
+    if (const FusedInstruction* pFused = m_FusedInstructions.GetValue(pCurrentNode))
+    {
+      byteCode.PushBack(pFused->m_OpCode);
+      byteCode.PushBack(uiTargetRegister);
+
+      for (ezUInt32 uiOperandIndex = 0; uiOperandIndex < EZ_ARRAY_SIZE(pFused->m_Operands); ++uiOperandIndex)
+      {
+        const ezExpressionAST::Node* pOperand = pFused->m_Operands[uiOperandIndex];
+        bool bIsConstant = IsConstantOperand(pFused->m_OpCode, uiOperandIndex);
+        byteCode.PushBack(bIsConstant ? GetConstantValue(pOperand) : m_NodeToRegisterIndex[pOperand]);
+      }
+    }
+    else if (ezExpressionAST::NodeType::IsUnary(nodeType))
     {
       auto pUnary = static_cast<const ezExpressionAST::UnaryOperator*>(pCurrentNode);
 
@@ -370,3 +550,38 @@ ezResult ezExpressionCompiler::GenerateByteCode(const ezExpressionAST& ast, ezEx
 
   return EZ_SUCCESS;
 }
+
+void ezExpressionCompiler::GetRegisterOperands(
+  const ezExpressionAST::Node* pNode, ezHybridArray<const ezExpressionAST::Node*, 8>& out_Operands) const
+{
+  out_Operands.Clear();
+
+  if (const FusedInstruction* pFused = m_FusedInstructions.GetValue(pNode))
+  {
+    for (ezUInt32 uiOperandIndex = 0; uiOperandIndex < EZ_ARRAY_SIZE(pFused->m_Operands); ++uiOperandIndex)
+    {
+      if (!IsConstantOperand(pFused->m_OpCode, uiOperandIndex))
+      {
+        out_Operands.PushBack(pFused->m_Operands[uiOperandIndex]);
+      }
+    }
+  }
+  else if (ezExpressionAST::NodeType::IsBinary(pNode->m_Type))
+  {
+    // A constant left operand is embedded in the instruction, see BuildNodeInstructions
+    auto pBinary = static_cast<const ezExpressionAST::BinaryOperator*>(pNode);
+    if (!IsConstant(pBinary->m_pLeftOperand))
+    {
+      out_Operands.PushBack(pBinary->m_pLeftOperand);
+    }
+
+    out_Operands.PushBack(pBinary->m_pRightOperand);
+  }
+  else
+  {
+    for (auto pChild : ezExpressionAST::GetChildren(pNode))
+    {
+      out_Operands.PushBack(pChild);
+    }
+  }
+}
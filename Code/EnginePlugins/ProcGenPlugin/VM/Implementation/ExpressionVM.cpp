@@ -14,92 +14,96 @@ namespace
 #  define VM_INLINE EZ_ALWAYS_INLINE
 #endif
 
-  template <typename Func>
-  VM_INLINE void VMOperation1(const ezExpressionByteCode::StorageType*& pByteCode, ezSimdVec4f* pRegisters, ezUInt32 uiNumRegisters, Func func)
-  {
-    ezSimdVec4f* r = pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode, uiNumRegisters);
-    ezSimdVec4f* re = r + uiNumRegisters;
+  // Registers are always allocated in pairs so all operations can process 8 instances per loop iteration. The two independent operations per
+  // iteration keep more SIMD units busy.
+  static constexpr ezUInt32 s_uiRegisterAlignment = 2;
 
-    ezSimdVec4f* x = pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode, uiNumRegisters);
+  // Instances are processed in blocks of this size so that all temp registers of a block stay in the L1/L2 cache while the byte code
+  // is executed, instead of streaming every register of all instances through memory once per instruction.
+  static constexpr ezUInt32 s_uiMaxNumInstancesPerBlock = 256;
 
-    while (r != re)
-    {
-      *r = func(*x);
 #ifdef DEBUG_VM
-      EZ_ASSERT_DEV(r->IsValid<4>(), "");
+#  define VM_VALIDATE_RESULT(r) EZ_ASSERT_DEV(r[0].IsValid<4>() && r[1].IsValid<4>(), "")
+#else
+#  define VM_VALIDATE_RESULT(r)
 #endif
 
-      ++r;
-      ++x;
+  struct VMRegister
+  {
+    VM_INLINE VMRegister(const ezExpressionByteCode::StorageType*& pByteCode, ezSimdVec4f* pRegisters, ezUInt32 uiNumRegisters)
+      : m_pValues(pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode, uiNumRegisters))
+    {
     }
-  }
 
-  template <typename Func>
-  VM_INLINE void VMOperation1_C(const ezExpressionByteCode::StorageType*& pByteCode, ezSimdVec4f* pRegisters, ezUInt32 uiNumRegisters, Func func)
+    VM_INLINE const ezSimdVec4f& Get(ezUInt32 uiIndex) const { return m_pValues[uiIndex]; }
+
+    const ezSimdVec4f* m_pValues;
+  };
+
+  struct VMConstant
+  {
+    VM_INLINE VMConstant(const ezExpressionByteCode::StorageType*& pByteCode, ezSimdVec4f* pRegisters, ezUInt32 uiNumRegisters)
+      : m_Value(ezExpressionByteCode::GetConstant(pByteCode))
+    {
+    }
+
+    VM_INLINE const ezSimdVec4f& Get(ezUInt32 uiIndex) const { return m_Value; }
+
+    ezSimdVec4f m_Value;
+  };
+
+  template <typename X, typename Func>
+  VM_INLINE void VMOperation1(const ezExpressionByteCode::StorageType*& pByteCode, ezSimdVec4f* pRegisters, ezUInt32 uiNumRegisters, Func func)
   {
     ezSimdVec4f* r = pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode, uiNumRegisters);
-    ezSimdVec4f* re = r + uiNumRegisters;
 
-    ezSimdVec4f x = ezExpressionByteCode::GetConstant(pByteCode);
+    X x(pByteCode, pRegisters, uiNumRegisters);
 
-    while (r != re)
+    for (ezUInt32 i = 0; i < uiNumRegisters; i += 2)
     {
-      *r = func(x);
-#ifdef DEBUG_VM
-      EZ_ASSERT_DEV(r->IsValid<4>(), "");
-#endif
-
-      ++r;
+      r[i] = func(x.Get(i));
+      r[i + 1] = func(x.Get(i + 1));
+      VM_VALIDATE_RESULT((r + i));
     }
   }
 
-  template <typename Func>
+  template <typename A, typename B, typename Func>
   VM_INLINE void VMOperation2(const ezExpressionByteCode::StorageType*& pByteCode, ezSimdVec4f* pRegisters, ezUInt32 uiNumRegisters, Func func)
   {
     ezSimdVec4f* r = pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode, uiNumRegisters);
-    ezSimdVec4f* re = r + uiNumRegisters;
 
-    ezSimdVec4f* a = pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode, uiNumRegisters);
-    ezSimdVec4f* b = pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode, uiNumRegisters);
+    A a(pByteCode, pRegisters, uiNumRegisters);
+    B b(pByteCode, pRegisters, uiNumRegisters);
 
-    while (r != re)
+    for (ezUInt32 i = 0; i < uiNumRegisters; i += 2)
     {
-      *r = func(*a, *b);
-#ifdef DEBUG_VM
-      EZ_ASSERT_DEV(r->IsValid<4>(), "");
-#endif
-
-      ++r;
-      ++a;
-      ++b;
+      r[i] = func(a.Get(i), b.Get(i));
+      r[i + 1] = func(a.Get(i + 1), b.Get(i + 1));
+      VM_VALIDATE_RESULT((r + i));
     }
   }
 
-  template <typename Func>
-  VM_INLINE void VMOperation2_C(const ezExpressionByteCode::StorageType*& pByteCode, ezSimdVec4f* pRegisters, ezUInt32 uiNumRegisters, Func func)
+  template <typename A, typename B, typename C, typename Func>
+  VM_INLINE void VMOperation3(const ezExpressionByteCode::StorageType*& pByteCode, ezSimdVec4f* pRegisters, ezUInt32 uiNumRegisters, Func func)
   {
     ezSimdVec4f* r = pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode, uiNumRegisters);
-    ezSimdVec4f* re = r + uiNumRegisters;
 
-    ezSimdVec4f a = ezExpressionByteCode::GetConstant(pByteCode);
-    ezSimdVec4f* b = pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode, uiNumRegisters);
+    A a(pByteCode, pRegisters, uiNumRegisters);
+    B b(pByteCode, pRegisters, uiNumRegisters);
+    C c(pByteCode, pRegisters, uiNumRegisters);
 
-    while (r != re)
+    for (ezUInt32 i = 0; i < uiNumRegisters; i += 2)
     {
-      *r = func(a, *b);
-#ifdef DEBUG_VM
-      EZ_ASSERT_DEV(r->IsValid<4>(), "");
-#endif
-
-      ++r;
-      ++b;
+      r[i] = func(a.Get(i), b.Get(i), c.Get(i));
+      r[i + 1] = func(a.Get(i + 1), b.Get(i + 1), c.Get(i + 1));
+      VM_VALIDATE_RESULT((r + i));
     }
   }
 
   VM_INLINE float ReadInputData(const ezUInt8* pData) { return *reinterpret_cast<const float*>(pData); }
 
   void VMLoadInput(const ezExpressionByteCode::StorageType*& pByteCode, ezSimdVec4f* pRegisters, ezUInt32 uiNumRegisters,
-    ezArrayPtr<const ezExpression::Stream> inputs, ezArrayPtr<ezUInt32> inputMapping)
+    ezUInt32 uiFirstInstanceIndex, ezArrayPtr<const ezExpression::Stream> inputs, ezArrayPtr<ezUInt32> inputMapping)
   {
     ezSimdVec4f* r = pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode, uiNumRegisters);
     ezSimdVec4f* re = r + uiNumRegisters;
@@ -108,8 +112,8 @@ namespace
     uiInputIndex = inputMapping[uiInputIndex];
     auto& input = inputs[uiInputIndex];
     ezUInt32 uiByteStride = input.m_uiByteStride;
-    const ezUInt8* pInputData = input.m_Data.GetPtr();
-    const ezUInt8* pInputDataEnd = pInputData + input.m_Data.GetCount() - uiByteStride;
+    const ezUInt8* pInputData = input.m_Data.GetPtr() + uiFirstInstanceIndex * uiByteStride;
+    const ezUInt8* pInputDataEnd = input.m_Data.GetPtr() + input.m_Data.GetCount() - uiByteStride;
 
     while (r != re)
     {
@@ -134,14 +138,14 @@ namespace
   VM_INLINE void StoreOutputData(ezUInt8* pData, float fData) { *reinterpret_cast<float*>(pData) = fData; }
 
   void VMStoreOutput(const ezExpressionByteCode::StorageType*& pByteCode, ezSimdVec4f* pRegisters, ezUInt32 uiNumRegisters,
-    ezArrayPtr<ezExpression::Stream> outputs, ezArrayPtr<ezUInt32> outputMapping)
+    ezUInt32 uiFirstInstanceIndex, ezArrayPtr<ezExpression::Stream> outputs, ezArrayPtr<ezUInt32> outputMapping)
   {
     ezUInt32 uiOutputIndex = ezExpressionByteCode::GetRegisterIndex(pByteCode, 1);
     uiOutputIndex = outputMapping[uiOutputIndex];
     auto& output = outputs[uiOutputIndex];
     ezUInt32 uiByteStride = output.m_uiByteStride;
-    ezUInt8* pOutputData = output.m_Data.GetPtr();
-    ezUInt8* pOutputDataEnd = pOutputData + output.m_Data.GetCount() - uiByteStride;
+    ezUInt8* pOutputData = output.m_Data.GetPtr() + uiFirstInstanceIndex * uiByteStride;
+    ezUInt8* pOutputDataEnd = output.m_Data.GetPtr() + output.m_Data.GetCount() - uiByteStride;
 
     ezSimdVec4f* r = pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode, uiNumRegisters);
     ezSimdVec4f* re = r + uiNumRegisters;
@@ -360,146 +364,189 @@ ezResult ezExpressionVM::Execute(const ezExpressionByteCode& byteCode, ezArrayPt
     }
   }
 
-  const ezUInt32 uiNumRegisters = (uiNumInstances + 3) / 4;
-  const ezUInt32 uiLastInstanceIndex = uiNumInstances - 1;
-
-  const ezUInt32 uiTotalNumRegisters = byteCode.GetNumTempRegisters() * uiNumRegisters;
+  const ezUInt32 uiMaxNumBlockInstances = ezMath::Min(uiNumInstances, s_uiMaxNumInstancesPerBlock);
+  const ezUInt32 uiMaxNumRegisters = ezMemoryUtils::AlignSize((uiMaxNumBlockInstances + 3) / 4, s_uiRegisterAlignment);
+  const ezUInt32 uiTotalNumRegisters = byteCode.GetNumTempRegisters() * uiMaxNumRegisters;
   m_Registers.SetCountUninitialized(uiTotalNumRegisters);
 
   ezSimdVec4f* pRegisters = m_Registers.GetData();
 
-  // Execute bytecode
-  const ezExpressionByteCode::StorageType* pByteCode = byteCode.GetByteCode();
-  const ezExpressionByteCode::StorageType* pByteCodeEnd = byteCode.GetByteCodeEnd();
+  for (ezUInt32 uiFirstInstanceIndex = 0; uiFirstInstanceIndex < uiNumInstances; uiFirstInstanceIndex += s_uiMaxNumInstancesPerBlock)
+  {
+    const ezUInt32 uiNumBlockInstances = ezMath::Min(uiNumInstances - uiFirstInstanceIndex, s_uiMaxNumInstancesPerBlock);
+    const ezUInt32 uiNumRegisters = ezMemoryUtils::AlignSize((uiNumBlockInstances + 3) / 4, s_uiRegisterAlignment);
+
+    // Execute bytecode
+    const ezExpressionByteCode::StorageType* pByteCode = byteCode.GetByteCode();
+    const ezExpressionByteCode::StorageType* pByteCodeEnd = byteCode.GetByteCodeEnd();
 
 #ifdef DEBUG_VM
-  ezUInt32 uiInstructionIndex = 0;
+    ezUInt32 uiInstructionIndex = 0;
 #endif
 
-  while (pByteCode < pByteCodeEnd)
-  {
-    ezExpressionByteCode::OpCode::Enum opCode = ezExpressionByteCode::GetOpCode(pByteCode);
+    while (pByteCode < pByteCodeEnd)
+    {
+      ezExpressionByteCode::OpCode::Enum opCode = ezExpressionByteCode::GetOpCode(pByteCode);
 
 #ifdef DEBUG_VM
-    ezLog::Info("{}: {}", uiInstructionIndex, ezExpressionByteCode::GetOpCodeName(opCode));
+      ezLog::Info("{}: {}", uiInstructionIndex, ezExpressionByteCode::GetOpCodeName(opCode));
 
-    uiInstructionIndex++;
+      uiInstructionIndex++;
 #endif
 
-    switch (opCode)
-    {
-        // unary
-      case ezExpressionByteCode::OpCode::Abs_R:
-        VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return x.Abs(); });
-        break;
+      switch (opCode)
+      {
+          // unary
+        case ezExpressionByteCode::OpCode::Abs_R:
+          VMOperation1<VMRegister>(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return x.Abs(); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Sqrt_R:
-        VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return x.GetSqrt(); });
-        break;
+        case ezExpressionByteCode::OpCode::Sqrt_R:
+          VMOperation1<VMRegister>(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return x.GetSqrt(); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Sin_R:
-        VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::Sin(x); });
-        break;
+        case ezExpressionByteCode::OpCode::Sin_R:
+          VMOperation1<VMRegister>(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::Sin(x); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Cos_R:
-        VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::Cos(x); });
-        break;
+        case ezExpressionByteCode::OpCode::Cos_R:
+          VMOperation1<VMRegister>(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::Cos(x); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Tan_R:
-        VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::Tan(x); });
-        break;
+        case ezExpressionByteCode::OpCode::Tan_R:
+          VMOperation1<VMRegister>(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::Tan(x); });
+          break;
 
-      case ezExpressionByteCode::OpCode::ASin_R:
-        VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::ASin(x); });
-        break;
+        case ezExpressionByteCode::OpCode::ASin_R:
+          VMOperation1<VMRegister>(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::ASin(x); });
+          break;
 
-      case ezExpressionByteCode::OpCode::ACos_R:
-        VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::ACos(x); });
-        break;
+        case ezExpressionByteCode::OpCode::ACos_R:
+          VMOperation1<VMRegister>(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::ACos(x); });
+          break;
 
-      case ezExpressionByteCode::OpCode::ATan_R:
-        VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::ATan(x); });
-        break;
+        case ezExpressionByteCode::OpCode::ATan_R:
+          VMOperation1<VMRegister>(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return ezSimdMath::ATan(x); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Mov_R:
-        VMOperation1(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return x; });
-        break;
+        case ezExpressionByteCode::OpCode::Mov_R:
+          VMOperation1<VMRegister>(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return x; });
+          break;
 
-      case ezExpressionByteCode::OpCode::Mov_C:
-        VMOperation1_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return x; });
-        break;
+        case ezExpressionByteCode::OpCode::Mov_C:
+          VMOperation1<VMConstant>(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& x) { return x; });
+          break;
 
-      case ezExpressionByteCode::OpCode::Mov_I:
-        VMLoadInput(pByteCode, pRegisters, uiNumRegisters, inputs, m_InputMapping);
-        break;
+        case ezExpressionByteCode::OpCode::Mov_I:
+          VMLoadInput(pByteCode, pRegisters, uiNumRegisters, uiFirstInstanceIndex, inputs, m_InputMapping);
+          break;
 
-      case ezExpressionByteCode::OpCode::Mov_O:
-        VMStoreOutput(pByteCode, pRegisters, uiNumRegisters, outputs, m_OutputMapping);
-        break;
+        case ezExpressionByteCode::OpCode::Mov_O:
+          VMStoreOutput(pByteCode, pRegisters, uiNumRegisters, uiFirstInstanceIndex, outputs, m_OutputMapping);
+          break;
 
-        // binary
-      case ezExpressionByteCode::OpCode::Add_RR:
-        VMOperation2(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a + b; });
-        break;
+          // binary
+        case ezExpressionByteCode::OpCode::Add_RR:
+          VMOperation2<VMRegister, VMRegister>(
+            pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a + b; });
+          break;
 
-      case ezExpressionByteCode::OpCode::Add_CR:
-        VMOperation2_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a + b; });
-        break;
+        case ezExpressionByteCode::OpCode::Add_CR:
+          VMOperation2<VMConstant, VMRegister>(
+            pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a + b; });
+          break;
 
-      case ezExpressionByteCode::OpCode::Sub_RR:
-        VMOperation2(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a - b; });
-        break;
+        case ezExpressionByteCode::OpCode::Sub_RR:
+          VMOperation2<VMRegister, VMRegister>(
+            pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a - b; });
+          break;
 
-      case ezExpressionByteCode::OpCode::Sub_CR:
-        VMOperation2_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a - b; });
-        break;
+        case ezExpressionByteCode::OpCode::Sub_CR:
+          VMOperation2<VMConstant, VMRegister>(
+            pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a - b; });
+          break;
 
-      case ezExpressionByteCode::OpCode::Mul_RR:
-        VMOperation2(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMul(b); });
-        break;
+        case ezExpressionByteCode::OpCode::Mul_RR:
+          VMOperation2<VMRegister, VMRegister>(
+            pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMul(b); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Mul_CR:
-        VMOperation2_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMul(b); });
-        break;
+        case ezExpressionByteCode::OpCode::Mul_CR:
+          VMOperation2<VMConstant, VMRegister>(
+            pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMul(b); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Div_RR:
-        VMOperation2(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompDiv(b); });
-        break;
+        case ezExpressionByteCode::OpCode::Div_RR:
+          VMOperation2<VMRegister, VMRegister>(
+            pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompDiv(b); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Div_CR:
-        VMOperation2_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompDiv(b); });
-        break;
+        case ezExpressionByteCode::OpCode::Div_CR:
+          VMOperation2<VMConstant, VMRegister>(
+            pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompDiv(b); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Min_RR:
-        VMOperation2(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMin(b); });
-        break;
+        case ezExpressionByteCode::OpCode::Min_RR:
+          VMOperation2<VMRegister, VMRegister>(
+            pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMin(b); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Min_CR:
-        VMOperation2_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMin(b); });
-        break;
+        case ezExpressionByteCode::OpCode::Min_CR:
+          VMOperation2<VMConstant, VMRegister>(
+            pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMin(b); });
+          break;
 
-      case ezExpressionByteCode::OpCode::Max_RR:
-        VMOperation2(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMax(b); });
-        break;
+        case ezExpressionByteCode::OpCode::Max_RR:
+          VMOperation2<VMRegister, VMRegister>(
+            pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMax(b); });
+          break;
+
+        case ezExpressionByteCode::OpCode::Max_CR:
+          VMOperation2<VMConstant, VMRegister>(
+            pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMax(b); });
+          break;
+
+          // call
+        case ezExpressionByteCode::OpCode::Call:
+        {
+          ezUInt32 uiFunctionIndex = ezExpressionByteCode::GetFunctionIndex(pByteCode);
+          uiFunctionIndex = m_FunctionMapping[uiFunctionIndex];
+          auto& func = m_Functions[uiFunctionIndex].m_Func;
 
-      case ezExpressionByteCode::OpCode::Max_CR:
-        VMOperation2_C(pByteCode, pRegisters, uiNumRegisters, [](const ezSimdVec4f& a, const ezSimdVec4f& b) { return a.CompMax(b); });
+          VMCall(pByteCode, pRegisters, uiNumRegisters, globalData, func);
+        }
         break;
 
-        // call
-      case ezExpressionByteCode::OpCode::Call:
-      {
-        ezUInt32 uiFunctionIndex = ezExpressionByteCode::GetFunctionIndex(pByteCode);
-        uiFunctionIndex = m_FunctionMapping[uiFunctionIndex];
-        auto& func = m_Functions[uiFunctionIndex].m_Func;
+          // ternary, these must compute exactly what the unfused instructions would, so MulAdd rounds twice instead of using FMA
+        case ezExpressionByteCode::OpCode::MulAdd_RRR:
+          VMOperation3<VMRegister, VMRegister, VMRegister>(pByteCode, pRegisters, uiNumRegisters,
+            [](const ezSimdVec4f& a, const ezSimdVec4f& b, const ezSimdVec4f& c) { return a.CompMul(b) + c; });
+          break;
 
-        VMCall(pByteCode, pRegisters, uiNumRegisters, globalData, func);
-      }
-      break;
+        case ezExpressionByteCode::OpCode::MulAdd_CRR:
+          VMOperation3<VMConstant, VMRegister, VMRegister>(pByteCode, pRegisters, uiNumRegisters,
+            [](const ezSimdVec4f& a, const ezSimdVec4f& b, const ezSimdVec4f& c) { return a.CompMul(b) + c; });
+          break;
 
-      default:
-        EZ_ASSERT_NOT_IMPLEMENTED;
-        return EZ_FAILURE;
+        case ezExpressionByteCode::OpCode::MulAdd_RRC:
+          VMOperation3<VMRegister, VMRegister, VMConstant>(pByteCode, pRegisters, uiNumRegisters,
+            [](const ezSimdVec4f& a, const ezSimdVec4f& b, const ezSimdVec4f& c) { return a.CompMul(b) + c; });
+          break;
+
+        case ezExpressionByteCode::OpCode::MulAdd_CRC:
+          VMOperation3<VMConstant, VMRegister, VMConstant>(pByteCode, pRegisters, uiNumRegisters,
+            [](const ezSimdVec4f& a, const ezSimdVec4f& b, const ezSimdVec4f& c) { return a.CompMul(b) + c; });
+          break;
+
+        case ezExpressionByteCode::OpCode::Clamp_CCR:
+          VMOperation3<VMConstant, VMConstant, VMRegister>(pByteCode, pRegisters, uiNumRegisters,
+            [](const ezSimdVec4f& a, const ezSimdVec4f& b, const ezSimdVec4f& c) { return b.CompMin(a.CompMax(c)); });
+          break;
+
+        default:
+          EZ_ASSERT_NOT_IMPLEMENTED;
+          return EZ_FAILURE;
+      }
     }
   }
 
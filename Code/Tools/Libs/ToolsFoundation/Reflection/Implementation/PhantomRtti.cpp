@@ -17,6 +17,7 @@ ezPhantomRTTI::ezPhantomRTTI(const char* szName, const ezRTTI* pParentType, ezUI
   m_szPluginName = m_sPluginNameStorage.GetData();
 
   RegisterType();
+  SetupParentHierarchy();
 }
 
 ezPhantomRTTI::~ezPhantomRTTI()
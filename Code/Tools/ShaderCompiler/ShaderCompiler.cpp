@@ -2,6 +2,7 @@
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Utilities/CommandLineOptions.h>
 #include <RendererCore/ShaderCompiler/ShaderCompiler.h>
 #include <RendererCore/ShaderCompiler/ShaderManager.h>
@@ -30,6 +31,8 @@ Examples:\n\
 
 ezCommandLineOptionBool opt_IgnoreErrors("_ShaderCompiler", "-IgnoreErrors", "If set, a compile error won't stop other shaders from being compiled.", false);
 
+ezCommandLineOptionBool opt_SingleThreaded("_ShaderCompiler", "-SingleThreaded", "If set, the permutations of a shader are compiled one after another instead of in parallel.", false);
+
 ezCommandLineOptionDoc opt_Perm("_ShaderCompiler", "-perm", "<string list>", "List of permutation variables to set to fixed values.\n\
 Spaces are used to separate multiple arguments, therefore each argument mustn't use spaces.\n\
 In the form of 'SOME_VAR=VALUE'\n\
@@ -77,6 +80,8 @@ ezResult ezShaderCompilerApplication::BeforeCoreSystemsStartup()
 
   m_bIgnoreErrors = opt_IgnoreErrors.GetOptionValue(ezCommandLineOption::LogMode::Always);
 
+  m_bCompileInParallel = !opt_SingleThreaded.GetOptionValue(ezCommandLineOption::LogMode::Always);
+
   const ezUInt32 pvs = cmd->GetStringOptionArguments("-perm");
 
   for (ezUInt32 pv = 0; pv < pvs; ++pv)
@@ -130,22 +135,54 @@ ezResult ezShaderCompilerApplication::CompileShader(const char* szShaderFile)
   if (ExtractPermutationVarValues(szShaderFile).Failed())
     return EZ_FAILURE;
 
-  ezHybridArray<ezPermutationVar, 16> PermVars;
-
   const ezUInt32 uiMaxPerms = m_PermutationGenerator.GetPermutationCount();
 
   ezLog::Info("Shader has {0} permutations", uiMaxPerms);
 
+  ezDynamicArray<ezHybridArray<ezPermutationVar, 16>> permutations;
+  permutations.SetCount(uiMaxPerms);
+
   for (ezUInt32 perm = 0; perm < uiMaxPerms; ++perm)
   {
-    EZ_LOG_BLOCK("Compiling Permutation");
+    m_PermutationGenerator.GetPermutation(perm, permutations[perm]);
+  }
 
-    m_PermutationGenerator.GetPermutation(perm, PermVars);
-    ezShaderCompiler sc;
-    if (sc.CompileShaderPermutationForPlatforms(szShaderFile, PermVars, ezLog::GetThreadLocalLogSystem(), m_sPlatforms).Failed())
-      return EZ_FAILURE;
+  ezAtomicInteger32 iNumFailed;
+
+  auto compilePermutations = [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+    for (ezUInt32 perm = uiStartIndex; perm < uiEndIndex; ++perm)
+    {
+      // stop early, like a serial compile would
+      if (iNumFailed > 0)
+        return;
+
+      EZ_LOG_BLOCK("Compiling Permutation");
+
+      // every permutation gets its own compiler, only the tokenized include files are shared
+      ezShaderCompiler sc(&m_FileCache);
+      if (sc.CompileShaderPermutationForPlatforms(szShaderFile, permutations[perm], ezLog::GetThreadLocalLogSystem(), m_sPlatforms).Failed())
+      {
+        iNumFailed.Increment();
+      }
+    }
+  };
+
+  if (m_bCompileInParallel)
+  {
+    ezParallelForParams params;
+    params.uiBinSize = 1;
+    params.uiMaxTasksPerThread = 3; // permutations take vastly different amounts of time, e.g. when they are already up to date
+
+    ezTaskSystem::ParallelForIndexed(0, uiMaxPerms, compilePermutations, "Compile Shader Permutations", params);
+  }
+  else
+  {
+    compilePermutations(0, uiMaxPerms);
   }
 
+  if (iNumFailed > 0)
+    return EZ_FAILURE;
+
   ezLog::Success("Compiled Shader '{0}'", szShaderFile);
   return EZ_SUCCESS;
 }
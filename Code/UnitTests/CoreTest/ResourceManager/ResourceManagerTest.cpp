@@ -1,6 +1,10 @@
 #include <CoreTestPCH.h>
 
 #include <Core/ResourceManager/ResourceManager.h>
+#include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/Time/Stopwatch.h>
 #include <Foundation/Types/ScopeExit.h>
 
 EZ_CREATE_SIMPLE_TEST_GROUP(ResourceManager);
@@ -122,6 +126,25 @@ namespace
     }
   };
 
+  // Reads the resources from files, which contain the same data that TestResourceTypeLoader generates
+  class TestFileResourceTypeLoader : public ezResourceLoaderFromFile
+  {
+  public:
+    virtual ezResourceLoadData OpenDataStream(const ezResource* pResource) override
+    {
+      ezResourceLoadData ld = ezResourceLoaderFromFile::OpenDataStream(pResource);
+
+      // skip the absolute path that the file loader puts in front of the file content
+      if (ld.m_pDataStream != nullptr)
+      {
+        ezStringBuilder sAbsolutePath;
+        *ld.m_pDataStream >> sAbsolutePath;
+      }
+
+      return ld;
+    }
+  };
+
   EZ_RESOURCE_IMPLEMENT_COMMON_CODE(TestResource);
   EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(TestResource, 1, ezRTTIDefaultAllocator<TestResource>)
   EZ_END_DYNAMIC_REFLECTED_TYPE;
@@ -286,3 +309,277 @@ EZ_CREATE_SIMPLE_TEST(ResourceManager, NestedLoading)
     EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(ResourceManager, MemoryBudgets)
+{
+  TestResourceTypeLoader TypeLoader;
+  ezResourceManager::SetResourceTypeLoader<TestResource>(&TypeLoader);
+  EZ_SCOPE_EXIT(ezResourceManager::SetResourceTypeLoader<TestResource>(nullptr));
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Deallocate unreferenced resources")
+  {
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
+
+    const ezUInt32 uiNumResources = 50;
+    const ezUInt32 uiNumReferenced = 5;
+    const ezUInt32 uiNumInBudget = 10;
+
+    ezResourceManager::SetResourceTypeMemoryBudget<TestResource>(uiNumInBudget * sizeof(TestResource), 0);
+    EZ_SCOPE_EXIT(ezResourceManager::SetResourceTypeMemoryBudget<TestResource>(0, 0));
+
+    ezDynamicArray<TestResourceHandle> hResources;
+
+    ezStringBuilder sResourceID;
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      sResourceID.Format("Budget-{}", i);
+      hResources.PushBack(ezResourceManager::LoadResource<TestResource>(sResourceID));
+
+      ezResourceLock<TestResource> pTestResource(hResources.PeekBack(), ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+      EZ_TEST_BOOL(pTestResource.GetAcquireResult() == ezResourceAcquireResult::Final);
+    }
+
+    while (ezResourceManager::IsAnyLoadingInProgress())
+    {
+      ezThreadUtils::Sleep(ezTime::Milliseconds(10));
+    }
+
+    hResources.SetCount(uiNumReferenced);
+
+    // resources that were acquired during the last two frames are never evicted
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      ezResourceManager::PerFrameUpdate();
+    }
+
+    ezResourceManager::MemoryBudgetStats stats;
+    EZ_TEST_BOOL(ezResourceManager::GetMemoryBudgetStats(ezGetStaticRTTI<TestResource>(), stats).Succeeded());
+    EZ_TEST_INT(stats.m_uiBudgetCPU, uiNumInBudget * sizeof(TestResource));
+    EZ_TEST_INT(stats.m_uiMemoryCPU, uiNumInBudget * sizeof(TestResource));
+    EZ_TEST_INT(stats.m_uiNumDeallocatedResources, uiNumResources - uiNumInBudget);
+    EZ_TEST_INT(stats.m_uiNumDiscardedQualityLevels, 0);
+    EZ_TEST_INT(stats.m_uiNumFramesOverBudget, 0);
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), uiNumInBudget);
+
+    for (const TestResourceHandle& hResource : hResources)
+    {
+      EZ_TEST_BOOL(ezResourceManager::GetLoadingState(hResource) == ezResourceState::Loaded);
+    }
+
+    // the referenced resources cannot be evicted
+    ezResourceManager::SetResourceTypeMemoryBudget<TestResource>(1, 0);
+    ezResourceManager::PerFrameUpdate();
+
+    EZ_TEST_BOOL(ezResourceManager::GetMemoryBudgetStats(ezGetStaticRTTI<TestResource>(), stats).Succeeded());
+    EZ_TEST_INT(stats.m_uiMemoryCPU, uiNumReferenced * sizeof(TestResource));
+    EZ_TEST_INT(stats.m_uiNumFramesOverBudget, 1);
+
+    hResources.Clear();
+    ezResourceManager::FreeAllUnusedResources();
+
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
+  }
+}
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::Enabled;
+#endif
+
+EZ_CREATE_SIMPLE_TEST(ResourceManager, Profile_LoadingQueue)
+{
+  TestResourceTypeLoader TypeLoader;
+  ezResourceManager::SetResourceTypeLoader<TestResource>(&TypeLoader);
+  EZ_SCOPE_EXIT(ezResourceManager::SetResourceTypeLoader<TestResource>(nullptr));
+
+  EZ_TEST_BLOCK(EnableInRelease, "Time to first use with a saturated queue")
+  {
+    const ezUInt32 uiNumBackgroundResources = 4000;
+    const ezUInt32 uiNumUrgentResources = 20;
+
+    auto QueueResources = [](const char* szPrefix, ezUInt32 uiNumResources, ezResourcePriority priority, ezDynamicArray<TestResourceHandle>& out_Resources) {
+      ezStringBuilder sResourceID;
+      for (ezUInt32 i = 0; i < uiNumResources; ++i)
+      {
+        sResourceID.Format("{}-{}", szPrefix, i);
+        TestResourceHandle hResource = ezResourceManager::LoadResource<TestResource>(sResourceID);
+
+        {
+          ezResourceLock<TestResource> pTestResource(hResource, ezResourceAcquireMode::PointerOnly);
+          pTestResource->SetPriority(priority);
+        }
+
+        ezResourceManager::PreloadResource(hResource);
+        out_Resources.PushBack(hResource);
+      }
+    };
+
+    auto CountLoaded = [](const ezDynamicArray<TestResourceHandle>& resources) {
+      ezUInt32 uiNumLoaded = 0;
+      for (const TestResourceHandle& hResource : resources)
+      {
+        if (ezResourceManager::GetLoadingState(hResource) == ezResourceState::Loaded)
+          ++uiNumLoaded;
+      }
+      return uiNumLoaded;
+    };
+
+    ezDynamicArray<TestResourceHandle> hBackgroundResources;
+    hBackgroundResources.Reserve(uiNumBackgroundResources);
+    QueueResources("Background", uiNumBackgroundResources, ezResourcePriority::VeryLow, hBackgroundResources);
+
+    ezStopwatch sw;
+
+    ezDynamicArray<TestResourceHandle> hUrgentResources;
+    hUrgentResources.Reserve(uiNumUrgentResources);
+    QueueResources("Urgent", uiNumUrgentResources, ezResourcePriority::VeryHigh, hUrgentResources);
+
+    // re-prioritize some of the resources that are already queued, they have to move to the front as well
+    for (ezUInt32 i = uiNumBackgroundResources - uiNumUrgentResources; i < uiNumBackgroundResources; ++i)
+    {
+      ezResourceLock<TestResource> pTestResource(hBackgroundResources[i], ezResourceAcquireMode::PointerOnly);
+      pTestResource->SetPriority(ezResourcePriority::VeryHigh);
+    }
+
+    const ezUInt32 uiNumBackgroundLoadedBefore = CountLoaded(hBackgroundResources);
+
+    ezTime tFirstUse;
+    ezTime tAllUrgent;
+    ezTime tAllPromoted;
+
+    while (tAllUrgent.IsZero() || tAllPromoted.IsZero())
+    {
+      const ezUInt32 uiNumUrgentLoaded = CountLoaded(hUrgentResources);
+
+      ezUInt32 uiNumPromotedLoaded = 0;
+      for (ezUInt32 i = uiNumBackgroundResources - uiNumUrgentResources; i < uiNumBackgroundResources; ++i)
+      {
+        if (ezResourceManager::GetLoadingState(hBackgroundResources[i]) == ezResourceState::Loaded)
+          ++uiNumPromotedLoaded;
+      }
+
+      const ezTime tNow = sw.GetRunningTotal();
+
+      if (tFirstUse.IsZero() && uiNumUrgentLoaded > 0)
+        tFirstUse = tNow;
+      if (tAllUrgent.IsZero() && uiNumUrgentLoaded == uiNumUrgentResources)
+        tAllUrgent = tNow;
+      if (tAllPromoted.IsZero() && uiNumPromotedLoaded == uiNumUrgentResources)
+        tAllPromoted = tNow;
+
+      ezThreadUtils::YieldTimeSlice();
+    }
+
+    const ezUInt32 uiNumBackgroundLoadedMeanwhile = CountLoaded(hBackgroundResources) - uiNumBackgroundLoadedBefore;
+
+    ezTestFramework::Output(ezTestOutput::Duration,
+      "%u queued resources: first urgent resource loaded after %.2f ms, all %u after %.2f ms, all re-prioritized after %.2f ms, %u other resources loaded meanwhile",
+      uiNumBackgroundResources, tFirstUse.GetMilliseconds(), uiNumUrgentResources, tAllUrgent.GetMilliseconds(), tAllPromoted.GetMilliseconds(),
+      uiNumBackgroundLoadedMeanwhile);
+
+    // the urgent resources must not have to wait for the whole queue
+    EZ_TEST_BOOL(uiNumBackgroundLoadedMeanwhile < uiNumBackgroundResources - uiNumBackgroundLoadedBefore);
+
+    while (ezResourceManager::IsAnyLoadingInProgress())
+    {
+      ezThreadUtils::Sleep(ezTime::Milliseconds(10));
+    }
+
+    hBackgroundResources.Clear();
+    hUrgentResources.Clear();
+
+    ezUInt32 uiUnloaded = 0;
+
+    for (ezUInt32 tries = 0; tries < 3; ++tries)
+    {
+      // if a resource is in a loading queue, unloading it can actually 'fail' for a short time
+      uiUnloaded += ezResourceManager::FreeAllUnusedResources();
+
+      if (uiUnloaded == uiNumBackgroundResources + uiNumUrgentResources)
+        break;
+
+      ezThreadUtils::Sleep(ezTime::Milliseconds(100));
+    }
+
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(ResourceManager, Profile_Loading)
+{
+  TestFileResourceTypeLoader TypeLoader;
+  ezResourceManager::SetResourceTypeLoader<TestResource>(&TypeLoader);
+  EZ_SCOPE_EXIT(ezResourceManager::SetResourceTypeLoader<TestResource>(nullptr));
+
+  EZ_TEST_BLOCK(EnableInRelease, "Load many small files")
+  {
+    const ezUInt32 uiNumResources = 4000;
+    const ezUInt32 uiNumElements = 256;
+
+    ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+    sOutputFolder.AppendPath("PerfResourceLoading");
+
+    ezFileSystem::RegisterDataDirectoryFactory(ezDataDirectory::FolderType::Factory);
+    EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "PerfResourceLoading", "perfres", ezFileSystem::AllowWrites).Succeeded());
+
+    ezStringBuilder sResourceID;
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      sResourceID.Format(":perfres/Resource-{}.bin", i);
+
+      ezFileWriter file;
+      EZ_TEST_BOOL(file.Open(sResourceID).Succeeded());
+
+      file << uiNumElements;
+      for (ezUInt32 e = 0; e < uiNumElements; ++e)
+      {
+        file << e;
+      }
+    }
+
+    const ezUInt32 uiPrevShortTasks = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+    const ezUInt32 uiPrevLongTasks = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::LongTasks);
+    const ezUInt32 uiPrevFileAccessTasks = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::FileAccess);
+
+    for (ezUInt32 uiFileAccessTasks : {1u, 2u, 4u, 8u})
+    {
+      ezTaskSystem::SetWorkerThreadCount(uiPrevShortTasks, uiPrevLongTasks, uiFileAccessTasks);
+
+      ezDynamicArray<TestResourceHandle> hResources;
+      hResources.Reserve(uiNumResources);
+
+      ezStopwatch sw;
+
+      for (ezUInt32 i = 0; i < uiNumResources; ++i)
+      {
+        sResourceID.Format(":perfres/Resource-{}.bin", i);
+        hResources.PushBack(ezResourceManager::LoadResource<TestResource>(sResourceID));
+        ezResourceManager::PreloadResource(hResources.PeekBack());
+      }
+
+      while (ezResourceManager::IsAnyLoadingInProgress())
+      {
+        ezThreadUtils::Sleep(ezTime::Milliseconds(1));
+      }
+
+      const ezTime tLoading = sw.Checkpoint();
+
+      for (const TestResourceHandle& hResource : hResources)
+      {
+        EZ_TEST_BOOL(ezResourceManager::GetLoadingState(hResource) == ezResourceState::Loaded);
+      }
+
+      ezTestFramework::Output(ezTestOutput::Duration, "%u file access threads: %u resources loaded in %.1f ms, %.0f resources/s", uiFileAccessTasks,
+        uiNumResources, tLoading.GetMilliseconds(), uiNumResources / tLoading.GetSeconds());
+
+      hResources.Clear();
+      ezResourceManager::FreeAllUnusedResources();
+      EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
+    }
+
+    ezTaskSystem::SetWorkerThreadCount(uiPrevShortTasks, uiPrevLongTasks, uiPrevFileAccessTasks);
+
+    EZ_TEST_INT(ezFileSystem::RemoveDataDirectoryGroup("PerfResourceLoading"), 1);
+  }
+}
@@ -0,0 +1,377 @@
+#include <CoreTestPCH.h>
+
+#include <Core/Assets/AssetFileHeader.h>
+#include <Core/Prefabs/PrefabResource.h>
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Core/ResourceManager/ResourceTypeLoader.h>
+#include <Core/World/World.h>
+#include <Core/WorldSerializer/WorldReader.h>
+#include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/IO/MemoryStream.h>
+
+namespace
+{
+  class ezPrefabTestComponent;
+  typedef ezComponentManager<ezPrefabTestComponent, ezBlockStorageType::FreeList> ezPrefabTestComponentManager;
+
+  class ezPrefabTestComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(ezPrefabTestComponent, ezComponent, ezPrefabTestComponentManager);
+
+  public:
+    virtual void SerializeComponent(ezWorldWriter& stream) const override { stream.GetStream() << m_iValue; }
+    virtual void DeserializeComponent(ezWorldReader& stream) override { stream.GetStream() >> m_iValue; }
+
+    ezInt32 m_iValue = 0;
+  };
+
+  // clang-format off
+  EZ_BEGIN_COMPONENT_TYPE(ezPrefabTestComponent, 1, ezComponentMode::Static)
+  {
+    EZ_BEGIN_PROPERTIES
+    {
+      EZ_MEMBER_PROPERTY("Value", m_iValue),
+    }
+    EZ_END_PROPERTIES;
+  }
+  EZ_END_COMPONENT_TYPE;
+  // clang-format on
+
+  ezGameObject* CreateObjectWithComponent(ezWorld& world, const ezGameObjectDesc& desc, ezInt32 iValue)
+  {
+    ezGameObject* pObject = nullptr;
+    world.CreateObject(desc, pObject);
+
+    ezPrefabTestComponent* pComponent = nullptr;
+    ezPrefabTestComponent::CreateComponent(pObject, pComponent);
+    pComponent->m_iValue = iValue;
+
+    return pObject;
+  }
+
+  /// A root object with a child and a grandchild, each with a component and a distinct local transform.
+  void WritePrefab(ezMemoryStreamStorage& prefabData)
+  {
+    ezWorldDesc worldDesc("Source");
+    ezWorld world(worldDesc);
+
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezGameObjectDesc gd;
+    gd.m_sName.Assign("Root");
+    gd.m_LocalPosition.Set(1, 2, 3);
+    gd.m_LocalRotation.SetFromAxisAndAngle(ezVec3(0, 0, 1), ezAngle::Degree(30));
+    gd.m_LocalScaling.Set(2, 2, 2);
+    gd.m_uiStableRandomSeed = 11;
+    ezGameObject* pRoot = CreateObjectWithComponent(world, gd, 7);
+
+    gd = ezGameObjectDesc();
+    gd.m_sName.Assign("Child");
+    gd.m_hParent = pRoot->GetHandle();
+    gd.m_LocalPosition.Set(0, 1, 0);
+    gd.m_LocalRotation.SetFromAxisAndAngle(ezVec3(1, 0, 0), ezAngle::Degree(45));
+    gd.m_uiStableRandomSeed = 12;
+    ezGameObject* pChild = CreateObjectWithComponent(world, gd, 11);
+
+    gd = ezGameObjectDesc();
+    gd.m_sName.Assign("GrandChild");
+    gd.m_hParent = pChild->GetHandle();
+    gd.m_LocalPosition.Set(0, 0, 5);
+    gd.m_uiStableRandomSeed = 13;
+    CreateObjectWithComponent(world, gd, 13);
+
+    ezMemoryStreamWriter writer(&prefabData);
+    ezWorldWriter worldWriter;
+    worldWriter.WriteWorld(writer, world);
+  }
+
+  ezInt32 GetComponentValue(ezGameObject* pObject)
+  {
+    ezPrefabTestComponent* pComponent = nullptr;
+    if (!pObject->TryGetComponentOfBaseType(pComponent))
+      return -1;
+
+    return pComponent->m_iValue;
+  }
+
+  /// Returns the index of the object's parent in \a objects, -1 if it is \a pExternalParent and -2 if it has no parent.
+  ezInt32 GetParentIndex(ezGameObject* pObject, const ezDynamicArray<ezGameObject*>& objects, const ezGameObject* pExternalParent)
+  {
+    ezGameObject* pParent = pObject->GetParent();
+
+    if (pParent == nullptr)
+      return -2;
+
+    if (pParent == pExternalParent)
+      return -1;
+
+    const ezUInt32 uiIndex = objects.IndexOf(pParent);
+    EZ_TEST_BOOL(uiIndex != ezInvalidIndex);
+    return static_cast<ezInt32>(uiIndex);
+  }
+
+  /// The objects of both arrays must be equal pair-wise, parents are compared by their index in the array.
+  void CompareObjects(const ezDynamicArray<ezGameObject*>& objects1, const ezGameObject* pParent1, const ezDynamicArray<ezGameObject*>& objects2, const ezGameObject* pParent2)
+  {
+    if (!EZ_TEST_INT(objects1.GetCount(), objects2.GetCount()))
+      return;
+
+    for (ezUInt32 i = 0; i < objects1.GetCount(); ++i)
+    {
+      ezGameObject* pObject1 = objects1[i];
+      ezGameObject* pObject2 = objects2[i];
+
+      EZ_TEST_STRING(pObject1->GetName(), pObject2->GetName());
+      EZ_TEST_BOOL(pObject1->GetGlobalTransform().IsEqual(pObject2->GetGlobalTransform(), 0.0001f));
+      EZ_TEST_INT(GetParentIndex(pObject1, objects1, pParent1), GetParentIndex(pObject2, objects2, pParent2));
+      EZ_TEST_INT(pObject1->GetStableRandomSeed(), pObject2->GetStableRandomSeed());
+      EZ_TEST_INT(GetComponentValue(pObject1), GetComponentValue(pObject2));
+    }
+  }
+
+  void AppendObjects(ezDynamicArray<ezGameObject*>& out_Objects, const ezDynamicArray<ezGameObject*>& rootObjects, const ezDynamicArray<ezGameObject*>& childObjects)
+  {
+    out_Objects.PushBackRange(rootObjects);
+    out_Objects.PushBackRange(childObjects);
+  }
+
+  /// Spawns the prefab once per transform with InstantiatePrefab() and all at once with InstantiatePrefabs(), each into its own world.
+  void CompareSingleAndBatchedInstantiation(ezWorldReader& worldReader, ezArrayPtr<const ezTransform> transforms, ezPrefabInstantiationOptions options, bool bUseParent)
+  {
+    ezWorldDesc worldDesc1("Single");
+    ezWorld world1(worldDesc1);
+    ezWorldDesc worldDesc2("Batched");
+    ezWorld world2(worldDesc2);
+
+    EZ_LOCK(world1.GetWriteMarker());
+    EZ_LOCK(world2.GetWriteMarker());
+
+    ezGameObjectDesc parentDesc;
+    parentDesc.m_LocalPosition.Set(-5, 10, 0);
+    parentDesc.m_LocalRotation.SetFromAxisAndAngle(ezVec3(0, 1, 0), ezAngle::Degree(90));
+    parentDesc.m_uiStableRandomSeed = 1234;
+
+    ezGameObject* pParent1 = nullptr;
+    ezGameObject* pParent2 = nullptr;
+
+    if (bUseParent)
+    {
+      world1.CreateObject(parentDesc, pParent1);
+      world2.CreateObject(parentDesc, pParent2);
+    }
+
+    ezDynamicArray<ezGameObject*> rootObjects1, childObjects1, rootObjects2, childObjects2;
+
+    options.m_hParent = bUseParent ? pParent1->GetHandle() : ezGameObjectHandle();
+    options.m_pCreatedRootObjectsOut = &rootObjects1;
+    options.m_pCreatedChildObjectsOut = &childObjects1;
+
+    for (const ezTransform& transform : transforms)
+    {
+      worldReader.InstantiatePrefab(world1, transform, options);
+    }
+
+    options.m_hParent = bUseParent ? pParent2->GetHandle() : ezGameObjectHandle();
+    options.m_pCreatedRootObjectsOut = &rootObjects2;
+    options.m_pCreatedChildObjectsOut = &childObjects2;
+
+    worldReader.InstantiatePrefabs(world2, transforms, options);
+
+    EZ_TEST_INT(rootObjects1.GetCount(), transforms.GetCount() * worldReader.GetRootObjectCount());
+    EZ_TEST_INT(childObjects1.GetCount(), transforms.GetCount() * worldReader.GetChildObjectCount());
+    EZ_TEST_INT(world1.GetObjectCount(), world2.GetObjectCount());
+
+    ezDynamicArray<ezGameObject*> allObjects1, allObjects2;
+    AppendObjects(allObjects1, rootObjects1, childObjects1);
+    AppendObjects(allObjects2, rootObjects2, childObjects2);
+
+    CompareObjects(allObjects1, pParent1, allObjects2, pParent2);
+
+    // the component values come from deserialization
+    for (ezUInt32 i = 0; i < rootObjects2.GetCount(); ++i)
+    {
+      EZ_TEST_INT(GetComponentValue(rootObjects2[i]), 7);
+    }
+  }
+
+  ezPrefabResourceHandle CreatePrefabResource(const ezMemoryStreamStorage& worldData)
+  {
+    ezUniquePtr<ezResourceLoaderFromMemory> loader(EZ_DEFAULT_NEW(ezResourceLoaderFromMemory));
+    loader->m_ModificationTimestamp = ezTimestamp::CurrentTimestamp();
+    loader->m_sResourceDescription = "PrefabInstantiationTest";
+
+    ezMemoryStreamWriter writer(&loader->m_CustomData);
+
+    // the file loader writes the path of the file into the stream first
+    ezString sPath = "PrefabInstantiationTest";
+    writer << sPath;
+
+    // version 6 is the first one with the current format of the exposed parameters
+    ezAssetFileHeader header;
+    header.SetFileHashAndVersion(1, 6);
+    header.Write(writer).IgnoreResult();
+
+    const char* szSceneTag = "[ezBinaryScene]";
+    writer.WriteBytes(szSceneTag, sizeof(char) * 16).IgnoreResult();
+
+    ezMemoryStreamReader worldReader(&worldData);
+    ezUInt8 uiTemp[1024];
+    while (const ezUInt64 uiRead = worldReader.ReadBytes(uiTemp, EZ_ARRAY_SIZE(uiTemp)))
+    {
+      writer.WriteBytes(uiTemp, uiRead).IgnoreResult();
+    }
+
+    ezExposedPrefabParameterDesc rootParam;
+    rootParam.m_sExposeName.Assign("RootValue");
+    rootParam.m_uiWorldReaderChildObject = 0;
+    rootParam.m_uiWorldReaderObjectIndex = 0;
+    rootParam.m_sComponentType.Assign("ezPrefabTestComponent");
+    rootParam.m_sProperty.Assign("Value");
+
+    // the child objects are written depth first, index 0 is 'Child', index 1 is 'GrandChild'
+    ezExposedPrefabParameterDesc childParam;
+    childParam.m_sExposeName.Assign("ChildValue");
+    childParam.m_uiWorldReaderChildObject = 1;
+    childParam.m_uiWorldReaderObjectIndex = 0;
+    childParam.m_sComponentType.Assign("ezPrefabTestComponent");
+    childParam.m_sProperty.Assign("Value");
+
+    writer << ezUInt32(2);
+    rootParam.Save(writer);
+    childParam.Save(writer);
+
+    ezPrefabResourceHandle hPrefab = ezResourceManager::GetExistingResourceOrCreateAsync<ezPrefabResource>("PrefabInstantiationTest", std::move(loader));
+    ezResourceManager::ForceLoadResourceNow(hPrefab);
+    return hPrefab;
+  }
+
+  /// Checks that every instance got the exposed parameter values and that \a pUntouched was left alone.
+  void TestExposedParameters(const ezDynamicArray<ezGameObject*>& rootObjects, const ezDynamicArray<ezGameObject*>& childObjects, ezUInt32 uiNumInstances, ezGameObject* pUntouched)
+  {
+    // the output arrays already held the untouched object before the instantiation
+    if (!EZ_TEST_INT(rootObjects.GetCount(), 1 + uiNumInstances) || !EZ_TEST_INT(childObjects.GetCount(), 1 + uiNumInstances * 2))
+      return;
+
+    EZ_TEST_BOOL(rootObjects[0] == pUntouched);
+    EZ_TEST_BOOL(childObjects[0] == pUntouched);
+    EZ_TEST_INT(GetComponentValue(pUntouched), 1);
+
+    for (ezUInt32 i = 0; i < uiNumInstances; ++i)
+    {
+      ezGameObject* pRoot = rootObjects[1 + i];
+      ezGameObject* pChild = childObjects[1 + i * 2];
+      ezGameObject* pGrandChild = childObjects[1 + i * 2 + 1];
+
+      EZ_TEST_STRING(pChild->GetName(), "Child");
+      EZ_TEST_STRING(pGrandChild->GetName(), "GrandChild");
+
+      EZ_TEST_INT(GetComponentValue(pRoot), 200);
+      EZ_TEST_INT(GetComponentValue(pChild), 100);
+      EZ_TEST_INT(GetComponentValue(pGrandChild), 13);
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(World, PrefabInstantiation)
+{
+  ezMemoryStreamStorage prefabData;
+  WritePrefab(prefabData);
+
+  ezMemoryStreamReader reader(&prefabData);
+  ezWorldReader worldReader;
+  EZ_TEST_BOOL(worldReader.ReadWorldDescription(reader).Succeeded());
+
+  EZ_TEST_INT(worldReader.GetRootObjectCount(), 1);
+  EZ_TEST_INT(worldReader.GetChildObjectCount(), 2);
+
+  ezHybridArray<ezTransform, 4> transforms;
+  transforms.PushBack(ezTransform(ezVec3(0, 0, 0)));
+  transforms.PushBack(ezTransform(ezVec3(10, 0, 0), ezQuat::IdentityQuaternion(), ezVec3(0.5f)));
+  transforms.PushBack(ezTransform(ezVec3(0, -20, 5)));
+  transforms.PeekBack().m_qRotation.SetFromAxisAndAngle(ezVec3(0, 0, 1), ezAngle::Degree(-60));
+  transforms.PushBack(ezTransform(ezVec3(1, 2, 3), ezQuat::IdentityQuaternion(), ezVec3(3.0f)));
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "InstantiatePrefabs - CustomRootValue")
+  {
+    ezPrefabInstantiationOptions options;
+    options.m_RandomSeedMode = ezPrefabInstantiationOptions::RandomSeedMode::CustomRootValue;
+    options.m_uiCustomRandomSeedRootValue = 42;
+
+    CompareSingleAndBatchedInstantiation(worldReader, transforms, options, false);
+    CompareSingleAndBatchedInstantiation(worldReader, transforms, options, true);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "InstantiatePrefabs - FixedFromSerialization")
+  {
+    ezPrefabInstantiationOptions options;
+    options.m_RandomSeedMode = ezPrefabInstantiationOptions::RandomSeedMode::FixedFromSerialization;
+
+    CompareSingleAndBatchedInstantiation(worldReader, transforms, options, false);
+    CompareSingleAndBatchedInstantiation(worldReader, transforms, options, true);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "InstantiatePrefabs - DeterministicFromParent")
+  {
+    // without a parent the seeds would be random
+    ezPrefabInstantiationOptions options;
+    options.m_RandomSeedMode = ezPrefabInstantiationOptions::RandomSeedMode::DeterministicFromParent;
+
+    CompareSingleAndBatchedInstantiation(worldReader, transforms, options, true);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Exposed Parameters")
+  {
+    ezPrefabResourceHandle hPrefab = CreatePrefabResource(prefabData);
+
+    {
+      ezResourceLock<ezPrefabResource> pPrefab(hPrefab, ezResourceAcquireMode::BlockTillLoaded);
+      EZ_TEST_BOOL(pPrefab.GetAcquireResult() == ezResourceAcquireResult::Final);
+
+      ezArrayMap<ezHashedString, ezVariant> exposedParamValues;
+      exposedParamValues.Insert(ezMakeHashedString("RootValue"), ezInt32(200));
+      exposedParamValues.Insert(ezMakeHashedString("ChildValue"), ezInt32(100));
+
+      ezWorldDesc worldDesc("Test");
+      ezWorld world(worldDesc);
+      EZ_LOCK(world.GetWriteMarker());
+
+      ezPrefabInstantiationOptions options;
+
+      // single instances
+      {
+        ezGameObject* pUntouched = CreateObjectWithComponent(world, ezGameObjectDesc(), 1);
+        ezDynamicArray<ezGameObject*> rootObjects, childObjects;
+        rootObjects.PushBack(pUntouched);
+        childObjects.PushBack(pUntouched);
+
+        options.m_pCreatedRootObjectsOut = &rootObjects;
+        options.m_pCreatedChildObjectsOut = &childObjects;
+
+        for (const ezTransform& transform : transforms)
+        {
+          pPrefab->InstantiatePrefab(world, transform, options, &exposedParamValues);
+        }
+
+        TestExposedParameters(rootObjects, childObjects, transforms.GetCount(), pUntouched);
+      }
+
+      // batched
+      {
+        ezGameObject* pUntouched = CreateObjectWithComponent(world, ezGameObjectDesc(), 1);
+        ezDynamicArray<ezGameObject*> rootObjects, childObjects;
+        rootObjects.PushBack(pUntouched);
+        childObjects.PushBack(pUntouched);
+
+        options.m_pCreatedRootObjectsOut = &rootObjects;
+        options.m_pCreatedChildObjectsOut = &childObjects;
+
+        pPrefab->InstantiatePrefabs(world, transforms, options, &exposedParamValues);
+
+        TestExposedParameters(rootObjects, childObjects, transforms.GetCount(), pUntouched);
+      }
+    }
+
+    hPrefab.Invalidate();
+    ezResourceManager::FreeAllUnusedResources();
+  }
+}
@@ -1,6 +1,8 @@
 #include <CoreTestPCH.h>
 
 #include <Core/Messages/UpdateLocalBoundsMessage.h>
+#include <Core/World/SpatialSystem_LooseOctree.h>
+#include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Core/World/World.h>
 #include <Foundation/Containers/HashSet.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
@@ -55,197 +57,338 @@ namespace
   }
   EZ_END_COMPONENT_TYPE;
   // clang-format on
-} // namespace
 
-EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
-{
-  ezWorldDesc worldDesc("Test");
-  worldDesc.m_uiRandomNumberGeneratorSeed = 5;
+  void TestSpatialSystem(ezWorldDesc& worldDesc)
+  {
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
 
-  ezWorld world(worldDesc);
-  EZ_LOCK(world.GetWriteMarker());
+    auto& rng = world.GetRandomNumberGenerator();
+    double range = 10000.0;
 
-  auto& rng = world.GetRandomNumberGenerator();
-  double range = 10000.0;
+    ezDynamicArray<ezGameObject*> objects;
+    objects.Reserve(1000);
 
-  ezDynamicArray<ezGameObject*> objects;
-  objects.Reserve(1000);
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      float x = (float)rng.DoubleMinMax(-range, range);
+      float y = (float)rng.DoubleMinMax(-range, range);
+      float z = (float)rng.DoubleMinMax(-range, range);
 
-  for (ezUInt32 i = 0; i < 1000; ++i)
-  {
-    float x = (float)rng.DoubleMinMax(-range, range);
-    float y = (float)rng.DoubleMinMax(-range, range);
-    float z = (float)rng.DoubleMinMax(-range, range);
+      ezGameObjectDesc desc;
+      desc.m_bDynamic = (i >= 500);
+      desc.m_LocalPosition = ezVec3(x, y, z);
 
-    ezGameObjectDesc desc;
-    desc.m_bDynamic = (i >= 500);
-    desc.m_LocalPosition = ezVec3(x, y, z);
+      ezGameObject* pObject = nullptr;
+      world.CreateObject(desc, pObject);
 
-    ezGameObject* pObject = nullptr;
-    world.CreateObject(desc, pObject);
+      objects.PushBack(pObject);
 
-    objects.PushBack(pObject);
+      TestBoundsComponent* pComponent = nullptr;
+      TestBoundsComponent::CreateComponent(pObject, pComponent);
+    }
 
-    TestBoundsComponent* pComponent = nullptr;
-    TestBoundsComponent::CreateComponent(pObject, pComponent);
-  }
+    world.Update();
 
-  world.Update();
+    ezUInt32 uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
 
-  ezUInt32 uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindObjectsInSphere")
+    {
+      ezBoundingSphere testSphere(ezVec3(100.0f, 60.0f, 400.0f), 3000.0f);
 
-  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindObjectsInSphere")
-  {
-    ezBoundingSphere testSphere(ezVec3(100.0f, 60.0f, 400.0f), 3000.0f);
+      ezDynamicArray<ezGameObject*> objectsInSphere;
+      ezHashSet<ezGameObject*> uniqueObjects;
+      world.GetSpatialSystem()->FindObjectsInSphere(testSphere, uiCategoryBitmask, objectsInSphere);
+
+      for (auto pObject : objectsInSphere)
+      {
+        ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
 
-    ezDynamicArray<ezGameObject*> objectsInSphere;
-    ezHashSet<ezGameObject*> uniqueObjects;
-    world.GetSpatialSystem()->FindObjectsInSphere(testSphere, uiCategoryBitmask, objectsInSphere);
+        EZ_TEST_BOOL(testSphere.Overlaps(objSphere));
+        EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+        EZ_TEST_BOOL(pObject->IsStatic());
+      }
 
-    for (auto pObject : objectsInSphere)
-    {
-      ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
+      // Check for missing objects
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        ezBoundingSphere objSphere = it->GetGlobalBounds().GetSphere();
+        if (testSphere.Overlaps(objSphere))
+        {
+          EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains(it));
+        }
+      }
+
+      objectsInSphere.Clear();
+      uniqueObjects.Clear();
+
+      world.GetSpatialSystem()->FindObjectsInSphere(testSphere, uiCategoryBitmask, [&](ezGameObject* pObject) {
+        objectsInSphere.PushBack(pObject);
+        EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
 
-      EZ_TEST_BOOL(testSphere.Overlaps(objSphere));
-      EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
-      EZ_TEST_BOOL(pObject->IsStatic());
+        return ezVisitorExecution::Continue;
+      });
+
+      for (auto pObject : objectsInSphere)
+      {
+        ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
+
+        EZ_TEST_BOOL(testSphere.Overlaps(objSphere));
+        EZ_TEST_BOOL(pObject->IsStatic());
+      }
+
+      // Check for missing objects
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        ezBoundingSphere objSphere = it->GetGlobalBounds().GetSphere();
+        if (testSphere.Overlaps(objSphere))
+        {
+          EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains(it));
+        }
+      }
     }
 
-    // Check for missing objects
-    for (auto it = world.GetObjects(); it.IsValid(); ++it)
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindObjectsInBox")
     {
-      ezBoundingSphere objSphere = it->GetGlobalBounds().GetSphere();
-      if (testSphere.Overlaps(objSphere))
+      ezBoundingBox testBox;
+      testBox.SetCenterAndHalfExtents(ezVec3(100.0f, 60.0f, 400.0f), ezVec3(3000.0f));
+
+      ezDynamicArray<ezGameObject*> objectsInBox;
+      ezHashSet<ezGameObject*> uniqueObjects;
+      world.GetSpatialSystem()->FindObjectsInBox(testBox, uiCategoryBitmask, objectsInBox);
+
+      for (auto pObject : objectsInBox)
       {
-        EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains(it));
+        ezBoundingBox objBox = pObject->GetGlobalBounds().GetBox();
+
+        EZ_TEST_BOOL(testBox.Overlaps(objBox));
+        EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+        EZ_TEST_BOOL(pObject->IsStatic());
       }
-    }
 
-    objectsInSphere.Clear();
-    uniqueObjects.Clear();
+      // Check for missing objects
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        ezBoundingBox objBox = it->GetGlobalBounds().GetBox();
+        if (testBox.Overlaps(objBox))
+        {
+          EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains(it));
+        }
+      }
 
-    world.GetSpatialSystem()->FindObjectsInSphere(testSphere, uiCategoryBitmask, [&](ezGameObject* pObject) {
-      objectsInSphere.PushBack(pObject);
-      EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+      objectsInBox.Clear();
+      uniqueObjects.Clear();
 
-      return ezVisitorExecution::Continue;
-    });
+      world.GetSpatialSystem()->FindObjectsInBox(testBox, uiCategoryBitmask, [&](ezGameObject* pObject) {
+        objectsInBox.PushBack(pObject);
+        EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
 
-    for (auto pObject : objectsInSphere)
-    {
-      ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
+        return ezVisitorExecution::Continue;
+      });
+
+      for (auto pObject : objectsInBox)
+      {
+        ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
+
+        EZ_TEST_BOOL(testBox.Overlaps(objSphere));
+        EZ_TEST_BOOL(pObject->IsStatic());
+      }
 
-      EZ_TEST_BOOL(testSphere.Overlaps(objSphere));
-      EZ_TEST_BOOL(pObject->IsStatic());
+      // Check for missing objects
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        ezBoundingBox objBox = it->GetGlobalBounds().GetBox();
+        if (testBox.Overlaps(objBox))
+        {
+          EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains(it));
+        }
+      }
     }
 
-    // Check for missing objects
-    for (auto it = world.GetObjects(); it.IsValid(); ++it)
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindVisibleObjects")
     {
-      ezBoundingSphere objSphere = it->GetGlobalBounds().GetSphere();
-      if (testSphere.Overlaps(objSphere))
+      ezFrustum testFrustum;
+      testFrustum.SetFrustum(ezVec3(100.0f, 60.0f, 400.0f), ezVec3(1.0f, 0.0f, 0.0f), ezVec3(0.0f, 0.0f, 1.0f), ezAngle::Degree(90.0f),
+        ezAngle::Degree(60.0f), 0.1f, 5000.0f);
+
+      ezDynamicArray<const ezGameObject*> visibleObjects;
+      ezHashSet<const ezGameObject*> uniqueObjects;
+      world.GetSpatialSystem()->FindVisibleObjects(testFrustum, uiCategoryBitmask, visibleObjects);
+
+      for (auto pObject : visibleObjects)
       {
-        EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains(it));
+        ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
+
+        EZ_TEST_BOOL(testFrustum.GetObjectPosition(objSphere) != ezVolumePosition::Outside);
+        EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+        EZ_TEST_BOOL(pObject->IsStatic());
+      }
+
+      // Check for missing objects
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        ezBoundingSphere objSphere = it->GetGlobalBounds().GetSphere();
+        if (testFrustum.GetObjectPosition(objSphere) != ezVolumePosition::Outside)
+        {
+          EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains(it));
+        }
       }
     }
-  }
 
-  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindObjectsInBox")
-  {
-    ezBoundingBox testBox;
-    testBox.SetCenterAndHalfExtents(ezVec3(100.0f, 60.0f, 400.0f), ezVec3(3000.0f));
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindVisibleObjects Batch")
+    {
+      ezFrustum testFrustums[3];
+      for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(testFrustums); ++i)
+      {
+        ezVec3 vDir(ezMath::Cos(ezAngle::Degree(i * 120.0f)), ezMath::Sin(ezAngle::Degree(i * 120.0f)), 0.0f);
+        testFrustums[i].SetFrustum(ezVec3(100.0f, 60.0f, 400.0f), vDir, ezVec3(0.0f, 0.0f, 1.0f), ezAngle::Degree(90.0f), ezAngle::Degree(60.0f),
+          0.1f, 5000.0f + i * 1000.0f);
+      }
 
-    ezDynamicArray<ezGameObject*> objectsInBox;
-    ezHashSet<ezGameObject*> uniqueObjects;
-    world.GetSpatialSystem()->FindObjectsInBox(testBox, uiCategoryBitmask, objectsInBox);
+      ezDynamicArray<const ezGameObject*> batchObjects[EZ_ARRAY_SIZE(testFrustums)];
+      world.GetSpatialSystem()->FindVisibleObjects(ezMakeArrayPtr(testFrustums), uiCategoryBitmask, ezMakeArrayPtr(batchObjects));
 
-    for (auto pObject : objectsInBox)
-    {
-      ezBoundingBox objBox = pObject->GetGlobalBounds().GetBox();
+      for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(testFrustums); ++i)
+      {
+        ezDynamicArray<const ezGameObject*> visibleObjects;
+        world.GetSpatialSystem()->FindVisibleObjects(testFrustums[i], uiCategoryBitmask, visibleObjects);
+
+        EZ_TEST_INT(batchObjects[i].GetCount(), visibleObjects.GetCount());
 
-      EZ_TEST_BOOL(testBox.Overlaps(objBox));
-      EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
-      EZ_TEST_BOOL(pObject->IsStatic());
+        ezHashSet<const ezGameObject*> uniqueObjects;
+        for (auto pObject : visibleObjects)
+        {
+          uniqueObjects.Insert(pObject);
+        }
+
+        for (auto pObject : batchObjects[i])
+        {
+          EZ_TEST_BOOL(uniqueObjects.Contains(pObject));
+        }
+      }
     }
 
-    // Check for missing objects
-    for (auto it = world.GetObjects(); it.IsValid(); ++it)
+    if (auto pGrid = ezDynamicCast<ezSpatialSystem_RegularGrid*>(world.GetSpatialSystem()))
     {
-      ezBoundingBox objBox = it->GetGlobalBounds().GetBox();
-      if (testBox.Overlaps(objBox))
+      EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindVisibleObjects Parallel")
       {
-        EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains(it));
+        ezFrustum testFrustum;
+        testFrustum.SetFrustum(ezVec3(100.0f, 60.0f, 400.0f), ezVec3(1.0f, 0.0f, 0.0f), ezVec3(0.0f, 0.0f, 1.0f), ezAngle::Degree(90.0f),
+          ezAngle::Degree(60.0f), 0.1f, 10000.0f);
+
+        ezDynamicArray<const ezGameObject*> serialObjects;
+        pGrid->SetParallelCullingThreshold(ezInvalidIndex);
+        pGrid->FindVisibleObjects(testFrustum, uiCategoryBitmask, serialObjects);
+
+        // the parallel path has to return the exact same result
+        ezDynamicArray<const ezGameObject*> parallelObjects;
+        pGrid->SetParallelCullingThreshold(0);
+        pGrid->FindVisibleObjects(testFrustum, uiCategoryBitmask, parallelObjects);
+
+        EZ_TEST_BOOL(serialObjects == parallelObjects);
+
+        pGrid->SetParallelCullingThreshold(8192);
       }
     }
 
-    objectsInBox.Clear();
-    uniqueObjects.Clear();
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Moving Objects")
+    {
+      // move all dynamic objects, some only a bit and some far away, and check that they are found at their new position
+      for (ezUInt32 i = 500; i < objects.GetCount(); ++i)
+      {
+        ezGameObject* pObject = objects[i];
+
+        float fOffset = (i % 2 == 0) ? 10.0f : 5000.0f;
+        pObject->SetLocalPosition(pObject->GetLocalPosition() + ezVec3(fOffset, -fOffset, 0.0f));
+      }
+
+      world.Update();
 
-    world.GetSpatialSystem()->FindObjectsInBox(testBox, uiCategoryBitmask, [&](ezGameObject* pObject) {
-      objectsInBox.PushBack(pObject);
-      EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+      ezUInt32 uiDynamicCategoryBitmask = ezDefaultSpatialDataCategories::RenderDynamic.GetBitmask();
 
-      return ezVisitorExecution::Continue;
-    });
+      ezBoundingSphere testSphere(ezVec3(100.0f, 60.0f, 400.0f), 5000.0f);
 
-    for (auto pObject : objectsInBox)
-    {
-      ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
+      ezDynamicArray<ezGameObject*> objectsInSphere;
+      ezHashSet<ezGameObject*> uniqueObjects;
+      world.GetSpatialSystem()->FindObjectsInSphere(testSphere, uiDynamicCategoryBitmask, objectsInSphere);
 
-      EZ_TEST_BOOL(testBox.Overlaps(objSphere));
-      EZ_TEST_BOOL(pObject->IsStatic());
+      for (auto pObject : objectsInSphere)
+      {
+        ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
+
+        EZ_TEST_BOOL(testSphere.Overlaps(objSphere));
+        EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+        EZ_TEST_BOOL(pObject->IsDynamic());
+      }
+
+      // Check for missing objects
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        ezBoundingSphere objSphere = it->GetGlobalBounds().GetSphere();
+        if (testSphere.Overlaps(objSphere))
+        {
+          EZ_TEST_BOOL(it->IsStatic() || uniqueObjects.Contains(it));
+        }
+      }
     }
 
-    // Check for missing objects
-    for (auto it = world.GetObjects(); it.IsValid(); ++it)
+    if (false)
     {
-      ezBoundingBox objBox = it->GetGlobalBounds().GetBox();
-      if (testBox.Overlaps(objBox))
+      ezStringBuilder outputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
+      EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(outputPath.GetData(), "test", "output", ezFileSystem::AllowWrites) == EZ_SUCCESS);
+
+      ezFileWriter fileWriter;
+      if (fileWriter.Open(":output/profiling.json") == EZ_SUCCESS)
       {
-        EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains(it));
+        ezProfilingSystem::ProfilingData profilingData;
+        ezProfilingSystem::Capture(profilingData);
+        profilingData.Write(fileWriter).IgnoreResult();
+        ezLog::Info("Profiling capture saved to '{0}'.", fileWriter.GetFilePathAbsolute().GetData());
       }
     }
-  }
 
-  if (false)
-  {
-    ezStringBuilder outputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
-    EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(outputPath.GetData(), "test", "output", ezFileSystem::AllowWrites) == EZ_SUCCESS);
-
-    ezFileWriter fileWriter;
-    if (fileWriter.Open(":output/profiling.json") == EZ_SUCCESS)
+    // Test multiple categories for spatial data
+    for (ezUInt32 i = 0; i < objects.GetCount(); ++i)
     {
-      ezProfilingSystem::ProfilingData profilingData;
-      ezProfilingSystem::Capture(profilingData);
-      profilingData.Write(fileWriter).IgnoreResult();
-      ezLog::Info("Profiling capture saved to '{0}'.", fileWriter.GetFilePathAbsolute().GetData());
+      ezGameObject* pObject = objects[i];
+
+      TestBoundsComponent* pComponent = nullptr;
+      TestBoundsComponent::CreateComponent(pObject, pComponent);
+      pComponent->m_SpecialCategory = s_SpecialTestCategory;
     }
-  }
 
-  // Test multiple categories for spatial data
-  for (ezUInt32 i = 0; i < objects.GetCount(); ++i)
-  {
-    ezGameObject* pObject = objects[i];
+    world.Update();
 
-    TestBoundsComponent* pComponent = nullptr;
-    TestBoundsComponent::CreateComponent(pObject, pComponent);
-    pComponent->m_SpecialCategory = s_SpecialTestCategory;
-  }
+    ezDynamicArray<ezGameObjectHandle> allObjects;
+    allObjects.Reserve(world.GetObjectCount());
 
-  world.Update();
+    for (auto it = world.GetObjects(); it.IsValid(); ++it)
+    {
+      allObjects.PushBack(it->GetHandle());
+    }
 
-  ezDynamicArray<ezGameObjectHandle> allObjects;
-  allObjects.Reserve(world.GetObjectCount());
+    for (ezUInt32 i = allObjects.GetCount(); i-- > 0;)
+    {
+      world.DeleteObjectNow(allObjects[i]);
+    }
 
-  for (auto it = world.GetObjects(); it.IsValid(); ++it)
-  {
-    allObjects.PushBack(it->GetHandle());
+    world.Update();
   }
+} // namespace
 
-  for (ezUInt32 i = allObjects.GetCount(); i-- > 0;)
-  {
-    world.DeleteObjectNow(allObjects[i]);
-  }
+EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
+{
+  ezWorldDesc worldDesc("Test");
+  worldDesc.m_uiRandomNumberGeneratorSeed = 5;
+
+  TestSpatialSystem(worldDesc);
+}
+
+EZ_CREATE_SIMPLE_TEST(World, SpatialSystem_LooseOctree)
+{
+  ezWorldDesc worldDesc("Test");
+  worldDesc.m_uiRandomNumberGeneratorSeed = 5;
+  worldDesc.m_pSpatialSystem = EZ_NEW(ezFoundation::GetAlignedAllocator(), ezSpatialSystem_LooseOctree);
 
-  world.Update();
+  TestSpatialSystem(worldDesc);
 }
@@ -1,6 +1,13 @@
 #include <CoreTestPCH.h>
 
+#include <Core/World/SpatialSystem_LooseOctree.h>
+#include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Core/World/World.h>
+#include <Core/WorldSerializer/WorldReader.h>
+#include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/SimdMath/SimdConversion.h>
 #include <Foundation/Time/Clock.h>
 #include <Foundation/Time/Stopwatch.h>
 
@@ -115,6 +122,211 @@ namespace
     }
   }
 
+  void CreateCullingObjects(ezSpatialSystem& spatialSystem, ezUInt32 uiNumObjects, float fLargeObjectSize)
+  {
+    ezRandom rng;
+    rng.Initialize(42);
+
+    ezUInt32 uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
+
+    // a flat level with mostly small objects and every 50th object being large
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      float x = (float)rng.DoubleMinMax(-10000.0, 10000.0);
+      float y = (float)rng.DoubleMinMax(-10000.0, 10000.0);
+      float z = (float)rng.DoubleMinMax(-200.0, 200.0);
+      float fHalfExtent = (float)rng.DoubleMinMax(0.5, (i % 50 == 0) ? fLargeObjectSize : 5.0);
+
+      ezBoundingBox box;
+      box.SetCenterAndHalfExtents(ezVec3(x, y, z), ezVec3(fHalfExtent));
+
+      spatialSystem.CreateSpatialData(ezSimdConversion::ToBBoxSphere(ezBoundingBoxSphere(box)), nullptr, uiCategoryBitmask);
+    }
+  }
+
+  void MeasureCulling(const char* szName, ezSpatialSystem& spatialSystem, ezUInt32 uiNumObjects, float fLargeObjectSize)
+  {
+    CreateCullingObjects(spatialSystem, uiNumObjects, fLargeObjectSize);
+
+    ezUInt32 uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
+
+    ezFrustum frustum;
+    ezDynamicArray<const ezGameObject*> visibleObjects;
+    visibleObjects.Reserve(uiNumObjects);
+
+    const ezUInt32 uiNumFrames = 100;
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < uiNumFrames; ++i)
+    {
+      // camera turning around in the middle of the level
+      ezVec3 vDir(ezMath::Cos(ezAngle::Degree(i * 3.6f)), ezMath::Sin(ezAngle::Degree(i * 3.6f)), 0.0f);
+      frustum.SetFrustum(
+        ezVec3(0.0f, 0.0f, 50.0f), vDir, ezVec3(0.0f, 0.0f, 1.0f), ezAngle::Degree(90.0f), ezAngle::Degree(60.0f), 0.1f, 5000.0f);
+
+      visibleObjects.Clear();
+      spatialSystem.FindVisibleObjects(frustum, uiCategoryBitmask, visibleObjects);
+    }
+
+    const ezTime tDiff = sw.Checkpoint();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%s: Culling %u objects (max size %.0f): %.3fms per frame, %u visible", szName,
+      uiNumObjects, fLargeObjectSize, tDiff.GetMilliseconds() / uiNumFrames, visibleObjects.GetCount());
+  }
+
+  void MeasureMultiFrustumCulling(ezSpatialSystem_RegularGrid& grid, ezUInt32 uiNumObjects)
+  {
+    CreateCullingObjects(grid, uiNumObjects, 50.0f);
+
+    ezUInt32 uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
+
+    // six views around the same position, like the faces of a reflection probe
+    ezFrustum frustums[6];
+    ezDynamicArray<const ezGameObject*> visibleObjects[EZ_ARRAY_SIZE(frustums)];
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(frustums); ++i)
+    {
+      ezVec3 vDir(ezMath::Cos(ezAngle::Degree(i * 60.0f)), ezMath::Sin(ezAngle::Degree(i * 60.0f)), 0.0f);
+      frustums[i].SetFrustum(
+        ezVec3(0.0f, 0.0f, 50.0f), vDir, ezVec3(0.0f, 0.0f, 1.0f), ezAngle::Degree(90.0f), ezAngle::Degree(90.0f), 0.1f, 3000.0f);
+    }
+
+    const ezUInt32 uiNumFrames = 50;
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < uiNumFrames; ++i)
+    {
+      for (ezUInt32 j = 0; j < EZ_ARRAY_SIZE(frustums); ++j)
+      {
+        visibleObjects[j].Clear();
+        grid.FindVisibleObjects(frustums[j], uiCategoryBitmask, visibleObjects[j]);
+      }
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Culling %u objects in 6 individual queries: %.3fms per frame", uiNumObjects,
+      sw.Checkpoint().GetMilliseconds() / uiNumFrames);
+
+    for (ezUInt32 i = 0; i < uiNumFrames; ++i)
+    {
+      for (auto& objects : visibleObjects)
+      {
+        objects.Clear();
+      }
+
+      grid.FindVisibleObjects(ezMakeArrayPtr(frustums), uiCategoryBitmask, ezMakeArrayPtr(visibleObjects));
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Culling %u objects in one batched query: %.3fms per frame", uiNumObjects,
+      sw.Checkpoint().GetMilliseconds() / uiNumFrames);
+
+    grid.SetParallelCullingThreshold(ezInvalidIndex);
+
+    for (ezUInt32 i = 0; i < uiNumFrames; ++i)
+    {
+      for (auto& objects : visibleObjects)
+      {
+        objects.Clear();
+      }
+
+      grid.FindVisibleObjects(ezMakeArrayPtr(frustums), uiCategoryBitmask, ezMakeArrayPtr(visibleObjects));
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Culling %u objects in one batched query (single-threaded): %.3fms per frame",
+      uiNumObjects, sw.Checkpoint().GetMilliseconds() / uiNumFrames);
+  }
+
+  void MeasureInstantiationTime(const ezMemoryStreamStorage& worldData, ezUInt32 uiNumObjects, ezUInt32 uiParallelThreshold, bool bAsPrefab)
+  {
+    ezWorldDesc worldDesc("Test");
+    ezWorld world(worldDesc);
+
+    ezStopwatch sw;
+
+    ezMemoryStreamReader reader(&worldData);
+    ezWorldReader worldReader;
+    worldReader.SetParallelPreparationThreshold(uiParallelThreshold);
+    EZ_TEST_BOOL(worldReader.ReadWorldDescription(reader).Succeeded());
+
+    const ezTime tRead = sw.Checkpoint();
+
+    if (bAsPrefab)
+    {
+      ezPrefabInstantiationOptions options;
+      options.m_RandomSeedMode = ezPrefabInstantiationOptions::RandomSeedMode::CustomRootValue;
+      worldReader.InstantiatePrefab(world, ezTransform(ezVec3(100.0f, 0.0f, 0.0f)), options);
+    }
+    else
+    {
+      worldReader.InstantiateWorld(world);
+    }
+
+    const ezTime tInstantiate = sw.Checkpoint();
+
+    EZ_LOCK(world.GetReadMarker());
+    EZ_TEST_INT(world.GetObjectCount(), uiNumObjects);
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Reading %u objects: %.2fms, instantiating as %s: %.2fms (%s)", uiNumObjects,
+      tRead.GetMilliseconds(), bAsPrefab ? "prefab" : "world", tInstantiate.GetMilliseconds(),
+      uiParallelThreshold == ezInvalidIndex ? "single-threaded" : "multi-threaded");
+  }
+
+  void MeasurePrefabSpawnTime(const ezMemoryStreamStorage& prefabData, ezUInt32 uiNumInstances)
+  {
+    ezMemoryStreamReader reader(&prefabData);
+    ezWorldReader worldReader;
+    EZ_TEST_BOOL(worldReader.ReadWorldDescription(reader).Succeeded());
+
+    const ezUInt32 uiObjectsPerInstance = worldReader.GetRootObjectCount() + worldReader.GetChildObjectCount();
+
+    ezDynamicArray<ezTransform> transforms;
+    for (ezUInt32 i = 0; i < uiNumInstances; ++i)
+    {
+      transforms.PushBack(ezTransform(ezVec3((float)(i % 100), (float)(i / 100), 0.0f)));
+    }
+
+    ezPrefabInstantiationOptions options;
+    options.m_RandomSeedMode = ezPrefabInstantiationOptions::RandomSeedMode::CustomRootValue;
+
+    ezTime tSingle;
+    ezTime tBatched;
+
+    {
+      ezWorldDesc worldDesc("Test");
+      ezWorld world(worldDesc);
+
+      ezStopwatch sw;
+
+      for (const ezTransform& transform : transforms)
+      {
+        worldReader.InstantiatePrefab(world, transform, options);
+      }
+
+      tSingle = sw.Checkpoint();
+
+      EZ_LOCK(world.GetReadMarker());
+      EZ_TEST_INT(world.GetObjectCount(), uiNumInstances * uiObjectsPerInstance);
+    }
+
+    {
+      ezWorldDesc worldDesc("Test");
+      ezWorld world(worldDesc);
+
+      ezStopwatch sw;
+
+      worldReader.InstantiatePrefabs(world, transforms, options);
+
+      tBatched = sw.Checkpoint();
+
+      EZ_LOCK(world.GetReadMarker());
+      EZ_TEST_INT(world.GetObjectCount(), uiNumInstances * uiObjectsPerInstance);
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Spawning a prefab with %u objects %u times: InstantiatePrefab %.2fms, InstantiatePrefabs %.2fms",
+      uiObjectsPerInstance, uiNumInstances, tSingle.GetMilliseconds(), tBatched.GetMilliseconds());
+  }
+
 } // namespace
 
 
@@ -250,7 +462,7 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
   EZ_TEST_BLOCK(EnableInRelease, "MT Update 250,000 dynamic objects")
   {
     ezWorldDesc worldDesc("Test");
-    worldDesc.m_bAutoCreateSpatialSystem = false; // allows multi-threaded update
+    worldDesc.m_bAutoCreateSpatialSystem = false; // no spatial data updates
     ezWorld world(worldDesc);
     MeasureCreationTime(true, 200, 5, 6, 0, &world);
 
@@ -271,7 +483,7 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
   EZ_TEST_BLOCK(EnableInRelease, "MT Update 1,000,000 dynamic objects")
   {
     ezWorldDesc worldDesc("Test");
-    worldDesc.m_bAutoCreateSpatialSystem = false; // allows multi-threaded update
+    worldDesc.m_bAutoCreateSpatialSystem = false; // no spatial data updates
     ezWorld world(worldDesc);
     MeasureCreationTime(true, 100, 1, 3, 1, &world);
 
@@ -289,3 +501,99 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
     }
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(World, Profile_Culling)
+{
+  EZ_TEST_BLOCK(EnableInRelease, "Small objects")
+  {
+    ezSpatialSystem_RegularGrid grid;
+    MeasureCulling("Grid", grid, 200000, 5.0f);
+
+    ezSpatialSystem_LooseOctree octree;
+    MeasureCulling("Octree", octree, 200000, 5.0f);
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "Mixed object sizes")
+  {
+    ezSpatialSystem_RegularGrid grid;
+    MeasureCulling("Grid", grid, 200000, 500.0f);
+
+    ezSpatialSystem_LooseOctree octree;
+    MeasureCulling("Octree", octree, 200000, 500.0f);
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "Multiple frustums")
+  {
+    ezSpatialSystem_RegularGrid grid;
+    MeasureMultiFrustumCulling(grid, 200000);
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(World, Profile_Instantiation)
+{
+  EZ_TEST_BLOCK(EnableInRelease, "Instantiate 111,110 objects with components")
+  {
+    ezMemoryStreamStorage worldData;
+    ezUInt32 uiNumObjects = 0;
+
+    {
+      ezWorldDesc worldDesc("Source");
+      ezWorld world(worldDesc);
+
+      EZ_LOCK(world.GetWriteMarker());
+      AddObjectsToWorld(world, true, 10, 1, 5, 5);
+      uiNumObjects = world.GetObjectCount();
+
+      ezMemoryStreamWriter writer(&worldData);
+      ezWorldWriter worldWriter;
+      worldWriter.WriteWorld(writer, world);
+    }
+
+    for (ezUInt32 uiParallelThreshold : {ezInvalidIndex, 4096u})
+    {
+      MeasureInstantiationTime(worldData, uiNumObjects, uiParallelThreshold, false);
+      MeasureInstantiationTime(worldData, uiNumObjects, uiParallelThreshold, true);
+    }
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(World, Profile_PrefabSpawning)
+{
+  EZ_TEST_BLOCK(EnableInRelease, "Spawn small prefabs")
+  {
+    for (ezUInt32 uiNumChildren : {0u, 4u, 16u})
+    {
+      ezMemoryStreamStorage prefabData;
+
+      {
+        ezWorldDesc worldDesc("Source");
+        ezWorld world(worldDesc);
+
+        EZ_LOCK(world.GetWriteMarker());
+        ezTestComponentManager* pMan = world.GetOrCreateComponentManager<ezTestComponentManager>();
+        ezTestComponent* pComponent = nullptr;
+
+        // one root object with a number of children, all with a component, like a projectile or a piece of debris
+        ezGameObjectDesc gd;
+        gd.m_bDynamic = true;
+
+        ezGameObject* pObject = nullptr;
+        gd.m_hParent = world.CreateObject(gd, pObject);
+        pMan->CreateComponent(pObject, pComponent);
+
+        for (ezUInt32 i = 0; i < uiNumChildren; ++i)
+        {
+          gd.m_LocalPosition.Set((float)i, 0.0f, 0.0f);
+          world.CreateObject(gd, pObject);
+          pMan->CreateComponent(pObject, pComponent);
+        }
+
+        ezMemoryStreamWriter writer(&prefabData);
+        ezWorldWriter worldWriter;
+        worldWriter.WriteWorld(writer, world);
+      }
+
+      MeasurePrefabSpawnTime(prefabData, 10000);
+    }
+  }
+}
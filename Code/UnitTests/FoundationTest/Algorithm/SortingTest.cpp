@@ -11,6 +11,43 @@ namespace
     // Comparision via operator. Sorting algorithm should prefer Less operator
     bool operator()(ezInt32 a, ezInt32 b) const { return a < b; }
   };
+
+  struct RadixSortElement
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiKey;
+    ezUInt32 m_uiOriginalIndex;
+  };
+
+  void TestRadixSort(ezUInt32 uiNumElements, ezUInt64 uiKeyMask, bool bParallel)
+  {
+    ezDynamicArray<RadixSortElement> elements;
+    elements.SetCountUninitialized(uiNumElements);
+    for (ezUInt32 i = 0; i < uiNumElements; ++i)
+    {
+      const ezUInt64 uiRandom = (static_cast<ezUInt64>(rand()) << 48) ^ (static_cast<ezUInt64>(rand()) << 24) ^ static_cast<ezUInt64>(rand());
+      elements[i].m_uiKey = uiRandom & uiKeyMask;
+      elements[i].m_uiOriginalIndex = i;
+    }
+
+    ezDynamicArray<RadixSortElement> temp;
+    temp.SetCountUninitialized(uiNumElements);
+
+    ezSorting::RadixSort(elements.GetArrayPtr(), temp.GetArrayPtr(), [](const RadixSortElement& e) { return e.m_uiKey; }, bParallel);
+
+    bool bSorted = true;
+    for (ezUInt32 i = 1; i < uiNumElements; ++i)
+    {
+      const RadixSortElement& prev = elements[i - 1];
+      const RadixSortElement& cur = elements[i];
+
+      // equal keys must keep their original order
+      bSorted &= prev.m_uiKey < cur.m_uiKey || (prev.m_uiKey == cur.m_uiKey && prev.m_uiOriginalIndex < cur.m_uiOriginalIndex);
+    }
+
+    EZ_TEST_BOOL_MSG(bSorted, "RadixSort failed for %u elements, parallel: %s", uiNumElements, bParallel ? "yes" : "no");
+  }
 } // namespace
 
 EZ_CREATE_SIMPLE_TEST(Algorithm, Sorting)
@@ -52,4 +89,33 @@ EZ_CREATE_SIMPLE_TEST(Algorithm, Sorting)
       EZ_TEST_BOOL(a2[i - 1] >= a2[i]);
     }
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "RadixSort")
+  {
+    ezDynamicArray<ezInt32> a2 = a1;
+    ezDynamicArray<ezInt32> temp;
+    temp.SetCountUninitialized(a2.GetCount());
+
+    ezSorting::RadixSort(a2.GetArrayPtr(), temp.GetArrayPtr(), [](ezInt32 a) { return static_cast<ezUInt64>(a); });
+
+    for (ezUInt32 i = 1; i < a2.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(a2[i - 1] <= a2[i]);
+    }
+
+    // empty and single element arrays
+    ezSorting::RadixSort(a2.GetArrayPtr().GetSubArray(0, 0), temp.GetArrayPtr(), [](ezInt32 a) { return static_cast<ezUInt64>(a); });
+    ezSorting::RadixSort(a2.GetArrayPtr().GetSubArray(0, 1), temp.GetArrayPtr(), [](ezInt32 a) { return static_cast<ezUInt64>(a); });
+
+    for (bool bParallel : {false, true})
+    {
+      TestRadixSort(17, 0xFFFFFFFFFFFFFFFFull, bParallel);
+      TestRadixSort(5000, 0xFFFFFFFFFFFFFFFFull, bParallel);
+
+      // many duplicates and keys that only use some digits, which skips passes
+      TestRadixSort(5000, 0xF0000F00ull, bParallel);
+      TestRadixSort(100000, 0xFF000000000000FFull, bParallel);
+      TestRadixSort(100000, 0xFFFFFFFFFFFFFFFFull, bParallel);
+    }
+  }
 }
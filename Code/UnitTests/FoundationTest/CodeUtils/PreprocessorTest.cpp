@@ -266,3 +266,42 @@ EZ_CREATE_SIMPLE_TEST(CodeUtils, Preprocessor)
 
   ezFileSystem::RemoveDataDirectoryGroup("PreprocessorTest");
 }
+
+EZ_CREATE_SIMPLE_TEST(CodeUtils, TokenizedFileCache)
+{
+  ezTokenizedFileCache cache;
+
+  const char* szContentA = "int a;";
+  const char* szContentB = "float b;";
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Tokenize")
+  {
+    EZ_TEST_BOOL(!cache.Lookup("File.txt").IsValid());
+
+    const ezTokenizer* pTokens = cache.Tokenize("File.txt", ezMakeArrayPtr((const ezUInt8*)szContentA, 6), ezTimestamp(), ezLog::GetThreadLocalLogSystem());
+
+    EZ_TEST_BOOL(pTokens != nullptr);
+    EZ_TEST_BOOL(cache.Lookup("File.txt").IsValid());
+    EZ_TEST_BOOL(&cache.Lookup("File.txt").Value().m_Tokens == pTokens);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Tokenize Cached File")
+  {
+    const ezTokenizer* pTokens = &cache.Lookup("File.txt").Value().m_Tokens;
+    const ezUInt32 uiNumTokens = pTokens->GetTokens().GetCount();
+
+    // a file that is already cached (e.g. by another thread) keeps its tokens
+    EZ_TEST_BOOL(cache.Tokenize("File.txt", ezMakeArrayPtr((const ezUInt8*)szContentB, 8), ezTimestamp(), ezLog::GetThreadLocalLogSystem()) == pTokens);
+    EZ_TEST_INT(pTokens->GetTokens().GetCount(), uiNumTokens);
+    EZ_TEST_BOOL(pTokens->GetTokens()[0].m_DataView.IsEqual("int"));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Remove")
+  {
+    cache.Remove("File.txt");
+    EZ_TEST_BOOL(!cache.Lookup("File.txt").IsValid());
+
+    const ezTokenizer* pTokens = cache.Tokenize("File.txt", ezMakeArrayPtr((const ezUInt8*)szContentB, 8), ezTimestamp(), ezLog::GetThreadLocalLogSystem());
+    EZ_TEST_BOOL(pTokens->GetTokens()[0].m_DataView.IsEqual("float"));
+  }
+}
@@ -1,6 +1,7 @@
 #include <FoundationTestPCH.h>
 
 #include <Foundation/Communication/MessageQueue.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 namespace
 {
@@ -27,6 +28,7 @@ namespace
   };
 
   typedef ezMessageQueue<MetaData> TestMessageQueue;
+  typedef ezShardedMessageQueue<MetaData> TestShardedMessageQueue;
 
   EZ_IMPLEMENT_MESSAGE_TYPE(TestMessage);
   EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(TestMessage, 1, ezRTTIDefaultAllocator<TestMessage>)
@@ -106,4 +108,52 @@ EZ_CREATE_SIMPLE_TEST(Communication, MessageQueue)
       EZ_DEFAULT_DELETE(pMsg);
     }
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Sharded Enqueue")
+  {
+    const ezUInt32 uiNumProducers = 8;
+    const ezUInt32 uiMessagesPerProducer = 1000;
+
+    TestShardedMessageQueue sq;
+
+    ezDynamicArray<TestMessage> messages;
+    messages.SetCount(uiNumProducers * uiMessagesPerProducer);
+
+    ezTaskSystem::ParallelForIndexed(0, uiNumProducers, [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 uiProducer = uiStartIndex; uiProducer < uiEndIndex; ++uiProducer)
+      {
+        for (ezUInt32 i = 0; i < uiMessagesPerProducer; ++i)
+        {
+          const ezUInt32 uiIndex = uiProducer * uiMessagesPerProducer + i;
+          messages[uiIndex].x = uiIndex;
+
+          MetaData md;
+          md.receiver = uiIndex;
+
+          sq.Enqueue(&messages[uiIndex], md);
+        }
+      }
+    });
+
+    // entries only become visible once the shards are merged
+    EZ_TEST_BOOL(sq.IsEmpty());
+
+    sq.Sort([](const TestShardedMessageQueue::Entry& a, const TestShardedMessageQueue::Entry& b) { return a.m_MetaData.receiver < b.m_MetaData.receiver; });
+
+    EZ_TEST_INT(sq.GetCount(), uiNumProducers * uiMessagesPerProducer);
+
+    for (ezUInt32 i = 0; i < sq.GetCount(); ++i)
+    {
+      EZ_TEST_INT(sq[i].m_MetaData.receiver, i);
+      EZ_TEST_BOOL(sq[i].m_pMessage == &messages[i]);
+    }
+
+    MetaData md;
+    md.receiver = 0;
+    sq.Enqueue(&messages[0], md);
+
+    sq.Clear();
+    sq.MergeShards();
+    EZ_TEST_BOOL(sq.IsEmpty());
+  }
 }
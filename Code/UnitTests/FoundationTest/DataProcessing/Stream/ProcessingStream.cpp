@@ -6,6 +6,7 @@
 #include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamProcessor.h>
 #include <Foundation/Reflection/Reflection.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
 
 EZ_CREATE_SIMPLE_TEST_GROUP(DataProcessing);
 
@@ -52,6 +53,44 @@ protected:
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(AddOneStreamProcessor, 1, ezRTTIDefaultAllocator<AddOneStreamProcessor>)
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 
+// SIMD add processor
+
+class AddOneSimdStreamProcessor : public ezProcessingStreamProcessor
+{
+  EZ_ADD_DYNAMIC_REFLECTION(AddOneSimdStreamProcessor, ezProcessingStreamProcessor);
+
+public:
+  void SetStreamName(ezHashedString StreamName) { m_StreamName = StreamName; }
+
+protected:
+  virtual ezResult UpdateStreamBindings() override
+  {
+    m_pStream = m_pStreamGroup->GetStreamByName(m_StreamName);
+
+    return m_pStream ? EZ_SUCCESS : EZ_FAILURE;
+  }
+
+  virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override {}
+
+  virtual void Process(ezUInt64 uiNumElements) override
+  {
+    ezSimdVec4f* pData = GetSimdData(m_pStream);
+
+    const ezUInt64 uiNumSimdElements = ezProcessingStream::GetNumSimdBatches(uiNumElements) * ezProcessingStream::SimdBatchSize;
+
+    for (ezUInt64 i = 0; i < uiNumSimdElements; ++i)
+    {
+      pData[i] += ezSimdVec4f(1.0f);
+    }
+  }
+
+  ezHashedString m_StreamName;
+  ezProcessingStream* m_pStream = nullptr;
+};
+
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(AddOneSimdStreamProcessor, 1, ezRTTIDefaultAllocator<AddOneSimdStreamProcessor>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
 EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStream)
 {
   ezProcessingStreamGroup Group;
@@ -157,3 +196,39 @@ EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStream)
     }
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStreamSimd)
+{
+  ezProcessingStreamGroup Group;
+  ezProcessingStream* pStream = Group.AddStream("Stream", ezProcessingStream::DataType::Float4);
+
+  ezProcessingStreamSpawnerZeroInitialized* pSpawner = EZ_DEFAULT_NEW(ezProcessingStreamSpawnerZeroInitialized);
+  pSpawner->SetStreamName(pStream->GetName());
+  Group.AddProcessor(pSpawner);
+
+  AddOneSimdStreamProcessor* pProcessor = EZ_DEFAULT_NEW(AddOneSimdStreamProcessor);
+  pProcessor->SetStreamName(pStream->GetName());
+  Group.AddProcessor(pProcessor);
+
+  // not a multiple of the batch size, the last batch reaches into the padding
+  Group.SetSize(7);
+
+  EZ_TEST_INT(ezProcessingStream::GetNumSimdBatches(0), 0);
+  EZ_TEST_INT(ezProcessingStream::GetNumSimdBatches(7), 2);
+  EZ_TEST_INT(ezProcessingStream::GetNumSimdBatches(8), 2);
+  EZ_TEST_BOOL(ezMemoryUtils::IsAligned(pStream->GetData<ezSimdVec4f>(), EZ_ALIGNMENT_OF(ezSimdVec4f)));
+
+  // spawning happens at the end of Process(), so only the second call processes the new elements
+  Group.InitializeElements(7);
+  Group.Process();
+  Group.Process();
+
+  EZ_TEST_INT(Group.GetNumActiveElements(), 7);
+
+  ezProcessingStreamIterator<ezVec4> it(pStream, Group.GetNumActiveElements(), 0);
+  while (!it.HasReachedEnd())
+  {
+    EZ_TEST_VEC4(it.Current(), ezVec4(1.0f), 0.0f);
+    it.Advance();
+  }
+}
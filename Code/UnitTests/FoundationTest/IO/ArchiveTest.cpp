@@ -153,6 +153,40 @@ EZ_CREATE_SIMPLE_TEST(IO, Archive)
       return;
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Mapped Data")
+  {
+    // files that are stored uncompressed are read directly from the memory mapped archive
+    const ezUInt32 uiFileIdx = 1;
+
+    ezStringBuilder sFileSrc(":output/", szTestData, "/", szFileList[uiFileIdx]);
+    ezStringBuilder sFileDst(":archive/", szFileList[uiFileIdx]);
+
+    ezFileReader reader;
+    if (!EZ_TEST_BOOL(reader.Open(sFileDst).Succeeded()))
+      return;
+
+    ezArrayPtr<const ezUInt8> mappedData = reader.GetMappedData();
+    if (!EZ_TEST_INT(mappedData.GetCount(), reader.GetFileSize()))
+      return;
+
+    ezFileReader srcReader;
+    if (!EZ_TEST_BOOL(srcReader.Open(sFileSrc).Succeeded()))
+      return;
+
+    ezDynamicArray<ezUInt8> srcData;
+    srcData.SetCountUninitialized(mappedData.GetCount());
+    EZ_TEST_INT(srcReader.ReadBytes(srcData.GetData(), srcData.GetCount()), srcData.GetCount());
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(srcData.GetData(), mappedData.GetPtr(), mappedData.GetCount()));
+
+    // reading through the file reader must yield the same data
+    ezUInt64 uiValue = 0;
+    EZ_TEST_INT(reader.SkipBytes(8), 8);
+    EZ_TEST_INT(reader.ReadBytes(&uiValue, sizeof(uiValue)), sizeof(uiValue));
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(reinterpret_cast<const ezUInt8*>(&uiValue), mappedData.GetPtr() + 8, sizeof(uiValue)));
+    EZ_TEST_INT(reader.SkipBytes(mappedData.GetCount()), mappedData.GetCount() - 16);
+    EZ_TEST_INT(reader.ReadBytes(&uiValue, sizeof(uiValue)), 0);
+  }
+
   ezFileSystem::RemoveDataDirectoryGroup("Clear");
 }
 
@@ -4,6 +4,7 @@
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/OSFile.h>
 
 #if EZ_ENABLED(EZ_SUPPORTS_LONG_PATHS)
 #  define LongPath                                                                                                                                   \
@@ -291,6 +292,85 @@ Only concrete and clocks.\n\
     ezFileSystem::DeleteFile(":output2/FileSystemTest2.txt");
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Resolve Cache")
+  {
+    ezFileSystem::SetResolveCacheEnabled(true);
+    EZ_TEST_BOOL(ezFileSystem::IsResolveCacheEnabled());
+
+    ezStringBuilder sRel, sAbs;
+
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile("FileSystemTest3.txt"));
+    EZ_TEST_BOOL(ezFileSystem::ResolvePath("FileSystemTest3.txt", &sAbs, &sRel).Failed());
+
+    // writing a file through the file system discards the cached results
+    {
+      ezFileWriter FileOut;
+      EZ_TEST_BOOL(FileOut.Open(":output1/FileSystemTest3.txt") == EZ_SUCCESS);
+    }
+
+    ezStringBuilder sExpectedAbs = sOutputFolder1Resolved;
+    sExpectedAbs.AppendPath("FileSystemTest3.txt");
+
+    EZ_TEST_BOOL(ezFileSystem::ExistsFile("FileSystemTest3.txt"));
+    EZ_TEST_BOOL(ezFileSystem::ResolvePath("FileSystemTest3.txt", &sAbs, &sRel).Succeeded());
+    EZ_TEST_STRING(sAbs, sExpectedAbs);
+    EZ_TEST_STRING(sRel, "FileSystemTest3.txt");
+
+    // this time the result comes from the cache
+    {
+      sAbs.Clear();
+      sRel.Clear();
+      ezDataDirectoryType* pDataDir = nullptr;
+
+      EZ_TEST_BOOL(ezFileSystem::ResolvePath("FileSystemTest3.txt", &sAbs, &sRel, &pDataDir).Succeeded());
+      EZ_TEST_STRING(sAbs, sExpectedAbs);
+      EZ_TEST_STRING(sRel, "FileSystemTest3.txt");
+      EZ_TEST_BOOL(pDataDir == ezFileSystem::FindDataDirectoryWithRoot("output1"));
+    }
+
+    // overwriting a file doesn't change which files exist, so the cached results are kept
+    {
+      ezFileWriter FileOut;
+      EZ_TEST_BOOL(FileOut.Open(":output1/FileSystemTest3.txt") == EZ_SUCCESS);
+    }
+
+    // without a directory watcher, files that are deleted by other means are only noticed after the cache has been cleared
+    EZ_TEST_BOOL(ezOSFile::DeleteFile(sExpectedAbs).Succeeded());
+#if EZ_DISABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+    EZ_TEST_BOOL(ezFileSystem::ExistsFile("FileSystemTest3.txt"));
+#endif
+
+    ezFileSystem::ClearResolveCache();
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile("FileSystemTest3.txt"));
+
+    // removing a data directory discards the cached results
+    {
+      ezStringBuilder sOutputFolder3 = szOutputFolder;
+      sOutputFolder3.AppendPath("IO", "SubFolder3");
+      EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sOutputFolder3).Succeeded());
+
+      EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder3, "Remove", "output3", ezFileSystem::AllowWrites) == EZ_SUCCESS);
+
+      {
+        ezFileWriter FileOut;
+        EZ_TEST_BOOL(FileOut.Open(":output3/FileSystemTest3.txt") == EZ_SUCCESS);
+      }
+
+      EZ_TEST_BOOL(ezFileSystem::ExistsFile("FileSystemTest3.txt"));
+      EZ_TEST_BOOL(ezFileSystem::ResolvePath("FileSystemTest3.txt", &sAbs, &sRel).Succeeded());
+
+      EZ_TEST_INT(ezFileSystem::RemoveDataDirectoryGroup("Remove"), 1);
+
+      EZ_TEST_BOOL(!ezFileSystem::ExistsFile("FileSystemTest3.txt"));
+      EZ_TEST_BOOL(ezFileSystem::ResolvePath("FileSystemTest3.txt", nullptr, nullptr).Failed());
+
+      EZ_TEST_BOOL(ezOSFile::DeleteFile(sAbs).Succeeded());
+    }
+
+    ezFileSystem::SetResolveCacheEnabled(false);
+    EZ_TEST_BOOL(!ezFileSystem::IsResolveCacheEnabled());
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindFolderWithSubPath")
   {
     EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(szOutputFolder, "remove", "toplevel", ezFileSystem::AllowWrites) == EZ_SUCCESS);
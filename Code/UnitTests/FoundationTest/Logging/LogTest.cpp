@@ -2,11 +2,13 @@
 
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
+#include <Foundation/Logging/AsyncWriter.h>
 #include <Foundation/Logging/ConsoleWriter.h>
 #include <Foundation/Logging/HTMLWriter.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Logging/VisualStudioWriter.h>
 #include <Foundation/Threading/Thread.h>
+#include <Foundation/Utilities/ConversionUtils.h>
 #include <TestFramework/Utilities/TestLogInterface.h>
 
 EZ_CREATE_SIMPLE_TEST_GROUP(Logging);
@@ -61,6 +63,14 @@ namespace
     ezStringBuilder m_Result;
   };
 
+  class AsyncLogInterface : public ezLogInterface
+  {
+  public:
+    virtual void HandleLogMessage(const ezLoggingEventData& le) override { m_pWriter->LogMessageHandler(le); }
+
+    ezLogWriter::Async* m_pWriter = nullptr;
+  };
+
 } // namespace
 
 EZ_CREATE_SIMPLE_TEST(Logging, Log)
@@ -254,3 +264,154 @@ EZ_CREATE_SIMPLE_TEST(Logging, GlobalTestLog)
     }
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(Logging, AsyncWriter)
+{
+  LogTestLogInterface log;
+
+  ezLogWriter::Async asyncWriter;
+  asyncWriter.AddLogWriter(ezMakeDelegate(&LogTestLogInterface::HandleLogMessage, &log));
+
+  AsyncLogInterface asyncLog;
+  asyncLog.m_pWriter = &asyncWriter;
+  asyncLog.SetLogLevel(ezLogMsgType::All);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Output")
+  {
+    asyncWriter.Startup(16);
+
+    {
+      ezLogSystemScope logScope(&asyncLog);
+      EZ_LOG_BLOCK("Verse 1", "Portal: Still Alive");
+
+      ezLog::Success("This was a triumph.");
+      ezLog::Info("I'm making a note here:");
+      ezLog::Error("Huge Success");
+
+      ezStringBuilder sLong;
+      for (ezUInt32 i = 0; i < 40; ++i)
+        sLong.Append("Cake! ");
+
+      ezLog::Warning("{0}", sLong);
+    }
+
+    asyncWriter.Flush();
+
+    ezStringBuilder sExpected = ">Portal: Still Alive Verse 1\nS: This was a triumph.\nI: I'm making a note here:\nE: Huge Success\nW: ";
+    for (ezUInt32 i = 0; i < 40; ++i)
+      sExpected.Append("Cake! ");
+    sExpected.Append("\n<Portal: Still Alive Verse 1\n[Flush]\n");
+
+    EZ_TEST_STRING(log.m_Result, sExpected);
+
+    asyncWriter.Shutdown();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Threads")
+  {
+    log.m_Result.Clear();
+    asyncWriter.Startup(16);
+
+    class LogThread : public ezThread
+    {
+    public:
+      virtual ezUInt32 Run() override
+      {
+        for (ezUInt32 i = 0; i < 1000; ++i)
+        {
+          ezLog::Info(m_pLog, "{0}", m_uiIndex);
+        }
+        return 0;
+      }
+
+      ezLogInterface* m_pLog = nullptr;
+      ezUInt32 m_uiIndex = 0;
+    };
+
+    LogThread thread[8];
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+    {
+      thread[i].m_pLog = &asyncLog;
+      thread[i].m_uiIndex = i;
+      thread[i].Start();
+    }
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+    {
+      thread[i].Join();
+    }
+
+    asyncWriter.Shutdown();
+
+    ezUInt32 uiCount[8] = {};
+    ezHybridArray<ezStringView, 32> lines;
+    log.m_Result.Split(false, lines, "\n");
+
+    for (const ezStringView& line : lines)
+    {
+      if (line.StartsWith("I: "))
+      {
+        ezUInt32 uiIndex = 0;
+        EZ_TEST_BOOL(ezConversionUtils::StringToUInt(line.GetStartPointer() + 3, uiIndex).Succeeded());
+        if (uiIndex < 8)
+          ++uiCount[uiIndex];
+      }
+    }
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+    {
+      EZ_TEST_INT(uiCount[i], 1000);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Shutdown While Logging")
+  {
+    log.m_Result.Clear();
+    asyncWriter.Startup(16);
+
+    class LogThread : public ezThread
+    {
+    public:
+      virtual ezUInt32 Run() override
+      {
+        for (ezUInt32 i = 0; i < 2000; ++i)
+        {
+          ezLog::Info(m_pLog, "x");
+        }
+        return 0;
+      }
+
+      ezLogInterface* m_pLog = nullptr;
+    };
+
+    LogThread thread[4];
+
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      thread[i].m_pLog = &asyncLog;
+      thread[i].Start();
+    }
+
+    // messages that are logged after the shutdown are passed on directly, none may get lost
+    ezThreadUtils::Sleep(ezTime::Milliseconds(1));
+    asyncWriter.Shutdown();
+
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      thread[i].Join();
+    }
+
+    ezHybridArray<ezStringView, 32> lines;
+    log.m_Result.Split(false, lines, "\n");
+
+    ezUInt32 uiCount = 0;
+    for (const ezStringView& line : lines)
+    {
+      if (line.IsEqual("I: x"))
+        ++uiCount;
+    }
+
+    EZ_TEST_INT(uiCount, 4 * 2000);
+  }
+}
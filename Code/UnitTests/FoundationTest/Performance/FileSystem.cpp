@@ -0,0 +1,140 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  // Calls func uiOpsPerThread times on each thread and returns how often it succeeded
+  template <typename Func>
+  ezTime MeasureParallel(ezUInt32 uiNumThreads, ezUInt32 uiOpsPerThread, ezUInt32& out_uiNumSucceeded, Func func)
+  {
+    ezParallelForParams params;
+    params.uiBinSize = 1;
+    params.uiMaxTasksPerThread = 1;
+
+    ezAtomicInteger32 iNumSucceeded;
+
+    ezStopwatch sw;
+
+    ezTaskSystem::ParallelForIndexed(0, uiNumThreads,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        for (ezUInt32 uiThread = uiStartIndex; uiThread < uiEndIndex; ++uiThread)
+        {
+          ezInt32 iSucceeded = 0;
+
+          for (ezUInt32 i = 0; i < uiOpsPerThread; ++i)
+          {
+            iSucceeded += func(uiThread * 7 + i) ? 1 : 0;
+          }
+
+          iNumSucceeded.Add(iSucceeded);
+        }
+      },
+      "FileSystemThread", params);
+
+    const ezTime tDuration = sw.Checkpoint();
+
+    out_uiNumSucceeded = static_cast<ezUInt32>(iNumSucceeded);
+    return tDuration;
+  }
+
+  void MeasureFileSystem(const ezDynamicArray<ezString>& files, ezUInt32 uiNumThreads, ezUInt32 uiOpsPerThread, bool bResolveCache)
+  {
+    const ezUInt32 uiNumFiles = files.GetCount();
+    const double fNumOps = static_cast<double>(uiNumThreads) * uiOpsPerThread;
+
+    ezFileSystem::SetResolveCacheEnabled(bResolveCache);
+
+    ezUInt32 uiNumSucceeded = 0;
+
+    const ezTime tExists = MeasureParallel(uiNumThreads, uiOpsPerThread, uiNumSucceeded, [&](ezUInt32 i) { return ezFileSystem::ExistsFile(files[i % uiNumFiles]); });
+    EZ_TEST_INT(uiNumSucceeded, uiNumThreads * uiOpsPerThread);
+
+    const ezTime tStats = MeasureParallel(uiNumThreads, uiOpsPerThread, uiNumSucceeded, [&](ezUInt32 i) {
+      ezFileStats stats;
+      return ezFileSystem::GetFileStats(files[i % uiNumFiles], stats).Succeeded();
+    });
+    EZ_TEST_INT(uiNumSucceeded, uiNumThreads * uiOpsPerThread);
+
+    const ezTime tResolve = MeasureParallel(uiNumThreads, uiOpsPerThread, uiNumSucceeded, [&](ezUInt32 i) {
+      ezStringBuilder sAbsolutePath;
+      return ezFileSystem::ResolvePath(files[i % uiNumFiles], &sAbsolutePath, nullptr).Succeeded();
+    });
+    EZ_TEST_INT(uiNumSucceeded, uiNumThreads * uiOpsPerThread);
+
+    const ezTime tOpen = MeasureParallel(uiNumThreads, uiOpsPerThread, uiNumSucceeded, [&](ezUInt32 i) {
+      ezFileReader file;
+      return file.Open(files[i % uiNumFiles], 1024).Succeeded();
+    });
+    EZ_TEST_INT(uiNumSucceeded, uiNumThreads * uiOpsPerThread);
+
+    ezFileSystem::SetResolveCacheEnabled(false);
+
+    ezTestFramework::Output(ezTestOutput::Duration,
+      "%u threads, resolve cache %s: ExistsFile %.1f, GetFileStats %.1f, ResolvePath %.1f, open %.1f thousand calls/s", uiNumThreads,
+      bResolveCache ? "on" : "off", fNumOps / tExists.GetSeconds() / 1000.0, fNumOps / tStats.GetSeconds() / 1000.0,
+      fNumOps / tResolve.GetSeconds() / 1000.0, fNumOps / tOpen.GetSeconds() / 1000.0);
+  }
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST(Performance, FileSystem)
+{
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Concurrent File Access")
+  {
+    const ezUInt32 uiNumDataDirs = 4;
+    const ezUInt32 uiNumFiles = 256;
+
+    ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+    sOutputFolder.AppendPath("PerfFileSystem");
+
+    ezFileSystem::RegisterDataDirectoryFactory(ezDataDirectory::FolderType::Factory);
+
+    // all files are in the data directory with the lowest priority, so every lookup has to check all data directories
+    ezStringBuilder sPath;
+    for (ezUInt32 uiDataDir = 0; uiDataDir < uiNumDataDirs; ++uiDataDir)
+    {
+      sPath.Format("{}/Dir{}", sOutputFolder, uiDataDir);
+      EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sPath).Succeeded());
+      EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sPath, "PerfFileSystem").Succeeded());
+    }
+
+    ezDynamicArray<ezString> files;
+    for (ezUInt32 i = 0; i < uiNumFiles; ++i)
+    {
+      sPath.Format("{}/Dir0/Sub{}/File{}.txt", sOutputFolder, i % 8, i);
+
+      ezOSFile file;
+      EZ_TEST_BOOL(file.Open(sPath, ezFileOpenMode::Write).Succeeded());
+      EZ_TEST_BOOL(file.Write("Test", 4).Succeeded());
+      file.Close();
+
+      sPath.Format("Sub{}/File{}.txt", i % 8, i);
+      files.PushBack(sPath);
+    }
+
+    const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+
+    for (bool bResolveCache : {false, true})
+    {
+      MeasureFileSystem(files, 1, 20000, bResolveCache);
+      MeasureFileSystem(files, ezMath::Max(uiNumWorkers, 2u), 10000, bResolveCache);
+      MeasureFileSystem(files, ezMath::Max(uiNumWorkers * 4, 8u), 2500, bResolveCache);
+    }
+
+    EZ_TEST_INT(ezFileSystem::RemoveDataDirectoryGroup("PerfFileSystem"), uiNumDataDirs);
+
+    for (ezUInt32 i = 0; i < uiNumFiles; ++i)
+    {
+      sPath.Format("{}/Dir0/Sub{}/File{}.txt", sOutputFolder, i % 8, i);
+      EZ_TEST_BOOL(ezOSFile::DeleteFile(sPath).Succeeded());
+    }
+  }
+}
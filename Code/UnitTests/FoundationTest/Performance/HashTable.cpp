@@ -0,0 +1,147 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/FlatHashTable.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Containers/Map.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  // ezMap has no TryGetValue, so lookups in all containers go through these functions
+  template <typename Container>
+  EZ_ALWAYS_INLINE bool LookUp(const Container& container, ezUInt64 uiKey, ezUInt64& out_uiSum)
+  {
+    const ezUInt32* pValue = nullptr;
+    if (container.TryGetValue(uiKey, pValue))
+    {
+      out_uiSum += *pValue;
+      return true;
+    }
+    return false;
+  }
+
+  EZ_ALWAYS_INLINE bool LookUp(const ezMap<ezUInt64, ezUInt32>& container, ezUInt64 uiKey, ezUInt64& out_uiSum)
+  {
+    auto it = container.Find(uiKey);
+    if (it.IsValid())
+    {
+      out_uiSum += it.Value();
+      return true;
+    }
+    return false;
+  }
+
+  struct ezPerfHashTableTimes
+  {
+    ezTime m_Insert;
+    ezTime m_LookUpHit;
+    ezTime m_LookUpMiss;
+    ezTime m_RemoveHeavy;
+  };
+
+  template <typename Container>
+  void MeasureContainer(const ezDynamicArray<ezUInt64>& keys, const ezDynamicArray<ezUInt64>& missingKeys, ezPerfHashTableTimes& inout_times)
+  {
+    const ezUInt32 uiNumKeys = keys.GetCount();
+
+    Container container;
+    ezUInt64 uiSum = 0;
+    ezUInt32 uiFound = 0;
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < uiNumKeys; ++i)
+    {
+      container.Insert(keys[i], i);
+    }
+
+    inout_times.m_Insert += sw.Checkpoint();
+
+    for (ezUInt32 i = 0; i < uiNumKeys; ++i)
+    {
+      uiFound += LookUp(container, keys[i], uiSum) ? 1 : 0;
+    }
+
+    inout_times.m_LookUpHit += sw.Checkpoint();
+
+    for (ezUInt32 i = 0; i < uiNumKeys; ++i)
+    {
+      uiFound += LookUp(container, missingKeys[i], uiSum) ? 1 : 0;
+    }
+
+    inout_times.m_LookUpMiss += sw.Checkpoint();
+
+    // keep the number of elements constant while constantly removing old and inserting new ones, which leaves many deleted slots behind
+    for (ezUInt32 uiRound = 0; uiRound < 4; ++uiRound)
+    {
+      const ezDynamicArray<ezUInt64>& removeKeys = (uiRound % 2) == 0 ? keys : missingKeys;
+      const ezDynamicArray<ezUInt64>& insertKeys = (uiRound % 2) == 0 ? missingKeys : keys;
+
+      for (ezUInt32 i = 0; i < uiNumKeys; ++i)
+      {
+        container.Remove(removeKeys[i]);
+        container.Insert(insertKeys[i], i);
+        uiFound += LookUp(container, insertKeys[(i * 7) % uiNumKeys], uiSum) ? 1 : 0;
+      }
+    }
+
+    inout_times.m_RemoveHeavy += sw.Checkpoint();
+
+    EZ_TEST_INT(container.GetCount(), uiNumKeys);
+    EZ_TEST_BOOL(uiFound >= uiNumKeys && uiSum > 0);
+  }
+
+  void PrintTimes(const char* szName, const ezPerfHashTableTimes& times, ezUInt32 uiNumRuns)
+  {
+    ezTestFramework::Output(ezTestOutput::Duration, "  %-16s insert %8.3fms, lookup hit %8.3fms, lookup miss %8.3fms, remove heavy %8.3fms", szName,
+      times.m_Insert.GetMilliseconds() / uiNumRuns, times.m_LookUpHit.GetMilliseconds() / uiNumRuns,
+      times.m_LookUpMiss.GetMilliseconds() / uiNumRuns, times.m_RemoveHeavy.GetMilliseconds() / uiNumRuns);
+  }
+
+  void MeasureHashTables(ezUInt32 uiNumKeys)
+  {
+    const ezUInt32 uiNumRuns = 5;
+
+    // the upper half of the key space is used for keys that are not in the containers
+    ezDynamicArray<ezUInt64> keys;
+    ezDynamicArray<ezUInt64> missingKeys;
+    keys.SetCountUninitialized(uiNumKeys);
+    missingKeys.SetCountUninitialized(uiNumKeys);
+    for (ezUInt32 i = 0; i < uiNumKeys; ++i)
+    {
+      const ezUInt64 uiRandom = (static_cast<ezUInt64>(rand()) << 32) ^ (static_cast<ezUInt64>(rand()) << 16) ^ i;
+      keys[i] = uiRandom & ~(1ull << 63);
+      missingKeys[i] = uiRandom | (1ull << 63);
+    }
+
+    ezPerfHashTableTimes flatHashTableTimes;
+    ezPerfHashTableTimes hashTableTimes;
+    ezPerfHashTableTimes mapTimes;
+
+    for (ezUInt32 uiRun = 0; uiRun < uiNumRuns; ++uiRun)
+    {
+      MeasureContainer<ezFlatHashTable<ezUInt64, ezUInt32>>(keys, missingKeys, flatHashTableTimes);
+      MeasureContainer<ezHashTable<ezUInt64, ezUInt32>>(keys, missingKeys, hashTableTimes);
+      MeasureContainer<ezMap<ezUInt64, ezUInt32>>(keys, missingKeys, mapTimes);
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%u keys:", uiNumKeys);
+    PrintTimes("ezFlatHashTable", flatHashTableTimes, uiNumRuns);
+    PrintTimes("ezHashTable", hashTableTimes, uiNumRuns);
+    PrintTimes("ezMap", mapTimes, uiNumRuns);
+  }
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST(Performance, HashTable)
+{
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "ezFlatHashTable vs ezHashTable vs ezMap")
+  {
+    MeasureHashTables(1000);
+    MeasureHashTables(10000);
+    MeasureHashTables(100000);
+  }
+}
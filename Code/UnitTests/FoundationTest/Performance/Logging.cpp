@@ -0,0 +1,139 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Logging/AsyncWriter.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  // Dispatches messages like ezGlobalLog does, but without the log writers that are registered there
+  class ezPerfLogInterface : public ezLogInterface
+  {
+  public:
+    virtual void HandleLogMessage(const ezLoggingEventData& le) override { m_LoggingEvent.Broadcast(le); }
+
+    ezLoggingEvent m_LoggingEvent;
+  };
+
+  // Formats the messages like the file based log writers do and writes them to memory
+  class ezPerfLogWriter
+  {
+  public:
+    ezPerfLogWriter()
+      : m_Writer(&m_Storage)
+    {
+    }
+
+    void LogMessageHandler(const ezLoggingEventData& eventData)
+    {
+      if (eventData.m_EventType == ezLogMsgType::Flush)
+        return;
+
+      ezStringBuilder sTimestamp;
+      ezLog::GenerateFormattedTimestamp(ezLog::TimestampMode::TimeOnly, sTimestamp);
+
+      ezStringBuilder sLine;
+      sLine.Format("{}{}: {}\n", sTimestamp, (int)eventData.m_EventType, eventData.m_szText);
+
+      EZ_LOCK(m_Mutex);
+      m_Writer.WriteBytes(sLine.GetData(), sLine.GetElementCount()).IgnoreResult();
+      ++m_uiNumMessages;
+    }
+
+    ezMutex m_Mutex;
+    ezMemoryStreamStorage m_Storage;
+    ezMemoryStreamWriter m_Writer;
+    ezUInt32 m_uiNumMessages = 0;
+  };
+
+  ezTime MeasureLogging(ezPerfLogInterface& log, ezLogWriter::Async* pAsyncWriter, ezUInt32 uiNumThreads, ezUInt32 uiMessagesPerThread)
+  {
+    ezParallelForParams params;
+    params.uiBinSize = 1;
+    params.uiMaxTasksPerThread = 1;
+
+    ezStopwatch sw;
+
+    ezTaskSystem::ParallelForIndexed(0, uiNumThreads,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        for (ezUInt32 uiThread = uiStartIndex; uiThread < uiEndIndex; ++uiThread)
+        {
+          for (ezUInt32 i = 0; i < uiMessagesPerThread; ++i)
+          {
+            ezLog::Info(&log, "Thread {} reporting message number {}", uiThread, i);
+          }
+        }
+      },
+      "LoggingThread", params);
+
+    // include the time needed to get all messages to the log writer
+    if (pAsyncWriter != nullptr)
+    {
+      pAsyncWriter->Flush();
+    }
+
+    return sw.Checkpoint();
+  }
+
+  void MeasureLogWriters(ezUInt32 uiNumThreads, ezUInt32 uiMessagesPerThread)
+  {
+    const ezUInt32 uiNumRuns = 5;
+    const double fNumMessages = static_cast<double>(uiNumThreads) * uiMessagesPerThread * uiNumRuns;
+
+    ezTime tSync;
+    ezTime tAsync;
+
+    {
+      ezPerfLogWriter writer;
+      ezPerfLogInterface log;
+      log.SetLogLevel(ezLogMsgType::All);
+      log.m_LoggingEvent.AddEventHandler(ezMakeDelegate(&ezPerfLogWriter::LogMessageHandler, &writer));
+
+      for (ezUInt32 uiRun = 0; uiRun < uiNumRuns; ++uiRun)
+      {
+        tSync += MeasureLogging(log, nullptr, uiNumThreads, uiMessagesPerThread);
+      }
+
+      EZ_TEST_INT(writer.m_uiNumMessages, uiNumThreads * uiMessagesPerThread * uiNumRuns);
+    }
+
+    {
+      ezPerfLogWriter writer;
+      ezLogWriter::Async asyncWriter;
+      asyncWriter.AddLogWriter(ezMakeDelegate(&ezPerfLogWriter::LogMessageHandler, &writer));
+      asyncWriter.Startup();
+
+      ezPerfLogInterface log;
+      log.SetLogLevel(ezLogMsgType::All);
+      log.m_LoggingEvent.AddEventHandler(ezMakeDelegate(&ezLogWriter::Async::LogMessageHandler, &asyncWriter));
+
+      for (ezUInt32 uiRun = 0; uiRun < uiNumRuns; ++uiRun)
+      {
+        tAsync += MeasureLogging(log, &asyncWriter, uiNumThreads, uiMessagesPerThread);
+      }
+
+      asyncWriter.Shutdown();
+
+      EZ_TEST_INT(writer.m_uiNumMessages, uiNumThreads * uiMessagesPerThread * uiNumRuns);
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%u threads, %u messages each: synchronous %.2f, ezLogWriter::Async %.2f million messages/s",
+      uiNumThreads, uiMessagesPerThread, fNumMessages / tSync.GetSeconds() / 1000000.0, fNumMessages / tAsync.GetSeconds() / 1000000.0);
+  }
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST(Performance, Logging)
+{
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Log Throughput")
+  {
+    const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+
+    MeasureLogWriters(1, 100000);
+    MeasureLogWriters(ezMath::Max(uiNumWorkers, 2u), 50000);
+    MeasureLogWriters(ezMath::Max(uiNumWorkers * 4, 8u), 10000);
+  }
+}
@@ -0,0 +1,97 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Communication/MessageQueue.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  struct ezPerfMsgMetaData
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiReceiver;
+  };
+
+  struct ezPerfMsgComparer
+  {
+    template <typename Entry>
+    EZ_ALWAYS_INLINE bool Less(const Entry& a, const Entry& b) const
+    {
+      return a.m_MetaData.m_uiReceiver < b.m_MetaData.m_uiReceiver;
+    }
+  };
+
+  template <typename QueueType>
+  ezTime MeasureEnqueue(QueueType& queue, ezMessage& msg, ezUInt32 uiNumProducers, ezUInt32 uiMessagesPerProducer)
+  {
+    ezParallelForParams params;
+    params.uiBinSize = 1;
+    params.uiMaxTasksPerThread = 1;
+
+    ezStopwatch sw;
+
+    ezTaskSystem::ParallelForIndexed(0, uiNumProducers,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        for (ezUInt32 uiProducer = uiStartIndex; uiProducer < uiEndIndex; ++uiProducer)
+        {
+          for (ezUInt32 i = 0; i < uiMessagesPerProducer; ++i)
+          {
+            ezPerfMsgMetaData metaData;
+            metaData.m_uiReceiver = static_cast<ezUInt64>(uiProducer) * uiMessagesPerProducer + i;
+
+            queue.Enqueue(&msg, metaData);
+          }
+        }
+      },
+      "MessageQueueProducer", params);
+
+    // include the time needed to make the messages available for delivery
+    queue.Sort(ezPerfMsgComparer());
+
+    const ezTime tDiff = sw.Checkpoint();
+
+    EZ_TEST_INT(queue.GetCount(), uiNumProducers * uiMessagesPerProducer);
+    queue.Clear();
+
+    return tDiff;
+  }
+
+  void MeasureMessageQueues(ezUInt32 uiNumProducers, ezUInt32 uiMessagesPerProducer)
+  {
+    const ezUInt32 uiNumRuns = 10;
+    const double fNumMessages = static_cast<double>(uiNumProducers) * uiMessagesPerProducer * uiNumRuns;
+
+    ezMessage msg;
+
+    ezMessageQueue<ezPerfMsgMetaData> queue;
+    ezShardedMessageQueue<ezPerfMsgMetaData> shardedQueue;
+
+    ezTime tQueue;
+    ezTime tShardedQueue;
+
+    for (ezUInt32 uiRun = 0; uiRun < uiNumRuns; ++uiRun)
+    {
+      tQueue += MeasureEnqueue(queue, msg, uiNumProducers, uiMessagesPerProducer);
+      tShardedQueue += MeasureEnqueue(shardedQueue, msg, uiNumProducers, uiMessagesPerProducer);
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%u producers, %u messages each: ezMessageQueue %.2f, ezShardedMessageQueue %.2f million messages/s",
+      uiNumProducers, uiMessagesPerProducer, fNumMessages / tQueue.GetSeconds() / 1000000.0, fNumMessages / tShardedQueue.GetSeconds() / 1000000.0);
+  }
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST(Performance, MessageQueue)
+{
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Enqueue Throughput")
+  {
+    const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+
+    MeasureMessageQueues(1, 100000);
+    MeasureMessageQueues(ezMath::Max(uiNumWorkers, 2u), 100000);
+    MeasureMessageQueues(ezMath::Max(uiNumWorkers * 4, 8u), 25000);
+  }
+}
@@ -0,0 +1,159 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/DataProcessing/Stream/ProcessingStreamGroup.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamProcessor.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
+#include <Foundation/Time/Stopwatch.h>
+
+// Same work as the particle gravity, velocity and apply velocity modules: accelerate, apply friction, move
+
+class ezPerfParticleMoveProcessor : public ezProcessingStreamProcessor
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezPerfParticleMoveProcessor, ezProcessingStreamProcessor);
+
+public:
+  ezProcessingStream::DataType m_VelocityType = ezProcessingStream::DataType::Float4;
+
+protected:
+  virtual ezResult UpdateStreamBindings() override
+  {
+    m_pStreamPosition = m_pStreamGroup->GetStreamByName("Position");
+    m_pStreamVelocity = m_pStreamGroup->GetStreamByName("Velocity");
+
+    return (m_pStreamPosition && m_pStreamVelocity) ? EZ_SUCCESS : EZ_FAILURE;
+  }
+
+  virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override
+  {
+    ezVec4* pPosition = m_pStreamPosition->GetWritableData<ezVec4>();
+
+    for (ezUInt64 i = uiStartIndex; i < uiStartIndex + uiNumElements; ++i)
+    {
+      pPosition[i].Set(static_cast<float>(i), 0.0f, 0.0f, 0.0f);
+    }
+
+    if (m_VelocityType == ezProcessingStream::DataType::Float3)
+    {
+      ezVec3* pVelocity = m_pStreamVelocity->GetWritableData<ezVec3>();
+
+      for (ezUInt64 i = uiStartIndex; i < uiStartIndex + uiNumElements; ++i)
+      {
+        pVelocity[i].Set(0.0f, 0.0f, 10.0f);
+      }
+    }
+    else
+    {
+      ezVec4* pVelocity = m_pStreamVelocity->GetWritableData<ezVec4>();
+
+      for (ezUInt64 i = uiStartIndex; i < uiStartIndex + uiNumElements; ++i)
+      {
+        pVelocity[i].Set(0.0f, 0.0f, 10.0f, 0.0f);
+      }
+    }
+  }
+
+  virtual void Process(ezUInt64 uiNumElements) override
+  {
+    const float tDiff = 1.0f / 60.0f;
+    const float fFrictionFactor = 0.99f;
+    const ezVec3 vGravity(0.0f, 0.0f, -10.0f * tDiff);
+
+    if (m_VelocityType == ezProcessingStream::DataType::Float3)
+    {
+      ezProcessingStreamIterator<ezVec4> itPosition(m_pStreamPosition, uiNumElements, 0);
+      ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+
+      while (!itPosition.HasReachedEnd())
+      {
+        itVelocity.Current() += vGravity;
+        itVelocity.Current() *= fFrictionFactor;
+
+        ezVec3& pos = reinterpret_cast<ezVec3&>(itPosition.Current());
+        pos += itVelocity.Current() * tDiff;
+
+        itPosition.Advance();
+        itVelocity.Advance();
+      }
+    }
+    else
+    {
+      ezSimdVec4f vGravitySimd;
+      vGravitySimd.Load<3>(&vGravity.x);
+
+      const ezSimdVec4f vTimeDiff(tDiff, tDiff, tDiff, 0.0f);
+      const ezSimdFloat fFriction(fFrictionFactor);
+
+      ezSimdVec4f* pPosition = GetSimdData(m_pStreamPosition);
+      ezSimdVec4f* pVelocity = GetSimdData(m_pStreamVelocity);
+
+      const ezUInt64 uiNumSimdElements = ezProcessingStream::GetNumSimdBatches(uiNumElements) * ezProcessingStream::SimdBatchSize;
+
+      for (ezUInt64 i = 0; i < uiNumSimdElements; ++i)
+      {
+        pVelocity[i] = (pVelocity[i] + vGravitySimd) * fFriction;
+        pPosition[i] = ezSimdVec4f::MulAdd(pVelocity[i], vTimeDiff, pPosition[i]);
+      }
+    }
+  }
+
+  ezProcessingStream* m_pStreamPosition = nullptr;
+  ezProcessingStream* m_pStreamVelocity = nullptr;
+};
+
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezPerfParticleMoveProcessor, 1, ezRTTIDefaultAllocator<ezPerfParticleMoveProcessor>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+namespace
+{
+  ezTime MeasureParticleMovement(ezUInt32 uiNumParticles, ezProcessingStream::DataType velocityType)
+  {
+    const ezUInt32 uiNumFrames = 100;
+
+    ezProcessingStreamGroup group;
+    group.AddStream("Position", ezProcessingStream::DataType::Float4);
+    group.AddStream("Velocity", velocityType);
+
+    ezPerfParticleMoveProcessor* pProcessor = EZ_DEFAULT_NEW(ezPerfParticleMoveProcessor);
+    pProcessor->m_VelocityType = velocityType;
+    group.AddProcessor(pProcessor);
+
+    group.SetSize(uiNumParticles);
+    group.InitializeElements(uiNumParticles);
+
+    // the first update spawns the particles
+    group.Process();
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < uiNumFrames; ++i)
+    {
+      group.Process();
+    }
+
+    return sw.GetRunningTotal() / uiNumFrames;
+  }
+
+  void MeasureParticleThroughput(ezUInt32 uiNumParticles)
+  {
+    const ezTime tScalar = MeasureParticleMovement(uiNumParticles, ezProcessingStream::DataType::Float3);
+    const ezTime tSimd = MeasureParticleMovement(uiNumParticles, ezProcessingStream::DataType::Float4);
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%u particles: Float3 iterator %.3fms (%.1f M/s), Float4 SIMD %.3fms (%.1f M/s)", uiNumParticles,
+      tScalar.GetMilliseconds(), uiNumParticles / tScalar.GetMicroseconds(), tSimd.GetMilliseconds(), uiNumParticles / tSimd.GetMicroseconds());
+  }
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST(Performance, ParticleStreams)
+{
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Float3 iterator vs Float4 SIMD batches")
+  {
+    MeasureParticleThroughput(1000);
+    MeasureParticleThroughput(10000);
+    MeasureParticleThroughput(100000);
+    MeasureParticleThroughput(1000000);
+  }
+}
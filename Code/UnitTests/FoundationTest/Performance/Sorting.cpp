@@ -0,0 +1,86 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Algorithm/Sorting.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  // Same layout as the sortable render data: a sorting key and a pointer to the actual data
+  struct ezPerfSortElement
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    const void* m_pData;
+    ezUInt64 m_uiKey;
+  };
+
+  struct ezPerfSortComparer
+  {
+    EZ_ALWAYS_INLINE bool Less(const ezPerfSortElement& a, const ezPerfSortElement& b) const { return a.m_uiKey < b.m_uiKey; }
+  };
+
+  void FillRandom(ezDynamicArray<ezPerfSortElement>& elements, ezUInt32 uiNumElements)
+  {
+    elements.SetCountUninitialized(uiNumElements);
+    for (ezUInt32 i = 0; i < uiNumElements; ++i)
+    {
+      elements[i].m_pData = &elements[i];
+      elements[i].m_uiKey = (static_cast<ezUInt64>(rand()) << 48) ^ (static_cast<ezUInt64>(rand()) << 24) ^ static_cast<ezUInt64>(rand());
+    }
+  }
+
+  void MeasureSorting(ezUInt32 uiNumElements)
+  {
+    const ezUInt32 uiNumRuns = 10;
+
+    ezDynamicArray<ezPerfSortElement> source;
+    FillRandom(source, uiNumElements);
+
+    ezDynamicArray<ezPerfSortElement> elements;
+    ezDynamicArray<ezPerfSortElement> temp;
+    temp.SetCountUninitialized(uiNumElements);
+
+    ezTime tQuickSort;
+    ezTime tRadixSort;
+    ezTime tRadixSortParallel;
+
+    ezStopwatch sw;
+
+    for (ezUInt32 uiRun = 0; uiRun < uiNumRuns; ++uiRun)
+    {
+      // Checkpoint after each copy so only the sorting itself is measured
+      elements = source;
+      sw.Checkpoint();
+      ezSorting::QuickSort(elements, ezPerfSortComparer());
+      tQuickSort += sw.Checkpoint();
+
+      elements = source;
+      sw.Checkpoint();
+      ezSorting::RadixSort(elements.GetArrayPtr(), temp.GetArrayPtr(), [](const ezPerfSortElement& e) { return e.m_uiKey; });
+      tRadixSort += sw.Checkpoint();
+
+      elements = source;
+      sw.Checkpoint();
+      ezSorting::RadixSort(elements.GetArrayPtr(), temp.GetArrayPtr(), [](const ezPerfSortElement& e) { return e.m_uiKey; }, true);
+      tRadixSortParallel += sw.Checkpoint();
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%u elements: QuickSort %.3fms, RadixSort %.3fms, RadixSort parallel %.3fms", uiNumElements,
+      tQuickSort.GetMilliseconds() / uiNumRuns, tRadixSort.GetMilliseconds() / uiNumRuns, tRadixSortParallel.GetMilliseconds() / uiNumRuns);
+  }
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST(Performance, Sorting)
+{
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "QuickSort vs RadixSort")
+  {
+    MeasureSorting(1000);
+    MeasureSorting(10000);
+    MeasureSorting(100000);
+    MeasureSorting(1000000);
+  }
+}
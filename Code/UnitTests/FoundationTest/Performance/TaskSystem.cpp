@@ -0,0 +1,158 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  enum TaskSystemPerfConstants
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    NUM_TASK_BATCHES = 16,
+#else
+    NUM_TASK_BATCHES = 128,
+#endif
+    NUM_TASKS_PER_BATCH = 512,
+    NUM_NESTED_TASKS = 64,
+  };
+
+  class ezTinyPerfTask final : public ezTask
+  {
+  public:
+    ezTinyPerfTask() { ConfigureTask("ezTinyPerfTask", ezTaskNesting::Never); }
+
+    ezAtomicInteger32* m_pCounter = nullptr;
+    ezUInt32 m_uiResult = 0;
+
+  private:
+    virtual void Execute() override
+    {
+      // very little work, the cost of scheduling should dominate
+      for (ezUInt32 i = 0; i < 64; ++i)
+        m_uiResult = m_uiResult * 31 + i;
+
+      m_pCounter->Increment();
+    }
+  };
+
+  /// Spawns more tasks from within a worker thread, which is the typical fan-out pattern of nested ParallelFor calls.
+  class ezSpawningPerfTask final : public ezTask
+  {
+  public:
+    ezSpawningPerfTask() { ConfigureTask("ezSpawningPerfTask", ezTaskNesting::Maybe); }
+
+    ezAtomicInteger32* m_pCounter = nullptr;
+
+  private:
+    virtual void Execute() override
+    {
+      ezSharedPtr<ezTinyPerfTask> tasks[NUM_NESTED_TASKS];
+
+      ezTaskGroupID group = ezTaskSystem::CreateTaskGroup(ezTaskPriority::EarlyThisFrame);
+
+      for (ezUInt32 i = 0; i < NUM_NESTED_TASKS; ++i)
+      {
+        tasks[i] = EZ_DEFAULT_NEW(ezTinyPerfTask);
+        tasks[i]->m_pCounter = m_pCounter;
+        ezTaskSystem::AddTaskToGroup(group, tasks[i]);
+      }
+
+      ezTaskSystem::StartTaskGroup(group);
+      ezTaskSystem::WaitForGroup(group);
+    }
+  };
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST(Performance, TaskSystem)
+{
+  const ezUInt32 uiPrevShortTasks = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+  const ezUInt32 uiPrevLongTasks = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::LongTasks);
+
+  const ezUInt32 workerCounts[] = {1, 2, 4, 8, 16, 32};
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Tasks Started From Main Thread")
+  {
+    ezDynamicArray<ezSharedPtr<ezTinyPerfTask>> tasks;
+    tasks.SetCount(NUM_TASKS_PER_BATCH);
+
+    for (ezUInt32 uiWorkers : workerCounts)
+    {
+      ezTaskSystem::SetWorkerThreadCount(uiWorkers, 2);
+
+      ezAtomicInteger32 counter;
+
+      for (auto& pTask : tasks)
+      {
+        pTask = EZ_DEFAULT_NEW(ezTinyPerfTask);
+        pTask->m_pCounter = &counter;
+      }
+
+      const ezTime t0 = ezTime::Now();
+
+      for (ezUInt32 batch = 0; batch < NUM_TASK_BATCHES; ++batch)
+      {
+        ezTaskGroupID group = ezTaskSystem::CreateTaskGroup(ezTaskPriority::ThisFrame);
+
+        for (auto& pTask : tasks)
+        {
+          ezTaskSystem::AddTaskToGroup(group, pTask);
+        }
+
+        ezTaskSystem::StartTaskGroup(group);
+        ezTaskSystem::WaitForGroup(group);
+      }
+
+      const ezTime t1 = ezTime::Now();
+      const ezUInt32 uiNumTasks = NUM_TASK_BATCHES * NUM_TASKS_PER_BATCH;
+
+      EZ_TEST_INT(counter, uiNumTasks);
+      ezLog::Info("[test]Main Thread Fan-Out, {0} workers: {1} tasks/sec", uiWorkers, ezArgF(uiNumTasks / (t1 - t0).GetSeconds(), 0));
+    }
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Tasks Started From Worker Threads")
+  {
+    ezDynamicArray<ezSharedPtr<ezSpawningPerfTask>> tasks;
+    tasks.SetCount(NUM_TASKS_PER_BATCH / NUM_NESTED_TASKS);
+
+    for (ezUInt32 uiWorkers : workerCounts)
+    {
+      ezTaskSystem::SetWorkerThreadCount(uiWorkers, 2);
+
+      ezAtomicInteger32 counter;
+
+      for (auto& pTask : tasks)
+      {
+        pTask = EZ_DEFAULT_NEW(ezSpawningPerfTask);
+        pTask->m_pCounter = &counter;
+      }
+
+      const ezTime t0 = ezTime::Now();
+
+      for (ezUInt32 batch = 0; batch < NUM_TASK_BATCHES; ++batch)
+      {
+        ezTaskGroupID group = ezTaskSystem::CreateTaskGroup(ezTaskPriority::ThisFrame);
+
+        for (auto& pTask : tasks)
+        {
+          ezTaskSystem::AddTaskToGroup(group, pTask);
+        }
+
+        ezTaskSystem::StartTaskGroup(group);
+        ezTaskSystem::WaitForGroup(group);
+      }
+
+      const ezTime t1 = ezTime::Now();
+      const ezUInt32 uiNumTasks = NUM_TASK_BATCHES * tasks.GetCount() * (NUM_NESTED_TASKS + 1);
+
+      EZ_TEST_INT(counter, NUM_TASK_BATCHES * tasks.GetCount() * NUM_NESTED_TASKS);
+      ezLog::Info("[test]Nested Fan-Out, {0} workers: {1} tasks/sec", uiWorkers, ezArgF(uiNumTasks / (t1 - t0).GetSeconds(), 0));
+    }
+  }
+
+  ezTaskSystem::SetWorkerThreadCount(uiPrevShortTasks, uiPrevLongTasks);
+}
@@ -1,5 +1,6 @@
 #include <FoundationTestPCH.h>
 
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/Profiling/Profiling.h>
@@ -7,10 +8,18 @@
 
 namespace
 {
-  void WriteOutProfilingCapture(const char* szFilePath)
+  void MountOutputDirectory()
   {
+    if (ezFileSystem::FindDataDirectoryWithRoot("output") != nullptr)
+      return;
+
     ezStringBuilder outputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
     EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(outputPath.GetData(), "test", "output", ezFileSystem::AllowWrites) == EZ_SUCCESS);
+  }
+
+  void WriteOutProfilingCapture(const char* szFilePath)
+  {
+    MountOutputDirectory();
 
     ezFileWriter fileWriter;
     if (fileWriter.Open(szFilePath) == EZ_SUCCESS)
@@ -52,4 +61,50 @@ EZ_CREATE_SIMPLE_TEST(Profiling, Profiling)
 
     WriteOutProfilingCapture(":output/profilingScopes.json");
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Scope names")
+  {
+    const ezUInt32 uiNameId = ezProfilingSystem::InternScopeName("Scope Name Test");
+
+    EZ_TEST_INT(ezProfilingSystem::InternScopeName("Scope Name Test"), uiNameId);
+    EZ_TEST_BOOL(ezProfilingSystem::InternScopeName("Other Scope Name Test") != uiNameId);
+    EZ_TEST_STRING(ezProfilingSystem::GetScopeName(uiNameId), "Scope Name Test");
+
+    // long names are truncated
+    ezStringBuilder sLongName;
+    for (ezUInt32 i = 0; i < ezProfilingSystem::SCOPE_NAME_SIZE; ++i)
+    {
+      sLongName.Append("a");
+    }
+
+    const ezUInt32 uiLongNameId = ezProfilingSystem::InternScopeName(sLongName);
+    EZ_TEST_INT(ezStringUtils::GetStringElementCount(ezProfilingSystem::GetScopeName(uiLongNameId)), ezProfilingSystem::SCOPE_NAME_SIZE - 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Continuous capture")
+  {
+    MountOutputDirectory();
+
+    EZ_TEST_BOOL(ezProfilingSystem::StartContinuousCapture(":output/profilingContinuous.json").Succeeded());
+    EZ_TEST_BOOL(ezProfilingSystem::IsContinuousCaptureActive());
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      ezProfilingSystem::StartNewFrame();
+
+      EZ_PROFILE_SCOPE("Continuous capture scope");
+      ezThreadUtils::Sleep(ezTime::Milliseconds(50));
+    }
+
+    ezProfilingSystem::StopContinuousCapture();
+    EZ_TEST_BOOL(!ezProfilingSystem::IsContinuousCaptureActive());
+
+    ezFileReader fileReader;
+    EZ_TEST_BOOL(fileReader.Open(":output/profilingContinuous.json") == EZ_SUCCESS);
+
+    ezStringBuilder sContent;
+    sContent.ReadAll(fileReader);
+    EZ_TEST_BOOL(sContent.FindSubString("Continuous capture scope") != nullptr);
+    EZ_TEST_BOOL(sContent.EndsWith("]}"));
+  }
 }
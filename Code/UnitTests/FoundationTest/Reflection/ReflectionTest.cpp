@@ -202,6 +202,20 @@ EZ_CREATE_SIMPLE_TEST(Reflection, Types)
     EZ_TEST_BOOL(pClass == pClass2);
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindTypeByNameHash32")
+  {
+    ezRTTI* pFloat = ezRTTI::FindTypeByName("float");
+    ezRTTI* pFloat2 = ezRTTI::FindTypeByNameHash32(ezHashingUtils::StringHashTo32(pFloat->GetTypeNameHash()));
+    EZ_TEST_BOOL(pFloat == pFloat2);
+
+    ezRTTI* pStruct = ezRTTI::FindTypeByName("ezTestStruct");
+    ezRTTI* pStruct2 = ezRTTI::FindTypeByNameHash32(ezHashingUtils::StringHashTo32(pStruct->GetTypeNameHash()));
+    EZ_TEST_BOOL(pStruct == pStruct2);
+
+    EZ_TEST_BOOL(ezRTTI::FindTypeByName("ezNonExistingType") == nullptr);
+    EZ_TEST_BOOL(ezRTTI::FindTypeByNameHash(ezHashingUtils::StringHash("ezNonExistingType")) == nullptr);
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "GetProperties")
   {
     {
@@ -418,6 +432,9 @@ EZ_CREATE_SIMPLE_TEST(Reflection, Hierarchies)
     EZ_TEST_BOOL(pRtti->IsDerivedFrom<ezTestClass2>());
     EZ_TEST_BOOL(pRtti->IsDerivedFrom(ezGetStaticRTTI<ezTestClass2>()));
 
+    EZ_TEST_BOOL(!ezGetStaticRTTI<ezTestClass1>()->IsDerivedFrom<ezTestClass2>());
+    EZ_TEST_BOOL(!pRtti->IsDerivedFrom(nullptr));
+
     EZ_TEST_BOOL(pRtti->IsDerivedFrom<ezReflectedClass>());
     EZ_TEST_BOOL(pRtti->IsDerivedFrom(ezGetStaticRTTI<ezReflectedClass>()));
 
@@ -426,6 +443,95 @@ EZ_CREATE_SIMPLE_TEST(Reflection, Hierarchies)
   }
 }
 
+class ezTestDeepClass1 : public ezTestClass2
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezTestDeepClass1, ezTestClass2);
+};
+
+class ezTestDeepClass2 : public ezTestDeepClass1
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezTestDeepClass2, ezTestDeepClass1);
+};
+
+class ezTestDeepClass2b : public ezTestDeepClass1
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezTestDeepClass2b, ezTestDeepClass1);
+};
+
+class ezTestDeepClass3 : public ezTestDeepClass2
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezTestDeepClass3, ezTestDeepClass2);
+};
+
+// clang-format off
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezTestDeepClass1, 1, ezRTTINoAllocator)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezTestDeepClass2, 1, ezRTTINoAllocator)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezTestDeepClass2b, 1, ezRTTINoAllocator)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezTestDeepClass3, 1, ezRTTINoAllocator)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+EZ_CREATE_SIMPLE_TEST(Reflection, IsDerivedFrom)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Deep Hierarchy")
+  {
+    const ezRTTI* pRtti = ezGetStaticRTTI<ezTestDeepClass3>();
+
+    EZ_TEST_BOOL(pRtti->IsDerivedFrom<ezTestDeepClass3>());
+    EZ_TEST_BOOL(pRtti->IsDerivedFrom<ezTestDeepClass2>());
+    EZ_TEST_BOOL(pRtti->IsDerivedFrom<ezTestDeepClass1>());
+    EZ_TEST_BOOL(pRtti->IsDerivedFrom<ezTestClass2>());
+    EZ_TEST_BOOL(pRtti->IsDerivedFrom<ezTestClass1>());
+    EZ_TEST_BOOL(pRtti->IsDerivedFrom<ezReflectedClass>());
+
+    EZ_TEST_BOOL(!ezGetStaticRTTI<ezTestDeepClass2>()->IsDerivedFrom<ezTestDeepClass3>());
+    EZ_TEST_BOOL(!ezGetStaticRTTI<ezTestClass1>()->IsDerivedFrom<ezTestDeepClass1>());
+    EZ_TEST_BOOL(!ezGetStaticRTTI<ezReflectedClass>()->IsDerivedFrom<ezTestDeepClass3>());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Siblings")
+  {
+    const ezRTTI* pRtti = ezGetStaticRTTI<ezTestDeepClass2b>();
+
+    EZ_TEST_BOOL(pRtti->IsDerivedFrom<ezTestDeepClass1>());
+    EZ_TEST_BOOL(pRtti->IsDerivedFrom<ezTestClass2>());
+
+    // siblings are at the same depth of the same hierarchy
+    EZ_TEST_BOOL(!pRtti->IsDerivedFrom<ezTestDeepClass2>());
+    EZ_TEST_BOOL(!ezGetStaticRTTI<ezTestDeepClass2>()->IsDerivedFrom<ezTestDeepClass2b>());
+    EZ_TEST_BOOL(!ezGetStaticRTTI<ezTestDeepClass3>()->IsDerivedFrom<ezTestDeepClass2b>());
+
+    // ezTestClass2b derives privately from ezReflectedClass, so ezGetStaticRTTI can't be used here
+    const ezRTTI* pSibling = ezRTTI::FindTypeByName("ezTestClass2b");
+    EZ_TEST_BOOL(pSibling != nullptr);
+    EZ_TEST_BOOL(pSibling->IsDerivedFrom<ezReflectedClass>());
+    EZ_TEST_BOOL(!pSibling->IsDerivedFrom<ezTestClass1>());
+    EZ_TEST_BOOL(!ezGetStaticRTTI<ezTestClass1>()->IsDerivedFrom(pSibling));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Unregistered Type")
+  {
+    // a type without a name is not registered and never assigned to a plugin, so it has no cached hierarchy
+    ezRTTI unregistered(nullptr, ezGetStaticRTTI<ezTestDeepClass1>(), 0, 1, ezVariant::Type::Invalid, ezTypeFlags::Class, nullptr, {}, {}, {}, {}, {}, nullptr);
+
+    EZ_TEST_BOOL(unregistered.IsDerivedFrom(&unregistered));
+    EZ_TEST_BOOL(unregistered.IsDerivedFrom<ezTestDeepClass1>());
+    EZ_TEST_BOOL(unregistered.IsDerivedFrom<ezTestClass1>());
+    EZ_TEST_BOOL(unregistered.IsDerivedFrom<ezReflectedClass>());
+    EZ_TEST_BOOL(!unregistered.IsDerivedFrom<ezTestDeepClass2>());
+    EZ_TEST_BOOL(!unregistered.IsDerivedFrom(nullptr));
+
+    EZ_TEST_BOOL(!ezGetStaticRTTI<ezTestDeepClass1>()->IsDerivedFrom(&unregistered));
+    EZ_TEST_BOOL(!ezGetStaticRTTI<ezTestDeepClass3>()->IsDerivedFrom(&unregistered));
+  }
+}
+
 
 template <typename T, typename T2>
 void TestMemberProperty(const char* szPropName, void* pObject, const ezRTTI* pRtti, ezBitflags<ezPropertyFlags> expectedFlags, T2 expectedValue, T2 testValue, bool testDefaultValue = true)
@@ -0,0 +1,152 @@
+#include <GameEngineTestPCH.h>
+
+#include <Foundation/Time/Stopwatch.h>
+#include <ProcGenPlugin/VM/ExpressionByteCode.h>
+#include <ProcGenPlugin/VM/ExpressionCompiler.h>
+#include <ProcGenPlugin/VM/ExpressionVM.h>
+
+namespace
+{
+  struct ezPerfPlacementPoint
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezVec3 m_vPosition;
+    ezVec3 m_vNormal;
+    float m_fPointIndex;
+    float m_fPadding;
+  };
+
+  using NodeType = ezExpressionAST::NodeType;
+
+  ezExpressionAST::Node* CreateRemap(ezExpressionAST& ast, ezExpressionAST::Node* pValue, float fScale, float fOffset)
+  {
+    auto pScaled = ast.CreateBinaryOperator(NodeType::Multiply, ast.CreateConstant(fScale), pValue);
+    return ast.CreateBinaryOperator(NodeType::Add, pScaled, ast.CreateConstant(fOffset));
+  }
+
+  ezExpressionAST::Node* CreateSaturate(ezExpressionAST& ast, ezExpressionAST::Node* pValue)
+  {
+    auto pMax = ast.CreateBinaryOperator(NodeType::Max, ast.CreateConstant(0.0f), pValue);
+    return ast.CreateBinaryOperator(NodeType::Min, ast.CreateConstant(1.0f), pMax);
+  }
+
+  /// Builds an expression that resembles what a typical placement graph compiles to: noise based density masked by slope, random scale,
+  /// and a color index derived from the position.
+  void CreatePlacementExpression(ezExpressionAST& ast, bool bWithNoise)
+  {
+    auto pPosX = ast.CreateInput(ezMakeHashedString("PositionX"));
+    auto pPosY = ast.CreateInput(ezMakeHashedString("PositionY"));
+    auto pPosZ = ast.CreateInput(ezMakeHashedString("PositionZ"));
+    auto pNormalZ = ast.CreateInput(ezMakeHashedString("NormalZ"));
+    auto pPointIndex = ast.CreateInput(ezMakeHashedString("PointIndex"));
+
+    ezExpressionAST::Node* pPattern = nullptr;
+    if (bWithNoise)
+    {
+      auto pNoise = ast.CreateFunctionCall(ezMakeHashedString("PerlinNoise"));
+      pNoise->m_Arguments.PushBack(ast.CreateBinaryOperator(NodeType::Multiply, ast.CreateConstant(0.05f), pPosX));
+      pNoise->m_Arguments.PushBack(ast.CreateBinaryOperator(NodeType::Multiply, ast.CreateConstant(0.05f), pPosY));
+      pNoise->m_Arguments.PushBack(ast.CreateBinaryOperator(NodeType::Multiply, ast.CreateConstant(0.05f), pPosZ));
+      pNoise->m_Arguments.PushBack(ast.CreateConstant(3.0f));
+      pPattern = pNoise;
+    }
+    else
+    {
+      auto pWaveX = ast.CreateUnaryOperator(NodeType::Sin, CreateRemap(ast, pPosX, 0.1f, 0.3f));
+      auto pWaveY = ast.CreateUnaryOperator(NodeType::Cos, CreateRemap(ast, pPosY, 0.13f, 0.7f));
+      pPattern = CreateRemap(ast, ast.CreateBinaryOperator(NodeType::Multiply, pWaveX, pWaveY), 0.5f, 0.5f);
+    }
+
+    auto pSlope = CreateSaturate(ast, CreateRemap(ast, pNormalZ, 4.0f, -3.0f));
+    auto pDensity = ast.CreateBinaryOperator(NodeType::Multiply, CreateSaturate(ast, CreateRemap(ast, pPattern, 2.0f, -0.5f)), pSlope);
+
+    auto pRandom = ast.CreateFunctionCall(ezMakeHashedString("Random"));
+    pRandom->m_Arguments.PushBack(pPointIndex);
+    auto pScale = CreateRemap(ast, pRandom, 0.5f, 0.75f);
+
+    auto pHeight = ast.CreateUnaryOperator(NodeType::Absolute, pPosZ);
+    auto pColorIndex = CreateSaturate(ast, CreateRemap(ast, pHeight, 0.01f, 0.0f));
+
+    ast.m_OutputNodes.PushBack(ast.CreateOutput(ezMakeHashedString("Density"), pDensity));
+    ast.m_OutputNodes.PushBack(ast.CreateOutput(ezMakeHashedString("Scale"), pScale));
+    ast.m_OutputNodes.PushBack(ast.CreateOutput(ezMakeHashedString("ColorIndex"), pColorIndex));
+  }
+
+  void MeasureExpressionVM(const char* szName, bool bWithNoise, ezUInt32 uiNumPoints)
+  {
+    ezExpressionAST ast;
+    CreatePlacementExpression(ast, bWithNoise);
+
+    ezExpressionByteCode byteCode;
+    ezExpressionCompiler compiler;
+    if (!EZ_TEST_BOOL(compiler.Compile(ast, byteCode).Succeeded()))
+      return;
+
+    ezDynamicArray<ezPerfPlacementPoint> points;
+    points.SetCountUninitialized(uiNumPoints);
+    for (ezUInt32 i = 0; i < uiNumPoints; ++i)
+    {
+      auto& point = points[i];
+      point.m_vPosition.Set((i % 256) * 0.5f, (i / 256) * 0.5f, (i % 37) * 3.0f);
+      point.m_vNormal.Set(0.0f, 0.0f, (i % 100) / 100.0f);
+      point.m_fPointIndex = static_cast<float>(i);
+    }
+
+    ezDynamicArray<float> outputData;
+    outputData.SetCountUninitialized(uiNumPoints * 3);
+
+    auto pointData = points.GetArrayPtr();
+    ezHybridArray<ezExpression::Stream, 8> inputs;
+    inputs.PushBack(ezExpression::MakeStream(pointData, offsetof(ezPerfPlacementPoint, m_vPosition.x), ezMakeHashedString("PositionX")));
+    inputs.PushBack(ezExpression::MakeStream(pointData, offsetof(ezPerfPlacementPoint, m_vPosition.y), ezMakeHashedString("PositionY")));
+    inputs.PushBack(ezExpression::MakeStream(pointData, offsetof(ezPerfPlacementPoint, m_vPosition.z), ezMakeHashedString("PositionZ")));
+    inputs.PushBack(ezExpression::MakeStream(pointData, offsetof(ezPerfPlacementPoint, m_vNormal.z), ezMakeHashedString("NormalZ")));
+    inputs.PushBack(ezExpression::MakeStream(pointData, offsetof(ezPerfPlacementPoint, m_fPointIndex), ezMakeHashedString("PointIndex")));
+
+    auto outputArray = outputData.GetArrayPtr();
+    ezHybridArray<ezExpression::Stream, 8> outputs;
+    outputs.PushBack(ezExpression::MakeStream(outputArray.GetSubArray(0, uiNumPoints), 0, ezMakeHashedString("Density")));
+    outputs.PushBack(ezExpression::MakeStream(outputArray.GetSubArray(uiNumPoints, uiNumPoints), 0, ezMakeHashedString("Scale")));
+    outputs.PushBack(ezExpression::MakeStream(outputArray.GetSubArray(uiNumPoints * 2, uiNumPoints), 0, ezMakeHashedString("ColorIndex")));
+
+    ezExpressionVM vm;
+    vm.RegisterDefaultFunctions();
+
+    // warm up
+    EZ_TEST_BOOL(vm.Execute(byteCode, inputs, outputs, uiNumPoints).Succeeded());
+
+    const ezUInt32 uiNumRuns = 20;
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < uiNumRuns; ++i)
+    {
+      vm.Execute(byteCode, inputs, outputs, uiNumPoints).IgnoreResult();
+    }
+
+    const ezTime tDiff = sw.Checkpoint();
+    const double fPointsPerSecond = (double)uiNumPoints * uiNumRuns / tDiff.GetSeconds();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%s, %u points, %u instructions: %.2fms per run, %.2f million points/s", szName,
+      uiNumPoints, byteCode.GetNumInstructions(), tDiff.GetMilliseconds() / uiNumRuns, fPointsPerSecond / 1000000.0);
+  }
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST(Performance, ExpressionVM)
+{
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Placement Arithmetic")
+  {
+    MeasureExpressionVM("Arithmetic", false, 1024);
+    MeasureExpressionVM("Arithmetic", false, 256 * 1024);
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Placement Noise")
+  {
+    MeasureExpressionVM("Noise", true, 1024);
+    MeasureExpressionVM("Noise", true, 256 * 1024);
+  }
+}
@@ -0,0 +1,173 @@
+#include <GameEngineTestPCH.h>
+
+#include <Core/Messages/UpdateLocalBoundsMessage.h>
+#include <Core/World/World.h>
+#include <Foundation/Time/Stopwatch.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Performance);
+
+namespace
+{
+  class ezPerfMoverComponentManager;
+
+  /// Rotates its owner every frame and provides some bounds, so that every object in the hierarchy below has to update its spatial data.
+  class ezPerfMoverComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(ezPerfMoverComponent, ezComponent, ezPerfMoverComponentManager);
+
+  public:
+    virtual void Initialize() override { GetOwner()->UpdateLocalBounds(); }
+
+    void OnUpdateLocalBounds(ezMsgUpdateLocalBounds& msg)
+    {
+      ezBoundingBox bounds;
+      bounds.SetCenterAndHalfExtents(ezVec3::ZeroVector(), ezVec3(0.5f));
+
+      msg.AddBounds(bounds, ezDefaultSpatialDataCategories::RenderDynamic);
+    }
+  };
+
+  class ezPerfMoverComponentManager : public ezComponentManager<ezPerfMoverComponent, ezBlockStorageType::FreeList>
+  {
+  public:
+    ezPerfMoverComponentManager(ezWorld* pWorld)
+      : ezComponentManager<ezPerfMoverComponent, ezBlockStorageType::FreeList>(pWorld)
+    {
+    }
+
+    virtual void Initialize() override
+    {
+      auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezPerfMoverComponentManager::Update, this);
+      desc.m_bOnlyUpdateWhenSimulating = false;
+
+      RegisterUpdateFunction(desc);
+    }
+
+    void Update(const ezWorldModule::UpdateContext& context)
+    {
+      m_Angle += ezAngle::Degree(2.0f);
+
+      ezQuat qRot;
+      qRot.SetFromAxisAndAngle(ezVec3(0, 0, 1), m_Angle);
+
+      for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+      {
+        if (it->IsActiveAndInitialized() && it->GetOwner()->GetParent() == nullptr)
+        {
+          it->GetOwner()->SetLocalRotation(qRot);
+        }
+      }
+    }
+
+    ezAngle m_Angle;
+  };
+
+  // clang-format off
+  EZ_BEGIN_COMPONENT_TYPE(ezPerfMoverComponent, 1, ezComponentMode::Dynamic)
+  {
+    EZ_BEGIN_MESSAGEHANDLERS
+    {
+      EZ_MESSAGE_HANDLER(ezMsgUpdateLocalBounds, OnUpdateLocalBounds)
+    }
+    EZ_END_MESSAGEHANDLERS;
+  }
+  EZ_END_COMPONENT_TYPE;
+  // clang-format on
+
+  void CreateHierarchy(ezWorld& world, ezUInt32 uiNumChildren, ezUInt32 uiDepth, ezGameObjectHandle hParent)
+  {
+    if (uiDepth == 0)
+      return;
+
+    ezPerfMoverComponentManager* pManager = world.GetOrCreateComponentManager<ezPerfMoverComponentManager>();
+
+    ezGameObjectDesc gd;
+    gd.m_bDynamic = true;
+    gd.m_hParent = hParent;
+
+    for (ezUInt32 i = 0; i < uiNumChildren; ++i)
+    {
+      gd.m_LocalPosition.Set(i * 2.0f, uiDepth * 2.0f, 0.0f);
+
+      ezGameObject* pObject = nullptr;
+      ezGameObjectHandle hObject = world.CreateObject(gd, pObject);
+
+      ezPerfMoverComponent* pComponent = nullptr;
+      pManager->CreateComponent(pObject, pComponent);
+
+      CreateHierarchy(world, uiNumChildren, uiDepth - 1, hObject);
+    }
+  }
+
+  void MeasureTransformUpdate(const char* szName, ezUInt32 uiNumRoots, ezUInt32 uiNumChildren, ezUInt32 uiDepth, bool bSpatialSystem)
+  {
+    ezWorldDesc worldDesc("Test");
+    worldDesc.m_bAutoCreateSpatialSystem = bSpatialSystem;
+    ezWorld world(worldDesc);
+
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezPerfMoverComponentManager* pManager = world.GetOrCreateComponentManager<ezPerfMoverComponentManager>();
+
+    ezGameObjectDesc gd;
+    gd.m_bDynamic = true;
+
+    for (ezUInt32 i = 0; i < uiNumRoots; ++i)
+    {
+      gd.m_LocalPosition.Set(0.0f, 0.0f, i * 2.0f);
+
+      ezGameObject* pRoot = nullptr;
+      ezGameObjectHandle hRoot = world.CreateObject(gd, pRoot);
+
+      ezPerfMoverComponent* pComponent = nullptr;
+      pManager->CreateComponent(pRoot, pComponent);
+
+      CreateHierarchy(world, uiNumChildren, uiDepth - 1, hRoot);
+    }
+
+    // first round initializes the components and creates the spatial data
+    world.Update();
+
+    const ezUInt32 uiNumFrames = 10;
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < uiNumFrames; ++i)
+    {
+      world.Update();
+    }
+
+    const ezTime tDiff = sw.Checkpoint();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%s, %u objects%s: %.2fms per frame", szName, world.GetObjectCount(),
+      bSpatialSystem ? " with spatial system" : "", tDiff.GetMilliseconds() / uiNumFrames);
+  }
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST(Performance, TransformUpdate)
+{
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Wide Hierarchy")
+  {
+    // 200,000 roots without children
+    MeasureTransformUpdate("Wide", 200000, 0, 1, false);
+    MeasureTransformUpdate("Wide", 200000, 0, 1, true);
+
+    // 2,000 roots with 99 children each
+    MeasureTransformUpdate("Wide", 2000, 99, 2, false);
+    MeasureTransformUpdate("Wide", 2000, 99, 2, true);
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Deep Hierarchy")
+  {
+    // 4 roots, binary trees with 16 levels
+    MeasureTransformUpdate("Deep", 4, 2, 16, false);
+    MeasureTransformUpdate("Deep", 4, 2, 16, true);
+
+    // 2,000 chains with 100 levels
+    MeasureTransformUpdate("Deep", 2000, 1, 100, false);
+    MeasureTransformUpdate("Deep", 2000, 1, 100, true);
+  }
+}
@@ -0,0 +1,218 @@
+#include <RendererCoreTestPCH.h>
+
+#include "StateBatchingTest.h"
+#include <Foundation/Configuration/CVar.h>
+#include <RendererCore/RenderContext/RenderContext.h>
+#include <RendererFoundation/CommandEncoder/CommandList.h>
+#include <RendererNull/Device/DeviceNull.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiWarmupFrames = 10;
+  constexpr ezUInt32 s_uiNumObjects = 1000;
+} // namespace
+
+ezResult ezRendererTestStateBatching::InitializeSubTest(ezInt32 iIdentifier)
+{
+  m_iFrame = -1;
+  m_ImmediateBinds = FrameCounters();
+
+  if (ezNullRendererTest::InitializeSubTest(iIdentifier).Failed())
+    return EZ_FAILURE;
+
+  if (SetupRenderer().Failed())
+    return EZ_FAILURE;
+
+  if (ezCVarBool* pCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_BatchStateChanges")))
+  {
+    m_bPrevStateBatching = *pCVar;
+  }
+
+  SetStateBatching(false);
+
+  if (iIdentifier == SubTests::ST_CompareWithImmediateBinds)
+  {
+    CreateScene(s_uiNumObjects);
+
+    // The scene must be fully loaded, otherwise fallback resources would change the counters between frames
+    ezResourceManager::ForceNoFallbackAcquisition(s_uiWarmupFrames);
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRendererTestStateBatching::DeInitializeSubTest(ezInt32 iIdentifier)
+{
+  if (iIdentifier == SubTests::ST_CompareWithImmediateBinds)
+  {
+    DestroyScene();
+  }
+
+  SetStateBatching(m_bPrevStateBatching);
+
+  ShutdownRenderer();
+
+  if (ezNullRendererTest::DeInitializeSubTest(iIdentifier).Failed())
+    return EZ_FAILURE;
+
+  return EZ_SUCCESS;
+}
+
+ezTestAppRun ezRendererTestStateBatching::RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount)
+{
+  if (iIdentifier == SubTests::ST_PendingBinds)
+    return PendingBinds();
+
+  return CompareWithImmediateBinds();
+}
+
+ezTestAppRun ezRendererTestStateBatching::PendingBinds()
+{
+  // The encoder of a command list passes its platform calls to the command list, so every bind that reaches the platform is a recorded command
+  ezGALCommandList commandList(*m_pDevice);
+  ezGALCommandList executedList(*m_pDevice);
+
+  {
+    ezGALRenderCommandEncoder* pEncoder = executedList.BeginRecording();
+    pEncoder->SetPrimitiveTopology(ezGALPrimitiveTopology::Points);
+    pEncoder->Draw(3, 0);
+    executedList.EndRecording();
+  }
+
+  ezGALRenderCommandEncoder* pEncoder = commandList.BeginRecording();
+  pEncoder->SetStateBatchingEnabled(true);
+  pEncoder->ClearStatisticsCounters();
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Bind On Draw")
+  {
+    pEncoder->SetPrimitiveTopology(ezGALPrimitiveTopology::Triangles);
+    EZ_TEST_INT(commandList.GetCommandCount(), 0);
+
+    pEncoder->Draw(3, 0);
+    EZ_TEST_INT(commandList.GetCommandCount(), 2);
+    EZ_TEST_INT(pEncoder->GetStateChangeCount(), 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Pending Topology")
+  {
+    pEncoder->SetPrimitiveTopology(ezGALPrimitiveTopology::Lines);
+    EZ_TEST_INT(pEncoder->GetPrimitiveTopology(), ezGALPrimitiveTopology::Lines);
+    EZ_TEST_INT(commandList.GetCommandCount(), 2);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Reverted Bind")
+  {
+    // Triangles -> Lines -> Triangles
+    pEncoder->SetPrimitiveTopology(ezGALPrimitiveTopology::Triangles);
+    EZ_TEST_INT(pEncoder->GetPrimitiveTopology(), ezGALPrimitiveTopology::Triangles);
+    EZ_TEST_INT(pEncoder->GetAvoidedStateChangeCount(), 1);
+
+    pEncoder->Draw(3, 0);
+    EZ_TEST_INT(commandList.GetCommandCount(), 3);
+    EZ_TEST_INT(pEncoder->GetStateChangeCount(), 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Flush On Disable")
+  {
+    pEncoder->SetPrimitiveTopology(ezGALPrimitiveTopology::Lines);
+    EZ_TEST_INT(commandList.GetCommandCount(), 3);
+
+    pEncoder->SetStateBatchingEnabled(false);
+    EZ_TEST_INT(commandList.GetCommandCount(), 4);
+    EZ_TEST_INT(pEncoder->GetStateChangeCount(), 2);
+
+    // Immediate binds again
+    pEncoder->SetPrimitiveTopology(ezGALPrimitiveTopology::Triangles);
+    EZ_TEST_INT(commandList.GetCommandCount(), 5);
+
+    pEncoder->SetStateBatchingEnabled(true);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Execute Command List")
+  {
+    pEncoder->SetPrimitiveTopology(ezGALPrimitiveTopology::Lines);
+
+    // The pending topology is dropped, only the executed commands are recorded
+    pEncoder->ExecuteCommandList(executedList);
+    EZ_TEST_INT(commandList.GetCommandCount(), 5 + executedList.GetCommandCount());
+    EZ_TEST_INT(pEncoder->GetPrimitiveTopology(), ezGALPrimitiveTopology::ENUM_COUNT);
+
+    pEncoder->Draw(3, 0);
+    EZ_TEST_INT(commandList.GetCommandCount(), 6 + executedList.GetCommandCount());
+  }
+
+  pEncoder->SetStateBatchingEnabled(false);
+  commandList.EndRecording();
+
+  return ezTestAppRun::Quit;
+}
+
+ezTestAppRun ezRendererTestStateBatching::CompareWithImmediateBinds()
+{
+  const ezUInt32 uiFrame = static_cast<ezUInt32>(++m_iFrame);
+
+  if (uiFrame < s_uiWarmupFrames)
+  {
+    RenderFrame();
+    return ezTestAppRun::Continue;
+  }
+
+  if (uiFrame == s_uiWarmupFrames)
+  {
+    m_ImmediateBinds = RenderAndCountFrame();
+
+    EZ_TEST_BOOL(m_ImmediateBinds.m_uiDrawCalls > 0);
+    EZ_TEST_INT(m_ImmediateBinds.m_uiAvoidedStateChanges, 0);
+
+    SetStateBatching(true);
+    return ezTestAppRun::Continue;
+  }
+
+  const FrameCounters batchedBinds = RenderAndCountFrame();
+
+  EZ_TEST_INT(batchedBinds.m_uiDrawCalls, m_ImmediateBinds.m_uiDrawCalls);
+  EZ_TEST_INT(batchedBinds.m_uiClears, m_ImmediateBinds.m_uiClears);
+
+  // Batching may only remove binds, never add any
+  EZ_TEST_BOOL(batchedBinds.m_uiShaderChanges <= m_ImmediateBinds.m_uiShaderChanges);
+  EZ_TEST_BOOL(batchedBinds.m_uiConstantBufferChanges <= m_ImmediateBinds.m_uiConstantBufferChanges);
+  EZ_TEST_BOOL(batchedBinds.m_uiResourceBindings <= m_ImmediateBinds.m_uiResourceBindings);
+  EZ_TEST_BOOL(batchedBinds.m_uiGeometryChanges <= m_ImmediateBinds.m_uiGeometryChanges);
+  EZ_TEST_BOOL(batchedBinds.m_uiRenderStateChanges <= m_ImmediateBinds.m_uiRenderStateChanges);
+  EZ_TEST_BOOL(batchedBinds.m_uiAvoidedStateChanges > 0);
+
+  return ezTestAppRun::Quit;
+}
+
+ezRendererTestStateBatching::FrameCounters ezRendererTestStateBatching::RenderAndCountFrame()
+{
+  ezGALDeviceNull* pDevice = static_cast<ezGALDeviceNull*>(m_pDevice);
+  pDevice->ResetStatistics();
+  ezRenderContext::GetDefaultInstance()->GetAndResetStatistics();
+
+  RenderFrame();
+
+  const ezGALDeviceNull::Statistics& deviceStats = pDevice->GetStatistics();
+  const ezRenderContext::Statistics contextStats = ezRenderContext::GetDefaultInstance()->GetAndResetStatistics();
+
+  FrameCounters counters;
+  counters.m_uiClears = deviceStats.m_uiClears;
+  counters.m_uiDrawCalls = deviceStats.m_uiDrawCalls;
+  counters.m_uiShaderChanges = deviceStats.m_uiShaderChanges;
+  counters.m_uiConstantBufferChanges = deviceStats.m_uiConstantBufferChanges;
+  counters.m_uiResourceBindings = deviceStats.m_uiResourceBindings;
+  counters.m_uiGeometryChanges = deviceStats.m_uiGeometryChanges;
+  counters.m_uiRenderStateChanges = deviceStats.m_uiRenderStateChanges;
+  counters.m_uiAvoidedStateChanges = contextStats.m_uiAvoidedStateChanges;
+  return counters;
+}
+
+void ezRendererTestStateBatching::SetStateBatching(bool bEnable)
+{
+  if (ezCVarBool* pCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_BatchStateChanges")))
+  {
+    *pCVar = bEnable;
+  }
+}
+
+static ezRendererTestStateBatching g_StateBatchingTest;
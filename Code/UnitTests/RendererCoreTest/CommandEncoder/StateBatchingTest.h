@@ -0,0 +1,49 @@
+#pragma once
+
+#include "../TestClass/TestClass.h"
+
+/// \brief Tests the batching of state changes in the GAL command encoders, see ezGALCommandEncoder::SetStateBatchingEnabled().
+class ezRendererTestStateBatching : public ezNullRendererTest
+{
+public:
+  virtual const char* GetTestName() const override { return "StateBatching"; }
+
+private:
+  enum SubTests
+  {
+    ST_PendingBinds,
+    ST_CompareWithImmediateBinds,
+  };
+
+  virtual void SetupSubTests() override
+  {
+    AddSubTest("Pending Binds", SubTests::ST_PendingBinds);
+    AddSubTest("Compare With Immediate Binds", SubTests::ST_CompareWithImmediateBinds);
+  }
+
+  virtual ezResult InitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezResult DeInitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezTestAppRun RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount) override;
+
+  ezTestAppRun PendingBinds();
+  ezTestAppRun CompareWithImmediateBinds();
+
+  struct FrameCounters
+  {
+    ezUInt32 m_uiClears = 0;
+    ezUInt32 m_uiDrawCalls = 0;
+    ezUInt32 m_uiShaderChanges = 0;
+    ezUInt32 m_uiConstantBufferChanges = 0;
+    ezUInt32 m_uiResourceBindings = 0;
+    ezUInt32 m_uiGeometryChanges = 0;
+    ezUInt32 m_uiRenderStateChanges = 0;
+    ezUInt32 m_uiAvoidedStateChanges = 0;
+  };
+
+  FrameCounters RenderAndCountFrame();
+  void SetStateBatching(bool bEnable);
+
+  ezInt32 m_iFrame = 0;
+  bool m_bPrevStateBatching = false;
+  FrameCounters m_ImmediateBinds;
+};
@@ -0,0 +1,122 @@
+#include <RendererCoreTestPCH.h>
+
+#include "GPUResourcePoolTest.h"
+#include <RendererCore/GPUResourcePool/GPUResourcePool.h>
+#include <RendererFoundation/Resources/Texture.h>
+
+namespace
+{
+  ezGALTextureCreationDescription CreateTargetDesc(bool bAllowUAV)
+  {
+    ezGALTextureCreationDescription desc;
+    desc.m_bCreateRenderTarget = true;
+    desc.m_bAllowShaderResourceView = !bAllowUAV;
+    desc.m_bAllowUAV = bAllowUAV;
+    desc.m_Format = ezGALResourceFormat::RGBAHalf;
+    desc.m_Type = ezGALTextureType::Texture2D;
+    desc.m_uiWidth = 64;
+    desc.m_uiHeight = 64;
+    return desc;
+  }
+} // namespace
+
+ezResult ezRendererTestGPUResourcePool::InitializeSubTest(ezInt32 iIdentifier)
+{
+  if (ezNullRendererTest::InitializeSubTest(iIdentifier).Failed())
+    return EZ_FAILURE;
+
+  if (SetupRenderer().Failed())
+    return EZ_FAILURE;
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRendererTestGPUResourcePool::DeInitializeSubTest(ezInt32 iIdentifier)
+{
+  ShutdownRenderer();
+
+  if (ezNullRendererTest::DeInitializeSubTest(iIdentifier).Failed())
+    return EZ_FAILURE;
+
+  return EZ_SUCCESS;
+}
+
+ezTestAppRun ezRendererTestGPUResourcePool::RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount)
+{
+  ezGPUResourcePool pool;
+
+  const ezGALTextureCreationDescription srvDesc = CreateTargetDesc(false);
+  const ezGALTextureCreationDescription uavDesc = CreateTargetDesc(true);
+
+  EZ_TEST_INT(ezGPUResourcePool::CalculateAliasingHash(srvDesc), ezGPUResourcePool::CalculateAliasingHash(uavDesc));
+
+  ezGALTextureHandle hSrvTarget;
+  ezGALTextureHandle hUavTarget;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Different Usages")
+  {
+    hSrvTarget = pool.GetRenderTarget(srvDesc);
+    hUavTarget = pool.GetRenderTarget(uavDesc);
+    EZ_TEST_BOOL(!hSrvTarget.IsInvalidated());
+    EZ_TEST_BOOL(!hUavTarget.IsInvalidated());
+    EZ_TEST_BOOL(hSrvTarget != hUavTarget);
+
+    // The second texture is created with all usages requested so far
+    const ezGALTextureCreationDescription& desc = m_pDevice->GetTexture(hUavTarget)->GetDescription();
+    EZ_TEST_BOOL(desc.m_bCreateRenderTarget);
+    EZ_TEST_BOOL(desc.m_bAllowShaderResourceView);
+    EZ_TEST_BOOL(desc.m_bAllowUAV);
+
+    pool.ReturnRenderTarget(hSrvTarget);
+    pool.ReturnRenderTarget(hUavTarget);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Reuse")
+  {
+    // Only the second texture supports UAVs
+    EZ_TEST_BOOL(pool.GetRenderTarget(uavDesc) == hUavTarget);
+    EZ_TEST_BOOL(pool.GetRenderTarget(srvDesc) == hSrvTarget);
+
+    // Both textures are in use now, a new one has to be created
+    ezGALTextureHandle hThirdTarget = pool.GetRenderTarget(srvDesc);
+    EZ_TEST_BOOL(hThirdTarget != hSrvTarget && hThirdTarget != hUavTarget);
+    EZ_TEST_BOOL(m_pDevice->GetTexture(hThirdTarget)->GetDescription().m_bAllowUAV);
+
+    pool.ReturnRenderTarget(hThirdTarget);
+    pool.ReturnRenderTarget(hSrvTarget);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "GC Keeps Usages Of Live Textures")
+  {
+    // The UAV target is still in use and survives the GC, so do its usages
+    pool.RunGC();
+
+    const ezGALTextureHandle hNewTarget = pool.GetRenderTarget(srvDesc);
+    EZ_TEST_BOOL(hNewTarget != hSrvTarget && hNewTarget != hUavTarget);
+    EZ_TEST_BOOL(m_pDevice->GetTexture(hNewTarget)->GetDescription().m_bAllowUAV);
+    hSrvTarget = hNewTarget;
+
+    pool.ReturnRenderTarget(hSrvTarget);
+    pool.ReturnRenderTarget(hUavTarget);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "GC Prunes Usages")
+  {
+    // No texture of this description is alive anymore, new textures only get the requested usages
+    pool.RunGC();
+
+    const ezGALTextureHandle hNewTarget = pool.GetRenderTarget(srvDesc);
+    EZ_TEST_BOOL(hNewTarget != hSrvTarget && hNewTarget != hUavTarget);
+    hSrvTarget = hNewTarget;
+
+    const ezGALTextureCreationDescription& desc = m_pDevice->GetTexture(hSrvTarget)->GetDescription();
+    EZ_TEST_BOOL(desc.m_bAllowShaderResourceView);
+    EZ_TEST_BOOL(!desc.m_bAllowUAV);
+
+    pool.ReturnRenderTarget(hSrvTarget);
+  }
+
+  return ezTestAppRun::Quit;
+}
+
+static ezRendererTestGPUResourcePool g_GPUResourcePoolTest;
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "../TestClass/TestClass.h"
+
+/// \brief Tests that the GPU resource pool shares render targets between descriptions that only differ in their usage flags.
+class ezRendererTestGPUResourcePool : public ezNullRendererTest
+{
+public:
+  virtual const char* GetTestName() const override { return "GPUResourcePool"; }
+
+private:
+  enum SubTests
+  {
+    ST_UsageAliasing,
+  };
+
+  virtual void SetupSubTests() override { AddSubTest("Usage Aliasing", SubTests::ST_UsageAliasing); }
+
+  virtual ezResult InitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezResult DeInitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezTestAppRun RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount) override;
+};
@@ -0,0 +1,191 @@
+#include <RendererCoreTestPCH.h>
+
+#include "Performance.h"
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Utilities/CommandLineUtils.h>
+#include <RendererCore/Pipeline/RenderPipeline.h>
+#include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderContext/RenderContext.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+#include <RendererNull/Device/DeviceNull.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiWarmupFrames = 10;
+  constexpr ezUInt32 s_uiMeasuredFrames = 100;
+} // namespace
+
+std::string ezRendererTestPerformance::IsTestAvailable() const
+{
+  if (!ezCommandLineUtils::GetGlobalInstance()->GetBoolOption("-benchmark"))
+  {
+    return "Renderer benchmarks only run when '-benchmark' is passed on the command line.";
+  }
+
+  return {};
+}
+
+ezResult ezRendererTestPerformance::InitializeSubTest(ezInt32 iIdentifier)
+{
+  m_iFrame = -1;
+
+  m_FrameTime.SetZero();
+  m_VisibilityCullingTime.SetZero();
+  m_ExtractionTime.SetZero();
+  m_SortingTime.SetZero();
+  m_RenderingTime.SetZero();
+  m_uiNumVisibleObjects = 0;
+  m_uiDrawCalls = 0;
+  m_uiShaderChanges = 0;
+  m_uiConstantBufferChanges = 0;
+  m_uiResourceBindings = 0;
+  m_uiStateChanges = 0;
+  m_uiUploadedBytes = 0;
+  m_uiRedundantStateChanges = 0;
+  m_uiAvoidedStateChanges = 0;
+
+  if (ezNullRendererTest::InitializeSubTest(iIdentifier).Failed())
+    return EZ_FAILURE;
+
+  if (SetupRenderer().Failed())
+    return EZ_FAILURE;
+
+  // Extract and render on the same thread, otherwise the timings of one frame would overlap with the next one
+  if (ezCVarBool* pCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_Multithreading")))
+  {
+    m_bMultithreadedRendering = *pCVar;
+    *pCVar = false;
+  }
+
+  switch (iIdentifier)
+  {
+    case SubTests::ST_Objects1k:
+      m_uiNumObjects = 1000;
+      break;
+    case SubTests::ST_Objects10k:
+      m_uiNumObjects = 10000;
+      break;
+    case SubTests::ST_Objects50k:
+      m_uiNumObjects = 50000;
+      break;
+    case SubTests::ST_Objects10kStateBatching:
+      m_uiNumObjects = 10000;
+      break;
+    case SubTests::ST_Objects50kStateBatching:
+      m_uiNumObjects = 50000;
+      break;
+  }
+
+  // The same scenes with and without state batching show how many API calls it saves
+  m_bStateBatching = iIdentifier == SubTests::ST_Objects10kStateBatching || iIdentifier == SubTests::ST_Objects50kStateBatching;
+  if (ezCVarBool* pCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_BatchStateChanges")))
+  {
+    m_bPrevStateBatching = *pCVar;
+    *pCVar = m_bStateBatching;
+  }
+
+  CreateScene(m_uiNumObjects);
+
+  // Shaders and meshes must be fully loaded before the first measured frame
+  ezResourceManager::ForceNoFallbackAcquisition(s_uiWarmupFrames);
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRendererTestPerformance::DeInitializeSubTest(ezInt32 iIdentifier)
+{
+  DestroyScene();
+
+  if (ezCVarBool* pCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_Multithreading")))
+  {
+    *pCVar = m_bMultithreadedRendering;
+  }
+
+  if (ezCVarBool* pCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_BatchStateChanges")))
+  {
+    *pCVar = m_bPrevStateBatching;
+  }
+
+  ShutdownRenderer();
+
+  if (ezNullRendererTest::DeInitializeSubTest(iIdentifier).Failed())
+    return EZ_FAILURE;
+
+  return EZ_SUCCESS;
+}
+
+ezTestAppRun ezRendererTestPerformance::RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount)
+{
+  const ezUInt32 uiFrame = static_cast<ezUInt32>(++m_iFrame);
+
+  if (uiFrame < s_uiWarmupFrames)
+  {
+    RenderFrame();
+    return ezTestAppRun::Continue;
+  }
+
+  ezGALDeviceNull* pDevice = static_cast<ezGALDeviceNull*>(m_pDevice);
+  pDevice->ResetStatistics();
+  ezRenderContext::GetDefaultInstance()->GetAndResetStatistics();
+
+  const ezTime startTime = ezTime::Now();
+  RenderFrame();
+  m_FrameTime += ezTime::Now() - startTime;
+
+  ezView* pView = nullptr;
+  if (ezRenderWorld::TryGetView(m_hView, pView) && pView->GetRenderPipeline() != nullptr)
+  {
+    const ezRenderPipeline::Statistics& pipelineStats = pView->GetRenderPipeline()->GetStatistics();
+    m_VisibilityCullingTime += pipelineStats.m_VisibilityCullingTime;
+    m_ExtractionTime += pipelineStats.m_ExtractionTime;
+    m_SortingTime += pipelineStats.m_SortingTime;
+    m_RenderingTime += pipelineStats.m_RenderingTime;
+    m_uiNumVisibleObjects += pipelineStats.m_uiNumVisibleObjects;
+  }
+
+  const ezGALDeviceNull::Statistics& deviceStats = pDevice->GetStatistics();
+  m_uiDrawCalls += deviceStats.m_uiDrawCalls;
+  m_uiShaderChanges += deviceStats.m_uiShaderChanges;
+  m_uiConstantBufferChanges += deviceStats.m_uiConstantBufferChanges;
+  m_uiResourceBindings += deviceStats.m_uiResourceBindings;
+  m_uiStateChanges += deviceStats.m_uiRenderStateChanges + deviceStats.m_uiGeometryChanges;
+  m_uiUploadedBytes += deviceStats.m_uiUploadedBytes;
+
+  const ezRenderContext::Statistics contextStats = ezRenderContext::GetDefaultInstance()->GetAndResetStatistics();
+  m_uiRedundantStateChanges += contextStats.m_uiRedundantStateChanges;
+  m_uiAvoidedStateChanges += contextStats.m_uiAvoidedStateChanges;
+
+  if (uiFrame + 1 < s_uiWarmupFrames + s_uiMeasuredFrames)
+    return ezTestAppRun::Continue;
+
+  ReportResults();
+  return ezTestAppRun::Quit;
+}
+
+void ezRendererTestPerformance::ReportResults()
+{
+  const double fFrames = s_uiMeasuredFrames;
+
+  ezTestFramework::Output(ezTestOutput::Duration, "%u objects (%.0f visible): frame %.3fms, culling %.3fms, extraction %.3fms, sorting %.3fms, command submission %.3fms", m_uiNumObjects,
+    m_uiNumVisibleObjects / fFrames, m_FrameTime.GetMilliseconds() / fFrames, m_VisibilityCullingTime.GetMilliseconds() / fFrames, m_ExtractionTime.GetMilliseconds() / fFrames,
+    m_SortingTime.GetMilliseconds() / fFrames, m_RenderingTime.GetMilliseconds() / fFrames);
+
+  ezTestFramework::Output(ezTestOutput::Details, "Per frame: %.0f draw calls, %.0f shader changes, %.0f constant buffer changes, %.0f resource bindings, %.0f state changes, %.1f KB uploaded",
+    m_uiDrawCalls / fFrames, m_uiShaderChanges / fFrames, m_uiConstantBufferChanges / fFrames, m_uiResourceBindings / fFrames, m_uiStateChanges / fFrames,
+    m_uiUploadedBytes / fFrames / 1024.0);
+
+  ezView* pView = nullptr;
+  if (ezRenderWorld::TryGetView(m_hView, pView) && pView->GetRenderPipeline() != nullptr)
+  {
+    const ezRenderPipeline::Statistics& pipelineStats = pView->GetRenderPipeline()->GetStatistics();
+    const double fToMB = 1.0 / (1024.0 * 1024.0);
+
+    ezTestFramework::Output(ezTestOutput::Details, "%u intermediate render targets: %.2f MB, %.2f MB with aliasing", pipelineStats.m_uiNumTransientTargets,
+      pipelineStats.m_uiTransientTargetMemory * fToMB, pipelineStats.m_uiAliasedTransientTargetMemory * fToMB);
+  }
+
+  ezTestFramework::Output(ezTestOutput::Details, "Per frame: %.0f redundant state changes skipped, %.0f state changes avoided by state batching (%s)", m_uiRedundantStateChanges / fFrames,
+    m_uiAvoidedStateChanges / fFrames, m_bStateBatching ? "enabled" : "disabled");
+}
+
+static ezRendererTestPerformance g_PerformanceTest;
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../TestClass/TestClass.h"
+
+/// \brief Measures the CPU cost of the renderer for large synthetic scenes.
+///
+/// Runs on the 'Null' device, so no GPU is needed and the numbers only contain the work done on the CPU.
+/// The test is only available when '-benchmark' is passed on the command line.
+class ezRendererTestPerformance : public ezNullRendererTest
+{
+public:
+  virtual const char* GetTestName() const override { return "Performance"; }
+  virtual std::string IsTestAvailable() const override;
+
+private:
+  enum SubTests
+  {
+    ST_Objects1k,
+    ST_Objects10k,
+    ST_Objects50k,
+    ST_Objects10kStateBatching,
+    ST_Objects50kStateBatching,
+  };
+
+  virtual void SetupSubTests() override
+  {
+    AddSubTest("1k Objects", SubTests::ST_Objects1k);
+    AddSubTest("10k Objects", SubTests::ST_Objects10k);
+    AddSubTest("50k Objects", SubTests::ST_Objects50k);
+    AddSubTest("10k Objects State Batching", SubTests::ST_Objects10kStateBatching);
+    AddSubTest("50k Objects State Batching", SubTests::ST_Objects50kStateBatching);
+  }
+
+  virtual ezResult InitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezResult DeInitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezTestAppRun RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount) override;
+
+  void ReportResults();
+
+  ezUInt32 m_uiNumObjects = 0;
+  ezInt32 m_iFrame = 0;
+  bool m_bMultithreadedRendering = true;
+  bool m_bStateBatching = false;
+  bool m_bPrevStateBatching = false;
+
+  // Accumulated over all measured frames
+  ezTime m_FrameTime;
+  ezTime m_VisibilityCullingTime;
+  ezTime m_ExtractionTime;
+  ezTime m_SortingTime;
+  ezTime m_RenderingTime;
+  ezUInt64 m_uiNumVisibleObjects = 0;
+  ezUInt64 m_uiDrawCalls = 0;
+  ezUInt64 m_uiShaderChanges = 0;
+  ezUInt64 m_uiConstantBufferChanges = 0;
+  ezUInt64 m_uiResourceBindings = 0;
+  ezUInt64 m_uiStateChanges = 0;
+  ezUInt64 m_uiUploadedBytes = 0;
+  ezUInt64 m_uiRedundantStateChanges = 0;
+  ezUInt64 m_uiAvoidedStateChanges = 0;
+};
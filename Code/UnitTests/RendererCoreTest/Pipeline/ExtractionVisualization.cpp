@@ -0,0 +1,137 @@
+#include <RendererCoreTestPCH.h>
+
+#include "ExtractionVisualization.h"
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <RendererNull/Device/DeviceNull.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiWarmupFrames = 10;
+
+  // Enough visible objects to split the extraction into several chunks
+  constexpr ezUInt32 s_uiNumObjects = 10000;
+} // namespace
+
+ezResult ezRendererTestExtractionVisualization::InitializeSubTest(ezInt32 iIdentifier)
+{
+  m_iFrame = -1;
+  m_SerialExtraction = FrameCounters();
+
+  if (ezNullRendererTest::InitializeSubTest(iIdentifier).Failed())
+    return EZ_FAILURE;
+
+  if (SetupRenderer().Failed())
+    return EZ_FAILURE;
+
+  // Objects are only extracted in parallel with multi-threaded rendering
+  if (ezCVarBool* pCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_Multithreading")))
+  {
+    m_bPrevMultithreadedRendering = *pCVar;
+    *pCVar = true;
+  }
+
+  if (ezCVarBool* pCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_VisBounds")))
+  {
+    m_bPrevVisBounds = *pCVar;
+    *pCVar = true;
+  }
+
+  // With a single short task worker the objects are extracted in one chunk
+  m_uiPrevShortTaskWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+  m_uiPrevLongTaskWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::LongTasks);
+  m_uiPrevFileAccessWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::FileAccess);
+  SetShortTaskWorkers(1);
+
+  CreateScene(s_uiNumObjects);
+
+  // The scene must be fully loaded, otherwise fallback resources would change the counters between frames
+  ezResourceManager::ForceNoFallbackAcquisition(s_uiWarmupFrames);
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRendererTestExtractionVisualization::DeInitializeSubTest(ezInt32 iIdentifier)
+{
+  DestroyScene();
+
+  if (ezCVarBool* pCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_Multithreading")))
+  {
+    *pCVar = m_bPrevMultithreadedRendering;
+  }
+
+  if (ezCVarBool* pCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_VisBounds")))
+  {
+    *pCVar = m_bPrevVisBounds;
+  }
+
+  SetShortTaskWorkers(m_uiPrevShortTaskWorkers);
+
+  ShutdownRenderer();
+
+  if (ezNullRendererTest::DeInitializeSubTest(iIdentifier).Failed())
+    return EZ_FAILURE;
+
+  return EZ_SUCCESS;
+}
+
+ezTestAppRun ezRendererTestExtractionVisualization::RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount)
+{
+  const ezUInt32 uiFrame = static_cast<ezUInt32>(++m_iFrame);
+
+  if (uiFrame < s_uiWarmupFrames)
+  {
+    RenderFrame();
+    return ezTestAppRun::Continue;
+  }
+
+  if (uiFrame == s_uiWarmupFrames)
+  {
+    m_SerialExtraction = RenderAndCountFrame();
+
+    EZ_TEST_BOOL(m_SerialExtraction.m_uiDrawCalls > 0);
+    EZ_TEST_BOOL(m_SerialExtraction.m_uiUploadedBytes > 0);
+
+    SetShortTaskWorkers(ezMath::Max<ezUInt32>(m_uiPrevShortTaskWorkers, 4));
+    return ezTestAppRun::Continue;
+  }
+
+  // Multi-threaded rendering renders the data that was extracted in the previous frame
+  if (uiFrame == s_uiWarmupFrames + 1)
+  {
+    RenderFrame();
+    return ezTestAppRun::Continue;
+  }
+
+  const FrameCounters parallelExtraction = RenderAndCountFrame();
+
+  // The lines of all bounding boxes are uploaded to the debug renderer's buffers, a lost or duplicated box changes the uploaded bytes
+  EZ_TEST_INT(parallelExtraction.m_uiDrawCalls, m_SerialExtraction.m_uiDrawCalls);
+  EZ_TEST_INT(parallelExtraction.m_uiResourceUpdates, m_SerialExtraction.m_uiResourceUpdates);
+  EZ_TEST_BOOL(parallelExtraction.m_uiUploadedBytes == m_SerialExtraction.m_uiUploadedBytes);
+
+  return ezTestAppRun::Quit;
+}
+
+ezRendererTestExtractionVisualization::FrameCounters ezRendererTestExtractionVisualization::RenderAndCountFrame()
+{
+  ezGALDeviceNull* pDevice = static_cast<ezGALDeviceNull*>(m_pDevice);
+  pDevice->ResetStatistics();
+
+  RenderFrame();
+
+  const ezGALDeviceNull::Statistics& deviceStats = pDevice->GetStatistics();
+
+  FrameCounters counters;
+  counters.m_uiDrawCalls = deviceStats.m_uiDrawCalls;
+  counters.m_uiResourceUpdates = deviceStats.m_uiResourceUpdates;
+  counters.m_uiUploadedBytes = deviceStats.m_uiUploadedBytes;
+  return counters;
+}
+
+void ezRendererTestExtractionVisualization::SetShortTaskWorkers(ezUInt32 uiNumWorkers)
+{
+  ezTaskSystem::SetWorkerThreadCount(uiNumWorkers, m_uiPrevLongTaskWorkers, m_uiPrevFileAccessWorkers);
+}
+
+static ezRendererTestExtractionVisualization g_ExtractionVisualizationTest;
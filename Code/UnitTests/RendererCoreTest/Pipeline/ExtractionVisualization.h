@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../TestClass/TestClass.h"
+
+/// \brief Renders the object bounds visualization with serial and with parallel extraction and compares the counters of the Null device.
+///
+/// Components and extractors call the debug renderer while they are extracted, with parallel extraction that happens on several
+/// threads at once. No primitive may get lost or duplicated on the way.
+class ezRendererTestExtractionVisualization : public ezNullRendererTest
+{
+public:
+  virtual const char* GetTestName() const override { return "ExtractionVisualization"; }
+
+private:
+  enum SubTests
+  {
+    ST_CompareWithSerialExtraction,
+  };
+
+  virtual void SetupSubTests() override { AddSubTest("Compare With Serial Extraction", SubTests::ST_CompareWithSerialExtraction); }
+
+  virtual ezResult InitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezResult DeInitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezTestAppRun RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount) override;
+
+  struct FrameCounters
+  {
+    ezUInt32 m_uiDrawCalls = 0;
+    ezUInt32 m_uiResourceUpdates = 0;
+    ezUInt64 m_uiUploadedBytes = 0;
+  };
+
+  FrameCounters RenderAndCountFrame();
+  void SetShortTaskWorkers(ezUInt32 uiNumWorkers);
+
+  ezInt32 m_iFrame = 0;
+  bool m_bPrevMultithreadedRendering = true;
+  bool m_bPrevVisBounds = false;
+  ezUInt32 m_uiPrevShortTaskWorkers = 0;
+  ezUInt32 m_uiPrevLongTaskWorkers = 0;
+  ezUInt32 m_uiPrevFileAccessWorkers = 0;
+  FrameCounters m_SerialExtraction;
+};
@@ -0,0 +1,139 @@
+#include <RendererCoreTestPCH.h>
+
+#include "ParallelRecording.h"
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <RendererCore/RenderContext/RenderContext.h>
+#include <RendererNull/Device/DeviceNull.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiWarmupFrames = 10;
+
+  // Enough visible objects in the opaque category to split them into several recording jobs
+  constexpr ezUInt32 s_uiNumObjects = 10000;
+} // namespace
+
+ezResult ezRendererTestParallelRecording::InitializeSubTest(ezInt32 iIdentifier)
+{
+  m_iFrame = -1;
+  m_DirectSubmission = FrameCounters();
+
+  if (ezNullRendererTest::InitializeSubTest(iIdentifier).Failed())
+    return EZ_FAILURE;
+
+  if (SetupRenderer().Failed())
+    return EZ_FAILURE;
+
+  // Parallel recording is only used together with multi-threaded rendering
+  if (ezCVarBool* pCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_Multithreading")))
+  {
+    m_bPrevMultithreadedRendering = *pCVar;
+    *pCVar = true;
+  }
+
+  if (ezCVarBool* pCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_ParallelRecording")))
+  {
+    m_bPrevParallelRecording = *pCVar;
+  }
+
+  SetParallelRecording(false);
+
+  // The number of recording jobs is limited by the number of workers, machines with few cores would not record in parallel at all
+  m_uiPrevShortTaskWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+  m_uiPrevLongTaskWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::LongTasks);
+  m_uiPrevFileAccessWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::FileAccess);
+  ezTaskSystem::SetWorkerThreadCount(ezMath::Max<ezInt32>(m_uiPrevShortTaskWorkers, 4), m_uiPrevLongTaskWorkers, m_uiPrevFileAccessWorkers);
+
+  CreateScene(s_uiNumObjects);
+
+  // The scene must be fully loaded, otherwise fallback resources would change the counters between frames
+  ezResourceManager::ForceNoFallbackAcquisition(s_uiWarmupFrames);
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRendererTestParallelRecording::DeInitializeSubTest(ezInt32 iIdentifier)
+{
+  DestroyScene();
+
+  if (ezCVarBool* pCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_Multithreading")))
+  {
+    *pCVar = m_bPrevMultithreadedRendering;
+  }
+
+  SetParallelRecording(m_bPrevParallelRecording);
+
+  ezTaskSystem::SetWorkerThreadCount(m_uiPrevShortTaskWorkers, m_uiPrevLongTaskWorkers, m_uiPrevFileAccessWorkers);
+
+  ShutdownRenderer();
+
+  if (ezNullRendererTest::DeInitializeSubTest(iIdentifier).Failed())
+    return EZ_FAILURE;
+
+  return EZ_SUCCESS;
+}
+
+ezTestAppRun ezRendererTestParallelRecording::RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount)
+{
+  const ezUInt32 uiFrame = static_cast<ezUInt32>(++m_iFrame);
+
+  if (uiFrame < s_uiWarmupFrames)
+  {
+    RenderFrame();
+    return ezTestAppRun::Continue;
+  }
+
+  if (uiFrame == s_uiWarmupFrames)
+  {
+    m_DirectSubmission = RenderAndCountFrame();
+
+    EZ_TEST_BOOL(m_DirectSubmission.m_uiDrawCalls > 0);
+    EZ_TEST_INT(m_DirectSubmission.m_uiExecutedCommandLists, 0);
+
+    SetParallelRecording(true);
+    return ezTestAppRun::Continue;
+  }
+
+  const FrameCounters parallelRecording = RenderAndCountFrame();
+
+  EZ_TEST_BOOL(parallelRecording.m_uiExecutedCommandLists > 0);
+
+  // Recording contexts must produce exactly the same commands as the primary context
+  EZ_TEST_INT(parallelRecording.m_uiRenderingScopes, m_DirectSubmission.m_uiRenderingScopes);
+  EZ_TEST_INT(parallelRecording.m_uiClears, m_DirectSubmission.m_uiClears);
+  EZ_TEST_INT(parallelRecording.m_uiDrawCalls, m_DirectSubmission.m_uiDrawCalls);
+  EZ_TEST_INT(parallelRecording.m_uiFailedDrawcalls, m_DirectSubmission.m_uiFailedDrawcalls);
+
+  return ezTestAppRun::Quit;
+}
+
+ezRendererTestParallelRecording::FrameCounters ezRendererTestParallelRecording::RenderAndCountFrame()
+{
+  ezGALDeviceNull* pDevice = static_cast<ezGALDeviceNull*>(m_pDevice);
+  pDevice->ResetStatistics();
+  ezRenderContext::GetDefaultInstance()->GetAndResetStatistics();
+
+  RenderFrame();
+
+  const ezGALDeviceNull::Statistics& deviceStats = pDevice->GetStatistics();
+  const ezRenderContext::Statistics contextStats = ezRenderContext::GetDefaultInstance()->GetAndResetStatistics();
+
+  FrameCounters counters;
+  counters.m_uiRenderingScopes = deviceStats.m_uiRenderingScopes;
+  counters.m_uiClears = deviceStats.m_uiClears;
+  counters.m_uiDrawCalls = deviceStats.m_uiDrawCalls;
+  counters.m_uiFailedDrawcalls = contextStats.m_uiFailedDrawcalls;
+  counters.m_uiExecutedCommandLists = contextStats.m_uiExecutedCommandLists;
+  return counters;
+}
+
+void ezRendererTestParallelRecording::SetParallelRecording(bool bEnable)
+{
+  if (ezCVarBool* pCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("r_ParallelRecording")))
+  {
+    *pCVar = bEnable;
+  }
+}
+
+static ezRendererTestParallelRecording g_ParallelRecordingTest;
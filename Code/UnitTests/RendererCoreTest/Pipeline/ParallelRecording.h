@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../TestClass/TestClass.h"
+
+/// \brief Renders the same frame with direct submission and with parallel recording and compares the counters of the Null device.
+class ezRendererTestParallelRecording : public ezNullRendererTest
+{
+public:
+  virtual const char* GetTestName() const override { return "ParallelRecording"; }
+
+private:
+  enum SubTests
+  {
+    ST_CompareWithDirectSubmission,
+  };
+
+  virtual void SetupSubTests() override { AddSubTest("Compare With Direct Submission", SubTests::ST_CompareWithDirectSubmission); }
+
+  virtual ezResult InitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezResult DeInitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezTestAppRun RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount) override;
+
+  struct FrameCounters
+  {
+    ezUInt32 m_uiRenderingScopes = 0;
+    ezUInt32 m_uiClears = 0;
+    ezUInt32 m_uiDrawCalls = 0;
+    ezUInt32 m_uiFailedDrawcalls = 0;
+    ezUInt32 m_uiExecutedCommandLists = 0;
+  };
+
+  FrameCounters RenderAndCountFrame();
+  void SetParallelRecording(bool bEnable);
+
+  ezInt32 m_iFrame = 0;
+  bool m_bPrevMultithreadedRendering = true;
+  bool m_bPrevParallelRecording = false;
+  ezUInt32 m_uiPrevShortTaskWorkers = 0;
+  ezUInt32 m_uiPrevLongTaskWorkers = 0;
+  ezUInt32 m_uiPrevFileAccessWorkers = 0;
+  FrameCounters m_DirectSubmission;
+};
@@ -0,0 +1,184 @@
+#include <RendererCoreTestPCH.h>
+
+#include "TransientTargets.h"
+#include <Foundation/Utilities/Stats.h>
+#include <RendererCore/Pipeline/Implementation/RenderPipelineResourceLoader.h>
+#include <RendererCore/Pipeline/Passes/CopyTexturePass.h>
+#include <RendererCore/Pipeline/Passes/SourcePass.h>
+#include <RendererCore/Pipeline/Passes/TargetPass.h>
+#include <RendererCore/Pipeline/RenderPipeline.h>
+#include <RendererCore/Pipeline/RenderPipelineResource.h>
+#include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiWarmupFrames = 3;
+  constexpr ezUInt32 s_uiNumCopyPasses = 3;
+  constexpr ezUInt32 s_uiResolutionX = 640;
+  constexpr ezUInt32 s_uiResolutionY = 360;
+
+  ezUInt32 CountTransientMemoryStats()
+  {
+    ezUInt32 uiCount = 0;
+    for (auto it = ezStats::GetAllStats().GetIterator(); it.IsValid(); ++it)
+    {
+      if (it.Key().StartsWith("Render Pipeline/TransientTargets (") && it.Key().EndsWith("/Transient Memory Saved"))
+      {
+        ++uiCount;
+      }
+    }
+    return uiCount;
+  }
+} // namespace
+
+ezResult ezRendererTestTransientTargets::InitializeSubTest(ezInt32 iIdentifier)
+{
+  m_iFrame = -1;
+
+  if (ezNullRendererTest::InitializeSubTest(iIdentifier).Failed())
+    return EZ_FAILURE;
+
+  if (SetupRenderer().Failed())
+    return EZ_FAILURE;
+
+  ezWorldDesc worldDesc("TransientTargets");
+  m_pWorld = EZ_DEFAULT_NEW(ezWorld, worldDesc);
+
+  CreateCopyChainView();
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRendererTestTransientTargets::DeInitializeSubTest(ezInt32 iIdentifier)
+{
+  DestroyScene();
+
+  ShutdownRenderer();
+
+  if (ezNullRendererTest::DeInitializeSubTest(iIdentifier).Failed())
+    return EZ_FAILURE;
+
+  return EZ_SUCCESS;
+}
+
+ezTestAppRun ezRendererTestTransientTargets::RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount)
+{
+  const ezUInt32 uiFrame = static_cast<ezUInt32>(++m_iFrame);
+
+  // The pipeline is created and rebuilt on the first frames the view is extracted
+  if (uiFrame < s_uiWarmupFrames)
+  {
+    RenderFrame();
+    return ezTestAppRun::Continue;
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Aliased Memory")
+  {
+    ezView* pView = nullptr;
+    EZ_TEST_BOOL(ezRenderWorld::TryGetView(m_hView, pView));
+    if (pView == nullptr || pView->GetRenderPipeline() == nullptr)
+      return ezTestAppRun::Quit;
+
+    ezGALTextureCreationDescription desc;
+    desc.m_uiWidth = s_uiResolutionX;
+    desc.m_uiHeight = s_uiResolutionY;
+    desc.m_Format = ezGALResourceFormat::RGBAUByteNormalizedsRGB;
+    desc.m_bCreateRenderTarget = true;
+
+    const ezUInt64 uiTextureMemory = m_pDevice->GetMemoryConsumptionForTexture(desc);
+    EZ_TEST_BOOL(uiTextureMemory > 0);
+
+    // The output of the last copy pass is the view's render target, all other outputs come from the pool. The source output is
+    // returned after the first copy pass, so the second copy pass reuses its texture and only two textures are ever alive at once.
+    const ezRenderPipeline::Statistics& stats = pView->GetRenderPipeline()->GetStatistics();
+    EZ_TEST_INT(stats.m_uiNumTransientTargets, s_uiNumCopyPasses);
+    EZ_TEST_BOOL(stats.m_uiTransientTargetMemory == s_uiNumCopyPasses * uiTextureMemory);
+    EZ_TEST_BOOL(stats.m_uiAliasedTransientTargetMemory == 2 * uiTextureMemory);
+  }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Stat Per Pipeline")
+  {
+    EZ_TEST_INT(CountTransientMemoryStats(), 1);
+
+    ezRenderWorld::DeleteView(m_hView);
+
+    // The render world keeps the pipelines of the last two extracted frames alive
+    RenderFrame();
+    RenderFrame();
+
+    EZ_TEST_INT(CountTransientMemoryStats(), 0);
+  }
+#endif
+
+  return ezTestAppRun::Quit;
+}
+
+void ezRendererTestTransientTargets::CreateCopyChainView()
+{
+  {
+    ezGALTextureCreationDescription texDesc;
+    texDesc.m_uiWidth = s_uiResolutionX;
+    texDesc.m_uiHeight = s_uiResolutionY;
+    texDesc.m_Format = ezGALResourceFormat::RGBAUByteNormalizedsRGB;
+    texDesc.m_bCreateRenderTarget = true;
+
+    m_hColorTarget = m_pDevice->CreateTexture(texDesc);
+  }
+
+  ezUniquePtr<ezRenderPipeline> pRenderPipeline = EZ_DEFAULT_NEW(ezRenderPipeline);
+
+  ezRenderPipelinePass* pPrevPass = nullptr;
+  {
+    ezUniquePtr<ezSourcePass> pPass = EZ_DEFAULT_NEW(ezSourcePass, "ColorSource");
+    pPrevPass = pPass.Borrow();
+    pRenderPipeline->AddPass(std::move(pPass));
+  }
+
+  ezStringBuilder sName;
+  for (ezUInt32 i = 0; i < s_uiNumCopyPasses; ++i)
+  {
+    sName.Format("Copy{}", i);
+
+    ezUniquePtr<ezCopyTexturePass> pPass = EZ_DEFAULT_NEW(ezCopyTexturePass);
+    pPass->SetName(sName);
+    ezRenderPipelinePass* pCopyPass = pPass.Borrow();
+    pRenderPipeline->AddPass(std::move(pPass));
+
+    EZ_VERIFY(pRenderPipeline->Connect(pPrevPass, "Output", pCopyPass, "Input"), "Connect failed!");
+    pPrevPass = pCopyPass;
+  }
+
+  {
+    ezUniquePtr<ezTargetPass> pPass = EZ_DEFAULT_NEW(ezTargetPass);
+    ezRenderPipelinePass* pTargetPass = pPass.Borrow();
+    pRenderPipeline->AddPass(std::move(pPass));
+
+    EZ_VERIFY(pRenderPipeline->Connect(pPrevPass, "Output", pTargetPass, "Color0"), "Connect failed!");
+  }
+
+  ezRenderPipelineResourceDescriptor desc;
+  ezRenderPipelineResourceLoader::CreateRenderPipelineResourceDescriptor(pRenderPipeline.Borrow(), desc);
+
+  ezRenderPipelineResourceHandle hPipeline = ezResourceManager::CreateResource<ezRenderPipelineResource>("TransientTargetsPipeline", std::move(desc), "TransientTargetsPipeline");
+
+  m_Camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovY, 60.0f, 0.1f, 1000.0f);
+  m_Camera.LookAt(ezVec3::ZeroVector(), ezVec3(1, 0, 0), ezVec3(0, 0, 1));
+
+  ezView* pView = nullptr;
+  m_hView = ezRenderWorld::CreateView("TransientTargets", pView);
+  pView->SetCameraUsageHint(ezCameraUsageHint::MainView);
+  pView->SetRenderPipelineResource(hPipeline);
+  pView->SetWorld(m_pWorld.Borrow());
+  pView->SetCamera(&m_Camera);
+  pView->SetViewport(ezRectFloat(0.0f, 0.0f, static_cast<float>(s_uiResolutionX), static_cast<float>(s_uiResolutionY)));
+
+  ezGALRenderTargetSetup renderTargetSetup;
+  renderTargetSetup.SetRenderTarget(0, m_pDevice->GetDefaultRenderTargetView(m_hColorTarget));
+  pView->SetRenderTargetSetup(renderTargetSetup);
+
+  ezRenderWorld::AddMainView(m_hView);
+}
+
+static ezRendererTestTransientTargets g_TransientTargetsTest;
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "../TestClass/TestClass.h"
+
+/// \brief Renders a chain of copy passes and checks the intermediate target memory that the pipeline computes when it is rebuilt.
+///
+/// Each target in the chain is only alive while its producer and consumer are executed, so every other target can share a pool texture.
+class ezRendererTestTransientTargets : public ezNullRendererTest
+{
+public:
+  virtual const char* GetTestName() const override { return "TransientTargets"; }
+
+private:
+  enum SubTests
+  {
+    ST_CopyChain,
+  };
+
+  virtual void SetupSubTests() override { AddSubTest("Copy Chain", SubTests::ST_CopyChain); }
+
+  virtual ezResult InitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezResult DeInitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezTestAppRun RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount) override;
+
+  void CreateCopyChainView();
+
+  ezInt32 m_iFrame = 0;
+};
@@ -0,0 +1 @@
+#include <RendererCoreTestPCH.h>
@@ -0,0 +1,145 @@
+#include <RendererCoreTestPCH.h>
+
+#include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Types/ScopeExit.h>
+#include <RendererCore/ShaderCompiler/ShaderCompiler.h>
+#include <RendererCore/ShaderCompiler/ShaderManager.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(ShaderCompiler);
+
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS) && EZ_ENABLED(EZ_SUPPORTS_FILE_STATS)
+
+/// \brief Writes dummy byte code for the 'TEST' platform and counts how often it was invoked.
+class ezTestShaderProgramCompiler : public ezShaderProgramCompiler
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezTestShaderProgramCompiler, ezShaderProgramCompiler);
+
+public:
+  virtual void GetSupportedPlatforms(ezHybridArray<ezString, 4>& Platforms) override { Platforms.PushBack("TEST"); }
+
+  virtual ezResult Compile(ezShaderProgramData& inout_Data, ezLogInterface* pLog) override
+  {
+    ++s_uiNumCompiles;
+
+    for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+    {
+      if (ezStringUtils::IsNullOrEmpty(inout_Data.m_szShaderSource[stage]) || !inout_Data.m_StageBinary[stage].GetByteCode().IsEmpty())
+        continue;
+
+      // the content does not matter, stage binaries without byte code count as missing
+      inout_Data.m_StageBinary[stage].GetByteCode().PushBack(static_cast<ezUInt8>(stage));
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  static ezUInt32 s_uiNumCompiles;
+};
+
+ezUInt32 ezTestShaderProgramCompiler::s_uiNumCompiles = 0;
+
+// clang-format off
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezTestShaderProgramCompiler, 1, ezRTTIDefaultAllocator<ezTestShaderProgramCompiler>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+namespace
+{
+  void WriteTextFile(const char* szFile, const char* szContent)
+  {
+    ezFileWriter file;
+    EZ_TEST_BOOL(file.Open(szFile).Succeeded());
+    EZ_TEST_BOOL(file.WriteBytes(szContent, ezStringUtils::GetStringElementCount(szContent)).Succeeded());
+  }
+
+  void WriteTestShader(ezUInt32 uiValue)
+  {
+    ezStringBuilder sShader = "[PLATFORMS]\nALL\n\n"
+                              "[PERMUTATIONS]\nTEST_PERM\n\n"
+                              "[RENDERSTATE]\nDepthTest = true\n\n"
+                              "[VERTEXSHADER]\n"
+                              "#include \"ShaderCompilerTestInclude.h\"\n";
+    sShader.AppendFormat("#define TEST_VALUE {}\n", uiValue);
+    sShader.Append("void main() { int a = TEST_VALUE + INCLUDE_VALUE; }\n");
+    WriteTextFile(":shadertest/ShaderCompilerTest.ezShader", sShader);
+  }
+
+  ezUInt32 CompilePermutation(bool bPermValue)
+  {
+    ezHybridArray<ezPermutationVar, 1> permVars;
+    permVars.ExpandAndGetRef().m_sName.Assign("TEST_PERM");
+    permVars.PeekBack().m_sValue.Assign(bPermValue ? "TRUE" : "FALSE");
+
+    const ezUInt32 uiPrevCompiles = ezTestShaderProgramCompiler::s_uiNumCompiles;
+
+    // like the shader compiler tool, every permutation gets its own compiler
+    ezShaderCompiler sc;
+    EZ_TEST_BOOL(sc.CompileShaderPermutationForPlatforms("ShaderCompilerTest.ezShader", permVars, ezLog::GetThreadLocalLogSystem(), "TEST").Succeeded());
+
+    return ezTestShaderProgramCompiler::s_uiNumCompiles - uiPrevCompiles;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(ShaderCompiler, SkipUpToDatePermutations)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("ShaderCompilerTest");
+
+  // stale permutations of a previous run would be skipped right away
+  ezOSFile::DeleteFolder(sOutputFolder).IgnoreResult();
+
+  ezFileSystem::RegisterDataDirectoryFactory(ezDataDirectory::FolderType::Factory);
+  EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "ShaderCompilerTest", "shadertest", ezFileSystem::AllowWrites).Succeeded());
+
+  const ezString sPrevPlatform = ezShaderManager::GetActivePlatform();
+  const ezString sPrevCacheDirectory = ezShaderManager::GetCacheDirectory();
+  const ezString sPrevPermVarDirectory = ezShaderManager::GetPermutationVarSubDirectory();
+  const bool bPrevRuntimeCompilation = ezShaderManager::IsRuntimeCompilationEnabled();
+
+  ezShaderManager::Configure("TEST", false, ":shadertest/ShaderCache");
+
+  EZ_SCOPE_EXIT(ezShaderManager::Configure(sPrevPlatform, bPrevRuntimeCompilation, sPrevCacheDirectory, sPrevPermVarDirectory);
+                ezFileSystem::RemoveDataDirectoryGroup("ShaderCompilerTest"););
+
+  WriteTextFile(":shadertest/ShaderCompilerTestInclude.h", "#define INCLUDE_VALUE 1\n");
+  WriteTestShader(1);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Skip Unchanged")
+  {
+    EZ_TEST_INT(CompilePermutation(true), 1);
+    EZ_TEST_INT(CompilePermutation(true), 0);
+
+    // a different permutation value is a different permutation
+    EZ_TEST_INT(CompilePermutation(false), 1);
+    EZ_TEST_INT(CompilePermutation(false), 0);
+    EZ_TEST_INT(CompilePermutation(true), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Changed Define")
+  {
+    WriteTestShader(2);
+
+    EZ_TEST_INT(CompilePermutation(true), 1);
+    EZ_TEST_INT(CompilePermutation(true), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Changed Include")
+  {
+    // dependency files store time stamps in seconds and cache them for two seconds
+    ezThreadUtils::Sleep(ezTime::Milliseconds(2100));
+
+    WriteTextFile(":shadertest/ShaderCompilerTestInclude.h", "#define INCLUDE_VALUE 2\n");
+
+    EZ_TEST_INT(CompilePermutation(true), 1);
+    EZ_TEST_INT(CompilePermutation(true), 0);
+
+    // the other permutation includes the same file
+    EZ_TEST_INT(CompilePermutation(false), 1);
+    EZ_TEST_INT(CompilePermutation(false), 0);
+  }
+}
+
+#endif
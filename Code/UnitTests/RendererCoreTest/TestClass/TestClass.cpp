@@ -0,0 +1,305 @@
+#include <RendererCoreTestPCH.h>
+
+#include "TestClass.h"
+#include <Foundation/Configuration/Plugin.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/Memory/MemoryTracker.h>
+#include <Foundation/Reflection/ReflectionUtils.h>
+#include <RendererCore/Meshes/MeshComponent.h>
+#include <RendererCore/Pipeline/Extractor.h>
+#include <RendererCore/Pipeline/Implementation/RenderPipelineResourceLoader.h>
+#include <RendererCore/Pipeline/Passes/OpaqueForwardRenderPass.h>
+#include <RendererCore/Pipeline/Passes/SourcePass.h>
+#include <RendererCore/Pipeline/Passes/TargetPass.h>
+#include <RendererCore/Pipeline/RenderPipelineResource.h>
+#include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderContext/RenderContext.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+#include <RendererCore/ShaderCompiler/ShaderManager.h>
+#include <RendererFoundation/Device/DeviceFactory.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiNumMaterials = 16;
+  constexpr ezUInt32 s_uiResolutionX = 1280;
+  constexpr ezUInt32 s_uiResolutionY = 720;
+
+  ezMeshResourceHandle CreateMeshResource(const ezGeometry& geom, const char* szResourceName)
+  {
+    ezMeshResourceDescriptor desc;
+    desc.MeshBufferDesc().AddCommonStreams();
+    desc.MeshBufferDesc().AllocateStreamsFromGeometry(geom, ezGALPrimitiveTopology::Triangles);
+    desc.AddSubMesh(desc.MeshBufferDesc().GetPrimitiveCount(), 0, 0);
+    desc.SetMaterial(0, "Materials/BaseMaterials/MissingMaterial.ezMaterial");
+    desc.ComputeBounds();
+
+    return ezResourceManager::CreateResource<ezMeshResource>(szResourceName, std::move(desc), szResourceName);
+  }
+} // namespace
+
+ezResult ezNullRendererTest::InitializeSubTest(ezInt32 iIdentifier)
+{
+  // initialize everything up to 'core'
+  ezStartup::StartupCoreSystems();
+  return EZ_SUCCESS;
+}
+
+ezResult ezNullRendererTest::DeInitializeSubTest(ezInt32 iIdentifier)
+{
+  // shut down completely
+  ezStartup::ShutdownCoreSystems();
+  ezMemoryTracker::DumpMemoryLeaks();
+  return EZ_SUCCESS;
+}
+
+ezResult ezNullRendererTest::SetupDataDirectories()
+{
+  ezFileSystem::SetSpecialDirectory("testout", ezTestFramework::GetInstance()->GetAbsOutputPath());
+
+  EZ_SUCCEED_OR_RETURN(ezFileSystem::AddDataDirectory(">appdir/", "ShaderCache", "shadercache", ezFileSystem::AllowWrites)); // for shader files
+
+  EZ_SUCCEED_OR_RETURN(ezFileSystem::AddDataDirectory(">sdk/Data/Base/", "Base"));
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezNullRendererTest::SetupRenderer()
+{
+  EZ_SUCCEED_OR_RETURN(SetupDataDirectories());
+
+  const char* szShaderModel = "";
+  const char* szShaderCompiler = "";
+  ezGALDeviceFactory::GetShaderModelAndCompiler("Null", szShaderModel, szShaderCompiler);
+
+  // The shader compiler is optional, without it all shaders are taken from the shader cache
+  const bool bCanCompileShaders = ezPlugin::LoadPlugin(szShaderCompiler).Succeeded();
+  if (!bCanCompileShaders)
+  {
+    ezLog::Warning("Shader compiler '{}' is not available, shaders can only be loaded from the shader cache.", szShaderCompiler);
+  }
+
+  ezShaderManager::Configure(szShaderModel, bCanCompileShaders);
+
+  // No window and no swap chain, tests render into offscreen targets
+  ezGALDeviceCreationDescription DeviceInit;
+  DeviceInit.m_bCreatePrimarySwapChain = false;
+  DeviceInit.m_bDebugDevice = false;
+
+  m_pDevice = ezGALDeviceFactory::CreateDevice("Null", ezFoundation::GetDefaultAllocator(), DeviceInit);
+
+  if (m_pDevice == nullptr || m_pDevice->Init().Failed())
+    return EZ_FAILURE;
+
+  ezGALDevice::SetDefaultDevice(m_pDevice);
+
+  ezStartup::StartupHighLevelSystems();
+
+  return EZ_SUCCESS;
+}
+
+void ezNullRendererTest::ShutdownRenderer()
+{
+  ezStartup::ShutdownHighLevelSystems();
+
+  ezResourceManager::FreeAllUnusedResources();
+
+  if (m_pDevice)
+  {
+    m_pDevice->Shutdown().IgnoreResult();
+    EZ_DEFAULT_DELETE(m_pDevice);
+  }
+}
+
+void ezNullRendererTest::CreateScene(ezUInt32 uiNumObjects)
+{
+  CreateMeshesAndMaterials();
+  CreateWorld(uiNumObjects);
+  CreateView();
+}
+
+void ezNullRendererTest::DestroyScene()
+{
+  ezRenderWorld::RemoveMainView(m_hView);
+  ezRenderWorld::DeleteView(m_hView);
+  m_hView.Invalidate();
+
+  m_pWorld = nullptr;
+
+  m_Meshes.Clear();
+  m_Materials.Clear();
+
+  if (m_pDevice && !m_hColorTarget.IsInvalidated())
+  {
+    m_pDevice->DestroyTexture(m_hColorTarget);
+    m_hColorTarget.Invalidate();
+  }
+}
+
+void ezNullRendererTest::CreateMeshesAndMaterials()
+{
+  {
+    ezGeometry geom;
+    geom.AddGeodesicSphere(0.5f, 2, ezColor::White);
+    geom.ComputeTangents();
+    m_Meshes.PushBack(CreateMeshResource(geom, "TestScene_Sphere"));
+  }
+
+  {
+    ezGeometry geom;
+    geom.AddBox(ezVec3(1.0f), ezColor::White);
+    geom.ComputeTangents();
+    m_Meshes.PushBack(CreateMeshResource(geom, "TestScene_Box"));
+  }
+
+  {
+    ezGeometry geom;
+    geom.AddTorus(0.25f, 0.5f, 16, 8, ezColor::White);
+    geom.ComputeTangents();
+    m_Meshes.PushBack(CreateMeshResource(geom, "TestScene_Torus"));
+  }
+
+  // Distinct materials break up the batches, like in a real scene
+  ezMaterialResourceHandle hBaseMaterial = ezResourceManager::LoadResource<ezMaterialResource>("Materials/BaseMaterials/MissingMaterial.ezMaterial");
+
+  ezStringBuilder sName;
+  for (ezUInt32 i = 0; i < s_uiNumMaterials; ++i)
+  {
+    sName.Format("TestScene_Material_{}", i);
+
+    ezMaterialResourceDescriptor md;
+    md.m_hBaseMaterial = hBaseMaterial;
+
+    m_Materials.PushBack(ezResourceManager::CreateResource<ezMaterialResource>(sName, std::move(md), sName));
+  }
+}
+
+void ezNullRendererTest::CreateWorld(ezUInt32 uiNumObjects)
+{
+  ezWorldDesc worldDesc("TestScene");
+  m_pWorld = EZ_DEFAULT_NEW(ezWorld, worldDesc);
+
+  EZ_LOCK(m_pWorld->GetWriteMarker());
+
+  ezMeshComponentManager* pManager = m_pWorld->GetOrCreateComponentManager<ezMeshComponentManager>();
+
+  // A cube of objects in front of the camera, the outer parts are culled
+  const ezUInt32 uiDim = static_cast<ezUInt32>(ezMath::Ceil(ezMath::Pow(static_cast<float>(uiNumObjects), 1.0f / 3.0f)));
+  const float fSpacing = 2.0f;
+  const float fHalfSize = uiDim * fSpacing * 0.5f;
+
+  for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+  {
+    const ezUInt32 x = i % uiDim;
+    const ezUInt32 y = (i / uiDim) % uiDim;
+    const ezUInt32 z = i / (uiDim * uiDim);
+
+    ezGameObjectDesc go;
+    go.m_LocalPosition.Set(5.0f + x * fSpacing, y * fSpacing - fHalfSize, z * fSpacing - fHalfSize);
+    go.m_bDynamic = false;
+
+    ezGameObject* pObject;
+    m_pWorld->CreateObject(go, pObject);
+
+    ezMeshComponent* pMesh;
+    pManager->CreateComponent(pObject, pMesh);
+
+    pMesh->SetMesh(m_Meshes[i % m_Meshes.GetCount()]);
+    pMesh->SetMaterial(0, m_Materials[(i / m_Meshes.GetCount()) % m_Materials.GetCount()]);
+  }
+}
+
+void ezNullRendererTest::CreateView()
+{
+  {
+    ezGALTextureCreationDescription texDesc;
+    texDesc.m_uiWidth = s_uiResolutionX;
+    texDesc.m_uiHeight = s_uiResolutionY;
+    texDesc.m_Format = ezGALResourceFormat::RGBAUByteNormalizedsRGB;
+    texDesc.m_bCreateRenderTarget = true;
+
+    m_hColorTarget = m_pDevice->CreateTexture(texDesc);
+  }
+
+  ezUniquePtr<ezRenderPipeline> pRenderPipeline = EZ_DEFAULT_NEW(ezRenderPipeline);
+
+  ezSourcePass* pColorSourcePass = nullptr;
+  {
+    ezUniquePtr<ezSourcePass> pPass = EZ_DEFAULT_NEW(ezSourcePass, "ColorSource");
+    pColorSourcePass = pPass.Borrow();
+    pRenderPipeline->AddPass(std::move(pPass));
+  }
+
+  ezSourcePass* pDepthSourcePass = nullptr;
+  {
+    ezUniquePtr<ezSourcePass> pPass = EZ_DEFAULT_NEW(ezSourcePass, "DepthStencil");
+    pDepthSourcePass = pPass.Borrow();
+
+    ezAbstractMemberProperty* pFormatProp = static_cast<ezAbstractMemberProperty*>(pPass->GetDynamicRTTI()->FindPropertyByName("Format"));
+    ezReflectionUtils::SetMemberPropertyValue(pFormatProp, pDepthSourcePass, static_cast<ezInt64>(ezGALResourceFormat::D24S8));
+
+    pRenderPipeline->AddPass(std::move(pPass));
+  }
+
+  ezOpaqueForwardRenderPass* pOpaquePass = nullptr;
+  {
+    ezUniquePtr<ezOpaqueForwardRenderPass> pPass = EZ_DEFAULT_NEW(ezOpaqueForwardRenderPass);
+    pOpaquePass = pPass.Borrow();
+    pRenderPipeline->AddPass(std::move(pPass));
+  }
+
+  ezTargetPass* pTargetPass = nullptr;
+  {
+    ezUniquePtr<ezTargetPass> pPass = EZ_DEFAULT_NEW(ezTargetPass);
+    pTargetPass = pPass.Borrow();
+    pRenderPipeline->AddPass(std::move(pPass));
+  }
+
+  EZ_VERIFY(pRenderPipeline->Connect(pColorSourcePass, "Output", pOpaquePass, "Color"), "Connect failed!");
+  EZ_VERIFY(pRenderPipeline->Connect(pDepthSourcePass, "Output", pOpaquePass, "DepthStencil"), "Connect failed!");
+  EZ_VERIFY(pRenderPipeline->Connect(pOpaquePass, "Color", pTargetPass, "Color0"), "Connect failed!");
+
+  pRenderPipeline->AddExtractor(EZ_DEFAULT_NEW(ezVisibleObjectsExtractor));
+
+  ezRenderPipelineResourceDescriptor desc;
+  ezRenderPipelineResourceLoader::CreateRenderPipelineResourceDescriptor(pRenderPipeline.Borrow(), desc);
+
+  ezRenderPipelineResourceHandle hPipeline = ezResourceManager::CreateResource<ezRenderPipelineResource>("TestScenePipeline", std::move(desc), "TestScenePipeline");
+
+  m_Camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovY, 60.0f, 0.1f, 1000.0f);
+  m_Camera.LookAt(ezVec3::ZeroVector(), ezVec3(1, 0, 0), ezVec3(0, 0, 1));
+
+  ezView* pView = nullptr;
+  m_hView = ezRenderWorld::CreateView("TestScene", pView);
+  pView->SetCameraUsageHint(ezCameraUsageHint::MainView);
+  pView->SetRenderPipelineResource(hPipeline);
+  pView->SetWorld(m_pWorld.Borrow());
+  pView->SetCamera(&m_Camera);
+  pView->SetViewport(ezRectFloat(0.0f, 0.0f, static_cast<float>(s_uiResolutionX), static_cast<float>(s_uiResolutionY)));
+
+  ezGALRenderTargetSetup renderTargetSetup;
+  renderTargetSetup.SetRenderTarget(0, m_pDevice->GetDefaultRenderTargetView(m_hColorTarget));
+  pView->SetRenderTargetSetup(renderTargetSetup);
+
+  ezRenderWorld::AddMainView(m_hView);
+}
+
+void ezNullRendererTest::RenderFrame()
+{
+  {
+    EZ_LOCK(m_pWorld->GetWriteMarker());
+    m_pWorld->Update();
+  }
+
+  ezRenderWorld::BeginFrame();
+  m_pDevice->BeginFrame();
+
+  ezRenderWorld::ExtractMainViews();
+  ezRenderWorld::Render(ezRenderContext::GetDefaultInstance());
+
+  m_pDevice->EndFrame();
+  ezRenderWorld::EndFrame();
+
+  ezTaskSystem::FinishFrameTasks();
+  ezResourceManager::PerFrameUpdate();
+}
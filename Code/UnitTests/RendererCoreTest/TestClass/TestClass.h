@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Core/Graphics/Camera.h>
+#include <Core/Graphics/Geometry.h>
+#include <Core/World/World.h>
+#include <RendererCore/Material/MaterialResource.h>
+#include <RendererCore/Meshes/MeshResource.h>
+#include <RendererCore/Pipeline/Declarations.h>
+#include <RendererFoundation/Device/Device.h>
+#include <TestFramework/Framework/TestBaseClass.h>
+
+/// \brief Base class for tests that render on the 'Null' device.
+///
+/// The Null device needs neither a GPU nor a window, so these tests run on every machine, including build servers.
+class ezNullRendererTest : public ezTestBaseClass
+{
+protected:
+  virtual ezResult InitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezResult DeInitializeSubTest(ezInt32 iIdentifier) override;
+
+  ezResult SetupDataDirectories();
+
+  /// \brief Creates the Null device without a swap chain and starts up the high level systems.
+  ezResult SetupRenderer();
+  void ShutdownRenderer();
+
+  /// \brief Creates a world with the given number of mesh objects and a main view that renders it into an offscreen target.
+  ///
+  /// The objects use 3 different meshes and 16 different materials, and the outer parts of the scene are culled.
+  void CreateScene(ezUInt32 uiNumObjects);
+  void DestroyScene();
+
+  /// \brief Updates the world, then extracts and renders all main views.
+  void RenderFrame();
+
+  ezGALDevice* m_pDevice = nullptr;
+
+  ezUniquePtr<ezWorld> m_pWorld;
+  ezCamera m_Camera;
+  ezViewHandle m_hView;
+  ezGALTextureHandle m_hColorTarget;
+
+  ezHybridArray<ezMeshResourceHandle, 4> m_Meshes;
+  ezHybridArray<ezMaterialResourceHandle, 16> m_Materials;
+
+private:
+  void CreateMeshesAndMaterials();
+  void CreateWorld(ezUInt32 uiNumObjects);
+  void CreateView();
+};